@@ -29,6 +29,7 @@ under the License.
 // ************************
 #endif
 
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -2468,6 +2469,90 @@ void ijkGridHyperslabingTiming(AbstractIjkGridRepresentation* ijkGrid, unsigned
 	std::cout << endl << "END: IJK GRID REP (hyperslabbed and non-hyperslabbed geometry reading comparison)" << std::endl;
 }
 
+/**
+ * This method provides a time comparison between the generic per corner cell geometry access (getXyzPointOfBlockFromCellCorner)
+ * and the specialized block kernels (getXyzPointIndicesOfBlockCellCorners and getCellCentersOfBlock).
+ * The specialized kernels do not look up the split information at all on grids with arithmetic node indexing (unfaulted or lattice grids).
+ * @param ijkGrid	an IJK grid representation
+ * @param nbIter	number of cell geometry computation iteration
+ */
+void ijkGridCellGeometryTiming(AbstractIjkGridRepresentation* ijkGrid, unsigned int nbIter)
+{
+	if (ijkGrid == nullptr)
+		throw invalid_argument("ijkGridCellGeometryTiming: ijkGrid is nullptr.");
+
+	cout << endl << "BEGIN: IJK GRID REP (generic and specialized cell geometry comparison)" << std::endl << std::endl;
+	cout << "Arithmetic node indexing : " << ijkGrid->hasArithmeticNodeIndexing() << std::endl;
+
+	if (!ijkGrid->hasArithmeticNodeIndexing()) {
+		ijkGrid->loadSplitInformation();
+	}
+	const unsigned int iCellCount = ijkGrid->getICellCount();
+	const unsigned int jCellCount = ijkGrid->getJCellCount();
+	const unsigned int kCellCount = ijkGrid->getKCellCount();
+	ijkGrid->loadBlockInformation(0, iCellCount, 0, jCellCount, 0, kCellCount);
+
+	double* xyzPoints = new double[ijkGrid->getXyzPointCountOfBlock() * 3];
+	ijkGrid->getXyzPointsOfBlockOfPatch(0, xyzPoints);
+	const ULONG64 cellCount = ijkGrid->getCellCountOfBlock();
+	double* genericCellCenters = new double[cellCount * 3];
+	double* specializedCellCenters = new double[cellCount * 3];
+
+	// generic path
+	clock_t clockStart = clock();
+	for (unsigned int n = 0; n < nbIter; ++n) {
+		ULONG64 cellIndex = 0;
+		for (unsigned int k = 0; k < kCellCount; ++k) {
+			for (unsigned int j = 0; j < jCellCount; ++j) {
+				for (unsigned int i = 0; i < iCellCount; ++i) {
+					double center[3] = { .0, .0, .0 };
+					for (unsigned int corner = 0; corner < 8; ++corner) {
+						double x, y, z;
+						ijkGrid->getXyzPointOfBlockFromCellCorner(i, j, k, corner, xyzPoints, x, y, z);
+						center[0] += x;
+						center[1] += y;
+						center[2] += z;
+					}
+					genericCellCenters[cellIndex * 3] = center[0] / 8;
+					genericCellCenters[cellIndex * 3 + 1] = center[1] / 8;
+					genericCellCenters[cellIndex * 3 + 2] = center[2] / 8;
+					++cellIndex;
+				}
+			}
+		}
+	}
+	const clock_t genericClockDuration = clock() - clockStart;
+
+	// specialized path
+	clockStart = clock();
+	for (unsigned int n = 0; n < nbIter; ++n) {
+		ijkGrid->getCellCentersOfBlock(xyzPoints, specializedCellCenters);
+	}
+	const clock_t specializedClockDuration = clock() - clockStart;
+
+	for (ULONG64 index = 0; index < cellCount * 3; ++index) {
+		if (fabs(genericCellCenters[index] - specializedCellCenters[index]) > 1e-9) {
+			std::cout << "ERROR : generic and specialized cell centers differ at index " << index << std::endl;
+			break;
+		}
+	}
+
+	std::cout << "Generic: cell centers of " << ijkGrid->getTitle() << " have been computed " << nbIter << " times in " << genericClockDuration << " ticks (CPU time)" << std::endl;
+	std::cout << "Specialized: cell centers of " << ijkGrid->getTitle() << " have been computed " << nbIter << " times in " << specializedClockDuration << " ticks (CPU time)" << std::endl;
+	if (genericClockDuration > 0) {
+		std::cout << "specialized version took " << (specializedClockDuration * 100) / genericClockDuration << " % of generic version" << std::endl;
+	}
+
+	if (!ijkGrid->hasArithmeticNodeIndexing()) {
+		ijkGrid->unloadSplitInformation();
+	}
+	delete[] xyzPoints;
+	delete[] genericCellCenters;
+	delete[] specializedCellCenters;
+
+	std::cout << endl << "END: IJK GRID REP (generic and specialized cell geometry comparison)" << std::endl;
+}
+
 /**
  * This method provides a time comparison betweeen hyperslabbed and non-hyperslabbed versions of IJK grid discrete property reading.
  * It is assumed that poperty is cell centric.
@@ -3235,6 +3320,14 @@ void deserialize(const string & inputFile)
 
 	// Testing block hyperslabbing
 	deserializeGridHyperslabbingBlock(pck);
+
+	// Comparing generic and specialized cell geometry
+	for (unsigned int i = 0; i < ijkGridCount; ++i) {
+		AbstractIjkGridRepresentation* ijkGrid = pck.getIjkGridRepresentation(i);
+		if (!ijkGrid->isPartial() && !ijkGrid->isTruncated() && ijkGrid->getGeometryKind() != AbstractIjkGridRepresentation::NO_GEOMETRY) {
+			ijkGridCellGeometryTiming(ijkGrid, 10);
+		}
+	}
 	
 	
 	// ====================
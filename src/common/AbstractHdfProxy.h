@@ -359,6 +359,28 @@ namespace COMMON_NS
 			unsigned long long * blockSizeInEachDimension,
 			const unsigned int & numDimensions) = 0;
 
+		/**
+		 * Find the array associated with @p datasetName and read from it.
+		 * @param datasetName					The name of the array (potentially with multi dimensions).
+		 * @param values						1d array output of values ordered firstly by fastest direction. The values must be pre-allocated and won't be freed by this method.
+		 * @param blockCountPerDimension		Number of blocks to select from the dataspace, in each dimension. They are ordered from fastest index to slowest index.
+		 * @param offsetInEachDimension			Offset values in each dimension of the array to read. They are ordered from fastest index to slowest index.
+		 * @param strideInEachDimension			Number of elements to move from one block to another in each dimension. They are ordered from fastest index to slowest index. nullptr means contiguous blocks.
+		 * @param blockSizeInEachDimension		Size of selected blocks in each dimension. They are ordered from fastest index to slowest index. nullptr means blocks of a single value.
+		 * @param numDimensions					The number of the dimensions of the array to read.
+		 * @param datatype						The hdf datatype of the values to read.
+		 *										If the values are not stored in this particular datatype, then hdf library will try to do a conversion.
+		 */
+		virtual void readArrayNdOfValues(
+			const std::string & datasetName,
+			void* values,
+			unsigned long long * blockCountPerDimension,
+			unsigned long long * offsetInEachDimension,
+			unsigned long long * strideInEachDimension,
+			unsigned long long * blockSizeInEachDimension,
+			const unsigned int & numDimensions,
+			const int & datatype) = 0;
+
 		/**
 		 * Considering a given dataset, this method selects an hyperslab region to add to an existing selected region or to add to a new selected region.
 		 * The dataset is not closed within this method.
@@ -396,6 +418,23 @@ namespace COMMON_NS
 			void* values,
 			unsigned long long slabSize) = 0;
 
+		/**
+		 * Considering a given dataset, read the values corresponding to an existing selected region.
+		 * The dataset and the selected region are closed within this method.
+		 * @param dataset		ID of the dataset to read from.
+		 * @param filespace		ID of the selected region.
+		 * @param values		1d array output of values ordered firstly by fastest direction. The values must be pre-allocated and won't be freed by this method.
+		 * @param slabSize		Number of values to read.
+		 * @param datatype		The hdf datatype of the values to read.
+		 *						If the values are not stored in this particular datatype, then hdf library will try to do a conversion.
+		 */
+		virtual void readArrayNdOfValues(
+			int dataset,
+			int filespace,
+			void* values,
+			unsigned long long slabSize,
+			const int & datatype) = 0;
+
 		/**
 		 * Read an array Nd of float values stored in a specific dataset.
 		 * @param datasetName	The absolute dataset name where to read the values
@@ -431,6 +470,22 @@ namespace COMMON_NS
 		*/
 		virtual void readArrayNdOfGSoapULong64Values(const std::string & datasetName, ULONG64* values) = 0;
 
+		/**
+		 * Find the array associated with @p datasetName and read from it.
+		 * @param datasetName                    The name of the array (potentially with multi dimensions).
+		 * @param values                         1d array output of unsigned 64 bits values ordered firstly by fastest direction. The values must be pre-allocated and won't be freed by this method.
+		 * @param numValuesInEachDimension       Number of values in each dimension of the array to read. They are ordered from fastest index to slowest index.
+		 * @param offsetValuesInEachDimension    Offset values in each dimension of the array to read. They are ordered from fastest index to slowest index.
+		 * @param numDimensions                  The number of the dimensions of the array to read.
+		 */
+		virtual void readArrayNdOfGSoapULong64Values(
+		  const std::string & datasetName,
+		  ULONG64* values,
+		  unsigned long long * numValuesInEachDimension,
+		  unsigned long long * offsetInEachDimension,
+		  const unsigned int & numDimensions
+		  ) = 0;
+
 		/**
 		 * Read an array Nd of long values stored in a specific dataset.
 		 * @param datasetName	The absolute dataset name where to read the values
@@ -24,6 +24,8 @@ under the License.
 #include "H5Epublic.h"
 #include "H5Fpublic.h"
 
+#include "common/GeometryCache.h"
+
 #include "epc/Relationship.h"
 #include "epc/FilePart.h"
 
@@ -171,14 +173,14 @@ namespace // anonymous namespace. Use only in that file.
 }
 
 EpcDocument::EpcDocument(const string & fileName, const openingMode & hdf5PermissionAccess) :
-	package(nullptr), s(nullptr), propertyKindMapper(nullptr), make_hdf_proxy(&default_builder), make_hdf_proxy_from_gsoap_proxy_2_0_1(&default_builder)
+	package(nullptr), s(nullptr), propertyKindMapper(nullptr), geometryCache(new GeometryCache()), make_hdf_proxy(&default_builder), make_hdf_proxy_from_gsoap_proxy_2_0_1(&default_builder)
 	, make_hdf_proxy_from_gsoap_proxy_2_1(&default_builder)
 {
 	open(fileName, hdf5PermissionAccess);
 }
 
 EpcDocument::EpcDocument(const std::string & fileName, const std::string & propertyKindMappingFilesDirectory, const openingMode & hdf5PermissionAccess) :
-	package(nullptr), s(nullptr), make_hdf_proxy(&default_builder), make_hdf_proxy_from_gsoap_proxy_2_0_1(&default_builder)
+	package(nullptr), s(nullptr), geometryCache(new GeometryCache()), make_hdf_proxy(&default_builder), make_hdf_proxy_from_gsoap_proxy_2_0_1(&default_builder)
 	, make_hdf_proxy_from_gsoap_proxy_2_1(&default_builder)
 {
 	open(fileName, hdf5PermissionAccess);
@@ -194,6 +196,12 @@ EpcDocument::EpcDocument(const std::string & fileName, const std::string & prope
 	}
 }
 
+EpcDocument::~EpcDocument()
+{
+	close();
+	delete geometryCache;
+}
+
 std::string EpcDocument::generateRandomUuidAsString()
 {
 	return GuidTools::generateUidAsString();
@@ -208,6 +216,8 @@ soap* EpcDocument::getGsoapContext() const { return s; }
 
 PropertyKindMapper* EpcDocument::getPropertyKindMapper() const { return propertyKindMapper; }
 
+GeometryCache* EpcDocument::getGeometryCache() const { return geometryCache; }
+
 #if (defined(_WIN32) && _MSC_VER >= 1600) || defined(__APPLE__)
 const std::unordered_map< std::string, COMMON_NS::AbstractObject* > & EpcDocument::getResqmlAbstractObjectSet() const { return resqmlAbstractObjectSet; }
 #else
@@ -386,6 +396,9 @@ void EpcDocument::close()
 		propertyKindMapper = nullptr;
 	}
 
+	// The cached geometry structures refer to the objects which are going to be deleted
+	geometryCache->clear();
+
 #if (defined(_WIN32) && _MSC_VER >= 1600) || defined(__APPLE__)
 	for (std::unordered_map< std::string, COMMON_NS::AbstractObject* >::const_iterator it = resqmlAbstractObjectSet.begin(); it != resqmlAbstractObjectSet.end(); ++it)
 #else
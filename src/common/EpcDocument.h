@@ -147,6 +147,7 @@ namespace COMMON_NS
 {
 	class AbstractObject;
 	class AbstractHdfProxy;
+	class GeometryCache;
 
 	/**
 	* This class allows an access to a memory package representing an EPC document.
@@ -175,7 +176,7 @@ namespace COMMON_NS
 		/**
 		* The destructor frees all allocated ressources.
 		*/
-		virtual ~EpcDocument() { close(); }
+		virtual ~EpcDocument();
 
 		// A function pointer definition which allows to build an abstract hdf proxy in writing mode of an epc document
 		typedef COMMON_NS::AbstractHdfProxy* (HdfProxyBuilder)(soap* soapContext, const std::string & guid, const std::string & title, const std::string & packageDirAbsolutePath, const std::string & externalFilePath, bool v21);
@@ -242,6 +243,12 @@ namespace COMMON_NS
 		 */
 		RESQML2_0_1_NS::PropertyKindMapper* getPropertyKindMapper() const;
 
+		/**
+		 * Get the cache of the geometry structures (split information, pillar information, unstructured grid topology...) derived from the HDF5 datasets of the objects of this epc document.
+		 * Use it to set a memory budget for these structures. By default, the budget is unlimited.
+		 */
+		COMMON_NS::GeometryCache* getGeometryCache() const;
+
 		/**
 		* Get the name of the energistics property kind as a string based on the enumerated property kind.
 		* @return The empty string if no correspondence is found
@@ -1237,6 +1244,8 @@ namespace COMMON_NS
 
 		std::vector<std::string> warnings;
 
+		COMMON_NS::GeometryCache* geometryCache;
+
 		HdfProxyBuilder* make_hdf_proxy; /// the builder for HDF proxy in writing mode of the epc document
 		HdfProxyBuilderFromGsoapProxy2_0_1* make_hdf_proxy_from_gsoap_proxy_2_0_1; /// the builder for a v2.0.1 HDF proxy in reading mode of the epc document
 		HdfProxyBuilderFromGsoapProxy2_1* make_hdf_proxy_from_gsoap_proxy_2_1; /// the builder for a v2.1 HDF proxy in reading mode of the epc document
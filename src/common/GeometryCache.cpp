@@ -0,0 +1,105 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "common/GeometryCache.h"
+
+#include <stdexcept>
+
+using namespace std;
+using namespace COMMON_NS;
+
+std::shared_ptr<GeometryCache::Entry> GeometryCache::get(const COMMON_NS::AbstractObject* owner, const entryKind & kind)
+{
+	map<Key, list<Item>::iterator>::iterator it = index.find(Key(owner, kind));
+	if (it == index.end()) {
+		return std::shared_ptr<Entry>();
+	}
+
+	// Move the item to the front of the LRU list
+	lruList.splice(lruList.begin(), lruList, it->second);
+	return it->second->entry;
+}
+
+std::shared_ptr<GeometryCache::Entry> GeometryCache::put(const COMMON_NS::AbstractObject* owner, const entryKind & kind, Entry* entry)
+{
+	if (entry == nullptr) {
+		throw invalid_argument("Cannot put a null entry in the geometry cache.");
+	}
+
+	Item item;
+	item.key = Key(owner, kind);
+	item.entry = std::shared_ptr<Entry>(entry);
+
+	release(owner, kind);
+
+	item.byteSize = entry->getByteSize();
+	lruList.push_front(item);
+	index[item.key] = lruList.begin();
+	byteSize += item.byteSize;
+
+	evict(1);
+
+	return item.entry;
+}
+
+void GeometryCache::release(const COMMON_NS::AbstractObject* owner, const entryKind & kind)
+{
+	map<Key, list<Item>::iterator>::iterator it = index.find(Key(owner, kind));
+	if (it != index.end()) {
+		erase(it);
+	}
+}
+
+void GeometryCache::releaseAll(const COMMON_NS::AbstractObject* owner)
+{
+	map<Key, list<Item>::iterator>::iterator it = index.lower_bound(Key(owner, SPLIT_INFORMATION));
+	while (it != index.end() && it->first.first == owner) {
+		erase(it++);
+	}
+}
+
+void GeometryCache::clear()
+{
+	lruList.clear();
+	index.clear();
+	byteSize = 0;
+}
+
+void GeometryCache::setByteBudget(const unsigned long long & byteBudget)
+{
+	this->byteBudget = byteBudget;
+	evict(0);
+}
+
+void GeometryCache::evict(const size_t & keptCount)
+{
+	if (byteBudget == 0) {
+		return;
+	}
+
+	while (byteSize > byteBudget && lruList.size() > keptCount) {
+		erase(index.find(lruList.back().key));
+	}
+}
+
+void GeometryCache::erase(map<Key, list<Item>::iterator>::iterator it)
+{
+	byteSize -= it->second->byteSize;
+	lruList.erase(it->second);
+	index.erase(it);
+}
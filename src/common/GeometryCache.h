@@ -0,0 +1,147 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#pragma once
+
+#include <list>
+#include <map>
+#include <memory>
+
+#include "common/EpcDocument.h"
+
+namespace COMMON_NS
+{
+	/**
+	* A memory budgeted cache of the geometry structures which are derived from the HDF5 datasets of the objects of an EPC document
+	* (split information, pillar information, unstructured grid topology, ...).
+	* The cache shares the ownership of its entries and tracks their byte sizes. When the total size exceeds the byte budget, the least recently used entries are evicted.
+	* An evicted or released entry is only deleted once nobody else holds it : keeping the shared pointer returned by get or put pins the entry during a computation.
+	* Owners may keep a weak pointer to their entries to avoid a cache lookup on each access, which does not refresh the recency of the entry then.
+	* They get them back from the cache and transparently reload them once this weak pointer has expired.
+	*/
+	class DLL_IMPORT_OR_EXPORT GeometryCache
+	{
+	public:
+
+		/**
+		* The kinds of cached geometry structures. An object owns at most one entry of each kind.
+		*/
+		enum entryKind { SPLIT_INFORMATION = 0, PILLAR_INFORMATION = 1, UNSTRUCTURED_GEOMETRY = 2, UNSTRUCTURED_CONNECTIVITY = 3, INTERPRETATION_CONNECTIONS = 4 };
+
+		/**
+		* A structure owned by the cache.
+		*/
+		class DLL_IMPORT_OR_EXPORT Entry
+		{
+		public:
+			virtual ~Entry() {}
+
+			/**
+			* Get the count of bytes used by this entry. It is called once, when the entry is put in the cache.
+			*/
+			virtual unsigned long long getByteSize() const = 0;
+		};
+
+		/**
+		* @param byteBudget	The maximum count of bytes of all entries. Zero means no limit.
+		*/
+		GeometryCache(const unsigned long long & byteBudget = 0) : byteSize(0), byteBudget(byteBudget) {}
+
+		/**
+		* The destructor releases all entries.
+		*/
+		~GeometryCache() { clear(); }
+
+		/**
+		* Get the entry of a particular kind owned by an object and mark it as the most recently used one.
+		* The returned entry remains valid as long as the returned shared pointer is kept, even if it is evicted from the cache meanwhile.
+		* @return An empty pointer if there is no such entry (never put or evicted).
+		*/
+		std::shared_ptr<Entry> get(const COMMON_NS::AbstractObject* owner, const entryKind & kind);
+
+		/**
+		* Put an entry in the cache, replacing (and releasing) any previous entry of the same kind of the same owner.
+		* Least recently used entries are then evicted until the byte budget is respected. The new entry is never evicted by this call
+		* even if it is bigger than the byte budget on its own.
+		* @param entry	The cache takes the ownership of this entry.
+		* @return		The shared pointer to the new entry.
+		*/
+		std::shared_ptr<Entry> put(const COMMON_NS::AbstractObject* owner, const entryKind & kind, Entry* entry);
+
+		/**
+		* Remove the entry of a particular kind owned by an object from the cache if it exists.
+		*/
+		void release(const COMMON_NS::AbstractObject* owner, const entryKind & kind);
+
+		/**
+		* Remove all entries owned by an object from the cache.
+		* It must be called when the owner is deleted since a new object could later get the same address.
+		*/
+		void releaseAll(const COMMON_NS::AbstractObject* owner);
+
+		/**
+		* Remove all entries from the cache.
+		*/
+		void clear();
+
+		/**
+		* Set the maximum count of bytes of all entries and evict the least recently used entries if necessary.
+		* @param byteBudget	Zero means no limit.
+		*/
+		void setByteBudget(const unsigned long long & byteBudget);
+
+		unsigned long long getByteBudget() const { return byteBudget; }
+
+		/**
+		* Get the count of bytes of all the entries currently in the cache.
+		* The entries which have been evicted but which are still pinned are not counted.
+		*/
+		unsigned long long getByteSize() const { return byteSize; }
+
+		/**
+		* Get the count of entries currently in the cache.
+		*/
+		unsigned int getEntryCount() const { return static_cast<unsigned int>(index.size()); }
+
+	private:
+
+		typedef std::pair<const COMMON_NS::AbstractObject*, entryKind> Key;
+
+		struct Item
+		{
+			Key key;
+			std::shared_ptr<Entry> entry;
+			unsigned long long byteSize;
+		};
+
+		/**
+		* Evict the least recently used entries until the byte budget is respected or only keptCount entries remain.
+		*/
+		void evict(const size_t & keptCount);
+
+		/**
+		* Remove an item from the cache.
+		*/
+		void erase(std::map<Key, std::list<Item>::iterator>::iterator it);
+
+		std::list<Item> lruList; // the most recently used item is at the front
+		std::map<Key, std::list<Item>::iterator> index;
+		unsigned long long byteSize;
+		unsigned long long byteBudget;
+	};
+}
@@ -595,7 +595,21 @@ void HdfProxy::createArrayNd(
 	if (compressionLevel > 0) {
 		hid_t dcpl = H5Pcreate (H5P_DATASET_CREATE);
 		H5Pset_deflate (dcpl, compressionLevel);
-		H5Pset_chunk (dcpl, numDimensions, numValuesInEachDimension);
+		// The array is going to be written slab by slab along its slowest dimension.
+		// Chunking along this dimension prevents from compressing again the whole array at each slab writing.
+		// Several small slabs are grouped in a chunk but a chunk never exceeds half of the default chunk cache (1MB) unless it is a single slab :
+		// otherwise a chunk would not stay in the cache between two slab writings and it would be compressed again at each of them.
+		std::vector<hsize_t> chunkDims(numValuesInEachDimension, numValuesInEachDimension + numDimensions);
+		if (numDimensions > 1 && chunkDims[0] > 0) {
+			hsize_t slabByteSize = H5Tget_size(datatype);
+			for (unsigned int dim = 1; dim < numDimensions; ++dim) {
+				slabByteSize *= numValuesInEachDimension[dim];
+			}
+			const hsize_t maxChunkByteSize = 1 << 19;
+			const hsize_t slabCountPerChunk = slabByteSize == 0 ? 1 : maxChunkByteSize / slabByteSize;
+			chunkDims[0] = slabCountPerChunk == 0 ? 1 : (slabCountPerChunk < chunkDims[0] ? slabCountPerChunk : chunkDims[0]);
+		}
+		H5Pset_chunk (dcpl, numDimensions, &chunkDims[0]);
 
 		dataset = H5Dcreate(grp, datasetName.c_str(), datatype, space, H5P_DEFAULT, dcpl, H5P_DEFAULT);
 		H5Pclose(dcpl);
@@ -747,6 +761,17 @@ void HdfProxy::readArrayNdOfGSoapULong64Values(const std::string & datasetName,
 	readArrayNdOfValues(datasetName, values, H5T_NATIVE_ULLONG);
 }
 
+void HdfProxy::readArrayNdOfGSoapULong64Values(
+	const std::string& datasetName, ULONG64* values,
+	hsize_t* numValuesInEachDimension,
+	hsize_t* offsetInEachDimension,
+	const unsigned int& numDimensions)
+{
+	readArrayNdOfValues(datasetName, values,
+			numValuesInEachDimension, offsetInEachDimension, numDimensions,
+			H5T_NATIVE_ULLONG);
+}
+
 void HdfProxy::readArrayNdOfLongValues(const std::string & datasetName, long* values)
 {
 	readArrayNdOfValues(datasetName, values, H5T_NATIVE_LONG);
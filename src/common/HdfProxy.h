@@ -66,28 +66,6 @@ namespace COMMON_NS
 			const unsigned int & numDimensions,
 			const int & datatype);
 
-		/**
-		* Find the array associated with @p datasetName and read from it.
-		* @param datasetName					The name of the array (potentially with multi dimensions).
-		* @param values							1d array output of values ordered firstly by fastest direction.
-		* @param blockCountPerDimension			Number of blocks to select from the dataspace, in each dimension. They are ordered from fastest index to slowest index.
-		* @param offsetInEachDimension			Offset values in each dimension of the array to read. They are ordered from fastest index to slowest index.
-		* @param strideInEachDimension			Number of elements to move from one block to another in each dimension. They are ordered from fastest index to slowest index.
-		* @param blockSizeInEachDimension		Size of selected blocks in each dimension. They are ordered from fastest index to slowest index.
-		* @param numDimensions					The number of the dimensions of the array to read.
-		* @param datatype 						The hdf datatype of the values to read.
-		* 										If the values are not stored in this particular datatype, then hdf library will try to do a conversion.
-		*/
-		void readArrayNdOfValues(
-			const std::string & datasetName,
-			void* values,
-			unsigned long long * blockCountPerDimension,
-			unsigned long long * offsetInEachDimension,
-			unsigned long long * strideInEachDimension,
-			unsigned long long * blockSizeInEachDimension,
-			const unsigned int & numDimensions,
-			const int & datatype);
-
 		/**
 		* Considering a given dataset, this method selects an hyperslab region to add to an existing selected region or to add to a new selected region.
 		* The dataset is not closed within this method.
@@ -112,22 +90,6 @@ namespace COMMON_NS
 			int & dataset,
 			int & filespace);
 
-		/**
-		* Considering a given dataset, read the double values corresponding to an existing selected region.
-		* @param dataset		ID of the dataset to read from.
-		* @param filespace		ID of the selected region.
-		* @param values			1d array output of double values ordered firstly by fastest direction.
-		* @param slabSize		Number of values to read.
-		* @param datatype 		The hdf datatype of the values to read.
-		* 						If the values are not stored in this particular datatype, then hdf library will try to do a conversion.
-		*/
-		void readArrayNdOfValues(
-			int dataset,
-			int filespace,
-			void* values, 
-			unsigned long long slabSize, 
-			const int & datatype);
-
 	public:
 
 		/**
@@ -391,6 +353,28 @@ namespace COMMON_NS
 		LONG64 readLongAttribute(const std::string & obj_name,
 			const std::string & attr_name) const;
 
+		/**
+		* Find the array associated with @p datasetName and read from it.
+		* @param datasetName					The name of the array (potentially with multi dimensions).
+		* @param values							1d array output of values ordered firstly by fastest direction.
+		* @param blockCountPerDimension			Number of blocks to select from the dataspace, in each dimension. They are ordered from fastest index to slowest index.
+		* @param offsetInEachDimension			Offset values in each dimension of the array to read. They are ordered from fastest index to slowest index.
+		* @param strideInEachDimension			Number of elements to move from one block to another in each dimension. They are ordered from fastest index to slowest index.
+		* @param blockSizeInEachDimension		Size of selected blocks in each dimension. They are ordered from fastest index to slowest index.
+		* @param numDimensions					The number of the dimensions of the array to read.
+		* @param datatype 						The hdf datatype of the values to read.
+		* 										If the values are not stored in this particular datatype, then hdf library will try to do a conversion.
+		*/
+		void readArrayNdOfValues(
+			const std::string & datasetName,
+			void* values,
+			unsigned long long * blockCountPerDimension,
+			unsigned long long * offsetInEachDimension,
+			unsigned long long * strideInEachDimension,
+			unsigned long long * blockSizeInEachDimension,
+			const unsigned int & numDimensions,
+			const int & datatype);
+
 		/**
 		* Read an array Nd of double values stored in a specific dataset
 		* @param datasetName	The absolute dataset name where to read the values
@@ -445,6 +429,22 @@ namespace COMMON_NS
 			void* values,
 			unsigned long long slabSize);
 
+		/**
+		* Considering a given dataset, read the values corresponding to an existing selected region.
+		* @param dataset		ID of the dataset to read from.
+		* @param filespace		ID of the selected region.
+		* @param values			1d array output of values ordered firstly by fastest direction.
+		* @param slabSize		Number of values to read.
+		* @param datatype 		The hdf datatype of the values to read.
+		* 						If the values are not stored in this particular datatype, then hdf library will try to do a conversion.
+		*/
+		void readArrayNdOfValues(
+			int dataset,
+			int filespace,
+			void* values,
+			unsigned long long slabSize,
+			const int & datatype);
+
 		/**
 		* Read an array Nd of float values stored in a specific dataset.
 		* @param datasetName	The absolute dataset name where to read the values
@@ -480,6 +480,22 @@ namespace COMMON_NS
 		*/
 		void readArrayNdOfGSoapULong64Values(const std::string & datasetName, ULONG64* values);
 
+		/**
+		* Find the array associated with datasetName and read from it.
+		* @param datasetName                    The name of the array (potentially with multi dimensions).
+		* @param values                         1d array output of unsigned 64 bits values ordered firstly by fastest direction. The values must be pre-allocated and won't be freed by this method.
+		* @param numValuesInEachDimension       Number of values in each dimension of the array to read. They are ordered from fastest index to slowest index.
+		* @param offsetValuesInEachDimension    Offset values in each dimension of the array to read. They are ordered from fastest index to slowest index.
+		* @param numDimensions                  The number of the dimensions of the array to read.
+		*/
+		void readArrayNdOfGSoapULong64Values(
+			const std::string & datasetName,
+			ULONG64* values,
+			unsigned long long * numValuesInEachDimension,
+			unsigned long long * offsetInEachDimension,
+			const unsigned int & numDimensions
+		);
+
 		/**
 		* Read an array Nd of long values stored in a specific dataset.
 		* @param datasetName	The absolute dataset name where to read the values
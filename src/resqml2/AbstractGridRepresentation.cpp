@@ -444,6 +444,152 @@ bool AbstractGridRepresentation::hasForcedNonRegridedParentCell() const
 	}
 }
 
+gsoap_resqml2_0_1::resqml2__AbstractIntegerArray* AbstractGridRepresentation::getForcedNonRegridedParentCell2_0_1() const
+{
+	gsoap_resqml2_0_1::resqml2__AbstractParentWindow* parentWindow = getParentWindow2_0_1();
+
+	if (parentWindow != nullptr) {
+		if (parentWindow->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IjkParentWindow) {
+			return static_cast<gsoap_resqml2_0_1::resqml2__IjkParentWindow*>(parentWindow)->OmitParentCells;
+		}
+		else if (parentWindow->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__ColumnLayerParentWindow) {
+			return static_cast<gsoap_resqml2_0_1::resqml2__ColumnLayerParentWindow*>(parentWindow)->OmitParentCells;
+		}
+
+		return nullptr;
+	}
+	else {
+		throw invalid_argument("There is no parent window on this grid.");
+	}
+}
+
+ULONG64 AbstractGridRepresentation::getForcedNonRegridedParentCellCount() const
+{
+	if (gsoapProxy2_0_1 != nullptr) {
+		gsoap_resqml2_0_1::resqml2__AbstractIntegerArray* omitParentCells = getForcedNonRegridedParentCell2_0_1();
+
+		if (omitParentCells == nullptr) {
+			return 0;
+		}
+		else if (omitParentCells->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerConstantArray) {
+			return static_cast<gsoap_resqml2_0_1::resqml2__IntegerConstantArray*>(omitParentCells)->Count;
+		}
+		else if (omitParentCells->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array) {
+			return hdfProxy->getElementCount(static_cast<gsoap_resqml2_0_1::resqml2__IntegerHdf5Array*>(omitParentCells)->Values->PathInHdfFile);
+		}
+		else {
+			throw logic_error("Not implemented yet");
+		}
+	}
+	else {
+		throw logic_error("Not implemented yet");
+	}
+}
+
+void AbstractGridRepresentation::getForcedNonRegridedParentCellIndices(ULONG64 * cellIndices) const
+{
+	if (gsoapProxy2_0_1 != nullptr) {
+		gsoap_resqml2_0_1::resqml2__AbstractIntegerArray* omitParentCells = getForcedNonRegridedParentCell2_0_1();
+
+		if (omitParentCells == nullptr) {
+			throw invalid_argument("There is no forced non regrided parent cell.");
+		}
+		else if (omitParentCells->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerConstantArray) {
+			for (ULONG64 i = 0; i < static_cast<gsoap_resqml2_0_1::resqml2__IntegerConstantArray*>(omitParentCells)->Count; ++i) {
+				cellIndices[i] = static_cast<gsoap_resqml2_0_1::resqml2__IntegerConstantArray*>(omitParentCells)->Value;
+			}
+		}
+		else if (omitParentCells->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array) {
+			hdfProxy->readArrayNdOfGSoapULong64Values(static_cast<gsoap_resqml2_0_1::resqml2__IntegerHdf5Array*>(omitParentCells)->Values->PathInHdfFile, cellIndices);
+		}
+		else {
+			throw logic_error("Not implemented yet");
+		}
+	}
+	else {
+		throw logic_error("Not implemented yet");
+	}
+}
+
+gsoap_resqml2_0_1::__resqml2__CellOverlap_sequence* AbstractGridRepresentation::getCellOverlap2_0_1() const
+{
+	gsoap_resqml2_0_1::resqml2__AbstractParentWindow* parentWindow = getParentWindow2_0_1();
+
+	if (parentWindow != nullptr) {
+		return parentWindow->CellOverlap == nullptr ? nullptr : parentWindow->CellOverlap->__CellOverlap_sequence;
+	}
+	else {
+		throw invalid_argument("There is no parent window on this grid.");
+	}
+}
+
+bool AbstractGridRepresentation::hasCellOverlap() const
+{
+	if (gsoapProxy2_0_1 != nullptr) {
+		return getCellOverlap2_0_1() != nullptr;
+	}
+	else {
+		throw logic_error("Not implemented yet");
+	}
+}
+
+ULONG64 AbstractGridRepresentation::getCellOverlapCount() const
+{
+	if (gsoapProxy2_0_1 != nullptr) {
+		gsoap_resqml2_0_1::__resqml2__CellOverlap_sequence* cellOverlap = getCellOverlap2_0_1();
+		return cellOverlap == nullptr ? 0 : cellOverlap->Count;
+	}
+	else {
+		throw logic_error("Not implemented yet");
+	}
+}
+
+void AbstractGridRepresentation::getCellOverlapParentChildCellPairs(ULONG64 * parentChildCellPairs) const
+{
+	if (gsoapProxy2_0_1 != nullptr) {
+		gsoap_resqml2_0_1::__resqml2__CellOverlap_sequence* cellOverlap = getCellOverlap2_0_1();
+
+		if (cellOverlap == nullptr) {
+			throw invalid_argument("There is no cell overlap information in the parent window.");
+		}
+		else if (cellOverlap->ParentChildCellPairs->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array) {
+			hdfProxy->readArrayNdOfGSoapULong64Values(static_cast<gsoap_resqml2_0_1::resqml2__IntegerHdf5Array*>(cellOverlap->ParentChildCellPairs)->Values->PathInHdfFile, parentChildCellPairs);
+		}
+		else {
+			throw invalid_argument("The parent child cell pairs can only be stored in HDF5 file.");
+		}
+	}
+	else {
+		throw logic_error("Not implemented yet");
+	}
+}
+
+bool AbstractGridRepresentation::hasCellOverlapVolume() const
+{
+	if (gsoapProxy2_0_1 != nullptr) {
+		gsoap_resqml2_0_1::__resqml2__CellOverlap_sequence* cellOverlap = getCellOverlap2_0_1();
+		return cellOverlap != nullptr && cellOverlap->OverlapVolume != nullptr && cellOverlap->OverlapVolume->__OverlapVolume_sequence != nullptr;
+	}
+	else {
+		throw logic_error("Not implemented yet");
+	}
+}
+
+void AbstractGridRepresentation::getCellOverlapVolumes(double * overlapVolumes) const
+{
+	if (!hasCellOverlapVolume()) {
+		throw invalid_argument("There is no overlap volume in the parent window.");
+	}
+
+	gsoap_resqml2_0_1::resqml2__AbstractDoubleArray* volumes = getCellOverlap2_0_1()->OverlapVolume->__OverlapVolume_sequence->OverlapVolumes;
+	if (volumes->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__DoubleHdf5Array) {
+		hdfProxy->readArrayNdOfDoubleValues(static_cast<gsoap_resqml2_0_1::resqml2__DoubleHdf5Array*>(volumes)->Values->PathInHdfFile, overlapVolumes);
+	}
+	else {
+		throw invalid_argument("The overlap volumes can only be stored in HDF5 file.");
+	}
+}
+
 void AbstractGridRepresentation::setCellOverlap(const ULONG64 & parentChildCellPairCount, ULONG64 * parentChildCellPair,
 	const gsoap_resqml2_0_1::eml20__VolumeUom & volumeUom, double * overlapVolumes)
 {
@@ -967,6 +1113,64 @@ void AbstractGridRepresentation::getRegridChildCellWeights(const char & dimensio
 	}
 }
 
+gsoap_resqml2_0_1::resqml2__AbstractDoubleArray* AbstractGridRepresentation::getRegridChildCellWeights2_0_1(const char & dimension) const
+{
+	gsoap_resqml2_0_1::resqml2__AbstractParentWindow* parentWindow = getParentWindow2_0_1();
+	if (parentWindow == nullptr) {
+		throw invalid_argument("There is no parent window on this grid.");
+	}
+
+	gsoap_resqml2_0_1::resqml2__Regrid* regrid = nullptr;
+	if (parentWindow->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IjkParentWindow) {
+		gsoap_resqml2_0_1::resqml2__IjkParentWindow* ijkpw = static_cast<gsoap_resqml2_0_1::resqml2__IjkParentWindow*>(parentWindow);
+		if (dimension == 'i' || dimension == 'I') {
+			regrid = ijkpw->IRegrid;
+		}
+		else if (dimension == 'j' || dimension == 'J') {
+			regrid = ijkpw->JRegrid;
+		}
+		else if (dimension == 'k' || dimension == 'K') {
+			regrid = ijkpw->KRegrid;
+		}
+		else {
+			throw invalid_argument("Only i, j or k dimension can be accessed for an IJK Parent Window.");
+		}
+	}
+	else if (parentWindow->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__ColumnLayerParentWindow) {
+		if (dimension == 'k' || dimension == 'K') {
+			regrid = static_cast<gsoap_resqml2_0_1::resqml2__ColumnLayerParentWindow*>(parentWindow)->KRegrid;
+		}
+		else {
+			throw invalid_argument("Only k dimension can be accessed for a ColumnLayer Parent Window.");
+		}
+	}
+	else {
+		throw invalid_argument("The parent window has not got any regrid information.");
+	}
+
+	return regrid->Intervals == nullptr ? nullptr : regrid->Intervals->ChildCellWeights;
+}
+
+void AbstractGridRepresentation::getRegridChildCellWeights(const char & dimension, double * childCellWeights) const
+{
+	if (gsoapProxy2_0_1 != nullptr) {
+		gsoap_resqml2_0_1::resqml2__AbstractDoubleArray* weights = getRegridChildCellWeights2_0_1(dimension);
+		if (weights == nullptr) {
+			throw invalid_argument("There is no child cell weights for this regrid.");
+		}
+
+		if (weights->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__DoubleHdf5Array) {
+			hdfProxy->readArrayNdOfDoubleValues(static_cast<gsoap_resqml2_0_1::resqml2__DoubleHdf5Array*>(weights)->Values->PathInHdfFile, childCellWeights);
+		}
+		else {
+			throw invalid_argument("ChildCellWeights should be in HDF5 file.");
+		}
+	}
+	else {
+		throw logic_error("Not implemented yet");
+	}
+}
+
 void AbstractGridRepresentation::importRelationshipSetFromEpc(COMMON_NS::EpcDocument* epcDoc)
 {
 	AbstractRepresentation::importRelationshipSetFromEpc(epcDoc);
@@ -48,6 +48,22 @@ namespace RESQML2_NS
 
 		gsoap_resqml2_0_1::resqml2__AbstractParentWindow* getParentWindow2_0_1() const;
 
+		/*
+		* @param	dimension					It must be either 'i', 'j' ou 'k' (upper or lower case) for an ijk parent grid. 'k' for a strict column layer parent grid.
+		* @return	nullptr if the regrid of this dimension has got no child cell weights.
+		*/
+		gsoap_resqml2_0_1::resqml2__AbstractDoubleArray* getRegridChildCellWeights2_0_1(const char & dimension) const;
+
+		/*
+		* @return	The omitted parent cells of an ijk or column layer parent window. nullptr if there is no omitted parent cell.
+		*/
+		gsoap_resqml2_0_1::resqml2__AbstractIntegerArray* getForcedNonRegridedParentCell2_0_1() const;
+
+		/*
+		* @return	The cell overlap of the parent window. nullptr if there is no cell overlap information.
+		*/
+		gsoap_resqml2_0_1::__resqml2__CellOverlap_sequence* getCellOverlap2_0_1() const;
+
 	protected:
 
 		/**
@@ -311,12 +327,58 @@ namespace RESQML2_NS
 		*/
 		void getRegridChildCellWeights(const char & dimension, ULONG64 * childCellWeights) const;
 
+		/**
+		* Only run this method for an ijk parent grid or a strict column layer parent grid.
+		* Same as above but without truncating the weights to integers.
+		* @param	dimension			It must be either 'i', 'j' ou 'k' (upper or lower case) for an ijk parent grid. 'k' for a strict column layer parent grid.
+		* @param	childCellWeights	This array must have been preallocated with a size equal to the sum of ChildCellCountPerInterval.
+		*/
+		void getRegridChildCellWeights(const char & dimension, double * childCellWeights) const;
+
 		/**
 		* When a parent windows has been defined, this method checks if some parent cells have been noted to be forced not to be regridded.
 		* It mainly occurs in case of non-rectangular local grids.
 		*/
 		bool hasForcedNonRegridedParentCell() const;
 
+		/**
+		* Get the count of parent cells which are forced not to be regridded.
+		*/
+		ULONG64 getForcedNonRegridedParentCellCount() const;
+
+		/**
+		* Get the indices of the parent cells which are forced not to be regridded.
+		* @param cellIndices	This array must have been preallocated with a size of getForcedNonRegridedParentCellCount().
+		*/
+		void getForcedNonRegridedParentCellIndices(ULONG64 * cellIndices) const;
+
+		/**
+		* Check if the parent window contains some explicit cell volume overlap information between this (child) grid and the parent grid.
+		*/
+		bool hasCellOverlap() const;
+
+		/**
+		* Get the count of parent/child cell pairs of the cell overlap information.
+		*/
+		ULONG64 getCellOverlapCount() const;
+
+		/**
+		* Get the parent/child cell pairs of the cell overlap information.
+		* @param parentChildCellPairs	This array must have been preallocated with a size of 2 * getCellOverlapCount(). The parent cell index comes first in each pair.
+		*/
+		void getCellOverlapParentChildCellPairs(ULONG64 * parentChildCellPairs) const;
+
+		/**
+		* Check if the cell overlap information contains the overlap volume of each parent/child cell pair.
+		*/
+		bool hasCellOverlapVolume() const;
+
+		/**
+		* Get the overlap volume of each parent/child cell pair of the cell overlap information.
+		* @param overlapVolumes	This array must have been preallocated with a size of getCellOverlapCount().
+		*/
+		void getCellOverlapVolumes(double * overlapVolumes) const;
+
 		//************************************************************
 		//**************** LINK WITH STRATIGRAPHY ********************
 		//************************************************************
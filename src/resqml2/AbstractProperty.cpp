@@ -396,6 +396,30 @@ unsigned int AbstractProperty::getTimeIndex() const
 	}
 }
 
+unsigned int AbstractProperty::getSeriesTimeIndexCount() const
+{
+	if (gsoapProxy2_0_1 != nullptr) {
+		gsoap_resqml2_0_1::resqml2__TimeIndices* timeIndices = nullptr;
+		if (gsoapProxy2_0_1->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__obj_USCORECategoricalPropertySeries) {
+			timeIndices = static_cast<gsoap_resqml2_0_1::_resqml2__CategoricalPropertySeries*>(gsoapProxy2_0_1)->SeriesTimeIndices;
+		}
+		else if (gsoapProxy2_0_1->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__obj_USCORECommentPropertySeries) {
+			timeIndices = static_cast<gsoap_resqml2_0_1::_resqml2__CommentPropertySeries*>(gsoapProxy2_0_1)->SeriesTimeIndices;
+		}
+		else if (gsoapProxy2_0_1->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__obj_USCOREContinuousPropertySeries) {
+			timeIndices = static_cast<gsoap_resqml2_0_1::_resqml2__ContinuousPropertySeries*>(gsoapProxy2_0_1)->SeriesTimeIndices;
+		}
+		else if (gsoapProxy2_0_1->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__obj_USCOREDiscretePropertySeries) {
+			timeIndices = static_cast<gsoap_resqml2_0_1::_resqml2__DiscretePropertySeries*>(gsoapProxy2_0_1)->SeriesTimeIndices;
+		}
+
+		return timeIndices == nullptr ? 0 : static_cast<unsigned int>(timeIndices->TimeIndexCount);
+	}
+	else {
+		throw logic_error("Not implemented yet");
+	}
+}
+
 void AbstractProperty::setHdfProxy(COMMON_NS::AbstractHdfProxy * proxy)
 {
 	if (proxy == nullptr) {
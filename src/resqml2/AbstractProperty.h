@@ -126,6 +126,12 @@ namespace RESQML2_NS
 		*/
 		unsigned int getTimeIndex() const;
 
+		/**
+		* Get the count of time indices of this property if it is a property series (i.e. values are given for several time indices in a single property).
+		* @return The count of time indices or zero if this property is not a property series.
+		*/
+		unsigned int getSeriesTimeIndexCount() const;
+
 		/**
 		* Set the Hdf Proxy where the numerical values are stored.
 		*/
@@ -228,6 +228,14 @@ AbstractValuesProperty* AbstractRepresentation::getValuesProperty(const unsigned
 	}
 }
 
+void AbstractRepresentation::loadValuesPropertySetOfPatch(const unsigned int & patchIndex,
+	std::map<std::string, std::vector<double> > & doubleColumns, std::map<std::string, std::vector<long> > & longColumns,
+	std::map<std::string, long> & longNullValues,
+	const indexing::BitSet * activeElements) const
+{
+	AbstractValuesProperty::loadValuesOfPatch(getValuesPropertySet(), patchIndex, doubleColumns, longColumns, longNullValues, activeElements);
+}
+
 void AbstractRepresentation::setInterpretation(AbstractFeatureInterpretation * interp)
 {
 	if (interp == nullptr) {
@@ -19,6 +19,7 @@ under the License.
 #pragma once
 
 #include <set>
+#include <map>
 
 #include "resqml2/AbstractProperty.h"
 
@@ -26,6 +27,10 @@ namespace COMMON_NS {
 	class AbstractHdfProxy;
 }
 
+namespace indexing {
+	class BitSet;
+}
+
 namespace RESQML2_NS
 {
 	class DLL_IMPORT_OR_EXPORT AbstractRepresentation : public COMMON_NS::AbstractObject
@@ -140,6 +145,17 @@ namespace RESQML2_NS
 		*/
 		class AbstractValuesProperty* getValuesProperty(const unsigned int & index) const;
 
+		/**
+		* Load all the values of a patch of all the values properties which use this representation as support.
+		* It is a columnar table where the values of each property are indexed by the property uuid (see AbstractValuesProperty::loadValuesOfPatch).
+		* @param longNullValues	The null value of each loaded long column indexed by the property uuid.
+		* @param activeElements	If not null, only the values of the elements corresponding to a set bit are loaded (for instance the enabled cells of an IJK grid).
+		*/
+		void loadValuesPropertySetOfPatch(const unsigned int & patchIndex,
+			std::map<std::string, std::vector<double> > & doubleColumns, std::map<std::string, std::vector<long> > & longColumns,
+			std::map<std::string, long> & longNullValues,
+			const indexing::BitSet * activeElements = nullptr) const;
+
 		/**
 		 * Set the interpretation which is associated to this representation.
 		 * And push back this representation as a representation of the interpreation as well.
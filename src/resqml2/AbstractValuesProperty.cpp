@@ -19,6 +19,7 @@ under the License.
 #include "resqml2/AbstractValuesProperty.h"
 
 #include <stdexcept>
+#include <algorithm>
 #include <ostream>
 #include <sstream>
 
@@ -29,10 +30,422 @@ under the License.
 #include "resqml2/AbstractLocal3dCrs.h"
 #include "common/AbstractHdfProxy.h"
 
+#include "tools/Parallel.h"
+
 using namespace RESQML2_NS;
 using namespace std;
 using namespace epc;
 
+namespace {
+	/**
+	* Decode in place the values of a dataset if they are scaled codes (see RESQML2_0_1_NS::ContinuousProperty::encodingEnum) and then transform them into value * scale + offset.
+	* Codes have already been converted to T by HDF5 at reading.
+	*/
+	template <class T> void decodeScaledValuesOfDataset(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, T * values, const ULONG64 & valueCount,
+		const double & scale, const double & offset)
+	{
+		const double codeScale = hdfProxy->getHdfDatatypeClassInDataset(datasetName) == H5T_INTEGER
+			? hdfProxy->readDoubleAttribute(datasetName, "scale_factor")
+			: std::numeric_limits<double>::quiet_NaN();
+		if (codeScale == codeScale) {
+			// Fold the transformation into the decoding
+			const double totalScale = codeScale * scale;
+			const double totalOffset = hdfProxy->readDoubleAttribute(datasetName, "add_offset") * scale + offset;
+			const T fillValue = static_cast<T>(hdfProxy->readDoubleAttribute(datasetName, "_FillValue"));
+
+			// branch free in order to allow vectorization
+			parallel::forEachRange(valueCount, 65536, [&](const unsigned int &, const uint64_t & begin, const uint64_t & end) {
+				for (uint64_t i = begin; i < end; ++i) {
+					values[i] = values[i] == fillValue ? std::numeric_limits<T>::quiet_NaN() : static_cast<T>(values[i] * totalScale + totalOffset);
+				}
+			});
+		}
+		else if (scale != 1 || offset != 0) {
+			// NaN values remain NaN
+			parallel::forEachRange(valueCount, 65536, [&](const unsigned int &, const uint64_t & begin, const uint64_t & end) {
+				for (uint64_t i = begin; i < end; ++i) {
+					values[i] = static_cast<T>(values[i] * scale + offset);
+				}
+			});
+		}
+	}
+
+	/**
+	* A planned read of all the values of a patch of a property.
+	*/
+	struct PatchRead
+	{
+		RESQML2_NS::AbstractValuesProperty* property;
+		COMMON_NS::AbstractHdfProxy* hdfProxy;
+		std::string datasetName;
+		bool isDouble;
+		ULONG64 valueCount;
+		LONG64 nullValue;
+	};
+
+	/**
+	* Order the reads by HDF file and then by dataset in order to read each file sequentially.
+	*/
+	bool isReadBefore(const PatchRead & left, const PatchRead & right)
+	{
+		if (left.hdfProxy != right.hdfProxy) {
+			return left.hdfProxy->getRelativePath() < right.hdfProxy->getRelativePath();
+		}
+		return left.datasetName < right.datasetName;
+	}
+
+	/**
+	* Keep only the values of the active elements.
+	* Large arrays are compacted concurrently into a new array : each thread copies a range of elements at the position given by the rank of its first element.
+	*/
+	template <class T> void compactValues(std::vector<T> & values, const indexing::BitSet & activeElements, const ULONG64 & valueCountPerElement)
+	{
+		if (activeElements.size() * valueCountPerElement != values.size()) {
+			throw invalid_argument("The count of active element flags does not match the count of elements of the property patch.");
+		}
+
+		const unsigned int chunkCount = parallel::getChunkCount(values.size(), 65536);
+		if (chunkCount > 1) {
+			activeElements.buildDirectory();
+			std::vector<T> compacted(activeElements.count() * valueCountPerElement);
+			parallel::forEachChunk(activeElements.size(), chunkCount, [&](const unsigned int &, const uint64_t & begin, const uint64_t & end) {
+				ULONG64 outIndex = activeElements.rank(begin) * valueCountPerElement;
+				for (uint64_t element = begin; element < end; ++element) {
+					if (activeElements.test(element)) {
+						for (ULONG64 i = 0; i < valueCountPerElement; ++i) {
+							compacted[outIndex++] = values[element * valueCountPerElement + i];
+						}
+					}
+				}
+			});
+			values.swap(compacted);
+			return;
+		}
+
+		if (valueCountPerElement == 1) {
+			values.resize(activeElements.compact(values.empty() ? nullptr : &values[0], values.empty() ? nullptr : &values[0]));
+			return;
+		}
+
+		ULONG64 outIndex = 0;
+		for (ULONG64 element = 0; element < activeElements.size(); ++element) {
+			if (activeElements.test(element)) {
+				for (ULONG64 i = 0; i < valueCountPerElement; ++i) {
+					values[outIndex++] = values[element * valueCountPerElement + i];
+				}
+			}
+		}
+		values.resize(outIndex);
+	}
+
+	/**
+	* Copy some long values into a narrower integer type, replacing the null values.
+	*/
+	template <class T> void narrowValues(const long * values, const ULONG64 & valueCount, const long & nullValue, const T & narrowedNullValue, std::vector<T> & narrowedValues)
+	{
+		narrowedValues.resize(valueCount);
+		// branch free in order to allow vectorization
+		for (ULONG64 i = 0; i < valueCount; ++i) {
+			narrowedValues[i] = values[i] == nullValue ? narrowedNullValue : static_cast<T>(values[i]);
+		}
+	}
+
+	/**
+	* An hyperslab of an HDF5 dataset. Counts and offsets are ordered from the slowest to the fastest dimension.
+	*/
+	struct Hyperslab
+	{
+		std::vector<unsigned long long> counts;
+		std::vector<unsigned long long> offsets;
+
+		ULONG64 getElementCount() const
+		{
+			ULONG64 result = 1;
+			for (size_t d = 0; d < counts.size(); ++d) {
+				result *= counts[d];
+			}
+			return result;
+		}
+	};
+
+	/**
+	* Decompose a range [start, end) of linearized indices of a multidimensional dataset into a few hyperslabs (at most two per dimension).
+	* @param dimensions	The count of values in each dimension of the dataset, ordered from the slowest to the fastest dimension.
+	*/
+	void getHyperslabsOfRange(const std::vector<unsigned long long> & dimensions, ULONG64 start, const ULONG64 & end, std::vector<Hyperslab> & hyperslabs)
+	{
+		const size_t dimCount = dimensions.size();
+		std::vector<ULONG64> strides(dimCount, 1);
+		for (size_t d = dimCount - 1; d > 0; --d) {
+			strides[d - 1] = strides[d] * dimensions[d];
+		}
+
+		while (start < end) {
+			// The slowest dimension whose whole sub-blocks can start the hyperslab
+			size_t slabDim = 0;
+			while (start % strides[slabDim] != 0 || strides[slabDim] > end - start) {
+				++slabDim;
+			}
+			const ULONG64 indexInDim = (start / strides[slabDim]) % dimensions[slabDim];
+			ULONG64 count = (end - start) / strides[slabDim];
+			if (count > dimensions[slabDim] - indexInDim) {
+				count = dimensions[slabDim] - indexInDim;
+			}
+
+			Hyperslab hyperslab;
+			hyperslab.counts.resize(dimCount);
+			hyperslab.offsets.resize(dimCount);
+			for (size_t d = 0; d < dimCount; ++d) {
+				hyperslab.offsets[d] = (start / strides[d]) % dimensions[d];
+				hyperslab.counts[d] = d < slabDim ? 1 : (d == slabDim ? count : dimensions[d]);
+			}
+			hyperslabs.push_back(hyperslab);
+			start += count * strides[slabDim];
+		}
+	}
+
+	void readHyperslab(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, Hyperslab & hyperslab, double * values)
+	{
+		hdfProxy->readArrayNdOfDoubleValues(datasetName, values, &hyperslab.counts[0], &hyperslab.offsets[0], hyperslab.counts.size());
+	}
+
+	void readHyperslab(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, Hyperslab & hyperslab, long * values)
+	{
+		hdfProxy->readArrayNdOfLongValues(datasetName, values, &hyperslab.counts[0], &hyperslab.offsets[0], hyperslab.counts.size());
+	}
+
+	/**
+	* Read the values of a range [start, end) of linearized indices of a dataset.
+	* Scaled integer codes are decoded (see AbstractValuesProperty::decodeScaledValues).
+	* @param values	It is resized to the count of values of the range.
+	*/
+	void readRange(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, const std::vector<unsigned long long> & dimensions,
+		const ULONG64 & start, const ULONG64 & end, double * values)
+	{
+		std::vector<Hyperslab> hyperslabs;
+		getHyperslabsOfRange(dimensions, start, end, hyperslabs);
+		ULONG64 valueIndex = 0;
+		for (size_t slab = 0; slab < hyperslabs.size(); ++slab) {
+			readHyperslab(hdfProxy, datasetName, hyperslabs[slab], values + valueIndex);
+			valueIndex += hyperslabs[slab].getElementCount();
+		}
+		if (!hyperslabs.empty()) {
+			decodeScaledValuesOfDataset(hdfProxy, datasetName, values, end - start, 1, 0);
+		}
+	}
+
+	void readRange(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, const std::vector<unsigned long long> & dimensions,
+		const ULONG64 & start, const ULONG64 & end, std::vector<double> & values)
+	{
+		values.resize(end - start);
+		if (!values.empty()) {
+			readRange(hdfProxy, datasetName, dimensions, start, end, &values[0]);
+		}
+	}
+
+	enum ChunkMatch { NO_MATCH, FULL_MATCH, PARTIAL_MATCH };
+
+	/**
+	* The values of a property patch which are read chunk by chunk in order to be compared to a range [minimumValue, maximumValue].
+	*/
+	struct ChunkedValues
+	{
+		COMMON_NS::AbstractHdfProxy* hdfProxy;
+		std::string datasetName;
+		std::vector<unsigned long long> dimensions;
+		ULONG64 valueCount;
+		double nullValue;
+		double minimumValue;
+		double maximumValue;
+
+		// Chunk summary. chunkValueCount is zero if there is no summary.
+		ULONG64 chunkValueCount;
+		std::vector<double> minimums;
+		std::vector<double> maximums;
+		std::vector<ULONG64> validCounts;
+
+		/**
+		* Check, thanks to the chunk summary, if the values of a chunk [start, end) can match.
+		* The summary can only be used if its chunks are the same as the queried ones.
+		*/
+		ChunkMatch getMatch(const ULONG64 & start, const ULONG64 & end) const
+		{
+			if (chunkValueCount == 0 || start % chunkValueCount != 0 || (end - start != chunkValueCount && end != valueCount)) {
+				return PARTIAL_MATCH;
+			}
+			const size_t chunk = start / chunkValueCount;
+			if (validCounts[chunk] == 0 || maximums[chunk] < minimumValue || minimums[chunk] > maximumValue) {
+				return NO_MATCH;
+			}
+			if (validCounts[chunk] == end - start && minimums[chunk] >= minimumValue && maximums[chunk] <= maximumValue) {
+				return FULL_MATCH;
+			}
+			return PARTIAL_MATCH;
+		}
+
+		/**
+		* Unselect the values which are not in the range or which are null. NaN values are never in the range.
+		* @return false if no more value is selected.
+		*/
+		bool evaluate(const std::vector<double> & values, std::vector<unsigned char> & isSelected) const
+		{
+			// branch free in order to allow vectorization
+			unsigned char isAnySelected = 0;
+			for (size_t i = 0; i < values.size(); ++i) {
+				const double value = values[i];
+				isSelected[i] &= static_cast<unsigned char>((value >= minimumValue) & (value <= maximumValue) & (value != nullValue));
+				isAnySelected |= isSelected[i];
+			}
+			return isAnySelected != 0;
+		}
+	};
+
+	/**
+	* A chunk which has not been discarded by the chunk summaries and whose values are evaluated by a thread.
+	*/
+	struct SelectedChunk
+	{
+		ULONG64 start;
+		ULONG64 end;
+		std::vector<size_t> propertiesToRead;	// empty if the chunk entirely matches
+		std::vector<double> buffer;				// the values of the property currently evaluated
+		std::vector<unsigned char> isSelected;
+		bool canMatch;
+		std::vector< std::pair<ULONG64, ULONG64> > selectedRanges;
+	};
+
+	/**
+	* Get the ranges of an index set after having checked they are in a dataset.
+	*/
+	void getRangesInDataset(const indexing::IndexSet & elementIndices, const std::vector<unsigned long long> & dimensions,
+		std::vector< std::pair<uint64_t, uint64_t> > & ranges)
+	{
+		elementIndices.getRanges(ranges);
+		ULONG64 valueCount = 1;
+		for (size_t d = 0; d < dimensions.size(); ++d) {
+			valueCount *= dimensions[d];
+		}
+		if (!ranges.empty() && ranges.back().second > valueCount) {
+			throw out_of_range("An element index is out of the range of the property values.");
+		}
+	}
+
+	/**
+	* Read the hyperslabs touched by the element indices and gather the selected values.
+	*/
+	template <class T> void gatherValues(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, const indexing::IndexSet & elementIndices, T * values, const ULONG64 & maxGap)
+	{
+		const std::vector<unsigned long long> dimensions = hdfProxy->readArrayDimensions(datasetName);
+		std::vector< std::pair<uint64_t, uint64_t> > ranges;
+		getRangesInDataset(elementIndices, dimensions, ranges);
+
+		const ULONG64 maxWindowSize = 1 << 22;
+		std::vector<T> buffer;
+		std::vector<Hyperslab> hyperslabs;
+		ULONG64 valueIndex = 0;
+		size_t range = 0;
+		while (range < ranges.size()) {
+			// Coalesce the following ranges which are close enough into a single read window
+			size_t lastRange = range;
+			while (lastRange + 1 < ranges.size() && ranges[lastRange + 1].first - ranges[lastRange].second <= maxGap &&
+				ranges[lastRange + 1].second - ranges[range].first <= maxWindowSize) {
+				++lastRange;
+			}
+			const ULONG64 windowStart = ranges[range].first;
+			buffer.resize(ranges[lastRange].second - windowStart);
+
+			hyperslabs.clear();
+			getHyperslabsOfRange(dimensions, windowStart, ranges[lastRange].second, hyperslabs);
+			ULONG64 bufferIndex = 0;
+			for (size_t slab = 0; slab < hyperslabs.size(); ++slab) {
+				readHyperslab(hdfProxy, datasetName, hyperslabs[slab], &buffer[bufferIndex]);
+				bufferIndex += hyperslabs[slab].getElementCount();
+			}
+
+			// Each run is a contiguous copy
+			for (; range <= lastRange; ++range) {
+				const T* source = &buffer[ranges[range].first - windowStart];
+				const ULONG64 runSize = ranges[range].second - ranges[range].first;
+				T* destination = values + valueIndex;
+				for (ULONG64 i = 0; i < runSize; ++i) {
+					destination[i] = source[i];
+				}
+				valueIndex += runSize;
+			}
+		}
+	}
+
+	/**
+	* Write the runs of consecutive element indices as hyperslabs.
+	* Runs which are separated by at most maxGap unselected elements are written at once : the window covering them is read, updated and written back.
+	* The dataset must follow the fesapi naming convention "/RESQML/" + groupName + "/" + name.
+	*/
+	template <class T> void scatterValues(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, const int & datatype, const indexing::IndexSet & elementIndices, const T * values, const ULONG64 & maxGap)
+	{
+		const size_t groupStart = datasetName.find("/RESQML/") == 0 ? 8 : std::string::npos;
+		const size_t nameStart = groupStart == std::string::npos ? std::string::npos : datasetName.find('/', groupStart);
+		if (nameStart == std::string::npos || datasetName.find('/', nameStart + 1) != std::string::npos) {
+			throw invalid_argument("The dataset " + datasetName + " does not follow the fesapi naming convention and cannot be written.");
+		}
+		const std::string groupName = datasetName.substr(groupStart, nameStart - groupStart);
+		const std::string name = datasetName.substr(nameStart + 1);
+
+		const std::vector<unsigned long long> dimensions = hdfProxy->readArrayDimensions(datasetName);
+		std::vector< std::pair<uint64_t, uint64_t> > ranges;
+		getRangesInDataset(elementIndices, dimensions, ranges);
+
+		const ULONG64 maxWindowSize = 1 << 22;
+		std::vector<T> buffer;
+		std::vector<Hyperslab> hyperslabs;
+		ULONG64 valueIndex = 0;
+		size_t range = 0;
+		while (range < ranges.size()) {
+			// Coalesce the following ranges which are close enough into a single write window
+			size_t lastRange = range;
+			while (lastRange + 1 < ranges.size() && ranges[lastRange + 1].first - ranges[lastRange].second <= maxGap &&
+				ranges[lastRange + 1].second - ranges[range].first <= maxWindowSize) {
+				++lastRange;
+			}
+			const ULONG64 windowStart = ranges[range].first;
+			const ULONG64 windowEnd = ranges[lastRange].second;
+			hyperslabs.clear();
+			getHyperslabsOfRange(dimensions, windowStart, windowEnd, hyperslabs);
+
+			const T* windowValues = values + valueIndex;
+			if (lastRange == range) {
+				// A single run is written directly from the input values
+				valueIndex += windowEnd - windowStart;
+				++range;
+			}
+			else {
+				// The unselected elements of the window keep their current values
+				buffer.resize(windowEnd - windowStart);
+				ULONG64 bufferIndex = 0;
+				for (size_t slab = 0; slab < hyperslabs.size(); ++slab) {
+					readHyperslab(hdfProxy, datasetName, hyperslabs[slab], &buffer[bufferIndex]);
+					bufferIndex += hyperslabs[slab].getElementCount();
+				}
+				for (; range <= lastRange; ++range) {
+					T* destination = &buffer[ranges[range].first - windowStart];
+					const ULONG64 runSize = ranges[range].second - ranges[range].first;
+					for (ULONG64 i = 0; i < runSize; ++i) {
+						destination[i] = values[valueIndex + i];
+					}
+					valueIndex += runSize;
+				}
+				windowValues = &buffer[0];
+			}
+
+			ULONG64 windowIndex = 0;
+			for (size_t slab = 0; slab < hyperslabs.size(); ++slab) {
+				hdfProxy->writeArrayNdSlab(groupName, name, datatype, windowValues + windowIndex,
+					&hyperslabs[slab].counts[0], &hyperslabs[slab].offsets[0], hyperslabs[slab].counts.size());
+				windowIndex += hyperslabs[slab].getElementCount();
+			}
+		}
+	}
+}
+
 unsigned int AbstractValuesProperty::getPatchCount() const
 {
 	if (gsoapProxy2_0_1 != nullptr) {
@@ -421,6 +834,20 @@ unsigned int AbstractValuesProperty::getValuesCountOfPatch (const unsigned int &
 	return hdfProxy->getElementCount(getPathInHdfFileOfPatch(patchIndex, nullValue));
 }
 
+std::vector<unsigned long long> AbstractValuesProperty::getValuesCountPerDimensionOfPatch(const unsigned int & patchIndex)
+{
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+	if (hdfProxy == nullptr) {
+		throw invalid_argument("The Hdf proxy cannot be nullptr.");
+	}
+	if (!hdfProxy->isOpened()) {
+		hdfProxy->open();
+	}
+
+	LONG64 nullValue = (numeric_limits<long long>::min)();
+	return hdfProxy->readArrayDimensions(getPathInHdfFileOfPatch(patchIndex, nullValue));
+}
+
 void AbstractValuesProperty::createLongHdf5Array3dOfValues(
 	const unsigned int& valueCountInFastestDim, 
 	const unsigned int& valueCountInMiddleDim, 
@@ -552,3 +979,816 @@ void AbstractValuesProperty::getLongValuesOf3dPatch(
 	);
 }
 
+void AbstractValuesProperty::gatherDoubleValuesOfPatch(const unsigned int & patchIndex, const indexing::IndexSet & elementIndices, double * values, const ULONG64 & maxGap)
+{
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+	if (hdfProxy == nullptr) {
+		throw invalid_argument("The Hdf proxy cannot be nullptr.");
+	}
+
+	LONG64 nullValue = (numeric_limits<LONG64>::min)();
+	const std::string datasetName = getPathInHdfFileOfPatch(patchIndex, nullValue);
+	gatherValues(hdfProxy, datasetName, elementIndices, values, maxGap);
+	decodeScaledValues(hdfProxy, datasetName, values, elementIndices.count());
+}
+
+long AbstractValuesProperty::gatherLongValuesOfPatch(const unsigned int & patchIndex, const indexing::IndexSet & elementIndices, long * values, const ULONG64 & maxGap)
+{
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+	if (hdfProxy == nullptr) {
+		throw invalid_argument("The Hdf proxy cannot be nullptr.");
+	}
+
+	LONG64 nullValue = (numeric_limits<LONG64>::min)();
+	gatherValues(hdfProxy, getPathInHdfFileOfPatch(patchIndex, nullValue), elementIndices, values, maxGap);
+
+	return nullValue;
+}
+
+void AbstractValuesProperty::scatterDoubleValuesOfPatch(const unsigned int & patchIndex, const indexing::IndexSet & elementIndices, const double * values, const ULONG64 & maxGap)
+{
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+	if (hdfProxy == nullptr) {
+		throw invalid_argument("The Hdf proxy cannot be nullptr.");
+	}
+
+	LONG64 nullValue = (numeric_limits<LONG64>::min)();
+	const std::string datasetName = getPathInHdfFileOfPatch(patchIndex, nullValue);
+	if (!hdfProxy->isOpened()) {
+		hdfProxy->open();
+	}
+	const double codeScale = hdfProxy->readDoubleAttribute(datasetName, "scale_factor");
+	if (codeScale == codeScale && hdfProxy->getHdfDatatypeClassInDataset(datasetName) == H5T_INTEGER) {
+		throw logic_error("Cannot scatter values to the scaled integer codes of the patch " + datasetName + ".");
+	}
+	scatterValues(hdfProxy, datasetName, H5T_NATIVE_DOUBLE, elementIndices, values, maxGap);
+}
+
+void AbstractValuesProperty::scatterLongValuesOfPatch(const unsigned int & patchIndex, const indexing::IndexSet & elementIndices, const long * values, const ULONG64 & maxGap)
+{
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+	if (hdfProxy == nullptr) {
+		throw invalid_argument("The Hdf proxy cannot be nullptr.");
+	}
+
+	LONG64 nullValue = (numeric_limits<LONG64>::min)();
+	scatterValues(hdfProxy, getPathInHdfFileOfPatch(patchIndex, nullValue), H5T_NATIVE_LONG, elementIndices, values, maxGap);
+}
+
+ULONG64 AbstractValuesProperty::getChunkSummaryValueCount(const unsigned long long * dimensions, const unsigned int & dimensionCount)
+{
+	if (dimensionCount < 2) {
+		return 65536;
+	}
+
+	ULONG64 result = 1;
+	for (unsigned int dim = 1; dim < dimensionCount; ++dim) {
+		result *= dimensions[dim];
+	}
+	return result == 0 ? 1 : result;
+}
+
+void AbstractValuesProperty::writeChunkSummaryDataset(const std::string & datasetName, const std::vector<double> & summary, const ULONG64 & chunkValueCount, COMMON_NS::AbstractHdfProxy* proxy)
+{
+	if (summary.empty()) {
+		return;
+	}
+
+	hsize_t summaryCount[2] = { summary.size() / 3, 3 };
+	proxy->writeArrayNdOfDoubleValues(getUuid(), datasetName + "_summary", &summary[0], summaryCount, 2);
+	proxy->writeDatasetAttributes(datasetName + "_summary",
+		std::vector<std::string>(1, "chunkValueCount"), std::vector<double>(1, static_cast<double>(chunkValueCount)));
+}
+
+void AbstractValuesProperty::writeChunkSummaryOfPatch(const unsigned int & patchIndex)
+{
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+	if (hdfProxy == nullptr) {
+		throw invalid_argument("The Hdf proxy cannot be nullptr.");
+	}
+
+	LONG64 nullValue = (numeric_limits<LONG64>::min)();
+	const std::string datasetName = getPathInHdfFileOfPatch(patchIndex, nullValue);
+	const std::vector<unsigned long long> dimensions = hdfProxy->readArrayDimensions(datasetName);
+	ULONG64 valueCount = 1;
+	for (size_t d = 0; d < dimensions.size(); ++d) {
+		valueCount *= dimensions[d];
+	}
+	const ULONG64 chunkValueCount = getChunkSummaryValueCount(&dimensions[0], dimensions.size());
+	const double nullDoubleValue = nullValue == (numeric_limits<LONG64>::min)() ? numeric_limits<double>::quiet_NaN() : static_cast<double>(nullValue);
+
+	std::vector<double> summary;
+	std::vector<double> buffer;
+	for (ULONG64 chunkStart = 0; chunkStart < valueCount; chunkStart += chunkValueCount) {
+		const ULONG64 chunkEnd = valueCount - chunkStart < chunkValueCount ? valueCount : chunkStart + chunkValueCount;
+		readRange(hdfProxy, datasetName, dimensions, chunkStart, chunkEnd, buffer);
+		statistics::Accumulator<double> accumulator(nullDoubleValue);
+		accumulator.add(&buffer[0], buffer.size());
+		summary.push_back(accumulator.getMinimum());
+		summary.push_back(accumulator.getMaximum());
+		summary.push_back(static_cast<double>(accumulator.getValidCount()));
+	}
+
+	writeChunkSummaryDataset(datasetName, summary, chunkValueCount, hdfProxy);
+}
+
+bool AbstractValuesProperty::hasChunkSummaryOfPatch(const unsigned int & patchIndex) const
+{
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+	if (hdfProxy == nullptr) {
+		throw invalid_argument("The Hdf proxy cannot be nullptr.");
+	}
+	if (!hdfProxy->isOpened()) {
+		hdfProxy->open();
+	}
+
+	LONG64 nullValue = (numeric_limits<LONG64>::min)();
+	return hdfProxy->exist(getPathInHdfFileOfPatch(patchIndex, nullValue) + "_summary");
+}
+
+ULONG64 AbstractValuesProperty::getChunkSummaryOfPatch(const unsigned int & patchIndex, std::vector<double> & minimums, std::vector<double> & maximums, std::vector<ULONG64> & validCounts) const
+{
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+	if (hdfProxy == nullptr) {
+		throw invalid_argument("The Hdf proxy cannot be nullptr.");
+	}
+
+	LONG64 nullValue = (numeric_limits<LONG64>::min)();
+	const std::string summaryName = getPathInHdfFileOfPatch(patchIndex, nullValue) + "_summary";
+	const std::vector<unsigned long long> dimensions = hdfProxy->readArrayDimensions(summaryName);
+	if (dimensions.size() != 2 || dimensions[1] != 3) {
+		throw invalid_argument("The dataset " + summaryName + " is not a chunk summary.");
+	}
+	const double chunkValueCount = hdfProxy->readDoubleAttribute(summaryName, "chunkValueCount");
+	if (!(chunkValueCount >= 1)) {
+		throw invalid_argument("The dataset " + summaryName + " does not define the count of values of its chunks.");
+	}
+
+	std::vector<double> summary(dimensions[0] * 3);
+	if (!summary.empty()) {
+		hdfProxy->readArrayNdOfDoubleValues(summaryName, &summary[0]);
+	}
+	minimums.resize(dimensions[0]);
+	maximums.resize(dimensions[0]);
+	validCounts.resize(dimensions[0]);
+	for (size_t chunk = 0; chunk < dimensions[0]; ++chunk) {
+		minimums[chunk] = summary[chunk * 3];
+		maximums[chunk] = summary[chunk * 3 + 1];
+		validCounts[chunk] = static_cast<ULONG64>(summary[chunk * 3 + 2]);
+	}
+
+	return static_cast<ULONG64>(chunkValueCount);
+}
+
+void AbstractValuesProperty::selectElementIndicesOfPatch(const unsigned int & patchIndex, const double & minimumValue, const double & maximumValue, indexing::IndexSet & elementIndices) const
+{
+	selectElementIndicesOfPatch(std::vector<const AbstractValuesProperty*>(1, this), std::vector<double>(1, minimumValue), std::vector<double>(1, maximumValue),
+		patchIndex, elementIndices);
+}
+
+void AbstractValuesProperty::selectElementIndicesOfPatch(const std::vector<const AbstractValuesProperty*> & properties,
+	const std::vector<double> & minimumValues, const std::vector<double> & maximumValues,
+	const unsigned int & patchIndex, indexing::IndexSet & elementIndices)
+{
+	if (properties.empty()) {
+		throw invalid_argument("At least one property is needed to select some elements.");
+	}
+	if (minimumValues.size() != properties.size() || maximumValues.size() != properties.size()) {
+		throw invalid_argument("There must be one minimum and one maximum value per property.");
+	}
+
+	// Prepare the reading of the values and of the chunk summaries of each property
+	std::vector<ChunkedValues> chunkedValues(properties.size());
+	for (size_t prop = 0; prop < properties.size(); ++prop) {
+		ChunkedValues & values = chunkedValues[prop];
+		values.hdfProxy = properties[prop]->getHdfProxy();
+		if (values.hdfProxy == nullptr) {
+			throw invalid_argument("The Hdf proxy cannot be nullptr.");
+		}
+		LONG64 nullValue = (numeric_limits<LONG64>::min)();
+		values.datasetName = properties[prop]->getPathInHdfFileOfPatch(patchIndex, nullValue);
+		values.dimensions = values.hdfProxy->readArrayDimensions(values.datasetName);
+		values.valueCount = 1;
+		for (size_t d = 0; d < values.dimensions.size(); ++d) {
+			values.valueCount *= values.dimensions[d];
+		}
+		if (values.valueCount != chunkedValues[0].valueCount) {
+			throw invalid_argument("All the properties must have the same count of values in the patch.");
+		}
+		values.nullValue = nullValue == (numeric_limits<LONG64>::min)() ? numeric_limits<double>::quiet_NaN() : static_cast<double>(nullValue);
+		values.minimumValue = minimumValues[prop];
+		values.maximumValue = maximumValues[prop];
+		values.chunkValueCount = properties[prop]->hasChunkSummaryOfPatch(patchIndex)
+			? properties[prop]->getChunkSummaryOfPatch(patchIndex, values.minimums, values.maximums, values.validCounts)
+			: 0;
+		if (values.chunkValueCount != 0 && values.validCounts.size() != (values.valueCount + values.chunkValueCount - 1) / values.chunkValueCount) {
+			throw invalid_argument("The chunk summary of the property " + properties[prop]->getUuid() + " does not match its values.");
+		}
+	}
+
+	// Chunks of the first summarized property so that its summary is fully exploited
+	ULONG64 chunkValueCount = getChunkSummaryValueCount(&chunkedValues[0].dimensions[0], chunkedValues[0].dimensions.size());
+	for (size_t prop = 0; prop < chunkedValues.size(); ++prop) {
+		if (chunkedValues[prop].chunkValueCount != 0) {
+			chunkValueCount = chunkedValues[prop].chunkValueCount;
+			break;
+		}
+	}
+
+	// The chunks which are not discarded by the summaries are processed by windows of one chunk per thread.
+	// HDF5 is only called from the calling thread : the values of a window are read property after property and each chunk is then evaluated by its own thread.
+	const ULONG64 valueCount = chunkedValues[0].valueCount;
+	const unsigned int windowSize = parallel::getChunkCount((valueCount + chunkValueCount - 1) / chunkValueCount, 1);
+	std::vector<SelectedChunk> window(windowSize);
+	ULONG64 chunkStart = 0;
+	while (chunkStart < valueCount) {
+		// Use the summaries first : a single property which cannot match discards the whole chunk without reading anything
+		unsigned int chunkCountInWindow = 0;
+		for (; chunkCountInWindow < windowSize && chunkStart < valueCount; chunkStart += chunkValueCount) {
+			SelectedChunk & chunk = window[chunkCountInWindow];
+			chunk.start = chunkStart;
+			chunk.end = valueCount - chunkStart < chunkValueCount ? valueCount : chunkStart + chunkValueCount;
+			chunk.canMatch = true;
+			chunk.propertiesToRead.clear();
+			for (size_t prop = 0; chunk.canMatch && prop < chunkedValues.size(); ++prop) {
+				const ChunkMatch match = chunkedValues[prop].getMatch(chunk.start, chunk.end);
+				if (match == NO_MATCH) {
+					chunk.canMatch = false;
+				}
+				else if (match == PARTIAL_MATCH) {
+					chunk.propertiesToRead.push_back(prop);
+				}
+			}
+			if (chunk.canMatch) {
+				++chunkCountInWindow;
+			}
+		}
+
+		// Evaluate the remaining predicates one property after the other on each chunk
+		for (size_t step = 0; ; ++step) {
+			bool isAnyChunkRead = false;
+			for (unsigned int c = 0; c < chunkCountInWindow; ++c) {
+				SelectedChunk & chunk = window[c];
+				if (chunk.canMatch && step < chunk.propertiesToRead.size()) {
+					const ChunkedValues & values = chunkedValues[chunk.propertiesToRead[step]];
+					readRange(values.hdfProxy, values.datasetName, values.dimensions, chunk.start, chunk.end, chunk.buffer);
+					isAnyChunkRead = true;
+				}
+			}
+			if (!isAnyChunkRead) {
+				break;
+			}
+			parallel::forEachChunk(chunkCountInWindow, chunkCountInWindow, [&](const unsigned int &, const uint64_t & begin, const uint64_t & end) {
+				for (uint64_t c = begin; c < end; ++c) {
+					SelectedChunk & chunk = window[c];
+					if (chunk.canMatch && step < chunk.propertiesToRead.size()) {
+						if (step == 0) {
+							chunk.isSelected.assign(chunk.end - chunk.start, 1);
+						}
+						chunk.canMatch = chunkedValues[chunk.propertiesToRead[step]].evaluate(chunk.buffer, chunk.isSelected);
+					}
+					if (chunk.canMatch && step + 1 == chunk.propertiesToRead.size()) {
+						// Last predicate of the chunk : gather its selected elements as ranges
+						chunk.selectedRanges.clear();
+						for (size_t i = 0; i < chunk.isSelected.size(); ++i) {
+							if (chunk.isSelected[i] != 0) {
+								const size_t rangeStart = i;
+								while (i < chunk.isSelected.size() && chunk.isSelected[i] != 0) {
+									++i;
+								}
+								chunk.selectedRanges.push_back(std::make_pair(chunk.start + rangeStart, chunk.start + i));
+							}
+						}
+					}
+				}
+			});
+		}
+
+		// Concatenate the selections in chunk order
+		for (unsigned int c = 0; c < chunkCountInWindow; ++c) {
+			const SelectedChunk & chunk = window[c];
+			if (chunk.propertiesToRead.empty()) {
+				elementIndices.addRange(chunk.start, chunk.end);
+			}
+			else if (chunk.canMatch) {
+				for (size_t range = 0; range < chunk.selectedRanges.size(); ++range) {
+					elementIndices.addRange(chunk.selectedRanges[range].first, chunk.selectedRanges[range].second);
+				}
+			}
+		}
+	}
+}
+
+void AbstractValuesProperty::getSeriesDatasetOfPatch(const unsigned int & patchIndex, std::string & datasetName, std::vector<unsigned long long> & dimensions, ULONG64 & elementCount) const
+{
+	const unsigned int timeIndexCount = getSeriesTimeIndexCount();
+	if (timeIndexCount == 0) {
+		throw invalid_argument("The property " + getUuid() + " is not a property series.");
+	}
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+	if (hdfProxy == nullptr) {
+		throw invalid_argument("The Hdf proxy cannot be nullptr.");
+	}
+
+	LONG64 nullValue = (numeric_limits<LONG64>::min)();
+	datasetName = getPathInHdfFileOfPatch(patchIndex, nullValue);
+	dimensions = hdfProxy->readArrayDimensions(datasetName);
+	ULONG64 valueCount = 1;
+	for (size_t d = 0; d < dimensions.size(); ++d) {
+		valueCount *= dimensions[d];
+	}
+	if (valueCount % timeIndexCount != 0) {
+		throw invalid_argument("The count of values of the property series " + getUuid() + " is not a multiple of its time index count.");
+	}
+	elementCount = valueCount / timeIndexCount;
+}
+
+ULONG64 AbstractValuesProperty::getSeriesElementCountOfPatch(const unsigned int & patchIndex) const
+{
+	std::string datasetName;
+	std::vector<unsigned long long> dimensions;
+	ULONG64 elementCount;
+	getSeriesDatasetOfPatch(patchIndex, datasetName, dimensions, elementCount);
+	return elementCount;
+}
+
+void AbstractValuesProperty::getDoubleValuesOfTimeIndex(const unsigned int & patchIndex, const unsigned int & timeIndex, double * values) const
+{
+	getDoubleValuesOfTimeWindow(patchIndex, timeIndex, 1, 0, getSeriesElementCountOfPatch(patchIndex), values);
+}
+
+void AbstractValuesProperty::getDoubleValuesOfTimeWindow(const unsigned int & patchIndex,
+	const unsigned int & firstTimeIndex, const unsigned int & timeIndexCount,
+	const ULONG64 & firstElementIndex, const ULONG64 & elementCount, double * values) const
+{
+	std::string datasetName;
+	std::vector<unsigned long long> dimensions;
+	ULONG64 seriesElementCount;
+	getSeriesDatasetOfPatch(patchIndex, datasetName, dimensions, seriesElementCount);
+	if (firstTimeIndex + timeIndexCount > getSeriesTimeIndexCount()) {
+		throw out_of_range("The time window is out of the time indices of the property series.");
+	}
+	if (firstElementIndex + elementCount > seriesElementCount) {
+		throw out_of_range("The element range is out of the elements of the property series.");
+	}
+
+	// One contiguous range of values per time index
+	for (unsigned int t = 0; t < timeIndexCount; ++t) {
+		const ULONG64 start = (firstTimeIndex + t) * seriesElementCount + firstElementIndex;
+		readRange(getHdfProxy(), datasetName, dimensions, start, start + elementCount, values + t * elementCount);
+	}
+}
+
+void AbstractValuesProperty::getDoubleValuesOfElementHistory(const unsigned int & patchIndex, const indexing::IndexSet & elementIndices, double * values) const
+{
+	std::string datasetName;
+	std::vector<unsigned long long> dimensions;
+	ULONG64 elementCount;
+	getSeriesDatasetOfPatch(patchIndex, datasetName, dimensions, elementCount);
+	const unsigned int timeIndexCount = getSeriesTimeIndexCount();
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+
+	std::vector< std::pair<uint64_t, uint64_t> > ranges;
+	elementIndices.getRanges(ranges);
+	if (!ranges.empty() && ranges.back().second > elementCount) {
+		throw out_of_range("An element index is out of the range of the elements of the property series.");
+	}
+
+	ULONG64 elementOffset = 0;
+	if (hasHistoryOfPatch(patchIndex)) {
+		// One hyperslab of consecutive histories per range of elements. The history dataset stores decoded values (see writeHistoryOfPatch).
+		for (size_t range = 0; range < ranges.size(); ++range) {
+			unsigned long long counts[2] = { ranges[range].second - ranges[range].first, timeIndexCount };
+			unsigned long long offsets[2] = { ranges[range].first, 0 };
+			hdfProxy->readArrayNdOfDoubleValues(datasetName + "_history", values + elementOffset * timeIndexCount, counts, offsets, 2);
+			elementOffset += counts[0];
+		}
+	}
+	else {
+		// One hyperslab per range of elements and per time index
+		std::vector<double> buffer;
+		for (size_t range = 0; range < ranges.size(); ++range) {
+			const ULONG64 rangeSize = ranges[range].second - ranges[range].first;
+			for (unsigned int t = 0; t < timeIndexCount; ++t) {
+				const ULONG64 start = t * elementCount + ranges[range].first;
+				readRange(hdfProxy, datasetName, dimensions, start, start + rangeSize, buffer);
+				for (ULONG64 i = 0; i < rangeSize; ++i) {
+					values[(elementOffset + i) * timeIndexCount + t] = buffer[i];
+				}
+			}
+			elementOffset += rangeSize;
+		}
+	}
+}
+
+void AbstractValuesProperty::getDoubleValuesOfElementHistory(const std::vector<const AbstractValuesProperty*> & properties,
+	const unsigned int & patchIndex, const indexing::IndexSet & elementIndices, double * values)
+{
+	const ULONG64 selectedCount = elementIndices.count();
+	std::vector<double> buffer(selectedCount);
+	for (size_t t = 0; t < properties.size(); ++t) {
+		COMMON_NS::AbstractHdfProxy* hdfProxy = properties[t]->getHdfProxy();
+		if (hdfProxy == nullptr) {
+			throw invalid_argument("The Hdf proxy cannot be nullptr.");
+		}
+		LONG64 nullValue = (numeric_limits<LONG64>::min)();
+		const std::string datasetName = properties[t]->getPathInHdfFileOfPatch(patchIndex, nullValue);
+		gatherValues(hdfProxy, datasetName, elementIndices, buffer.empty() ? nullptr : &buffer[0], 256);
+		decodeScaledValues(hdfProxy, datasetName, buffer.empty() ? nullptr : &buffer[0], selectedCount);
+		for (ULONG64 i = 0; i < selectedCount; ++i) {
+			values[i * properties.size() + t] = buffer[i];
+		}
+	}
+}
+
+void AbstractValuesProperty::writeHistoryOfPatch(const unsigned int & patchIndex)
+{
+	std::string datasetName;
+	std::vector<unsigned long long> dimensions;
+	ULONG64 elementCount;
+	getSeriesDatasetOfPatch(patchIndex, datasetName, dimensions, elementCount);
+	const unsigned int timeIndexCount = getSeriesTimeIndexCount();
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+
+	unsigned long long historyDimensions[2] = { elementCount, timeIndexCount };
+	hdfProxy->createArrayNd(getUuid(), datasetName + "_history", H5T_NATIVE_DOUBLE, historyDimensions, 2);
+
+	// Transpose blocks of elements in order to bound the memory consumption
+	const ULONG64 maxBlockValueCount = 1 << 22;
+	const ULONG64 blockElementCount = maxBlockValueCount / timeIndexCount > 0 ? maxBlockValueCount / timeIndexCount : 1;
+	std::vector<double> timeSlices;
+	std::vector<double> histories;
+	for (ULONG64 blockStart = 0; blockStart < elementCount; blockStart += blockElementCount) {
+		const ULONG64 blockSize = elementCount - blockStart < blockElementCount ? elementCount - blockStart : blockElementCount;
+		timeSlices.resize(blockSize * timeIndexCount);
+		for (unsigned int t = 0; t < timeIndexCount; ++t) {
+			const ULONG64 start = t * elementCount + blockStart;
+			readRange(hdfProxy, datasetName, dimensions, start, start + blockSize, &timeSlices[t * blockSize]);
+		}
+		histories.resize(timeSlices.size());
+		for (ULONG64 i = 0; i < blockSize; ++i) {
+			for (unsigned int t = 0; t < timeIndexCount; ++t) {
+				histories[i * timeIndexCount + t] = timeSlices[t * blockSize + i];
+			}
+		}
+		unsigned long long counts[2] = { blockSize, timeIndexCount };
+		unsigned long long offsets[2] = { blockStart, 0 };
+		hdfProxy->writeArrayNdSlab(getUuid(), datasetName + "_history", H5T_NATIVE_DOUBLE, &histories[0], counts, offsets, 2);
+	}
+}
+
+bool AbstractValuesProperty::hasHistoryOfPatch(const unsigned int & patchIndex) const
+{
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+	if (hdfProxy == nullptr) {
+		throw invalid_argument("The Hdf proxy cannot be nullptr.");
+	}
+	if (!hdfProxy->isOpened()) {
+		hdfProxy->open();
+	}
+
+	LONG64 nullValue = (numeric_limits<LONG64>::min)();
+	return hdfProxy->exist(getPathInHdfFileOfPatch(patchIndex, nullValue) + "_history");
+}
+
+AbstractValuesProperty::hdfDatatypeEnum AbstractValuesProperty::getNarrowestIntegerDatatype(const LONG64 & minimum, const LONG64 & maximum, LONG64 & nullValue)
+{
+	// Ordered by increasing width
+	const hdfDatatypeEnum datatypes[7] = { CHAR, UCHAR, SHORT, USHORT, INT, UINT, LONG };
+	const LONG64 datatypeMinimums[7] = { (numeric_limits<signed char>::min)(), 0, (numeric_limits<short>::min)(), 0, (numeric_limits<int>::min)(), 0, (numeric_limits<long>::min)() };
+	const LONG64 datatypeMaximums[7] = { (numeric_limits<signed char>::max)(), (numeric_limits<unsigned char>::max)(), (numeric_limits<short>::max)(), (numeric_limits<unsigned short>::max)(),
+		(numeric_limits<int>::max)(), (numeric_limits<unsigned int>::max)(), (numeric_limits<long>::max)() };
+
+	const bool hasValue = minimum <= maximum;
+	for (unsigned int i = 0; i < 7; ++i) {
+		if (hasValue && (minimum < datatypeMinimums[i] || maximum > datatypeMaximums[i])) {
+			continue;
+		}
+		if (nullValue >= datatypeMinimums[i] && nullValue <= datatypeMaximums[i]) {
+			return datatypes[i];
+		}
+		if (!hasValue || maximum < datatypeMaximums[i]) {
+			nullValue = datatypeMaximums[i];
+			return datatypes[i];
+		}
+		if (minimum > datatypeMinimums[i]) {
+			nullValue = datatypeMinimums[i];
+			return datatypes[i];
+		}
+	}
+
+	return LONG; // The null value is out of the long range
+}
+
+void AbstractValuesProperty::writeNarrowedLongValues(const std::string & datasetName, const long * values, unsigned long long * numValues, const unsigned int & numArrayDimensions,
+	const long & nullValue, const LONG64 & narrowedNullValue, const hdfDatatypeEnum & datatype, COMMON_NS::AbstractHdfProxy* proxy)
+{
+	ULONG64 valueCount = 1;
+	for (unsigned int dim = 0; dim < numArrayDimensions; ++dim) {
+		valueCount *= numValues[dim];
+	}
+
+	if (datatype == CHAR) {
+		std::vector<signed char> narrowedValues;
+		narrowValues(values, valueCount, nullValue, static_cast<signed char>(narrowedNullValue), narrowedValues);
+		proxy->writeArrayNd(getUuid(), datasetName, H5T_NATIVE_SCHAR, narrowedValues.empty() ? nullptr : &narrowedValues[0], numValues, numArrayDimensions);
+	}
+	else if (datatype == UCHAR) {
+		std::vector<unsigned char> narrowedValues;
+		narrowValues(values, valueCount, nullValue, static_cast<unsigned char>(narrowedNullValue), narrowedValues);
+		proxy->writeArrayNd(getUuid(), datasetName, H5T_NATIVE_UCHAR, narrowedValues.empty() ? nullptr : &narrowedValues[0], numValues, numArrayDimensions);
+	}
+	else if (datatype == SHORT) {
+		std::vector<short> narrowedValues;
+		narrowValues(values, valueCount, nullValue, static_cast<short>(narrowedNullValue), narrowedValues);
+		proxy->writeArrayNd(getUuid(), datasetName, H5T_NATIVE_SHORT, narrowedValues.empty() ? nullptr : &narrowedValues[0], numValues, numArrayDimensions);
+	}
+	else if (datatype == USHORT) {
+		std::vector<unsigned short> narrowedValues;
+		narrowValues(values, valueCount, nullValue, static_cast<unsigned short>(narrowedNullValue), narrowedValues);
+		proxy->writeArrayNd(getUuid(), datasetName, H5T_NATIVE_USHORT, narrowedValues.empty() ? nullptr : &narrowedValues[0], numValues, numArrayDimensions);
+	}
+	else if (datatype == INT) {
+		std::vector<int> narrowedValues;
+		narrowValues(values, valueCount, nullValue, static_cast<int>(narrowedNullValue), narrowedValues);
+		proxy->writeArrayNd(getUuid(), datasetName, H5T_NATIVE_INT, narrowedValues.empty() ? nullptr : &narrowedValues[0], numValues, numArrayDimensions);
+	}
+	else if (datatype == UINT) {
+		std::vector<unsigned int> narrowedValues;
+		narrowValues(values, valueCount, nullValue, static_cast<unsigned int>(narrowedNullValue), narrowedValues);
+		proxy->writeArrayNd(getUuid(), datasetName, H5T_NATIVE_UINT, narrowedValues.empty() ? nullptr : &narrowedValues[0], numValues, numArrayDimensions);
+	}
+	else if (datatype == LONG) {
+		std::vector<long> narrowedValues;
+		narrowValues(values, valueCount, nullValue, static_cast<long>(narrowedNullValue), narrowedValues);
+		proxy->writeArrayNd(getUuid(), datasetName, H5T_NATIVE_LONG, narrowedValues.empty() ? nullptr : &narrowedValues[0], numValues, numArrayDimensions);
+	}
+	else {
+		throw invalid_argument("The datatype is not an integer datatype.");
+	}
+}
+
+void AbstractValuesProperty::decodeScaledValues(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, double * values, const ULONG64 & valueCount,
+	const double & scale, const double & offset)
+{
+	decodeScaledValuesOfDataset(hdfProxy, datasetName, values, valueCount, scale, offset);
+}
+
+void AbstractValuesProperty::decodeScaledValues(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, float * values, const ULONG64 & valueCount,
+	const double & scale, const double & offset)
+{
+	decodeScaledValuesOfDataset(hdfProxy, datasetName, values, valueCount, scale, offset);
+}
+
+void AbstractValuesProperty::loadValuesOfPatch(const std::vector<AbstractValuesProperty*> & properties, const unsigned int & patchIndex,
+	std::map<std::string, std::vector<double> > & doubleColumns, std::map<std::string, std::vector<long> > & longColumns,
+	std::map<std::string, long> & longNullValues, const indexing::BitSet * activeElements)
+{
+	// Plan the reads
+	std::vector<PatchRead> reads;
+	for (size_t propIndex = 0; propIndex < properties.size(); ++propIndex) {
+		AbstractValuesProperty* prop = properties[propIndex];
+		if (prop->gsoapProxy2_0_1 == nullptr) {
+			throw logic_error("Not implemented yet");
+		}
+		if (patchIndex >= prop->getPatchCount()) {
+			throw range_error("The values property patch is out of range");
+		}
+
+		const int valuesType = static_cast<gsoap_resqml2_0_1::resqml2__AbstractValuesProperty*>(prop->gsoapProxy2_0_1)->PatchOfValues[patchIndex]->Values->soap_type();
+		if (valuesType != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__DoubleHdf5Array && valuesType != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array) {
+			throw logic_error("The values of the patch of the property " + prop->getUuid() + " are not stored in a double or integer HDF5 array : loading them is not implemented yet.");
+		}
+		PatchRead read;
+		read.property = prop;
+		read.hdfProxy = prop->getHdfProxy();
+		if (read.hdfProxy == nullptr) {
+			throw invalid_argument("The Hdf proxy cannot be nullptr.");
+		}
+		read.nullValue = (numeric_limits<LONG64>::min)();
+		read.datasetName = prop->getPathInHdfFileOfPatch(patchIndex, read.nullValue);
+		read.isDouble = valuesType == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__DoubleHdf5Array;
+		read.valueCount = prop->getValuesCountOfPatch(patchIndex);
+		reads.push_back(read);
+	}
+	std::sort(reads.begin(), reads.end(), isReadBefore);
+
+	// Issue the reads
+	for (size_t readIndex = 0; readIndex < reads.size(); ++readIndex) {
+		const PatchRead & read = reads[readIndex];
+		if (!read.hdfProxy->isOpened()) {
+			read.hdfProxy->open();
+		}
+
+		if (read.isDouble) {
+			std::vector<double> & column = doubleColumns[read.property->getUuid()];
+			column.resize(read.valueCount);
+			if (read.valueCount > 0) {
+				read.hdfProxy->readArrayNdOfDoubleValues(read.datasetName, &column[0]);
+				decodeScaledValues(read.hdfProxy, read.datasetName, &column[0], read.valueCount);
+			}
+			if (activeElements != nullptr) {
+				compactValues(column, *activeElements, read.property->getElementCountPerValue());
+			}
+		}
+		else {
+			std::vector<long> & column = longColumns[read.property->getUuid()];
+			longNullValues[read.property->getUuid()] = static_cast<long>(read.nullValue);
+			column.resize(read.valueCount);
+			if (read.valueCount > 0) {
+				read.hdfProxy->readArrayNdOfLongValues(read.datasetName, &column[0]);
+			}
+			if (activeElements != nullptr) {
+				compactValues(column, *activeElements, read.property->getElementCountPerValue());
+			}
+		}
+	}
+}
+
+void AbstractValuesProperty::readHyperslabOfPatch(const unsigned int & patchIndex, void * values, const int & datatype,
+	unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions)
+{
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+	if (hdfProxy == nullptr) {
+		throw invalid_argument("The Hdf proxy cannot be nullptr.");
+	}
+	if (!hdfProxy->isOpened()) {
+		hdfProxy->open();
+	}
+
+	LONG64 nullValue = (numeric_limits<LONG64>::min)();
+	const std::string datasetName = getPathInHdfFileOfPatch(patchIndex, nullValue);
+	hdfProxy->readArrayNdOfValues(datasetName, values, numValuesInEachDimension, offsetInEachDimension, strideInEachDimension, nullptr, numArrayDimensions, datatype);
+
+	ULONG64 valueCount = 1;
+	for (unsigned int dim = 0; dim < numArrayDimensions; ++dim) {
+		valueCount *= numValuesInEachDimension[dim];
+	}
+	if (H5Tequal(datatype, H5T_NATIVE_DOUBLE) > 0) {
+		decodeScaledValues(hdfProxy, datasetName, static_cast<double*>(values), valueCount);
+	}
+	else if (H5Tequal(datatype, H5T_NATIVE_FLOAT) > 0) {
+		decodeScaledValues(hdfProxy, datasetName, static_cast<float*>(values), valueCount);
+	}
+}
+
+void AbstractValuesProperty::read3dBoxOfPatch(const unsigned int & patchIndex, void * values, const int & datatype,
+	const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+	const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+	const unsigned int & strideInFastestDim, const unsigned int & strideInMiddleDim, const unsigned int & strideInSlowestDim)
+{
+	unsigned long long numValuesInEachDimension[3] = { valueCountInSlowestDim, valueCountInMiddleDim, valueCountInFastestDim };
+	unsigned long long offsetInEachDimension[3] = { offsetInSlowestDim, offsetInMiddleDim, offsetInFastestDim };
+	unsigned long long strideInEachDimension[3] = { strideInSlowestDim, strideInMiddleDim, strideInFastestDim };
+	readHyperslabOfPatch(patchIndex, values, datatype, numValuesInEachDimension, offsetInEachDimension, strideInEachDimension, 3);
+}
+
+void AbstractValuesProperty::getDoubleValuesOfHyperslabOfPatch(const unsigned int & patchIndex, double * values,
+	unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions)
+{
+	readHyperslabOfPatch(patchIndex, values, H5T_NATIVE_DOUBLE, numValuesInEachDimension, offsetInEachDimension, strideInEachDimension, numArrayDimensions);
+}
+
+void AbstractValuesProperty::getFloatValuesOfHyperslabOfPatch(const unsigned int & patchIndex, float * values,
+	unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions)
+{
+	readHyperslabOfPatch(patchIndex, values, H5T_NATIVE_FLOAT, numValuesInEachDimension, offsetInEachDimension, strideInEachDimension, numArrayDimensions);
+}
+
+void AbstractValuesProperty::getLongValuesOfHyperslabOfPatch(const unsigned int & patchIndex, long * values,
+	unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions)
+{
+	readHyperslabOfPatch(patchIndex, values, H5T_NATIVE_LONG, numValuesInEachDimension, offsetInEachDimension, strideInEachDimension, numArrayDimensions);
+}
+
+void AbstractValuesProperty::getULongValuesOfHyperslabOfPatch(const unsigned int & patchIndex, unsigned long * values,
+	unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions)
+{
+	readHyperslabOfPatch(patchIndex, values, H5T_NATIVE_ULONG, numValuesInEachDimension, offsetInEachDimension, strideInEachDimension, numArrayDimensions);
+}
+
+void AbstractValuesProperty::getIntValuesOfHyperslabOfPatch(const unsigned int & patchIndex, int * values,
+	unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions)
+{
+	readHyperslabOfPatch(patchIndex, values, H5T_NATIVE_INT, numValuesInEachDimension, offsetInEachDimension, strideInEachDimension, numArrayDimensions);
+}
+
+void AbstractValuesProperty::getUIntValuesOfHyperslabOfPatch(const unsigned int & patchIndex, unsigned int * values,
+	unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions)
+{
+	readHyperslabOfPatch(patchIndex, values, H5T_NATIVE_UINT, numValuesInEachDimension, offsetInEachDimension, strideInEachDimension, numArrayDimensions);
+}
+
+void AbstractValuesProperty::getShortValuesOfHyperslabOfPatch(const unsigned int & patchIndex, short * values,
+	unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions)
+{
+	readHyperslabOfPatch(patchIndex, values, H5T_NATIVE_SHORT, numValuesInEachDimension, offsetInEachDimension, strideInEachDimension, numArrayDimensions);
+}
+
+void AbstractValuesProperty::getUShortValuesOfHyperslabOfPatch(const unsigned int & patchIndex, unsigned short * values,
+	unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions)
+{
+	readHyperslabOfPatch(patchIndex, values, H5T_NATIVE_USHORT, numValuesInEachDimension, offsetInEachDimension, strideInEachDimension, numArrayDimensions);
+}
+
+void AbstractValuesProperty::getCharValuesOfHyperslabOfPatch(const unsigned int & patchIndex, char * values,
+	unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions)
+{
+	readHyperslabOfPatch(patchIndex, values, H5T_NATIVE_CHAR, numValuesInEachDimension, offsetInEachDimension, strideInEachDimension, numArrayDimensions);
+}
+
+void AbstractValuesProperty::getUCharValuesOfHyperslabOfPatch(const unsigned int & patchIndex, unsigned char * values,
+	unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions)
+{
+	readHyperslabOfPatch(patchIndex, values, H5T_NATIVE_UCHAR, numValuesInEachDimension, offsetInEachDimension, strideInEachDimension, numArrayDimensions);
+}
+
+void AbstractValuesProperty::getDoubleValuesOf3dBoxOfPatch(const unsigned int & patchIndex, double * values,
+	const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+	const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+	const unsigned int & strideInFastestDim, const unsigned int & strideInMiddleDim, const unsigned int & strideInSlowestDim)
+{
+	read3dBoxOfPatch(patchIndex, values, H5T_NATIVE_DOUBLE, valueCountInFastestDim, valueCountInMiddleDim, valueCountInSlowestDim,
+		offsetInFastestDim, offsetInMiddleDim, offsetInSlowestDim, strideInFastestDim, strideInMiddleDim, strideInSlowestDim);
+}
+
+void AbstractValuesProperty::getFloatValuesOf3dBoxOfPatch(const unsigned int & patchIndex, float * values,
+	const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+	const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+	const unsigned int & strideInFastestDim, const unsigned int & strideInMiddleDim, const unsigned int & strideInSlowestDim)
+{
+	read3dBoxOfPatch(patchIndex, values, H5T_NATIVE_FLOAT, valueCountInFastestDim, valueCountInMiddleDim, valueCountInSlowestDim,
+		offsetInFastestDim, offsetInMiddleDim, offsetInSlowestDim, strideInFastestDim, strideInMiddleDim, strideInSlowestDim);
+}
+
+void AbstractValuesProperty::getLongValuesOf3dBoxOfPatch(const unsigned int & patchIndex, long * values,
+	const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+	const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+	const unsigned int & strideInFastestDim, const unsigned int & strideInMiddleDim, const unsigned int & strideInSlowestDim)
+{
+	read3dBoxOfPatch(patchIndex, values, H5T_NATIVE_LONG, valueCountInFastestDim, valueCountInMiddleDim, valueCountInSlowestDim,
+		offsetInFastestDim, offsetInMiddleDim, offsetInSlowestDim, strideInFastestDim, strideInMiddleDim, strideInSlowestDim);
+}
+
+void AbstractValuesProperty::getULongValuesOf3dBoxOfPatch(const unsigned int & patchIndex, unsigned long * values,
+	const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+	const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+	const unsigned int & strideInFastestDim, const unsigned int & strideInMiddleDim, const unsigned int & strideInSlowestDim)
+{
+	read3dBoxOfPatch(patchIndex, values, H5T_NATIVE_ULONG, valueCountInFastestDim, valueCountInMiddleDim, valueCountInSlowestDim,
+		offsetInFastestDim, offsetInMiddleDim, offsetInSlowestDim, strideInFastestDim, strideInMiddleDim, strideInSlowestDim);
+}
+
+void AbstractValuesProperty::getIntValuesOf3dBoxOfPatch(const unsigned int & patchIndex, int * values,
+	const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+	const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+	const unsigned int & strideInFastestDim, const unsigned int & strideInMiddleDim, const unsigned int & strideInSlowestDim)
+{
+	read3dBoxOfPatch(patchIndex, values, H5T_NATIVE_INT, valueCountInFastestDim, valueCountInMiddleDim, valueCountInSlowestDim,
+		offsetInFastestDim, offsetInMiddleDim, offsetInSlowestDim, strideInFastestDim, strideInMiddleDim, strideInSlowestDim);
+}
+
+void AbstractValuesProperty::getUIntValuesOf3dBoxOfPatch(const unsigned int & patchIndex, unsigned int * values,
+	const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+	const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+	const unsigned int & strideInFastestDim, const unsigned int & strideInMiddleDim, const unsigned int & strideInSlowestDim)
+{
+	read3dBoxOfPatch(patchIndex, values, H5T_NATIVE_UINT, valueCountInFastestDim, valueCountInMiddleDim, valueCountInSlowestDim,
+		offsetInFastestDim, offsetInMiddleDim, offsetInSlowestDim, strideInFastestDim, strideInMiddleDim, strideInSlowestDim);
+}
+
+void AbstractValuesProperty::getShortValuesOf3dBoxOfPatch(const unsigned int & patchIndex, short * values,
+	const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+	const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+	const unsigned int & strideInFastestDim, const unsigned int & strideInMiddleDim, const unsigned int & strideInSlowestDim)
+{
+	read3dBoxOfPatch(patchIndex, values, H5T_NATIVE_SHORT, valueCountInFastestDim, valueCountInMiddleDim, valueCountInSlowestDim,
+		offsetInFastestDim, offsetInMiddleDim, offsetInSlowestDim, strideInFastestDim, strideInMiddleDim, strideInSlowestDim);
+}
+
+void AbstractValuesProperty::getUShortValuesOf3dBoxOfPatch(const unsigned int & patchIndex, unsigned short * values,
+	const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+	const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+	const unsigned int & strideInFastestDim, const unsigned int & strideInMiddleDim, const unsigned int & strideInSlowestDim)
+{
+	read3dBoxOfPatch(patchIndex, values, H5T_NATIVE_USHORT, valueCountInFastestDim, valueCountInMiddleDim, valueCountInSlowestDim,
+		offsetInFastestDim, offsetInMiddleDim, offsetInSlowestDim, strideInFastestDim, strideInMiddleDim, strideInSlowestDim);
+}
+
+void AbstractValuesProperty::getCharValuesOf3dBoxOfPatch(const unsigned int & patchIndex, char * values,
+	const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+	const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+	const unsigned int & strideInFastestDim, const unsigned int & strideInMiddleDim, const unsigned int & strideInSlowestDim)
+{
+	read3dBoxOfPatch(patchIndex, values, H5T_NATIVE_CHAR, valueCountInFastestDim, valueCountInMiddleDim, valueCountInSlowestDim,
+		offsetInFastestDim, offsetInMiddleDim, offsetInSlowestDim, strideInFastestDim, strideInMiddleDim, strideInSlowestDim);
+}
+
+void AbstractValuesProperty::getUCharValuesOf3dBoxOfPatch(const unsigned int & patchIndex, unsigned char * values,
+	const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+	const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+	const unsigned int & strideInFastestDim, const unsigned int & strideInMiddleDim, const unsigned int & strideInSlowestDim)
+{
+	read3dBoxOfPatch(patchIndex, values, H5T_NATIVE_UCHAR, valueCountInFastestDim, valueCountInMiddleDim, valueCountInSlowestDim,
+		offsetInFastestDim, offsetInMiddleDim, offsetInSlowestDim, strideInFastestDim, strideInMiddleDim, strideInSlowestDim);
+}
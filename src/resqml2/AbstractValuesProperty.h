@@ -19,8 +19,14 @@ under the License.
 #pragma once
 
 #include <limits>
+#include <map>
+#include <vector>
 #include "resqml2/AbstractProperty.h"
 
+#include "tools/IndexSet.h"
+#include "tools/Statistics.h"
+#include "tools/Parallel.h"
+
 namespace RESQML2_NS
 {
 	class DLL_IMPORT_OR_EXPORT AbstractValuesProperty : public AbstractProperty
@@ -43,6 +49,100 @@ namespace RESQML2_NS
 		*/
 		std::string pushBackRefToExistingIntegerDataset(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName = "", const long & nullValue = (std::numeric_limits<long>::max)());
 
+		/**
+		* Get the count of values summarized by each chunk summary of a dataset.
+		* It is the count of values of one slab along the slowest dimension (i.e. one K layer for a 3d cell property) or a fixed count for a 1d dataset.
+		* @param dimensions	The count of values in each dimension of the dataset, ordered from the slowest to the fastest dimension.
+		*/
+		static ULONG64 getChunkSummaryValueCount(const unsigned long long * dimensions, const unsigned int & dimensionCount);
+
+		/**
+		* Compute in one pass over the values of a dataset which are still in memory the statistics of each component of the values and, if asked, the chunk summary of the dataset (see writeChunkSummaryOfPatch).
+		* The chunks are split between several threads which accumulate their own statistics, merged once all threads are done.
+		* @param values					All the values of the dataset.
+		* @param numValues				The count of values in each dimension of the dataset, ordered from the slowest to the fastest dimension.
+		* @param numArrayDimensions		The count of dimensions of the dataset.
+		* @param componentCount			The count of components of each element (i.e. the count of a vectorial property). Components are the fastest values.
+		* @param nullValue				The values equal to this null value (or NaN) are ignored.
+		* @param withChunkSummary		True to compute the chunk summary.
+		* @param componentAccumulators	Output statistics of each component.
+		* @param summary				Output min, max and valid count of each chunk. It is left empty if withChunkSummary is false.
+		*/
+		template <class T>
+		void computeStatistics(const T * values, const unsigned long long * numValues, const unsigned int & numArrayDimensions, const unsigned int & componentCount, const T & nullValue, const bool & withChunkSummary,
+			std::vector< statistics::Accumulator<T> > & componentAccumulators, std::vector<double> & summary) const
+		{
+			if (componentCount == 0) {
+				throw std::invalid_argument("Cannot compute the statistics of values which have no component.");
+			}
+
+			ULONG64 valueCount = 1;
+			for (unsigned int dim = 0; dim < numArrayDimensions; ++dim) {
+				valueCount *= numValues[dim];
+			}
+			const ULONG64 chunkValueCount = getChunkSummaryValueCount(numValues, numArrayDimensions);
+			const ULONG64 chunkCount = (valueCount + chunkValueCount - 1) / chunkValueCount;
+			summary.assign(withChunkSummary ? chunkCount * 3 : 0, 0);
+
+			// A thread processes whole chunks and at least 65536 values.
+			const unsigned int threadCount = parallel::getChunkCount(chunkCount, chunkValueCount < 65536 ? 65536 / chunkValueCount : 1);
+			std::vector< std::vector< statistics::Accumulator<T> > > threadAccumulators(threadCount, std::vector< statistics::Accumulator<T> >(componentCount, statistics::Accumulator<T>(nullValue)));
+			parallel::forEachChunk(chunkCount, threadCount, [&](const unsigned int & threadIndex, const uint64_t & begin, const uint64_t & end) {
+				std::vector< statistics::Accumulator<T> > & accumulators = threadAccumulators[threadIndex];
+				for (uint64_t chunk = begin; chunk < end; ++chunk) {
+					const ULONG64 chunkStart = chunk * chunkValueCount;
+					const ULONG64 chunkSize = valueCount - chunkStart < chunkValueCount ? valueCount - chunkStart : chunkValueCount;
+					statistics::Accumulator<T> chunkAccumulator(nullValue);
+					for (unsigned int chunkComponent = 0; chunkComponent < componentCount && chunkComponent < chunkSize; ++chunkComponent) {
+						statistics::Accumulator<T> componentAccumulator(nullValue);
+						componentAccumulator.add(values + chunkStart + chunkComponent, chunkSize - chunkComponent, componentCount);
+						chunkAccumulator.merge(componentAccumulator);
+						accumulators[(chunkStart + chunkComponent) % componentCount].merge(componentAccumulator);
+					}
+					if (withChunkSummary) {
+						summary[3 * chunk] = static_cast<double>(chunkAccumulator.getMinimum());
+						summary[3 * chunk + 1] = static_cast<double>(chunkAccumulator.getMaximum());
+						summary[3 * chunk + 2] = static_cast<double>(chunkAccumulator.getValidCount());
+					}
+				}
+			});
+
+			componentAccumulators = threadAccumulators[0];
+			for (unsigned int thread = 1; thread < threadCount; ++thread) {
+				for (unsigned int component = 0; component < componentCount; ++component) {
+					componentAccumulators[component].merge(threadAccumulators[thread][component]);
+				}
+			}
+		}
+
+		/**
+		* Write the chunk summary dataset (see writeChunkSummaryOfPatch) of a dataset from its values which are still in memory.
+		* It does nothing if chunk summaries are not enabled on this property.
+		* @param datasetName		The absolute path of the dataset of values in the HDF file.
+		* @param values				All the values of the dataset.
+		* @param numValues			The count of values in each dimension of the dataset, ordered from the slowest to the fastest dimension.
+		* @param numArrayDimensions	The count of dimensions of the dataset.
+		* @param nullValue			The values equal to this null value (or NaN) are not summarized.
+		*/
+		template <class T>
+		void writeChunkSummary(const std::string & datasetName, const T * values, const unsigned long long * numValues, const unsigned int & numArrayDimensions, const T & nullValue, COMMON_NS::AbstractHdfProxy* proxy)
+		{
+			if (!chunkSummariesEnabled) {
+				return;
+			}
+
+			std::vector< statistics::Accumulator<T> > accumulators;
+			std::vector<double> summary;
+			computeStatistics(values, numValues, numArrayDimensions, 1, nullValue, true, accumulators, summary);
+			writeChunkSummaryDataset(datasetName, summary, getChunkSummaryValueCount(numValues, numArrayDimensions), proxy);
+		}
+
+		/**
+		* Write a chunk summary dataset next to a dataset of values.
+		* @param summary	Min, max and valid count of each chunk.
+		*/
+		void writeChunkSummaryDataset(const std::string & datasetName, const std::vector<double> & summary, const ULONG64 & chunkValueCount, COMMON_NS::AbstractHdfProxy* proxy);
+
 	public:
 
 		enum hdfDatatypeEnum { UNKNOWN = 0, DOUBLE = 1, FLOAT = 2, LONG = 3, ULONG = 4, INT = 5, UINT = 6, SHORT = 7, USHORT = 8, CHAR = 9, UCHAR = 10};
@@ -50,18 +150,18 @@ namespace RESQML2_NS
 		/**
 		* Only to be used in partial transfer context
 		*/
-		AbstractValuesProperty(gsoap_resqml2_0_1::eml20__DataObjectReference* partialObject) : AbstractProperty(partialObject) {}
+		AbstractValuesProperty(gsoap_resqml2_0_1::eml20__DataObjectReference* partialObject) : AbstractProperty(partialObject), chunkSummariesEnabled(false) {}
 
 		/**
 		* Default constructor
 		* Set the relationship with an AbstractRepresentation and a local property type.
 		*/
-		AbstractValuesProperty() {}
+		AbstractValuesProperty() : chunkSummariesEnabled(false) {}
 
 		/**
 		* Creates an instance of this class by wrapping a gsoap instance.
 		*/
-		AbstractValuesProperty(gsoap_resqml2_0_1::resqml2__AbstractValuesProperty* fromGsoap) : RESQML2_NS::AbstractProperty(fromGsoap) {}
+		AbstractValuesProperty(gsoap_resqml2_0_1::resqml2__AbstractValuesProperty* fromGsoap) : RESQML2_NS::AbstractProperty(fromGsoap), chunkSummariesEnabled(false) {}
 
 		/**
 		* Destructor does nothing since the memory is managed by the gsoap context.
@@ -195,6 +295,11 @@ namespace RESQML2_NS
 		*/
 		unsigned int getValuesCountOfPatch (const unsigned int & patchIndex);
 
+		/**
+		* Get the count of values in each dimension of the underlying HDF5 dataset of this property for a particular patch, ordered from the slowest to the fastest dimension.
+		*/
+		std::vector<unsigned long long> getValuesCountPerDimensionOfPatch(const unsigned int & patchIndex);
+
 		/**
 		* Get the count of values on a specific dimension of the underlying HDF5 dataset of this property.
 		* @param dimIndex	The index of the dimension we want to know the values count in this property.
@@ -337,6 +442,323 @@ namespace RESQML2_NS
 			const unsigned int& offsetInSlowestDim
 		);
 
+		//***************************
+		//*** Hyperslabs ************
+		//***************************
+
+		/**
+		* Get the values of a (potentially strided) hyperslab of a particular patch of the instance whatever their datatype in the HDF file.
+		* They are read by means of a single HDF5 hyperslab selection. Null values are the null value of the patch (see getNullValueOfPatch) for integer values and NaN for floating point values.
+		* @param patchIndex					The index of the patch we want the values from.
+		* @param values						The array (pointer) of values must be preallocated with the product of numValuesInEachDimension.
+		* @param numValuesInEachDimension	The count of values to read in each dimension, ordered from the slowest to the fastest dimension.
+		* @param offsetInEachDimension		The index of the first value to read in each dimension, ordered from the slowest to the fastest dimension.
+		* @param strideInEachDimension		The count of values between two read values in each dimension, ordered from the slowest to the fastest dimension.
+		*									nullptr means a stride of 1 in each dimension i.e. a contiguous window.
+		* @param numArrayDimensions			The number of dimensions of the HDF5 array to read.
+		*/
+		void getDoubleValuesOfHyperslabOfPatch(const unsigned int & patchIndex, double * values,
+			unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions);
+		void getFloatValuesOfHyperslabOfPatch(const unsigned int & patchIndex, float * values,
+			unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions);
+		void getLongValuesOfHyperslabOfPatch(const unsigned int & patchIndex, long * values,
+			unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions);
+		void getULongValuesOfHyperslabOfPatch(const unsigned int & patchIndex, unsigned long * values,
+			unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions);
+		void getIntValuesOfHyperslabOfPatch(const unsigned int & patchIndex, int * values,
+			unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions);
+		void getUIntValuesOfHyperslabOfPatch(const unsigned int & patchIndex, unsigned int * values,
+			unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions);
+		void getShortValuesOfHyperslabOfPatch(const unsigned int & patchIndex, short * values,
+			unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions);
+		void getUShortValuesOfHyperslabOfPatch(const unsigned int & patchIndex, unsigned short * values,
+			unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions);
+		void getCharValuesOfHyperslabOfPatch(const unsigned int & patchIndex, char * values,
+			unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions);
+		void getUCharValuesOfHyperslabOfPatch(const unsigned int & patchIndex, unsigned char * values,
+			unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions);
+
+		/**
+		* Get the values of a (potentially strided) 3d box of a particular patch of the instance whatever their datatype in the HDF file, typically a window of the cells of an IJK grid.
+		* It is the same as the hyperslab getters but dimensions are given from the fastest (mainly I) to the slowest (mainly K) one.
+		* @param values	The array (pointer) of values must be preallocated with valueCountInFastestDim * valueCountInMiddleDim * valueCountInSlowestDim values.
+		*/
+		void getDoubleValuesOf3dBoxOfPatch(const unsigned int & patchIndex, double * values,
+			const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+			const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+			const unsigned int & strideInFastestDim = 1, const unsigned int & strideInMiddleDim = 1, const unsigned int & strideInSlowestDim = 1);
+		void getFloatValuesOf3dBoxOfPatch(const unsigned int & patchIndex, float * values,
+			const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+			const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+			const unsigned int & strideInFastestDim = 1, const unsigned int & strideInMiddleDim = 1, const unsigned int & strideInSlowestDim = 1);
+		void getLongValuesOf3dBoxOfPatch(const unsigned int & patchIndex, long * values,
+			const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+			const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+			const unsigned int & strideInFastestDim = 1, const unsigned int & strideInMiddleDim = 1, const unsigned int & strideInSlowestDim = 1);
+		void getULongValuesOf3dBoxOfPatch(const unsigned int & patchIndex, unsigned long * values,
+			const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+			const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+			const unsigned int & strideInFastestDim = 1, const unsigned int & strideInMiddleDim = 1, const unsigned int & strideInSlowestDim = 1);
+		void getIntValuesOf3dBoxOfPatch(const unsigned int & patchIndex, int * values,
+			const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+			const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+			const unsigned int & strideInFastestDim = 1, const unsigned int & strideInMiddleDim = 1, const unsigned int & strideInSlowestDim = 1);
+		void getUIntValuesOf3dBoxOfPatch(const unsigned int & patchIndex, unsigned int * values,
+			const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+			const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+			const unsigned int & strideInFastestDim = 1, const unsigned int & strideInMiddleDim = 1, const unsigned int & strideInSlowestDim = 1);
+		void getShortValuesOf3dBoxOfPatch(const unsigned int & patchIndex, short * values,
+			const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+			const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+			const unsigned int & strideInFastestDim = 1, const unsigned int & strideInMiddleDim = 1, const unsigned int & strideInSlowestDim = 1);
+		void getUShortValuesOf3dBoxOfPatch(const unsigned int & patchIndex, unsigned short * values,
+			const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+			const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+			const unsigned int & strideInFastestDim = 1, const unsigned int & strideInMiddleDim = 1, const unsigned int & strideInSlowestDim = 1);
+		void getCharValuesOf3dBoxOfPatch(const unsigned int & patchIndex, char * values,
+			const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+			const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+			const unsigned int & strideInFastestDim = 1, const unsigned int & strideInMiddleDim = 1, const unsigned int & strideInSlowestDim = 1);
+		void getUCharValuesOf3dBoxOfPatch(const unsigned int & patchIndex, unsigned char * values,
+			const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+			const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+			const unsigned int & strideInFastestDim = 1, const unsigned int & strideInMiddleDim = 1, const unsigned int & strideInSlowestDim = 1);
+
+		//***************************
+		//*** Gather/scatter ********
+		//***************************
+
+		/**
+		* Gather the values of some elements of a particular patch into a compact array (typically the elements of a subrepresentation, see SubRepresentation::getElementIndicesOfPatch).
+		* Only the HDF5 hyperslabs touched by the element indices are read : runs of indices which are separated by at most maxGap unselected elements are read at once.
+		* @param patchIndex		The index of the patch we want the values from.
+		* @param elementIndices	The indices of the elements in the (linearized) values of the patch.
+		* @param values			It must be preallocated with elementIndices.count(). Values are ordered by increasing element index.
+		* @param maxGap			The maximal count of unselected elements which can be read in order to coalesce two runs of selected elements.
+		*/
+		void gatherDoubleValuesOfPatch(const unsigned int & patchIndex, const indexing::IndexSet & elementIndices, double * values, const ULONG64 & maxGap = 256);
+
+		/**
+		* Same as gatherDoubleValuesOfPatch but for values which are supposed to be long ones.
+		* @return the null value
+		*/
+		long gatherLongValuesOfPatch(const unsigned int & patchIndex, const indexing::IndexSet & elementIndices, long * values, const ULONG64 & maxGap = 256);
+
+		/**
+		* Scatter a compact array of values to some elements of an existing patch.
+		* Runs of indices which are separated by at most maxGap unselected elements are written at once : the unselected values in between are read and written back unchanged.
+		* Set maxGap to zero in order to write each run as its own HDF5 hyperslabs, which is slow when there are a lot of short runs.
+		* The minimum and maximum values of the property are not updated. Double values cannot be scattered to a patch stored as scaled integer codes.
+		* @param patchIndex		The index of the patch to write to. Its values must have been written (or created) by fesapi.
+		* @param elementIndices	The indices of the elements in the (linearized) values of the patch.
+		* @param values			The elementIndices.count() values ordered by increasing element index.
+		* @param maxGap			The maximal count of unselected elements which can be rewritten in order to coalesce two runs of selected elements.
+		*/
+		void scatterDoubleValuesOfPatch(const unsigned int & patchIndex, const indexing::IndexSet & elementIndices, const double * values, const ULONG64 & maxGap = 256);
+
+		/**
+		* Same as scatterDoubleValuesOfPatch but for values which are supposed to be long ones.
+		*/
+		void scatterLongValuesOfPatch(const unsigned int & patchIndex, const indexing::IndexSet & elementIndices, const long * values, const ULONG64 & maxGap = 256);
+
+		//***************************
+		//*** Chunk summaries *******
+		//***************************
+
+		/**
+		* Enable or disable the writing of a chunk summary dataset next to the values written by the next pushBack*Hdf5ArrayOfValues calls on this instance.
+		* A chunk summary stores the minimum, the maximum and the count of valid values of each chunk of a dataset. A chunk is one slab along the slowest dimension of the dataset (i.e. one K layer for a 3d cell property) or a fixed count of values for a 1d dataset.
+		* It allows selectElementIndicesOfPatch to skip the chunks which cannot match.
+		* Chunk summaries are disabled by default. Values written by slabs need an explicit call to writeChunkSummaryOfPatch once all slabs are written.
+		*/
+		void enableChunkSummaries(const bool & enable = true) { chunkSummariesEnabled = enable; }
+
+		/**
+		* Check if the writing of chunk summaries is enabled on this instance.
+		*/
+		bool areChunkSummariesEnabled() const { return chunkSummariesEnabled; }
+
+		/**
+		* Compute and write the chunk summary dataset of a patch from its values which are already written in the HDF file.
+		* Values are read one chunk at a time. An existing chunk summary of this patch is overwritten.
+		* @param patchIndex	The index of the patch to summarize. Its values must have been written by fesapi.
+		*/
+		void writeChunkSummaryOfPatch(const unsigned int & patchIndex);
+
+		/**
+		* Check if a patch has a chunk summary dataset in the HDF file.
+		*/
+		bool hasChunkSummaryOfPatch(const unsigned int & patchIndex) const;
+
+		/**
+		* Read the chunk summary of a patch.
+		* @param patchIndex		The index of the patch. It must have a chunk summary.
+		* @param minimums		The minimum valid value of each chunk (the null value or NaN if the chunk has no valid value).
+		* @param maximums		The maximum valid value of each chunk (the null value or NaN if the chunk has no valid value).
+		* @param validCounts	The count of values of each chunk which are neither NaN nor the null value.
+		* @return				The count of values in each chunk (the last chunk may contain less values).
+		*/
+		ULONG64 getChunkSummaryOfPatch(const unsigned int & patchIndex, std::vector<double> & minimums, std::vector<double> & maximums, std::vector<ULONG64> & validCounts) const;
+
+		/**
+		* Select the elements of a patch whose value is in [minimumValue, maximumValue]. Null and NaN values are never selected.
+		* If the patch has a chunk summary, chunks which cannot match are not read at all and chunks which entirely match are selected without being read.
+		* Otherwise, the values are read one chunk at a time.
+		* @param patchIndex		The index of the patch we want to select the elements from.
+		* @param minimumValue	The minimum value (included) of the selected elements.
+		* @param maximumValue	The maximum value (included) of the selected elements.
+		* @param elementIndices	The selected indices (in the linearized values of the patch) are added to this index set.
+		*/
+		void selectElementIndicesOfPatch(const unsigned int & patchIndex, const double & minimumValue, const double & maximumValue, indexing::IndexSet & elementIndices) const;
+
+		/**
+		* Select the elements of a patch which satisfy a range predicate on each of several properties (e.g. porosity in [0.2, 0.3] and facies == 2).
+		* All properties must have the same count of values in this patch (typically properties on the same representation and indexable element).
+		* The patch is processed one chunk at a time so that the memory consumption does not depend on the size of the properties.
+		* On each chunk, the chunk summaries are checked first : a single property which cannot match the chunk discards it without reading any value.
+		* Then the values of the other properties are read and evaluated one property after the other until no element of the chunk is selected anymore.
+		* The chunks are evaluated concurrently by windows of parallel::getMaxThreadCount() chunks while the values are read by the calling thread only.
+		* @param properties		The properties to evaluate. Null and NaN values never match.
+		* @param minimumValues	For each property, the minimum value (included) of the selected elements.
+		* @param maximumValues	For each property, the maximum value (included) of the selected elements.
+		* @param patchIndex		The index of the patch we want to select the elements from.
+		* @param elementIndices	The selected indices (in the linearized values of the patch) are added to this index set.
+		*/
+		static void selectElementIndicesOfPatch(const std::vector<const AbstractValuesProperty*> & properties,
+			const std::vector<double> & minimumValues, const std::vector<double> & maximumValues,
+			const unsigned int & patchIndex, indexing::IndexSet & elementIndices);
+
+		//***************************
+		//*** Property series *******
+		//***************************
+
+		/**
+		* Get the count of elements of a patch of a property series i.e. the count of values of the patch divided by the count of time indices of the series.
+		* Values of a property series are ordered by time index and then by element.
+		*/
+		ULONG64 getSeriesElementCountOfPatch(const unsigned int & patchIndex) const;
+
+		/**
+		* Get the values of all elements of a patch of a property series at a single time index. Only the values of this time index are read.
+		* @param values	It must be preallocated with getSeriesElementCountOfPatch(patchIndex) values.
+		*/
+		void getDoubleValuesOfTimeIndex(const unsigned int & patchIndex, const unsigned int & timeIndex, double * values) const;
+
+		/**
+		* Get the values of a range of elements (typically one K layer of a cell property) of a patch of a property series over a window of time indices.
+		* One hyperslab per time index is read.
+		* @param firstTimeIndex		The first time index of the window.
+		* @param timeIndexCount		The count of time indices of the window.
+		* @param firstElementIndex	The first element of the range.
+		* @param elementCount		The count of elements of the range.
+		* @param values				It must be preallocated with timeIndexCount * elementCount values. Values are ordered by time index and then by element.
+		*/
+		void getDoubleValuesOfTimeWindow(const unsigned int & patchIndex,
+			const unsigned int & firstTimeIndex, const unsigned int & timeIndexCount,
+			const ULONG64 & firstElementIndex, const ULONG64 & elementCount, double * values) const;
+
+		/**
+		* Get the values of some elements of a patch of a property series at all time indices.
+		* If the patch has a history dataset (see writeHistoryOfPatch), one hyperslab per run of consecutive element indices is read.
+		* Otherwise, one hyperslab per run of consecutive element indices and per time index is read.
+		* @param elementIndices	The indices of the elements we want the history of.
+		* @param values			It must be preallocated with elementIndices.count() * getSeriesTimeIndexCount() values.
+		*						Values are ordered by element (increasing index) and then by time index : the history of each element is contiguous.
+		*/
+		void getDoubleValuesOfElementHistory(const unsigned int & patchIndex, const indexing::IndexSet & elementIndices, double * values) const;
+
+		/**
+		* Same as getDoubleValuesOfElementHistory where each time index is stored in a distinct property (typically one property per time step of a time series).
+		* Only the hyperslabs touched by the element indices are read in each property.
+		* @param properties		The properties ordered by time index.
+		* @param values			It must be preallocated with elementIndices.count() * properties.size() values.
+		*						Values are ordered by element (increasing index) and then by property.
+		*/
+		static void getDoubleValuesOfElementHistory(const std::vector<const AbstractValuesProperty*> & properties,
+			const unsigned int & patchIndex, const indexing::IndexSet & elementIndices, double * values);
+
+		/**
+		* Write a transposed copy of the values of a patch of a property series where the history of each element is contiguous.
+		* It is stored as a 2d double dataset (element, time index) next to the values of the patch and it speeds up getDoubleValuesOfElementHistory.
+		* The values of the patch are read and transposed by blocks of elements. It must be called once the values of the patch are written.
+		*/
+		void writeHistoryOfPatch(const unsigned int & patchIndex);
+
+		/**
+		* Check if a patch of a property series has a history dataset in the HDF file.
+		*/
+		bool hasHistoryOfPatch(const unsigned int & patchIndex) const;
+
+		/**
+		* Load all the values of a patch of several properties at once, typically all the values properties of a representation (see AbstractRepresentation::getValuesPropertySet).
+		* The reads are sorted by HDF file and dataset and each HDF file is opened only once. HDF5 converts the stored datatypes at reading.
+		* Values of double HDF5 arrays (i.e. continuous properties) are loaded as doubles where null values are NaN.
+		* Values of integer HDF5 arrays (i.e. discrete and categorical properties) are loaded as longs where null values are the null value of the patch (see getNullValueOfPatch).
+		* The decoding and the compaction of large patches are shared between threads (see parallel::setMaxThreadCount). The reads stay on the calling thread.
+		* Throw a logic_error if a patch is not stored in a double or integer HDF5 array (for instance a constant array).
+		* @param properties		The properties to load.
+		* @param patchIndex		The index of the patch to load in each property.
+		* @param doubleColumns	The loaded double values indexed by the uuid of their property.
+		* @param longColumns	The loaded long values indexed by the uuid of their property.
+		* @param longNullValues	The null value of each long column indexed by the uuid of its property.
+		* @param activeElements	If not null, only the values of the elements corresponding to a set bit are loaded. Its size must be the count of elements of each patch.
+		*/
+		static void loadValuesOfPatch(const std::vector<AbstractValuesProperty*> & properties, const unsigned int & patchIndex,
+			std::map<std::string, std::vector<double> > & doubleColumns, std::map<std::string, std::vector<long> > & longColumns,
+			std::map<std::string, long> & longNullValues, const indexing::BitSet * activeElements = nullptr);
+
+	protected:
+
+		/**
+		* Get the narrowest integer datatype which can store all the values between minimum and maximum as well as a null value.
+		* @param minimum	The minimum non null value. If it is greater than maximum, there is no non null value.
+		* @param maximum	The maximum non null value.
+		* @param nullValue	The wished null value. If it does not fit in the returned datatype, it is changed to a value of this datatype which is not between minimum and maximum.
+		*/
+		static hdfDatatypeEnum getNarrowestIntegerDatatype(const LONG64 & minimum, const LONG64 & maximum, LONG64 & nullValue);
+
+		/**
+		* Decode in place some values read from a dataset if they are stored as scaled integer codes (see the scale_factor, add_offset and _FillValue dataset attributes).
+		* The decoded values are then transformed into value * scale + offset in the same pass (typically a unit of measure conversion). NaN values remain NaN.
+		* It does nothing if the dataset values are not scaled codes and if the transformation is the identity.
+		*/
+		static void decodeScaledValues(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, double * values, const ULONG64 & valueCount,
+			const double & scale = 1, const double & offset = 0);
+		static void decodeScaledValues(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, float * values, const ULONG64 & valueCount,
+			const double & scale = 1, const double & offset = 0);
+
+		/**
+		* Write some long values into a dataset of a narrower integer datatype (see getNarrowestIntegerDatatype).
+		* @param nullValue				The null value of the long values.
+		* @param narrowedNullValue		The value which replaces nullValue in the dataset.
+		* @param datatype				The integer datatype of the dataset.
+		*/
+		void writeNarrowedLongValues(const std::string & datasetName, const long * values, unsigned long long * numValues, const unsigned int & numArrayDimensions,
+			const long & nullValue, const LONG64 & narrowedNullValue, const hdfDatatypeEnum & datatype, COMMON_NS::AbstractHdfProxy* proxy);
+
+	private:
+
+		/**
+		* Read a (potentially strided) hyperslab of a patch into a particular HDF5 datatype and decode floating point values if they are scaled (see decodeScaledValues).
+		*/
+		void readHyperslabOfPatch(const unsigned int & patchIndex, void * values, const int & datatype,
+			unsigned long long * numValuesInEachDimension, unsigned long long * offsetInEachDimension, unsigned long long * strideInEachDimension, const unsigned int & numArrayDimensions);
+
+		/**
+		* Same as readHyperslabOfPatch for a 3d box given from the fastest to the slowest dimension.
+		*/
+		void read3dBoxOfPatch(const unsigned int & patchIndex, void * values, const int & datatype,
+			const unsigned int & valueCountInFastestDim, const unsigned int & valueCountInMiddleDim, const unsigned int & valueCountInSlowestDim,
+			const unsigned int & offsetInFastestDim, const unsigned int & offsetInMiddleDim, const unsigned int & offsetInSlowestDim,
+			const unsigned int & strideInFastestDim, const unsigned int & strideInMiddleDim, const unsigned int & strideInSlowestDim);
+
+		/**
+		* Get the dataset of the values of a patch of a property series and check its consistency with the time indices of the series.
+		*/
+		void getSeriesDatasetOfPatch(const unsigned int & patchIndex, std::string & datasetName, std::vector<unsigned long long> & dimensions, ULONG64 & elementCount) const;
+
+		bool chunkSummariesEnabled;
+
 	};
 }
 
@@ -0,0 +1,537 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2/GridConnectionGeometry.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "common/EpcDocument.h"
+#include "resqml2_0_1/AbstractIjkGridRepresentation.h"
+#include "resqml2_0_1/ContinuousProperty.h"
+#include "tools/Parallel.h"
+
+using namespace std;
+using namespace RESQML2_NS;
+
+namespace {
+	/**
+	* The corners (see AbstractIjkGridRepresentation::getXyzPointIndexFromCellCorner) of each local face of an hexahedron, in a cyclic order.
+	* Local faces are ordered as K-, K+, J-, I+, J+, I-.
+	*/
+	const unsigned int FACE_CORNERS[6][4] = { { 0, 1, 2, 3 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 }, { 1, 2, 6, 5 }, { 2, 3, 7, 6 }, { 3, 0, 4, 7 } };
+
+	/**
+	* The direction of each local face : 0 for I, 1 for J and 2 for K.
+	*/
+	const unsigned char FACE_DIRECTIONS[6] = { 2, 2, 1, 0, 1, 0 };
+
+	struct Point2d
+	{
+		double x;
+		double y;
+	};
+
+	void cross(const double * a, const double * b, double * result)
+	{
+		result[0] = a[1] * b[2] - a[2] * b[1];
+		result[1] = a[2] * b[0] - a[0] * b[2];
+		result[2] = a[0] * b[1] - a[1] * b[0];
+	}
+
+	double dot(const double * a, const double * b)
+	{
+		return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+	}
+
+	/**
+	* Get the local face of a cell which is shared with another cell of the same ijk grid.
+	* @return The local face or -1 if both cells are not ijk neighbors.
+	*/
+	int getNeighborLocalFace(const ULONG64 & cellIndex, const ULONG64 & otherCellIndex, const ULONG64 & iCellCount, const ULONG64 & jCellCount)
+	{
+		const LONG64 di = static_cast<LONG64>(otherCellIndex % iCellCount) - static_cast<LONG64>(cellIndex % iCellCount);
+		const LONG64 dj = static_cast<LONG64>((otherCellIndex / iCellCount) % jCellCount) - static_cast<LONG64>((cellIndex / iCellCount) % jCellCount);
+		const LONG64 dk = static_cast<LONG64>(otherCellIndex / (iCellCount * jCellCount)) - static_cast<LONG64>(cellIndex / (iCellCount * jCellCount));
+		if (dj == 0 && dk == 0) {
+			if (di == 1) return 3;
+			if (di == -1) return 5;
+		}
+		else if (di == 0 && dk == 0) {
+			if (dj == 1) return 4;
+			if (dj == -1) return 2;
+		}
+		else if (di == 0 && dj == 0) {
+			if (dk == 1) return 1;
+			if (dk == -1) return 0;
+		}
+		return -1;
+	}
+
+	/**
+	* Get the XYZ coordinates of the 8 corners of a cell and of its center.
+	* @param cornerPointIndices	The indices of the 8 corner points of the cell (see AbstractIjkGridRepresentation::getXyzPointIndicesOfCellCorners).
+	*/
+	void getCellCorners(const std::vector<double> & xyzPoints, const ULONG64 * cornerPointIndices, double * corners, double * center)
+	{
+		center[0] = center[1] = center[2] = 0;
+		for (unsigned int corner = 0; corner < 8; ++corner) {
+			for (unsigned int d = 0; d < 3; ++d) {
+				corners[corner * 3 + d] = xyzPoints[cornerPointIndices[corner] * 3 + d];
+				center[d] += corners[corner * 3 + d] / 8;
+			}
+		}
+	}
+
+	/**
+	* Get the area vector (oriented outward the cell) and the center of a local face of a cell.
+	*/
+	void getFaceAreaVector(const double * corners, const double * cellCenter, const unsigned int & localFace, double * areaVector, double * faceCenter)
+	{
+		const double* p0 = corners + FACE_CORNERS[localFace][0] * 3;
+		const double* p1 = corners + FACE_CORNERS[localFace][1] * 3;
+		const double* p2 = corners + FACE_CORNERS[localFace][2] * 3;
+		const double* p3 = corners + FACE_CORNERS[localFace][3] * 3;
+		double diagonal1[3];
+		double diagonal2[3];
+		double outward[3];
+		for (unsigned int d = 0; d < 3; ++d) {
+			diagonal1[d] = p2[d] - p0[d];
+			diagonal2[d] = p3[d] - p1[d];
+			faceCenter[d] = (p0[d] + p1[d] + p2[d] + p3[d]) / 4;
+			outward[d] = faceCenter[d] - cellCenter[d];
+		}
+		cross(diagonal1, diagonal2, areaVector);
+		const double factor = dot(areaVector, outward) < 0 ? -0.5 : 0.5;
+		for (unsigned int d = 0; d < 3; ++d) {
+			areaVector[d] *= factor;
+		}
+	}
+
+	/**
+	* Twice the signed area of a 2d polygon. It is positive for a counterclockwise polygon.
+	*/
+	double getDoubleSignedArea(const std::vector<Point2d> & polygon)
+	{
+		double result = 0;
+		for (size_t i = 0; i < polygon.size(); ++i) {
+			const Point2d & current = polygon[i];
+			const Point2d & next = polygon[(i + 1) % polygon.size()];
+			result += current.x * next.y - next.x * current.y;
+		}
+		return result;
+	}
+
+	/**
+	* Positive if point is on the left of the oriented line going from a to b.
+	*/
+	double getSide(const Point2d & a, const Point2d & b, const Point2d & point)
+	{
+		return (b.x - a.x) * (point.y - a.y) - (b.y - a.y) * (point.x - a.x);
+	}
+
+	/**
+	* Clip a polygon by a convex counterclockwise polygon (Sutherland-Hodgman).
+	* @param subject	The polygon to clip. It is replaced by the clipped polygon which may be empty.
+	*/
+	void clipPolygon(std::vector<Point2d> & subject, const std::vector<Point2d> & clip)
+	{
+		std::vector<Point2d> input;
+		for (size_t edge = 0; edge < clip.size() && !subject.empty(); ++edge) {
+			const Point2d & a = clip[edge];
+			const Point2d & b = clip[(edge + 1) % clip.size()];
+			input.swap(subject);
+			subject.clear();
+			for (size_t i = 0; i < input.size(); ++i) {
+				const Point2d & previous = input[(i + input.size() - 1) % input.size()];
+				const Point2d & current = input[i];
+				const double previousSide = getSide(a, b, previous);
+				const double currentSide = getSide(a, b, current);
+				if ((previousSide >= 0) != (currentSide >= 0)) {
+					const double t = previousSide / (previousSide - currentSide);
+					Point2d intersection;
+					intersection.x = previous.x + t * (current.x - previous.x);
+					intersection.y = previous.y + t * (current.y - previous.y);
+					subject.push_back(intersection);
+				}
+				if (currentSide >= 0) {
+					subject.push_back(current);
+				}
+			}
+		}
+	}
+
+	/**
+	* Project the corners of a face onto a plane as a counterclockwise 2d polygon.
+	*/
+	void projectFace(const double * corners, const unsigned int & localFace, const double * origin, const double * u, const double * v, std::vector<Point2d> & polygon)
+	{
+		polygon.resize(4);
+		for (unsigned int i = 0; i < 4; ++i) {
+			const double* corner = corners + FACE_CORNERS[localFace][i] * 3;
+			const double relative[3] = { corner[0] - origin[0], corner[1] - origin[1], corner[2] - origin[2] };
+			polygon[i].x = dot(relative, u);
+			polygon[i].y = dot(relative, v);
+		}
+		if (getDoubleSignedArea(polygon) < 0) {
+			std::swap(polygon[1], polygon[3]);
+		}
+	}
+
+	/**
+	* Read all the values of a scalar continuous property on the cells of an ijk grid.
+	* @param values	Let empty if the property is null.
+	*/
+	void readCellValues(RESQML2_0_1_NS::ContinuousProperty* prop, RESQML2_0_1_NS::AbstractIjkGridRepresentation* grid, std::vector<double> & values)
+	{
+		values.clear();
+		if (prop == nullptr) {
+			return;
+		}
+		if (prop->getRepresentation() != grid) {
+			throw invalid_argument("The property " + prop->getUuid() + " is not supported by the expected grid of the grid connection set.");
+		}
+
+		const unsigned int patchCount = prop->getPatchCount();
+		ULONG64 valueCount = 0;
+		for (unsigned int patchIndex = 0; patchIndex < patchCount; ++patchIndex) {
+			valueCount += prop->getValuesCountOfPatch(patchIndex);
+		}
+		if (valueCount != grid->getCellCount()) {
+			throw invalid_argument("The property " + prop->getUuid() + " does not have a single value per cell of its grid.");
+		}
+
+		values.resize(valueCount);
+		ULONG64 offset = 0;
+		for (unsigned int patchIndex = 0; patchIndex < patchCount; ++patchIndex) {
+			prop->getDoubleValuesOfPatch(patchIndex, &values[offset]);
+			offset += prop->getValuesCountOfPatch(patchIndex);
+		}
+	}
+}
+
+GridConnectionGeometry::GridConnectionGeometry(GridConnectionSetRepresentation* gcs) : gridConnectionSet(gcs)
+{
+	if (gcs == nullptr) {
+		throw invalid_argument("The grid connection set cannot be null.");
+	}
+
+	const unsigned int gridCount = gcs->getSupportingGridRepresentationCount();
+	std::vector<RESQML2_0_1_NS::AbstractIjkGridRepresentation*> grids(gridCount);
+	std::vector< std::vector<double> > xyzPointsOfGrids(gridCount);
+	for (unsigned int gridIndex = 0; gridIndex < gridCount; ++gridIndex) {
+		grids[gridIndex] = dynamic_cast<RESQML2_0_1_NS::AbstractIjkGridRepresentation*>(gcs->getSupportingGridRepresentation(gridIndex));
+		if (grids[gridIndex] == nullptr) {
+			throw invalid_argument("The grid connection set " + gcs->getUuid() + " is not only supported by ijk grids.");
+		}
+		xyzPointsOfGrids[gridIndex].resize(grids[gridIndex]->getXyzPointCountOfAllPatches() * 3);
+		grids[gridIndex]->getXyzPointsOfAllPatches(&xyzPointsOfGrids[gridIndex][0]);
+	}
+
+	const ULONG64 connectionCount = gcs->getCellIndexPairCount();
+	cellIndexPairs.resize(connectionCount * 2);
+	const ULONG64 cellNullValue = connectionCount > 0 ? gcs->getCellIndexPairs(&cellIndexPairs[0]) : 0;
+	gridIndexPairs.assign(connectionCount * 2, 0);
+	if (gcs->isBasedOnMultiGrids() && connectionCount > 0) {
+		gcs->getGridIndexPairs(&gridIndexPairs[0]);
+	}
+	std::vector<int> localFacePairs;
+	LONG64 localFaceNullValue = -1;
+	if (gcs->hasLocalFacePerCell() && connectionCount > 0) {
+		localFacePairs.resize(connectionCount * 2);
+		localFaceNullValue = gcs->getLocalFacePerCellIndexPairs(&localFacePairs[0]);
+	}
+
+	const double nan = numeric_limits<double>::quiet_NaN();
+	overlapAreas.assign(connectionCount, 0);
+	overlapCentroids.assign(connectionCount * 3, nan);
+	overlapNormals.assign(connectionCount * 3, 0);
+	polygonOffsets.assign(connectionCount + 1, 0);
+	cellCenters.assign(connectionCount * 6, nan);
+	faceDirections.assign(connectionCount * 2, 0);
+
+	// The connected faces and the corner points of both cells are looked up on the calling thread : the grids may have to reload their split information.
+	std::vector<int> localFacesOfConnections(connectionCount * 2, -1);
+	std::vector<ULONG64> cornerPointIndices(connectionCount * 16);
+	for (ULONG64 connection = 0; connection < connectionCount; ++connection) {
+		int localFaces[2] = { -1, -1 };
+		bool isValid = true;
+		for (unsigned int side = 0; side < 2 && isValid; ++side) {
+			const ULONG64 cellIndex = cellIndexPairs[connection * 2 + side];
+			const unsigned short gridIndex = gridIndexPairs[connection * 2 + side];
+			isValid = cellIndex != cellNullValue && gridIndex < gridCount && cellIndex < grids[gridIndex]->getCellCount();
+			if (isValid && !localFacePairs.empty()) {
+				localFaces[side] = localFacePairs[connection * 2 + side];
+				isValid = localFaces[side] != localFaceNullValue && localFaces[side] >= 0 && localFaces[side] < 6;
+			}
+		}
+		if (!isValid) {
+			continue;
+		}
+		if (localFacePairs.empty()) {
+			if (gridIndexPairs[connection * 2] != gridIndexPairs[connection * 2 + 1]) {
+				continue;
+			}
+			const RESQML2_0_1_NS::AbstractIjkGridRepresentation* grid = grids[gridIndexPairs[connection * 2]];
+			localFaces[0] = getNeighborLocalFace(cellIndexPairs[connection * 2], cellIndexPairs[connection * 2 + 1], grid->getICellCount(), grid->getJCellCount());
+			if (localFaces[0] < 0) {
+				continue;
+			}
+			// K- <-> K+, J- <-> J+ and I+ <-> I-
+			localFaces[1] = localFaces[0] < 2 ? localFaces[0] ^ 1 : localFaces[0] % 4 + 2;
+		}
+
+		for (unsigned int side = 0; side < 2; ++side) {
+			const RESQML2_0_1_NS::AbstractIjkGridRepresentation* grid = grids[gridIndexPairs[connection * 2 + side]];
+			const ULONG64 cellIndex = cellIndexPairs[connection * 2 + side];
+			const ULONG64 iCellCount = grid->getICellCount();
+			const ULONG64 jCellCount = grid->getJCellCount();
+			grid->getXyzPointIndicesOfCellCorners(static_cast<unsigned int>(cellIndex % iCellCount), static_cast<unsigned int>((cellIndex / iCellCount) % jCellCount),
+				static_cast<unsigned int>(cellIndex / (iCellCount * jCellCount)), &cornerPointIndices[connection * 16 + side * 8]);
+			localFacesOfConnections[connection * 2 + side] = localFaces[side];
+		}
+	}
+
+	// Each connection only writes its own slots : the connections are shared between threads.
+	// The overlap polygons of each chunk of connections are gathered apart and concatenated in the chunk order afterwards.
+	const unsigned int chunkCount = parallel::getChunkCount(connectionCount, 1024);
+	std::vector< std::vector<double> > polygonPointsOfChunks(chunkCount);
+	parallel::forEachChunk(connectionCount, chunkCount, [&](const unsigned int & chunkIndex, const uint64_t & firstConnection, const uint64_t & endConnection) {
+		std::vector<double> & chunkPolygonPoints = polygonPointsOfChunks[chunkIndex];
+		double corners[2][24];
+		double areaVectors[2][3];
+		double faceCenters[2][3];
+		std::vector<Point2d> polygon;
+		std::vector<Point2d> clip;
+		for (ULONG64 connection = firstConnection; connection < endConnection; ++connection) {
+			const int* localFaces = &localFacesOfConnections[connection * 2];
+			if (localFaces[0] < 0) {
+				continue;
+			}
+
+			for (unsigned int side = 0; side < 2; ++side) {
+				const unsigned short gridIndex = gridIndexPairs[connection * 2 + side];
+				getCellCorners(xyzPointsOfGrids[gridIndex], &cornerPointIndices[connection * 16 + side * 8], corners[side], &cellCenters[connection * 6 + side * 3]);
+				getFaceAreaVector(corners[side], &cellCenters[connection * 6 + side * 3], localFaces[side], areaVectors[side], faceCenters[side]);
+				faceDirections[connection * 2 + side] = FACE_DIRECTIONS[localFaces[side]];
+			}
+
+			// The projection plane is the average of both faces
+			double normal[3] = { areaVectors[0][0] - areaVectors[1][0], areaVectors[0][1] - areaVectors[1][1], areaVectors[0][2] - areaVectors[1][2] };
+			const double normalLength = sqrt(dot(normal, normal));
+			if (normalLength == 0) {
+				continue;
+			}
+			for (unsigned int d = 0; d < 3; ++d) {
+				normal[d] /= normalLength;
+			}
+			double axis[3] = { 0, 0, 0 };
+			axis[fabs(normal[0]) <= fabs(normal[1]) && fabs(normal[0]) <= fabs(normal[2]) ? 0 : (fabs(normal[1]) <= fabs(normal[2]) ? 1 : 2)] = 1;
+			double u[3];
+			cross(normal, axis, u);
+			const double uLength = sqrt(dot(u, u));
+			for (unsigned int d = 0; d < 3; ++d) {
+				u[d] /= uLength;
+			}
+			double v[3];
+			cross(normal, u, v);
+
+			projectFace(corners[0], localFaces[0], faceCenters[0], u, v, polygon);
+			projectFace(corners[1], localFaces[1], faceCenters[0], u, v, clip);
+			if (getDoubleSignedArea(polygon) <= 0 || getDoubleSignedArea(clip) <= 0) {
+				continue;
+			}
+			clipPolygon(polygon, clip);
+			const double doubleArea = polygon.size() < 3 ? 0 : getDoubleSignedArea(polygon);
+			if (doubleArea <= 0) {
+				continue;
+			}
+
+			// Area, centroid and polygon in 3d
+			double centroidX = 0;
+			double centroidY = 0;
+			for (size_t i = 0; i < polygon.size(); ++i) {
+				const Point2d & current = polygon[i];
+				const Point2d & next = polygon[(i + 1) % polygon.size()];
+				const double crossProduct = current.x * next.y - next.x * current.y;
+				centroidX += (current.x + next.x) * crossProduct;
+				centroidY += (current.y + next.y) * crossProduct;
+				for (unsigned int d = 0; d < 3; ++d) {
+					chunkPolygonPoints.push_back(faceCenters[0][d] + current.x * u[d] + current.y * v[d]);
+				}
+			}
+			centroidX /= 3 * doubleArea;
+			centroidY /= 3 * doubleArea;
+			overlapAreas[connection] = doubleArea / 2;
+			polygonOffsets[connection + 1] = polygon.size();
+			for (unsigned int d = 0; d < 3; ++d) {
+				overlapCentroids[connection * 3 + d] = faceCenters[0][d] + centroidX * u[d] + centroidY * v[d];
+				overlapNormals[connection * 3 + d] = normal[d];
+			}
+		}
+	});
+
+	// The vertex counts of the overlap polygons become offsets
+	for (ULONG64 connection = 0; connection < connectionCount; ++connection) {
+		polygonOffsets[connection + 1] += polygonOffsets[connection];
+	}
+	polygonPoints.reserve(polygonOffsets[connectionCount] * 3);
+	for (unsigned int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex) {
+		polygonPoints.insert(polygonPoints.end(), polygonPointsOfChunks[chunkIndex].begin(), polygonPointsOfChunks[chunkIndex].end());
+	}
+}
+
+void GridConnectionGeometry::getOverlapAreas(double * areas) const
+{
+	for (size_t i = 0; i < overlapAreas.size(); ++i) {
+		areas[i] = overlapAreas[i];
+	}
+}
+
+void GridConnectionGeometry::getOverlapCentroids(double * centroids) const
+{
+	for (size_t i = 0; i < overlapCentroids.size(); ++i) {
+		centroids[i] = overlapCentroids[i];
+	}
+}
+
+void GridConnectionGeometry::getOverlapNormals(double * normals) const
+{
+	for (size_t i = 0; i < overlapNormals.size(); ++i) {
+		normals[i] = overlapNormals[i];
+	}
+}
+
+unsigned int GridConnectionGeometry::getOverlapPolygonVertexCount(const ULONG64 & connectionIndex) const
+{
+	if (connectionIndex >= getConnectionCount()) {
+		throw out_of_range("The connection index is out of range.");
+	}
+	return static_cast<unsigned int>(polygonOffsets[connectionIndex + 1] - polygonOffsets[connectionIndex]);
+}
+
+void GridConnectionGeometry::getOverlapPolygon(const ULONG64 & connectionIndex, double * xyzPoints) const
+{
+	if (connectionIndex >= getConnectionCount()) {
+		throw out_of_range("The connection index is out of range.");
+	}
+	for (ULONG64 i = polygonOffsets[connectionIndex] * 3; i < polygonOffsets[connectionIndex + 1] * 3; ++i) {
+		xyzPoints[i - polygonOffsets[connectionIndex] * 3] = polygonPoints[i];
+	}
+}
+
+void GridConnectionGeometry::computeTransmissibilities(double * transmissibilities,
+	RESQML2_0_1_NS::ContinuousProperty* permeabilityI, RESQML2_0_1_NS::ContinuousProperty* permeabilityJ, RESQML2_0_1_NS::ContinuousProperty* permeabilityK,
+	RESQML2_0_1_NS::ContinuousProperty* netToGrossRatio, const double & darcyConstant) const
+{
+	if (gridConnectionSet->getSupportingGridRepresentationCount() != 1) {
+		throw invalid_argument("The grid connection set must be based on a single grid. Give the properties of each supporting grid instead.");
+	}
+
+	std::vector<RESQML2_0_1_NS::ContinuousProperty*> netToGrossRatios;
+	if (netToGrossRatio != nullptr) {
+		netToGrossRatios.push_back(netToGrossRatio);
+	}
+	computeTransmissibilities(transmissibilities,
+		std::vector<RESQML2_0_1_NS::ContinuousProperty*>(1, permeabilityI), std::vector<RESQML2_0_1_NS::ContinuousProperty*>(1, permeabilityJ), std::vector<RESQML2_0_1_NS::ContinuousProperty*>(1, permeabilityK),
+		netToGrossRatios, darcyConstant);
+}
+
+void GridConnectionGeometry::computeTransmissibilities(double * transmissibilities,
+	const std::vector<RESQML2_0_1_NS::ContinuousProperty*> & permeabilitiesI, const std::vector<RESQML2_0_1_NS::ContinuousProperty*> & permeabilitiesJ, const std::vector<RESQML2_0_1_NS::ContinuousProperty*> & permeabilitiesK,
+	const std::vector<RESQML2_0_1_NS::ContinuousProperty*> & netToGrossRatios, const double & darcyConstant) const
+{
+	const unsigned int gridCount = gridConnectionSet->getSupportingGridRepresentationCount();
+	if (permeabilitiesI.size() != gridCount || permeabilitiesJ.size() != gridCount || permeabilitiesK.size() != gridCount ||
+		(!netToGrossRatios.empty() && netToGrossRatios.size() != gridCount)) {
+		throw invalid_argument("There must be one property per supporting grid of the grid connection set.");
+	}
+
+	// Read the cell values of all grids
+	std::vector< std::vector<double> > permeabilities[3];
+	std::vector< std::vector<double> > netToGross(gridCount);
+	for (unsigned int direction = 0; direction < 3; ++direction) {
+		permeabilities[direction].resize(gridCount);
+	}
+	for (unsigned int gridIndex = 0; gridIndex < gridCount; ++gridIndex) {
+		RESQML2_0_1_NS::AbstractIjkGridRepresentation* grid = static_cast<RESQML2_0_1_NS::AbstractIjkGridRepresentation*>(gridConnectionSet->getSupportingGridRepresentation(gridIndex));
+		if (permeabilitiesI[gridIndex] == nullptr || permeabilitiesJ[gridIndex] == nullptr || permeabilitiesK[gridIndex] == nullptr) {
+			throw invalid_argument("The permeability properties cannot be null.");
+		}
+		readCellValues(permeabilitiesI[gridIndex], grid, permeabilities[0][gridIndex]);
+		readCellValues(permeabilitiesJ[gridIndex], grid, permeabilities[1][gridIndex]);
+		readCellValues(permeabilitiesK[gridIndex], grid, permeabilities[2][gridIndex]);
+		if (!netToGrossRatios.empty()) {
+			readCellValues(netToGrossRatios[gridIndex], grid, netToGross[gridIndex]);
+		}
+	}
+
+	const ULONG64 connectionCount = getConnectionCount();
+	for (ULONG64 connection = 0; connection < connectionCount; ++connection) {
+		if (overlapAreas[connection] == 0) {
+			transmissibilities[connection] = 0;
+			continue;
+		}
+
+		double halfTransmissibilities[2];
+		for (unsigned int side = 0; side < 2; ++side) {
+			const unsigned short gridIndex = gridIndexPairs[connection * 2 + side];
+			const ULONG64 cellIndex = cellIndexPairs[connection * 2 + side];
+			const unsigned char direction = faceDirections[connection * 2 + side];
+			double permeability = permeabilities[direction][gridIndex][cellIndex];
+			if (direction != 2 && !netToGross[gridIndex].empty()) {
+				permeability *= netToGross[gridIndex][cellIndex];
+			}
+
+			double centerToCentroid[3];
+			for (unsigned int d = 0; d < 3; ++d) {
+				centerToCentroid[d] = overlapCentroids[connection * 3 + d] - cellCenters[connection * 6 + side * 3 + d];
+			}
+			const double squaredDistance = dot(centerToCentroid, centerToCentroid);
+			halfTransmissibilities[side] = permeability * overlapAreas[connection] * fabs(dot(&overlapNormals[connection * 3], centerToCentroid)) / squaredDistance;
+		}
+
+		const double sum = halfTransmissibilities[0] + halfTransmissibilities[1];
+		transmissibilities[connection] = sum == 0 ? 0 : darcyConstant * halfTransmissibilities[0] * halfTransmissibilities[1] / sum;
+	}
+}
+
+RESQML2_0_1_NS::ContinuousProperty* GridConnectionGeometry::createOverlapAreaProperty(const std::string & guid, const std::string & title,
+	const gsoap_resqml2_0_1::resqml2__ResqmlUom & uom, COMMON_NS::AbstractHdfProxy* proxy) const
+{
+	RESQML2_0_1_NS::ContinuousProperty* result = gridConnectionSet->getEpcDocument()->createContinuousProperty(gridConnectionSet, guid, title, 1,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__faces, uom, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__area);
+	if (!overlapAreas.empty()) {
+		result->pushBackDoubleHdf5Array1dOfValues(&overlapAreas[0], overlapAreas.size(), proxy);
+	}
+
+	return result;
+}
+
+RESQML2_0_1_NS::ContinuousProperty* GridConnectionGeometry::createTransmissibilityProperty(const std::string & guid, const std::string & title, const double * transmissibilities,
+	const gsoap_resqml2_0_1::resqml2__ResqmlUom & uom, COMMON_NS::AbstractHdfProxy* proxy) const
+{
+	RESQML2_0_1_NS::ContinuousProperty* result = gridConnectionSet->getEpcDocument()->createContinuousProperty(gridConnectionSet, guid, title, 1,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__faces, uom, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__transmissibility);
+	if (getConnectionCount() > 0) {
+		result->pushBackDoubleHdf5Array1dOfValues(transmissibilities, getConnectionCount(), proxy);
+	}
+
+	return result;
+}
@@ -0,0 +1,146 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#pragma once
+
+#include "resqml2/GridConnectionSetRepresentation.h"
+
+namespace RESQML2_0_1_NS
+{
+	class ContinuousProperty;
+}
+
+namespace RESQML2_NS
+{
+	/**
+	* The geometry of the connections of a grid connection set (fault connections and other non neighbor connections) and their two point transmissibilities.
+	* For each connection, the two connected cell faces are projected on their average plane and the overlap polygon is computed by clipping one face by the other.
+	* It gives the overlap area, centroid and unit normal of the connection which are then combined with the permeability (and net to gross ratio) of both cells
+	* in order to get a harmonic two point transmissibility.
+	* Only connections between cells of ijk grids are supported.
+	*/
+	class DLL_IMPORT_OR_EXPORT GridConnectionGeometry
+	{
+	public:
+
+		/**
+		* Compute the overlap polygons of all the connections of a grid connection set.
+		* The split information of the faulted supporting grids must have been loaded before (see AbstractIjkGridRepresentation::loadSplitInformation).
+		* If the grid connection set has no local face per cell, the connected faces are only inferred for ijk neighbor cells (other connections get a null overlap).
+		* The corner points of the connected cells are looked up on the calling thread, then the overlap polygons are computed by several threads.
+		* @param gridConnectionSet	The grid connection set. All its supporting grids must be ijk grids.
+		*/
+		GridConnectionGeometry(GridConnectionSetRepresentation* gridConnectionSet);
+		~GridConnectionGeometry() {}
+
+		GridConnectionSetRepresentation* getGridConnectionSet() const { return gridConnectionSet; }
+		ULONG64 getConnectionCount() const { return overlapAreas.size(); }
+
+		/**
+		* Get the overlap areas of all connections in the length unit of the local CRS squared.
+		* A connection which has a null cell or face, or whose faces do not overlap, has a zero area.
+		* @param areas	It must be preallocated with getConnectionCount().
+		*/
+		void getOverlapAreas(double * areas) const;
+
+		/**
+		* Get the centroids of the overlap polygons of all connections. A connection with a zero area has a NaN centroid.
+		* @param centroids	It must be preallocated with 3 * getConnectionCount() (XYZ triplets).
+		*/
+		void getOverlapCentroids(double * centroids) const;
+
+		/**
+		* Get the unit normals of the overlap polygons of all connections. They are oriented from the first cell to the second cell of each connection.
+		* A connection with a zero area has a zero normal.
+		* @param normals	It must be preallocated with 3 * getConnectionCount() (XYZ triplets).
+		*/
+		void getOverlapNormals(double * normals) const;
+
+		/**
+		* Get the count of vertices of the overlap polygon of a connection.
+		*/
+		unsigned int getOverlapPolygonVertexCount(const ULONG64 & connectionIndex) const;
+
+		/**
+		* Get the vertices of the overlap polygon of a connection.
+		* @param xyzPoints	It must be preallocated with 3 * getOverlapPolygonVertexCount(connectionIndex).
+		*/
+		void getOverlapPolygon(const ULONG64 & connectionIndex, double * xyzPoints) const;
+
+		/**
+		* Compute the two point transmissibilities of all connections of a grid connection set based on a single grid.
+		* The half transmissibility of each cell is k.A.d/(d.d) where A is the overlap area vector and d goes from the cell center to the overlap centroid.
+		* The permeability k is the one of the direction of the connected face, multiplied by the net to gross ratio for I and J faces.
+		* The transmissibility of the connection is darcyConstant.T1.T2/(T1+T2). It is zero for a connection with a zero area and NaN if an input value is NaN.
+		* @param transmissibilities	It must be preallocated with getConnectionCount().
+		* @param permeabilityI		The permeability property in the I direction. It must be a scalar property on the cells of the grid.
+		* @param permeabilityJ		The permeability property in the J direction. It must be a scalar property on the cells of the grid.
+		* @param permeabilityK		The permeability property in the K direction. It must be a scalar property on the cells of the grid.
+		* @param netToGrossRatio	The optional net to gross ratio property. It must be a scalar property on the cells of the grid.
+		* @param darcyConstant		The unit conversion constant to apply to the transmissibilities.
+		*/
+		void computeTransmissibilities(double * transmissibilities,
+			RESQML2_0_1_NS::ContinuousProperty* permeabilityI, RESQML2_0_1_NS::ContinuousProperty* permeabilityJ, RESQML2_0_1_NS::ContinuousProperty* permeabilityK,
+			RESQML2_0_1_NS::ContinuousProperty* netToGrossRatio = nullptr, const double & darcyConstant = 1.0) const;
+
+		/**
+		* Same as above but for a grid connection set based on several grids.
+		* The properties are given for each supporting grid in the order of the grid connection set (the net to gross vector may be empty).
+		*/
+		void computeTransmissibilities(double * transmissibilities,
+			const std::vector<RESQML2_0_1_NS::ContinuousProperty*> & permeabilitiesI, const std::vector<RESQML2_0_1_NS::ContinuousProperty*> & permeabilitiesJ, const std::vector<RESQML2_0_1_NS::ContinuousProperty*> & permeabilitiesK,
+			const std::vector<RESQML2_0_1_NS::ContinuousProperty*> & netToGrossRatios, const double & darcyConstant = 1.0) const;
+
+		/**
+		* Create a continuous property on the faces of the grid connection set which stores the overlap area of each connection.
+		* @param guid	The guid to set to the property. If empty then a new guid will be generated.
+		* @param title	A title for the property.
+		* @param uom	The unit of measure of the areas. It must be consistent with the length unit of the local CRS of the supporting grids.
+		* @param proxy	The HDF proxy where the areas are going to be stored.
+		*/
+		RESQML2_0_1_NS::ContinuousProperty* createOverlapAreaProperty(const std::string & guid, const std::string & title,
+			const gsoap_resqml2_0_1::resqml2__ResqmlUom & uom, COMMON_NS::AbstractHdfProxy* proxy) const;
+
+		/**
+		* Create a continuous property on the faces of the grid connection set which stores the transmissibility of each connection.
+		* @param guid					The guid to set to the property. If empty then a new guid will be generated.
+		* @param title					A title for the property.
+		* @param transmissibilities		The transmissibilities of all connections (see computeTransmissibilities).
+		* @param uom					The unit of measure of the transmissibilities.
+		* @param proxy					The HDF proxy where the transmissibilities are going to be stored.
+		*/
+		RESQML2_0_1_NS::ContinuousProperty* createTransmissibilityProperty(const std::string & guid, const std::string & title, const double * transmissibilities,
+			const gsoap_resqml2_0_1::resqml2__ResqmlUom & uom, COMMON_NS::AbstractHdfProxy* proxy) const;
+
+	private:
+
+		GridConnectionSetRepresentation* gridConnectionSet;
+
+		std::vector<double> overlapAreas;
+		std::vector<double> overlapCentroids;		// XYZ triplets
+		std::vector<double> overlapNormals;			// XYZ triplets
+		std::vector<ULONG64> polygonOffsets;		// first vertex of each overlap polygon (one more entry for the total)
+		std::vector<double> polygonPoints;			// XYZ triplets
+
+		// Needed for the transmissibility computation
+		std::vector<double> cellCenters;			// XYZ triplets of both cells of each connection
+		std::vector<ULONG64> cellIndexPairs;
+		std::vector<unsigned short> gridIndexPairs;
+		std::vector<unsigned char> faceDirections;	// 0 for I, 1 for J and 2 for K for both faces of each connection
+	};
+}
@@ -99,11 +99,20 @@ namespace RESQML2_NS
 		* Get the cell index pairs, the grid index pairs (optional) and the local face pairs (optional) which correspond to a particular  interpretation.
 		* @param cellIndexPairs			Mandatory. Must be allocated with getCellIndexPairCountFromIndex first.
 		* @param gridIndexPairs			Optional (put null if you don't want it). Must be allocated with getCellIndexPairCountFromIndex first.
+		*								As for getGridIndexPairs, an invalid_argument exception is thrown if it is not null and this representation is not based on multiple grids.
 		* @param localFaceIndexPairs	Optional (put null if you don't want it). Must be allocated with getCellIndexPairCountFromIndex first.
+		*								As for getLocalFacePerCellIndexPairs, an invalid_argument exception is thrown if it is not null and this representation has no local face per cell.
 		* @param interpretationIndex	The index of the interpretation in the collection of feature interpretation of this grid connection set.
 		*/
 		virtual void getGridConnectionSetInformationFromInterpretationIndex(ULONG64 * cellIndexPairs, unsigned short * gridIndexPairs, int * localFaceIndexPairs, const unsigned int & interpretationIndex) const = 0;
 
+		/**
+		* Get the indices of the connections (i.e. of the cell index pairs) which correspond to a particular interpretation, in increasing order.
+		* @param connectionIndices		Must be allocated with getCellIndexPairCountFromInterpretationIndex first.
+		* @param interpretationIndex	The index of the interpretation in the collection of feature interpretation of this grid connection set.
+		*/
+		virtual void getConnectionIndicesFromInterpretationIndex(ULONG64 * connectionIndices, const unsigned int & interpretationIndex) const = 0;
+
 		/**
 		* Get the UUID of a particular interpretation of this grid connection set.
 		* @param interpretationIndex The index of the interpretation in the collection of feature interpretation of this grid connection set.
@@ -0,0 +1,740 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2/GridPartition.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+
+#include "common/EpcDocument.h"
+#include "resqml2/GridConnectionSetRepresentation.h"
+#include "resqml2_0_1/AbstractIjkGridRepresentation.h"
+#include "resqml2_0_1/UnstructuredGridRepresentation.h"
+#include "resqml2_0_1/DiscreteProperty.h"
+
+using namespace std;
+using namespace RESQML2_NS;
+
+namespace {
+	const unsigned int NO_PART = (numeric_limits<unsigned int>::max)();
+	const ULONG64 NO_VERTEX = (numeric_limits<ULONG64>::max)();
+
+	/**
+	* A weighted undirected graph in compressed sparse row format. Each edge is stored in both directions.
+	*/
+	struct CellGraph
+	{
+		std::vector<ULONG64> offsets;
+		std::vector<ULONG64> adjacency;
+		std::vector<unsigned int> edgeWeights;
+		std::vector<unsigned int> vertexWeights;
+
+		ULONG64 getVertexCount() const { return vertexWeights.size(); }
+	};
+
+	/**
+	* Sort the neighbors of each vertex and merge the duplicated ones by summing their edge weights.
+	*/
+	void mergeDuplicatedEdges(CellGraph & graph)
+	{
+		const ULONG64 vertexCount = graph.getVertexCount();
+		std::vector<std::pair<ULONG64, unsigned int> > row;
+		ULONG64 kept = 0;
+		ULONG64 begin = 0;
+		for (ULONG64 v = 0; v < vertexCount; ++v) {
+			const ULONG64 end = graph.offsets[v + 1];
+			row.clear();
+			for (ULONG64 e = begin; e < end; ++e) {
+				row.push_back(std::make_pair(graph.adjacency[e], graph.edgeWeights[e]));
+			}
+			std::sort(row.begin(), row.end());
+			for (size_t i = 0; i < row.size(); ++i) {
+				if (i > 0 && row[i].first == row[i - 1].first) {
+					graph.edgeWeights[kept - 1] += row[i].second;
+				}
+				else {
+					graph.adjacency[kept] = row[i].first;
+					graph.edgeWeights[kept] = row[i].second;
+					++kept;
+				}
+			}
+			begin = end;
+			graph.offsets[v + 1] = kept;
+		}
+		graph.adjacency.resize(kept);
+		graph.edgeWeights.resize(kept);
+	}
+
+	/**
+	* Add some edges to a graph and merge them with the existing ones.
+	* @param pairs	The vertex pairs of the edges to add. An edge is added in both directions.
+	*/
+	void addEdges(CellGraph & graph, const std::vector<ULONG64> & pairs)
+	{
+		const ULONG64 vertexCount = graph.getVertexCount();
+		std::vector<ULONG64> extraCount(vertexCount, 0);
+		for (size_t i = 0; i < pairs.size(); ++i) {
+			++extraCount[pairs[i]];
+		}
+
+		// Shift the existing rows to make room for the new edges, from the last row to the first one
+		const ULONG64 newEdgeCount = graph.adjacency.size() + pairs.size();
+		graph.adjacency.resize(newEdgeCount);
+		graph.edgeWeights.resize(newEdgeCount);
+		std::vector<ULONG64> newOffsets(vertexCount + 1, 0);
+		for (ULONG64 v = 0; v < vertexCount; ++v) {
+			newOffsets[v + 1] = newOffsets[v] + graph.offsets[v + 1] - graph.offsets[v] + extraCount[v];
+		}
+		for (ULONG64 v = vertexCount; v-- > 0;) {
+			const ULONG64 rowSize = graph.offsets[v + 1] - graph.offsets[v];
+			for (ULONG64 e = rowSize; e-- > 0;) {
+				graph.adjacency[newOffsets[v] + e] = graph.adjacency[graph.offsets[v] + e];
+				graph.edgeWeights[newOffsets[v] + e] = graph.edgeWeights[graph.offsets[v] + e];
+			}
+			extraCount[v] = newOffsets[v] + rowSize; // next free position of the row
+		}
+		graph.offsets.swap(newOffsets);
+
+		for (size_t i = 0; i < pairs.size(); i += 2) {
+			graph.adjacency[extraCount[pairs[i]]] = pairs[i + 1];
+			graph.edgeWeights[extraCount[pairs[i]]++] = 1;
+			graph.adjacency[extraCount[pairs[i + 1]]] = pairs[i];
+			graph.edgeWeights[extraCount[pairs[i + 1]]++] = 1;
+		}
+
+		mergeDuplicatedEdges(graph);
+	}
+
+	/**
+	* Coarsen a graph by heavy edge matching : each vertex is merged with its unmatched neighbor having the heaviest edge.
+	* @param fineToCoarse	Filled in with the coarse vertex of each fine vertex.
+	*/
+	void coarsen(const CellGraph & fine, CellGraph & coarse, std::vector<ULONG64> & fineToCoarse)
+	{
+		const ULONG64 fineCount = fine.getVertexCount();
+		std::vector<ULONG64> match(fineCount, NO_VERTEX);
+		for (ULONG64 v = 0; v < fineCount; ++v) {
+			if (match[v] != NO_VERTEX) {
+				continue;
+			}
+			ULONG64 best = v;
+			unsigned int bestWeight = 0;
+			for (ULONG64 e = fine.offsets[v]; e < fine.offsets[v + 1]; ++e) {
+				const ULONG64 u = fine.adjacency[e];
+				if (match[u] == NO_VERTEX && u != v && fine.edgeWeights[e] > bestWeight) {
+					best = u;
+					bestWeight = fine.edgeWeights[e];
+				}
+			}
+			match[v] = best;
+			match[best] = v;
+		}
+
+		// The coarse vertices are numbered in the order of their first fine vertex
+		fineToCoarse.assign(fineCount, NO_VERTEX);
+		ULONG64 coarseCount = 0;
+		for (ULONG64 v = 0; v < fineCount; ++v) {
+			if (fineToCoarse[v] == NO_VERTEX) {
+				fineToCoarse[v] = coarseCount;
+				fineToCoarse[match[v]] = coarseCount;
+				++coarseCount;
+			}
+		}
+
+		coarse.offsets.assign(1, 0);
+		coarse.adjacency.clear();
+		coarse.edgeWeights.clear();
+		coarse.vertexWeights.assign(coarseCount, 0);
+		std::vector<ULONG64> positionInRow(coarseCount, NO_VERTEX);
+		for (ULONG64 v = 0; v < fineCount; ++v) {
+			if (match[v] < v) {
+				continue; // already merged with its match
+			}
+			const ULONG64 c = fineToCoarse[v];
+			const ULONG64 rowBegin = coarse.adjacency.size();
+			const ULONG64 fineVertices[2] = { v, match[v] };
+			const unsigned int fineVertexCount = match[v] == v ? 1 : 2;
+			for (unsigned int i = 0; i < fineVertexCount; ++i) {
+				const ULONG64 f = fineVertices[i];
+				coarse.vertexWeights[c] += fine.vertexWeights[f];
+				for (ULONG64 e = fine.offsets[f]; e < fine.offsets[f + 1]; ++e) {
+					const ULONG64 neighbor = fineToCoarse[fine.adjacency[e]];
+					if (neighbor == c) {
+						continue;
+					}
+					if (positionInRow[neighbor] == NO_VERTEX || positionInRow[neighbor] < rowBegin) {
+						positionInRow[neighbor] = coarse.adjacency.size();
+						coarse.adjacency.push_back(neighbor);
+						coarse.edgeWeights.push_back(fine.edgeWeights[e]);
+					}
+					else {
+						coarse.edgeWeights[positionInRow[neighbor]] += fine.edgeWeights[e];
+					}
+				}
+			}
+			coarse.offsets.push_back(coarse.adjacency.size());
+		}
+	}
+
+	/**
+	* Get the vertices of a subgraph in breadth first order from a seed. The disconnected components of the subgraph are appended one after the other.
+	* @param inSubgraph	Tells for each vertex of the graph if it belongs to the subgraph.
+	*/
+	void breadthFirstOrder(const CellGraph & graph, const std::vector<ULONG64> & subgraph, const std::vector<bool> & inSubgraph, const ULONG64 & seed, std::vector<ULONG64> & order)
+	{
+		order.clear();
+		std::vector<bool> visited(graph.getVertexCount(), false);
+		size_t nextSeedIndex = 0;
+		ULONG64 nextSeed = seed;
+		while (order.size() < subgraph.size()) {
+			if (visited[nextSeed]) {
+				while (visited[subgraph[nextSeedIndex]]) {
+					++nextSeedIndex;
+				}
+				nextSeed = subgraph[nextSeedIndex];
+			}
+			visited[nextSeed] = true;
+			size_t head = order.size();
+			order.push_back(nextSeed);
+			for (; head < order.size(); ++head) {
+				const ULONG64 v = order[head];
+				for (ULONG64 e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+					const ULONG64 u = graph.adjacency[e];
+					if (inSubgraph[u] && !visited[u]) {
+						visited[u] = true;
+						order.push_back(u);
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	* Partition a subgraph of a (coarse) graph by recursive bisection.
+	* Each bisection greedily grows the first half from a pseudo peripheral vertex until it reaches its target weight.
+	*/
+	void bisect(const CellGraph & graph, const std::vector<ULONG64> & subgraph, const unsigned int & firstPart, const unsigned int & partCount, std::vector<unsigned int> & parts)
+	{
+		if (partCount == 1 || subgraph.empty()) {
+			for (size_t i = 0; i < subgraph.size(); ++i) {
+				parts[subgraph[i]] = firstPart;
+			}
+			return;
+		}
+
+		std::vector<bool> inSubgraph(graph.getVertexCount(), false);
+		ULONG64 subgraphWeight = 0;
+		for (size_t i = 0; i < subgraph.size(); ++i) {
+			inSubgraph[subgraph[i]] = true;
+			subgraphWeight += graph.vertexWeights[subgraph[i]];
+		}
+
+		// The last vertex of two successive breadth first searches is a pseudo peripheral vertex
+		std::vector<ULONG64> order;
+		breadthFirstOrder(graph, subgraph, inSubgraph, subgraph[0], order);
+		breadthFirstOrder(graph, subgraph, inSubgraph, order.back(), order);
+		breadthFirstOrder(graph, subgraph, inSubgraph, order.back(), order);
+
+		// Greedy graph growing : the next vertex of the first half is the one which most reduces the edge cut
+		const unsigned int firstHalfPartCount = partCount / 2;
+		const ULONG64 target = subgraphWeight * firstHalfPartCount / partCount;
+		std::vector<bool> inFirstHalf(graph.getVertexCount(), false);
+		std::vector<LONG64> gains(graph.getVertexCount(), 0);
+		for (size_t i = 0; i < subgraph.size(); ++i) {
+			const ULONG64 v = subgraph[i];
+			for (ULONG64 e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+				if (inSubgraph[graph.adjacency[e]]) {
+					gains[v] -= graph.edgeWeights[e];
+				}
+			}
+		}
+		std::priority_queue<std::pair<LONG64, ULONG64> > candidates; // may contain outdated gains
+		candidates.push(std::make_pair(gains[order.back()], order.back()));
+		size_t nextInOrder = 0;
+		ULONG64 weight = 0;
+		while (weight < target) {
+			ULONG64 v = NO_VERTEX;
+			while (!candidates.empty() && v == NO_VERTEX) {
+				if (!inFirstHalf[candidates.top().second] && candidates.top().first == gains[candidates.top().second]) {
+					v = candidates.top().second;
+				}
+				candidates.pop();
+			}
+			if (v == NO_VERTEX) {
+				// Disconnected subgraph
+				while (inFirstHalf[order[nextInOrder]]) {
+					++nextInOrder;
+				}
+				v = order[nextInOrder];
+			}
+			inFirstHalf[v] = true;
+			weight += graph.vertexWeights[v];
+			for (ULONG64 e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+				const ULONG64 u = graph.adjacency[e];
+				if (inSubgraph[u] && !inFirstHalf[u]) {
+					gains[u] += 2 * static_cast<LONG64>(graph.edgeWeights[e]);
+					candidates.push(std::make_pair(gains[u], u));
+				}
+			}
+		}
+
+		std::vector<ULONG64> firstHalf;
+		std::vector<ULONG64> secondHalf;
+		for (size_t i = 0; i < subgraph.size(); ++i) {
+			if (inFirstHalf[subgraph[i]]) {
+				firstHalf.push_back(subgraph[i]);
+			}
+			else {
+				secondHalf.push_back(subgraph[i]);
+			}
+		}
+
+		bisect(graph, firstHalf, firstPart, firstHalfPartCount, parts);
+		bisect(graph, secondHalf, firstPart + firstHalfPartCount, partCount - firstHalfPartCount, parts);
+	}
+
+	/**
+	* Greedily move the vertices to the neighbor part which most reduces the edge cut while respecting the maximum part weight.
+	* Moves which do not change the edge cut are done only if they improve the balance.
+	*/
+	void refine(const CellGraph & graph, const unsigned int & partCount, const ULONG64 & maxPartWeight, std::vector<unsigned int> & parts)
+	{
+		const ULONG64 vertexCount = graph.getVertexCount();
+		std::vector<ULONG64> partWeights(partCount, 0);
+		for (ULONG64 v = 0; v < vertexCount; ++v) {
+			partWeights[parts[v]] += graph.vertexWeights[v];
+		}
+
+		std::vector<std::pair<unsigned int, LONG64> > connections; // connection weight of a vertex to each neighbor part
+		for (unsigned int pass = 0; pass < 8; ++pass) {
+			ULONG64 moveCount = 0;
+			for (ULONG64 v = 0; v < vertexCount; ++v) {
+				const unsigned int own = parts[v];
+				connections.clear();
+				LONG64 internalWeight = 0;
+				for (ULONG64 e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+					const unsigned int p = parts[graph.adjacency[e]];
+					if (p == own) {
+						internalWeight += graph.edgeWeights[e];
+						continue;
+					}
+					size_t i = 0;
+					while (i < connections.size() && connections[i].first != p) {
+						++i;
+					}
+					if (i == connections.size()) {
+						connections.push_back(std::make_pair(p, static_cast<LONG64>(0)));
+					}
+					connections[i].second += graph.edgeWeights[e];
+				}
+
+				const ULONG64 weight = graph.vertexWeights[v];
+				const bool isOverweighted = partWeights[own] > maxPartWeight;
+				unsigned int best = own;
+				LONG64 bestGain = 0;
+				for (size_t i = 0; i < connections.size(); ++i) {
+					const unsigned int p = connections[i].first;
+					if (partWeights[p] + weight > maxPartWeight) {
+						continue;
+					}
+					const LONG64 gain = connections[i].second - internalWeight;
+					if ((best == own && (gain > 0 || isOverweighted || (gain == 0 && partWeights[own] > partWeights[p] + weight))) ||
+						(best != own && (gain > bestGain || (gain == bestGain && partWeights[p] < partWeights[best])))) {
+						best = p;
+						bestGain = gain;
+					}
+				}
+
+				if (best != own) {
+					parts[v] = best;
+					partWeights[own] -= weight;
+					partWeights[best] += weight;
+					++moveCount;
+				}
+			}
+			if (moveCount == 0) {
+				break;
+			}
+		}
+	}
+
+	/**
+	* Extend an ijk box (iStart, iEnd, jStart, jEnd, kStart, kEnd) to some cells.
+	* @param cells	The cells to include in the box are in [begin, end) of this list.
+	*/
+	void extendIjkBox(const std::vector<ULONG64> & cells, const ULONG64 & begin, const ULONG64 & end, const ULONG64 & iCount, const ULONG64 & ijCount, unsigned int * box)
+	{
+		for (ULONG64 index = begin; index < end; ++index) {
+			const ULONG64 cell = cells[index];
+			const unsigned int i = static_cast<unsigned int>(cell % iCount);
+			const unsigned int j = static_cast<unsigned int>((cell % ijCount) / iCount);
+			const unsigned int k = static_cast<unsigned int>(cell / ijCount);
+			if (i < box[0]) box[0] = i;
+			if (i >= box[1]) box[1] = i + 1;
+			if (j < box[2]) box[2] = j;
+			if (j >= box[3]) box[3] = j + 1;
+			if (k < box[4]) box[4] = k;
+			if (k >= box[5]) box[5] = k + 1;
+		}
+	}
+}
+
+GridPartition::GridPartition(AbstractGridRepresentation* grid, const unsigned int & partCount, const bool & withGridConnectionSets, const unsigned int & haloDepth) :
+	grid(grid), partCount(partCount), edgeCut(0)
+{
+	if (grid == nullptr) {
+		throw invalid_argument("The grid to partition cannot be null.");
+	}
+	if (partCount == 0) {
+		throw invalid_argument("The part count must be strictly positive.");
+	}
+
+	// Build the cell graph
+	CellGraph graph;
+	RESQML2_0_1_NS::AbstractIjkGridRepresentation* ijkGrid = dynamic_cast<RESQML2_0_1_NS::AbstractIjkGridRepresentation*>(grid);
+	RESQML2_0_1_NS::UnstructuredGridRepresentation* unstructuredGrid = dynamic_cast<RESQML2_0_1_NS::UnstructuredGridRepresentation*>(grid);
+	if (ijkGrid != nullptr) {
+		const ULONG64 iCount = ijkGrid->getICellCount();
+		const ULONG64 ijCount = iCount * ijkGrid->getJCellCount();
+		const ULONG64 cellCount = ijkGrid->getCellCount();
+		graph.vertexWeights.assign(cellCount, 1);
+		if (ijkGrid->hasEnabledCellInformation()) {
+			indexing::BitSet enabledCells;
+			ijkGrid->getEnabledCells(enabledCells);
+			enabledCells.getAsArray(&graph.vertexWeights[0]);
+		}
+
+		// The ijk neighbors are pushed in increasing cell index order. Each ijk face between two cells gives two directed edges.
+		const ULONG64 jCount = ijkGrid->getJCellCount();
+		const ULONG64 kCount = ijkGrid->getKCellCount();
+		graph.offsets.reserve(cellCount + 1);
+		graph.offsets.push_back(0);
+		graph.adjacency.reserve(2 * ((iCount - 1) * jCount * kCount + iCount * (jCount - 1) * kCount + iCount * jCount * (kCount - 1)));
+		for (ULONG64 cell = 0; cell < cellCount; ++cell) {
+			const ULONG64 i = cell % iCount;
+			const ULONG64 j = (cell % ijCount) / iCount;
+			if (cell >= ijCount) graph.adjacency.push_back(cell - ijCount);
+			if (j > 0) graph.adjacency.push_back(cell - iCount);
+			if (i > 0) graph.adjacency.push_back(cell - 1);
+			if (i + 1 < iCount) graph.adjacency.push_back(cell + 1);
+			if (j + 1 < jCount) graph.adjacency.push_back(cell + iCount);
+			if (cell + ijCount < cellCount) graph.adjacency.push_back(cell + ijCount);
+			graph.offsets.push_back(graph.adjacency.size());
+		}
+		graph.edgeWeights.assign(graph.adjacency.size(), 1);
+	}
+	else if (unstructuredGrid != nullptr) {
+		const ULONG64 cellCount = unstructuredGrid->getCellCount();
+		graph.vertexWeights.assign(cellCount, 1);
+		graph.offsets.assign(cellCount + 1, 0);
+		graph.adjacency.resize(unstructuredGrid->getCellAdjacencyCount());
+		graph.edgeWeights.assign(graph.adjacency.size(), 1);
+		if (cellCount > 0) {
+			unstructuredGrid->getCellAdjacency(&graph.offsets[1], graph.adjacency.empty() ? nullptr : &graph.adjacency[0]);
+		}
+		mergeDuplicatedEdges(graph);
+	}
+	else {
+		throw invalid_argument("Only ijk and unstructured grids can be partitioned.");
+	}
+	const ULONG64 cellCount = graph.getVertexCount();
+
+	if (withGridConnectionSets) {
+		std::vector<ULONG64> connectionPairs;
+		for (unsigned int gcsIndex = 0; gcsIndex < grid->getGridConnectionSetRepresentationCount(); ++gcsIndex) {
+			GridConnectionSetRepresentation* gcs = grid->getGridConnectionSetRepresentation(gcsIndex);
+			const ULONG64 pairCount = gcs->getCellIndexPairCount();
+			if (pairCount == 0) {
+				continue;
+			}
+			std::vector<ULONG64> cellIndexPairs(2 * pairCount);
+			gcs->getCellIndexPairs(&cellIndexPairs[0]);
+
+			// Only keep the connections between two cells of the partitioned grid
+			std::vector<unsigned short> gridIndexPairs;
+			unsigned short gridIndex = 0;
+			if (gcs->isBasedOnMultiGrids()) {
+				gridIndexPairs.resize(2 * pairCount);
+				gcs->getGridIndexPairs(&gridIndexPairs[0]);
+				while (gridIndex < gcs->getSupportingGridRepresentationCount() && gcs->getSupportingGridRepresentationUuid(gridIndex) != grid->getUuid()) {
+					++gridIndex;
+				}
+			}
+
+			for (ULONG64 i = 0; i < pairCount; ++i) {
+				const ULONG64 cell1 = cellIndexPairs[2 * i];
+				const ULONG64 cell2 = cellIndexPairs[2 * i + 1];
+				if (cell1 >= cellCount || cell2 >= cellCount || cell1 == cell2 ||
+					(!gridIndexPairs.empty() && (gridIndexPairs[2 * i] != gridIndex || gridIndexPairs[2 * i + 1] != gridIndex))) {
+					continue;
+				}
+				connectionPairs.push_back(cell1);
+				connectionPairs.push_back(cell2);
+			}
+		}
+		if (!connectionPairs.empty()) {
+			addEdges(graph, connectionPairs);
+		}
+	}
+
+	// A grid without any enabled cell is balanced by cell count
+	ULONG64 totalWeight = 0;
+	for (ULONG64 cell = 0; cell < cellCount; ++cell) {
+		totalWeight += graph.vertexWeights[cell];
+	}
+	if (totalWeight == 0) {
+		graph.vertexWeights.assign(cellCount, 1);
+		totalWeight = cellCount;
+	}
+	const ULONG64 maxPartWeight = (totalWeight * 103 + 100 * partCount - 1) / (100 * partCount) + 1;
+
+	// Multilevel partitioning
+	std::vector<CellGraph> coarseGraphs;
+	std::vector<std::vector<ULONG64> > fineToCoarseMaps;
+	const CellGraph* coarsest = &graph;
+	while (coarsest->getVertexCount() > 30 * static_cast<ULONG64>(partCount)) {
+		CellGraph coarse;
+		std::vector<ULONG64> fineToCoarse;
+		coarsen(*coarsest, coarse, fineToCoarse);
+		if (coarse.getVertexCount() * 20 > coarsest->getVertexCount() * 19) {
+			break; // Not enough reduction (e.g. star graph)
+		}
+		coarseGraphs.push_back(CellGraph());
+		coarseGraphs.back().offsets.swap(coarse.offsets);
+		coarseGraphs.back().adjacency.swap(coarse.adjacency);
+		coarseGraphs.back().edgeWeights.swap(coarse.edgeWeights);
+		coarseGraphs.back().vertexWeights.swap(coarse.vertexWeights);
+		fineToCoarseMaps.push_back(std::vector<ULONG64>());
+		fineToCoarseMaps.back().swap(fineToCoarse);
+		coarsest = &coarseGraphs.back();
+	}
+
+	std::vector<unsigned int> parts;
+	std::vector<ULONG64> allVertices(coarsest->getVertexCount());
+	for (ULONG64 v = 0; v < allVertices.size(); ++v) {
+		allVertices[v] = v;
+	}
+	parts.assign(allVertices.size(), NO_PART);
+	bisect(*coarsest, allVertices, 0, partCount, parts);
+	refine(*coarsest, partCount, maxPartWeight, parts);
+	for (size_t level = coarseGraphs.size(); level-- > 0;) {
+		const std::vector<ULONG64> & fineToCoarse = fineToCoarseMaps[level];
+		std::vector<unsigned int> fineParts(fineToCoarse.size());
+		for (size_t v = 0; v < fineToCoarse.size(); ++v) {
+			fineParts[v] = parts[fineToCoarse[v]];
+		}
+		parts.swap(fineParts);
+		refine(level == 0 ? graph : coarseGraphs[level - 1], partCount, maxPartWeight, parts);
+	}
+	partOfCells.swap(parts);
+
+	// Statistics
+	partWeights.assign(partCount, 0);
+	for (ULONG64 cell = 0; cell < cellCount; ++cell) {
+		partWeights[partOfCells[cell]] += graph.vertexWeights[cell];
+		for (ULONG64 e = graph.offsets[cell]; e < graph.offsets[cell + 1]; ++e) {
+			if (graph.adjacency[e] > cell && partOfCells[graph.adjacency[e]] != partOfCells[cell]) {
+				++edgeCut;
+			}
+		}
+	}
+
+	// Cells of each part : counting sort of the cells by part which keeps them in increasing order
+	partOffsets.assign(partCount + 1, 0);
+	for (ULONG64 cell = 0; cell < cellCount; ++cell) {
+		++partOffsets[partOfCells[cell] + 1];
+	}
+	for (unsigned int p = 0; p < partCount; ++p) {
+		partOffsets[p + 1] += partOffsets[p];
+	}
+	cellIndicesOfParts.resize(cellCount);
+	std::vector<ULONG64> next(partOffsets.begin(), partOffsets.end() - 1);
+	for (ULONG64 cell = 0; cell < cellCount; ++cell) {
+		cellIndicesOfParts[next[partOfCells[cell]]++] = cell;
+	}
+
+	// Halo : the first layer of all parts is given by a single sweep over the edges of the graph.
+	// The next layers are grown by breadth first search from the previous layer only, through the enabled cells of the other parts.
+	std::vector<std::pair<unsigned int, ULONG64> > haloPairs;
+	if (haloDepth > 0) {
+		for (ULONG64 cell = 0; cell < cellCount; ++cell) {
+			for (ULONG64 e = graph.offsets[cell]; e < graph.offsets[cell + 1]; ++e) {
+				const ULONG64 neighbor = graph.adjacency[e];
+				if (partOfCells[neighbor] != partOfCells[cell] && graph.vertexWeights[neighbor] > 0) {
+					haloPairs.push_back(std::make_pair(partOfCells[cell], neighbor));
+				}
+			}
+		}
+		std::sort(haloPairs.begin(), haloPairs.end());
+		haloPairs.erase(std::unique(haloPairs.begin(), haloPairs.end()), haloPairs.end());
+	}
+	if (haloDepth > 1) {
+		const size_t firstLayerSize = haloPairs.size();
+		std::vector<unsigned int> visitedByPart(cellCount, NO_PART);
+		std::vector<ULONG64> frontier;
+		std::vector<ULONG64> nextFrontier;
+		size_t firstLayerIndex = 0;
+		for (unsigned int p = 0; p < partCount; ++p) {
+			frontier.clear();
+			for (; firstLayerIndex < firstLayerSize && haloPairs[firstLayerIndex].first == p; ++firstLayerIndex) {
+				frontier.push_back(haloPairs[firstLayerIndex].second);
+				visitedByPart[haloPairs[firstLayerIndex].second] = p;
+			}
+			for (unsigned int depth = 1; depth < haloDepth && !frontier.empty(); ++depth) {
+				nextFrontier.clear();
+				for (size_t i = 0; i < frontier.size(); ++i) {
+					for (ULONG64 e = graph.offsets[frontier[i]]; e < graph.offsets[frontier[i] + 1]; ++e) {
+						const ULONG64 neighbor = graph.adjacency[e];
+						if (partOfCells[neighbor] != p && visitedByPart[neighbor] != p && graph.vertexWeights[neighbor] > 0) {
+							visitedByPart[neighbor] = p;
+							haloPairs.push_back(std::make_pair(p, neighbor));
+							nextFrontier.push_back(neighbor);
+						}
+					}
+				}
+				frontier.swap(nextFrontier);
+			}
+		}
+		std::sort(haloPairs.begin(), haloPairs.end());
+	}
+	haloOffsets.assign(partCount + 1, 0);
+	haloCellIndices.resize(haloPairs.size());
+	for (size_t i = 0; i < haloPairs.size(); ++i) {
+		++haloOffsets[haloPairs[i].first + 1];
+		haloCellIndices[i] = haloPairs[i].second;
+	}
+	for (unsigned int p = 0; p < partCount; ++p) {
+		haloOffsets[p + 1] += haloOffsets[p];
+	}
+
+	// Ijk boxes of the parts and their halo
+	if (ijkGrid != nullptr) {
+		const ULONG64 iCount = ijkGrid->getICellCount();
+		const ULONG64 ijCount = iCount * ijkGrid->getJCellCount();
+		ijkBoxes.resize(6 * partCount);
+		for (unsigned int p = 0; p < partCount; ++p) {
+			unsigned int* box = &ijkBoxes[6 * p];
+			box[0] = box[2] = box[4] = (numeric_limits<unsigned int>::max)();
+			box[1] = box[3] = box[5] = 0;
+			extendIjkBox(cellIndicesOfParts, partOffsets[p], partOffsets[p + 1], iCount, ijCount, box);
+			extendIjkBox(haloCellIndices, haloOffsets[p], haloOffsets[p + 1], iCount, ijCount, box);
+			if (box[1] == 0) {
+				// Empty part
+				box[0] = box[2] = box[4] = 0;
+			}
+		}
+	}
+}
+
+unsigned int GridPartition::getPartOfCell(const ULONG64 & cellIndex) const
+{
+	if (cellIndex >= partOfCells.size()) {
+		throw out_of_range("The cell index is out of range.");
+	}
+
+	return partOfCells[cellIndex];
+}
+
+void GridPartition::getPartOfCells(unsigned int * partIndices) const
+{
+	std::copy(partOfCells.begin(), partOfCells.end(), partIndices);
+}
+
+ULONG64 GridPartition::getCellCountOfPart(const unsigned int & partIndex) const
+{
+	if (partIndex >= partCount) {
+		throw out_of_range("The part index is out of range.");
+	}
+
+	return partOffsets[partIndex + 1] - partOffsets[partIndex];
+}
+
+void GridPartition::getCellIndicesOfPart(const unsigned int & partIndex, ULONG64 * cellIndices) const
+{
+	if (partIndex >= partCount) {
+		throw out_of_range("The part index is out of range.");
+	}
+
+	std::copy(cellIndicesOfParts.begin() + partOffsets[partIndex], cellIndicesOfParts.begin() + partOffsets[partIndex + 1], cellIndices);
+}
+
+ULONG64 GridPartition::getWeightOfPart(const unsigned int & partIndex) const
+{
+	if (partIndex >= partCount) {
+		throw out_of_range("The part index is out of range.");
+	}
+
+	return partWeights[partIndex];
+}
+
+ULONG64 GridPartition::getHaloCellCountOfPart(const unsigned int & partIndex) const
+{
+	if (partIndex >= partCount) {
+		throw out_of_range("The part index is out of range.");
+	}
+
+	return haloOffsets[partIndex + 1] - haloOffsets[partIndex];
+}
+
+void GridPartition::getHaloCellIndicesOfPart(const unsigned int & partIndex, ULONG64 * cellIndices) const
+{
+	if (partIndex >= partCount) {
+		throw out_of_range("The part index is out of range.");
+	}
+
+	std::copy(haloCellIndices.begin() + haloOffsets[partIndex], haloCellIndices.begin() + haloOffsets[partIndex + 1], cellIndices);
+}
+
+void GridPartition::getIjkBoxOfPart(const unsigned int & partIndex,
+	unsigned int & iStart, unsigned int & iEnd, unsigned int & jStart, unsigned int & jEnd, unsigned int & kStart, unsigned int & kEnd) const
+{
+	if (partIndex >= partCount) {
+		throw out_of_range("The part index is out of range.");
+	}
+	if (ijkBoxes.empty()) {
+		throw invalid_argument("An ijk box can only be computed on an ijk grid.");
+	}
+
+	const unsigned int* box = &ijkBoxes[6 * partIndex];
+	iStart = box[0];
+	iEnd = box[1];
+	jStart = box[2];
+	jEnd = box[3];
+	kStart = box[4];
+	kEnd = box[5];
+}
+
+RESQML2_0_1_NS::DiscreteProperty* GridPartition::createPartitionProperty(const std::string & guid, const std::string & title, COMMON_NS::AbstractHdfProxy* proxy) const
+{
+	RESQML2_0_1_NS::DiscreteProperty* result = grid->getEpcDocument()->createDiscreteProperty(grid, guid, title, 1,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__cells, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__discrete);
+
+	std::vector<int> values(partOfCells.begin(), partOfCells.end());
+	RESQML2_0_1_NS::AbstractIjkGridRepresentation* ijkGrid = dynamic_cast<RESQML2_0_1_NS::AbstractIjkGridRepresentation*>(grid);
+	if (ijkGrid != nullptr) {
+		result->pushBackIntHdf5Array3dOfValues(&values[0], ijkGrid->getICellCount(), ijkGrid->getJCellCount(), ijkGrid->getKCellCount(), proxy,
+			-1, 0, static_cast<int>(partCount) - 1);
+	}
+	else {
+		result->pushBackIntHdf5Array1dOfValues(&values[0], values.size(), proxy, -1, 0, static_cast<int>(partCount) - 1);
+	}
+
+	return result;
+}
@@ -0,0 +1,136 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#pragma once
+
+#include "resqml2/AbstractGridRepresentation.h"
+
+namespace RESQML2_0_1_NS
+{
+	class DiscreteProperty;
+}
+
+namespace RESQML2_NS
+{
+	/**
+	* A balanced partition of the cells of an ijk or unstructured grid into parts (subdomains) which can be processed independently.
+	* The cell graph is made of the ijk neighborhood (or the shared faces of an unstructured grid) plus the connections of the grid connection sets of the grid.
+	* Cells are weighted by their activity (a disabled cell weights nothing) and the partition is computed by a multilevel scheme :
+	* the graph is coarsened by heavy edge matching, the coarsest graph is partitioned by recursive bisection grown from pseudo peripheral cells,
+	* and the partition is projected back and refined at each level by moving boundary cells which reduce the edge cut without breaking the balance.
+	*/
+	class DLL_IMPORT_OR_EXPORT GridPartition
+	{
+	public:
+
+		/**
+		* Partition a grid.
+		* The geometry of an unstructured grid must have been loaded before (see UnstructuredGridRepresentation::loadGeometry).
+		* @param grid						The ijk or unstructured grid to partition.
+		* @param partCount					The count of parts. It must be strictly positive.
+		* @param withGridConnectionSets		If true, the connections of the grid connection sets of the grid are added to the cell graph.
+		* @param haloDepth					The count of cell layers around each part which are given as halo (ghost) cells of this part.
+		*/
+		GridPartition(AbstractGridRepresentation* grid, const unsigned int & partCount, const bool & withGridConnectionSets = true, const unsigned int & haloDepth = 1);
+		~GridPartition() {}
+
+		AbstractGridRepresentation* getGrid() const { return grid; }
+		unsigned int getPartCount() const { return partCount; }
+		ULONG64 getCellCount() const { return partOfCells.size(); }
+
+		/**
+		* Get the part of a cell.
+		*/
+		unsigned int getPartOfCell(const ULONG64 & cellIndex) const;
+
+		/**
+		* Get the part of all cells.
+		* @param partIndices	It must be preallocated with getCellCount().
+		*/
+		void getPartOfCells(unsigned int * partIndices) const;
+
+		/**
+		* Get the count of cells (enabled or not) of a part.
+		*/
+		ULONG64 getCellCountOfPart(const unsigned int & partIndex) const;
+
+		/**
+		* Get the cells of a part in increasing order.
+		* @param cellIndices	It must be preallocated with getCellCountOfPart(partIndex).
+		*/
+		void getCellIndicesOfPart(const unsigned int & partIndex, ULONG64 * cellIndices) const;
+
+		/**
+		* Get the weight of a part i.e. its count of enabled cells.
+		*/
+		ULONG64 getWeightOfPart(const unsigned int & partIndex) const;
+
+		/**
+		* Get the count of halo cells of a part.
+		*/
+		ULONG64 getHaloCellCountOfPart(const unsigned int & partIndex) const;
+
+		/**
+		* Get the halo (ghost) cells of a part in increasing order.
+		* They are the enabled cells of the other parts which are at most haloDepth connections away from the part.
+		* @param cellIndices	It must be preallocated with getHaloCellCountOfPart(partIndex).
+		*/
+		void getHaloCellIndicesOfPart(const unsigned int & partIndex, ULONG64 * cellIndices) const;
+
+		/**
+		* Get the count of graph edges (ijk neighborhoods, shared faces and grid connections) between two cells of different parts.
+		*/
+		ULONG64 getEdgeCut() const { return edgeCut; }
+
+		/**
+		* Only for an ijk grid : get the smallest ijk box of cells containing a part and its halo.
+		* It allows a worker to only read the hyperslabs of its part (see AbstractIjkGridRepresentation::loadBlockInformation).
+		* Start values are inclusive and end values are exclusive.
+		*/
+		void getIjkBoxOfPart(const unsigned int & partIndex,
+			unsigned int & iStart, unsigned int & iEnd, unsigned int & jStart, unsigned int & jEnd, unsigned int & kStart, unsigned int & kEnd) const;
+
+		/**
+		* Create a discrete property on the grid which stores the part of each cell.
+		* @param guid	The guid to set to the property. If empty then a new guid will be generated.
+		* @param title	A title for the property.
+		* @param proxy	The HDF proxy where the part indices are going to be stored.
+		*/
+		RESQML2_0_1_NS::DiscreteProperty* createPartitionProperty(const std::string & guid, const std::string & title, COMMON_NS::AbstractHdfProxy* proxy) const;
+
+	private:
+
+		AbstractGridRepresentation* grid;
+		unsigned int partCount;
+		ULONG64 edgeCut;
+
+		std::vector<unsigned int> partOfCells;
+		std::vector<ULONG64> partWeights;
+
+		// Cells of all parts in increasing order : the ones of part p are in [partOffsets[p], partOffsets[p+1])
+		std::vector<ULONG64> partOffsets;
+		std::vector<ULONG64> cellIndicesOfParts;
+
+		// Halo cells of all parts : the ones of part p are in [haloOffsets[p], haloOffsets[p+1])
+		std::vector<ULONG64> haloOffsets;
+		std::vector<ULONG64> haloCellIndices;
+
+		// Only for an ijk grid : iStart, iEnd, jStart, jEnd, kStart and kEnd of the box of each part and its halo
+		std::vector<unsigned int> ijkBoxes;
+	};
+}
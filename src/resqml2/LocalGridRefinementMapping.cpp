@@ -0,0 +1,512 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2/LocalGridRefinementMapping.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "resqml2/AbstractColumnLayerGridRepresentation.h"
+#include "resqml2_0_1/AbstractIjkGridRepresentation.h"
+
+#include "tools/Parallel.h"
+
+using namespace std;
+using namespace RESQML2_NS;
+
+LocalGridRefinementMapping::LocalGridRefinementMapping(const AbstractGridRepresentation* childGrid) :
+	childGrid(childGrid), parentGrid(nullptr)
+{
+	if (childGrid == nullptr) {
+		throw invalid_argument("The child grid cannot be null.");
+	}
+
+	parentGrid = childGrid->getParentGrid();
+	if (parentGrid == nullptr) {
+		throw invalid_argument("There is no parent window on this grid or its parent grid is not in the EPC document.");
+	}
+	gsoap_resqml2_0_1::resqml2__AbstractParentWindow* parentWindow = static_cast<gsoap_resqml2_0_1::resqml2__AbstractGridRepresentation*>(childGrid->getGsoapProxy())->ParentWindow;
+
+	parentOffsets.assign(parentGrid->getCellCount() + 1, 0);
+
+	if (childGrid->hasCellOverlap()) {
+		buildFromCellOverlap();
+	}
+	else if (parentWindow->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IjkParentWindow) {
+		buildFromIjkParentWindow();
+	}
+	else if (parentWindow->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__ColumnLayerParentWindow) {
+		buildFromColumnLayerParentWindow();
+	}
+	else {
+		// Only the refined parent cells are known
+		childOffsets.assign(childGrid->getCellCount() + 1, 0);
+	}
+
+	finalize();
+
+	if (parentWindow->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__CellParentWindow) {
+		const ULONG64 parentCellIndexCount = childGrid->getParentCellIndexCount();
+		ULONG64* parentCellIndices = new ULONG64[parentCellIndexCount];
+		childGrid->getParentCellIndices(parentCellIndices);
+		for (ULONG64 i = 0; i < parentCellIndexCount; ++i) {
+			if (parentCellIndices[i] >= refinedParentCells.size()) {
+				delete [] parentCellIndices;
+				throw out_of_range("A parent cell index of the parent window is out of the parent grid.");
+			}
+			refinedParentCells[parentCellIndices[i]] = true;
+		}
+		delete [] parentCellIndices;
+	}
+}
+
+void LocalGridRefinementMapping::buildRegridDimension(const char & dimension, const ULONG64 & childCellCountIfNoInterval, RegridDimension & result) const
+{
+	const ULONG64 parentStart = childGrid->getRegridStartIndexOnParentGrid(dimension);
+	const ULONG64 intervalCount = childGrid->getRegridIntervalCount(dimension);
+
+	result.childOffsets.clear();
+	result.parentIndices.clear();
+	result.childFractions.clear();
+	result.parentFractions.clear();
+	result.childOffsets.push_back(0);
+
+	if (intervalCount == 0) {
+		for (ULONG64 c = 0; c < childCellCountIfNoInterval; ++c) {
+			result.parentIndices.push_back(parentStart + c);
+			result.childFractions.push_back(1.0);
+			result.parentFractions.push_back(1.0);
+			result.childOffsets.push_back(result.parentIndices.size());
+		}
+		return;
+	}
+
+	std::vector<ULONG64> childCountPerInterval(intervalCount);
+	std::vector<ULONG64> parentCountPerInterval(intervalCount);
+	childGrid->getRegridCellCountPerInterval(dimension, &childCountPerInterval[0], true);
+	childGrid->getRegridCellCountPerInterval(dimension, &parentCountPerInterval[0], false);
+
+	ULONG64 childCellCount = 0;
+	for (ULONG64 interval = 0; interval < intervalCount; ++interval) {
+		childCellCount += childCountPerInterval[interval];
+	}
+	std::vector<double> weights(childCellCount, 1.0);
+	if (childCellCount > 0 && childGrid->hasRegridChildCellWeights(dimension)) {
+		childGrid->getRegridChildCellWeights(dimension, &weights[0]);
+	}
+
+	ULONG64 firstChild = 0;
+	ULONG64 firstParent = parentStart;
+	for (ULONG64 interval = 0; interval < intervalCount; ++interval) {
+		const ULONG64 childCount = childCountPerInterval[interval];
+		const ULONG64 parentCount = parentCountPerInterval[interval];
+
+		double weightSum = 0;
+		for (ULONG64 c = 0; c < childCount; ++c) {
+			weightSum += weights[firstChild + c];
+		}
+		if (childCount > 0 && !(weightSum > 0)) {
+			throw invalid_argument("The child cell weights of a regrid interval must have a positive sum.");
+		}
+
+		// Child cell c spans [childBegin, childEnd) and parent cell p spans [p/parentCount, (p+1)/parentCount) of the normalized interval.
+		double childBegin = 0;
+		ULONG64 p = 0;
+		for (ULONG64 c = 0; c < childCount; ++c) {
+			const double childLength = weights[firstChild + c] / weightSum;
+			const double childEnd = c + 1 == childCount ? 1.0 : childBegin + childLength;
+			while (p < parentCount) {
+				const double parentBegin = static_cast<double>(p) / parentCount;
+				const double parentEnd = static_cast<double>(p + 1) / parentCount;
+				const double overlap = (childEnd < parentEnd ? childEnd : parentEnd) - (childBegin > parentBegin ? childBegin : parentBegin);
+				if (overlap > 0) {
+					result.parentIndices.push_back(firstParent + p);
+					result.childFractions.push_back(childLength > 0 ? overlap / childLength : 1.0);
+					result.parentFractions.push_back(overlap * parentCount);
+				}
+				if (parentEnd > childEnd) {
+					break;
+				}
+				++p;
+			}
+			result.childOffsets.push_back(result.parentIndices.size());
+			childBegin = childEnd;
+		}
+
+		firstChild += childCount;
+		firstParent += parentCount;
+	}
+}
+
+void LocalGridRefinementMapping::buildFromIjkParentWindow()
+{
+	RESQML2_0_1_NS::AbstractIjkGridRepresentation* ijkParentGrid = dynamic_cast<RESQML2_0_1_NS::AbstractIjkGridRepresentation*>(parentGrid);
+	if (ijkParentGrid == nullptr) {
+		throw invalid_argument("The parent grid of an ijk parent window must be an ijk grid.");
+	}
+	const RESQML2_0_1_NS::AbstractIjkGridRepresentation* ijkChildGrid = dynamic_cast<const RESQML2_0_1_NS::AbstractIjkGridRepresentation*>(childGrid);
+
+	RegridDimension dims[3];
+	const char dimNames[3] = { 'i', 'j', 'k' };
+	ULONG64 childCounts[3] = { 0, 0, 0 };
+	if (ijkChildGrid != nullptr) {
+		childCounts[0] = ijkChildGrid->getICellCount();
+		childCounts[1] = ijkChildGrid->getJCellCount();
+		childCounts[2] = ijkChildGrid->getKCellCount();
+	}
+	for (unsigned int d = 0; d < 3; ++d) {
+		buildRegridDimension(dimNames[d], childCounts[d], dims[d]);
+		childCounts[d] = dims[d].childOffsets.size() - 1;
+	}
+	if (childCounts[0] * childCounts[1] * childCounts[2] != childGrid->getCellCount()) {
+		throw invalid_argument("The regrid intervals of the parent window are not consistent with the child grid cell count.");
+	}
+
+	const ULONG64 parentICount = ijkParentGrid->getICellCount();
+	const ULONG64 parentIjCount = parentICount * ijkParentGrid->getJCellCount();
+
+	childOffsets.reserve(childGrid->getCellCount() + 1);
+	childOffsets.push_back(0);
+	for (ULONG64 ck = 0; ck < childCounts[2]; ++ck) {
+		for (ULONG64 cj = 0; cj < childCounts[1]; ++cj) {
+			for (ULONG64 ci = 0; ci < childCounts[0]; ++ci) {
+				const ULONG64 childCellIndex = childOffsets.size() - 1;
+				for (ULONG64 ok = dims[2].childOffsets[ck]; ok < dims[2].childOffsets[ck + 1]; ++ok) {
+					for (ULONG64 oj = dims[1].childOffsets[cj]; oj < dims[1].childOffsets[cj + 1]; ++oj) {
+						for (ULONG64 oi = dims[0].childOffsets[ci]; oi < dims[0].childOffsets[ci + 1]; ++oi) {
+							parentOfOverlap.push_back(dims[0].parentIndices[oi] + dims[1].parentIndices[oj] * parentICount + dims[2].parentIndices[ok] * parentIjCount);
+							childOfOverlap.push_back(childCellIndex);
+							childFractionOfOverlap.push_back(dims[0].childFractions[oi] * dims[1].childFractions[oj] * dims[2].childFractions[ok]);
+							parentFractionOfOverlap.push_back(dims[0].parentFractions[oi] * dims[1].parentFractions[oj] * dims[2].parentFractions[ok]);
+						}
+					}
+				}
+				childOffsets.push_back(parentOfOverlap.size());
+			}
+		}
+	}
+}
+
+void LocalGridRefinementMapping::buildFromColumnLayerParentWindow()
+{
+	AbstractColumnLayerGridRepresentation* columnLayerParentGrid = dynamic_cast<AbstractColumnLayerGridRepresentation*>(parentGrid);
+	if (columnLayerParentGrid == nullptr) {
+		throw invalid_argument("The parent grid of a column layer parent window must be a column layer grid.");
+	}
+	const ULONG64 parentColumnCount = columnLayerParentGrid->getCellCount() / columnLayerParentGrid->getKCellCount();
+
+	const ULONG64 childColumnCount = childGrid->getParentColumnIndexCount();
+	std::vector<ULONG64> parentColumnIndices(childColumnCount);
+	if (childColumnCount > 0) {
+		childGrid->getParentColumnIndices(&parentColumnIndices[0]);
+	}
+
+	const AbstractColumnLayerGridRepresentation* columnLayerChildGrid = dynamic_cast<const AbstractColumnLayerGridRepresentation*>(childGrid);
+	RegridDimension kDim;
+	buildRegridDimension('k', columnLayerChildGrid != nullptr ? columnLayerChildGrid->getKCellCount() : 0, kDim);
+	const ULONG64 childKCount = kDim.childOffsets.size() - 1;
+	if (childKCount * childColumnCount != childGrid->getCellCount()) {
+		throw invalid_argument("The column indices and the K regrid of the parent window are not consistent with the child grid cell count.");
+	}
+
+	childOffsets.reserve(childGrid->getCellCount() + 1);
+	childOffsets.push_back(0);
+	for (ULONG64 ck = 0; ck < childKCount; ++ck) {
+		for (ULONG64 column = 0; column < childColumnCount; ++column) {
+			const ULONG64 childCellIndex = childOffsets.size() - 1;
+			for (ULONG64 ok = kDim.childOffsets[ck]; ok < kDim.childOffsets[ck + 1]; ++ok) {
+				parentOfOverlap.push_back(parentColumnIndices[column] + kDim.parentIndices[ok] * parentColumnCount);
+				childOfOverlap.push_back(childCellIndex);
+				childFractionOfOverlap.push_back(kDim.childFractions[ok]);
+				parentFractionOfOverlap.push_back(kDim.parentFractions[ok]);
+			}
+			childOffsets.push_back(parentOfOverlap.size());
+		}
+	}
+}
+
+void LocalGridRefinementMapping::buildFromCellOverlap()
+{
+	const ULONG64 overlapCount = childGrid->getCellOverlapCount();
+	const ULONG64 childCellCount = childGrid->getCellCount();
+	const ULONG64 parentCellCount = getParentCellCount();
+
+	std::vector<ULONG64> pairs(2 * overlapCount);
+	std::vector<double> volumes(overlapCount, 1.0);
+	if (overlapCount > 0) {
+		childGrid->getCellOverlapParentChildCellPairs(&pairs[0]);
+		if (childGrid->hasCellOverlapVolume()) {
+			childGrid->getCellOverlapVolumes(&volumes[0]);
+		}
+	}
+
+	// Total overlap volume of each child and parent cell
+	std::vector<double> childVolumes(childCellCount, 0.0);
+	std::vector<double> parentVolumes(parentCellCount, 0.0);
+	childOffsets.assign(childCellCount + 1, 0);
+	for (ULONG64 i = 0; i < overlapCount; ++i) {
+		if (pairs[2 * i] >= parentCellCount || pairs[2 * i + 1] >= childCellCount) {
+			throw out_of_range("A cell overlap pair is out of the parent or child grid.");
+		}
+		parentVolumes[pairs[2 * i]] += volumes[i];
+		childVolumes[pairs[2 * i + 1]] += volumes[i];
+		++childOffsets[pairs[2 * i + 1] + 1];
+	}
+	for (ULONG64 c = 0; c < childCellCount; ++c) {
+		childOffsets[c + 1] += childOffsets[c];
+	}
+
+	// Counting sort of the pairs by child cell
+	parentOfOverlap.resize(overlapCount);
+	childOfOverlap.resize(overlapCount);
+	childFractionOfOverlap.resize(overlapCount);
+	parentFractionOfOverlap.resize(overlapCount);
+	std::vector<ULONG64> next(childOffsets.begin(), childOffsets.end() - 1);
+	for (ULONG64 i = 0; i < overlapCount; ++i) {
+		const ULONG64 parentCellIndex = pairs[2 * i];
+		const ULONG64 childCellIndex = pairs[2 * i + 1];
+		const ULONG64 overlapIndex = next[childCellIndex]++;
+		parentOfOverlap[overlapIndex] = parentCellIndex;
+		childOfOverlap[overlapIndex] = childCellIndex;
+		childFractionOfOverlap[overlapIndex] = childVolumes[childCellIndex] > 0 ? volumes[i] / childVolumes[childCellIndex] : 0;
+		parentFractionOfOverlap[overlapIndex] = parentVolumes[parentCellIndex] > 0 ? volumes[i] / parentVolumes[parentCellIndex] : 0;
+	}
+}
+
+void LocalGridRefinementMapping::finalize()
+{
+	const ULONG64 parentCellCount = getParentCellCount();
+
+	// Remove the overlaps of the omitted parent cells
+	const ULONG64 omittedCount = childGrid->hasCellOverlap() ? 0 : childGrid->getForcedNonRegridedParentCellCount();
+	if (omittedCount > 0) {
+		std::vector<ULONG64> omittedCells(omittedCount);
+		childGrid->getForcedNonRegridedParentCellIndices(&omittedCells[0]);
+		std::vector<bool> isOmitted(parentCellCount, false);
+		for (ULONG64 i = 0; i < omittedCount; ++i) {
+			if (omittedCells[i] < parentCellCount) {
+				isOmitted[omittedCells[i]] = true;
+			}
+		}
+
+		ULONG64 kept = 0;
+		ULONG64 overlapIndex = 0;
+		for (ULONG64 c = 0; c + 1 < childOffsets.size(); ++c) {
+			const ULONG64 end = childOffsets[c + 1];
+			for (; overlapIndex < end; ++overlapIndex) {
+				if (!isOmitted[parentOfOverlap[overlapIndex]]) {
+					parentOfOverlap[kept] = parentOfOverlap[overlapIndex];
+					childOfOverlap[kept] = childOfOverlap[overlapIndex];
+					childFractionOfOverlap[kept] = childFractionOfOverlap[overlapIndex];
+					parentFractionOfOverlap[kept] = parentFractionOfOverlap[overlapIndex];
+					++kept;
+				}
+			}
+			childOffsets[c + 1] = kept;
+		}
+		parentOfOverlap.resize(kept);
+		childOfOverlap.resize(kept);
+		childFractionOfOverlap.resize(kept);
+		parentFractionOfOverlap.resize(kept);
+	}
+
+	// Parent ordered overlaps : counting sort which keeps the child ordering inside each parent cell
+	const ULONG64 overlapCount = parentOfOverlap.size();
+	parentOffsets.assign(parentCellCount + 1, 0);
+	for (ULONG64 i = 0; i < overlapCount; ++i) {
+		if (parentOfOverlap[i] >= parentCellCount) {
+			throw out_of_range("The parent window refers to a cell which is out of the parent grid.");
+		}
+		++parentOffsets[parentOfOverlap[i] + 1];
+	}
+	for (ULONG64 p = 0; p < parentCellCount; ++p) {
+		parentOffsets[p + 1] += parentOffsets[p];
+	}
+	overlapsOfParents.resize(overlapCount);
+	std::vector<ULONG64> next(parentOffsets.begin(), parentOffsets.end() - 1);
+	for (ULONG64 i = 0; i < overlapCount; ++i) {
+		overlapsOfParents[next[parentOfOverlap[i]]++] = i;
+	}
+
+	refinedParentCells.assign(parentCellCount, false);
+	for (ULONG64 p = 0; p < parentCellCount; ++p) {
+		refinedParentCells[p] = parentOffsets[p + 1] > parentOffsets[p];
+	}
+}
+
+bool LocalGridRefinementMapping::isParentCellRefined(const ULONG64 & parentCellIndex) const
+{
+	if (parentCellIndex >= getParentCellCount()) {
+		throw out_of_range("The parent cell index is out of range.");
+	}
+
+	return refinedParentCells[parentCellIndex];
+}
+
+ULONG64 LocalGridRefinementMapping::getParentCellCountOfChildCell(const ULONG64 & childCellIndex) const
+{
+	if (childCellIndex >= getChildCellCount()) {
+		throw out_of_range("The child cell index is out of range.");
+	}
+
+	return childOffsets[childCellIndex + 1] - childOffsets[childCellIndex];
+}
+
+void LocalGridRefinementMapping::getParentCellsOfChildCell(const ULONG64 & childCellIndex, ULONG64 * parentCellIndices, double * childFractions) const
+{
+	if (childCellIndex >= getChildCellCount()) {
+		throw out_of_range("The child cell index is out of range.");
+	}
+
+	for (ULONG64 i = childOffsets[childCellIndex]; i < childOffsets[childCellIndex + 1]; ++i) {
+		*parentCellIndices++ = parentOfOverlap[i];
+		if (childFractions != nullptr) {
+			*childFractions++ = childFractionOfOverlap[i];
+		}
+	}
+}
+
+ULONG64 LocalGridRefinementMapping::getChildCellCountOfParentCell(const ULONG64 & parentCellIndex) const
+{
+	if (parentCellIndex >= getParentCellCount()) {
+		throw out_of_range("The parent cell index is out of range.");
+	}
+
+	return parentOffsets[parentCellIndex + 1] - parentOffsets[parentCellIndex];
+}
+
+void LocalGridRefinementMapping::getChildCellsOfParentCell(const ULONG64 & parentCellIndex, ULONG64 * childCellIndices, double * parentFractions) const
+{
+	if (parentCellIndex >= getParentCellCount()) {
+		throw out_of_range("The parent cell index is out of range.");
+	}
+
+	for (ULONG64 i = parentOffsets[parentCellIndex]; i < parentOffsets[parentCellIndex + 1]; ++i) {
+		const ULONG64 overlapIndex = overlapsOfParents[i];
+		*childCellIndices++ = childOfOverlap[overlapIndex];
+		if (parentFractions != nullptr) {
+			*parentFractions++ = parentFractionOfOverlap[overlapIndex];
+		}
+	}
+}
+
+void LocalGridRefinementMapping::getParentCellIndices(const ULONG64 * childCellIndices, const ULONG64 & count, ULONG64 * parentCellIndices) const
+{
+	const ULONG64 childCellCount = getChildCellCount();
+	for (ULONG64 i = 0; i < count; ++i) {
+		if (childCellIndices[i] >= childCellCount) {
+			throw out_of_range("A child cell index is out of range.");
+		}
+		ULONG64 result = (numeric_limits<ULONG64>::max)();
+		double biggestFraction = -1;
+		for (ULONG64 overlapIndex = childOffsets[childCellIndices[i]]; overlapIndex < childOffsets[childCellIndices[i] + 1]; ++overlapIndex) {
+			if (childFractionOfOverlap[overlapIndex] > biggestFraction) {
+				biggestFraction = childFractionOfOverlap[overlapIndex];
+				result = parentOfOverlap[overlapIndex];
+			}
+		}
+		parentCellIndices[i] = result;
+	}
+}
+
+void LocalGridRefinementMapping::getChildCellCounts(const ULONG64 * parentCellIndices, const ULONG64 & count, ULONG64 * childCellCounts) const
+{
+	const ULONG64 parentCellCount = getParentCellCount();
+	for (ULONG64 i = 0; i < count; ++i) {
+		if (parentCellIndices[i] >= parentCellCount) {
+			throw out_of_range("A parent cell index is out of range.");
+		}
+		childCellCounts[i] = parentOffsets[parentCellIndices[i] + 1] - parentOffsets[parentCellIndices[i]];
+	}
+}
+
+void LocalGridRefinementMapping::upscale(const double * childValues, double * parentValues, const propertyKind & kind) const
+{
+	// Each parent cell only reads its own overlaps and only writes its own value : the parent cells are shared between threads.
+	parallel::forEachRange(getParentCellCount(), 4096, [&](const unsigned int &, const uint64_t & firstParent, const uint64_t & endParent) {
+		for (ULONG64 p = firstParent; p < endParent; ++p) {
+			const ULONG64 begin = parentOffsets[p];
+			const ULONG64 end = parentOffsets[p + 1];
+			if (begin == end) {
+				continue;
+			}
+
+			double sum = 0;
+			double weightSum = 0;
+			bool hasValue = false;
+			for (ULONG64 i = begin; i < end; ++i) {
+				const ULONG64 overlapIndex = overlapsOfParents[i];
+				const double value = childValues[childOfOverlap[overlapIndex]];
+				if (!std::isnan(value)) {
+					const double weight = kind == INTENSIVE ? parentFractionOfOverlap[overlapIndex] : childFractionOfOverlap[overlapIndex];
+					sum += value * weight;
+					weightSum += weight;
+					hasValue = true;
+				}
+			}
+
+			if (!hasValue) {
+				parentValues[p] = numeric_limits<double>::quiet_NaN();
+			}
+			else if (kind == INTENSIVE) {
+				parentValues[p] = weightSum > 0 ? sum / weightSum : numeric_limits<double>::quiet_NaN();
+			}
+			else {
+				parentValues[p] = sum;
+			}
+		}
+	});
+}
+
+void LocalGridRefinementMapping::downscale(const double * parentValues, double * childValues, const propertyKind & kind) const
+{
+	// Each child cell only reads its own overlaps and only writes its own value : the child cells are shared between threads.
+	parallel::forEachRange(getChildCellCount(), 4096, [&](const unsigned int &, const uint64_t & firstChild, const uint64_t & endChild) {
+		for (ULONG64 c = firstChild; c < endChild; ++c) {
+			const ULONG64 begin = childOffsets[c];
+			const ULONG64 end = childOffsets[c + 1];
+			if (begin == end) {
+				continue;
+			}
+
+			double sum = 0;
+			double weightSum = 0;
+			bool hasValue = false;
+			for (ULONG64 i = begin; i < end; ++i) {
+				const double value = parentValues[parentOfOverlap[i]];
+				if (!std::isnan(value)) {
+					const double weight = kind == INTENSIVE ? childFractionOfOverlap[i] : parentFractionOfOverlap[i];
+					sum += value * weight;
+					weightSum += weight;
+					hasValue = true;
+				}
+			}
+
+			if (!hasValue) {
+				childValues[c] = numeric_limits<double>::quiet_NaN();
+			}
+			else if (kind == INTENSIVE) {
+				childValues[c] = weightSum > 0 ? sum / weightSum : numeric_limits<double>::quiet_NaN();
+			}
+			else {
+				childValues[c] = sum;
+			}
+		}
+	});
+}
@@ -0,0 +1,166 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#pragma once
+
+#include "resqml2/AbstractGridRepresentation.h"
+
+namespace RESQML2_NS
+{
+	/**
+	* A precomputed bidirectional mapping between the cells of a local (child) grid and the cells of its parent grid.
+	* It is built once from the parent window of the child grid : from the explicit cell overlap if any, otherwise from the regrid intervals and child cell weights.
+	* Each overlap between a child cell and a parent cell is stored twice (ordered by child cells and ordered by parent cells) together with
+	* the fraction of the child cell volume and the fraction of the parent cell volume which the overlap represents.
+	* Parent cells which are forced not to be regridded are excluded from the mapping.
+	*/
+	class DLL_IMPORT_OR_EXPORT LocalGridRefinementMapping
+	{
+	public:
+
+		/**
+		* Tells how a property is transferred between the child and the parent grid.
+		* An intensive property (porosity, pressure, ...) is averaged by volume. An extensive property (pore volume, ...) is summed by volume fraction.
+		*/
+		enum propertyKind { INTENSIVE = 0, EXTENSIVE = 1 };
+
+		/**
+		* Build the mapping between a child grid and its parent grid.
+		* The parent grid must be in the same EPC document than the child grid.
+		* A cell parent window without any cell overlap information only tells which parent cells are refined : its child cells are not mapped.
+		*/
+		LocalGridRefinementMapping(const AbstractGridRepresentation* childGrid);
+		~LocalGridRefinementMapping() {}
+
+		const AbstractGridRepresentation* getChildGrid() const { return childGrid; }
+		AbstractGridRepresentation* getParentGrid() const { return parentGrid; }
+
+		ULONG64 getChildCellCount() const { return childOffsets.size() - 1; }
+		ULONG64 getParentCellCount() const { return parentOffsets.size() - 1; }
+
+		/**
+		* Get the count of child/parent cell overlaps of the mapping.
+		*/
+		ULONG64 getOverlapCount() const { return parentOfOverlap.size(); }
+
+		/**
+		* Check if a parent cell is refined by the child grid.
+		*/
+		bool isParentCellRefined(const ULONG64 & parentCellIndex) const;
+
+		/**
+		* Get the count of parent cells overlapped by a child cell. Zero if the child cell is not mapped.
+		*/
+		ULONG64 getParentCellCountOfChildCell(const ULONG64 & childCellIndex) const;
+
+		/**
+		* Get the parent cells overlapped by a child cell.
+		* @param parentCellIndices	It must be preallocated with getParentCellCountOfChildCell(childCellIndex).
+		* @param childFractions		If not null, it must be preallocated with getParentCellCountOfChildCell(childCellIndex). It is filled in with the fraction of the child cell volume which lies in each parent cell.
+		*/
+		void getParentCellsOfChildCell(const ULONG64 & childCellIndex, ULONG64 * parentCellIndices, double * childFractions = nullptr) const;
+
+		/**
+		* Get the count of child cells overlapping a parent cell. Zero if the parent cell is not refined.
+		*/
+		ULONG64 getChildCellCountOfParentCell(const ULONG64 & parentCellIndex) const;
+
+		/**
+		* Get the child cells overlapping a parent cell. They are ordered by increasing child cell index.
+		* @param childCellIndices	It must be preallocated with getChildCellCountOfParentCell(parentCellIndex).
+		* @param parentFractions	If not null, it must be preallocated with getChildCellCountOfParentCell(parentCellIndex). It is filled in with the fraction of the parent cell volume which is covered by each child cell.
+		*/
+		void getChildCellsOfParentCell(const ULONG64 & parentCellIndex, ULONG64 * childCellIndices, double * parentFractions = nullptr) const;
+
+		/**
+		* Batch version of the child to parent mapping : get the parent cell containing the biggest part of each child cell.
+		* @param childCellIndices	The child cells to map.
+		* @param count				The count of child cells to map.
+		* @param parentCellIndices	It must be preallocated with count. A child cell which is not mapped gets (std::numeric_limits<ULONG64>::max)().
+		*/
+		void getParentCellIndices(const ULONG64 * childCellIndices, const ULONG64 & count, ULONG64 * parentCellIndices) const;
+
+		/**
+		* Batch version of getChildCellCountOfParentCell.
+		* @param parentCellIndices	The parent cells to map.
+		* @param count				The count of parent cells to map.
+		* @param childCellCounts	It must be preallocated with count.
+		*/
+		void getChildCellCounts(const ULONG64 * parentCellIndices, const ULONG64 & count, ULONG64 * childCellCounts) const;
+
+		/**
+		* Compute parent cell values from child cell values. NaN child values are ignored. A parent cell whose child values are all NaN gets NaN.
+		* @param childValues	One value per child cell.
+		* @param parentValues	One value per parent cell. The values of the parent cells which are not refined are left untouched.
+		* @param kind			INTENSIVE computes the volume weighted mean of the child values. EXTENSIVE sums the child values weighted by the fraction of the child cells lying in the parent cell.
+		*/
+		void upscale(const double * childValues, double * parentValues, const propertyKind & kind = INTENSIVE) const;
+
+		/**
+		* Compute child cell values from parent cell values. NaN parent values are ignored. A child cell whose parent values are all NaN gets NaN.
+		* @param parentValues	One value per parent cell.
+		* @param childValues	One value per child cell. The values of the child cells which are not mapped are left untouched.
+		* @param kind			INTENSIVE computes the volume weighted mean of the parent values. EXTENSIVE distributes the parent values according to the fraction of the parent cells covered by the child cell.
+		*/
+		void downscale(const double * parentValues, double * childValues, const propertyKind & kind = INTENSIVE) const;
+
+	private:
+
+		/**
+		* The overlaps between child and parent cell indices along a single dimension of a regrid.
+		*/
+		struct RegridDimension
+		{
+			std::vector<ULONG64> childOffsets;		// overlaps of child index c are in [childOffsets[c], childOffsets[c+1])
+			std::vector<ULONG64> parentIndices;		// parent index (in the whole parent grid dimension) of each overlap
+			std::vector<double> childFractions;
+			std::vector<double> parentFractions;
+		};
+
+		/**
+		* Build the overlaps along a single dimension of the regrid of the parent window.
+		* @param childCellCountIfNoInterval	The child cell count of this dimension which is used when the regrid has no interval (i.e. one child cell per parent cell).
+		*/
+		void buildRegridDimension(const char & dimension, const ULONG64 & childCellCountIfNoInterval, RegridDimension & result) const;
+
+		void buildFromIjkParentWindow();
+		void buildFromColumnLayerParentWindow();
+		void buildFromCellOverlap();
+
+		/**
+		* Remove the overlaps of the forced non regrided parent cells, build the parent ordered overlaps and flag the refined parent cells.
+		*/
+		void finalize();
+
+		const AbstractGridRepresentation* childGrid;
+		AbstractGridRepresentation* parentGrid;
+
+		// Child ordered overlaps
+		std::vector<ULONG64> childOffsets;
+		std::vector<ULONG64> parentOfOverlap;
+		std::vector<ULONG64> childOfOverlap;
+		std::vector<double> childFractionOfOverlap;		// fraction of the child cell volume
+		std::vector<double> parentFractionOfOverlap;	// fraction of the parent cell volume
+
+		// Parent ordered overlaps (indices of the child ordered overlaps)
+		std::vector<ULONG64> parentOffsets;
+		std::vector<ULONG64> overlapsOfParents;
+
+		std::vector<bool> refinedParentCells;
+	};
+}
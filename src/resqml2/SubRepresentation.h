@@ -20,6 +20,8 @@ under the License.
 
 #include "resqml2/AbstractRepresentation.h"
 
+#include "tools/IndexSet.h"
+
 namespace RESQML2_NS
 {
 	class DLL_IMPORT_OR_EXPORT SubRepresentation : public RESQML2_NS::AbstractRepresentation
@@ -70,6 +72,15 @@ namespace RESQML2_NS
 		*/
 		virtual void getElementIndicesOfPatch(const unsigned int & patchIndex, const unsigned int & elementIndicesIndex, ULONG64 * elementIndices) const = 0;
 
+		/**
+		* Get the indices of the selected elements for a particular patch of this subrepresentation without expanding them.
+		* Lattice element indices are added as ranges and HDF5 element indices are read by chunks. Null element indices are ignored.
+		* Since it is a set, a duplicated element index is only stored once and the elements are not in the order of the patch anymore.
+		* @param	elementIndicesIndex	Must be equal to 0 if the element indices are not pairwise.
+		* @param	elementIndices		The set where the element indices are added.
+		*/
+		virtual void getElementIndicesOfPatch(const unsigned int & patchIndex, const unsigned int & elementIndicesIndex, indexing::IndexSet & elementIndices) const = 0;
+
 		/**
 		* Get the indices of the supporting representations of the selected elements for a particular patch of this subrepresentation.
 		* @param	supportingRepresentationIndices	This array must be preallocated with getElementCountOfPatch() size.
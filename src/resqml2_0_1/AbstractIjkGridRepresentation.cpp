@@ -19,11 +19,14 @@ under the License.
 
 #include "resqml2_0_1/AbstractIjkGridRepresentation.h"
 
+#include <cmath>
 #include <stdexcept>
+#include <algorithm>
 
 #include "hdf5.h"
 
 #include "resqml2/AbstractFeatureInterpretation.h"
+#include "resqml2/GridConnectionSetRepresentation.h"
 #include "resqml2/AbstractLocal3dCrs.h"
 #include "common/AbstractHdfProxy.h"
 
@@ -31,6 +34,104 @@ using namespace std;
 using namespace gsoap_resqml2_0_1;
 using namespace RESQML2_0_1_NS;
 
+namespace {
+	/**
+	* The extent along the two shared pillars of a cell face which lies on a column edge.
+	* Top is the smaller coordinate along the pillar and bottom the greater one.
+	*/
+	struct ColumnEdgeFace
+	{
+		unsigned int kCell;
+		double top[2];
+		double bottom[2];
+	};
+
+	/**
+	* Check if a face is entirely before another one along both pillars of a column edge.
+	*/
+	bool isBefore(const ColumnEdgeFace & face, const ColumnEdgeFace & otherFace)
+	{
+		return face.bottom[0] <= otherFace.top[0] && face.bottom[1] <= otherFace.top[1];
+	}
+
+	/**
+	* The axis of a pillar as seen from a column. It goes from the node of the first K interface to the node of the last K interface.
+	*/
+	struct PillarAxis
+	{
+		double origin[3];
+		double direction[3];
+	};
+
+	/**
+	* Get the axes of the two pillars of a column edge from the nodes of this column.
+	* A pillar whose first and last nodes are the same falls back on the Z axis.
+	* @param xyzPoints					The XYZ points of a block which contains the column on all its K interfaces.
+	* @param columnCornerPointIndices	The indices in the first K interface of the block of the 4 corner points of the column (see getXyzPointIndicesOfBlockColumnCorners).
+	* @param kInterfacePointCount		The count of points of a K interface of the block.
+	* @param firstCorner				The top corner (see getXyzPointIndexFromCellCorner) of the face on the first pillar of the edge.
+	* @param secondCorner				The top corner of the face on the second pillar of the edge.
+	*/
+	void getColumnEdgePillarAxes(const double * xyzPoints, const ULONG64 * columnCornerPointIndices, const ULONG64 & kInterfacePointCount, const unsigned int & kCellCount,
+		const unsigned int & firstCorner, const unsigned int & secondCorner, PillarAxis * axes)
+	{
+		const unsigned int corners[2] = { firstCorner, secondCorner };
+		for (unsigned int pillar = 0; pillar < 2; ++pillar) {
+			const double* first = xyzPoints + 3 * columnCornerPointIndices[corners[pillar]];
+			const double* last = xyzPoints + 3 * (kCellCount * kInterfacePointCount + columnCornerPointIndices[corners[pillar]]);
+			double squaredLength = 0;
+			for (unsigned int d = 0; d < 3; ++d) {
+				axes[pillar].origin[d] = first[d];
+				axes[pillar].direction[d] = last[d] - first[d];
+				squaredLength += axes[pillar].direction[d] * axes[pillar].direction[d];
+			}
+			if (squaredLength == 0) {
+				axes[pillar].direction[0] = axes[pillar].direction[1] = 0;
+				axes[pillar].direction[2] = 1;
+			}
+			else {
+				const double length = sqrt(squaredLength);
+				for (unsigned int d = 0; d < 3; ++d) {
+					axes[pillar].direction[d] /= length;
+				}
+			}
+		}
+	}
+
+	/**
+	* Get the faces of a column which lie on one of its edges, in the order of the pillars.
+	* The extent of a face on a pillar is the abscissa of its nodes along the pillar axis. Using the same axes for both columns of an edge makes their faces comparable
+	* whatever the pillar direction is (vertical, tilted or horizontal) and the faces of both columns follow the K order of the axes.
+	* @param xyzPoints					The XYZ points of a block which contains the column on all its K interfaces.
+	* @param columnCornerPointIndices	The indices in the first K interface of the block of the 4 corner points of the column (see getXyzPointIndicesOfBlockColumnCorners).
+	* @param kInterfacePointCount		The count of points of a K interface of the block.
+	* @param firstCorner				The top corner (see getXyzPointIndexFromCellCorner) of the face on the first pillar of the edge.
+	* @param secondCorner				The top corner of the face on the second pillar of the edge.
+	* @param axes						The axes of the first and second pillars of the edge.
+	*/
+	void getColumnEdgeFaces(const double * xyzPoints, const ULONG64 * columnCornerPointIndices, const ULONG64 & kInterfacePointCount, const unsigned int & kCellCount,
+		const unsigned int & firstCorner, const unsigned int & secondCorner, const PillarAxis * axes, std::vector<ColumnEdgeFace> & faces)
+	{
+		faces.resize(kCellCount);
+		const unsigned int corners[2] = { firstCorner, secondCorner };
+		for (unsigned int kCell = 0; kCell < kCellCount; ++kCell) {
+			faces[kCell].kCell = kCell;
+			for (unsigned int pillar = 0; pillar < 2; ++pillar) {
+				const double* point = xyzPoints + 3 * (kCell * kInterfacePointCount + columnCornerPointIndices[corners[pillar]]);
+				const double* nextPoint = point + 3 * kInterfacePointCount;
+				double abscissa = 0;
+				double nextAbscissa = 0;
+				for (unsigned int d = 0; d < 3; ++d) {
+					abscissa += (point[d] - axes[pillar].origin[d]) * axes[pillar].direction[d];
+					nextAbscissa += (nextPoint[d] - axes[pillar].origin[d]) * axes[pillar].direction[d];
+				}
+				faces[kCell].top[pillar] = abscissa < nextAbscissa ? abscissa : nextAbscissa;
+				faces[kCell].bottom[pillar] = abscissa < nextAbscissa ? nextAbscissa : abscissa;
+			}
+		}
+	}
+}
+
 const char* AbstractIjkGridRepresentation::XML_TAG = "IjkGridRepresentation";
 const char* AbstractIjkGridRepresentation::XML_TAG_TRUNCATED = "TruncatedIjkGridRepresentation";
 
@@ -79,7 +180,7 @@ AbstractIjkGridRepresentation::AbstractIjkGridRepresentation(soap* soapContext,
 	const std::string & guid, const std::string & title,
 	const unsigned int & iCount, const unsigned int & jCount, const unsigned int & kCount,
 	bool withTruncatedPillars) :
-	RESQML2_NS::AbstractColumnLayerGridRepresentation(nullptr, crs, withTruncatedPillars), splitInformation(nullptr), blockInformation(nullptr)
+	RESQML2_NS::AbstractColumnLayerGridRepresentation(nullptr, crs, withTruncatedPillars), splitInformationLoaded(false), blockInformation(nullptr), enabledCellCount((std::numeric_limits<ULONG64>::max)())
 {
 	init(soapContext, crs, guid, title, iCount, jCount, kCount, withTruncatedPillars);
 }
@@ -88,7 +189,7 @@ AbstractIjkGridRepresentation::AbstractIjkGridRepresentation(RESQML2_NS::Abstrac
 	const std::string & guid, const std::string & title,
 	const unsigned int & iCount, const unsigned int & jCount, const unsigned int & kCount,
 	bool withTruncatedPillars) :
-	RESQML2_NS::AbstractColumnLayerGridRepresentation(interp, crs, withTruncatedPillars), splitInformation(nullptr), blockInformation(nullptr)
+	RESQML2_NS::AbstractColumnLayerGridRepresentation(interp, crs, withTruncatedPillars), splitInformationLoaded(false), blockInformation(nullptr), enabledCellCount((std::numeric_limits<ULONG64>::max)())
 {
 	if (interp == nullptr) {
 		throw invalid_argument("The interpretation of the IJK grid cannot be null.");
@@ -254,44 +355,10 @@ unsigned long AbstractIjkGridRepresentation::getBlockSplitCoordinateLineCount()
 	if (blockInformation == nullptr)
 		throw invalid_argument("The block information must have been loaded first.");
 
-	unsigned long splitCoordinateLineCount = 0;
-	
-	// I traverse all pillars of the block
-	for (unsigned int jPillarIndex = blockInformation->jInterfaceStart; jPillarIndex <= blockInformation->jInterfaceEnd; ++jPillarIndex)
-	{
-		for (unsigned int iPillarIndex = blockInformation->iInterfaceStart; iPillarIndex <= blockInformation->iInterfaceEnd; iPillarIndex++)
-		{
-			unsigned int pillarIndex = getGlobalIndexPillarFromIjIndex(iPillarIndex, jPillarIndex);
-
-			// if I am looking at a splitted pillar
-			if (splitInformation[pillarIndex].size() != 0) 
-			{
-				// I traverse all corresponding splitted coordinate lines
-				for (unsigned int splitCoordinateLineIndex = 0; splitCoordinateLineIndex < splitInformation[pillarIndex].size(); ++splitCoordinateLineIndex)
-				{
-					// I traverse all columns adjacent to the split coordinate line
-					for (unsigned int columnIndex = 0; columnIndex < splitInformation[pillarIndex][splitCoordinateLineIndex].second.size(); ++columnIndex)
-					{
-						unsigned int iColumnIndex = getIColumnFromGlobalIndex(splitInformation[pillarIndex][splitCoordinateLineIndex].second[columnIndex]);
-						unsigned int jColumnIndex = getJColumnFromGlobalIndex(splitInformation[pillarIndex][splitCoordinateLineIndex].second[columnIndex]);
-
-						// if the split coordinate line is adjacent to the cell of the block, I count the corresponding splited pillar
-						if ((iColumnIndex >= blockInformation->iInterfaceStart && iColumnIndex <= blockInformation->iInterfaceEnd - 1) && (jColumnIndex >= blockInformation->jInterfaceStart && jColumnIndex <= blockInformation->jInterfaceEnd - 1))
-						{
-							++splitCoordinateLineCount;
-
-							break; // to be sure not to count several time a same split pillar
-						}
-					}
-				}
-			}
-		}
-	}
-
-	return splitCoordinateLineCount;
+	// The block split coordinate lines have already been collected when loading the block information.
+	return blockInformation->globalToLocalSplitCoordinateLinesIndex.size();
 }
 
-
 ULONG64 AbstractIjkGridRepresentation::getSplitNodeCount() const
 {
 	gsoap_resqml2_0_1::resqml2__IjkGridGeometry* geom = static_cast<gsoap_resqml2_0_1::resqml2__IjkGridGeometry*>(getPointGeometry2_0_1(0));
@@ -561,15 +628,27 @@ unsigned int AbstractIjkGridRepresentation::getGlobalIndexCellFromIjkIndex(const
 	return iCell + getICellCount() * jCell + getColumnCount() * kCell;
 }
 
-void AbstractIjkGridRepresentation::loadSplitInformation()
+unsigned long long AbstractIjkGridRepresentation::SplitInformation::getByteSize() const
 {
-	unloadSplitInformation();
-	splitInformation = new std::vector< std::pair< unsigned int, std::vector<unsigned int> > >[(getICellCount()+1) * (getJCellCount()+1)];
+	unsigned long long result = sizeof(SplitInformation) + pillarCount * sizeof(std::vector< std::pair< unsigned int, std::vector<unsigned int> > >);
+	for (unsigned int pillarIndex = 0; pillarIndex < pillarCount; ++pillarIndex) {
+		result += splitCoordinateLinesOfPillars[pillarIndex].capacity() * sizeof(std::pair< unsigned int, std::vector<unsigned int> >);
+		for (size_t splitCoordinateLineIndex = 0; splitCoordinateLineIndex < splitCoordinateLinesOfPillars[pillarIndex].size(); ++splitCoordinateLineIndex) {
+			result += splitCoordinateLinesOfPillars[pillarIndex][splitCoordinateLineIndex].second.capacity() * sizeof(unsigned int);
+		}
+	}
+	return result;
+}
 
+AbstractIjkGridRepresentation::SplitInformation* AbstractIjkGridRepresentation::readSplitInformation() const
+{
 	gsoap_resqml2_0_1::resqml2__IjkGridGeometry* geom = static_cast<gsoap_resqml2_0_1::resqml2__IjkGridGeometry*>(getPointGeometry2_0_1(0));
 	if (geom == nullptr) {
 		throw invalid_argument("There is no geometry on this grid.");
 	}
+
+	SplitInformation* result = new SplitInformation((getICellCount()+1) * (getJCellCount()+1));
+	std::vector< std::pair< unsigned int, std::vector<unsigned int> > >* splitInformation = result->splitCoordinateLinesOfPillars;
 	if (geom->SplitCoordinateLines != nullptr)
 	{
 		// Read the split information
@@ -607,11 +686,43 @@ void AbstractIjkGridRepresentation::loadSplitInformation()
 		delete [] columnIndexCumulativeCountPerSplitCoordinateLine;
 		delete [] splitColumnIndices;
 	}
+
+	return result;
+}
+
+void AbstractIjkGridRepresentation::loadSplitInformation()
+{
+	if (getEpcDocument() == nullptr)
+		throw invalid_argument("The ijk grid must belong to an EPC document to load its split information.");
+
+	SplitInformation* splitInfo = readSplitInformation();
+	cachedSplitInformation = std::static_pointer_cast<SplitInformation>(getEpcDocument()->getGeometryCache()->put(this, COMMON_NS::GeometryCache::SPLIT_INFORMATION, splitInfo));
+	splitInformationLoaded = true;
+}
+
+std::shared_ptr<AbstractIjkGridRepresentation::SplitInformation> AbstractIjkGridRepresentation::getSplitInformation() const
+{
+	if (!splitInformationLoaded) {
+		return std::shared_ptr<SplitInformation>();
+	}
+
+	std::shared_ptr<SplitInformation> splitInfo = cachedSplitInformation.lock();
+	if (!splitInfo) {
+		// It has been evicted from the cache
+		COMMON_NS::GeometryCache* cache = getEpcDocument()->getGeometryCache();
+		splitInfo = std::static_pointer_cast<SplitInformation>(cache->put(this, COMMON_NS::GeometryCache::SPLIT_INFORMATION, readSplitInformation()));
+		cachedSplitInformation = splitInfo;
+	}
+
+	return splitInfo;
 }
 
 void AbstractIjkGridRepresentation::loadBlockInformation(const unsigned int & iInterfaceStart, const unsigned int & iInterfaceEnd, const unsigned int & jInterfaceStart, const unsigned int & jInterfaceEnd, const unsigned int & kInterfaceStart, const unsigned int & kInterfaceEnd)
 {
-	if (splitInformation == nullptr)
+	const std::shared_ptr<SplitInformation> splitInfo = getSplitInformation();
+	std::vector< std::pair< unsigned int, std::vector<unsigned int> > >* splitInformation = splitInfo ? splitInfo->splitCoordinateLinesOfPillars : nullptr;
+
+	if (splitInformation == nullptr && !hasArithmeticNodeIndexing())
 		throw invalid_argument("The split information must have been loaded first.");
 
 	if (iInterfaceEnd > getICellCount() || iInterfaceEnd > getICellCount())
@@ -641,8 +752,12 @@ void AbstractIjkGridRepresentation::loadBlockInformation(const unsigned int & iI
 	blockInformation->kInterfaceStart = kInterfaceStart;
 	blockInformation->kInterfaceEnd = kInterfaceEnd;
 
+	if (splitInformation == nullptr) {
+		return; // no split coordinate line
+	}
+
 	// seting mapping between global and local (to the block) split coordinate lines index
-	unsigned int splitCoordinateLineHdfLocalIndex = (iInterfaceEnd - iInterfaceStart + 1) * (jInterfaceEnd - jInterfaceStart + 1);
+	// First collect the split coordinate lines impacting the block
 	for (unsigned int jPillarIndex = jInterfaceStart; jPillarIndex <= jInterfaceEnd; ++jPillarIndex)
 	{
 		for (unsigned int iPillarIndex = iInterfaceStart; iPillarIndex <= iInterfaceEnd; iPillarIndex++)
@@ -665,8 +780,7 @@ void AbstractIjkGridRepresentation::loadBlockInformation(const unsigned int & iI
 						if ((iColumnIndex >= iInterfaceStart && iColumnIndex < iInterfaceEnd) && (jColumnIndex >= jInterfaceStart && jColumnIndex < jInterfaceEnd))
 						{
 							// here is a split coordinate line impacting the bloc
-							(blockInformation->globalToLocalSplitCoordinateLinesIndex)[splitInformation[pillarIndex][splitCoordinateLineIndex].first] = splitCoordinateLineHdfLocalIndex;
-							++splitCoordinateLineHdfLocalIndex;
+							(blockInformation->globalToLocalSplitCoordinateLinesIndex)[splitInformation[pillarIndex][splitCoordinateLineIndex].first] = 0;
 
 							break; // in order to be sure not adding twice a same coordinate line if it is adjacent to several columns within the bloc
 						}
@@ -675,13 +789,76 @@ void AbstractIjkGridRepresentation::loadBlockInformation(const unsigned int & iI
 			}
 		}
 	}
+
+	// Then number them in increasing global index order which is the order they are read from the HDF datasets
+	unsigned int splitCoordinateLineHdfLocalIndex = (iInterfaceEnd - iInterfaceStart + 1) * (jInterfaceEnd - jInterfaceStart + 1);
+	for (std::map<unsigned int, unsigned int>::iterator it = blockInformation->globalToLocalSplitCoordinateLinesIndex.begin(); it != blockInformation->globalToLocalSplitCoordinateLinesIndex.end(); ++it) {
+		it->second = splitCoordinateLineHdfLocalIndex++;
+	}
+}
+
+void AbstractIjkGridRepresentation::readBlockOfNodeDataset(const std::string & datasetName, double * values, const unsigned int & valueCountPerNode) const
+{
+	if (blockInformation == nullptr)
+		throw invalid_argument("The block information must have been loaded first.");
+
+	const unsigned int rank = hdfProxy->getDimensionCount(datasetName);
+	const unsigned int nodeValueDimCount = valueCountPerNode > 1 ? 1 : 0;
+	const unsigned long long kInterfaceCount = blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart + 1;
+	const unsigned long long jPillarCount = blockInformation->jInterfaceEnd - blockInformation->jInterfaceStart + 1;
+	const unsigned long long iPillarCount = blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart + 1;
+
+	if (rank == 3 + nodeValueDimCount) {
+		// K, J and I are distinct dimensions : a single hyperslab selects the whole block.
+		unsigned long long valueCountPerDimension[4] = { kInterfaceCount, jPillarCount, iPillarCount, valueCountPerNode };
+		unsigned long long offsetPerDimension[4] = { blockInformation->kInterfaceStart, blockInformation->jInterfaceStart, blockInformation->iInterfaceStart, 0 };
+		hdfProxy->readArrayNdOfDoubleValues(datasetName, values, valueCountPerDimension, offsetPerDimension, rank);
+	}
+	else if (rank == 2 + nodeValueDimCount) {
+		// Coordinate lines are flattened : one strided hyperslab for the block pillars (one block per J pillar row)...
+		unsigned long long blockCountPerDimension[3] = { 1, jPillarCount, 1 };
+		unsigned long long offsetPerDimension[3] = { blockInformation->kInterfaceStart, blockInformation->jInterfaceStart * (getICellCount() + 1) + blockInformation->iInterfaceStart, 0 };
+		unsigned long long strideInEachDimension[3] = { 1, getICellCount() + 1, 1 };
+		unsigned long long blockSizeInEachDimension[3] = { kInterfaceCount, iPillarCount, valueCountPerNode };
+
+		int dataset, filespace;
+		hdfProxy->selectArrayNdOfValues(datasetName, blockCountPerDimension, offsetPerDimension, strideInEachDimension, blockSizeInEachDimension,
+			rank, true, dataset, filespace);
+		unsigned long long slabSize = kInterfaceCount * jPillarCount * iPillarCount * valueCountPerNode;
+
+		// ... and one hyperslab per run of consecutive split coordinate lines of the block.
+		const std::map<unsigned int, unsigned int> & blockSplitLines = blockInformation->globalToLocalSplitCoordinateLinesIndex;
+		std::map<unsigned int, unsigned int>::const_iterator it = blockSplitLines.begin();
+		while (it != blockSplitLines.end()) {
+			const unsigned int runStart = it->first;
+			unsigned int runLength = 1;
+			for (++it; it != blockSplitLines.end() && it->first == runStart + runLength; ++it) {
+				++runLength;
+			}
+
+			blockCountPerDimension[1] = 1;
+			offsetPerDimension[1] = getPillarCount() + runStart;
+			strideInEachDimension[1] = 1;
+			blockSizeInEachDimension[1] = runLength;
+			hdfProxy->selectArrayNdOfValues(datasetName, blockCountPerDimension, offsetPerDimension, strideInEachDimension, blockSizeInEachDimension,
+				rank, false, dataset, filespace);
+			slabSize += kInterfaceCount * runLength * valueCountPerNode;
+		}
+
+		// reading values corresponding to the whole selected region (non splitted and splitted part)
+		hdfProxy->readArrayNdOfDoubleValues(dataset, filespace, values, slabSize);
+	}
+	else {
+		throw invalid_argument("The dataset " + datasetName + " has not the expected dimension count for an ijk grid node dataset.");
+	}
 }
 
 void AbstractIjkGridRepresentation::unloadSplitInformation()
 {
-	if (splitInformation != nullptr) {
-		delete [] splitInformation;
-		splitInformation = nullptr;
+	splitInformationLoaded = false;
+	cachedSplitInformation.reset();
+	if (getEpcDocument() != nullptr) {
+		getEpcDocument()->getGeometryCache()->release(this, COMMON_NS::GeometryCache::SPLIT_INFORMATION);
 	}
 }
 
@@ -721,14 +898,20 @@ unsigned int AbstractIjkGridRepresentation::getFaceCount() const
 
 bool AbstractIjkGridRepresentation::isColumnEdgeSplitted(const unsigned int & iColumn, const unsigned int & jColumn, const unsigned int & edge) const
 {
-	if (splitInformation == nullptr)
-		throw invalid_argument("The split information must have been loaded first.");
+	const std::shared_ptr<SplitInformation> splitInfo = getSplitInformation();
+	std::vector< std::pair< unsigned int, std::vector<unsigned int> > >* splitInformation = splitInfo ? splitInfo->splitCoordinateLinesOfPillars : nullptr;
+
 	if (iColumn > getICellCount())
 		throw range_error("I column is out of range.");
 	if (jColumn > getJCellCount())
 		throw range_error("J column is out of range.");
 	if (edge > 7)
 		throw range_error("Edge is out of range.");
+	if (splitInformation == nullptr) {
+		if (hasArithmeticNodeIndexing())
+			return false;
+		throw invalid_argument("The split information must have been loaded first.");
+	}
 
 	// Pillar
 	unsigned int iPillarIndex = iColumn;
@@ -834,9 +1017,160 @@ bool AbstractIjkGridRepresentation::isColumnEdgeSplitted(const unsigned int & iC
 	return result;
 }
 
+void AbstractIjkGridRepresentation::getFaultConnections(std::vector<ULONG64> & cellIndexPairs, std::vector<int> & localFacePerCellIndexPairs)
+{
+	cellIndexPairs.clear();
+	localFacePerCellIndexPairs.clear();
+	const unsigned long splitCoordinateLineCount = getSplitCoordinateLineCount();
+	if (splitCoordinateLineCount == 0) {
+		return;
+	}
+
+	const unsigned int iCellCount = getICellCount();
+	const unsigned int jCellCount = getJCellCount();
+	const unsigned int kCellCount = getKCellCount();
+
+	// Only the column edges around the pillars of the split coordinate lines can be split.
+	// A candidate is 2 * column index for edge 1 (I+ face) and 2 * column index + 1 for edge 2 (J+ face) : sorting them gives the column order.
+	std::vector<unsigned int> splitPillars(splitCoordinateLineCount);
+	getPillarsOfSplitCoordinateLines(&splitPillars[0]);
+	std::vector<ULONG64> columnEdges;
+	for (unsigned long splitCoordinateLine = 0; splitCoordinateLine < splitCoordinateLineCount; ++splitCoordinateLine) {
+		const unsigned int iPillar = splitPillars[splitCoordinateLine] % (iCellCount + 1);
+		const unsigned int jPillar = splitPillars[splitCoordinateLine] / (iCellCount + 1);
+		if (iPillar > 0 && iPillar < iCellCount) {
+			for (unsigned int jColumn = jPillar > 0 ? jPillar - 1 : 0; jColumn <= jPillar && jColumn < jCellCount; ++jColumn) {
+				columnEdges.push_back(2 * (iPillar - 1 + static_cast<ULONG64>(jColumn) * iCellCount));
+			}
+		}
+		if (jPillar > 0 && jPillar < jCellCount) {
+			for (unsigned int iColumn = iPillar > 0 ? iPillar - 1 : 0; iColumn <= iPillar && iColumn < iCellCount; ++iColumn) {
+				columnEdges.push_back(2 * (iColumn + static_cast<ULONG64>(jPillar - 1) * iCellCount) + 1);
+			}
+		}
+	}
+	std::sort(columnEdges.begin(), columnEdges.end());
+	columnEdges.erase(std::unique(columnEdges.begin(), columnEdges.end()), columnEdges.end());
+
+	// Connections to disabled cells are ignored.
+	indexing::BitSet enabledCells;
+	if (hasEnabledCellInformation()) {
+		getEnabledCells(enabledCells);
+	}
+
+	// The points are read by block : a block gathers a run of consecutive candidate columns of a J row together with the next column in I and the next row in J.
+	// The current block of the grid is restored at the end.
+	BlockInformation* const currentBlockInformation = blockInformation;
+	blockInformation = nullptr;
+	try {
+		std::vector<double> xyzPoints;
+		std::vector<ULONG64> columnCornerPointIndices;
+		PillarAxis axes[2];
+		std::vector<ColumnEdgeFace> faces;
+		std::vector<ColumnEdgeFace> otherFaces;
+		size_t runStart = 0;
+		while (runStart < columnEdges.size()) {
+			const unsigned int j = static_cast<unsigned int>(columnEdges[runStart] / 2 / iCellCount);
+			const unsigned int iFirst = static_cast<unsigned int>(columnEdges[runStart] / 2 % iCellCount);
+			size_t runEnd = runStart + 1;
+			while (runEnd < columnEdges.size() && columnEdges[runEnd] / 2 / iCellCount == j && columnEdges[runEnd] / 2 - columnEdges[runEnd - 1] / 2 <= 1) {
+				++runEnd;
+			}
+			const unsigned int iLast = static_cast<unsigned int>(columnEdges[runEnd - 1] / 2 % iCellCount);
+			const unsigned int iInterfaceEnd = iLast + 2 < iCellCount ? iLast + 2 : iCellCount;
+			const unsigned int jInterfaceEnd = j + 2 < jCellCount ? j + 2 : jCellCount;
+
+			loadBlockInformation(iFirst, iInterfaceEnd, j, jInterfaceEnd, 0, kCellCount);
+			xyzPoints.resize(getXyzPointCountOfBlock() * 3);
+			getXyzPointsOfBlockOfPatch(0, &xyzPoints[0]);
+			getXyzPointIndicesOfBlockColumnCorners(columnCornerPointIndices);
+			const ULONG64 kInterfacePointCount = static_cast<ULONG64>(iInterfaceEnd - iFirst + 1) * (jInterfaceEnd - j + 1) + getBlockSplitCoordinateLineCount();
+			const unsigned int iBlockColumnCount = iInterfaceEnd - iFirst;
+
+			for (size_t columnEdge = runStart; columnEdge < runEnd; ++columnEdge) {
+				const unsigned int i = static_cast<unsigned int>(columnEdges[columnEdge] / 2 % iCellCount);
+				// Edge 1 (I+ face of this column, I- face of the other one) and edge 2 (J+ face of this column, J- face of the other one)
+				const unsigned int edge = static_cast<unsigned int>(columnEdges[columnEdge] % 2) + 1;
+				if (!isColumnEdgeSplitted(i, j, edge)) {
+					continue;
+				}
+				const unsigned int iOther = edge == 1 ? i + 1 : i;
+				const unsigned int jOther = edge == 2 ? j + 1 : j;
+				const ULONG64* columnCorners = &columnCornerPointIndices[4 * (i - iFirst)];
+				const ULONG64* otherColumnCorners = &columnCornerPointIndices[4 * (iOther - iFirst + (jOther - j) * iBlockColumnCount)];
+
+				// Corners of both faces which are on the same pillars
+				if (edge == 1) {
+					getColumnEdgePillarAxes(&xyzPoints[0], columnCorners, kInterfacePointCount, kCellCount, 1, 2, axes);
+					getColumnEdgeFaces(&xyzPoints[0], columnCorners, kInterfacePointCount, kCellCount, 1, 2, axes, faces);
+					getColumnEdgeFaces(&xyzPoints[0], otherColumnCorners, kInterfacePointCount, kCellCount, 0, 3, axes, otherFaces);
+				}
+				else {
+					getColumnEdgePillarAxes(&xyzPoints[0], columnCorners, kInterfacePointCount, kCellCount, 3, 2, axes);
+					getColumnEdgeFaces(&xyzPoints[0], columnCorners, kInterfacePointCount, kCellCount, 3, 2, axes, faces);
+					getColumnEdgeFaces(&xyzPoints[0], otherColumnCorners, kInterfacePointCount, kCellCount, 0, 1, axes, otherFaces);
+				}
+
+				// Sweep along the pillars : the faces of the other column which overlap a face form a range which only goes forward.
+				size_t firstOther = 0;
+				for (size_t face = 0; face < faces.size(); ++face) {
+					if (faces[face].top[0] == faces[face].bottom[0] && faces[face].top[1] == faces[face].bottom[1]) {
+						continue; // collapsed face
+					}
+					while (firstOther < otherFaces.size() && isBefore(otherFaces[firstOther], faces[face])) {
+						++firstOther;
+					}
+					for (size_t otherFace = firstOther; otherFace < otherFaces.size() && !isBefore(faces[face], otherFaces[otherFace]); ++otherFace) {
+						if (otherFaces[otherFace].top[0] == otherFaces[otherFace].bottom[0] && otherFaces[otherFace].top[1] == otherFaces[otherFace].bottom[1]) {
+							continue; // collapsed face
+						}
+						const ULONG64 cellIndex = i + j * iCellCount + faces[face].kCell * static_cast<ULONG64>(iCellCount) * jCellCount;
+						const ULONG64 otherCellIndex = iOther + jOther * iCellCount + otherFaces[otherFace].kCell * static_cast<ULONG64>(iCellCount) * jCellCount;
+						if (!isBefore(otherFaces[otherFace], faces[face]) &&
+							(enabledCells.size() == 0 || (enabledCells.test(cellIndex) && enabledCells.test(otherCellIndex)))) {
+							cellIndexPairs.push_back(cellIndex);
+							cellIndexPairs.push_back(otherCellIndex);
+							localFacePerCellIndexPairs.push_back(edge == 1 ? 3 : 4);
+							localFacePerCellIndexPairs.push_back(edge == 1 ? 5 : 2);
+						}
+					}
+				}
+			}
+			runStart = runEnd;
+		}
+	}
+	catch (...) {
+		delete blockInformation;
+		blockInformation = currentBlockInformation;
+		throw;
+	}
+	delete blockInformation;
+	blockInformation = currentBlockInformation;
+}
+
+RESQML2_NS::GridConnectionSetRepresentation* AbstractIjkGridRepresentation::createFaultGridConnectionSet(const std::string & guid, const std::string & title, COMMON_NS::AbstractHdfProxy* proxy)
+{
+	std::vector<ULONG64> cellIndexPairs;
+	std::vector<int> localFacePerCellIndexPairs;
+	getFaultConnections(cellIndexPairs, localFacePerCellIndexPairs);
+	if (cellIndexPairs.empty()) {
+		return nullptr;
+	}
+
+	RESQML2_NS::GridConnectionSetRepresentation* result = getEpcDocument()->createGridConnectionSetRepresentation(guid, title);
+	result->pushBackSupportingGridRepresentation(this);
+	result->setCellIndexPairs(cellIndexPairs.size() / 2, &cellIndexPairs[0], -1, proxy);
+	result->setLocalFacePerCellIndexPairs(localFacePerCellIndexPairs.size() / 2, &localFacePerCellIndexPairs[0], -1, proxy);
+
+	return result;
+}
+
 ULONG64 AbstractIjkGridRepresentation::getXyzPointIndexFromCellCorner(const unsigned int & iCell, const unsigned int & jCell, const unsigned int & kCell, const unsigned int & corner) const
 {
-	if (splitInformation == nullptr)
+	const std::shared_ptr<SplitInformation> splitInfo = getSplitInformation();
+	std::vector< std::pair< unsigned int, std::vector<unsigned int> > >* splitInformation = splitInfo ? splitInfo->splitCoordinateLinesOfPillars : nullptr;
+
+	if (splitInformation == nullptr && !hasArithmeticNodeIndexing())
 		throw invalid_argument("The split information must have been loaded first.");
 	if (iCell > getICellCount())
 		throw range_error("I Cell is out of range.");
@@ -858,7 +1192,7 @@ ULONG64 AbstractIjkGridRepresentation::getXyzPointIndexFromCellCorner(const unsi
 		++kPointIndex;
 
 	unsigned int pillarIndex = getGlobalIndexPillarFromIjIndex(iPillarIndex, jPillarIndex);
-	if (splitInformation[pillarIndex].size() != 0)
+	if (splitInformation != nullptr && splitInformation[pillarIndex].size() != 0)
 	{
 		unsigned int columnIndex = getGlobalIndexColumnFromIjIndex(iCell, jCell);
 		for (size_t columnSet = 0; columnSet < splitInformation[pillarIndex].size(); ++columnSet)
@@ -874,10 +1208,49 @@ ULONG64 AbstractIjkGridRepresentation::getXyzPointIndexFromCellCorner(const unsi
 	return iPillarIndex + jPillarIndex * (getICellCount()+1) + kPointIndex * ((getICellCount()+1) * (getJCellCount()+1) + getSplitCoordinateLineCount()); // non splitted point
 }
 
+void AbstractIjkGridRepresentation::getXyzPointIndicesOfCellCorners(const unsigned int & iCell, const unsigned int & jCell, const unsigned int & kCell, ULONG64 * cornerPointIndices) const
+{
+	const std::shared_ptr<SplitInformation> splitInfo = getSplitInformation();
+	std::vector< std::pair< unsigned int, std::vector<unsigned int> > >* splitInformation = splitInfo ? splitInfo->splitCoordinateLinesOfPillars : nullptr;
+
+	if (splitInformation == nullptr && !hasArithmeticNodeIndexing())
+		throw invalid_argument("The split information must have been loaded first.");
+	if (iCell >= getICellCount())
+		throw range_error("I Cell is out of range.");
+	if (jCell >= getJCellCount())
+		throw range_error("J Cell is out of range.");
+	if (kCell >= getKCellCount())
+		throw range_error("K Cell is out of range.");
+
+	const ULONG64 pillarCount = static_cast<ULONG64>(getICellCount() + 1) * (getJCellCount() + 1);
+	const ULONG64 kInterfacePointCount = pillarCount + (splitInformation != nullptr ? getSplitCoordinateLineCount() : 0);
+	const unsigned int columnIndex = getGlobalIndexColumnFromIjIndex(iCell, jCell);
+	for (unsigned int corner = 0; corner < 4; ++corner) {
+		const unsigned int iPillar = corner == 1 || corner == 2 ? iCell + 1 : iCell;
+		const unsigned int jPillar = corner == 2 || corner == 3 ? jCell + 1 : jCell;
+		const unsigned int pillarIndex = getGlobalIndexPillarFromIjIndex(iPillar, jPillar);
+		ULONG64 pointIndex = pillarIndex; // non splitted point
+		if (splitInformation != nullptr) {
+			for (size_t columnSet = 0; columnSet < splitInformation[pillarIndex].size(); ++columnSet) {
+				const std::vector<unsigned int> & columns = splitInformation[pillarIndex][columnSet].second;
+				if (std::find(columns.begin(), columns.end(), columnIndex) != columns.end()) {
+					pointIndex = pillarCount + splitInformation[pillarIndex][columnSet].first; // splitted point
+					break;
+				}
+			}
+		}
+		cornerPointIndices[corner] = pointIndex + kCell * kInterfacePointCount;
+		cornerPointIndices[corner + 4] = cornerPointIndices[corner] + kInterfacePointCount;
+	}
+}
+
 void AbstractIjkGridRepresentation::getXyzPointOfBlockFromCellCorner(const unsigned int & iCell, const unsigned int & jCell, const unsigned int & kCell, const unsigned int & corner,
 	const double* xyzPoints, double & x, double & y, double & z) const
 {
-	if (splitInformation == nullptr)
+	const std::shared_ptr<SplitInformation> splitInfo = getSplitInformation();
+	std::vector< std::pair< unsigned int, std::vector<unsigned int> > >* splitInformation = splitInfo ? splitInfo->splitCoordinateLinesOfPillars : nullptr;
+
+	if (splitInformation == nullptr && !hasArithmeticNodeIndexing())
 		throw invalid_argument("The split information must have been loaded first.");
 	if (blockInformation == nullptr)
 		throw invalid_argument("The block information must have been loaded first.");
@@ -898,7 +1271,7 @@ void AbstractIjkGridRepresentation::getXyzPointOfBlockFromCellCorner(const unsig
 	ULONG64 pointIndex;
 
 	unsigned int pillarIndex = getGlobalIndexPillarFromIjIndex(iPillarIndex, jPillarIndex);
-	if (splitInformation[pillarIndex].size() != 0)
+	if (splitInformation != nullptr && splitInformation[pillarIndex].size() != 0)
 	{
 		unsigned int columnIndex = getGlobalIndexColumnFromIjIndex(iCell, jCell);
 		for (size_t columnSet = 0; columnSet < splitInformation[pillarIndex].size(); ++columnSet)
@@ -942,6 +1315,132 @@ ULONG64 AbstractIjkGridRepresentation::getXyzPointCountOfBlock() const
 	return (blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart + 1) * (blockInformation->jInterfaceEnd - blockInformation->jInterfaceStart + 1) * (blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart + 1) + (blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart + 1) * getBlockSplitCoordinateLineCount();
 }
 
+ULONG64 AbstractIjkGridRepresentation::getCellCountOfBlock() const
+{
+	if (blockInformation == nullptr)
+		throw invalid_argument("The block information must have been loaded first.");
+
+	return static_cast<ULONG64>(blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart) * (blockInformation->jInterfaceEnd - blockInformation->jInterfaceStart) * (blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart);
+}
+
+bool AbstractIjkGridRepresentation::hasArithmeticNodeIndexing() const
+{
+	if (getGeometryKind() == LATTICE) {
+		return true;
+	}
+
+	gsoap_resqml2_0_1::resqml2__IjkGridGeometry* geom = static_cast<gsoap_resqml2_0_1::resqml2__IjkGridGeometry*>(getPointGeometry2_0_1(0));
+	if (geom == nullptr) {
+		throw invalid_argument("There is no geometry on this grid.");
+	}
+
+	return geom->SplitCoordinateLines == nullptr || geom->SplitCoordinateLines->Count == 0;
+}
+
+template <bool withSplitCoordinateLines>
+void AbstractIjkGridRepresentation::getXyzPointIndicesOfBlockColumnCorners(std::vector<ULONG64> & columnCornerPointIndices) const
+{
+	const std::shared_ptr<SplitInformation> splitInfo = withSplitCoordinateLines ? getSplitInformation() : std::shared_ptr<SplitInformation>();
+	std::vector< std::pair< unsigned int, std::vector<unsigned int> > >* splitInformation = splitInfo ? splitInfo->splitCoordinateLinesOfPillars : nullptr;
+	const unsigned int iBlockPillarCount = blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart + 1;
+	const unsigned int iBlockColumnCount = blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart;
+	const unsigned int jBlockColumnCount = blockInformation->jInterfaceEnd - blockInformation->jInterfaceStart;
+	columnCornerPointIndices.resize(4 * static_cast<size_t>(iBlockColumnCount) * jBlockColumnCount);
+
+	size_t index = 0;
+	for (unsigned int jColumn = 0; jColumn < jBlockColumnCount; ++jColumn) {
+		for (unsigned int iColumn = 0; iColumn < iBlockColumnCount; ++iColumn) {
+			for (unsigned int corner = 0; corner < 4; ++corner) {
+				const unsigned int iPillar = corner == 1 || corner == 2 ? iColumn + 1 : iColumn;
+				const unsigned int jPillar = corner == 2 || corner == 3 ? jColumn + 1 : jColumn;
+				ULONG64 pointIndex = iPillar + jPillar * iBlockPillarCount; // non splitted point
+
+				if (withSplitCoordinateLines) {
+					const unsigned int pillarIndex = getGlobalIndexPillarFromIjIndex(iPillar + blockInformation->iInterfaceStart, jPillar + blockInformation->jInterfaceStart);
+					if (splitInformation[pillarIndex].size() != 0) {
+						const unsigned int columnIndex = getGlobalIndexColumnFromIjIndex(iColumn + blockInformation->iInterfaceStart, jColumn + blockInformation->jInterfaceStart);
+						for (size_t columnSet = 0; columnSet < splitInformation[pillarIndex].size(); ++columnSet) {
+							const std::vector<unsigned int> & columns = splitInformation[pillarIndex][columnSet].second;
+							if (std::find(columns.begin(), columns.end(), columnIndex) != columns.end()) {
+								pointIndex = blockInformation->globalToLocalSplitCoordinateLinesIndex.find(splitInformation[pillarIndex][columnSet].first)->second; // splitted point
+								break;
+							}
+						}
+					}
+				}
+
+				columnCornerPointIndices[index++] = pointIndex;
+			}
+		}
+	}
+}
+
+void AbstractIjkGridRepresentation::getXyzPointIndicesOfBlockColumnCorners(std::vector<ULONG64> & columnCornerPointIndices) const
+{
+	if (blockInformation == nullptr)
+		throw invalid_argument("The block information must have been loaded first.");
+
+	if (hasArithmeticNodeIndexing()) {
+		getXyzPointIndicesOfBlockColumnCorners<false>(columnCornerPointIndices);
+	}
+	else {
+		if (!splitInformationLoaded)
+			throw invalid_argument("The split information must have been loaded first.");
+		getXyzPointIndicesOfBlockColumnCorners<true>(columnCornerPointIndices);
+	}
+}
+
+void AbstractIjkGridRepresentation::getXyzPointIndicesOfBlockCellCorners(ULONG64 * cornerPointIndices) const
+{
+	std::vector<ULONG64> columnCornerPointIndices;
+	getXyzPointIndicesOfBlockColumnCorners(columnCornerPointIndices);
+
+	const size_t blockColumnCount = columnCornerPointIndices.size() / 4;
+	const ULONG64 kInterfacePointCount = static_cast<ULONG64>(blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart + 1) * (blockInformation->jInterfaceEnd - blockInformation->jInterfaceStart + 1) + getBlockSplitCoordinateLineCount();
+	const unsigned int kBlockCellCount = blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart;
+
+	ULONG64 index = 0;
+	for (unsigned int k = 0; k < kBlockCellCount; ++k) {
+		const ULONG64 topOffset = k * kInterfacePointCount;
+		const ULONG64 bottomOffset = topOffset + kInterfacePointCount;
+		for (size_t column = 0; column < blockColumnCount; ++column) {
+			const ULONG64* columnCorners = &columnCornerPointIndices[4 * column];
+			for (unsigned int corner = 0; corner < 4; ++corner) {
+				cornerPointIndices[index + corner] = topOffset + columnCorners[corner];
+				cornerPointIndices[index + 4 + corner] = bottomOffset + columnCorners[corner];
+			}
+			index += 8;
+		}
+	}
+}
+
+void AbstractIjkGridRepresentation::getCellCentersOfBlock(const double * xyzPoints, double * cellCenters) const
+{
+	std::vector<ULONG64> columnCornerPointIndices;
+	getXyzPointIndicesOfBlockColumnCorners(columnCornerPointIndices);
+
+	const size_t blockColumnCount = columnCornerPointIndices.size() / 4;
+	const ULONG64 kInterfacePointCount = static_cast<ULONG64>(blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart + 1) * (blockInformation->jInterfaceEnd - blockInformation->jInterfaceStart + 1) + getBlockSplitCoordinateLineCount();
+	const unsigned int kBlockCellCount = blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart;
+
+	ULONG64 cellIndex = 0;
+	for (unsigned int k = 0; k < kBlockCellCount; ++k) {
+		const double* topPoints = xyzPoints + 3 * k * kInterfacePointCount;
+		const double* bottomPoints = topPoints + 3 * kInterfacePointCount;
+		for (size_t column = 0; column < blockColumnCount; ++column) {
+			const ULONG64* columnCorners = &columnCornerPointIndices[4 * column];
+			for (unsigned int coord = 0; coord < 3; ++coord) {
+				double sum = .0;
+				for (unsigned int corner = 0; corner < 4; ++corner) {
+					sum += topPoints[3 * columnCorners[corner] + coord] + bottomPoints[3 * columnCorners[corner] + coord];
+				}
+				cellCenters[3 * cellIndex + coord] = sum / 8;
+			}
+			++cellIndex;
+		}
+	}
+}
+
 void AbstractIjkGridRepresentation::getXyzPointsOfKInterfaceOfPatch(const unsigned int & kInterface, const unsigned int & patchIndex, double * xyzPoints)
 {
 	getXyzPointsOfKInterfaceSequenceOfPatch(kInterface, kInterface, patchIndex, xyzPoints);
@@ -960,6 +1459,7 @@ void AbstractIjkGridRepresentation::setEnabledCells(unsigned char* enabledCells)
 	boolArray->Values = soap_new_eml20__Hdf5Dataset(gsoapProxy2_0_1->soap, 1);
 	boolArray->Values->HdfProxy = hdfProxy->newResqmlReference();
 	boolArray->Values->PathInHdfFile = "/RESQML/" + gsoapProxy2_0_1->uuid + "/CellGeometryIsDefined";
+	enabledCellCount = (std::numeric_limits<ULONG64>::max)();
 
 	// HDF
 	hsize_t * cellGeometryIsDefinedCount = new hsize_t[3];
@@ -970,6 +1470,98 @@ void AbstractIjkGridRepresentation::setEnabledCells(unsigned char* enabledCells)
 	delete [] cellGeometryIsDefinedCount;
 }
 
+void AbstractIjkGridRepresentation::getEnabledCells(indexing::BitSet & enabledCells) const
+{
+	if (!hasEnabledCellInformation()) {
+		throw invalid_argument("The grid has no geometry or no information about enabled cells.");
+	}
+
+	gsoap_resqml2_0_1::resqml2__IjkGridGeometry* geom = static_cast<gsoap_resqml2_0_1::resqml2__IjkGridGeometry*>(getPointGeometry2_0_1(0));
+	const ULONG64 cellCount = getCellCount();
+	if (geom->CellGeometryIsDefined->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__BooleanHdf5Array) {
+		// Read and pack one K layer at a time in order not to unpack the whole mask in memory.
+		const std::string datasetName = static_cast<resqml2__BooleanHdf5Array*>(geom->CellGeometryIsDefined)->Values->PathInHdfFile;
+		const ULONG64 layerCellCount = static_cast<ULONG64>(getICellCount()) * getJCellCount();
+		const bool isLayered = hdfProxy->getDimensionCount(datasetName) == 3;
+		unsigned long long layerCount[3] = { 1, getJCellCount(), getICellCount() };
+		unsigned long long layerOffset[3] = { 0, 0, 0 };
+		if (!isLayered) {
+			layerCount[0] = layerCellCount;
+		}
+		enabledCells.resize(cellCount);
+		unsigned char* layer = new unsigned char[layerCellCount];
+		for (unsigned int k = 0; k < getKCellCount(); ++k) {
+			layerOffset[0] = isLayered ? k : k * layerCellCount;
+			hdfProxy->readArrayNdOfValues(datasetName, layer, layerCount, layerOffset, nullptr, nullptr, isLayered ? 3 : 1, H5T_NATIVE_UCHAR);
+			const ULONG64 layerStart = k * layerCellCount;
+			for (ULONG64 cell = 0; cell < layerCellCount; ++cell) {
+				if (layer[cell] != 0) {
+					enabledCells.set(layerStart + cell);
+				}
+			}
+		}
+		delete [] layer;
+	}
+	else if (geom->CellGeometryIsDefined->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__BooleanConstantArray) {
+		enabledCells.resize(cellCount, static_cast<resqml2__BooleanConstantArray*>(geom->CellGeometryIsDefined)->Value);
+	}
+	else
+		throw std::logic_error("Not yet implemented");
+
+	enabledCellCount = enabledCells.count();
+}
+
+void AbstractIjkGridRepresentation::setEnabledCells(const indexing::BitSet & enabledCells)
+{
+	gsoap_resqml2_0_1::resqml2__IjkGridGeometry* geom = static_cast<gsoap_resqml2_0_1::resqml2__IjkGridGeometry*>(getPointGeometry2_0_1(0));
+	if (geom == nullptr) {
+		throw invalid_argument("There is no geometry on this grid.");
+	}
+	if (enabledCells.size() != getCellCount()) {
+		throw invalid_argument("The enabled cell mask must have a size equal to the cell count of the grid.");
+	}
+
+	resqml2__BooleanHdf5Array* boolArray = soap_new_resqml2__BooleanHdf5Array(gsoapProxy2_0_1->soap, 1);
+	geom->CellGeometryIsDefined = boolArray;
+
+	boolArray->Values = soap_new_eml20__Hdf5Dataset(gsoapProxy2_0_1->soap, 1);
+	boolArray->Values->HdfProxy = hdfProxy->newResqmlReference();
+	boolArray->Values->PathInHdfFile = "/RESQML/" + gsoapProxy2_0_1->uuid + "/CellGeometryIsDefined";
+	enabledCellCount = enabledCells.count();
+
+	// HDF
+	unsigned long long cellGeometryIsDefinedCount[3] = { getKCellCount(), getJCellCount(), getICellCount() };
+	hdfProxy->createArrayNd(gsoapProxy2_0_1->uuid, "CellGeometryIsDefined", H5T_NATIVE_UCHAR, cellGeometryIsDefinedCount, 3);
+
+	const ULONG64 layerCellCount = static_cast<ULONG64>(getICellCount()) * getJCellCount();
+	unsigned char* layer = new unsigned char[layerCellCount];
+	unsigned long long slabCount[3] = { 1, getJCellCount(), getICellCount() };
+	unsigned long long slabOffset[3] = { 0, 0, 0 };
+	for (unsigned int k = 0; k < getKCellCount(); ++k) {
+		const ULONG64 layerStart = k * layerCellCount;
+		for (ULONG64 cell = 0; cell < layerCellCount; ++cell) {
+			layer[cell] = enabledCells.test(layerStart + cell) ? 1 : 0;
+		}
+		slabOffset[0] = k;
+		hdfProxy->writeArrayNdSlab(gsoapProxy2_0_1->uuid, "CellGeometryIsDefined", H5T_NATIVE_UCHAR, layer, slabCount, slabOffset, 3);
+	}
+	delete [] layer;
+}
+
+ULONG64 AbstractIjkGridRepresentation::getEnabledCellCount() const
+{
+	if (!hasEnabledCellInformation()) {
+		return getCellCount();
+	}
+
+	if (enabledCellCount == (std::numeric_limits<ULONG64>::max)()) {
+		// getEnabledCells stores the count once the mask is read
+		indexing::BitSet enabledCells;
+		getEnabledCells(enabledCells);
+	}
+	return enabledCellCount;
+}
+
 gsoap_resqml2_0_1::resqml2__KDirection AbstractIjkGridRepresentation::getKDirection() const
 {
 	gsoap_resqml2_0_1::resqml2__IjkGridGeometry* geom = static_cast<gsoap_resqml2_0_1::resqml2__IjkGridGeometry*>(getPointGeometry2_0_1(0));
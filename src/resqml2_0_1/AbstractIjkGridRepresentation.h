@@ -20,8 +20,15 @@ under the License.
 
 #include "resqml2/AbstractColumnLayerGridRepresentation.h"
 
+#include "common/GeometryCache.h"
+
+#include "tools/BitSet.h"
+
 #include <stdexcept>
 #include <map>
+#include <memory>
+#include <limits>
+#include <vector>
 
 namespace RESQML2_0_1_NS
 {
@@ -41,6 +48,12 @@ namespace RESQML2_0_1_NS
 				const unsigned int & iCount, const unsigned int & jCount, const unsigned int & kCount,
 				bool withTruncatedPillars);
 
+
+		/**
+		* Indicates if the split information has been loaded (and not unloaded) by the user.
+		*/
+		bool splitInformationLoaded;
+
 		class BlockInformation
 		{
 		public:
@@ -62,23 +75,88 @@ namespace RESQML2_0_1_NS
 			~BlockInformation() {}
 		};
 
+		/**
+		* Get the XYZ point indices (relative to the block XYZ points) of the 4 pillar corners of all columns of the current block.
+		* The template parameter allows to fully skip the split information lookup for grids without any split coordinate line.
+		* @param columnCornerPointIndices	Output vector of 4 indices per column of the block. Columns are ordered i then j and corners follow the getXyzPointOfBlockFromCellCorner ordering (0 to 3).
+		*/
+		template <bool withSplitCoordinateLines> void getXyzPointIndicesOfBlockColumnCorners(std::vector<ULONG64> & columnCornerPointIndices) const;
+
+		/**
+		* Get the XYZ point indices (relative to the block XYZ points) of the 4 pillar corners of all columns of the current block
+		* dispatching to the right specialization according to the presence of split coordinate lines.
+		*/
+		void getXyzPointIndicesOfBlockColumnCorners(std::vector<ULONG64> & columnCornerPointIndices) const;
+
 	protected :
 
 		/**
 		* Creates an instance of this class by wrapping a gsoap instance.
 		*/
-		AbstractIjkGridRepresentation(gsoap_resqml2_0_1::_resqml2__IjkGridRepresentation* fromGsoap) : AbstractColumnLayerGridRepresentation(fromGsoap, false), splitInformation(nullptr), blockInformation(nullptr) {}
-		AbstractIjkGridRepresentation(gsoap_resqml2_0_1::_resqml2__TruncatedIjkGridRepresentation* fromGsoap) : AbstractColumnLayerGridRepresentation(fromGsoap, true), splitInformation(nullptr), blockInformation(nullptr) {}
+		AbstractIjkGridRepresentation(gsoap_resqml2_0_1::_resqml2__IjkGridRepresentation* fromGsoap) : AbstractColumnLayerGridRepresentation(fromGsoap, false), splitInformationLoaded(false), blockInformation(nullptr), enabledCellCount((std::numeric_limits<ULONG64>::max)()) {}
+		AbstractIjkGridRepresentation(gsoap_resqml2_0_1::_resqml2__TruncatedIjkGridRepresentation* fromGsoap) : AbstractColumnLayerGridRepresentation(fromGsoap, true), splitInformationLoaded(false), blockInformation(nullptr), enabledCellCount((std::numeric_limits<ULONG64>::max)()) {}
 
 		gsoap_resqml2_0_1::_resqml2__IjkGridRepresentation* getSpecializedGsoapProxy() const;
 		gsoap_resqml2_0_1::_resqml2__TruncatedIjkGridRepresentation* getSpecializedTruncatedGsoapProxy() const;
 
 		gsoap_resqml2_0_1::resqml2__PointGeometry* getPointGeometry2_0_1(const unsigned int & patchIndex) const;
 
-		std::vector< std::pair< unsigned int, std::vector<unsigned int> > >* splitInformation;
+		/**
+		* Read the values of the nodes of the current block from a dataset indexed by K interface and then by coordinate line.
+		* Only the K interfaces, pillars and split coordinate lines of the block are selected in the dataset so that memory and IO are proportional to the block size.
+		* Block information must be loaded.
+		* @param datasetName		The dataset whose dimensions are either {K interface, J pillar, I pillar} (no split coordinate line)
+		*							or {K interface, pillar and then split coordinate line}, optionally followed by a dimension of valueCountPerNode values.
+		* @param values				It must be preallocated with valueCountPerNode * getXyzPointCountOfBlock() values.
+		* @param valueCountPerNode	3 for XYZ points, 1 for parameters.
+		*/
+		void readBlockOfNodeDataset(const std::string & datasetName, double * values, const unsigned int & valueCountPerNode) const;
+
+		/**
+		* The split coordinate lines of each pillar, owned by the geometry cache of the EPC document.
+		* For each pillar, it gives the index of each of its split coordinate lines and the columns each of them is adjacent to.
+		*/
+		class SplitInformation : public COMMON_NS::GeometryCache::Entry
+		{
+		public:
+			std::vector< std::pair< unsigned int, std::vector<unsigned int> > >* splitCoordinateLinesOfPillars;
+			unsigned int pillarCount;
+
+			SplitInformation(const unsigned int & pillarCount) :
+				splitCoordinateLinesOfPillars(new std::vector< std::pair< unsigned int, std::vector<unsigned int> > >[pillarCount]), pillarCount(pillarCount) {}
+
+			~SplitInformation() { delete[] splitCoordinateLinesOfPillars; }
+
+			unsigned long long getByteSize() const;
+		};
+
+		/**
+		* Read the split information from the HDF5 datasets.
+		*/
+		SplitInformation* readSplitInformation() const;
+
+		/**
+		* Get the split information of this grid from the geometry cache of its EPC document.
+		* It is transparently reloaded if it has been evicted from the cache since it has been loaded.
+		* The cache is only looked up when the split information has been evicted : a weak pointer to it is kept meanwhile.
+		* The returned pointer pins the split information : keep it while using its content.
+		* @return An empty pointer if the split information has not been loaded.
+		*/
+		std::shared_ptr<SplitInformation> getSplitInformation() const;
+
+		/**
+		* The split information of the geometry cache, which expires when it is evicted from the cache.
+		*/
+		mutable std::weak_ptr<SplitInformation> cachedSplitInformation;
 
 		BlockInformation* blockInformation;
 
+		/**
+		* The count of enabled cells, known once the enabled cell mask has been read or written.
+		* std::numeric_limits<ULONG64>::max() means that it is not known yet.
+		*/
+		mutable ULONG64 enabledCellCount;
+
 	public:
 
 		enum geometryKind { UNKNOWN = 0, EXPLICIT = 1, PARAMETRIC = 2, LATTICE = 3, NO_GEOMETRY = 4}; // UNKNOWN exists in case of partial transfer
@@ -101,17 +179,19 @@ namespace RESQML2_0_1_NS
 		*/
 		AbstractIjkGridRepresentation(gsoap_resqml2_0_1::eml20__DataObjectReference* partialObject,
 			bool withTruncatedPillars = false) :
-			AbstractColumnLayerGridRepresentation(nullptr, partialObject, withTruncatedPillars), splitInformation(nullptr), blockInformation(nullptr)
+			AbstractColumnLayerGridRepresentation(nullptr, partialObject, withTruncatedPillars), splitInformationLoaded(false), blockInformation(nullptr), enabledCellCount((std::numeric_limits<ULONG64>::max)())
 		{
 		}
 
 		/**
-		* Destructor does nothing since the memory is managed by the gsoap context.
+		* Destructor only deletes the block information and releases the cached geometry since the memory is managed by the gsoap context.
 		*/
 		virtual ~AbstractIjkGridRepresentation() 
 		{
 			if (blockInformation != nullptr)
 				delete blockInformation;
+			if (getEpcDocument() != nullptr)
+				getEpcDocument()->getGeometryCache()->releaseAll(this);
 		}
 
 		/**
@@ -151,7 +231,7 @@ namespace RESQML2_0_1_NS
 
 		/**
 		* Get the count of faces in the grid
-		* This method requires you have already loaded the split information.
+		* This method requires you have already loaded the split information unless the grid has arithmetic node indexing.
 		*/
 		unsigned int getFaceCount() const;
 
@@ -243,14 +323,39 @@ namespace RESQML2_0_1_NS
 		 */
 		void setEnabledCells(unsigned char* enabledCells);
 
+		/**
+		 * Get the information on the dead/invisible cells as a bit packed mask (one bit per cell instead of one byte).
+		 * The bits follow the index ordering i then j then k. A set bit means that the corresponding cell is enabled.
+		 * The returned mask allows to go from a global cell index to an active cell index (rank) and conversely (select)
+		 * and to compact property values to the enabled cells only.
+		 * @param	enabledCells	It is resized to the cell count of the ijk grid.
+		 */
+		void getEnabledCells(indexing::BitSet & enabledCells) const;
+
+		/**
+		 * Set the information on the dead/invisible cells from a bit packed mask. The geometry of the grid must have been defined yet.
+		 * The bits must follow the index ordering i then j then k. A set bit means that the corresponding cell is enabled.
+		 * The mask is written K layer by K layer in order not to unpack it entirely in memory.
+		 */
+		void setEnabledCells(const indexing::BitSet & enabledCells);
+
+		/**
+		 * Get the count of enabled cells.
+		 * It returns the cell count if the grid has no information about enabled cells.
+		 * The mask is only read once : the count is then kept until the enabled cells are set again.
+		 */
+		ULONG64 getEnabledCellCount() const;
+
 		/**
 		* Load the split information into memory to speed up processes.
-		* Be aware that you must unload by yourself this memory.
+		* This memory is owned by the geometry cache of the EPC document : it is transparently reloaded if the cache evicts it because of its memory budget.
+		* Be aware that you must unload it by yourself when you no longer need it.
 		*/
 		void loadSplitInformation();
 
 		/**
 		 * Load the block information into memory to speed up the processes and make easier block geometry handling for the user.
+		 * The split information must have been loaded first unless the grid has arithmetic node indexing.
 		 * @param iCellStart	The starting I cell index of the block taken from zero to iCellCount - 1.
 		 * @param iCellEnd		The ending I cell index of the block taken from zero to iCellCount - 1.
 		 * @param jCellStart	The starting J cell index of the block taken from zero to jCellCount - 1.
@@ -267,7 +372,7 @@ namespace RESQML2_0_1_NS
 
 		/**
 		* Check either a column edge is splitted or not.
-		* This method requires you have already loaded the split information.
+		* This method requires you have already loaded the split information unless the grid has arithmetic node indexing.
 		* @param iColumn	The I index of the column
 		* @param jColumn	The J index of the column
 		* @param edge		0 for edge from i to i+1, lower j connection
@@ -277,9 +382,32 @@ namespace RESQML2_0_1_NS
 		*/
 		bool isColumnEdgeSplitted(const unsigned int & iColumn, const unsigned int & jColumn, const unsigned int & edge) const;
 
+		/**
+		* Get the pairs of cell faces which are juxtaposed across the split column edges (i.e. the faults) of the grid.
+		* Only the column edges around the pillars of the split coordinate lines are visited and only the XYZ points of the columns around them are read,
+		* block by block (see loadBlockInformation). The current block information is restored at the end.
+		* The faces of both columns of each split column edge are swept along the pillars at the same time which makes the cost linear in the count of faulted faces.
+		* The faces are compared by their extent along the axes of the pillars, so the pillars can be vertical, tilted or even horizontal.
+		* Collapsed faces (zero thickness on both pillars) are ignored. Faces which only touch each other are not connected. Connections to disabled cells are ignored.
+		* This method requires you have already loaded the split information.
+		* @param cellIndexPairs					Filled with the cell index pairs of the connections.
+		* @param localFacePerCellIndexPairs	Filled with the local faces (3 for I+, 5 for I-, 4 for J+ and 2 for J-) of the connections.
+		*/
+		void getFaultConnections(std::vector<ULONG64> & cellIndexPairs, std::vector<int> & localFacePerCellIndexPairs);
+
+		/**
+		* Create a grid connection set representation which contains all the fault connections of the grid (see getFaultConnections).
+		* This method requires you have already loaded the split information.
+		* @param guid	The guid to set to the grid connection set. If empty then a new guid will be generated.
+		* @param title	A title for the grid connection set.
+		* @param proxy	The HDF proxy where the cell index pairs and the local faces are going to be stored.
+		* @return		The created grid connection set or null if the grid has no fault connection.
+		*/
+		RESQML2_NS::GridConnectionSetRepresentation* createFaultGridConnectionSet(const std::string & guid, const std::string & title, COMMON_NS::AbstractHdfProxy* proxy);
+
 		/**
 		* Get the XYZ point index in the HDF dataset from the corner of a cell.
-		* This method requires your have already loaded the split information.
+		* This method requires your have already loaded the split information unless the grid has arithmetic node indexing.
 		* @param iCell	The I index of the cell
 		* @param jCell	The J index of the cell
 		* @param kCell	The K index of the cell
@@ -296,6 +424,17 @@ namespace RESQML2_0_1_NS
 		*/
 		ULONG64 getXyzPointIndexFromCellCorner(const unsigned int & iCell, const unsigned int & jCell, const unsigned int & kCell, const unsigned int & corner) const;
 
+		/**
+		* Get the XYZ point indices of the 8 corners of a cell.
+		* It is faster than calling getXyzPointIndexFromCellCorner for each corner since the split information and the pillars of the cell column are only looked up once.
+		* The split information must have been loaded first unless the grid has an arithmetic node indexing.
+		* @param iCell					The I index of the cell.
+		* @param jCell					The J index of the cell.
+		* @param kCell					The K index of the cell.
+		* @param cornerPointIndices		It must be preallocated with a size of 8. Corners follow the getXyzPointIndexFromCellCorner ordering.
+		*/
+		void getXyzPointIndicesOfCellCorners(const unsigned int & iCell, const unsigned int & jCell, const unsigned int & kCell, ULONG64 * cornerPointIndices) const;
+
 		/**
 		* Gets the x, y and z values of the corner of a cell of a given block.
 		* This method requires your have already both loaded the block information and get the geometry of the block thanks to getXyzPointsOfBlockOfPatch.
@@ -329,6 +468,34 @@ namespace RESQML2_0_1_NS
 		 */
 		ULONG64 getXyzPointCountOfBlock() const;
 
+		/**
+		 * Get the cell count of the current block. Block information must be loaded.
+		 */
+		ULONG64 getCellCountOfBlock() const;
+
+		/**
+		* Indicates if the node indexing of this grid is purely arithmetic i.e. if the grid is a lattice or if it has no split coordinate line (unfaulted grid).
+		* In such a case, the split information does not need to be loaded for node indexing and block handling.
+		*/
+		bool hasArithmeticNodeIndexing() const;
+
+		/**
+		* Get the XYZ point indices (relative to the block XYZ points) of the 8 corners of all cells of the current block.
+		* It is much faster than calling getXyzPointOfBlockFromCellCorner for each corner of each cell since the split information is only looked up once per column
+		* and not at all for grids with arithmetic node indexing.
+		* Block information must be loaded.
+		* @param cornerPointIndices	It must be preallocated with a size of 8 * getCellCountOfBlock(). Cells are ordered i then j then k and corners follow the getXyzPointOfBlockFromCellCorner ordering.
+		*/
+		void getXyzPointIndicesOfBlockCellCorners(ULONG64 * cornerPointIndices) const;
+
+		/**
+		* Get the centers (mean of the 8 corners) of all cells of the current block.
+		* Block information must be loaded.
+		* @param xyzPoints		The XYZ points of the block (resulting from a call to getXyzPointsOfBlockOfPatch).
+		* @param cellCenters	It must be preallocated with a size of 3 * getCellCountOfBlock(). Cells are ordered i then j then k.
+		*/
+		void getCellCentersOfBlock(const double * xyzPoints, double * cellCenters) const;
+
 		/**
 		* Get all the XYZ points of a particular K interface of a particular patch of this representation.
 		* XYZ points are given in the local CRS.
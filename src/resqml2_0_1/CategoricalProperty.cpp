@@ -23,6 +23,7 @@ under the License.
 
 #include "hdf5.h"
 
+#include "tools/Statistics.h"
 #include "resqml2/AbstractRepresentation.h"
 #include "resqml2_0_1/PropertyKind.h"
 #include "resqml2_0_1/StringTableLookup.h"
@@ -137,6 +138,27 @@ void CategoricalProperty::pushBackLongHdf5ArrayOfValues(const long * values, uns
 		numValues, numDimensionsInArray);
 }
 
+RESQML2_NS::AbstractValuesProperty::hdfDatatypeEnum CategoricalProperty::pushBackCompactLongHdf5ArrayOfValues(const long * values, unsigned long long * numValues, const unsigned int & numDimensionsInArray, COMMON_NS::AbstractHdfProxy* proxy,
+	const long & nullValue)
+{
+	ULONG64 numTotalValues = numValues[0];
+	for (unsigned int dim = 1; dim < numDimensionsInArray; ++dim) {
+		numTotalValues *= numValues[dim];
+	}
+
+	statistics::Accumulator<long> accumulator(nullValue);
+	accumulator.add(values, numTotalValues);
+	LONG64 narrowedNullValue = nullValue;
+	const hdfDatatypeEnum datatype = accumulator.getValidCount() > 0
+		? getNarrowestIntegerDatatype(accumulator.getMinimum(), accumulator.getMaximum(), narrowedNullValue)
+		: getNarrowestIntegerDatatype(1, 0, narrowedNullValue);
+
+	const string datasetName = pushBackRefToExistingDataset(proxy, "", narrowedNullValue);
+	writeNarrowedLongValues(datasetName, values, numValues, numDimensionsInArray, nullValue, narrowedNullValue, datatype, proxy);
+
+	return datatype;
+}
+
 void CategoricalProperty::pushBackUShortHdf5Array1dOfValues(const unsigned short * values, const ULONG64 & valueCount, COMMON_NS::AbstractHdfProxy * proxy, const long & nullValue)
 {
 	hsize_t valueCountPerDimension[3] = { valueCount };
@@ -146,6 +146,14 @@ namespace RESQML2_0_1_NS
 		*/
 		void pushBackUShortHdf5ArrayOfValues(const unsigned short * values, unsigned long long * numValues, const unsigned int & numDimensionsInArray, COMMON_NS::AbstractHdfProxy* proxy, const unsigned short & nullValue);
 
+		/**
+		* Add an array (potentially multi dimensions) of long values to the property values which will be stored in the narrowest integer datatype able to store them.
+		* The values are read back (and widened) with the usual getters such as getLongValuesOfPatch or getIntValuesOfPatch.
+		* @param nullValue				The null value of the values. If it does not fit in the narrowest datatype, the null values are stored with another value which is out of the range of the values (see getNullValueOfPatch).
+		* @return						The datatype of the values in the HDF file.
+		*/
+		hdfDatatypeEnum pushBackCompactLongHdf5ArrayOfValues(const long * values, unsigned long long * numValues, const unsigned int & numDimensionsInArray, COMMON_NS::AbstractHdfProxy* proxy, const long & nullValue);
+
 		std::string pushBackRefToExistingDataset(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & dataset = "", const long & nullValue = (std::numeric_limits<long>::max)());
 
 		/**
@@ -20,6 +20,7 @@ under the License.
 
 #include <limits>
 #include <sstream>
+#include <vector>
 
 #include "hdf5.h"
 
@@ -27,10 +28,211 @@ under the License.
 #include "resqml2_0_1/PropertyKind.h"
 #include "common/AbstractHdfProxy.h"
 
+#include "tools/Parallel.h"
+
 using namespace std;
 using namespace RESQML2_0_1_NS;
 using namespace gsoap_resqml2_0_1;
 
+namespace {
+	/**
+	* Convert a float to the bits of an IEEE 754 half float, rounding to the nearest even value.
+	* Overflowing values become infinite and NaN values stay NaN.
+	*/
+	unsigned short floatToHalf(const float & value)
+	{
+		union { float f; uint32_t u; } bits;
+		bits.f = value;
+		const uint32_t sign = bits.u & 0x80000000u;
+		bits.u ^= sign;
+
+		unsigned short result;
+		if (bits.u >= (127u + 16u) << 23) { // Overflow, infinite or NaN
+			result = bits.u > 255u << 23 ? 0x7e00 : 0x7c00;
+		}
+		else if (bits.u < 113u << 23) { // Subnormal or zero : let the floating point unit round the mantissa
+			union { float f; uint32_t u; } denormMagic;
+			denormMagic.u = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+			bits.f += denormMagic.f;
+			result = static_cast<unsigned short>(bits.u - denormMagic.u);
+		}
+		else {
+			const uint32_t isMantissaOdd = (bits.u >> 13) & 1;
+			bits.u += (static_cast<uint32_t>(15 - 127) << 23) + 0xfff + isMantissaOdd;
+			result = static_cast<unsigned short>(bits.u >> 13);
+		}
+
+		return result | static_cast<unsigned short>(sign >> 16);
+	}
+
+	/**
+	* Create the HDF5 datatype of IEEE 754 little endian half floats. It must be closed by the caller.
+	*/
+	hid_t createHalfFloatDatatype()
+	{
+		hid_t result = H5Tcopy(H5T_IEEE_F32LE);
+		H5Tset_fields(result, 15, 10, 5, 0, 10);
+		H5Tset_offset(result, 0);
+		H5Tset_precision(result, 16);
+		H5Tset_size(result, 2);
+		H5Tset_ebias(result, 15);
+		return result;
+	}
+
+	/**
+	* Quantize some values into unsigned integer codes. NaN values are encoded with nanCode.
+	*/
+	template <class T> void quantize(const double * values, const ULONG64 & valueCount, const double & scale, const double & offset, const T & nanCode, T * codes)
+	{
+		const double inverseScale = 1.0 / scale;
+		for (ULONG64 i = 0; i < valueCount; ++i) {
+			const double code = (values[i] - offset) * inverseScale + 0.5;
+			codes[i] = values[i] == values[i] ? static_cast<T>(code < 0 ? 0 : (code > nanCode - 1 ? nanCode - 1 : code)) : nanCode;
+		}
+	}
+
+	/**
+	* The quantities which are measured by the units of measure of the conversion table.
+	* Keep the documentation of ContinuousProperty::getUomConversion in line with them.
+	*/
+	enum quantityEnum { LENGTH = 0, AREA, VOLUME, PRESSURE, PRESSURE_GRADIENT, TEMPERATURE, TIME, SLOWNESS, VELOCITY, MASS, DENSITY, VISCOSITY, ANGLE, RATIO };
+
+	/**
+	* The conversion of a unit of measure into the SI unit of its quantity : siValue = value * scale + offset.
+	*/
+	struct UomConversion
+	{
+		gsoap_resqml2_0_1::resqml2__ResqmlUom uom;
+		quantityEnum quantity;
+		double scale;
+		double offset;
+	};
+
+	const UomConversion uomConversions[] = {
+		{ resqml2__ResqmlUom__m, LENGTH, 1, 0 },
+		{ resqml2__ResqmlUom__cm, LENGTH, 0.01, 0 },
+		{ resqml2__ResqmlUom__mm, LENGTH, 0.001, 0 },
+		{ resqml2__ResqmlUom__km, LENGTH, 1000, 0 },
+		{ resqml2__ResqmlUom__ft, LENGTH, 0.3048, 0 },
+		{ resqml2__ResqmlUom__ft_x005bUS_x005d, LENGTH, 1200.0 / 3937.0, 0 },
+		{ resqml2__ResqmlUom__in, LENGTH, 0.0254, 0 },
+		{ resqml2__ResqmlUom__yd, LENGTH, 0.9144, 0 },
+		{ resqml2__ResqmlUom__mi, LENGTH, 1609.344, 0 },
+		{ resqml2__ResqmlUom__m2, AREA, 1, 0 },
+		{ resqml2__ResqmlUom__mm2, AREA, 1e-6, 0 },
+		{ resqml2__ResqmlUom__cm2, AREA, 1e-4, 0 },
+		{ resqml2__ResqmlUom__km2, AREA, 1e6, 0 },
+		{ resqml2__ResqmlUom__in2, AREA, 0.00064516, 0 },
+		{ resqml2__ResqmlUom__ft2, AREA, 0.09290304, 0 },
+		{ resqml2__ResqmlUom__mi2, AREA, 2589988.110336, 0 },
+		{ resqml2__ResqmlUom__acre, AREA, 4046.8564224, 0 },
+		{ resqml2__ResqmlUom__ha, AREA, 1e4, 0 },
+		{ resqml2__ResqmlUom__um2, AREA, 1e-12, 0 },
+		{ resqml2__ResqmlUom__D, AREA, 9.869233e-13, 0 },
+		{ resqml2__ResqmlUom__D_x005bAPI_x005d, AREA, 9.869233e-13, 0 },
+		{ resqml2__ResqmlUom__mD, AREA, 9.869233e-16, 0 },
+		{ resqml2__ResqmlUom__m3, VOLUME, 1, 0 },
+		{ resqml2__ResqmlUom__cm3, VOLUME, 1e-6, 0 },
+		{ resqml2__ResqmlUom__L, VOLUME, 0.001, 0 },
+		{ resqml2__ResqmlUom__ft3, VOLUME, 0.028316846592, 0 },
+		{ resqml2__ResqmlUom__bbl, VOLUME, 0.158987294928, 0 },
+		{ resqml2__ResqmlUom__Pa, PRESSURE, 1, 0 },
+		{ resqml2__ResqmlUom__kPa, PRESSURE, 1e3, 0 },
+		{ resqml2__ResqmlUom__MPa, PRESSURE, 1e6, 0 },
+		{ resqml2__ResqmlUom__GPa, PRESSURE, 1e9, 0 },
+		{ resqml2__ResqmlUom__mbar, PRESSURE, 100, 0 },
+		{ resqml2__ResqmlUom__bar, PRESSURE, 1e5, 0 },
+		{ resqml2__ResqmlUom__atm, PRESSURE, 101325, 0 },
+		{ resqml2__ResqmlUom__psi, PRESSURE, 6894.757293168361, 0 },
+		{ resqml2__ResqmlUom__kPa_x002fm, PRESSURE_GRADIENT, 1e3, 0 },
+		{ resqml2__ResqmlUom__bar_x002fm, PRESSURE_GRADIENT, 1e5, 0 },
+		{ resqml2__ResqmlUom__psi_x002fft, PRESSURE_GRADIENT, 6894.757293168361 / 0.3048, 0 },
+		{ resqml2__ResqmlUom__K, TEMPERATURE, 1, 0 },
+		{ resqml2__ResqmlUom__degC, TEMPERATURE, 1, 273.15 },
+		{ resqml2__ResqmlUom__degF, TEMPERATURE, 5.0 / 9.0, 273.15 - 32 * 5.0 / 9.0 },
+		{ resqml2__ResqmlUom__degR, TEMPERATURE, 5.0 / 9.0, 0 },
+		{ resqml2__ResqmlUom__s, TIME, 1, 0 },
+		{ resqml2__ResqmlUom__ms, TIME, 0.001, 0 },
+		{ resqml2__ResqmlUom__h, TIME, 3600, 0 },
+		{ resqml2__ResqmlUom__d, TIME, 86400, 0 },
+		{ resqml2__ResqmlUom__a, TIME, 31557600, 0 },
+		{ resqml2__ResqmlUom__ms_x002fm, SLOWNESS, 0.001, 0 },
+		{ resqml2__ResqmlUom__us_x002fm, SLOWNESS, 1e-6, 0 },
+		{ resqml2__ResqmlUom__us_x002fft, SLOWNESS, 1e-6 / 0.3048, 0 },
+		{ resqml2__ResqmlUom__m_x002fs, VELOCITY, 1, 0 },
+		{ resqml2__ResqmlUom__km_x002fs, VELOCITY, 1000, 0 },
+		{ resqml2__ResqmlUom__ft_x002fs, VELOCITY, 0.3048, 0 },
+		{ resqml2__ResqmlUom__kg, MASS, 1, 0 },
+		{ resqml2__ResqmlUom__g, MASS, 0.001, 0 },
+		{ resqml2__ResqmlUom__lbm, MASS, 0.45359237, 0 },
+		{ resqml2__ResqmlUom__kg_x002fm3, DENSITY, 1, 0 },
+		{ resqml2__ResqmlUom__g_x002fcm3, DENSITY, 1000, 0 },
+		{ resqml2__ResqmlUom__kg_x002fL, DENSITY, 1000, 0 },
+		{ resqml2__ResqmlUom__lbm_x002fft3, DENSITY, 0.45359237 / 0.028316846592, 0 },
+		{ resqml2__ResqmlUom__Pa_x002es, VISCOSITY, 1, 0 },
+		{ resqml2__ResqmlUom__cP, VISCOSITY, 0.001, 0 },
+		{ resqml2__ResqmlUom__rad, ANGLE, 1, 0 },
+		{ resqml2__ResqmlUom__dega, ANGLE, 3.14159265358979323846 / 180, 0 },
+		{ resqml2__ResqmlUom__Euc, RATIO, 1, 0 },
+		{ resqml2__ResqmlUom___x0025, RATIO, 0.01, 0 }
+	};
+
+	/**
+	* Index the conversion table by the value of the unit of measure enumeration.
+	* The index ends with the greatest unit of the table and units without conversion are indexed to nullptr.
+	*/
+	std::vector<const UomConversion*> indexUomConversions()
+	{
+		const size_t conversionCount = sizeof(uomConversions) / sizeof(uomConversions[0]);
+		size_t indexSize = 0;
+		for (size_t i = 0; i < conversionCount; ++i) {
+			if (static_cast<size_t>(uomConversions[i].uom) >= indexSize) {
+				indexSize = static_cast<size_t>(uomConversions[i].uom) + 1;
+			}
+		}
+
+		std::vector<const UomConversion*> result(indexSize, nullptr);
+		for (size_t i = 0; i < conversionCount; ++i) {
+			result[uomConversions[i].uom] = &uomConversions[i];
+		}
+		return result;
+	}
+
+	// Built once at load time so that lookups are constant time and thread safe.
+	const std::vector<const UomConversion*> uomConversionIndex = indexUomConversions();
+
+	/**
+	* @return The conversion of a unit of measure into the SI unit of its quantity or nullptr if the unit is not in the conversion table.
+	*/
+	const UomConversion* getUomConversionToSi(const gsoap_resqml2_0_1::resqml2__ResqmlUom & uom)
+	{
+		const size_t index = static_cast<size_t>(uom);
+		return index < uomConversionIndex.size() ? uomConversionIndex[index] : nullptr;
+	}
+
+	/**
+	* Get the conversion between two units of measure (see ContinuousProperty::getUomConversion).
+	* Throw an invalid_argument exception naming the unit which is not in the conversion table or both units if they do not measure the same quantity.
+	*/
+	void getUomConversionOrThrow(soap* s, const gsoap_resqml2_0_1::resqml2__ResqmlUom & sourceUom, const gsoap_resqml2_0_1::resqml2__ResqmlUom & targetUom,
+		double & scale, double & offset)
+	{
+		if (ContinuousProperty::getUomConversion(sourceUom, targetUom, scale, offset)) {
+			return;
+		}
+
+		const std::string sourceName = soap_resqml2__ResqmlUom2s(s, sourceUom);
+		const std::string targetName = soap_resqml2__ResqmlUom2s(s, targetUom);
+		if (getUomConversionToSi(sourceUom) == nullptr) {
+			throw invalid_argument("The unit of measure " + sourceName + " is not supported by the unit conversions (see ContinuousProperty::getUomConversion).");
+		}
+		if (getUomConversionToSi(targetUom) == nullptr) {
+			throw invalid_argument("The unit of measure " + targetName + " is not supported by the unit conversions (see ContinuousProperty::getUomConversion).");
+		}
+		throw invalid_argument("The unit of measure " + sourceName + " cannot be converted into " + targetName + " because they do not measure the same quantity.");
+	}
+}
+
 const char* ContinuousProperty::XML_TAG = "ContinuousProperty";
 
 void ContinuousProperty::init(RESQML2_NS::AbstractRepresentation * rep, const std::string & guid, const std::string & title,
@@ -155,7 +357,8 @@ void ContinuousProperty::pushBackDoubleHdf5ArrayOfValues(const double * values,
 	double * minimumValue, double * maximumValue)
 {
 	const string datasetName = pushBackRefToExistingDataset(proxy, "");
-	setPropertyMinMax(values, numValues, numArrayDimensions, minimumValue, maximumValue);
+	std::vector<double> chunkSummary;
+	setPropertyMinMax(values, numValues, numArrayDimensions, minimumValue, maximumValue, &chunkSummary);
 
 	// HDF
 	proxy->writeArrayNd(gsoapProxy2_0_1->uuid,
@@ -163,6 +366,258 @@ void ContinuousProperty::pushBackDoubleHdf5ArrayOfValues(const double * values,
 		H5T_NATIVE_DOUBLE,
 		values,
 		numValues, numArrayDimensions);
+	writeChunkSummaryDataset(datasetName, chunkSummary, getChunkSummaryValueCount(numValues, numArrayDimensions), proxy);
+}
+
+void ContinuousProperty::pushBackDoubleHdf5ArrayOfValues(const double * values, unsigned long long * numValues, const unsigned int & numArrayDimensions, COMMON_NS::AbstractHdfProxy* proxy,
+	const std::vector< statistics::Accumulator<double> > & accumulators, const std::vector<double> & chunkSummary)
+{
+	const string datasetName = pushBackRefToExistingDataset(proxy, "");
+	setPropertyMinMax(accumulators);
+
+	// HDF
+	proxy->writeArrayNd(gsoapProxy2_0_1->uuid,
+		datasetName,
+		H5T_NATIVE_DOUBLE,
+		values,
+		numValues, numArrayDimensions);
+	writeChunkSummaryDataset(datasetName, chunkSummary, getChunkSummaryValueCount(numValues, numArrayDimensions), proxy);
+}
+
+void ContinuousProperty::ProductKernel::compute(const std::vector<const double *> & inputs, const ULONG64 & valueCount, double * outputs)
+{
+	for (ULONG64 i = 0; i < valueCount; ++i) {
+		outputs[i] = 1;
+	}
+	for (size_t inputIndex = 0; inputIndex < inputs.size(); ++inputIndex) {
+		const double * input = inputs[inputIndex];
+		for (ULONG64 i = 0; i < valueCount; ++i) {
+			outputs[i] *= input[i];
+		}
+	}
+}
+
+void ContinuousProperty::pushBackDerivedDoubleHdf5ArrayOfValues(const std::vector<RESQML2_NS::AbstractValuesProperty*> & inputs, const unsigned int & patchIndex,
+	DerivationKernel & kernel, COMMON_NS::AbstractHdfProxy* proxy, const ULONG64 & maxChunkValueCount)
+{
+	if (inputs.empty()) {
+		throw invalid_argument("A derived property needs at least one input property.");
+	}
+
+	std::vector<unsigned long long> dimensions = inputs[0]->getValuesCountPerDimensionOfPatch(patchIndex);
+	for (size_t inputIndex = 1; inputIndex < inputs.size(); ++inputIndex) {
+		if (inputs[inputIndex]->getValuesCountPerDimensionOfPatch(patchIndex) != dimensions) {
+			throw invalid_argument("The input properties of a derived property must have the same dimensions.");
+		}
+	}
+	if (dimensions.empty()) {
+		throw invalid_argument("The input properties of a derived property must have at least one dimension.");
+	}
+	const unsigned int dimensionCount = static_cast<unsigned int>(dimensions.size());
+	ULONG64 slabValueCount = 1;
+	for (unsigned int dim = 1; dim < dimensionCount; ++dim) {
+		slabValueCount *= dimensions[dim];
+	}
+	// An empty slab makes the whole patch empty : the dataset is created but there is nothing to stream.
+	const ULONG64 slabCount = slabValueCount > 0 ? dimensions[0] : 0;
+	ULONG64 slabCountPerChunk = slabValueCount > 0 && maxChunkValueCount / slabValueCount > 0 ? maxChunkValueCount / slabValueCount : 1;
+	// The chunks of the summary are the slabs of a multidimensional patch. A 1d patch is streamed by whole chunks of the summary.
+	const bool withChunkSummary = areChunkSummariesEnabled();
+	if (withChunkSummary && dimensionCount == 1) {
+		const ULONG64 summaryChunkValueCount = getChunkSummaryValueCount(&dimensions[0], dimensionCount);
+		slabCountPerChunk = slabCountPerChunk < summaryChunkValueCount ? summaryChunkValueCount : slabCountPerChunk - slabCountPerChunk % summaryChunkValueCount;
+	}
+
+	const string datasetName = pushBackRefToExistingDataset(proxy, "");
+	proxy->createArrayNd(gsoapProxy2_0_1->uuid, datasetName, H5T_NATIVE_DOUBLE, &dimensions[0], dimensionCount);
+
+	_resqml2__ContinuousProperty* prop = static_cast<_resqml2__ContinuousProperty*>(gsoapProxy2_0_1);
+	std::vector< statistics::Accumulator<double> > accumulators(prop->Count);
+	std::vector< statistics::Accumulator<double> > chunkAccumulators;
+	std::vector<double> summary;
+	std::vector<double> chunkSummary;
+	std::vector< std::vector<double> > inputValues(inputs.size());
+	std::vector<double> outputValues;
+	std::vector<unsigned long long> counts(dimensions);
+	std::vector<unsigned long long> offsets(dimensionCount, 0);
+	for (ULONG64 slabIndex = 0; slabIndex < slabCount; slabIndex += slabCountPerChunk) {
+		counts[0] = slabCount - slabIndex < slabCountPerChunk ? slabCount - slabIndex : slabCountPerChunk;
+		offsets[0] = slabIndex;
+		const ULONG64 chunkValueCount = counts[0] * slabValueCount;
+
+		// HDF5 reads and writes stay on the calling thread.
+		for (size_t inputIndex = 0; inputIndex < inputs.size(); ++inputIndex) {
+			inputValues[inputIndex].resize(chunkValueCount);
+			inputs[inputIndex]->getDoubleValuesOfHyperslabOfPatch(patchIndex, &inputValues[inputIndex][0], &counts[0], &offsets[0], nullptr, dimensionCount);
+		}
+		outputValues.resize(chunkValueCount);
+
+		// The values of the chunk are split in ranges which are derived concurrently.
+		parallel::forEachRange(chunkValueCount, 65536, [&](const unsigned int &, const uint64_t & begin, const uint64_t & end) {
+			std::vector<const double *> rangeInputs(inputs.size());
+			for (size_t inputIndex = 0; inputIndex < inputs.size(); ++inputIndex) {
+				rangeInputs[inputIndex] = &inputValues[inputIndex][0] + begin;
+			}
+			kernel.compute(rangeInputs, end - begin, &outputValues[0] + begin);
+		});
+
+		computeStatistics(&outputValues[0], &counts[0], dimensionCount, prop->Count, numeric_limits<double>::quiet_NaN(), withChunkSummary, chunkAccumulators, chunkSummary);
+		const ULONG64 chunkStart = slabIndex * slabValueCount;
+		for (unsigned int component = 0; component < prop->Count; ++component) {
+			accumulators[(chunkStart + component) % prop->Count].merge(chunkAccumulators[component]);
+		}
+		summary.insert(summary.end(), chunkSummary.begin(), chunkSummary.end());
+		proxy->writeArrayNdSlab(gsoapProxy2_0_1->uuid, datasetName, H5T_NATIVE_DOUBLE, &outputValues[0], &counts[0], &offsets[0], dimensionCount);
+	}
+
+	prop->MinimumValue.clear();
+	prop->MaximumValue.clear();
+	if (prop->Count > 1 || accumulators[0].getValidCount() > 0) { // Same as setPropertyMinMax : min and max are not set if all values are NaN.
+		for (unsigned int component = 0; component < prop->Count; ++component) {
+			prop->MinimumValue.push_back(accumulators[component].getMinimum());
+			prop->MaximumValue.push_back(accumulators[component].getMaximum());
+		}
+	}
+	if (withChunkSummary) {
+		writeChunkSummaryDataset(datasetName, summary, getChunkSummaryValueCount(&dimensions[0], dimensionCount), proxy);
+	}
+}
+
+void ContinuousProperty::writeEncodedValues(const std::string & datasetName, const double * values, unsigned long long * numValues, const unsigned int & numArrayDimensions, COMMON_NS::AbstractHdfProxy* proxy,
+	const encodingEnum & encoding, const double & scale, const double & offset)
+{
+	ULONG64 valueCount = 1;
+	for (unsigned int dim = 0; dim < numArrayDimensions; ++dim) {
+		valueCount *= numValues[dim];
+	}
+
+	if (encoding == HALF_FLOAT) {
+		std::vector<unsigned short> halfValues(valueCount);
+		for (ULONG64 i = 0; i < valueCount; ++i) {
+			halfValues[i] = floatToHalf(static_cast<float>(values[i]));
+		}
+		hid_t halfFloatDatatype = createHalfFloatDatatype();
+		proxy->writeArrayNd(gsoapProxy2_0_1->uuid, datasetName, halfFloatDatatype, halfValues.empty() ? nullptr : &halfValues[0], numValues, numArrayDimensions);
+		H5Tclose(halfFloatDatatype);
+		proxy->writeDatasetAttributes(datasetName, std::vector<std::string>(1, "encoding"), std::vector<double>(1, encoding));
+		return;
+	}
+
+	double fillValue;
+	if (encoding == SCALED_UCHAR) {
+		std::vector<unsigned char> codes(valueCount);
+		quantize(values, valueCount, scale, offset, (numeric_limits<unsigned char>::max)(), codes.empty() ? nullptr : &codes[0]);
+		proxy->writeArrayNd(gsoapProxy2_0_1->uuid, datasetName, H5T_NATIVE_UCHAR, codes.empty() ? nullptr : &codes[0], numValues, numArrayDimensions);
+		fillValue = (numeric_limits<unsigned char>::max)();
+	}
+	else if (encoding == SCALED_USHORT) {
+		std::vector<unsigned short> codes(valueCount);
+		quantize(values, valueCount, scale, offset, (numeric_limits<unsigned short>::max)(), codes.empty() ? nullptr : &codes[0]);
+		proxy->writeArrayNd(gsoapProxy2_0_1->uuid, datasetName, H5T_NATIVE_USHORT, codes.empty() ? nullptr : &codes[0], numValues, numArrayDimensions);
+		fillValue = (numeric_limits<unsigned short>::max)();
+	}
+	else {
+		throw invalid_argument("Unknown encoding of continuous values.");
+	}
+
+	std::vector<std::string> attributeNames;
+	attributeNames.push_back("scale_factor");
+	attributeNames.push_back("add_offset");
+	attributeNames.push_back("_FillValue");
+	attributeNames.push_back("encoding");
+	std::vector<double> attributeValues;
+	attributeValues.push_back(scale);
+	attributeValues.push_back(offset);
+	attributeValues.push_back(fillValue);
+	attributeValues.push_back(encoding);
+	proxy->writeDatasetAttributes(datasetName, attributeNames, attributeValues);
+}
+
+void ContinuousProperty::pushBackEncodedDoubleHdf5ArrayOfValues(const double * values, unsigned long long * numValues, const unsigned int & numArrayDimensions, COMMON_NS::AbstractHdfProxy* proxy,
+	const encodingEnum & encoding)
+{
+	if (encoding == NO_ENCODING) {
+		pushBackDoubleHdf5ArrayOfValues(values, numValues, numArrayDimensions, proxy);
+		return;
+	}
+
+	// One pass gives the range of the codes, the min and max of the property and its chunk summary.
+	_resqml2__ContinuousProperty* prop = static_cast<_resqml2__ContinuousProperty*>(gsoapProxy2_0_1);
+	std::vector< statistics::Accumulator<double> > accumulators;
+	std::vector<double> chunkSummary;
+	computeStatistics(values, numValues, numArrayDimensions, prop->Count, std::numeric_limits<double>::quiet_NaN(), areChunkSummariesEnabled(), accumulators, chunkSummary);
+	statistics::Accumulator<double> accumulator = accumulators[0];
+	for (size_t component = 1; component < accumulators.size(); ++component) {
+		accumulator.merge(accumulators[component]);
+	}
+
+	// Spread the codes (except the NaN one) between the minimum and the maximum values
+	const double offset = accumulator.getValidCount() == 0 ? 0 : accumulator.getMinimum();
+	const double range = accumulator.getValidCount() == 0 ? 0 : accumulator.getMaximum() - accumulator.getMinimum();
+	const double codeCount = encoding == SCALED_UCHAR ? (numeric_limits<unsigned char>::max)() : (numeric_limits<unsigned short>::max)();
+	const double scale = range > 0 ? range / (codeCount - 1) : 1;
+
+	const string datasetName = pushBackRefToExistingDataset(proxy, "");
+	setPropertyMinMax(accumulators);
+	writeEncodedValues(datasetName, values, numValues, numArrayDimensions, proxy, encoding, scale, offset);
+	writeChunkSummaryDataset(datasetName, chunkSummary, getChunkSummaryValueCount(numValues, numArrayDimensions), proxy);
+}
+
+ContinuousProperty::encodingEnum ContinuousProperty::pushBackEncodedDoubleHdf5ArrayOfValues(const double * values, unsigned long long * numValues, const unsigned int & numArrayDimensions, COMMON_NS::AbstractHdfProxy* proxy,
+	const double & maximumError)
+{
+	if (!(maximumError > 0)) {
+		throw invalid_argument("The maximum error of the encoding must be strictly positive.");
+	}
+
+	// One pass gives the range of the codes, the min and max of the property and its chunk summary.
+	_resqml2__ContinuousProperty* prop = static_cast<_resqml2__ContinuousProperty*>(gsoapProxy2_0_1);
+	std::vector< statistics::Accumulator<double> > accumulators;
+	std::vector<double> chunkSummary;
+	computeStatistics(values, numValues, numArrayDimensions, prop->Count, std::numeric_limits<double>::quiet_NaN(), areChunkSummariesEnabled(), accumulators, chunkSummary);
+	statistics::Accumulator<double> accumulator = accumulators[0];
+	for (size_t component = 1; component < accumulators.size(); ++component) {
+		accumulator.merge(accumulators[component]);
+	}
+
+	// A quantization step of twice the maximum error guarantees this maximum error.
+	const double scale = 2 * maximumError;
+	const double offset = accumulator.getValidCount() == 0 ? 0 : accumulator.getMinimum();
+	const double stepCount = accumulator.getValidCount() == 0 ? 0 : (accumulator.getMaximum() - accumulator.getMinimum()) / scale;
+	encodingEnum encoding = NO_ENCODING;
+	if (stepCount < (numeric_limits<unsigned char>::max)() - 1) {
+		encoding = SCALED_UCHAR;
+	}
+	else if (stepCount < (numeric_limits<unsigned short>::max)() - 1) {
+		encoding = SCALED_USHORT;
+	}
+
+	if (encoding == NO_ENCODING) {
+		pushBackDoubleHdf5ArrayOfValues(values, numValues, numArrayDimensions, proxy, accumulators, chunkSummary);
+	}
+	else {
+		const string datasetName = pushBackRefToExistingDataset(proxy, "");
+		setPropertyMinMax(accumulators);
+		writeEncodedValues(datasetName, values, numValues, numArrayDimensions, proxy, encoding, scale, offset);
+		writeChunkSummaryDataset(datasetName, chunkSummary, getChunkSummaryValueCount(numValues, numArrayDimensions), proxy);
+	}
+
+	return encoding;
+}
+
+ContinuousProperty::encodingEnum ContinuousProperty::getEncodingOfPatch(const unsigned int & patchIndex) const
+{
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+	if (hdfProxy == nullptr) {
+		throw invalid_argument("The hdf proxy does not exist");
+	}
+	if (!hdfProxy->isOpened()) {
+		hdfProxy->open();
+	}
+
+	LONG64 nullValue = (numeric_limits<LONG64>::min)();
+	const double encoding = hdfProxy->readDoubleAttribute(getPathInHdfFileOfPatch(patchIndex, nullValue), "encoding");
+	return encoding == encoding ? static_cast<encodingEnum>(static_cast<int>(encoding)) : NO_ENCODING;
 }
 
 void ContinuousProperty::pushBackFloatHdf5Array1dOfValues(const float * values, const ULONG64 & valueCount, COMMON_NS::AbstractHdfProxy * proxy,
@@ -280,7 +735,8 @@ void ContinuousProperty::pushBackFloatHdf5ArrayOfValues(const float * values, un
 	float * minimumValue, float * maximumValue)
 {
 	const string datasetName = pushBackRefToExistingDataset(proxy, string());
-	setPropertyMinMax(values, numValues, numArrayDimensions, minimumValue, maximumValue);
+	std::vector<double> chunkSummary;
+	setPropertyMinMax(values, numValues, numArrayDimensions, minimumValue, maximumValue, &chunkSummary);
 
 	// HDF
 	proxy->writeArrayNd(gsoapProxy2_0_1->uuid,
@@ -288,6 +744,7 @@ void ContinuousProperty::pushBackFloatHdf5ArrayOfValues(const float * values, un
 		H5T_NATIVE_FLOAT,
 		values,
 		numValues, numArrayDimensions);
+	writeChunkSummaryDataset(datasetName, chunkSummary, getChunkSummaryValueCount(numValues, numArrayDimensions), proxy);
 }
 
 void ContinuousProperty::pushBackFloatHdf5ArrayOfValues(
@@ -355,6 +812,7 @@ void ContinuousProperty::getDoubleValuesOfPatch(const unsigned int & patchIndex,
 	resqml2__DoubleHdf5Array* hdfValues = static_cast<resqml2__DoubleHdf5Array*>(prop->PatchOfValues[patchIndex]->Values);
 
 	hdfProxy->readArrayNdOfDoubleValues(hdfValues->Values->PathInHdfFile, values);
+	decodeScaledValues(hdfProxy, hdfValues->Values->PathInHdfFile, values, getValuesCountOfPatch(patchIndex));
 }
 
 void ContinuousProperty::getFloatValuesOfPatch(const unsigned int & patchIndex, float * values)
@@ -368,6 +826,61 @@ void ContinuousProperty::getFloatValuesOfPatch(const unsigned int & patchIndex,
 	resqml2__DoubleHdf5Array* hdfValues = static_cast<resqml2__DoubleHdf5Array*>(prop->PatchOfValues[patchIndex]->Values);
 
 	hdfProxy->readArrayNdOfFloatValues(hdfValues->Values->PathInHdfFile, values);
+	decodeScaledValues(hdfProxy, hdfValues->Values->PathInHdfFile, values, getValuesCountOfPatch(patchIndex));
+}
+
+void ContinuousProperty::getDoubleValuesOfPatch(const unsigned int & patchIndex, double * values, const gsoap_resqml2_0_1::resqml2__ResqmlUom & uom)
+{
+	double scale, offset;
+	getUomConversionOrThrow(gsoapProxy2_0_1->soap, getUom(), uom, scale, offset);
+
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+	if (hdfProxy == nullptr) {
+		throw invalid_argument("The hdf proxy does not exist");
+	}
+
+	_resqml2__ContinuousProperty* prop = static_cast<_resqml2__ContinuousProperty*>(gsoapProxy2_0_1);
+	resqml2__DoubleHdf5Array* hdfValues = static_cast<resqml2__DoubleHdf5Array*>(prop->PatchOfValues[patchIndex]->Values);
+
+	hdfProxy->readArrayNdOfDoubleValues(hdfValues->Values->PathInHdfFile, values);
+	decodeScaledValues(hdfProxy, hdfValues->Values->PathInHdfFile, values, getValuesCountOfPatch(patchIndex), scale, offset);
+}
+
+void ContinuousProperty::getFloatValuesOfPatch(const unsigned int & patchIndex, float * values, const gsoap_resqml2_0_1::resqml2__ResqmlUom & uom)
+{
+	double scale, offset;
+	getUomConversionOrThrow(gsoapProxy2_0_1->soap, getUom(), uom, scale, offset);
+
+	COMMON_NS::AbstractHdfProxy* hdfProxy = getHdfProxy();
+	if (hdfProxy == nullptr) {
+		throw invalid_argument("The hdf proxy does not exist");
+	}
+
+	_resqml2__ContinuousProperty* prop = static_cast<_resqml2__ContinuousProperty*>(gsoapProxy2_0_1);
+	resqml2__DoubleHdf5Array* hdfValues = static_cast<resqml2__DoubleHdf5Array*>(prop->PatchOfValues[patchIndex]->Values);
+
+	hdfProxy->readArrayNdOfFloatValues(hdfValues->Values->PathInHdfFile, values);
+	decodeScaledValues(hdfProxy, hdfValues->Values->PathInHdfFile, values, getValuesCountOfPatch(patchIndex), scale, offset);
+}
+
+bool ContinuousProperty::getUomConversion(const gsoap_resqml2_0_1::resqml2__ResqmlUom & sourceUom, const gsoap_resqml2_0_1::resqml2__ResqmlUom & targetUom, double & scale, double & offset)
+{
+	if (sourceUom == targetUom) {
+		scale = 1;
+		offset = 0;
+		return true;
+	}
+
+	const UomConversion* source = getUomConversionToSi(sourceUom);
+	const UomConversion* target = getUomConversionToSi(targetUom);
+	if (source == nullptr || target == nullptr || source->quantity != target->quantity) {
+		return false;
+	}
+
+	// targetValue = (sourceValue * source->scale + source->offset - target->offset) / target->scale
+	scale = source->scale / target->scale;
+	offset = (source->offset - target->offset) / target->scale;
+	return true;
 }
 
 void ContinuousProperty::getFloatValuesOfPatch(
@@ -391,6 +904,12 @@ void ContinuousProperty::getFloatValuesOfPatch(
 		numValuesInEachDimension,
 		offsetInEachDimension,
 		numArrayDimensions);
+
+	ULONG64 valueCount = 1;
+	for (unsigned int dim = 0; dim < numArrayDimensions; ++dim) {
+		valueCount *= numValuesInEachDimension[dim];
+	}
+	decodeScaledValues(hdfProxy, hdfValues->Values->PathInHdfFile, values, valueCount);
 }
 
 void ContinuousProperty::getFloatValuesOf3dPatch(
@@ -21,7 +21,11 @@ under the License.
 #include "resqml2/AbstractValuesProperty.h"
 #include "common/AbstractHdfProxy.h"
 
+#include "tools/Statistics.h"
+
 #include <stdexcept>
+#include <limits>
+#include <vector>
 #include <sstream>      // std::ostringstream
 
 namespace RESQML2_0_1_NS
@@ -228,6 +232,79 @@ namespace RESQML2_0_1_NS
 		void pushBackFloatHdf5ArrayOfValues(const float * values, unsigned long long * numValues, const unsigned int & numArrayDimensions, COMMON_NS::AbstractHdfProxy* proxy,
 			float * minimumValue = nullptr, float * maximumValue = nullptr);
 
+		/**
+		* Computes the values of a derived property from the values of some input properties, value by value (see pushBackDerivedDoubleHdf5ArrayOfValues).
+		*/
+		class DLL_IMPORT_OR_EXPORT DerivationKernel
+		{
+		public:
+			virtual ~DerivationKernel() {}
+
+			/**
+			* Compute the derived values of a range of values.
+			* It is called concurrently by several threads on disjoint ranges of values : it must not modify any state shared between calls.
+			* @param inputs		The values of the range of each input property, in the order of the input properties. Each input contains valueCount values. Null values are NaN.
+			* @param valueCount	The count of values in the range.
+			* @param outputs	The derived values to compute. It is preallocated with valueCount values.
+			*/
+			virtual void compute(const std::vector<const double *> & inputs, const ULONG64 & valueCount, double * outputs) = 0;
+		};
+
+		/**
+		* Multiplies the values of all the input properties, for instance pore volume = bulk volume * net to gross * porosity.
+		*/
+		class DLL_IMPORT_OR_EXPORT ProductKernel : public DerivationKernel
+		{
+		public:
+			void compute(const std::vector<const double *> & inputs, const ULONG64 & valueCount, double * outputs);
+		};
+
+		/**
+		* Add a patch of values which are derived from the values of some input properties by a kernel.
+		* Values are streamed : inputs are read, derived and written by chunks of slabs along the slowest dimension.
+		* Memory is consequently bounded by the chunk size whatever the count of values. Minimum and maximum values and the chunk summary if enabled are computed on the fly.
+		* The values of a chunk are derived by several threads (see parallel::setMaxThreadCount) while the HDF5 reads and writes stay on the calling thread.
+		* @param inputs				The input properties. Their patches must have the same dimensions, at least one, which will be the ones of the derived patch.
+		* @param patchIndex			The index of the patch of the input properties to derive.
+		* @param kernel				The kernel which derives the values.
+		* @param proxy				The HDF proxy where to write the property values. It must be already opened for writing and won't be closed in this method.
+		* @param maxChunkValueCount	The maximum count of values of a chunk. A chunk contains at least one slab along the slowest dimension, and whole chunks of the summary of a 1d patch if chunk summaries are enabled.
+		*/
+		void pushBackDerivedDoubleHdf5ArrayOfValues(const std::vector<RESQML2_NS::AbstractValuesProperty*> & inputs, const unsigned int & patchIndex,
+			DerivationKernel & kernel, COMMON_NS::AbstractHdfProxy* proxy, const ULONG64 & maxChunkValueCount = 1048576);
+
+		/**
+		* The compact encodings of the values of a continuous property in the HDF file.
+		* HALF_FLOAT stores IEEE 754 16 bits floating point values.
+		* SCALED_UCHAR and SCALED_USHORT store unsigned integer codes which are decoded as code * scale_factor + add_offset.
+		* The greatest code is reserved for NaN values. The scale_factor, add_offset and _FillValue attributes of the dataset store the decoding parameters.
+		*/
+		enum encodingEnum { NO_ENCODING = 0, HALF_FLOAT = 1, SCALED_UCHAR = 2, SCALED_USHORT = 3 };
+
+		/**
+		* Same as pushBackDoubleHdf5ArrayOfValues but the values are stored with a compact (and lossy) encoding.
+		* The encoded values are transparently decoded by getDoubleValuesOfPatch and getFloatValuesOfPatch.
+		* Minimum and maximum values are computed from the values before encoding.
+		* @param encoding	The encoding of the values in the HDF file.
+		*					SCALED_UCHAR and SCALED_USHORT spread the codes between the minimum and the maximum values.
+		*					The absolute error is then (max - min) / 508 and (max - min) / 131068 respectively. HALF_FLOAT has a relative error of 2^-11.
+		*/
+		void pushBackEncodedDoubleHdf5ArrayOfValues(const double * values, unsigned long long * numValues, const unsigned int & numArrayDimensions, COMMON_NS::AbstractHdfProxy* proxy,
+			const encodingEnum & encoding);
+
+		/**
+		* Same as pushBackEncodedDoubleHdf5ArrayOfValues but the encoding is the most compact scaled one which guarantees an absolute error less or equal to maximumError.
+		* If no scaled encoding can guarantee it, the values are stored without any encoding.
+		* @return The chosen encoding.
+		*/
+		encodingEnum pushBackEncodedDoubleHdf5ArrayOfValues(const double * values, unsigned long long * numValues, const unsigned int & numArrayDimensions, COMMON_NS::AbstractHdfProxy* proxy,
+			const double & maximumError);
+
+		/**
+		* Get the encoding of the values of a particular patch in the HDF file.
+		*/
+		encodingEnum getEncodingOfPatch(const unsigned int & patchIndex) const;
+
 		/**
 		* Create an array (potentially multi dimensions) of explicit float values to the property values. No values are written to this array yet then the HDF5 array contains uninitialized values.
 		* @param numValues				The number of property values ordered by dimension of the array to write.
@@ -322,6 +399,37 @@ namespace RESQML2_0_1_NS
 		*/
 		void getFloatValuesOfPatch(const unsigned int & patchIndex, float * values);
 
+		/**
+		* Get all the values of a particular patch of the instance converted into another unit of measure.
+		* The conversion is applied in the same pass as the decoding of the values. NaN values remain NaN.
+		* @param patchIndex	The index of the patch we want the values from.
+		* @param values		The array (pointer) of values must be preallocated.
+		* @param uom		The unit of measure of the values to get. An invalid_argument exception naming the faulty unit is thrown if the unit of measure of the property cannot be converted into it (see getUomConversion).
+		*/
+		void getDoubleValuesOfPatch(const unsigned int & patchIndex, double * values, const gsoap_resqml2_0_1::resqml2__ResqmlUom & uom);
+		void getFloatValuesOfPatch(const unsigned int & patchIndex, float * values, const gsoap_resqml2_0_1::resqml2__ResqmlUom & uom);
+
+		/**
+		* Get the affine conversion of values from a unit of measure into another one : targetValue = sourceValue * scale + offset.
+		* The conversion of a unit is found in constant time. Any unit of measure can be converted into itself. Otherwise only these families are covered :
+		* - length : m, cm, mm, km, ft, ft[US], in, yd, mi
+		* - area (including permeability) : m2, mm2, cm2, km2, in2, ft2, mi2, acre, ha, um2, D, D[API], mD
+		* - volume : m3, cm3, L, ft3, bbl
+		* - pressure : Pa, kPa, MPa, GPa, mbar, bar, atm, psi
+		* - pressure gradient : kPa/m, bar/m, psi/ft
+		* - temperature : K, degC, degF, degR
+		* - time : s, ms, h, d, a
+		* - slowness : ms/m, us/m, us/ft
+		* - velocity : m/s, km/s, ft/s
+		* - mass : kg, g, lbm
+		* - density : kg/m3, g/cm3, kg/L, lbm/ft3
+		* - viscosity : Pa.s, cP
+		* - angle : rad, dega
+		* - dimensionless ratio : Euc, %
+		* @return false if the conversion is not known, because one of the units is not covered or because the units do not measure the same quantity.
+		*/
+		static bool getUomConversion(const gsoap_resqml2_0_1::resqml2__ResqmlUom & sourceUom, const gsoap_resqml2_0_1::resqml2__ResqmlUom & targetUom, double & scale, double & offset);
+
 		/**
 		* Get some of the values of a particular patch of the instance which are supposed to be float ones. This method makes use of HDF5 hyperslabbing.
 		* @param patchIndex					The index of the patch we want the values from.
@@ -385,25 +493,56 @@ namespace RESQML2_0_1_NS
 	private:
 
 		/**
-		* Compute and set the minimum and maximum value in \p values. 
+		* Write some values with an encoding which is not NO_ENCODING.
+		*/
+		void writeEncodedValues(const std::string & datasetName, const double * values, unsigned long long * numValues, const unsigned int & numArrayDimensions, COMMON_NS::AbstractHdfProxy* proxy,
+			const encodingEnum & encoding, const double & scale, const double & offset);
+
+		/**
+		* Push back a new patch of double values whose statistics have already been computed by computeStatistics.
+		* @param accumulators	The statistics of each component of the values.
+		* @param chunkSummary	The chunk summary of the values. It is not written if it is empty.
+		*/
+		void pushBackDoubleHdf5ArrayOfValues(const double * values, unsigned long long * numValues, const unsigned int & numArrayDimensions, COMMON_NS::AbstractHdfProxy* proxy,
+			const std::vector< statistics::Accumulator<double> > & accumulators, const std::vector<double> & chunkSummary);
+
+		/**
+		* Compute and set the minimum and maximum value in \p values.
+		* The values are read in one parallel pass which also computes the chunk summary of the values if \p chunkSummary is not null and if chunk summaries are enabled.
 		* @param values				The array of values.
 		* @param numValues			The number of property values in each dimension.
 		* @param numArrayDimensions	The number of dimensions of the array.
 		* @param minimumValue		If this value and \p maximumValue are defined then the method does not compute the min but forces it to this value.
 		* @param maximumValue		If this value and \p minimumValue are defined then the method does not compute the max but forces it to this value.
+		* @param chunkSummary		If not null, it receives the chunk summary of the values (see writeChunkSummaryDataset), or nothing if chunk summaries are disabled.
 		*/
 		template <class T>
 		void setPropertyMinMax(
 			const T* values, 
 			unsigned long long* numValuesInEachDimension,
 			const unsigned int& numArrayDimensions,
-			T * minimumValue = nullptr, T * maximumValue = nullptr)
+			T * minimumValue = nullptr, T * maximumValue = nullptr,
+			std::vector<double> * chunkSummary = nullptr)
 		{
 			gsoap_resqml2_0_1::_resqml2__ContinuousProperty* prop = static_cast<gsoap_resqml2_0_1::_resqml2__ContinuousProperty*>(gsoapProxy2_0_1);
-			prop->MinimumValue.clear();
-			prop->MaximumValue.clear();
+			if (prop->Count < 1) {
+				throw std::invalid_argument("Cannot compute and set min and max value on a property which has a Count set to zero or negative.");
+			}
 
-			if (minimumValue != nullptr && maximumValue != nullptr) {
+			const bool isMinMaxForced = minimumValue != nullptr && maximumValue != nullptr;
+			const bool withChunkSummary = chunkSummary != nullptr && areChunkSummariesEnabled();
+			std::vector< statistics::Accumulator<T> > accumulators;
+			if (!isMinMaxForced || withChunkSummary) {
+				std::vector<double> summary;
+				computeStatistics(values, numValuesInEachDimension, numArrayDimensions, prop->Count, std::numeric_limits<T>::quiet_NaN(), withChunkSummary, accumulators, summary);
+				if (chunkSummary != nullptr) {
+					chunkSummary->swap(summary);
+				}
+			}
+
+			if (isMinMaxForced) {
+				prop->MinimumValue.clear();
+				prop->MaximumValue.clear();
 				for (unsigned int i = 0; i < prop->Count; ++i)
 				{
 					prop->MinimumValue.push_back(minimumValue[i]);
@@ -411,53 +550,26 @@ namespace RESQML2_0_1_NS
 				}
 			}
 			else {
+				setPropertyMinMax(accumulators);
+			}
+		}
 
-				ULONG64 nValues = numValuesInEachDimension[0];
-				if (prop->Count == 1) {
-					for (unsigned int dim = 1; dim < numArrayDimensions; dim++) {
-						nValues *= numValuesInEachDimension[dim];
-					}
-				}
-				else if (prop->Count > 1) {
-					//In this case, the last (fastest) dimension has the number of properties per indexable element of the representation.
-					for (unsigned int dim = 1; dim < numArrayDimensions - 1; dim++) {
-						nValues *= numValuesInEachDimension[dim];
-					}
-				}
-				else {
-					throw std::invalid_argument("Cannot compute and set min and max value on a property which has a Count set to zero or negative.");
-				}
-
-				for (ULONG64 propIndex = 0; propIndex < prop->Count; ++propIndex) {
-					size_t i = propIndex;
-					T computedMin = std::numeric_limits<T>::quiet_NaN();
-					T computedMax = std::numeric_limits<T>::quiet_NaN();
-					while (i < nValues && values[i] != values[i]) i += prop->Count;
-					if (i >= nValues) {
-						// All values of a dimension of the vectorial property look to be only NaN values.
-						if (prop->Count == 1) {
-							return; // Does not set min and max value
-						}
-						else { // Set min and max as NaN values
-							prop->MinimumValue.push_back(std::numeric_limits<T>::quiet_NaN());
-							prop->MaximumValue.push_back(std::numeric_limits<T>::quiet_NaN());
-						}
-					}
-					computedMin = values[i];
-					computedMax = values[i];
-
-					for (; i < nValues; i += prop->Count) {
-						T propVal = values[i];
-						if (propVal < computedMin) {
-							computedMin = propVal;
-						}
-						else if (propVal > computedMax) {
-							computedMax = propVal;
-						}
-					}
-					prop->MinimumValue.push_back(computedMin);
-					prop->MaximumValue.push_back(computedMax);
-				}
+		/**
+		* Set the minimum and maximum value of each component of this property from their statistics.
+		* If all values of a single component property are NaN values, min and max are not set. If all values of a component of a vectorial property are NaN values then its min and max are set to NaN.
+		*/
+		template <class T>
+		void setPropertyMinMax(const std::vector< statistics::Accumulator<T> > & accumulators)
+		{
+			gsoap_resqml2_0_1::_resqml2__ContinuousProperty* prop = static_cast<gsoap_resqml2_0_1::_resqml2__ContinuousProperty*>(gsoapProxy2_0_1);
+			prop->MinimumValue.clear();
+			prop->MaximumValue.clear();
+			if (accumulators.size() == 1 && accumulators[0].getValidCount() == 0) {
+				return;
+			}
+			for (size_t component = 0; component < accumulators.size(); ++component) {
+				prop->MinimumValue.push_back(accumulators[component].getMinimum());
+				prop->MaximumValue.push_back(accumulators[component].getMaximum());
 			}
 		}
 	};
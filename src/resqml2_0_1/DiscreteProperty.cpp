@@ -302,6 +302,7 @@ void DiscreteProperty::pushBackLongHdf5ArrayOfValues(const long * values, unsign
 		H5T_NATIVE_LONG,
 		values,
 		numValues, numDimensionsInArray);
+	writeChunkSummary(datasetName, values, numValues, numDimensionsInArray, nullValue, proxy);
 }
 
 void DiscreteProperty::pushBackLongHdf5ArrayOfValues(const long * values, unsigned long long * numValues, const unsigned int & numDimensionsInArray, COMMON_NS::AbstractHdfProxy * proxy,
@@ -326,6 +327,7 @@ void DiscreteProperty::pushBackIntHdf5ArrayOfValues(const int * values, unsigned
 		H5T_NATIVE_INT,
 		values,
 		numValues, numDimensionsInArray);
+	writeChunkSummary(datasetName, values, numValues, numDimensionsInArray, nullValue, proxy);
 }
 
 void DiscreteProperty::pushBackIntHdf5ArrayOfValues(const int * values, unsigned long long * numValues, const unsigned int & numDimensionsInArray, COMMON_NS::AbstractHdfProxy* proxy, const int & nullValue)
@@ -349,6 +351,7 @@ void DiscreteProperty::pushBackShortHdf5ArrayOfValues(const short * values, unsi
 		H5T_NATIVE_SHORT,
 		values,
 		numValues, numDimensionsInArray);
+	writeChunkSummary(datasetName, values, numValues, numDimensionsInArray, nullValue, proxy);
 }
 
 void DiscreteProperty::pushBackShortHdf5ArrayOfValues(const short * values, unsigned long long * numValues, const unsigned int & numDimensionsInArray, COMMON_NS::AbstractHdfProxy* proxy, const short & nullValue)
@@ -372,6 +375,7 @@ void DiscreteProperty::pushBackUShortHdf5ArrayOfValues(const unsigned short * va
 		H5T_NATIVE_USHORT,
 		values,
 		numValues, numDimensionsInArray);
+	writeChunkSummary(datasetName, values, numValues, numDimensionsInArray, nullValue, proxy);
 }
 
 void DiscreteProperty::pushBackUShortHdf5ArrayOfValues(const unsigned short * values, unsigned long long * numValues, const unsigned int & numDimensionsInArray, COMMON_NS::AbstractHdfProxy* proxy, const unsigned short & nullValue)
@@ -395,6 +399,7 @@ void DiscreteProperty::pushBackCharHdf5ArrayOfValues(const char * values, unsign
 		H5T_NATIVE_CHAR,
 		values,
 		numValues, numDimensionsInArray);
+	writeChunkSummary(datasetName, values, numValues, numDimensionsInArray, nullValue, proxy);
 }
 
 void DiscreteProperty::pushBackCharHdf5ArrayOfValues(const char * values, unsigned long long * numValues, const unsigned int & numDimensionsInArray, COMMON_NS::AbstractHdfProxy* proxy, const char & nullValue)
@@ -408,6 +413,33 @@ void DiscreteProperty::pushBackCharHdf5ArrayOfValues(const char * values, unsign
 	pushBackCharHdf5ArrayOfValues(values, numValues, numDimensionsInArray, proxy, nullValue, minMax.first, minMax.second);
 }
 
+RESQML2_NS::AbstractValuesProperty::hdfDatatypeEnum DiscreteProperty::pushBackCompactLongHdf5ArrayOfValues(const long * values, unsigned long long * numValues, const unsigned int & numDimensionsInArray, COMMON_NS::AbstractHdfProxy* proxy,
+	const long & nullValue)
+{
+	ULONG64 numTotalValues = numValues[0];
+	for (unsigned int dim = 1; dim < numDimensionsInArray; ++dim) {
+		numTotalValues *= numValues[dim];
+	}
+
+	statistics::Accumulator<long> accumulator(nullValue);
+	accumulator.add(values, numTotalValues);
+	LONG64 narrowedNullValue = nullValue;
+	string datasetName;
+	hdfDatatypeEnum datatype;
+	if (accumulator.getValidCount() > 0) {
+		datatype = getNarrowestIntegerDatatype(accumulator.getMinimum(), accumulator.getMaximum(), narrowedNullValue);
+		datasetName = pushBackRefToExistingDataset(proxy, "", narrowedNullValue, accumulator.getMinimum(), accumulator.getMaximum());
+	}
+	else {
+		datatype = getNarrowestIntegerDatatype(1, 0, narrowedNullValue);
+		datasetName = pushBackRefToExistingDataset(proxy, "", narrowedNullValue);
+	}
+	writeNarrowedLongValues(datasetName, values, numValues, numDimensionsInArray, nullValue, narrowedNullValue, datatype, proxy);
+	writeChunkSummary(datasetName, values, numValues, numDimensionsInArray, nullValue, proxy);
+
+	return datatype;
+}
+
 bool DiscreteProperty::validatePropertyKindAssociation(RESQML2_NS::PropertyKind* pk)
 {
 	if (pk == nullptr) {
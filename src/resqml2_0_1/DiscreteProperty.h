@@ -152,6 +152,14 @@ namespace RESQML2_0_1_NS
 		void pushBackCharHdf5ArrayOfValues(const char * values, unsigned long long * numValues, const unsigned int & numDimensionsInArray, COMMON_NS::AbstractHdfProxy* proxy, const char & nullValue, const char & minimumValue, const char & maximumValue);
 		void pushBackCharHdf5ArrayOfValues(const char * values, unsigned long long * numValues, const unsigned int & numDimensionsInArray, COMMON_NS::AbstractHdfProxy* proxy, const char & nullValue);
 
+		/**
+		* Add an array (potentially multi dimensions) of long values to the property values which will be stored in the narrowest integer datatype able to store them.
+		* The values are read back (and widened) with the usual getters such as getLongValuesOfPatch or getIntValuesOfPatch.
+		* @param nullValue				The null value of the values. If it does not fit in the narrowest datatype, the null values are stored with another value which is out of the range of the values (see getNullValueOfPatch).
+		* @return						The datatype of the values in the HDF file.
+		*/
+		hdfDatatypeEnum pushBackCompactLongHdf5ArrayOfValues(const long * values, unsigned long long * numValues, const unsigned int & numDimensionsInArray, COMMON_NS::AbstractHdfProxy* proxy, const long & nullValue);
+
 		/**
 		* Push back a a reference to an existing (or a "to exist") HDF5 dataset in a particular hdf proxy.
 		* The reason can be that the indice values already exist in an external file (only HDF5 for now) or that the writing of these indice values in the external file is defered in time.
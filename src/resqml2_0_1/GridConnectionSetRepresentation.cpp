@@ -25,6 +25,7 @@ under the License.
 
 #include "hdf5.h"
 
+#include "common/EpcDocument.h"
 #include "resqml2_0_1/FaultInterpretation.h"
 #include "resqml2/AbstractGridRepresentation.h"
 #include "common/AbstractHdfProxy.h"
@@ -38,6 +39,53 @@ using namespace epc;
 using namespace RESQML2_0_1_NS;
 using namespace gsoap_resqml2_0_1;
 
+namespace {
+	/**
+	* Gather the pairs of some connections from a dataset of pairs.
+	* Only the rows of the connections are read : each run of consecutive connections is added as an hyperslab to a single selected region which is read at once.
+	* @param connectionIndices	The connections to gather in increasing order.
+	* @param pairs				It must be preallocated with 2 * connectionCount.
+	*/
+	template <class T> void gatherPairsOfConnections(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, const hid_t & datatype,
+		const ULONG64* connectionIndices, const ULONG64 & connectionCount, T* pairs)
+	{
+		unsigned long long blockCountPerDimension[2] = { 1, 1 };
+		unsigned long long offsetPerDimension[2] = { 0, 0 };
+		unsigned long long strideInEachDimension[2] = { 1, 1 };
+		unsigned long long blockSizeInEachDimension[2] = { 0, 2 };
+		int dataset, filespace;
+		unsigned long long rowCount = 0;
+		ULONG64 i = 0;
+		while (i < connectionCount) {
+			const ULONG64 runStart = connectionIndices[i];
+			ULONG64 runLength = 1;
+			for (++i; i < connectionCount && connectionIndices[i] <= runStart + runLength; ++i) {
+				if (connectionIndices[i] == runStart + runLength) {
+					++runLength;
+				}
+			}
+
+			offsetPerDimension[0] = runStart;
+			blockSizeInEachDimension[0] = runLength;
+			hdfProxy->selectArrayNdOfValues(datasetName, blockCountPerDimension, offsetPerDimension, strideInEachDimension, blockSizeInEachDimension,
+				2, rowCount == 0, dataset, filespace);
+			rowCount += runLength;
+		}
+
+		// The selected rows are read in increasing order : a repeated connection index is read once.
+		std::vector<T> rows(2 * rowCount);
+		hdfProxy->readArrayNdOfValues(dataset, filespace, &rows[0], 2 * rowCount, datatype);
+		ULONG64 row = 0;
+		for (i = 0; i < connectionCount; ++i) {
+			if (i > 0 && connectionIndices[i] != connectionIndices[i - 1]) {
+				++row;
+			}
+			pairs[2 * i] = rows[2 * row];
+			pairs[2 * i + 1] = rows[2 * row + 1];
+		}
+	}
+}
+
 void GridConnectionSetRepresentation::init(soap* soapContext, const std::string & guid, const std::string & title)
 {
 	gsoapProxy2_0_1 = soap_new_resqml2__obj_USCOREGridConnectionSetRepresentation(soapContext, 1);
@@ -82,6 +130,7 @@ void GridConnectionSetRepresentation::setCellIndexPairsUsingExistingDataset(cons
 	}
 	_resqml2__GridConnectionSetRepresentation* const rep = static_cast<_resqml2__GridConnectionSetRepresentation* const>(gsoapProxy2_0_1);
 	rep->Count = cellIndexPairCount;
+	releaseInterpretationConnections();
 
 	setHdfProxy(proxy);
 
@@ -120,6 +169,7 @@ void GridConnectionSetRepresentation::setLocalFacePerCellIndexPairsUsingExisting
 	integerArray->Values = resqmlHDF5dataset;
 	integerArray->NullValue = nullValue;
 	rep->LocalFacePerCellIndexPairs = integerArray;
+	releaseInterpretationConnections();
 }
 
 void GridConnectionSetRepresentation::setLocalFacePerCellIndexPairs(const ULONG64 & cellIndexPairCount, int * localFacePerCellIndexPair, const LONG64 & nullValue, COMMON_NS::AbstractHdfProxy * proxy)
@@ -190,150 +240,161 @@ ULONG64 GridConnectionSetRepresentation::getCellIndexPairCount() const
 	return static_cast<_resqml2__GridConnectionSetRepresentation*>(gsoapProxy2_0_1)->Count;
 }
 
-unsigned int GridConnectionSetRepresentation::getCellIndexPairCountFromInterpretationIndex(const unsigned int & interpretationIndex) const
+unsigned long long GridConnectionSetRepresentation::InterpretationConnections::getByteSize() const
 {
-	unsigned int result = 0;
-	_resqml2__GridConnectionSetRepresentation* rep = static_cast<_resqml2__GridConnectionSetRepresentation*>(gsoapProxy2_0_1);
+	return sizeof(InterpretationConnections) + (connectionOffsetsOfInterpretations.size() + connectionIndices.size()) * sizeof(ULONG64);
+}
 
-	if (rep->ConnectionInterpretations)
-	{
-		if (rep->ConnectionInterpretations->InterpretationIndices->Elements->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array)
-		{
-			const unsigned int faultIndexCount = hdfProxy->getElementCount(static_cast<resqml2__IntegerHdf5Array*>(rep->ConnectionInterpretations->InterpretationIndices->Elements)->Values->PathInHdfFile);
-			unsigned int * const faultIndices = new unsigned int[faultIndexCount];
-
-			hdfProxy->readArrayNdOfUIntValues(static_cast<resqml2__IntegerHdf5Array*>(rep->ConnectionInterpretations->InterpretationIndices->Elements)->Values->PathInHdfFile, faultIndices);
-			for (unsigned int i = 0; i < faultIndexCount; ++i) {
-				if (faultIndices[i] == interpretationIndex) {
-					result++;
+GridConnectionSetRepresentation::InterpretationConnections* GridConnectionSetRepresentation::buildInterpretationConnections() const
+{
+	_resqml2__GridConnectionSetRepresentation* const rep = static_cast<_resqml2__GridConnectionSetRepresentation*>(gsoapProxy2_0_1);
+	if (rep->ConnectionInterpretations == nullptr) {
+		throw invalid_argument("The grid connection does not contain any fault association.");
+	}
+	if (rep->ConnectionInterpretations->InterpretationIndices->CumulativeLength->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array ||
+		rep->ConnectionInterpretations->InterpretationIndices->Elements->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array) {
+		throw std::logic_error("Not yet implemented");
+	}
+
+	const ULONG64 connectionCount = getCellIndexPairCount();
+	const unsigned int interpretationCount = getInterpretationCount();
+	std::vector<unsigned int> cumulativeCount(connectionCount);
+	if (connectionCount > 0) {
+		getInterpretationIndexCumulativeCount(&cumulativeCount[0]);
+	}
+	std::vector<unsigned int> interpretationIndices(connectionCount > 0 ? cumulativeCount[connectionCount - 1] : 0);
+	if (!interpretationIndices.empty()) {
+		getInterpretationIndices(&interpretationIndices[0]);
+	}
+
+	InterpretationConnections* result = new InterpretationConnections();
+	try {
+		// Count the connections of each interpretation. Null or out of range interpretation indices are ignored
+		// and a connection which references several times the same interpretation is counted once.
+		result->connectionOffsetsOfInterpretations.assign(interpretationCount + 1, 0);
+		unsigned int begin = 0;
+		for (ULONG64 connection = 0; connection < connectionCount; ++connection) {
+			for (unsigned int j = begin; j < cumulativeCount[connection]; ++j) {
+				if (interpretationIndices[j] < interpretationCount &&
+					std::find(interpretationIndices.begin() + begin, interpretationIndices.begin() + j, interpretationIndices[j]) == interpretationIndices.begin() + j) {
+					++result->connectionOffsetsOfInterpretations[interpretationIndices[j] + 1];
 				}
 			}
-
-			delete [] faultIndices;
+			begin = cumulativeCount[connection];
 		}
-		else {
-			throw std::logic_error("Not yet implemented");
+		for (unsigned int interp = 0; interp < interpretationCount; ++interp) {
+			result->connectionOffsetsOfInterpretations[interp + 1] += result->connectionOffsetsOfInterpretations[interp];
+		}
+
+		// Scatter the connections in their interpretation bucket. Connections are scattered in increasing order which keeps each bucket sorted.
+		result->connectionIndices.resize(result->connectionOffsetsOfInterpretations[interpretationCount]);
+		std::vector<ULONG64> next(result->connectionOffsetsOfInterpretations.begin(), result->connectionOffsetsOfInterpretations.end() - 1);
+		begin = 0;
+		for (ULONG64 connection = 0; connection < connectionCount; ++connection) {
+			for (unsigned int j = begin; j < cumulativeCount[connection]; ++j) {
+				if (interpretationIndices[j] < interpretationCount &&
+					std::find(interpretationIndices.begin() + begin, interpretationIndices.begin() + j, interpretationIndices[j]) == interpretationIndices.begin() + j) {
+					result->connectionIndices[next[interpretationIndices[j]]++] = connection;
+				}
+			}
+			begin = cumulativeCount[connection];
 		}
+
 	}
-	else {
-		throw invalid_argument("The grid connection does not contain any fault association."); 
+	catch (...) {
+		delete result;
+		throw;
 	}
 
 	return result;
 }
 
-void GridConnectionSetRepresentation::getGridConnectionSetInformationFromInterpretationIndex(ULONG64 * cellIndexPairs, unsigned short * gridIndexPairs, int * localFaceIndexPairs, const unsigned int & interpretationIndex) const
+std::shared_ptr<const GridConnectionSetRepresentation::InterpretationConnections> GridConnectionSetRepresentation::getInterpretationConnections() const
 {
-	unsigned int result = 0;
-
-	//load global information into memory
-	const ULONG64 totalCellIndexPairCount = getCellIndexPairCount();
-	ULONG64 * const totalCellIndexPairs = new ULONG64[totalCellIndexPairCount*2];
-	getCellIndexPairs(totalCellIndexPairs);
-	unsigned short * totalGridIndexPairs = nullptr;
-	if (gridIndexPairs != nullptr)
-	{
-		totalGridIndexPairs = new unsigned short[totalCellIndexPairCount * 2];
-		getGridIndexPairs(totalGridIndexPairs);
+	if (getEpcDocument() == nullptr) {
+		// No cache to keep them
+		return std::shared_ptr<const InterpretationConnections>(buildInterpretationConnections());
 	}
-	int * totalLocalFaceIndexPairs = nullptr;
-	if (localFaceIndexPairs != nullptr)
-	{
-		totalLocalFaceIndexPairs = new int[totalCellIndexPairCount*2];
-		getLocalFacePerCellIndexPairs(totalLocalFaceIndexPairs);
+
+	COMMON_NS::GeometryCache* cache = getEpcDocument()->getGeometryCache();
+	std::shared_ptr<COMMON_NS::GeometryCache::Entry> connections = cache->get(this, COMMON_NS::GeometryCache::INTERPRETATION_CONNECTIONS);
+	if (!connections) {
+		connections = cache->put(this, COMMON_NS::GeometryCache::INTERPRETATION_CONNECTIONS, buildInterpretationConnections());
 	}
 
-	_resqml2__GridConnectionSetRepresentation* const rep = static_cast<_resqml2__GridConnectionSetRepresentation*>(gsoapProxy2_0_1);
+	return std::static_pointer_cast<const InterpretationConnections>(connections);
+}
 
-	if (rep->ConnectionInterpretations != nullptr)
-	{
-		// Get the fault indices information
-		unsigned int * cumulativeCount = nullptr;
-		if (rep->ConnectionInterpretations->InterpretationIndices->CumulativeLength->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array)
-		{
-			cumulativeCount = new unsigned int[totalCellIndexPairCount];
-			hdfProxy->readArrayNdOfUIntValues(static_cast<resqml2__IntegerHdf5Array*>(rep->ConnectionInterpretations->InterpretationIndices->CumulativeLength)->Values->PathInHdfFile, cumulativeCount);
-		}
-		else
-		{
-			if (totalGridIndexPairs != nullptr) {
-				delete[] totalGridIndexPairs;
-			}
-			if (totalLocalFaceIndexPairs != nullptr) {
-				delete[] totalLocalFaceIndexPairs;
-			}
-			delete [] totalCellIndexPairs;
-			throw std::logic_error("Not yet implemented");
-		}
+void GridConnectionSetRepresentation::releaseInterpretationConnections()
+{
+	if (getEpcDocument() != nullptr) {
+		getEpcDocument()->getGeometryCache()->release(this, COMMON_NS::GeometryCache::INTERPRETATION_CONNECTIONS);
+	}
+}
 
-		unsigned int * faultIndices = nullptr;
-		if (rep->ConnectionInterpretations->InterpretationIndices->Elements->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array)
-		{
-			faultIndices = new unsigned int[cumulativeCount[totalCellIndexPairCount-1]];
-			hdfProxy->readArrayNdOfUIntValues(static_cast<resqml2__IntegerHdf5Array*>(rep->ConnectionInterpretations->InterpretationIndices->Elements)->Values->PathInHdfFile, faultIndices);
-		}
-		else
-		{
-			delete [] cumulativeCount;
-			if (totalGridIndexPairs != nullptr) {
-				delete[] totalGridIndexPairs;
-			}
-			if (totalLocalFaceIndexPairs != nullptr) {
-				delete[] totalLocalFaceIndexPairs;
-			}
-			delete [] totalCellIndexPairs;
-			throw std::logic_error("Not yet implemented");
-		}
+unsigned int GridConnectionSetRepresentation::getCellIndexPairCountFromInterpretationIndex(const unsigned int & interpretationIndex) const
+{
+	if (interpretationIndex >= getInterpretationCount()) {
+		throw range_error("The interpretation index is out of range in this grid connection context.");
+	}
 
-		// Based on the fault indices information, construct the required subset of information
-		size_t cellIndexPairIndex = 0;
-		unsigned int j = 0;
-		for (unsigned int i = 0; i < totalCellIndexPairCount; ++i)
-		{
-			for (; j < cumulativeCount[i]; ++j)
-			{
-				if (faultIndices[j] == interpretationIndex)
-				{
-					cellIndexPairs[cellIndexPairIndex*2] = totalCellIndexPairs[i*2];
-					cellIndexPairs[cellIndexPairIndex*2+1] = totalCellIndexPairs[i*2+1];
-					if (gridIndexPairs != nullptr)
-					{
-						gridIndexPairs[cellIndexPairIndex*2] = totalGridIndexPairs[i*2];
-						gridIndexPairs[cellIndexPairIndex*2+1] = totalGridIndexPairs[i*2+1];
-					}
-					if (localFaceIndexPairs != nullptr)
-					{
-						localFaceIndexPairs[cellIndexPairIndex*2] = totalLocalFaceIndexPairs[i*2];
-						localFaceIndexPairs[cellIndexPairIndex*2+1] = totalLocalFaceIndexPairs[i*2+1];
-					}
-					++cellIndexPairIndex;
-					break;
-				}
-			}
-		}
+	const std::shared_ptr<const InterpretationConnections> connections = getInterpretationConnections();
+
+	return static_cast<unsigned int>(connections->connectionOffsetsOfInterpretations[interpretationIndex + 1] - connections->connectionOffsetsOfInterpretations[interpretationIndex]);
+}
+
+void GridConnectionSetRepresentation::getGridConnectionSetInformationFromInterpretationIndex(ULONG64 * cellIndexPairs, unsigned short * gridIndexPairs, int * localFaceIndexPairs, const unsigned int & interpretationIndex) const
+{
+	if (gridIndexPairs != nullptr && !isBasedOnMultiGrids()) {
+		throw std::invalid_argument("This representation has no multiple grid support.");
+	}
+	if (localFaceIndexPairs != nullptr && !hasLocalFacePerCell()) {
+		throw std::invalid_argument("This representation has no local face per cell.");
+	}
 
-		delete [] faultIndices;
-		delete [] cumulativeCount;
+	if (interpretationIndex >= getInterpretationCount()) {
+		throw range_error("The interpretation index is out of range in this grid connection context.");
 	}
-	else
-	{
-		if (totalGridIndexPairs != nullptr) {
-			delete[] totalGridIndexPairs;
-		}
-		if (totalLocalFaceIndexPairs != nullptr) {
-			delete[] totalLocalFaceIndexPairs;
+
+	const std::shared_ptr<const InterpretationConnections> connections = getInterpretationConnections();
+	const ULONG64 begin = connections->connectionOffsetsOfInterpretations[interpretationIndex];
+	const ULONG64 end = connections->connectionOffsetsOfInterpretations[interpretationIndex + 1];
+	if (begin == end) {
+		return;
+	}
+
+	_resqml2__GridConnectionSetRepresentation* const rep = static_cast<_resqml2__GridConnectionSetRepresentation*>(gsoapProxy2_0_1);
+	const ULONG64* connectionIndices = &connections->connectionIndices[begin];
+	if (rep->CellIndexPairs->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array) {
+		throw std::logic_error("Not yet implemented");
+	}
+	gatherPairsOfConnections(hdfProxy, static_cast<resqml2__IntegerHdf5Array*>(rep->CellIndexPairs)->Values->PathInHdfFile, H5T_NATIVE_ULLONG,
+		connectionIndices, end - begin, cellIndexPairs);
+	if (gridIndexPairs != nullptr) {
+		if (rep->GridIndexPairs->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array) {
+			throw std::logic_error("Not implemented yet");
 		}
-		delete [] totalCellIndexPairs;
-		throw invalid_argument("The grid connection does not contain any fault association."); 
+		gatherPairsOfConnections(hdfProxy, static_cast<resqml2__IntegerHdf5Array*>(rep->GridIndexPairs)->Values->PathInHdfFile, H5T_NATIVE_USHORT,
+			connectionIndices, end - begin, gridIndexPairs);
 	}
-	
-	if (totalGridIndexPairs != nullptr) {
-		delete[] totalGridIndexPairs;
+	if (localFaceIndexPairs != nullptr) {
+		if (rep->LocalFacePerCellIndexPairs->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array) {
+			throw std::logic_error("Not implemented yet");
+		}
+		gatherPairsOfConnections(hdfProxy, static_cast<resqml2__IntegerHdf5Array*>(rep->LocalFacePerCellIndexPairs)->Values->PathInHdfFile, H5T_NATIVE_INT,
+			connectionIndices, end - begin, localFaceIndexPairs);
 	}
-	if (totalLocalFaceIndexPairs != nullptr) {
-		delete[] totalLocalFaceIndexPairs;
+}
+
+void GridConnectionSetRepresentation::getConnectionIndicesFromInterpretationIndex(ULONG64 * connectionIndices, const unsigned int & interpretationIndex) const
+{
+	if (interpretationIndex >= getInterpretationCount()) {
+		throw range_error("The interpretation index is out of range in this grid connection context.");
 	}
-	delete [] totalCellIndexPairs;
+
+	const std::shared_ptr<const InterpretationConnections> connections = getInterpretationConnections();
+	std::copy(connections->connectionIndices.begin() + connections->connectionOffsetsOfInterpretations[interpretationIndex],
+		connections->connectionIndices.begin() + connections->connectionOffsetsOfInterpretations[interpretationIndex + 1], connectionIndices);
 }
 
 std::string GridConnectionSetRepresentation::getInterpretationUuidFromIndex(const unsigned int & interpretationIndex) const
@@ -461,6 +522,7 @@ void GridConnectionSetRepresentation::setConnectionInterpretationIndices(unsigne
 	}
 	hdfProxy->writeItemizedListOfList(gsoapProxy2_0_1->uuid, "InterpretationIndices", H5T_NATIVE_UINT, cumulative, interpretationIndiceCount, H5T_NATIVE_UINT, interpretationIndices, interpretationIndiceCount);
 	delete [] cumulative;
+	releaseInterpretationConnections();
 }
 
 void GridConnectionSetRepresentation::pushBackXmlInterpretation(RESQML2_NS::AbstractFeatureInterpretation* interp)
@@ -471,6 +533,7 @@ void GridConnectionSetRepresentation::pushBackXmlInterpretation(RESQML2_NS::Abst
 	}
 
 	rep->ConnectionInterpretations->FeatureInterpretation.push_back(interp->newResqmlReference());
+	releaseInterpretationConnections();
 }
 
 unsigned int GridConnectionSetRepresentation::getSupportingGridRepresentationCount() const
@@ -20,10 +20,45 @@ under the License.
 
 #include "resqml2/GridConnectionSetRepresentation.h"
 
+#include "common/GeometryCache.h"
+
 namespace RESQML2_0_1_NS
 {
 	class DLL_IMPORT_OR_EXPORT GridConnectionSetRepresentation : public RESQML2_NS::GridConnectionSetRepresentation
 	{
+	private:
+
+		/**
+		* The connections of each interpretation, owned by the geometry cache of the EPC document.
+		* It is a compressed sparse row : the connections of the interpretation i are in [offsets[i], offsets[i+1]) in increasing order.
+		* Only the connection indices are kept : the pairs of an interpretation are read on demand from the rows spanned by its connections.
+		*/
+		class InterpretationConnections : public COMMON_NS::GeometryCache::Entry
+		{
+		public:
+			std::vector<ULONG64> connectionOffsetsOfInterpretations;	// interpretation count + 1 values
+			std::vector<ULONG64> connectionIndices;
+
+			unsigned long long getByteSize() const;
+		};
+
+		/**
+		* Build the connections of each interpretation by reading the HDF5 datasets once and bucketing (counting sort) the connections per interpretation.
+		*/
+		InterpretationConnections* buildInterpretationConnections() const;
+
+		/**
+		* Get the connections of each interpretation from the geometry cache of the EPC document.
+		* They are transparently built at the first call or if they have been evicted from the cache.
+		* The returned pointer pins the connections : keep it while using its content.
+		*/
+		std::shared_ptr<const InterpretationConnections> getInterpretationConnections() const;
+
+		/**
+		* Release the connections of each interpretation from the geometry cache since the underlying datasets have changed.
+		*/
+		void releaseInterpretationConnections();
+
 	protected:
 		void init(soap* soapContext, const std::string & guid, const std::string & title);
 
@@ -72,9 +107,12 @@ namespace RESQML2_0_1_NS
 		GridConnectionSetRepresentation(gsoap_resqml2_0_1::_resqml2__GridConnectionSetRepresentation* fromGsoap) : RESQML2_NS::GridConnectionSetRepresentation(fromGsoap) {}
 
 		/**
-		* Destructor does nothing since the memory is managed by the gsoap context.
+		* Destructor only releases the cached connections of each interpretation since the memory is managed by the gsoap context.
 		*/
-		~GridConnectionSetRepresentation() {}
+		~GridConnectionSetRepresentation()
+		{
+			releaseInterpretationConnections();
+		}
 
 		std::string getHdfProxyUuid() const;
 
@@ -90,7 +128,8 @@ namespace RESQML2_0_1_NS
 
 		/**
 		* Get the cell index pairs count which correspond to a particular interpretation.
-		* @param interpretationIndex The index of the interpretation in the collection of feature interpretation of this grid connection set.
+		* The first call builds an index from the interpretations to the connections which is kept in the geometry cache of the EPC document.
+		* @param interpretationIndex The index of the interpretation in the collection of feature interpretation of this grid connection set. It must be lesser than getInterpretationCount().
 		*/
 		unsigned int getCellIndexPairCountFromInterpretationIndex(const unsigned int & interpretationIndex) const;
 
@@ -118,6 +157,8 @@ namespace RESQML2_0_1_NS
 
 		/**
 		* Get the cell index pairs, the grid index pairs (optional) and the local face pairs (optional) which correspond to a particular  interpretation.
+		* The first call builds an index from the interpretations to the connections which is kept in the geometry cache of the EPC document :
+		* next calls only read the rows of the datasets from the first to the last connection of the interpretation.
 		* @param cellIndexPairs			Mandatory. Must be allocated with getCellIndexPairCountFromIndex first.
 		* @param gridIndexPairs			Optional (put null if you don't want it). Must be allocated with getCellIndexPairCountFromIndex first.
 		* @param localFaceIndexPairs	Optional (put null if you don't want it). Must be allocated with getCellIndexPairCountFromIndex first.
@@ -125,6 +166,13 @@ namespace RESQML2_0_1_NS
 		*/
 		void getGridConnectionSetInformationFromInterpretationIndex(ULONG64 * cellIndexPairs, unsigned short * gridIndexPairs, int * localFaceIndexPairs, const unsigned int & interpretationIndex) const;
 
+		/**
+		* Get the indices of the connections (i.e. of the cell index pairs) which correspond to a particular interpretation, in increasing order.
+		* @param connectionIndices		Must be allocated with getCellIndexPairCountFromInterpretationIndex first.
+		* @param interpretationIndex	The index of the interpretation in the collection of feature interpretation of this grid connection set.
+		*/
+		void getConnectionIndicesFromInterpretationIndex(ULONG64 * connectionIndices, const unsigned int & interpretationIndex) const;
+
 		/**
 		* Get the UUID of a particular interpretation of this grid connection set.
 		* @param interpretationIndex The index of the interpretation in the collection of feature interpretation of this grid connection set.
@@ -20,6 +20,8 @@ under the License.
 #include "resqml2_0_1/IjkGridExplicitRepresentation.h"
 
 #include <stdexcept>
+#include <algorithm>
+#include <vector>
 
 #include "hdf5.h"
 
@@ -28,6 +30,8 @@ under the License.
 #include "resqml2/AbstractValuesProperty.h"
 #include "common/AbstractHdfProxy.h"
 
+#include "tools/Parallel.h"
+
 using namespace std;
 using namespace gsoap_resqml2_0_1;
 using namespace RESQML2_0_1_NS;
@@ -167,143 +171,8 @@ void IjkGridExplicitRepresentation::getXyzPointsOfBlockOfPatch(const unsigned in
 	resqml2__PointGeometry* pointGeom = getPointGeometry2_0_1(patchIndex);
 	if (pointGeom != nullptr && pointGeom->Points->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__Point3dHdf5Array)
 	{
-		unsigned long splitCoordinateLineCount = getSplitCoordinateLineCount();
-
-		if (splitCoordinateLineCount == 0)
-		{
-			const std::string pathInHdfFile = static_cast<resqml2__Point3dHdf5Array*>(pointGeom->Points)->Coordinates->PathInHdfFile;
-		
-			unsigned long long* valueCountPerDimension = new unsigned long long[4];
-			valueCountPerDimension[0] = blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart + 1;
-			valueCountPerDimension[1] = blockInformation->jInterfaceEnd - blockInformation->jInterfaceStart + 1;
-			valueCountPerDimension[2] = blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart + 1;
-			valueCountPerDimension[3] = 3;
-			unsigned long long* offsetPerDimension = new unsigned long long[4];
-			offsetPerDimension[0] = blockInformation->kInterfaceStart;
-			offsetPerDimension[1] = blockInformation->jInterfaceStart;
-			offsetPerDimension[2] = blockInformation->iInterfaceStart;
-			offsetPerDimension[3] = 0;
-
-			hdfProxy->readArrayNdOfDoubleValues(
-				static_cast<resqml2__Point3dHdf5Array*>(pointGeom->Points)->Coordinates->PathInHdfFile,
-				xyzPoints,
-				valueCountPerDimension,
-				offsetPerDimension,
-				4);
-			delete[] valueCountPerDimension;
-			delete[] offsetPerDimension;
-		}
-		else
-		{
-			const std::string pathInHdfFile = static_cast<resqml2__Point3dHdf5Array*>(pointGeom->Points)->Coordinates->PathInHdfFile;
-		
-			unsigned long long* blockCountPerDimension = new unsigned long long[3];
-			blockCountPerDimension[0] = 1;
-			blockCountPerDimension[1] = blockInformation->jInterfaceEnd - blockInformation->jInterfaceStart + 1;
-			blockCountPerDimension[2] = 1;
-			unsigned long long* offsetPerDimension = new unsigned long long[3];
-			offsetPerDimension[0] = blockInformation->kInterfaceStart;
-			offsetPerDimension[1] = blockInformation->jInterfaceStart * (getICellCount() + 1) + blockInformation->iInterfaceStart;
-			offsetPerDimension[2] = 0;
-			unsigned long long* strideInEachDimension = new unsigned long long[3];
-			strideInEachDimension[0] = 1;
-			strideInEachDimension[1] = (blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart + 1) + ((getICellCount() + 1) - (blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart + 1));
-			strideInEachDimension[2] = 1;
-			unsigned long long* blockSizeInEachDimension = new unsigned long long[3];
-			blockSizeInEachDimension[0] = blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart + 1;
-			blockSizeInEachDimension[1] = blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart + 1;
-			blockSizeInEachDimension[2] = 3;
-		
-			int dataset, filespace;
-			hdfProxy->selectArrayNdOfValues(
-				pathInHdfFile,
-				blockCountPerDimension,
-				offsetPerDimension,
-				strideInEachDimension,
-				blockSizeInEachDimension,
-				3,
-				true,
-				dataset,
-				filespace);
-
-			unsigned long long slab_size = 1;
-			for (unsigned int h = 0; h < 3; ++h) {
-				slab_size *= blockSizeInEachDimension[h];
-			}
-			for (unsigned int h = 0; h < 3; ++h) {
-				slab_size *= blockCountPerDimension[h];
-			}
-
-			// Adding block split coordinate lines to the selected regions
-			// traversing all bloc pillars in direction i and then in direction j
-			for (unsigned int jPillarIndex = blockInformation->jInterfaceStart; jPillarIndex <= blockInformation->jInterfaceEnd; ++jPillarIndex)
-			{
-				for (unsigned int iPillarIndex = blockInformation->iInterfaceStart; iPillarIndex <= blockInformation->iInterfaceEnd; iPillarIndex++)
-				{
-					unsigned int pillarIndex = getGlobalIndexPillarFromIjIndex(iPillarIndex, jPillarIndex);
-
-					if (splitInformation[pillarIndex].size() != 0)
-					{
-						// here is a split pillar
-
-						// traversing all split coordinate lines corresponding to the current splitted pillar
-						for (unsigned int splitCoordinateLineIndex = 0; splitCoordinateLineIndex < splitInformation[pillarIndex].size(); ++splitCoordinateLineIndex)
-						{
-							// traversing adjacent columns, it current column is in the bloc, corresponding coordinate line is added to the selected region
-							for (unsigned int columnIndex = 0; columnIndex < splitInformation[pillarIndex][splitCoordinateLineIndex].second.size(); ++columnIndex)
-							{
-								unsigned int iColumnIndex = getIColumnFromGlobalIndex(splitInformation[pillarIndex][splitCoordinateLineIndex].second[columnIndex]);
-								unsigned int jColumnIndex = getJColumnFromGlobalIndex(splitInformation[pillarIndex][splitCoordinateLineIndex].second[columnIndex]);
-								
-								if ((iColumnIndex >= blockInformation->iInterfaceStart && iColumnIndex < blockInformation->iInterfaceEnd) && (jColumnIndex >= blockInformation->jInterfaceStart && jColumnIndex < blockInformation->jInterfaceEnd))
-								{
-									// here is a split coordinate line impacting the bloc
-									unsigned int splitCoordinateLineHdfIndex = (getICellCount() + 1) * (getJCellCount() + 1) + splitInformation[pillarIndex][splitCoordinateLineIndex].first;
-
-									// the split coordinate line is added to the selected region
-									blockCountPerDimension[0] = 1;
-									blockCountPerDimension[1] = 1;
-									blockCountPerDimension[2] = 1;
-									offsetPerDimension[0] = blockInformation->kInterfaceStart;
-									offsetPerDimension[1] = splitCoordinateLineHdfIndex;
-									offsetPerDimension[2] = 0;
-									strideInEachDimension[0] = 1;
-									strideInEachDimension[1] = 1;
-									strideInEachDimension[2] = 1;
-									blockSizeInEachDimension[0] = blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart + 1;
-									blockSizeInEachDimension[1] = 1;
-									blockSizeInEachDimension[2] = 3;
-
-									hdfProxy->selectArrayNdOfValues(
-										pathInHdfFile,
-										blockCountPerDimension,
-										offsetPerDimension,
-										strideInEachDimension,
-										blockSizeInEachDimension,
-										3,
-										false,
-										dataset,
-										filespace);
-
-									slab_size += (blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart + 1) * 3;
-
-									break; // in order to be sure not adding twice a same coordinate line if it is adjacent to several columns within the bloc
-								}
-							}
-						}
-					}
-				}
-			}
-
-			// reading values corresponding to the whole selected region (non splitted and splitted part)
-			hdfProxy->readArrayNdOfDoubleValues(dataset, filespace,
-				xyzPoints, slab_size);
-
-			delete[] blockCountPerDimension;
-			delete[] offsetPerDimension;
-			delete[] strideInEachDimension;
-			delete[] blockSizeInEachDimension;
-		}
+		// Only the block K interfaces, pillars and split coordinate lines are selected (one hyperslab per run of consecutive split coordinate lines).
+		readBlockOfNodeDataset(static_cast<resqml2__Point3dHdf5Array*>(pointGeom->Points)->Coordinates->PathInHdfFile, xyzPoints, 3);
 	}
 	else {
 		throw invalid_argument("The geometry of the grid either does not exist or it is not an explicit one.");
@@ -496,6 +365,210 @@ void IjkGridExplicitRepresentation::setGeometryAsCoordinateLineNodes(
 	}
 }
 
+void IjkGridExplicitRepresentation::setGeometryAsCoordinateLineNodesWithoutPoints(
+	const resqml2__PillarShape & mostComplexPillarGeometry,
+	const resqml2__KDirection & kDirectionKind,
+	const bool & isRightHanded,
+	COMMON_NS::AbstractHdfProxy * proxy,
+	const unsigned long & splitCoordinateLineCount, unsigned int * pillarOfCoordinateLine,
+	unsigned int * splitCoordinateLineColumnCumulativeCount, unsigned int * splitCoordinateLineColumns,
+	char * definedPillars)
+{
+	if (splitCoordinateLineCount != 0 && (pillarOfCoordinateLine == nullptr || splitCoordinateLineColumnCumulativeCount == nullptr || splitCoordinateLineColumns == nullptr)) {
+		throw invalid_argument("The definition of the split coordinate lines is incomplete.");
+	}
+
+	const std::string hdfDatasetPrefix = "/RESQML/" + gsoapProxy2_0_1->uuid;
+	setGeometryAsCoordinateLineNodesUsingExistingDatasets(mostComplexPillarGeometry, kDirectionKind, isRightHanded,
+		hdfDatasetPrefix + "/Points", proxy,
+		splitCoordinateLineCount, pillarOfCoordinateLine == nullptr ? "" : hdfDatasetPrefix + "/PillarIndices",
+		splitCoordinateLineColumnCumulativeCount == nullptr ? "" : hdfDatasetPrefix + "/ColumnsPerSplitCoordinateLine/" + CUMULATIVE_LENGTH_DS_NAME, splitCoordinateLineColumns == nullptr ? "" : hdfDatasetPrefix + "/ColumnsPerSplitCoordinateLine/" + ELEMENTS_DS_NAME,
+		definedPillars == nullptr ? "" : hdfDatasetPrefix + "/PillarGeometryIsDefined");
+
+	// Pillar defined
+	if (definedPillars != nullptr) {
+		hsize_t pillarGeometryIsDefinedCount[2] = { getJCellCount() + 1, getICellCount() + 1 };
+		hdfProxy->writeArrayNd(gsoapProxy2_0_1->uuid, "PillarGeometryIsDefined", H5T_NATIVE_CHAR, definedPillars, pillarGeometryIsDefinedCount, 2);
+	}
+
+	if (splitCoordinateLineCount != 0)
+	{
+		// split coordinate lines
+		hsize_t splitCount[1] = { splitCoordinateLineCount };
+		hdfProxy->writeArrayNd(gsoapProxy2_0_1->uuid, "PillarIndices", H5T_NATIVE_UINT, pillarOfCoordinateLine, splitCount, 1);
+		hdfProxy->writeItemizedListOfList(gsoapProxy2_0_1->uuid, "ColumnsPerSplitCoordinateLine", H5T_NATIVE_UINT, splitCoordinateLineColumnCumulativeCount, splitCoordinateLineCount, H5T_NATIVE_UINT, splitCoordinateLineColumns, splitCoordinateLineColumnCumulativeCount[splitCoordinateLineCount - 1]);
+	}
+
+	// Points : the dataset is only created here.
+	unsigned long long numValues[4];
+	numValues[0] = getKCellCount() + 1;
+	if (splitCoordinateLineCount == 0) {
+		numValues[1] = getJCellCount() + 1;
+		numValues[2] = getICellCount() + 1;
+		numValues[3] = 3; // 3 for X, Y and Z
+		hdfProxy->createArrayNd(gsoapProxy2_0_1->uuid, "Points", H5T_NATIVE_DOUBLE, numValues, 4);
+	}
+	else {
+		numValues[1] = static_cast<ULONG64>(getJCellCount() + 1) * (getICellCount() + 1) + splitCoordinateLineCount;
+		numValues[2] = 3; // 3 for X, Y and Z
+		hdfProxy->createArrayNd(gsoapProxy2_0_1->uuid, "Points", H5T_NATIVE_DOUBLE, numValues, 3);
+	}
+}
+
+void IjkGridExplicitRepresentation::setGeometryAsCoordinateLineNodesByLayer(
+	const resqml2__PillarShape & mostComplexPillarGeometry,
+	const resqml2__KDirection & kDirectionKind,
+	const bool & isRightHanded,
+	PointLayerGenerator * generator, COMMON_NS::AbstractHdfProxy * proxy,
+	const unsigned long & splitCoordinateLineCount, unsigned int * pillarOfCoordinateLine,
+	unsigned int * splitCoordinateLineColumnCumulativeCount, unsigned int * splitCoordinateLineColumns,
+	char * definedPillars)
+{
+	if (generator == nullptr) {
+		throw invalid_argument("The generator of the points of the ijk grid cannot be null.");
+	}
+
+	setGeometryAsCoordinateLineNodesWithoutPoints(mostComplexPillarGeometry, kDirectionKind, isRightHanded, proxy,
+		splitCoordinateLineCount, pillarOfCoordinateLine, splitCoordinateLineColumnCumulativeCount, splitCoordinateLineColumns, definedPillars);
+
+	// A window of consecutive K interfaces is generated concurrently (one K interface per thread) and then written at once
+	// since consecutive K interfaces are contiguous in the points dataset.
+	const unsigned int kInterfaceCount = getKCellCount() + 1;
+	const ULONG64 layerValueCount = (static_cast<ULONG64>(getJCellCount() + 1) * (getICellCount() + 1) + splitCoordinateLineCount) * 3;
+	const unsigned int dimCount = splitCoordinateLineCount == 0 ? 4 : 3;
+	unsigned long long windowCount[4] = { 0, getJCellCount() + 1, getICellCount() + 1, 3 };
+	if (splitCoordinateLineCount != 0) {
+		windowCount[1] = layerValueCount / 3;
+		windowCount[2] = 3;
+	}
+	unsigned long long windowOffset[4] = { 0, 0, 0, 0 };
+
+	const unsigned int maxWindowSize = parallel::getChunkCount(kInterfaceCount, 1);
+	std::vector<double> windowPoints(maxWindowSize * layerValueCount);
+	for (unsigned int windowStart = 0; windowStart < kInterfaceCount; windowStart += maxWindowSize) {
+		const unsigned int windowSize = (std::min)(maxWindowSize, kInterfaceCount - windowStart);
+		parallel::forEachChunk(windowSize, windowSize, [&](const unsigned int &, const uint64_t & begin, const uint64_t & end) {
+			for (uint64_t layer = begin; layer < end; ++layer) {
+				generator->generateLayer(windowStart + static_cast<unsigned int>(layer), &windowPoints[layer * layerValueCount]);
+			}
+		});
+
+		// HDF5 is only called from the calling thread.
+		windowCount[0] = windowSize;
+		windowOffset[0] = windowStart;
+		hdfProxy->writeArrayNdSlab(gsoapProxy2_0_1->uuid, "Points", H5T_NATIVE_DOUBLE, &windowPoints[0], windowCount, windowOffset, dimCount);
+	}
+}
+
+void IjkGridExplicitRepresentation::setGeometryAsCoordinateLineNodesByISlab(
+	const resqml2__PillarShape & mostComplexPillarGeometry,
+	const resqml2__KDirection & kDirectionKind,
+	const bool & isRightHanded,
+	PointISlabGenerator * generator, COMMON_NS::AbstractHdfProxy * proxy,
+	const unsigned long & splitCoordinateLineCount, unsigned int * pillarOfCoordinateLine,
+	unsigned int * splitCoordinateLineColumnCumulativeCount, unsigned int * splitCoordinateLineColumns,
+	char * definedPillars)
+{
+	if (generator == nullptr) {
+		throw invalid_argument("The generator of the points of the ijk grid cannot be null.");
+	}
+
+	const unsigned int iPillarCount = getICellCount() + 1;
+	const unsigned int jPillarCount = getJCellCount() + 1;
+	const unsigned int kInterfaceCount = getKCellCount() + 1;
+	const ULONG64 pillarCount = static_cast<ULONG64>(iPillarCount) * jPillarCount;
+
+	// Group the split coordinate lines by J index of their pillar (counting sort which keeps the increasing split coordinate line order).
+	std::vector<ULONG64> splitCoordinateLineOfSlabStart(jPillarCount + 1, 0);
+	std::vector<ULONG64> splitCoordinateLinesOfSlabs(splitCoordinateLineCount);
+	if (splitCoordinateLineCount != 0 && pillarOfCoordinateLine != nullptr) {
+		for (ULONG64 splitIndex = 0; splitIndex < splitCoordinateLineCount; ++splitIndex) {
+			if (pillarOfCoordinateLine[splitIndex] >= pillarCount) {
+				throw out_of_range("The pillar of a split coordinate line is out of range.");
+			}
+			++splitCoordinateLineOfSlabStart[pillarOfCoordinateLine[splitIndex] / iPillarCount + 1];
+		}
+		for (unsigned int jPillar = 0; jPillar < jPillarCount; ++jPillar) {
+			splitCoordinateLineOfSlabStart[jPillar + 1] += splitCoordinateLineOfSlabStart[jPillar];
+		}
+		std::vector<ULONG64> nextSplitCoordinateLineOfSlab(splitCoordinateLineOfSlabStart.begin(), splitCoordinateLineOfSlabStart.end() - 1);
+		for (ULONG64 splitIndex = 0; splitIndex < splitCoordinateLineCount; ++splitIndex) {
+			splitCoordinateLinesOfSlabs[nextSplitCoordinateLineOfSlab[pillarOfCoordinateLine[splitIndex] / iPillarCount]++] = splitIndex;
+		}
+	}
+	ULONG64 maxSplitCoordinateLineCountOfSlab = 0;
+	for (unsigned int jPillar = 0; jPillar < jPillarCount; ++jPillar) {
+		maxSplitCoordinateLineCountOfSlab = (std::max)(maxSplitCoordinateLineCountOfSlab, splitCoordinateLineOfSlabStart[jPillar + 1] - splitCoordinateLineOfSlabStart[jPillar]);
+	}
+
+	setGeometryAsCoordinateLineNodesWithoutPoints(mostComplexPillarGeometry, kDirectionKind, isRightHanded, proxy,
+		splitCoordinateLineCount, pillarOfCoordinateLine, splitCoordinateLineColumnCumulativeCount, splitCoordinateLineColumns, definedPillars);
+
+	// A window of I slabs is generated concurrently (one I slab per thread) and then written slab after slab.
+	const ULONG64 pillarValueCountOfSlab = static_cast<ULONG64>(iPillarCount) * kInterfaceCount * 3;
+	const ULONG64 splitValueCountOfSlab = maxSplitCoordinateLineCountOfSlab * kInterfaceCount * 3;
+	const unsigned int maxWindowSize = parallel::getChunkCount(jPillarCount, 1);
+	std::vector<double> windowPillarPoints(maxWindowSize * pillarValueCountOfSlab);
+	std::vector<double> windowSplitPoints(maxWindowSize * splitValueCountOfSlab + 1);
+	std::vector<double> splitRunPoints;
+	for (unsigned int windowStart = 0; windowStart < jPillarCount; windowStart += maxWindowSize) {
+		const unsigned int windowSize = (std::min)(maxWindowSize, jPillarCount - windowStart);
+		parallel::forEachChunk(windowSize, windowSize, [&](const unsigned int &, const uint64_t & begin, const uint64_t & end) {
+			for (uint64_t slab = begin; slab < end; ++slab) {
+				generator->generateISlab(windowStart + static_cast<unsigned int>(slab), &windowPillarPoints[slab * pillarValueCountOfSlab], &windowSplitPoints[slab * splitValueCountOfSlab]);
+			}
+		});
+
+		// HDF5 is only called from the calling thread.
+		for (unsigned int slab = 0; slab < windowSize; ++slab) {
+			const unsigned int jPillar = windowStart + slab;
+			if (splitCoordinateLineCount == 0) {
+				unsigned long long slabCount[4] = { kInterfaceCount, 1, iPillarCount, 3 };
+				unsigned long long slabOffset[4] = { 0, jPillar, 0, 0 };
+				hdfProxy->writeArrayNdSlab(gsoapProxy2_0_1->uuid, "Points", H5T_NATIVE_DOUBLE, &windowPillarPoints[slab * pillarValueCountOfSlab], slabCount, slabOffset, 4);
+				continue;
+			}
+
+			unsigned long long slabCount[3] = { kInterfaceCount, iPillarCount, 3 };
+			unsigned long long slabOffset[3] = { 0, static_cast<ULONG64>(jPillar) * iPillarCount, 0 };
+			hdfProxy->writeArrayNdSlab(gsoapProxy2_0_1->uuid, "Points", H5T_NATIVE_DOUBLE, &windowPillarPoints[slab * pillarValueCountOfSlab], slabCount, slabOffset, 3);
+
+			// The split coordinate lines of the slab are written by runs of consecutive split coordinate line indices.
+			const ULONG64 splitStart = splitCoordinateLineOfSlabStart[jPillar];
+			const ULONG64 splitEnd = splitCoordinateLineOfSlabStart[jPillar + 1];
+			double * slabSplitPoints = &windowSplitPoints[slab * splitValueCountOfSlab];
+			ULONG64 runStart = splitStart;
+			while (runStart < splitEnd) {
+				ULONG64 runEnd = runStart + 1;
+				while (runEnd < splitEnd && splitCoordinateLinesOfSlabs[runEnd] == splitCoordinateLinesOfSlabs[runEnd - 1] + 1) {
+					++runEnd;
+				}
+				const ULONG64 runSize = runEnd - runStart;
+				double * runPoints = slabSplitPoints;
+				if (runSize != splitEnd - splitStart) {
+					// Gather the run (ordered by split coordinate line then k in the slab) in a buffer ordered the same way.
+					splitRunPoints.resize(runSize * kInterfaceCount * 3);
+					const ULONG64 splitCountOfSlab = splitEnd - splitStart;
+					for (unsigned int kInterface = 0; kInterface < kInterfaceCount; ++kInterface) {
+						for (ULONG64 runIndex = 0; runIndex < runSize; ++runIndex) {
+							const double * source = slabSplitPoints + (kInterface * splitCountOfSlab + runStart - splitStart + runIndex) * 3;
+							double * target = &splitRunPoints[(kInterface * runSize + runIndex) * 3];
+							target[0] = source[0];
+							target[1] = source[1];
+							target[2] = source[2];
+						}
+					}
+					runPoints = &splitRunPoints[0];
+				}
+				unsigned long long runCount[3] = { kInterfaceCount, runSize, 3 };
+				unsigned long long runOffset[3] = { 0, pillarCount + splitCoordinateLinesOfSlabs[runStart], 0 };
+				hdfProxy->writeArrayNdSlab(gsoapProxy2_0_1->uuid, "Points", H5T_NATIVE_DOUBLE, runPoints, runCount, runOffset, 3);
+				runStart = runEnd;
+			}
+		}
+	}
+}
+
 AbstractIjkGridRepresentation::geometryKind IjkGridExplicitRepresentation::getGeometryKind() const
 {
 	return EXPLICIT;
@@ -104,6 +104,70 @@ namespace RESQML2_0_1_NS
 			unsigned int * splitCoordinateLineColumnCumulativeCount = nullptr, unsigned int * splitCoordinateLineColumns = nullptr,
 			char * definedPillars = nullptr);
 
+		/**
+		* Generates the XYZ points of an explicit IJK grid one K interface at a time.
+		* It allows to write the geometry of a grid which does not fit in memory.
+		*/
+		class DLL_IMPORT_OR_EXPORT PointLayerGenerator
+		{
+		public:
+			virtual ~PointLayerGenerator() {}
+
+			/**
+			* Fill the XYZ points of a K interface.
+			* It is called concurrently by several threads for distinct K interfaces (see parallel::setMaxThreadCount) and in no particular order.
+			* @param kInterfaceIndex	The index of the K interface to generate.
+			* @param points				XYZ double triplets ordered by i then j then split. It is preallocated with a count of ((iCellCount+1) * (jCellCount+1) + splitCoordinateLineCount) * 3.
+			*/
+			virtual void generateLayer(const unsigned int & kInterfaceIndex, double * points) = 0;
+		};
+
+		/**
+		* Generates the XYZ points of an explicit IJK grid one I slab at a time.
+		* An I slab is made of the iCellCount+1 pillars sharing the same J index and of the split coordinate lines of these pillars, on all K interfaces.
+		*/
+		class DLL_IMPORT_OR_EXPORT PointISlabGenerator
+		{
+		public:
+			virtual ~PointISlabGenerator() {}
+
+			/**
+			* Fill the XYZ points of an I slab.
+			* It is called concurrently by several threads for distinct I slabs (see parallel::setMaxThreadCount) and in no particular order.
+			* @param jPillarIndex				The J index of the pillars of the I slab to generate.
+			* @param pillarPoints				XYZ double triplets ordered by i then k. It is preallocated with a count of (iCellCount+1) * (kCellCount+1) * 3.
+			* @param splitCoordinateLinePoints	XYZ double triplets ordered by split coordinate line then k. The split coordinate lines are the ones whose pillar has the J index jPillarIndex, in increasing split coordinate line index.
+			*									It is preallocated with a count of (kCellCount+1) * 3 per split coordinate line of the I slab.
+			*/
+			virtual void generateISlab(const unsigned int & jPillarIndex, double * pillarPoints, double * splitCoordinateLinePoints) = 0;
+		};
+
+		/**
+		* Same as setGeometryAsCoordinateLineNodes where the points are not given at once but generated and written by K interface.
+		* The K interfaces are generated concurrently by windows of parallel::getMaxThreadCount() interfaces which are written before the next window is generated.
+		* Only one window of K interfaces is kept in memory whatever the count of K cells.
+		* @param generator	The generator of the points of each K interface. It cannot be null.
+		*/
+		void setGeometryAsCoordinateLineNodesByLayer(
+			const gsoap_resqml2_0_1::resqml2__PillarShape & mostComplexPillarGeometry, const gsoap_resqml2_0_1::resqml2__KDirection & kDirectionKind, const bool & isRightHanded,
+			PointLayerGenerator * generator, COMMON_NS::AbstractHdfProxy* proxy,
+			const unsigned long & splitCoordinateLineCount = 0, unsigned int * pillarOfCoordinateLine = nullptr,
+			unsigned int * splitCoordinateLineColumnCumulativeCount = nullptr, unsigned int * splitCoordinateLineColumns = nullptr,
+			char * definedPillars = nullptr);
+
+		/**
+		* Same as setGeometryAsCoordinateLineNodes where the points are not given at once but generated and written by I slab.
+		* It suits generators which naturally work pillar after pillar (for instance when all the K interfaces of a pillar come from the same computation).
+		* The I slabs are generated concurrently by windows of parallel::getMaxThreadCount() slabs which are written before the next window is generated.
+		* @param generator	The generator of the points of each I slab. It cannot be null.
+		*/
+		void setGeometryAsCoordinateLineNodesByISlab(
+			const gsoap_resqml2_0_1::resqml2__PillarShape & mostComplexPillarGeometry, const gsoap_resqml2_0_1::resqml2__KDirection & kDirectionKind, const bool & isRightHanded,
+			PointISlabGenerator * generator, COMMON_NS::AbstractHdfProxy* proxy,
+			const unsigned long & splitCoordinateLineCount = 0, unsigned int * pillarOfCoordinateLine = nullptr,
+			unsigned int * splitCoordinateLineColumnCumulativeCount = nullptr, unsigned int * splitCoordinateLineColumns = nullptr,
+			char * definedPillars = nullptr);
+
 		/**
 		* Same as setGeometryAsCoordinateLineNodes where the hdf datasets are already written in the the file.
 		*/
@@ -115,6 +179,18 @@ namespace RESQML2_0_1_NS
 			const std::string & definedPillars = "");
 
 		geometryKind getGeometryKind() const;
+
+	private:
+		/**
+		* Set the geometry and write all its hdf datasets except the points which are written afterwards by the caller in the created (but empty) points dataset.
+		* Without split coordinate lines, the points dataset is 4d (K, J, I, XYZ) else it is 3d (K, coordinate line, XYZ).
+		*/
+		void setGeometryAsCoordinateLineNodesWithoutPoints(
+			const gsoap_resqml2_0_1::resqml2__PillarShape & mostComplexPillarGeometry, const gsoap_resqml2_0_1::resqml2__KDirection & kDirectionKind, const bool & isRightHanded,
+			COMMON_NS::AbstractHdfProxy* proxy,
+			const unsigned long & splitCoordinateLineCount, unsigned int * pillarOfCoordinateLine,
+			unsigned int * splitCoordinateLineColumnCumulativeCount, unsigned int * splitCoordinateLineColumns,
+			char * definedPillars);
 	};
 }
 
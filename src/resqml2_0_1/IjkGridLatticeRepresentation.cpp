@@ -104,12 +104,77 @@ void IjkGridLatticeRepresentation::getXyzPointsOfPatch(const unsigned int & patc
 {
 	if (patchIndex < getPatchCount())
 	{
-		throw logic_error("Not yet implemented. Please use lattice information.");
+		getXyzPointsOfNodeBox(0, getICellCount(), 0, getJCellCount(), 0, getKCellCount(), xyzPoints);
 	}
 	else
 		throw range_error("An ijk grid has a maximum of one patch.");
 }
 
+void IjkGridLatticeRepresentation::getXyzPointsOfKInterfaceSequenceOfPatch(const unsigned int & kInterfaceStart, const unsigned int & kInterfaceEnd, const unsigned int & patchIndex, double * xyzPoints)
+{
+	if (kInterfaceStart > getKCellCount() || kInterfaceEnd > getKCellCount())
+		throw range_error("kInterfaceStart and/or kInterfaceEnd is/are out of boundaries.");
+	if (kInterfaceStart > kInterfaceEnd)
+		throw range_error("kInterfaceStart > kInterfaceEnd");
+	if (patchIndex >= getPatchCount())
+		throw range_error("An ijk grid has a maximum of one patch.");
+	if (xyzPoints == nullptr)
+		throw invalid_argument("xyzPoints must be allocated.");
+
+	getXyzPointsOfNodeBox(0, getICellCount(), 0, getJCellCount(), kInterfaceStart, kInterfaceEnd, xyzPoints);
+}
+
+void IjkGridLatticeRepresentation::getXyzPointsOfBlockOfPatch(const unsigned int & patchIndex, double * xyzPoints)
+{
+	if (blockInformation == nullptr)
+		throw invalid_argument("The block information must have been loaded first.");
+	if (patchIndex >= getPatchCount())
+		throw range_error("An ijk grid has a maximum of one patch.");
+	if (xyzPoints == nullptr)
+		throw invalid_argument("xyzPoints must be allocated.");
+
+	getXyzPointsOfNodeBox(blockInformation->iInterfaceStart, blockInformation->iInterfaceEnd,
+		blockInformation->jInterfaceStart, blockInformation->jInterfaceEnd,
+		blockInformation->kInterfaceStart, blockInformation->kInterfaceEnd, xyzPoints);
+}
+
+void IjkGridLatticeRepresentation::getXyzPointsOfNodeBox(const unsigned int & iStart, const unsigned int & iEnd,
+	const unsigned int & jStart, const unsigned int & jEnd,
+	const unsigned int & kStart, const unsigned int & kEnd, double * xyzPoints) const
+{
+	resqml2__Point3dLatticeArray* arrayLatticeOfPoints3d = getArrayLatticeOfPoints3d();
+	if (arrayLatticeOfPoints3d == nullptr || arrayLatticeOfPoints3d->Offset.size() != 3)
+		throw invalid_argument("The geometry of the grid either does not exist or it is not a 3d lattice one.");
+
+	// Offsets are ordered from the slowest axis to the fastest axis : k, j, i
+	double stepK[3], stepJ[3], stepI[3];
+	double* steps[3] = { stepK, stepJ, stepI };
+	for (unsigned int dim = 0; dim < 3; ++dim) {
+		if (arrayLatticeOfPoints3d->Offset[dim]->Spacing->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__DoubleConstantArray)
+			throw logic_error("Non constant spacing in lattice grids is not implemented yet.");
+		const double spacing = static_cast<resqml2__DoubleConstantArray*>(arrayLatticeOfPoints3d->Offset[dim]->Spacing)->Value;
+		steps[dim][0] = arrayLatticeOfPoints3d->Offset[dim]->Offset->Coordinate1 * spacing;
+		steps[dim][1] = arrayLatticeOfPoints3d->Offset[dim]->Offset->Coordinate2 * spacing;
+		steps[dim][2] = arrayLatticeOfPoints3d->Offset[dim]->Offset->Coordinate3 * spacing;
+	}
+	const double origin[3] = { arrayLatticeOfPoints3d->Origin->Coordinate1, arrayLatticeOfPoints3d->Origin->Coordinate2, arrayLatticeOfPoints3d->Origin->Coordinate3 };
+
+	ULONG64 index = 0;
+	for (unsigned int k = kStart; k <= kEnd; ++k) {
+		for (unsigned int j = jStart; j <= jEnd; ++j) {
+			const double rowOrigin[3] = {
+				origin[0] + k * stepK[0] + j * stepJ[0],
+				origin[1] + k * stepK[1] + j * stepJ[1],
+				origin[2] + k * stepK[2] + j * stepJ[2] };
+			for (unsigned int i = iStart; i <= iEnd; ++i) {
+				xyzPoints[index++] = rowOrigin[0] + i * stepI[0];
+				xyzPoints[index++] = rowOrigin[1] + i * stepI[1];
+				xyzPoints[index++] = rowOrigin[2] + i * stepI[2];
+			}
+		}
+	}
+}
+
 resqml2__Point3dLatticeArray* IjkGridLatticeRepresentation::getArrayLatticeOfPoints3d() const
 {
     resqml2__Point3dLatticeArray* result = nullptr;
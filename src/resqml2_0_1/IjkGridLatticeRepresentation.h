@@ -26,6 +26,15 @@ namespace RESQML2_0_1_NS
 	{
 	private :
 		gsoap_resqml2_0_1::resqml2__Point3dLatticeArray* getArrayLatticeOfPoints3d() const;
+
+		/**
+		* Compute the XYZ points of a box of nodes of the lattice (all bounds are inclusive).
+		* Node indexing and node locations are purely arithmetic in a lattice : no HDF5 access is needed.
+		* @param xyzPoints	It must be preallocated with a size of 3 * the node count of the box. Nodes are ordered i then j then k.
+		*/
+		void getXyzPointsOfNodeBox(const unsigned int & iStart, const unsigned int & iEnd,
+			const unsigned int & jStart, const unsigned int & jEnd,
+			const unsigned int & kStart, const unsigned int & kEnd, double * xyzPoints) const;
 	public:
 
 		IjkGridLatticeRepresentation(soap* soapContext, RESQML2_NS::AbstractLocal3dCrs * crs,
@@ -69,6 +78,18 @@ namespace RESQML2_0_1_NS
 		*/
 		void getXyzPointsOfPatch(const unsigned int & patchIndex, double * xyzPoints) const;
 
+		/**
+		* Get all the XYZ points of a particular sequence of K interfaces of a particular patch of this representation.
+		* XYZ points are given in the local CRS and are computed from the lattice definition.
+		*/
+		void getXyzPointsOfKInterfaceSequenceOfPatch(const unsigned int & kInterfaceStart, const unsigned int & kInterfaceEnd, const unsigned int & patchIndex, double * xyzPoints);
+
+		/**
+		* Get all the XYZ points of the current block. Block information must be loaded.
+		* XYZ points are given in the local CRS and are computed from the lattice definition.
+		*/
+		void getXyzPointsOfBlockOfPatch(const unsigned int & patchIndex, double * xyzPoints);
+
 		/**
 		* Get the X origin of this geometry.
 		* X coordinate is given in the local CRS.
@@ -20,6 +20,8 @@ under the License.
 #include "resqml2_0_1/IjkGridParametricRepresentation.h"
 
 #include <stdexcept>
+#include <algorithm>
+#include <vector>
 
 #include "hdf5.h"
 
@@ -28,6 +30,8 @@ under the License.
 #include "resqml2/AbstractValuesProperty.h"
 #include "common/AbstractHdfProxy.h"
 
+#include "tools/Parallel.h"
+
 using namespace std;
 using namespace gsoap_resqml2_0_1;
 using namespace RESQML2_0_1_NS;
@@ -36,7 +40,7 @@ IjkGridParametricRepresentation::IjkGridParametricRepresentation(soap* soapConte
 	const std::string & guid, const std::string & title,
 	const unsigned int & iCount, const unsigned int & jCount, const unsigned int & kCount,
 	bool withTruncatedPillars) :
-	AbstractIjkGridRepresentation(soapContext, crs, guid, title, iCount, jCount, kCount, withTruncatedPillars), pillarInformation(nullptr)
+	AbstractIjkGridRepresentation(soapContext, crs, guid, title, iCount, jCount, kCount, withTruncatedPillars)
 {
 }
 
@@ -44,7 +48,7 @@ IjkGridParametricRepresentation::IjkGridParametricRepresentation(RESQML2_NS::Abs
 	const std::string & guid, const std::string & title,
 	const unsigned int & iCount, const unsigned int & jCount, const unsigned int & kCount,
 	bool withTruncatedPillars) :
-	AbstractIjkGridRepresentation(interp, crs, guid, title, iCount, jCount, kCount, withTruncatedPillars), pillarInformation(nullptr)
+	AbstractIjkGridRepresentation(interp, crs, guid, title, iCount, jCount, kCount, withTruncatedPillars)
 {
 }
 
@@ -542,240 +546,32 @@ void IjkGridParametricRepresentation::getXyzPointsOfKInterfaceSequenceOfPatch(co
 	}
 	resqml2__Point3dParametricArray* parametricPoint3d = static_cast<resqml2__Point3dParametricArray*>(geom->Points);
 
-	if (pillarInformation == nullptr)
-	{
-		pillarInformation = new PillarInformation();
-		loadPillarInformation(*pillarInformation);
-	}
-	
-	ULONG64 xyzPointCount = getXyzPointCountOfKInterfaceOfPatch(patchIndex);
-
-	// parameters : ordered
-	double * parameters = new double[xyzPointCount * (kInterfaceEnd - kInterfaceStart + 1)];
-	if (parametricPoint3d->Parameters->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__DoubleHdf5Array) {
-		const std::string pathInHdfFile = static_cast<resqml2__DoubleHdf5Array*>(parametricPoint3d->Parameters)->Values->PathInHdfFile;
-	
-		unsigned long long* numValuesInEachDimension = new unsigned long long[2];
-		numValuesInEachDimension[0] = kInterfaceEnd - kInterfaceStart + 1;
-		numValuesInEachDimension[1] = xyzPointCount;
-		unsigned long long* offsetInEachDimension = new unsigned long long[2];
-		offsetInEachDimension[0] = kInterfaceStart;
-		offsetInEachDimension[1] = 0;
-		hdfProxy->readArrayNdOfDoubleValues(pathInHdfFile, parameters,
-			numValuesInEachDimension, offsetInEachDimension, 2);
-		delete[] numValuesInEachDimension;
-		delete[] offsetInEachDimension;
+	if (parametricPoint3d->ParametricLines->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__ParametricLineArray) {
+		throw logic_error("Parametric lines should be of type resqml2__ParametricLineArray. Other type is not implemented yet.");
 	}
-	else {
-		delete[] parameters;
+	if (parametricPoint3d->Parameters->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__DoubleHdf5Array) {
 		throw logic_error("Non floating point coordinate line parameters are not implemented yet");
 	}
 
-	if (parametricPoint3d->ParametricLines->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__ParametricLineArray) {
-		//Mapping
-		size_t paramIndex = 0;
-		for (unsigned int pillarIndex = 0; pillarIndex < pillarInformation->parametricLineCount; ++pillarIndex) {
-			if (pillarInformation->pillarKind[pillarIndex] == -1 || parameters[paramIndex] != parameters[paramIndex]) { // not defined line
-				for (unsigned int k = 0; k <= kInterfaceEnd - kInterfaceStart; ++k) {
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3] = std::numeric_limits<double>::quiet_NaN();
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = std::numeric_limits<double>::quiet_NaN();
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = std::numeric_limits<double>::quiet_NaN();
-				}
-			}
-			else if (pillarInformation->pillarKind[pillarIndex] == 0) { // vertical (parameter must be the Z value)
-				for (unsigned int k = 0; k <= kInterfaceEnd - kInterfaceStart; ++k) {
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3] = pillarInformation->controlPoints[pillarIndex * 3];
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = pillarInformation->controlPoints[pillarIndex * 3 + 1];
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = parameters[(k * xyzPointCount) + paramIndex];
-				}
-			}
-			else if (pillarInformation->pillarKind[pillarIndex] == 1) { // linear interpolation
-				unsigned int controlPointCount = 0;
-				while (controlPointCount < pillarInformation->maxControlPointCount &&
-					pillarInformation->controlPoints[(pillarIndex + controlPointCount*pillarInformation->parametricLineCount) * 3] == 
-					pillarInformation->controlPoints[(pillarIndex + controlPointCount*pillarInformation->parametricLineCount) * 3]) {
-					controlPointCount++;
-				}
-
-				// Control point count on this line
-				if (controlPointCount == 2) { // straight
-					double parameterDistance = .0;
-					if (pillarInformation->controlPointParameters != nullptr)
-						parameterDistance = pillarInformation->controlPointParameters[pillarIndex + pillarInformation->parametricLineCount] - 
-											pillarInformation->controlPointParameters[pillarIndex]; // Parameter distance from top to bottom.
-					else // Should never occur by business rule. Assume the parameters are Z values for now (workaround for some softwares)....
-						parameterDistance = pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3 + 2] - pillarInformation->controlPoints[pillarIndex * 3 + 2]; // Parameter distance from top to bottom.
+	const std::shared_ptr<PillarInformation> pillarInformation = getPillarInformation();
 
-					const double xDist = (pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3] - pillarInformation->controlPoints[pillarIndex * 3]);
-					const double yDist = (pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3 + 1] - pillarInformation->controlPoints[pillarIndex * 3 + 1]);
-					const double zDist = (pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3 + 2] - pillarInformation->controlPoints[pillarIndex * 3 + 2]);
-
-					double ratioFromFirstControlPoint = .0;
-					for (unsigned int k = 0; k <= kInterfaceEnd - kInterfaceStart; ++k)
-					{
-						if (parameterDistance != .0)
-							if (pillarInformation->controlPointParameters != nullptr)
-								ratioFromFirstControlPoint = (parameters[(k * xyzPointCount) + paramIndex] - pillarInformation->controlPointParameters[pillarIndex]) / parameterDistance;
-							else
-								ratioFromFirstControlPoint = (parameters[(k * xyzPointCount) + paramIndex] - pillarInformation->controlPoints[pillarIndex * 3 + 2]) / parameterDistance;
-						else
-							ratioFromFirstControlPoint = .0;
-
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3] = pillarInformation->controlPoints[pillarIndex * 3] + ratioFromFirstControlPoint * xDist;
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = pillarInformation->controlPoints[pillarIndex * 3 + 1] + ratioFromFirstControlPoint * yDist;
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = pillarInformation->controlPoints[pillarIndex * 3 + 2] + ratioFromFirstControlPoint * zDist;
-					}
-				}
-				else { // piecewise linear
-
-					//unsigned int previousControlPoint = 0;
-					//if (pillarInformation->controlPointParameters != nullptr) {
-					//	while ((parameters[paramIndex] < pillarInformation->controlPointParameters[coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint] && parameters[paramIndex] < pillarInformation->controlPointParameters[coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)]) ||
-					//		(parameters[paramIndex] > pillarInformation->controlPointParameters[coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint] && parameters[paramIndex] > pillarInformation->controlPointParameters[coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)]) &&
-					//		previousControlPoint < controlPointCount - 1) {
-					//		++previousControlPoint;
-					//	}
-					//}
-					//else { // Should never occur by business rule. Assume the parameters are Z values for now (workaround for some softwares)....
-					//	while ((parameters[paramIndex] < pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 2] && parameters[paramIndex] < pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)) * 3 + 2]) ||
-					//		(parameters[paramIndex] > pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 2] && parameters[paramIndex] > pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)) * 3 + 2]) &&
-					//		previousControlPoint < controlPointCount - 1) {
-					//		++previousControlPoint;
-					//	}
-					//}
-
-					//if (previousControlPoint == controlPointCount - 1) {
-					//	throw invalid_argument("Cannot extrapolate piecewiselinear pillar for now to explicit a grid node.");
-					//}
-
-					//double ratioFromPreviousControlPoint = .0;
-					//double parameterDistance = .0;
-					//if (pillarInformation->controlPointParameters != nullptr) {
-					//	parameterDistance = pillarInformation->controlPointParameters[coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)] - pillarInformation->controlPointParameters[coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint]; // Parameter distance from top to bottom.
-					//	if (parameterDistance != .0)
-					//		ratioFromPreviousControlPoint = (parameters[paramIndex] - pillarInformation->controlPointParameters[coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint]) / parameterDistance;
-					//}
-					//else { // Should never occur by business rule. Assume the parameters are Z values for now (workaround for some softwares)....
-					//	parameterDistance = pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)) * 3 + 2] - pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 2]; // Parameter distance from top to bottom.
-					//	if (parameterDistance != .0) {
-					//		ratioFromPreviousControlPoint = (parameters[paramIndex] - pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 2]) / parameterDistance;
-					//	}
-					//}
-					//xyzPoints[paramIndex * 3] = pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3] + ratioFromPreviousControlPoint * (pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount) * 3] - pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3]);
-					//xyzPoints[paramIndex * 3 + 1] = pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 1] + ratioFromPreviousControlPoint * (pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)) * 3 + 1] - pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 1]);
-					//xyzPoints[paramIndex * 3 + 2] = pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 2] + ratioFromPreviousControlPoint * (pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)) * 3 + 2] - pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 2]);
-
-					//// TODO AND TO VERIFY ABOVE (MERGE PIECEWISE AND LINEAR (only 2 control points) IF POSSIBLE)
-
-					//delete[] parameters;
-					throw logic_error("Piecewise linear pillars are not implemented yet");
-				}
-			}
-			else if (pillarInformation->pillarKind[pillarIndex] == 2 || pillarInformation->pillarKind[pillarIndex] == 4) { // XY Natural cubic spline
-				for (unsigned int k = 0; k <= kInterfaceEnd - kInterfaceStart; ++k) {
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3] = pillarInformation->splines[pillarIndex][0].getValueFromParameter(parameters[k * xyzPointCount + paramIndex]);
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = pillarInformation->splines[pillarIndex][1].getValueFromParameter(parameters[k * xyzPointCount + paramIndex]);
-					if (pillarInformation->pillarKind[pillarIndex] == 2) { //  Z natural cubic spline
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = pillarInformation->splines[pillarIndex][2].getValueFromParameter(parameters[k * xyzPointCount + paramIndex]);
-					}
-					else { // Z linear cubic spline
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = parameters[k * xyzPointCount + paramIndex];
-					}
-				}
-			}
-			else {
-				delete[] parameters;
-				throw logic_error("Computing XYZ from parameters on a non natural cubic spline or on a minimum curvature spline is not implemented yet.");
-			}
-			++paramIndex;
-		}
-
-		for (unsigned int splitLineIndex = 0; splitLineIndex < pillarInformation->splitLineCount; ++splitLineIndex)
-		{
-			unsigned int pillarIndex = pillarInformation->pillarOfSplitCoordLines[splitLineIndex];
-			if (pillarInformation->pillarKind[pillarIndex] == -1 || parameters[paramIndex] != parameters[paramIndex]) { // not defined line
-				for (unsigned int k = 0; k <= kInterfaceEnd - kInterfaceStart; ++k) {
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3] = std::numeric_limits<double>::quiet_NaN();
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = std::numeric_limits<double>::quiet_NaN();
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = std::numeric_limits<double>::quiet_NaN();
-				}
-			}
-			else if (pillarInformation->pillarKind[pillarIndex] == 0) { // vertical (parameter must be the Z value)
-				for (unsigned int k = 0; k <= kInterfaceEnd - kInterfaceStart; ++k) {
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3] = pillarInformation->controlPoints[pillarIndex * 3];
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = pillarInformation->controlPoints[pillarIndex * 3 + 1];
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = parameters[k * xyzPointCount + paramIndex];
-				}
-			}
-			else if (pillarInformation->pillarKind[pillarIndex] == 1) { // Linear interpolation
-				unsigned int controlPointCount = 0;
-				while (controlPointCount < pillarInformation->maxControlPointCount &&
-					pillarInformation->controlPoints[(pillarIndex + controlPointCount*pillarInformation->parametricLineCount) * 3] == pillarInformation->controlPoints[(pillarIndex + controlPointCount*pillarInformation->parametricLineCount) * 3]) {
-					controlPointCount++;
-				}
+	const unsigned int kInterfaceCount = kInterfaceEnd - kInterfaceStart + 1;
+	const ULONG64 xyzPointCount = getXyzPointCountOfKInterfaceOfPatch(patchIndex);
 
-				// Control point count on this line
-				if (controlPointCount == 2) { // straight
-					double parameterDistance = .0;
-					if (pillarInformation->controlPointParameters != nullptr)
-						parameterDistance = pillarInformation->controlPointParameters[pillarIndex + pillarInformation->parametricLineCount] - pillarInformation->controlPointParameters[pillarIndex]; // Parameter distance from top to bottom.
-					else // Should never occur by business rule. Assume the parameters are Z values for now (workaround for some softwares)....
-						parameterDistance = pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3 + 2] - pillarInformation->controlPoints[pillarIndex * 3 + 2]; // Parameter distance from top to bottom.
-
-					double xDist = pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3] - pillarInformation->controlPoints[pillarIndex * 3];
-					double yDist = pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3 + 1] - pillarInformation->controlPoints[pillarIndex * 3 + 1];
-					double zDist = pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3 + 2] - pillarInformation->controlPoints[pillarIndex * 3 + 2];
-
-					double ratioFromFirstControlPoint = .0;
-					for (unsigned int k = 0; k <= kInterfaceEnd - kInterfaceStart; ++k) {
-						if (parameterDistance != .0) {
-							if (pillarInformation->controlPointParameters != nullptr)
-								ratioFromFirstControlPoint = (parameters[(k * xyzPointCount) + paramIndex] - pillarInformation->controlPointParameters[pillarIndex]) / parameterDistance;
-							else { // Should never occur by business rule. Assume the parameters are Z values for now (workaround for some softwares)....
-								ratioFromFirstControlPoint = (parameters[(k * xyzPointCount) + paramIndex] - pillarInformation->controlPoints[pillarIndex * 3 + 2]) / parameterDistance;
-							}
-						}
-						else
-							ratioFromFirstControlPoint = .0;
+	// parameters : ordered by K interface and then by coordinate line (pillars and then split coordinate lines)
+	std::vector<double> parameters(xyzPointCount * kInterfaceCount);
+	unsigned long long numValuesInEachDimension[2] = { kInterfaceCount, xyzPointCount };
+	unsigned long long offsetInEachDimension[2] = { kInterfaceStart, 0 };
+	hdfProxy->readArrayNdOfDoubleValues(static_cast<resqml2__DoubleHdf5Array*>(parametricPoint3d->Parameters)->Values->PathInHdfFile, &parameters[0],
+		numValuesInEachDimension, offsetInEachDimension, 2);
 
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3] = pillarInformation->controlPoints[pillarIndex * 3] + ratioFromFirstControlPoint * xDist;
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = pillarInformation->controlPoints[pillarIndex * 3 + 1] + ratioFromFirstControlPoint * yDist;
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = pillarInformation->controlPoints[pillarIndex * 3 + 2] + ratioFromFirstControlPoint * zDist;
-					}
-				}
-				else { // piecewise linear
-					   // Cleaning
-					delete[] parameters;
-					throw logic_error("Piecewise linear pillars are not implemented yet");
-				}
-			}
-			else if (pillarInformation->pillarKind[pillarIndex] == 2 || pillarInformation->pillarKind[pillarIndex] == 4) { // XY Natural cubic spline
-				for (unsigned int k = 0; k <= kInterfaceEnd - kInterfaceStart; ++k) {
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3] = pillarInformation->splines[pillarIndex][0].getValueFromParameter(parameters[k * xyzPointCount + paramIndex]);
-					xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = pillarInformation->splines[pillarIndex][1].getValueFromParameter(parameters[k * xyzPointCount + paramIndex]);
-					if (pillarInformation->pillarKind[pillarIndex] == 2) { //  Z natural cubic spline
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = pillarInformation->splines[pillarIndex][2].getValueFromParameter(parameters[k * xyzPointCount + paramIndex]);
-					}
-					else { // Z linear cubic spline
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = parameters[k * xyzPointCount + paramIndex];
-					}
-				}
-			}
-			else {
-				// Cleaning
-				delete[] parameters;
-				throw logic_error("Computing XYZ from parameters on a non natural cubic spline or on a minimum curvature spline is not implemented yet.");
-			}
-			++paramIndex;
-		}
-	}
-	else
-	{
-		delete[] parameters;
-		throw logic_error("Parametric lines should be of type resqml2__ParametricLineArray. Other type is not implemented yet.");
+	//Mapping
+	for (ULONG64 paramIndex = 0; paramIndex < xyzPointCount; ++paramIndex) {
+		const unsigned int pillarIndex = paramIndex < pillarInformation->parametricLineCount
+			? static_cast<unsigned int>(paramIndex)
+			: pillarInformation->pillarOfSplitCoordLines[paramIndex - pillarInformation->parametricLineCount];
+		pillarInformation->computeXyzPoints(pillarIndex, &parameters[paramIndex], xyzPointCount, kInterfaceCount, xyzPoints + paramIndex * 3);
 	}
-
-	delete[] parameters;
 }
 
 void IjkGridParametricRepresentation::getXyzPointsOfBlockOfPatch(const unsigned int & patchIndex, double * xyzPoints)
@@ -795,341 +591,31 @@ void IjkGridParametricRepresentation::getXyzPointsOfBlockOfPatch(const unsigned
 	}
 	resqml2__Point3dParametricArray* parametricPoint3d = static_cast<resqml2__Point3dParametricArray*>(geom->Points);
 
-	if (pillarInformation == nullptr)
-	{
-		pillarInformation = new PillarInformation();
-		loadPillarInformation(*pillarInformation);
-	}
-
-	// following lines for time testing
-	//if (pillarInformation != nullptr)
-	//	delete pillarInformation;
-	//pillarInformation = new PillarInformation();
-	//loadPillarInformation(*pillarInformation);
-
-	ULONG64 xyzPointCount =	(blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart + 1) *  (blockInformation->jInterfaceEnd - blockInformation->jInterfaceStart + 1) + getBlockSplitCoordinateLineCount(); 
-
-	// parameters : ordered
-	double * parameters = new double[getXyzPointCountOfBlock()];
-	if (parametricPoint3d->Parameters->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__DoubleHdf5Array) {
-		const std::string pathInHdfFile = static_cast<resqml2__DoubleHdf5Array*>(parametricPoint3d->Parameters)->Values->PathInHdfFile;
-	
-		unsigned long long* blockCountPerDimension = new unsigned long long[2];
-		blockCountPerDimension[0] = 1;
-		blockCountPerDimension[1] = blockInformation->jInterfaceEnd - blockInformation->jInterfaceStart + 1;
-		unsigned long long* offsetPerDimension = new unsigned long long[2];
-		offsetPerDimension[0] = blockInformation->kInterfaceStart;
-		offsetPerDimension[1] = blockInformation->jInterfaceStart * (getICellCount() + 1) + blockInformation->iInterfaceStart;
-		unsigned long long* strideInEachDimension = new unsigned long long[2];
-		strideInEachDimension[0] = 1;
-		strideInEachDimension[1] = (blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart + 1) + ((getICellCount() + 1) - (blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart + 1));
-		unsigned long long* blockSizeInEachDimension = new unsigned long long[2];
-		blockSizeInEachDimension[0] = blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart + 1;
-		blockSizeInEachDimension[1] = blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart + 1;
-
-		int dataset, filespace;
-		hdfProxy->selectArrayNdOfValues(
-			pathInHdfFile,
-			blockCountPerDimension,
-			offsetPerDimension,
-			strideInEachDimension,
-			blockSizeInEachDimension,
-			2,
-			true,
-			dataset,
-			filespace);
-
-		unsigned long long slab_size = 1;
-		for (unsigned int h = 0; h < 2; ++h) {
-			slab_size *= blockSizeInEachDimension[h];
-		}
-		for (unsigned int h = 0; h < 2; ++h) {
-			slab_size *= blockCountPerDimension[h];
-		}
-
-		// Adding block split coordinate lines to the selected regions
-		// traversing all bloc pillars in direction i and then in direction j
-		for (unsigned int jPillarIndex = blockInformation->jInterfaceStart; jPillarIndex <= blockInformation->jInterfaceEnd; ++jPillarIndex)
-		{
-			for (unsigned int iPillarIndex = blockInformation->iInterfaceStart; iPillarIndex <= blockInformation->iInterfaceEnd; iPillarIndex++)
-			{
-				unsigned int pillarIndex = getGlobalIndexPillarFromIjIndex(iPillarIndex, jPillarIndex);
-
-				if (splitInformation[pillarIndex].size() != 0)
-				{
-					// here is a split pillar
-
-					// traversing all split coordinate lines corresponding to the current splitted pillar
-					for (unsigned int splitCoordinateLineIndex = 0; splitCoordinateLineIndex < splitInformation[pillarIndex].size(); ++splitCoordinateLineIndex)
-					{
-						// traversing adjacent columns, it current column is in the bloc, corresponding coordinate line is added to the selected region
-						for (unsigned int columnIndex = 0; columnIndex < splitInformation[pillarIndex][splitCoordinateLineIndex].second.size(); ++columnIndex)
-						{
-							unsigned int iColumnIndex = getIColumnFromGlobalIndex(splitInformation[pillarIndex][splitCoordinateLineIndex].second[columnIndex]);
-							unsigned int jColumnIndex = getJColumnFromGlobalIndex(splitInformation[pillarIndex][splitCoordinateLineIndex].second[columnIndex]);
-
-							if ((iColumnIndex >= blockInformation->iInterfaceStart && iColumnIndex < blockInformation->iInterfaceEnd) && (jColumnIndex >= blockInformation->jInterfaceStart && jColumnIndex < blockInformation->jInterfaceEnd))
-							{
-								// here is a split coordinate line impacting the bloc
-								unsigned int splitCoordinateLineHdfIndex = (getICellCount() + 1) * (getJCellCount() + 1) + splitInformation[pillarIndex][splitCoordinateLineIndex].first;
-
-								// the split coordinate line is added to the selected region
-								blockCountPerDimension[0] = 1;
-								blockCountPerDimension[1] = 1;
-								offsetPerDimension[0] = blockInformation->kInterfaceStart;
-								offsetPerDimension[1] = splitCoordinateLineHdfIndex;
-								strideInEachDimension[0] = 1;
-								strideInEachDimension[1] = 1;
-								blockSizeInEachDimension[0] = blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart + 1;
-								blockSizeInEachDimension[1] = 1;
-							
-								hdfProxy->selectArrayNdOfValues(
-									pathInHdfFile,
-									blockCountPerDimension,
-									offsetPerDimension,
-									strideInEachDimension,
-									blockSizeInEachDimension,
-									2,
-									false,
-									dataset,
-									filespace);
-
-								slab_size += (blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart + 1);
-
-								break; // in order to be sure not adding twice a same coordinate line if it is adjacent to several columns within the bloc
-							}
-						}
-					}
-				}
-			}
-		}
-
-		// reading values corresponding to the whole selected region (non splitted and splitted part)
-		hdfProxy->readArrayNdOfDoubleValues(dataset, filespace,
-			parameters, slab_size);
-
-		delete[] blockCountPerDimension;
-		delete[] offsetPerDimension;
-		delete[] strideInEachDimension;
-		delete[] blockSizeInEachDimension;
+	if (parametricPoint3d->ParametricLines->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__ParametricLineArray) {
+		throw logic_error("Parametric lines should be of type resqml2__ParametricLineArray. Other type is not implemented yet.");
 	}
-	else {
+	if (parametricPoint3d->Parameters->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__DoubleHdf5Array) {
 		throw logic_error("Non floating point coordinate line parameters are not implemented yet");
 	}
 
-	if (parametricPoint3d->ParametricLines->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__ParametricLineArray) {
-		//Mapping
-		size_t paramIndex = 0;
-		for (unsigned int j = blockInformation->jInterfaceStart; j <= blockInformation->jInterfaceEnd; ++j)
-		{
-			for (unsigned int i = blockInformation->iInterfaceStart; i <= blockInformation->iInterfaceEnd; ++i) {
-			//for (unsigned int pillarIndex = 0; pillarIndex < pillarInformation->parametricLineCount; ++pillarIndex) {
-				unsigned int pillarIndex = i + j * (getICellCount()+1);
-				if (pillarInformation->pillarKind[pillarIndex] == -1 || parameters[paramIndex] != parameters[paramIndex]) { // not defined line
-					for (unsigned int k = 0; k <= blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart; ++k) {
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3] = std::numeric_limits<double>::quiet_NaN();
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = std::numeric_limits<double>::quiet_NaN();
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = std::numeric_limits<double>::quiet_NaN();
-					}
-				}
-				else if (pillarInformation->pillarKind[pillarIndex] == 0) { // vertical (parameter must be the Z value)
-					for (unsigned int k = 0; k <= blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart; ++k) {
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3] = pillarInformation->controlPoints[pillarIndex * 3];
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = pillarInformation->controlPoints[pillarIndex * 3 + 1];
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = parameters[(k * xyzPointCount) + paramIndex];
-					}
-				}
-				else if (pillarInformation->pillarKind[pillarIndex] == 1) { // linear interpolation
-					unsigned int controlPointCount = 0;
-					while (controlPointCount < pillarInformation->maxControlPointCount &&
-						pillarInformation->controlPoints[(pillarIndex + controlPointCount*pillarInformation->parametricLineCount) * 3] ==
-						pillarInformation->controlPoints[(pillarIndex + controlPointCount*pillarInformation->parametricLineCount) * 3]) {
-						controlPointCount++;
-					}
+	// Only the pillars of the block are loaded (not the whole grid ones)
+	PillarInformation blockPillarInformation;
+	loadPillarInformationOfBlock(blockPillarInformation);
 
-					// Control point count on this line
-					if (controlPointCount == 2) { // straight
-						double parameterDistance = .0;
-						if (pillarInformation->controlPointParameters != nullptr)
-							parameterDistance = pillarInformation->controlPointParameters[pillarIndex + pillarInformation->parametricLineCount] -
-							pillarInformation->controlPointParameters[pillarIndex]; // Parameter distance from top to bottom.
-						else // Should never occur by business rule. Assume the parameters are Z values for now (workaround for some softwares)....
-							parameterDistance = pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3 + 2] - pillarInformation->controlPoints[pillarIndex * 3 + 2]; // Parameter distance from top to bottom.
-
-						const double xDist = (pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3] - pillarInformation->controlPoints[pillarIndex * 3]);
-						const double yDist = (pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3 + 1] - pillarInformation->controlPoints[pillarIndex * 3 + 1]);
-						const double zDist = (pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3 + 2] - pillarInformation->controlPoints[pillarIndex * 3 + 2]);
+	const unsigned int kInterfaceCount = blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart + 1;
+	const ULONG64 xyzPointCount = blockPillarInformation.parametricLineCount + blockPillarInformation.splitLineCount;
 
-						double ratioFromFirstControlPoint = .0;
-						for (unsigned int k = 0; k <= blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart; ++k)
-						{
-							if (parameterDistance != .0)
-								if (pillarInformation->controlPointParameters != nullptr)
-									ratioFromFirstControlPoint = (parameters[(k * xyzPointCount) + paramIndex] - pillarInformation->controlPointParameters[pillarIndex]) / parameterDistance;
-								else
-									ratioFromFirstControlPoint = (parameters[(k * xyzPointCount) + paramIndex] - pillarInformation->controlPoints[pillarIndex * 3 + 2]) / parameterDistance;
-							else
-								ratioFromFirstControlPoint = .0;
-
-							xyzPoints[(k * xyzPointCount + paramIndex) * 3] = pillarInformation->controlPoints[pillarIndex * 3] + ratioFromFirstControlPoint * xDist;
-							xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = pillarInformation->controlPoints[pillarIndex * 3 + 1] + ratioFromFirstControlPoint * yDist;
-							xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = pillarInformation->controlPoints[pillarIndex * 3 + 2] + ratioFromFirstControlPoint * zDist;
-						}
-					}
-					else { // piecewise linear
+	// parameters : ordered by K interface and then by block coordinate line (pillars and then split coordinate lines)
+	std::vector<double> parameters(getXyzPointCountOfBlock());
+	readBlockOfNodeDataset(static_cast<resqml2__DoubleHdf5Array*>(parametricPoint3d->Parameters)->Values->PathInHdfFile, &parameters[0], 1);
 
-						   //unsigned int previousControlPoint = 0;
-						   //if (pillarInformation->controlPointParameters != nullptr) {
-						   //	while ((parameters[paramIndex] < pillarInformation->controlPointParameters[coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint] && parameters[paramIndex] < pillarInformation->controlPointParameters[coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)]) ||
-						   //		(parameters[paramIndex] > pillarInformation->controlPointParameters[coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint] && parameters[paramIndex] > pillarInformation->controlPointParameters[coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)]) &&
-						   //		previousControlPoint < controlPointCount - 1) {
-						   //		++previousControlPoint;
-						   //	}
-						   //}
-						   //else { // Should never occur by business rule. Assume the parameters are Z values for now (workaround for some softwares)....
-						   //	while ((parameters[paramIndex] < pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 2] && parameters[paramIndex] < pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)) * 3 + 2]) ||
-						   //		(parameters[paramIndex] > pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 2] && parameters[paramIndex] > pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)) * 3 + 2]) &&
-						   //		previousControlPoint < controlPointCount - 1) {
-						   //		++previousControlPoint;
-						   //	}
-						   //}
-
-						   //if (previousControlPoint == controlPointCount - 1) {
-						   //	throw invalid_argument("Cannot extrapolate piecewiselinear pillar for now to explicit a grid node.");
-						   //}
-
-						   //double ratioFromPreviousControlPoint = .0;
-						   //double parameterDistance = .0;
-						   //if (pillarInformation->controlPointParameters != nullptr) {
-						   //	parameterDistance = pillarInformation->controlPointParameters[coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)] - pillarInformation->controlPointParameters[coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint]; // Parameter distance from top to bottom.
-						   //	if (parameterDistance != .0)
-						   //		ratioFromPreviousControlPoint = (parameters[paramIndex] - pillarInformation->controlPointParameters[coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint]) / parameterDistance;
-						   //}
-						   //else { // Should never occur by business rule. Assume the parameters are Z values for now (workaround for some softwares)....
-						   //	parameterDistance = pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)) * 3 + 2] - pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 2]; // Parameter distance from top to bottom.
-						   //	if (parameterDistance != .0) {
-						   //		ratioFromPreviousControlPoint = (parameters[paramIndex] - pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 2]) / parameterDistance;
-						   //	}
-						   //}
-						   //xyzPoints[paramIndex * 3] = pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3] + ratioFromPreviousControlPoint * (pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount) * 3] - pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3]);
-						   //xyzPoints[paramIndex * 3 + 1] = pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 1] + ratioFromPreviousControlPoint * (pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)) * 3 + 1] - pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 1]);
-						   //xyzPoints[paramIndex * 3 + 2] = pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 2] + ratioFromPreviousControlPoint * (pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*(previousControlPoint + 1)) * 3 + 2] - pillarInformation->controlPoints[(coordLineIndex + pillarInformation->parametricLineCount*previousControlPoint) * 3 + 2]);
-
-						   //// TODO AND TO VERIFY ABOVE (MERGE PIECEWISE AND LINEAR (only 2 control points) IF POSSIBLE)
-
-						   //delete[] parameters;
-						throw logic_error("Piecewise linear pillars are not implemented yet");
-					}
-				}
-				else if (pillarInformation->pillarKind[pillarIndex] == 2 || pillarInformation->pillarKind[pillarIndex] == 4) { // XY Natural cubic spline
-					for (unsigned int k = 0; k <= blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart; ++k) {
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3] = pillarInformation->splines[pillarIndex][0].getValueFromParameter(parameters[k * xyzPointCount + paramIndex]);
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = pillarInformation->splines[pillarIndex][1].getValueFromParameter(parameters[k * xyzPointCount + paramIndex]);
-						if (pillarInformation->pillarKind[pillarIndex] == 2) { //  Z natural cubic spline
-							xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = pillarInformation->splines[pillarIndex][2].getValueFromParameter(parameters[k * xyzPointCount + paramIndex]);
-						}
-						else { // Z linear cubic spline
-							xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = parameters[k * xyzPointCount + paramIndex];
-						}
-					}
-				}
-				else {
-					delete[] parameters;
-					throw logic_error("Computing XYZ from parameters on a non natural cubic spline or on a minimum curvature spline is not implemented yet.");
-				}
-				++paramIndex;
-			}
-		}
-
-		for (unsigned int splitLineIndex = 0; splitLineIndex < pillarInformation->splitLineCount; ++splitLineIndex)
-		{
-			if (blockInformation->globalToLocalSplitCoordinateLinesIndex.find(splitLineIndex) != blockInformation->globalToLocalSplitCoordinateLinesIndex.end())
-			{
-				paramIndex = blockInformation->globalToLocalSplitCoordinateLinesIndex[splitLineIndex];
-				unsigned int pillarIndex = pillarInformation->pillarOfSplitCoordLines[splitLineIndex];
-				if (pillarInformation->pillarKind[pillarIndex] == -1 || parameters[paramIndex] != parameters[paramIndex]) { // not defined line
-					for (unsigned int k = 0; k <= blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart; ++k) {
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3] = std::numeric_limits<double>::quiet_NaN();
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = std::numeric_limits<double>::quiet_NaN();
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = std::numeric_limits<double>::quiet_NaN();
-					}
-				}
-				else if (pillarInformation->pillarKind[pillarIndex] == 0) { // vertical (parameter must be the Z value)
-					for (unsigned int k = 0; k <= blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart; ++k) {
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3] = pillarInformation->controlPoints[pillarIndex * 3];
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = pillarInformation->controlPoints[pillarIndex * 3 + 1];
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = parameters[k * xyzPointCount + paramIndex];
-					}
-				}
-				else if (pillarInformation->pillarKind[pillarIndex] == 1) { // Linear interpolation
-					unsigned int controlPointCount = 0;
-					while (controlPointCount < pillarInformation->maxControlPointCount &&
-						pillarInformation->controlPoints[(pillarIndex + controlPointCount*pillarInformation->parametricLineCount) * 3] == pillarInformation->controlPoints[(pillarIndex + controlPointCount*pillarInformation->parametricLineCount) * 3]) {
-						controlPointCount++;
-					}
-
-					// Control point count on this line
-					if (controlPointCount == 2) { // straight
-						double parameterDistance = .0;
-						if (pillarInformation->controlPointParameters != nullptr)
-							parameterDistance = pillarInformation->controlPointParameters[pillarIndex + pillarInformation->parametricLineCount] - pillarInformation->controlPointParameters[pillarIndex]; // Parameter distance from top to bottom.
-						else // Should never occur by business rule. Assume the parameters are Z values for now (workaround for some softwares)....
-							parameterDistance = pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3 + 2] - pillarInformation->controlPoints[pillarIndex * 3 + 2]; // Parameter distance from top to bottom.
-
-						double xDist = pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3] - pillarInformation->controlPoints[pillarIndex * 3];
-						double yDist = pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3 + 1] - pillarInformation->controlPoints[pillarIndex * 3 + 1];
-						double zDist = pillarInformation->controlPoints[(pillarIndex + pillarInformation->parametricLineCount) * 3 + 2] - pillarInformation->controlPoints[pillarIndex * 3 + 2];
-
-						double ratioFromFirstControlPoint = .0;
-						for (unsigned int k = 0; k <= blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart; ++k) {
-							if (parameterDistance != .0) {
-								if (pillarInformation->controlPointParameters != nullptr)
-									ratioFromFirstControlPoint = (parameters[k * xyzPointCount + paramIndex] - pillarInformation->controlPointParameters[pillarIndex]) / parameterDistance;
-								else { // Should never occur by business rule. Assume the parameters are Z values for now (workaround for some softwares)....
-									ratioFromFirstControlPoint = (parameters[k * xyzPointCount + paramIndex] - pillarInformation->controlPoints[pillarIndex * 3 + 2]) / parameterDistance;
-								}
-							}
-							else
-								ratioFromFirstControlPoint = .0;
-
-							xyzPoints[(k * xyzPointCount + paramIndex) * 3] = pillarInformation->controlPoints[pillarIndex * 3] + ratioFromFirstControlPoint * xDist;
-							xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = pillarInformation->controlPoints[pillarIndex * 3 + 1] + ratioFromFirstControlPoint * yDist;
-							xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = pillarInformation->controlPoints[pillarIndex * 3 + 2] + ratioFromFirstControlPoint * zDist;
-						}
-					}
-					else { // piecewise linear
-						   // Cleaning
-						delete[] parameters;
-						throw logic_error("Piecewise linear pillars are not implemented yet");
-					}
-				}
-				else if (pillarInformation->pillarKind[pillarIndex] == 2 || pillarInformation->pillarKind[pillarIndex] == 4) { // XY Natural cubic spline
-					for (unsigned int k = 0; k <= blockInformation->kInterfaceEnd - blockInformation->kInterfaceStart; ++k) {
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3] = pillarInformation->splines[pillarIndex][0].getValueFromParameter(parameters[k * xyzPointCount + paramIndex]);
-						xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 1] = pillarInformation->splines[pillarIndex][1].getValueFromParameter(parameters[k * xyzPointCount + paramIndex]);
-						if (pillarInformation->pillarKind[pillarIndex] == 2) { //  Z natural cubic spline
-							xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = pillarInformation->splines[pillarIndex][2].getValueFromParameter(parameters[k * xyzPointCount + paramIndex]);
-						}
-						else { // Z linear cubic spline
-							xyzPoints[(k * xyzPointCount + paramIndex) * 3 + 2] = parameters[k * xyzPointCount + paramIndex];
-						}
-					}
-				}
-				else {
-					// Cleaning
-					delete[] parameters;
-					throw logic_error("Computing XYZ from parameters on a non natural cubic spline or on a minimum curvature spline is not implemented yet.");
-				}
-			}
-		}
+	//Mapping
+	for (ULONG64 paramIndex = 0; paramIndex < xyzPointCount; ++paramIndex) {
+		const unsigned int pillarIndex = paramIndex < blockPillarInformation.parametricLineCount
+			? static_cast<unsigned int>(paramIndex)
+			: blockPillarInformation.pillarOfSplitCoordLines[paramIndex - blockPillarInformation.parametricLineCount];
+		blockPillarInformation.computeXyzPoints(pillarIndex, &parameters[paramIndex], xyzPointCount, kInterfaceCount, xyzPoints + paramIndex * 3);
 	}
-	else
-	{
-		delete[] parameters;
-		throw logic_error("Parametric lines should be of type resqml2__ParametricLineArray. Other type is not implemented yet.");
-	}
-
-	delete[] parameters;
 }
 
 void IjkGridParametricRepresentation::getXyzPointsOfPatch(const unsigned int & patchIndex, double * xyzPoints) const
@@ -1190,6 +676,11 @@ void IjkGridParametricRepresentation::setGeometryAsParametricSplittedPillarNodes
 	setGeometryAsParametricSplittedPillarNodes(isRightHanded, parameters, controlPoints, controlPointParameters, controlPointMaxCountPerPillar, 2, proxy,
 		splitCoordinateLineCount, pillarOfCoordinateLine, splitCoordinateLineColumnCumulativeCount, splitCoordinateLineColumns);
 
+	setParametricLineKinds(mostComplexPillarGeometry, controlPointMaxCountPerPillar, pillarKind, proxy);
+}
+
+void IjkGridParametricRepresentation::setParametricLineKinds(const gsoap_resqml2_0_1::resqml2__PillarShape & mostComplexPillarGeometry, const unsigned int & controlPointMaxCountPerPillar, short * pillarKind, COMMON_NS::AbstractHdfProxy * proxy)
+{
 	gsoap_resqml2_0_1::resqml2__IjkGridGeometry* geom = static_cast<gsoap_resqml2_0_1::resqml2__IjkGridGeometry*>(getPointGeometry2_0_1(0));
 	if (geom == nullptr) {
 		throw invalid_argument("There is no geometry on this grid.");
@@ -1323,9 +814,19 @@ void IjkGridParametricRepresentation::setGeometryAsParametricSplittedPillarNodes
 
 		hdfProxy->writeArrayNdOfDoubleValues(gsoapProxy2_0_1->uuid, "PointParameters", parameters, numValues, 2);
 		delete[] numValues;
+	}
 
+	writeParametricLines(controlPoints, controlPointParameters, controlPointCountPerPillar,
+		splitCoordinateLineCount, pillarOfCoordinateLine, splitCoordinateLineColumnCumulativeCount, splitCoordinateLineColumns);
+}
+
+void IjkGridParametricRepresentation::writeParametricLines(double * controlPoints, double * controlPointParameters, const unsigned int & controlPointCountPerPillar,
+	const unsigned long & splitCoordinateLineCount, unsigned int * pillarOfCoordinateLine,
+	unsigned int * splitCoordinateLineColumnCumulativeCount, unsigned int * splitCoordinateLineColumns)
+{
+	if (splitCoordinateLineCount != 0) {
 		// split coordinate lines
-		numValues = new hsize_t[1];
+		hsize_t * numValues = new hsize_t[1];
 		numValues[0] = splitCoordinateLineCount;
 		hdfProxy->writeArrayNd(gsoapProxy2_0_1->uuid, "PillarIndices", H5T_NATIVE_UINT, pillarOfCoordinateLine, numValues, 1);
 		delete[] numValues;
@@ -1359,6 +860,78 @@ void IjkGridParametricRepresentation::setGeometryAsParametricSplittedPillarNodes
 	}
 }
 
+void IjkGridParametricRepresentation::setGeometryAsParametricSplittedPillarNodesByLayer(
+	const gsoap_resqml2_0_1::resqml2__PillarShape & mostComplexPillarGeometry, const bool & isRightHanded,
+	ParameterLayerGenerator * generator, double * controlPoints, double * controlPointParameters, const unsigned int & controlPointMaxCountPerPillar, short * pillarKind, COMMON_NS::AbstractHdfProxy * proxy,
+	const unsigned long & splitCoordinateLineCount, unsigned int * pillarOfCoordinateLine,
+	unsigned int * splitCoordinateLineColumnCumulativeCount, unsigned int * splitCoordinateLineColumns)
+{
+	if (pillarKind == nullptr) {
+		throw invalid_argument("The kind of the coordinate lines cannot be null.");
+	}
+
+	setGeometryAsParametricSplittedPillarNodesByLayer(isRightHanded, generator, controlPoints, controlPointParameters, controlPointMaxCountPerPillar, 2, proxy,
+		splitCoordinateLineCount, pillarOfCoordinateLine, splitCoordinateLineColumnCumulativeCount, splitCoordinateLineColumns);
+
+	setParametricLineKinds(mostComplexPillarGeometry, controlPointMaxCountPerPillar, pillarKind, proxy);
+}
+
+void IjkGridParametricRepresentation::setGeometryAsParametricSplittedPillarNodesByLayer(const bool & isRightHanded,
+	ParameterLayerGenerator * generator, double * controlPoints, double * controlPointParameters, const unsigned int & controlPointCountPerPillar, short pillarKind, COMMON_NS::AbstractHdfProxy * proxy,
+	const unsigned long & splitCoordinateLineCount, unsigned int * pillarOfCoordinateLine,
+	unsigned int * splitCoordinateLineColumnCumulativeCount, unsigned int * splitCoordinateLineColumns)
+{
+	if (generator == nullptr) {
+		throw invalid_argument("The generator of the parameters of the nodes of the ijk grid cannot be null.");
+	}
+	if (controlPoints == nullptr) {
+		throw invalid_argument("The control points of the coordinate lines of the ijk grid cannot be null.");
+	}
+	if (splitCoordinateLineCount != 0 && (pillarOfCoordinateLine == nullptr || splitCoordinateLineColumnCumulativeCount == nullptr || splitCoordinateLineColumns == nullptr)) {
+		throw invalid_argument("The definition of the split coordinate lines is incomplete.");
+	}
+
+	gsoap_resqml2_0_1::resqml2__KDirection kDirectionKind = computeKDirection(controlPoints, controlPointCountPerPillar);
+
+	const std::string hdfDatasetPrefix = "/RESQML/" + gsoapProxy2_0_1->uuid;
+	setGeometryAsParametricSplittedPillarNodesUsingExistingDatasets(kDirectionKind, isRightHanded,
+		hdfDatasetPrefix + "/PointParameters", hdfDatasetPrefix + "/ControlPoints", controlPointParameters != nullptr ? hdfDatasetPrefix + "/controlPointParameters" : "", controlPointCountPerPillar, pillarKind, proxy,
+		splitCoordinateLineCount, hdfDatasetPrefix + "/PillarIndices",
+		hdfDatasetPrefix + "/ColumnsPerSplitCoordinateLine/" + CUMULATIVE_LENGTH_DS_NAME, hdfDatasetPrefix + "/ColumnsPerSplitCoordinateLine/" + ELEMENTS_DS_NAME);
+
+	writeParametricLines(controlPoints, controlPointParameters, controlPointCountPerPillar,
+		splitCoordinateLineCount, pillarOfCoordinateLine, splitCoordinateLineColumnCumulativeCount, splitCoordinateLineColumns);
+
+	// PointParameters : the dataset is 3d (K, J, I) without split coordinate lines else it is 2d (K, coordinate line).
+	const unsigned int kInterfaceCount = getKCellCount() + 1;
+	const ULONG64 layerValueCount = static_cast<ULONG64>(getJCellCount() + 1) * (getICellCount() + 1) + splitCoordinateLineCount;
+	const unsigned int dimCount = splitCoordinateLineCount == 0 ? 3 : 2;
+	unsigned long long numValues[3] = { kInterfaceCount, getJCellCount() + 1, getICellCount() + 1 };
+	if (splitCoordinateLineCount != 0) {
+		numValues[1] = layerValueCount;
+	}
+	hdfProxy->createArrayNd(gsoapProxy2_0_1->uuid, "PointParameters", H5T_NATIVE_DOUBLE, numValues, dimCount);
+
+	// A window of consecutive K interfaces is generated concurrently (one K interface per thread) and then written at once
+	// since consecutive K interfaces are contiguous in the parameters dataset.
+	unsigned long long windowOffset[3] = { 0, 0, 0 };
+	const unsigned int maxWindowSize = parallel::getChunkCount(kInterfaceCount, 1);
+	std::vector<double> windowParameters(maxWindowSize * layerValueCount);
+	for (unsigned int windowStart = 0; windowStart < kInterfaceCount; windowStart += maxWindowSize) {
+		const unsigned int windowSize = (std::min)(maxWindowSize, kInterfaceCount - windowStart);
+		parallel::forEachChunk(windowSize, windowSize, [&](const unsigned int &, const uint64_t & begin, const uint64_t & end) {
+			for (uint64_t layer = begin; layer < end; ++layer) {
+				generator->generateLayer(windowStart + static_cast<unsigned int>(layer), &windowParameters[layer * layerValueCount]);
+			}
+		});
+
+		// HDF5 is only called from the calling thread.
+		numValues[0] = windowSize;
+		windowOffset[0] = windowStart;
+		hdfProxy->writeArrayNdSlab(gsoapProxy2_0_1->uuid, "PointParameters", H5T_NATIVE_DOUBLE, &windowParameters[0], numValues, windowOffset, dimCount);
+	}
+}
+
 void IjkGridParametricRepresentation::setGeometryAsParametricSplittedPillarNodesUsingExistingDatasets(
 	const gsoap_resqml2_0_1::resqml2__KDirection & kDirectionKind, const bool & isRightHanded,
 	const std::string & parameters, const std::string & controlPoints, const std::string & controlPointParameters, const unsigned int & controlPointCountPerPillar, short pillarKind, COMMON_NS::AbstractHdfProxy* proxy,
@@ -1522,26 +1095,242 @@ void IjkGridParametricRepresentation::loadPillarInformation(IjkGridParametricRep
 		getPillarsOfSplitCoordinateLines(pillarInfo.pillarOfSplitCoordLines);
 	}
 
-	// Spline creation
+	pillarInfo.createSplines();
+}
+
+namespace {
+	/**
+	* Read the values of a window of pillars from a dataset indexed by pillar.
+	* The dataset dimensions are either {[leadingCount,] J pillar, I pillar [, valueCountPerPillar]} or {[leadingCount,] pillar [, valueCountPerPillar]}.
+	* Values are ordered by leading dimension, then by J, then by I and finally by value.
+	*/
+	void readPillarWindowOfDoubleValues(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, double * values,
+		const unsigned long long & leadingCount, const unsigned long long & valueCountPerPillar, const unsigned long long & iPillarCountOfGrid,
+		const unsigned long long & iStart, const unsigned long long & iCount, const unsigned long long & jStart, const unsigned long long & jCount)
+	{
+		const unsigned int rank = hdfProxy->getDimensionCount(datasetName);
+		const unsigned int otherDimCount = (leadingCount > 0 ? 1 : 0) + (valueCountPerPillar > 1 ? 1 : 0);
+
+		unsigned long long blockCountPerDimension[4];
+		unsigned long long offsetPerDimension[4];
+		unsigned long long strideInEachDimension[4];
+		unsigned long long blockSizeInEachDimension[4];
+		unsigned int dimIndex = 0;
+		if (leadingCount > 0) {
+			blockCountPerDimension[dimIndex] = 1;
+			offsetPerDimension[dimIndex] = 0;
+			strideInEachDimension[dimIndex] = 1;
+			blockSizeInEachDimension[dimIndex++] = leadingCount;
+		}
+		if (rank == 2 + otherDimCount) { // J and I are distinct dimensions
+			blockCountPerDimension[dimIndex] = 1;
+			offsetPerDimension[dimIndex] = jStart;
+			strideInEachDimension[dimIndex] = 1;
+			blockSizeInEachDimension[dimIndex++] = jCount;
+			blockCountPerDimension[dimIndex] = 1;
+			offsetPerDimension[dimIndex] = iStart;
+			strideInEachDimension[dimIndex] = 1;
+			blockSizeInEachDimension[dimIndex++] = iCount;
+		}
+		else if (rank == 1 + otherDimCount) { // pillars are flattened : one block per J pillar row
+			blockCountPerDimension[dimIndex] = jCount;
+			offsetPerDimension[dimIndex] = jStart * iPillarCountOfGrid + iStart;
+			strideInEachDimension[dimIndex] = iPillarCountOfGrid;
+			blockSizeInEachDimension[dimIndex++] = iCount;
+		}
+		else {
+			throw invalid_argument("The dataset " + datasetName + " has not the expected dimension count for a pillar dataset.");
+		}
+		if (valueCountPerPillar > 1) {
+			blockCountPerDimension[dimIndex] = 1;
+			offsetPerDimension[dimIndex] = 0;
+			strideInEachDimension[dimIndex] = 1;
+			blockSizeInEachDimension[dimIndex++] = valueCountPerPillar;
+		}
+
+		hdfProxy->readArrayNdOfDoubleValues(datasetName, values,
+			blockCountPerDimension, offsetPerDimension, strideInEachDimension, blockSizeInEachDimension, rank);
+	}
+
+	/**
+	* Read the line kinds of a window of pillars from a dataset whose dimensions are either {J pillar, I pillar} or {pillar}.
+	* Line kinds are ordered by J and then by I.
+	*/
+	void readPillarWindowOfLineKinds(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, short * pillarKind, const unsigned long long & iPillarCountOfGrid,
+		const unsigned long long & iStart, const unsigned long long & iCount, const unsigned long long & jStart, const unsigned long long & jCount)
+	{
+		const unsigned int rank = hdfProxy->getDimensionCount(datasetName);
+		int* values = new int[iCount * jCount];
+		if (rank == 2) {
+			unsigned long long numValuesInEachDimension[2] = { jCount, iCount };
+			unsigned long long offsetInEachDimension[2] = { jStart, iStart };
+			hdfProxy->readArrayNdOfIntValues(datasetName, values, numValuesInEachDimension, offsetInEachDimension, 2);
+		}
+		else if (rank == 1) { // pillars are flattened : one block per J pillar row
+			unsigned long long blockCount = jCount;
+			unsigned long long offset = jStart * iPillarCountOfGrid + iStart;
+			unsigned long long stride = iPillarCountOfGrid;
+			unsigned long long blockSize = iCount;
+			hdfProxy->readArrayNdOfValues(datasetName, values, &blockCount, &offset, &stride, &blockSize, 1, H5T_NATIVE_INT);
+		}
+		else {
+			delete[] values;
+			throw invalid_argument("The dataset " + datasetName + " has not the expected dimension count for a line kind dataset.");
+		}
+
+		for (unsigned long long index = 0; index < iCount * jCount; ++index) {
+			pillarKind[index] = static_cast<short>(values[index]);
+		}
+		delete[] values;
+	}
+}
+
+std::shared_ptr<IjkGridParametricRepresentation::PillarInformation> IjkGridParametricRepresentation::getPillarInformation() const
+{
+	std::shared_ptr<PillarInformation> pillarInfo = cachedPillarInformation.lock();
+	if (!pillarInfo) {
+		if (getEpcDocument() == nullptr)
+			throw invalid_argument("The ijk grid must belong to an EPC document to load its pillar information.");
+
+		PillarInformation* loadedPillarInfo = new PillarInformation();
+		try {
+			loadPillarInformation(*loadedPillarInfo);
+		}
+		catch (...) {
+			delete loadedPillarInfo;
+			throw;
+		}
+		pillarInfo = std::static_pointer_cast<PillarInformation>(getEpcDocument()->getGeometryCache()->put(this, COMMON_NS::GeometryCache::PILLAR_INFORMATION, loadedPillarInfo));
+		cachedPillarInformation = pillarInfo;
+	}
+
+	return pillarInfo;
+}
+
+void IjkGridParametricRepresentation::loadPillarInformationOfBlock(IjkGridParametricRepresentation::PillarInformation & pillarInfo) const
+{
+	if (blockInformation == nullptr)
+		throw invalid_argument("The block information must have been loaded first.");
+
+	pillarInfo.cleanMemory();
+
+	gsoap_resqml2_0_1::resqml2__PointGeometry* geom = getPointGeometry2_0_1(0);
+	if (geom == nullptr) {
+		throw invalid_argument("There is no geometry on this grid.");
+	}
+	if (geom->Points->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__Point3dParametricArray)
+	{
+		throw invalid_argument("The geometry of the grid is not a parametric one.");
+	}
+	resqml2__Point3dParametricArray* parametricPoint3d = static_cast<resqml2__Point3dParametricArray*>(geom->Points);
+
+	if (parametricPoint3d->ParametricLines->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__ParametricLineArray) {
+		throw logic_error("Parametric lines should be of type resqml2__ParametricLineArray. Other type is not implemented yet.");
+	}
+
+	resqml2__ParametricLineArray* paramLineArray = static_cast<resqml2__ParametricLineArray*>(parametricPoint3d->ParametricLines);
+	const unsigned int iPillarCountOfGrid = getICellCount() + 1;
+	const unsigned int iStart = blockInformation->iInterfaceStart;
+	const unsigned int iCount = blockInformation->iInterfaceEnd - blockInformation->iInterfaceStart + 1;
+	const unsigned int jStart = blockInformation->jInterfaceStart;
+	const unsigned int jCount = blockInformation->jInterfaceEnd - blockInformation->jInterfaceStart + 1;
+	pillarInfo.maxControlPointCount = getControlPointMaxCountPerPillar();
+	pillarInfo.parametricLineCount = iCount * jCount;
+	pillarInfo.splitLineCount = blockInformation->globalToLocalSplitCoordinateLinesIndex.size();
+
+	// Control points
+	if (paramLineArray->ControlPoints->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__Point3dHdf5Array) {
+		throw logic_error("Not yet implemented");
+	}
+	pillarInfo.controlPoints = new double[pillarInfo.parametricLineCount*pillarInfo.maxControlPointCount * 3];
+	readPillarWindowOfDoubleValues(hdfProxy, static_cast<resqml2__Point3dHdf5Array*>(paramLineArray->ControlPoints)->Coordinates->PathInHdfFile, pillarInfo.controlPoints,
+		pillarInfo.maxControlPointCount, 3, iPillarCountOfGrid, iStart, iCount, jStart, jCount);
+
+	// Control points parameters
+	if (paramLineArray->ControlPointParameters != nullptr) {
+		if (paramLineArray->ControlPointParameters->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml2__DoubleHdf5Array) {
+			throw logic_error("Not yet implemented");
+		}
+		pillarInfo.controlPointParameters = new double[pillarInfo.parametricLineCount*pillarInfo.maxControlPointCount];
+		readPillarWindowOfDoubleValues(hdfProxy, static_cast<resqml2__DoubleHdf5Array*>(paramLineArray->ControlPointParameters)->Values->PathInHdfFile, pillarInfo.controlPointParameters,
+			pillarInfo.maxControlPointCount, 1, iPillarCountOfGrid, iStart, iCount, jStart, jCount);
+	}
+
+	// Line kind indices
+	pillarInfo.pillarKind = new short[pillarInfo.parametricLineCount];
+	if (paramLineArray->LineKindIndices->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array) {
+		readPillarWindowOfLineKinds(hdfProxy, static_cast<resqml2__IntegerHdf5Array*>(paramLineArray->LineKindIndices)->Values->PathInHdfFile, pillarInfo.pillarKind,
+			iPillarCountOfGrid, iStart, iCount, jStart, jCount);
+	}
+	else if (paramLineArray->LineKindIndices->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerConstantArray) {
+		const short value = static_cast<short>(static_cast<resqml2__IntegerConstantArray*>(paramLineArray->LineKindIndices)->Value);
+		for (unsigned int pillarIndex = 0; pillarIndex < pillarInfo.parametricLineCount; ++pillarIndex) {
+			pillarInfo.pillarKind[pillarIndex] = value;
+		}
+	}
+	else
+		throw std::logic_error("Not yet implemented");
+
+	// Pillars of the block split coordinate lines
+	if (pillarInfo.splitLineCount > 0) {
+		const std::shared_ptr<SplitInformation> splitInfo = getSplitInformation();
+		if (!splitInfo)
+			throw invalid_argument("The split information must have been loaded first.");
+		std::vector< std::pair< unsigned int, std::vector<unsigned int> > >* splitInformation = splitInfo->splitCoordinateLinesOfPillars;
+		pillarInfo.pillarOfSplitCoordLines = new unsigned int[pillarInfo.splitLineCount];
+		const std::map<unsigned int, unsigned int> & blockSplitLines = blockInformation->globalToLocalSplitCoordinateLinesIndex;
+		for (unsigned int j = 0; j < jCount; ++j) {
+			for (unsigned int i = 0; i < iCount; ++i) {
+				const unsigned int globalPillarIndex = getGlobalIndexPillarFromIjIndex(iStart + i, jStart + j);
+				for (size_t splitCoordinateLineIndex = 0; splitCoordinateLineIndex < splitInformation[globalPillarIndex].size(); ++splitCoordinateLineIndex) {
+					std::map<unsigned int, unsigned int>::const_iterator it = blockSplitLines.find(splitInformation[globalPillarIndex][splitCoordinateLineIndex].first);
+					if (it != blockSplitLines.end()) {
+						pillarInfo.pillarOfSplitCoordLines[it->second - pillarInfo.parametricLineCount] = i + j * iCount;
+					}
+				}
+			}
+		}
+	}
+
+	pillarInfo.createSplines();
+}
+
+unsigned long long IjkGridParametricRepresentation::PillarInformation::getByteSize() const
+{
+	unsigned long long result = sizeof(PillarInformation);
+	if (controlPoints != nullptr) result += static_cast<unsigned long long>(parametricLineCount) * maxControlPointCount * 3 * sizeof(double);
+	if (controlPointParameters != nullptr) result += static_cast<unsigned long long>(parametricLineCount) * maxControlPointCount * sizeof(double);
+	if (pillarKind != nullptr) result += parametricLineCount * sizeof(short);
+	if (pillarOfSplitCoordLines != nullptr) result += splitLineCount * sizeof(unsigned int);
+	for (size_t parametricLineIndex = 0; parametricLineIndex < splines.size(); ++parametricLineIndex) {
+		// A spline stores 5 coefficients per control point
+		result += sizeof(std::vector<geometry::BSpline>) + splines[parametricLineIndex].size() * (sizeof(geometry::BSpline) + maxControlPointCount * 5 * sizeof(double));
+	}
+	return result;
+}
+
+void IjkGridParametricRepresentation::PillarInformation::createSplines()
+{
+	splines.clear();
 	geometry::BSpline spline;
-	for (unsigned int parametricLineIndex = 0; parametricLineIndex < pillarInfo.parametricLineCount; ++parametricLineIndex) {
+	for (unsigned int parametricLineIndex = 0; parametricLineIndex < parametricLineCount; ++parametricLineIndex) {
 		vector<geometry::BSpline> xyzSplines;
-		if (pillarInfo.pillarKind[parametricLineIndex] == 2 || pillarInfo.pillarKind[parametricLineIndex] == 4) { // X and Y natural cubic spline
+		if (pillarKind[parametricLineIndex] == 2 || pillarKind[parametricLineIndex] == 4) { // X and Y natural cubic spline
 			vector<double> parameters;
 			vector<double> xValues;
 			vector<double> yValues;
-			for (unsigned int cpIndex = 0; cpIndex < pillarInfo.maxControlPointCount; ++cpIndex) {
-				unsigned int globalCpIndex = parametricLineIndex + cpIndex*pillarInfo.parametricLineCount;
-				if (pillarInfo.controlPointParameters != nullptr && pillarInfo.controlPointParameters[globalCpIndex] == pillarInfo.controlPointParameters[globalCpIndex]) {
-					parameters.push_back(pillarInfo.controlPointParameters[globalCpIndex]);
-					xValues.push_back(pillarInfo.controlPoints[globalCpIndex * 3]);
-					yValues.push_back(pillarInfo.controlPoints[globalCpIndex * 3 + 1]);
+			for (unsigned int cpIndex = 0; cpIndex < maxControlPointCount; ++cpIndex) {
+				unsigned int globalCpIndex = parametricLineIndex + cpIndex*parametricLineCount;
+				if (controlPointParameters != nullptr && controlPointParameters[globalCpIndex] == controlPointParameters[globalCpIndex]) {
+					parameters.push_back(controlPointParameters[globalCpIndex]);
+					xValues.push_back(controlPoints[globalCpIndex * 3]);
+					yValues.push_back(controlPoints[globalCpIndex * 3 + 1]);
 				}
 				// A variant in v2.0.1 when the KIL about presency of control point parameters was not existing yet.
-				else if (pillarInfo.pillarKind[parametricLineIndex] == 4 && pillarInfo.controlPoints[globalCpIndex * 3] == pillarInfo.controlPoints[globalCpIndex * 3]) {
-					parameters.push_back(pillarInfo.controlPoints[globalCpIndex * 3 + 2]);
-					xValues.push_back(pillarInfo.controlPoints[globalCpIndex * 3]);
-					yValues.push_back(pillarInfo.controlPoints[globalCpIndex * 3 + 1]);
+				else if (pillarKind[parametricLineIndex] == 4 && controlPoints[globalCpIndex * 3] == controlPoints[globalCpIndex * 3]) {
+					parameters.push_back(controlPoints[globalCpIndex * 3 + 2]);
+					xValues.push_back(controlPoints[globalCpIndex * 3]);
+					yValues.push_back(controlPoints[globalCpIndex * 3 + 1]);
 				}
 			}
 			// X
@@ -1551,10 +1340,10 @@ void IjkGridParametricRepresentation::loadPillarInformation(IjkGridParametricRep
 			spline.setParameterAndValueAtControlPoint(parameters, yValues);
 			xyzSplines.push_back(spline);
 			// Z
-			if (pillarInfo.pillarKind[parametricLineIndex] == 2) { // Z Natural cubic spline
+			if (pillarKind[parametricLineIndex] == 2) { // Z Natural cubic spline
 				vector<double> zValues;
-				for (unsigned int cpIndex = 0; cpIndex < pillarInfo.maxControlPointCount; ++cpIndex) {
-					double zvalue = pillarInfo.controlPoints[parametricLineIndex + cpIndex*pillarInfo.parametricLineCount * 3 + 2];
+				for (unsigned int cpIndex = 0; cpIndex < maxControlPointCount; ++cpIndex) {
+					double zvalue = controlPoints[(parametricLineIndex + cpIndex*parametricLineCount) * 3 + 2];
 					if (zvalue == zvalue) {
 						zValues.push_back(zvalue);
 					}
@@ -1563,7 +1352,79 @@ void IjkGridParametricRepresentation::loadPillarInformation(IjkGridParametricRep
 				xyzSplines.push_back(spline);
 			}
 		}
-		pillarInfo.splines.push_back(xyzSplines);
+		splines.push_back(xyzSplines);
+	}
+}
+
+void IjkGridParametricRepresentation::PillarInformation::computeXyzPoints(const unsigned int & pillarIndex, const double * parameters, const ULONG64 & parameterStride, const unsigned int & nodeCount, double * xyzPoints) const
+{
+	if (pillarKind[pillarIndex] == -1 || parameters[0] != parameters[0]) { // not defined line
+		for (unsigned int k = 0; k < nodeCount; ++k) {
+			xyzPoints[k * parameterStride * 3] = std::numeric_limits<double>::quiet_NaN();
+			xyzPoints[k * parameterStride * 3 + 1] = std::numeric_limits<double>::quiet_NaN();
+			xyzPoints[k * parameterStride * 3 + 2] = std::numeric_limits<double>::quiet_NaN();
+		}
+	}
+	else if (pillarKind[pillarIndex] == 0) { // vertical (parameter must be the Z value)
+		for (unsigned int k = 0; k < nodeCount; ++k) {
+			xyzPoints[k * parameterStride * 3] = controlPoints[pillarIndex * 3];
+			xyzPoints[k * parameterStride * 3 + 1] = controlPoints[pillarIndex * 3 + 1];
+			xyzPoints[k * parameterStride * 3 + 2] = parameters[k * parameterStride];
+		}
+	}
+	else if (pillarKind[pillarIndex] == 1) { // linear interpolation
+		unsigned int controlPointCount = 0;
+		while (controlPointCount < maxControlPointCount &&
+			controlPoints[(pillarIndex + controlPointCount*parametricLineCount) * 3] == controlPoints[(pillarIndex + controlPointCount*parametricLineCount) * 3]) {
+			controlPointCount++;
+		}
+
+		// Control point count on this line
+		if (controlPointCount == 2) { // straight
+			double parameterDistance = .0;
+			if (controlPointParameters != nullptr)
+				parameterDistance = controlPointParameters[pillarIndex + parametricLineCount] - controlPointParameters[pillarIndex]; // Parameter distance from top to bottom.
+			else // Should never occur by business rule. Assume the parameters are Z values for now (workaround for some softwares)....
+				parameterDistance = controlPoints[(pillarIndex + parametricLineCount) * 3 + 2] - controlPoints[pillarIndex * 3 + 2]; // Parameter distance from top to bottom.
+
+			const double xDist = controlPoints[(pillarIndex + parametricLineCount) * 3] - controlPoints[pillarIndex * 3];
+			const double yDist = controlPoints[(pillarIndex + parametricLineCount) * 3 + 1] - controlPoints[pillarIndex * 3 + 1];
+			const double zDist = controlPoints[(pillarIndex + parametricLineCount) * 3 + 2] - controlPoints[pillarIndex * 3 + 2];
+
+			double ratioFromFirstControlPoint = .0;
+			for (unsigned int k = 0; k < nodeCount; ++k) {
+				if (parameterDistance != .0) {
+					if (controlPointParameters != nullptr)
+						ratioFromFirstControlPoint = (parameters[k * parameterStride] - controlPointParameters[pillarIndex]) / parameterDistance;
+					else // Should never occur by business rule. Assume the parameters are Z values for now (workaround for some softwares)....
+						ratioFromFirstControlPoint = (parameters[k * parameterStride] - controlPoints[pillarIndex * 3 + 2]) / parameterDistance;
+				}
+				else
+					ratioFromFirstControlPoint = .0;
+
+				xyzPoints[k * parameterStride * 3] = controlPoints[pillarIndex * 3] + ratioFromFirstControlPoint * xDist;
+				xyzPoints[k * parameterStride * 3 + 1] = controlPoints[pillarIndex * 3 + 1] + ratioFromFirstControlPoint * yDist;
+				xyzPoints[k * parameterStride * 3 + 2] = controlPoints[pillarIndex * 3 + 2] + ratioFromFirstControlPoint * zDist;
+			}
+		}
+		else { // piecewise linear
+			throw logic_error("Piecewise linear pillars are not implemented yet");
+		}
+	}
+	else if (pillarKind[pillarIndex] == 2 || pillarKind[pillarIndex] == 4) { // XY Natural cubic spline
+		for (unsigned int k = 0; k < nodeCount; ++k) {
+			xyzPoints[k * parameterStride * 3] = splines[pillarIndex][0].getValueFromParameter(parameters[k * parameterStride]);
+			xyzPoints[k * parameterStride * 3 + 1] = splines[pillarIndex][1].getValueFromParameter(parameters[k * parameterStride]);
+			if (pillarKind[pillarIndex] == 2) { //  Z natural cubic spline
+				xyzPoints[k * parameterStride * 3 + 2] = splines[pillarIndex][2].getValueFromParameter(parameters[k * parameterStride]);
+			}
+			else { // Z linear cubic spline
+				xyzPoints[k * parameterStride * 3 + 2] = parameters[k * parameterStride];
+			}
+		}
+	}
+	else {
+		throw logic_error("Computing XYZ from parameters on a non natural cubic spline or on a minimum curvature spline is not implemented yet.");
 	}
 }
 
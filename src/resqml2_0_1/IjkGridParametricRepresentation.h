@@ -29,7 +29,7 @@ namespace RESQML2_0_1_NS
 	private:
 		void getXyzPointsOfPatchFromParametricPoints(gsoap_resqml2_0_1::resqml2__Point3dParametricArray* parametricPoint3d, double * xyzPoints) const;
 	
-		class PillarInformation
+		class PillarInformation : public COMMON_NS::GeometryCache::Entry
 		{
 		public:
 
@@ -54,7 +54,29 @@ namespace RESQML2_0_1_NS
 				if (controlPointParameters != nullptr) delete[] controlPointParameters;
 				if (pillarKind != nullptr) delete[] pillarKind;
 				if (pillarOfSplitCoordLines != nullptr) delete[] pillarOfSplitCoordLines;
+				controlPoints = nullptr;
+				controlPointParameters = nullptr;
+				pillarKind = nullptr;
+				pillarOfSplitCoordLines = nullptr;
+				splines.clear();
 			}
+
+			/**
+			* Create the splines of the natural cubic spline (and Z linear cubic spline) pillars from the control points and their parameters.
+			*/
+			void createSplines();
+
+			/**
+			* Compute the XYZ points of a coordinate line from their parameters.
+			* @param pillarIndex		The index of the pillar (in this pillar information) the coordinate line belongs to.
+			* @param parameters			The parameters of the nodes of the coordinate line, parameterStride values apart.
+			* @param parameterStride	The count of values between two consecutive nodes of the coordinate line in parameters and in xyzPoints (in XYZ point count).
+			* @param nodeCount			The count of nodes to compute.
+			* @param xyzPoints			Output XYZ points of the nodes.
+			*/
+			void computeXyzPoints(const unsigned int & pillarIndex, const double * parameters, const ULONG64 & parameterStride, const unsigned int & nodeCount, double * xyzPoints) const;
+
+			unsigned long long getByteSize() const;
 		};
 
 		/**
@@ -63,12 +85,41 @@ namespace RESQML2_0_1_NS
 		*/
 		void loadPillarInformation(PillarInformation & pillarInfo) const;
 
+		/**
+		* Load in pillarInfo parameter the pillar information of the current block only (block information must be loaded).
+		* Pillars are the block ones ordered by I and then by J. Split coordinate lines are indexed by their local block index minus the block pillar count.
+		* Only the block window of the pillar datasets is read.
+		*/
+		void loadPillarInformationOfBlock(PillarInformation & pillarInfo) const;
+
 		/**
 		* Compute the K Direction of the gid according to its contorl points.
 		*/
 		gsoap_resqml2_0_1::resqml2__KDirection computeKDirection(double * controlPoints, const unsigned int & controlPointCountPerPillar);
-	protected:
-		PillarInformation* pillarInformation;
+
+		/**
+		* Write the pillar kinds and the defined pillars of a geometry which has first been set with a constant pillar kind.
+		*/
+		void setParametricLineKinds(const gsoap_resqml2_0_1::resqml2__PillarShape & mostComplexPillarGeometry, const unsigned int & controlPointMaxCountPerPillar, short * pillarKind, COMMON_NS::AbstractHdfProxy* proxy);
+
+		/**
+		* Write the hdf datasets of the parametric lines (control points and their parameters) and of the split coordinate lines.
+		*/
+		void writeParametricLines(double * controlPoints, double * controlPointParameters, const unsigned int & controlPointCountPerPillar,
+			const unsigned long & splitCoordinateLineCount, unsigned int * pillarOfCoordinateLine,
+			unsigned int * splitCoordinateLineColumnCumulativeCount, unsigned int * splitCoordinateLineColumns);
+
+		/**
+		* Get the pillar information of the whole grid from the geometry cache of the EPC document.
+		* It is loaded (or reloaded if it has been evicted from the cache) if necessary.
+		* The returned pointer pins the pillar information : keep it while using its content.
+		*/
+		std::shared_ptr<PillarInformation> getPillarInformation() const;
+
+		/**
+		* The pillar information of the geometry cache, which expires when it is evicted from the cache.
+		*/
+		mutable std::weak_ptr<PillarInformation> cachedPillarInformation;
 	
 	public:
 		IjkGridParametricRepresentation(soap* soapContext, RESQML2_NS::AbstractLocal3dCrs * crs,
@@ -84,16 +135,13 @@ namespace RESQML2_0_1_NS
 		/**
 		* Creates an instance of this class by wrapping a gsoap instance.
 		*/
-		IjkGridParametricRepresentation(gsoap_resqml2_0_1::_resqml2__IjkGridRepresentation* fromGsoap) : AbstractIjkGridRepresentation(fromGsoap), pillarInformation(nullptr) {}
-		IjkGridParametricRepresentation(gsoap_resqml2_0_1::_resqml2__TruncatedIjkGridRepresentation* fromGsoap) : AbstractIjkGridRepresentation(fromGsoap), pillarInformation(nullptr) {}
+		IjkGridParametricRepresentation(gsoap_resqml2_0_1::_resqml2__IjkGridRepresentation* fromGsoap) : AbstractIjkGridRepresentation(fromGsoap) {}
+		IjkGridParametricRepresentation(gsoap_resqml2_0_1::_resqml2__TruncatedIjkGridRepresentation* fromGsoap) : AbstractIjkGridRepresentation(fromGsoap) {}
 
 		/**
-		* Destructor clean pillarInformation memory when allocated
+		* Destructor does nothing since the pillar information memory is managed by the geometry cache of the EPC document (released by the base class destructor).
 		*/
-		virtual ~IjkGridParametricRepresentation() { 
-			if (pillarInformation != nullptr) 
-				delete pillarInformation; 
-		}
+		virtual ~IjkGridParametricRepresentation() {}
 
 		std::string getHdfProxyUuid() const;
 
@@ -253,6 +301,45 @@ namespace RESQML2_0_1_NS
 			const unsigned long & splitCoordinateLineCount, unsigned int * pillarOfCoordinateLine,
 			unsigned int * splitCoordinateLineColumnCumulativeCount, unsigned int * splitCoordinateLineColumns);
 
+		/**
+		* Generates the parameters of the nodes of a parametric IJK grid one K interface at a time.
+		* It allows to write the geometry of a grid which does not fit in memory.
+		*/
+		class DLL_IMPORT_OR_EXPORT ParameterLayerGenerator
+		{
+		public:
+			virtual ~ParameterLayerGenerator() {}
+
+			/**
+			* Fill the parameters of the nodes of a K interface.
+			* It is called concurrently by several threads for distinct K interfaces (see parallel::setMaxThreadCount) and in no particular order.
+			* @param kInterfaceIndex	The index of the K interface to generate.
+			* @param parameters			The parameter of each node ordered by i then j then split. It is preallocated with a count of (iCellCount+1) * (jCellCount+1) + splitCoordinateLineCount.
+			*/
+			virtual void generateLayer(const unsigned int & kInterfaceIndex, double * parameters) = 0;
+		};
+
+		/**
+		* Same as setGeometryAsParametricSplittedPillarNodes where the parameters are not given at once but generated and written by K interface.
+		* The K interfaces are generated concurrently by windows of parallel::getMaxThreadCount() interfaces which are written before the next window is generated.
+		* The control points are still given at once : they are (kCellCount+1) / controlPointMaxCountPerPillar times smaller than the parameters.
+		* @param generator	The generator of the parameters of each K interface. It cannot be null.
+		*/
+		void setGeometryAsParametricSplittedPillarNodesByLayer(
+			const gsoap_resqml2_0_1::resqml2__PillarShape & mostComplexPillarGeometry, const bool & isRightHanded,
+			ParameterLayerGenerator * generator, double * controlPoints, double * controlPointParameters, const unsigned int & controlPointMaxCountPerPillar, short * pillarKind, COMMON_NS::AbstractHdfProxy* proxy,
+			const unsigned long & splitCoordinateLineCount = 0, unsigned int * pillarOfCoordinateLine = nullptr,
+			unsigned int * splitCoordinateLineColumnCumulativeCount = nullptr, unsigned int * splitCoordinateLineColumns = nullptr);
+
+		/**
+		* Same as setGeometryAsParametricSplittedPillarNodes where all pillars are of the same kind and where the parameters are generated and written by K interface.
+		* @param generator	The generator of the parameters of each K interface. It cannot be null.
+		*/
+		void setGeometryAsParametricSplittedPillarNodesByLayer(const bool & isRightHanded,
+			ParameterLayerGenerator * generator, double * controlPoints, double * controlPointParameters, const unsigned int & controlPointCountPerPillar, short pillarKind, COMMON_NS::AbstractHdfProxy* proxy,
+			const unsigned long & splitCoordinateLineCount = 0, unsigned int * pillarOfCoordinateLine = nullptr,
+			unsigned int * splitCoordinateLineColumnCumulativeCount = nullptr, unsigned int * splitCoordinateLineColumns = nullptr);
+
 		/**
 		* Same as setGeometryAsParametricSplittedPillarNodes where the hdf datasets are already written in the the file.
 		*/
@@ -359,6 +359,97 @@ void SubRepresentation::getElementIndicesOfPatch(const unsigned int & patchIndex
 	}
 }
 
+void SubRepresentation::getElementIndicesOfPatch(const unsigned int & patchIndex, const unsigned int & elementIndicesIndex, indexing::IndexSet & elementIndices) const
+{
+	_resqml2__SubRepresentation* rep = getSpecializedGsoapProxy();
+	if (rep->SubRepresentationPatch.size() <= patchIndex) {
+		throw range_error("The patch does not exist at this index.");
+	}
+	if (rep->SubRepresentationPatch[patchIndex]->ElementIndices.size() <= elementIndicesIndex) {
+		throw range_error("The elementIndices does not exist at this index.");
+	}
+
+	resqml2__AbstractIntegerArray* indices = rep->SubRepresentationPatch[patchIndex]->ElementIndices[elementIndicesIndex]->Indices;
+	if (indices->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerLatticeArray) {
+		resqml2__IntegerLatticeArray* lattice = static_cast<resqml2__IntegerLatticeArray*>(indices);
+		const size_t dimCount = lattice->Offset.size();
+
+		// The lowest index of the lattice must not be negative.
+		LONG64 lowestIndex = lattice->StartValue;
+		for (size_t dim = 0; dim < dimCount; ++dim) {
+			if (lattice->Offset[dim]->Value < 0) {
+				lowestIndex += lattice->Offset[dim]->Value * lattice->Offset[dim]->Count;
+			}
+		}
+		if (lowestIndex < 0) {
+			throw range_error("The lattice of element indices contains negative indices.");
+		}
+
+		if (dimCount == 0) {
+			elementIndices.add(lattice->StartValue);
+			return;
+		}
+
+		// Odometer over all dimensions but the fastest one which is added as a range when possible.
+		std::vector<ULONG64> position(dimCount - 1, 0);
+		const LONG64 fastestValue = lattice->Offset[dimCount - 1]->Value;
+		const ULONG64 fastestCount = lattice->Offset[dimCount - 1]->Count + 1;
+		while (true) {
+			LONG64 first = lattice->StartValue;
+			for (size_t dim = 0; dim < dimCount - 1; ++dim) {
+				first += static_cast<LONG64>(position[dim]) * lattice->Offset[dim]->Value;
+			}
+			if (fastestValue == 1) {
+				elementIndices.addRange(first, first + fastestCount);
+			}
+			else if (fastestValue == -1) {
+				elementIndices.addRange(first - fastestCount + 1, first + 1);
+			}
+			else {
+				for (ULONG64 i = 0; i < fastestCount; ++i) {
+					elementIndices.add(first + static_cast<LONG64>(i) * fastestValue);
+				}
+			}
+
+			size_t dim = dimCount - 1;
+			while (dim > 0 && ++position[dim - 1] > static_cast<ULONG64>(lattice->Offset[dim - 1]->Count)) {
+				position[dim - 1] = 0;
+				--dim;
+			}
+			if (dim == 0) {
+				break;
+			}
+		}
+	}
+	else if (indices->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array) {
+		resqml2__IntegerHdf5Array* hdfIndices = static_cast<resqml2__IntegerHdf5Array*>(indices);
+		const ULONG64 nullValue = static_cast<ULONG64>(hdfIndices->NullValue);
+		const ULONG64 elementCount = getElementCountOfPatch(patchIndex);
+
+		// Read by chunks in order to never materialize all the indices
+		const ULONG64 chunkSize = 1 << 20;
+		std::vector<ULONG64> chunk(elementCount < chunkSize ? elementCount : chunkSize);
+		for (ULONG64 offset = 0; offset < elementCount; offset += chunkSize) {
+			unsigned long long count = elementCount - offset < chunkSize ? elementCount - offset : chunkSize;
+			unsigned long long hdfOffset = offset;
+			hdfProxy->readArrayNdOfGSoapULong64Values(hdfIndices->Values->PathInHdfFile, &chunk[0], &count, &hdfOffset, 1);
+
+			// Remove the null values
+			ULONG64 kept = 0;
+			for (ULONG64 i = 0; i < count; ++i) {
+				if (chunk[i] != nullValue) {
+					chunk[kept++] = chunk[i];
+				}
+			}
+			elementIndices.add(&chunk[0], kept);
+		}
+	}
+	else {
+		throw logic_error("Not yet implemented");
+	}
+	elementIndices.optimize();
+}
+
 void SubRepresentation::getSupportingRepresentationIndicesOfPatch(const unsigned int & patchIndex, short * supportingRepresentationIndices) const
 {
 	const _resqml2__SubRepresentation* rep = getSpecializedGsoapProxy();
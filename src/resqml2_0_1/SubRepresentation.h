@@ -101,6 +101,13 @@ namespace RESQML2_0_1_NS
 		*/
 		void getElementIndicesOfPatch(const unsigned int & patchIndex, const unsigned int & elementIndicesIndex, ULONG64 * elementIndices) const;
 
+		/**
+		* Get the indices of the selected elements in the supporting representation for a particular patch of this subrepresentation without expanding them.
+		* @param	elementIndicesIndex	Must be equal to 0 if the element indices are not pairwise.
+		* @param	elementIndices		The set where the element indices are added.
+		*/
+		void getElementIndicesOfPatch(const unsigned int & patchIndex, const unsigned int & elementIndicesIndex, indexing::IndexSet & elementIndices) const;
+
 		/**
 		* Get the indices of the supporting representations of the selected elements for a particular patch of this subrepresentation.
 		* @param	supportingRepresentationIndices	This array must be preallocated with getElementCountOfPatch() size.
@@ -20,6 +20,10 @@ under the License.
 #include "resqml2_0_1/UnstructuredGridRepresentation.h"
 
 #include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <limits>
+#include <cmath>
 
 #include "hdf5.h"
 
@@ -27,12 +31,294 @@ under the License.
 #include "resqml2/AbstractLocal3dCrs.h"
 #include "common/AbstractHdfProxy.h"
 
+#include "tools/Parallel.h"
+
 using namespace std;
 using namespace gsoap_resqml2_0_1;
 using namespace RESQML2_0_1_NS;
 
 const char* UnstructuredGridRepresentation::XML_TAG = "UnstructuredGridRepresentation";
 
+namespace {
+	void readIndexValues(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, ULONG64* values)
+	{
+		hdfProxy->readArrayNdOfGSoapULong64Values(datasetName, values);
+	}
+
+	// HDF5 converts the stored integer width into the memory one while reading : there is no intermediate 64 bits copy.
+	void readIndexValues(COMMON_NS::AbstractHdfProxy* hdfProxy, const std::string & datasetName, unsigned int* values)
+	{
+		hdfProxy->readArrayNdOfUIntValues(datasetName, values);
+	}
+
+	template <class T> void readJaggedArrayElements(COMMON_NS::AbstractHdfProxy* hdfProxy, resqml2__ResqmlJaggedArray* jaggedArray, T* values)
+	{
+		if (jaggedArray->Elements->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array) {
+			readIndexValues(hdfProxy, static_cast<resqml2__IntegerHdf5Array*>(jaggedArray->Elements)->Values->PathInHdfFile, values);
+		}
+		else {
+			throw logic_error("Not yet implemented");
+		}
+	}
+
+	/**
+	* Read the cumulative length of a jagged array. A constant cumulative length must have been checked before by the caller.
+	*/
+	template <class T> void readJaggedArrayCumulativeLength(COMMON_NS::AbstractHdfProxy* hdfProxy, resqml2__ResqmlJaggedArray* jaggedArray, const ULONG64 & count, T* values)
+	{
+		if (jaggedArray->CumulativeLength->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array) {
+			readIndexValues(hdfProxy, static_cast<resqml2__IntegerHdf5Array*>(jaggedArray->CumulativeLength)->Values->PathInHdfFile, values);
+		}
+		else if (jaggedArray->CumulativeLength->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerLatticeArray) {
+			resqml2__IntegerLatticeArray* lattice = static_cast<resqml2__IntegerLatticeArray*>(jaggedArray->CumulativeLength);
+			values[0] = static_cast<T>(lattice->StartValue);
+			const T offsetValue = static_cast<T>(lattice->Offset[0]->Value);
+			for (ULONG64 index = 1; index < count; ++index) {
+				values[index] = values[index - 1] + offsetValue;
+			}
+		}
+		else if (jaggedArray->CumulativeLength->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerConstantArray) {
+			values[0] = static_cast<T>(static_cast<resqml2__IntegerConstantArray*>(jaggedArray->CumulativeLength)->Value);
+		}
+	}
+
+	/**
+	* Get the range [begin, end) of the items of a row of a jagged array which is defined either by a constant count or by cumulative counts.
+	*/
+	template <class T> inline void getJaggedArrayRowRange(const T* cumulativeCounts, const unsigned int & constantCount, const ULONG64 & row, ULONG64 & begin, ULONG64 & end)
+	{
+		if (constantCount != 0) {
+			begin = constantCount * row;
+			end = begin + constantCount;
+		}
+		else {
+			begin = row == 0 ? 0 : cumulativeCounts[row - 1];
+			end = cumulativeCounts[row];
+		}
+	}
+
+	/**
+	* Add to volume and moment the signed volume of the tetrahedron (r, a, b, c) and its first moment.
+	* The volume is positive if the triangle (a, b, c) is counterclockwise when seen from the outside i.e. from the opposite side of r.
+	*/
+	inline void addTetrahedron(const double* r, const double* a, const double* b, const double* c, const double & sign, double & volume, double* moment)
+	{
+		const double ax = a[0] - r[0], ay = a[1] - r[1], az = a[2] - r[2];
+		const double bx = b[0] - r[0], by = b[1] - r[1], bz = b[2] - r[2];
+		const double cx = c[0] - r[0], cy = c[1] - r[1], cz = c[2] - r[2];
+		const double tetraVolume = sign * (ax * (by * cz - bz * cy) + ay * (bz * cx - bx * cz) + az * (bx * cy - by * cx)) / 6.0;
+		volume += tetraVolume;
+		for (unsigned int dim = 0; dim < 3; ++dim) {
+			moment[dim] += tetraVolume * (r[dim] + a[dim] + b[dim] + c[dim]) / 4.0;
+		}
+	}
+
+	/**
+	* Compute the center (average of the nodes), the vector area and the centroid of a range of faces.
+	* Each output is optional. A triangular face is directly computed, other faces are split into a fan of triangles around their center.
+	* @tparam NODE_COUNT	The constant node count of the faces which is known at compile time or 0 if it must be read from the cumulative counts.
+	*/
+	template <class T, unsigned int NODE_COUNT> void computeFaceGeometryOfRange(const T* nodeIndicesOfFaces, const T* cumulativeNodeCountPerFace, const unsigned int & constantNodeCountPerFace,
+		const ULONG64 & firstFace, const ULONG64 & endFace, const double* xyz, double* faceCenters, double* faceAreaVectors, double* faceCentroids)
+	{
+		for (ULONG64 face = firstFace; face < endFace; ++face) {
+			ULONG64 begin, end;
+			if (NODE_COUNT != 0) {
+				begin = NODE_COUNT * face;
+				end = begin + NODE_COUNT;
+			}
+			else {
+				getJaggedArrayRowRange(cumulativeNodeCountPerFace, constantNodeCountPerFace, face, begin, end);
+			}
+			const T* nodes = nodeIndicesOfFaces + begin;
+			const ULONG64 nodeCount = NODE_COUNT != 0 ? NODE_COUNT : end - begin;
+
+			double center[3] = { 0, 0, 0 };
+			for (ULONG64 i = 0; i < nodeCount; ++i) {
+				for (unsigned int dim = 0; dim < 3; ++dim) {
+					center[dim] += xyz[3 * nodes[i] + dim];
+				}
+			}
+			for (unsigned int dim = 0; dim < 3; ++dim) {
+				center[dim] /= nodeCount;
+			}
+			if (faceCenters != nullptr) {
+				std::copy(center, center + 3, faceCenters + 3 * face);
+			}
+			if (faceAreaVectors == nullptr && faceCentroids == nullptr) {
+				continue;
+			}
+
+			// Vector area of each fan triangle (center, a, b) and weighted triangle centroids
+			double areaVector[3] = { 0, 0, 0 };
+			double weightedCentroid[3] = { 0, 0, 0 };
+			double weight = 0;
+			const ULONG64 triangleCount = nodeCount == 3 ? 1 : nodeCount;
+			for (unsigned int pass = 0; pass < 2; ++pass) {
+				for (ULONG64 i = 0; i < triangleCount; ++i) {
+					const double* o = nodeCount == 3 ? xyz + 3 * nodes[0] : center;
+					const double* a = xyz + 3 * nodes[nodeCount == 3 ? 1 : i];
+					const double* b = xyz + 3 * nodes[nodeCount == 3 ? 2 : (i + 1) % nodeCount];
+					const double ux = a[0] - o[0], uy = a[1] - o[1], uz = a[2] - o[2];
+					const double vx = b[0] - o[0], vy = b[1] - o[1], vz = b[2] - o[2];
+					const double triangleAreaVector[3] = { 0.5 * (uy * vz - uz * vy), 0.5 * (uz * vx - ux * vz), 0.5 * (ux * vy - uy * vx) };
+					if (pass == 0) {
+						for (unsigned int dim = 0; dim < 3; ++dim) {
+							areaVector[dim] += triangleAreaVector[dim];
+						}
+					}
+					else {
+						// The area of a triangle is counted along the face normal : it correctly weights triangles of a non planar face.
+						const double triangleWeight = triangleAreaVector[0] * areaVector[0] + triangleAreaVector[1] * areaVector[1] + triangleAreaVector[2] * areaVector[2];
+						weight += triangleWeight;
+						for (unsigned int dim = 0; dim < 3; ++dim) {
+							weightedCentroid[dim] += triangleWeight * (o[dim] + a[dim] + b[dim]) / 3.0;
+						}
+					}
+				}
+				if (faceCentroids == nullptr) {
+					break;
+				}
+			}
+
+			if (faceAreaVectors != nullptr) {
+				std::copy(areaVector, areaVector + 3, faceAreaVectors + 3 * face);
+			}
+			if (faceCentroids != nullptr) {
+				for (unsigned int dim = 0; dim < 3; ++dim) {
+					faceCentroids[3 * face + dim] = weight > 0 ? weightedCentroid[dim] / weight : center[dim];
+				}
+			}
+		}
+	}
+
+	/**
+	* Compute the center (average of the nodes), the vector area and the centroid of all the faces. Each output is optional.
+	* The faces are shared between threads. Triangular and quadrilateral faces of a constant node count grid (tetrahedral and hexahedral grids) do not go through the cumulative node counts.
+	*/
+	template <class T> void computeFaceGeometryOfTopology(const T* nodeIndicesOfFaces, const T* cumulativeNodeCountPerFace, const unsigned int & constantNodeCountPerFace,
+		const ULONG64 & faceCount, const double* xyz, double* faceCenters, double* faceAreaVectors, double* faceCentroids)
+	{
+		parallel::forEachRange(faceCount, 16384, [&](const unsigned int &, const uint64_t & firstFace, const uint64_t & endFace) {
+			if (constantNodeCountPerFace == 3) {
+				computeFaceGeometryOfRange<T, 3>(nodeIndicesOfFaces, cumulativeNodeCountPerFace, constantNodeCountPerFace, firstFace, endFace, xyz, faceCenters, faceAreaVectors, faceCentroids);
+			}
+			else if (constantNodeCountPerFace == 4) {
+				computeFaceGeometryOfRange<T, 4>(nodeIndicesOfFaces, cumulativeNodeCountPerFace, constantNodeCountPerFace, firstFace, endFace, xyz, faceCenters, faceAreaVectors, faceCentroids);
+			}
+			else {
+				computeFaceGeometryOfRange<T, 0>(nodeIndicesOfFaces, cumulativeNodeCountPerFace, constantNodeCountPerFace, firstFace, endFace, xyz, faceCenters, faceAreaVectors, faceCentroids);
+			}
+		});
+	}
+
+	/**
+	* Compute the volume and the centroid of a range of cells. Each output is optional.
+	* @tparam FACE_COUNT	The constant face count of the cells which is known at compile time or 0 if it must be read from the cumulative counts.
+	* @tparam NODE_COUNT	The constant node count of the faces which is known at compile time or 0 if it must be read from the cumulative counts.
+	* @param faceCenters	The average of the nodes of each face
+	*/
+	template <class T, unsigned int FACE_COUNT, unsigned int NODE_COUNT> void computeCellGeometryOfRange(const T* nodeIndicesOfFaces, const T* cumulativeNodeCountPerFace, const unsigned int & constantNodeCountPerFace,
+		const T* faceIndicesOfCells, const T* cumulativeFaceCountPerCell, const unsigned int & constantFaceCountPerCell,
+		const ULONG64 & firstCell, const ULONG64 & endCell, const double* xyz, const double* faceCenters, const unsigned char* cellFaceIsRightHanded,
+		double* cellVolumes, double* cellCentroids)
+	{
+		for (ULONG64 cell = firstCell; cell < endCell; ++cell) {
+			ULONG64 faceBegin, faceEnd;
+			if (FACE_COUNT != 0) {
+				faceBegin = FACE_COUNT * cell;
+				faceEnd = faceBegin + FACE_COUNT;
+			}
+			else {
+				getJaggedArrayRowRange(cumulativeFaceCountPerCell, constantFaceCountPerCell, cell, faceBegin, faceEnd);
+			}
+
+			double reference[3] = { 0, 0, 0 };
+			for (ULONG64 faceIndexOfCell = faceBegin; faceIndexOfCell < faceEnd; ++faceIndexOfCell) {
+				for (unsigned int dim = 0; dim < 3; ++dim) {
+					reference[dim] += faceCenters[3 * faceIndicesOfCells[faceIndexOfCell] + dim];
+				}
+			}
+			for (unsigned int dim = 0; dim < 3; ++dim) {
+				reference[dim] /= (faceEnd - faceBegin);
+			}
+
+			double volume = 0;
+			double moment[3] = { 0, 0, 0 };
+			for (ULONG64 faceIndexOfCell = faceBegin; faceIndexOfCell < faceEnd; ++faceIndexOfCell) {
+				const ULONG64 face = faceIndicesOfCells[faceIndexOfCell];
+				const double sign = cellFaceIsRightHanded[faceIndexOfCell] != 0 ? 1.0 : -1.0;
+				ULONG64 nodeBegin, nodeEnd;
+				if (NODE_COUNT != 0) {
+					nodeBegin = NODE_COUNT * face;
+					nodeEnd = nodeBegin + NODE_COUNT;
+				}
+				else {
+					getJaggedArrayRowRange(cumulativeNodeCountPerFace, constantNodeCountPerFace, face, nodeBegin, nodeEnd);
+				}
+				const T* nodes = nodeIndicesOfFaces + nodeBegin;
+				const ULONG64 nodeCount = NODE_COUNT != 0 ? NODE_COUNT : nodeEnd - nodeBegin;
+				if (nodeCount == 3) {
+					addTetrahedron(reference, xyz + 3 * nodes[0], xyz + 3 * nodes[1], xyz + 3 * nodes[2], sign, volume, moment);
+				}
+				else {
+					for (ULONG64 i = 0; i < nodeCount; ++i) {
+						addTetrahedron(reference, faceCenters + 3 * face, xyz + 3 * nodes[i], xyz + 3 * nodes[(i + 1) % nodeCount], sign, volume, moment);
+					}
+				}
+			}
+
+			if (cellVolumes != nullptr) {
+				cellVolumes[cell] = volume;
+			}
+			if (cellCentroids != nullptr) {
+				for (unsigned int dim = 0; dim < 3; ++dim) {
+					cellCentroids[3 * cell + dim] = volume != 0 ? moment[dim] / volume : reference[dim];
+				}
+			}
+		}
+	}
+
+	/**
+	* Compute the volume and the centroid of all the cells. Each output is optional.
+	* The cells are shared between threads. Tetrahedral and hexahedral grids (constant face count per cell and constant node count per face) do not go through the cumulative counts.
+	* @param faceCenters	The average of the nodes of each face
+	*/
+	template <class T> void computeCellGeometryOfTopology(const T* nodeIndicesOfFaces, const T* cumulativeNodeCountPerFace, const unsigned int & constantNodeCountPerFace,
+		const T* faceIndicesOfCells, const T* cumulativeFaceCountPerCell, const unsigned int & constantFaceCountPerCell,
+		const ULONG64 & cellCount, const double* xyz, const double* faceCenters, const unsigned char* cellFaceIsRightHanded,
+		double* cellVolumes, double* cellCentroids)
+	{
+		parallel::forEachRange(cellCount, 8192, [&](const unsigned int &, const uint64_t & firstCell, const uint64_t & endCell) {
+			if (constantFaceCountPerCell == 4 && constantNodeCountPerFace == 3) {
+				computeCellGeometryOfRange<T, 4, 3>(nodeIndicesOfFaces, cumulativeNodeCountPerFace, constantNodeCountPerFace, faceIndicesOfCells, cumulativeFaceCountPerCell, constantFaceCountPerCell,
+					firstCell, endCell, xyz, faceCenters, cellFaceIsRightHanded, cellVolumes, cellCentroids);
+			}
+			else if (constantFaceCountPerCell == 6 && constantNodeCountPerFace == 4) {
+				computeCellGeometryOfRange<T, 6, 4>(nodeIndicesOfFaces, cumulativeNodeCountPerFace, constantNodeCountPerFace, faceIndicesOfCells, cumulativeFaceCountPerCell, constantFaceCountPerCell,
+					firstCell, endCell, xyz, faceCenters, cellFaceIsRightHanded, cellVolumes, cellCentroids);
+			}
+			else {
+				computeCellGeometryOfRange<T, 0, 0>(nodeIndicesOfFaces, cumulativeNodeCountPerFace, constantNodeCountPerFace, faceIndicesOfCells, cumulativeFaceCountPerCell, constantFaceCountPerCell,
+					firstCell, endCell, xyz, faceCenters, cellFaceIsRightHanded, cellVolumes, cellCentroids);
+			}
+		});
+	}
+
+	/**
+	* Get the count of elements of a jagged array i.e. the last value of its cumulative length.
+	*/
+	ULONG64 getJaggedArrayElementCount(COMMON_NS::AbstractHdfProxy* hdfProxy, resqml2__ResqmlJaggedArray* jaggedArray)
+	{
+		if (jaggedArray->Elements->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array) {
+			return hdfProxy->getElementCount(static_cast<resqml2__IntegerHdf5Array*>(jaggedArray->Elements)->Values->PathInHdfFile);
+		}
+		else {
+			throw logic_error("Not yet implemented");
+		}
+	}
+}
+
 
 void UnstructuredGridRepresentation::init(soap* soapContext, RESQML2_NS::AbstractLocal3dCrs * crs,
 			const std::string & guid, const std::string & title,
@@ -61,9 +347,7 @@ void UnstructuredGridRepresentation::init(soap* soapContext, RESQML2_NS::Abstrac
 UnstructuredGridRepresentation::UnstructuredGridRepresentation(soap* soapContext, RESQML2_NS::AbstractLocal3dCrs * crs,
 	const std::string & guid, const std::string & title,
 	const ULONG64 & cellCount):
-	AbstractGridRepresentation(nullptr, crs, false), constantNodeCountPerFace(0), constantFaceCountPerCell(0),
-	cumulativeNodeCountPerFace(nullptr), cumulativeFaceCountPerCell(nullptr),
-	nodeIndicesOfFaces(nullptr), faceIndicesOfCells(nullptr)
+	AbstractGridRepresentation(nullptr, crs, false), geometryLoaded(false), geometryIndexedIn32Bits(false)
 {
 	init(soapContext, crs, guid, title, cellCount);
 }
@@ -71,9 +355,7 @@ UnstructuredGridRepresentation::UnstructuredGridRepresentation(soap* soapContext
 UnstructuredGridRepresentation::UnstructuredGridRepresentation(RESQML2_NS::AbstractFeatureInterpretation* interp, RESQML2_NS::AbstractLocal3dCrs * crs,
 	const std::string & guid, const std::string & title,
 	const ULONG64 & cellCount):
-	AbstractGridRepresentation(interp, crs, false), constantNodeCountPerFace(0), constantFaceCountPerCell(0),
-	cumulativeNodeCountPerFace(nullptr), cumulativeFaceCountPerCell(nullptr),
-	nodeIndicesOfFaces(nullptr), faceIndicesOfCells(nullptr)
+	AbstractGridRepresentation(interp, crs, false), geometryLoaded(false), geometryIndexedIn32Bits(false)
 {
 	if (interp == nullptr)
 		throw invalid_argument("The interpretation of the unstructured grid cannot be null.");
@@ -167,12 +449,19 @@ void UnstructuredGridRepresentation::getFaceIndicesOfCells(ULONG64 * faceIndices
 	if (grid->Geometry == nullptr) {
 		throw invalid_argument("There is no geometry in this grid.");
 	}
-	if (grid->Geometry->FacesPerCell->Elements->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array) {
-		hdfProxy->readArrayNdOfGSoapULong64Values(static_cast<resqml2__IntegerHdf5Array*>(grid->Geometry->FacesPerCell->Elements)->Values->PathInHdfFile, faceIndices);	
+	readJaggedArrayElements(hdfProxy, grid->Geometry->FacesPerCell, faceIndices);
+}
+
+void UnstructuredGridRepresentation::getFaceIndicesOfCells(unsigned int * faceIndices) const
+{
+	_resqml2__UnstructuredGridRepresentation* grid = getSpecializedGsoapProxy();
+	if (grid->Geometry == nullptr) {
+		throw invalid_argument("There is no geometry in this grid.");
 	}
-	else {
-		throw logic_error("Not yet implemented");
+	if (getFaceCount() > (numeric_limits<unsigned int>::max)()) {
+		throw range_error("The face count of the grid does not fit in 32 bits.");
 	}
+	readJaggedArrayElements(hdfProxy, grid->Geometry->FacesPerCell, faceIndices);
 }
 
 void UnstructuredGridRepresentation::getCumulativeFaceCountPerCell(ULONG64 * cumulativeFaceCountPerCell) const
@@ -180,26 +469,21 @@ void UnstructuredGridRepresentation::getCumulativeFaceCountPerCell(ULONG64 * cum
 	_resqml2__UnstructuredGridRepresentation* grid = getSpecializedGsoapProxy();
 	if (grid->Geometry == nullptr)
 		throw invalid_argument("There is no geometry in this grid.");
-	if (grid->Geometry->FacesPerCell->CumulativeLength->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array)
-	{
-		hdfProxy->readArrayNdOfGSoapULong64Values(static_cast<resqml2__IntegerHdf5Array*>(grid->Geometry->FacesPerCell->CumulativeLength)->Values->PathInHdfFile, cumulativeFaceCountPerCell);
-	}
-	else if (grid->Geometry->FacesPerCell->CumulativeLength->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerLatticeArray)
-	{
-		cumulativeFaceCountPerCell[0] = static_cast<resqml2__IntegerLatticeArray*>(grid->Geometry->FacesPerCell->CumulativeLength)->StartValue;
-		const LONG64 offsetValue = static_cast<resqml2__IntegerLatticeArray*>(grid->Geometry->FacesPerCell->CumulativeLength)->Offset[0]->Value;
-		const ULONG64 cellCount = getCellCount();
-		for (ULONG64 cumulativeFaceCountPerCellIndex = 1; cumulativeFaceCountPerCellIndex < cellCount; ++cumulativeFaceCountPerCellIndex)
-		{
-			cumulativeFaceCountPerCell[cumulativeFaceCountPerCellIndex] = cumulativeFaceCountPerCell[cumulativeFaceCountPerCellIndex - 1] + offsetValue;
-		}
-	}
-	else if (grid->Geometry->FacesPerCell->CumulativeLength->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerConstantArray)
-	{
-		if (getCellCount() > 1)
-			throw range_error("The cumulative length of faces count per cells cannot be constant if there is more than one cell in the grid");
-		cumulativeFaceCountPerCell[0] = static_cast<resqml2__IntegerConstantArray*>(grid->Geometry->FacesPerCell->CumulativeLength)->Value;
-	}
+	if (grid->Geometry->FacesPerCell->CumulativeLength->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerConstantArray && getCellCount() > 1)
+		throw range_error("The cumulative length of faces count per cells cannot be constant if there is more than one cell in the grid");
+	readJaggedArrayCumulativeLength(hdfProxy, grid->Geometry->FacesPerCell, getCellCount(), cumulativeFaceCountPerCell);
+}
+
+void UnstructuredGridRepresentation::getCumulativeFaceCountPerCell(unsigned int * cumulativeFaceCountPerCell) const
+{
+	_resqml2__UnstructuredGridRepresentation* grid = getSpecializedGsoapProxy();
+	if (grid->Geometry == nullptr)
+		throw invalid_argument("There is no geometry in this grid.");
+	if (grid->Geometry->FacesPerCell->CumulativeLength->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerConstantArray && getCellCount() > 1)
+		throw range_error("The cumulative length of faces count per cells cannot be constant if there is more than one cell in the grid");
+	if (getJaggedArrayElementCount(hdfProxy, grid->Geometry->FacesPerCell) > (numeric_limits<unsigned int>::max)())
+		throw range_error("The count of face indices of the cells does not fit in 32 bits.");
+	readJaggedArrayCumulativeLength(hdfProxy, grid->Geometry->FacesPerCell, getCellCount(), cumulativeFaceCountPerCell);
 }
 
 void UnstructuredGridRepresentation::getFaceCountPerCell(ULONG64 * faceCountPerCell) const
@@ -273,37 +557,39 @@ void UnstructuredGridRepresentation::getNodeIndicesOfFaces(ULONG64 * nodeIndices
 	_resqml2__UnstructuredGridRepresentation* grid = getSpecializedGsoapProxy();
 	if (grid->Geometry == nullptr)
 		throw invalid_argument("There is no geometry in this grid.");
-	if (grid->Geometry->NodesPerFace->Elements->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array)
-	{
-		hdfProxy->readArrayNdOfGSoapULong64Values(static_cast<resqml2__IntegerHdf5Array*>(grid->Geometry->NodesPerFace->Elements)->Values->PathInHdfFile, nodeIndices);
-	}
-	else
-		throw logic_error("Not yet implemented");
+	readJaggedArrayElements(hdfProxy, grid->Geometry->NodesPerFace, nodeIndices);
+}
+
+void UnstructuredGridRepresentation::getNodeIndicesOfFaces(unsigned int * nodeIndices) const
+{
+	_resqml2__UnstructuredGridRepresentation* grid = getSpecializedGsoapProxy();
+	if (grid->Geometry == nullptr)
+		throw invalid_argument("There is no geometry in this grid.");
+	if (getNodeCount() > (numeric_limits<unsigned int>::max)())
+		throw range_error("The node count of the grid does not fit in 32 bits.");
+	readJaggedArrayElements(hdfProxy, grid->Geometry->NodesPerFace, nodeIndices);
 }
 
 void UnstructuredGridRepresentation::getCumulativeNodeCountPerFace(ULONG64 * nodeCountPerFace) const
 {
 	_resqml2__UnstructuredGridRepresentation* grid = getSpecializedGsoapProxy();
-		if (grid->Geometry == nullptr)
-			throw invalid_argument("There is no geometry in this grid.");
-	if (grid->Geometry->NodesPerFace->CumulativeLength->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerHdf5Array)
-	{
-		hdfProxy->readArrayNdOfGSoapULong64Values(static_cast<resqml2__IntegerHdf5Array*>(grid->Geometry->NodesPerFace->CumulativeLength)->Values->PathInHdfFile, nodeCountPerFace);
-	}
-	else if (grid->Geometry->NodesPerFace->CumulativeLength->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerLatticeArray)
-	{
-		nodeCountPerFace[0] = static_cast<resqml2__IntegerLatticeArray*>(grid->Geometry->NodesPerFace->CumulativeLength)->StartValue;
-		const LONG64 offsetValue = static_cast<resqml2__IntegerLatticeArray*>(grid->Geometry->NodesPerFace->CumulativeLength)->Offset[0]->Value;
-		const ULONG64 faceCount = getFaceCount();
-		for (ULONG64 nodeCountPerFaceIndex = 1; nodeCountPerFaceIndex < faceCount; ++nodeCountPerFaceIndex)
-		{
-			nodeCountPerFace[nodeCountPerFaceIndex] = nodeCountPerFace[nodeCountPerFaceIndex - 1] + offsetValue;
-		}
-	}
-	else if (grid->Geometry->NodesPerFace->CumulativeLength->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerConstantArray)
-	{
+	if (grid->Geometry == nullptr)
+		throw invalid_argument("There is no geometry in this grid.");
+	if (grid->Geometry->NodesPerFace->CumulativeLength->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerConstantArray)
 		throw range_error("The *cumulative* length of nodes count per cells cannot be constant.");
-	}
+	readJaggedArrayCumulativeLength(hdfProxy, grid->Geometry->NodesPerFace, getFaceCount(), nodeCountPerFace);
+}
+
+void UnstructuredGridRepresentation::getCumulativeNodeCountPerFace(unsigned int * nodeCountPerFace) const
+{
+	_resqml2__UnstructuredGridRepresentation* grid = getSpecializedGsoapProxy();
+	if (grid->Geometry == nullptr)
+		throw invalid_argument("There is no geometry in this grid.");
+	if (grid->Geometry->NodesPerFace->CumulativeLength->soap_type() == SOAP_TYPE_gsoap_resqml2_0_1_resqml2__IntegerConstantArray)
+		throw range_error("The *cumulative* length of nodes count per cells cannot be constant.");
+	if (getJaggedArrayElementCount(hdfProxy, grid->Geometry->NodesPerFace) > (numeric_limits<unsigned int>::max)())
+		throw range_error("The count of node indices of the faces does not fit in 32 bits.");
+	readJaggedArrayCumulativeLength(hdfProxy, grid->Geometry->NodesPerFace, getFaceCount(), nodeCountPerFace);
 }
 
 void UnstructuredGridRepresentation::getNodeCountPerFace(ULONG64 * nodeCountPerFace) const
@@ -690,52 +976,193 @@ void UnstructuredGridRepresentation::setHexahedraOnlyGeometry(unsigned char * ce
 		nodeIndicesPerFace, 4);
 }
 
-void UnstructuredGridRepresentation::loadGeometry()
+unsigned long long UnstructuredGridRepresentation::GeometryInformation::getByteSize() const
 {
-	unloadGeometry();
+	const unsigned long long indexSize = indicesIn32Bits ? sizeof(unsigned int) : sizeof(ULONG64);
+	unsigned long long result = sizeof(GeometryInformation) + (nodeIndexCount + faceIndexCount) * indexSize;
+	if (cumulativeNodeCountPerFace.isAllocated()) result += faceCount * indexSize;
+	if (cumulativeFaceCountPerCell.isAllocated()) result += cellCount * indexSize;
+	return result;
+}
 
-	if (isNodeCountOfFacesConstant() == true)
-	{
-		constantNodeCountPerFace = getConstantNodeCountOfFaces();
-		nodeIndicesOfFaces = new ULONG64[constantNodeCountPerFace * getFaceCount()];
-	}
+unsigned int UnstructuredGridRepresentation::GeometryInformation::getFaceCountOfCell(const ULONG64 & cellIndex) const
+{
+	if (constantFaceCountPerCell != 0)
+		return constantFaceCountPerCell;
+	else if (cellIndex == 0)
+		return static_cast<unsigned int>(cumulativeFaceCountPerCell[0]);
 	else
-	{
-		cumulativeNodeCountPerFace = new ULONG64[getFaceCount()];
-		getCumulativeNodeCountPerFace(cumulativeNodeCountPerFace);
-		nodeIndicesOfFaces = new ULONG64[cumulativeNodeCountPerFace[getFaceCount() - 1]];
+		return static_cast<unsigned int>(cumulativeFaceCountPerCell[cellIndex] - cumulativeFaceCountPerCell[cellIndex-1]);
+}
+
+ULONG64 UnstructuredGridRepresentation::GeometryInformation::getGlobalFaceIndex(const ULONG64 & cellIndex, const unsigned int & localFaceIndex) const
+{
+	if (constantFaceCountPerCell != 0)
+		return faceIndicesOfCells[constantFaceCountPerCell * cellIndex + localFaceIndex];
+	else if (cellIndex == 0)
+		return faceIndicesOfCells[localFaceIndex];
+	else
+		return faceIndicesOfCells[cumulativeFaceCountPerCell[cellIndex-1] + localFaceIndex];
+}
+
+ULONG64 UnstructuredGridRepresentation::GeometryInformation::getFirstNodeIndexPosition(const ULONG64 & globalFaceIndex) const
+{
+	if (globalFaceIndex == 0)
+		return 0;
+	else if (constantNodeCountPerFace != 0)
+		return constantNodeCountPerFace * globalFaceIndex;
+	else
+		return cumulativeNodeCountPerFace[globalFaceIndex-1];
+}
+
+ULONG64 UnstructuredGridRepresentation::GeometryInformation::getFirstFaceIndexPosition(const ULONG64 & cellIndex) const
+{
+	if (cellIndex == 0)
+		return 0;
+	else if (constantFaceCountPerCell != 0)
+		return constantFaceCountPerCell * cellIndex;
+	else
+		return cumulativeFaceCountPerCell[cellIndex-1];
+}
+
+bool UnstructuredGridRepresentation::GeometryInformation::isFirstOccurrenceOfFaceInCell(const ULONG64 & faceIndexPosition, const ULONG64 & firstFaceIndexPositionOfCell) const
+{
+	const ULONG64 face = faceIndicesOfCells[faceIndexPosition];
+	for (ULONG64 i = firstFaceIndexPositionOfCell; i < faceIndexPosition; ++i) {
+		if (faceIndicesOfCells[i] == face) {
+			return false;
+		}
 	}
+	return true;
+}
 
-	if (isFaceCountOfCellsConstant() == true)
-	{
-		constantFaceCountPerCell = getConstantFaceCountOfCells();
-		faceIndicesOfCells = new ULONG64[constantFaceCountPerCell * getCellCount()];
+bool UnstructuredGridRepresentation::canIndexGeometryIn32Bits() const
+{
+	const ULONG64 maxValue = (numeric_limits<unsigned int>::max)();
+	if (getNodeCount() > maxValue || getFaceCount() > maxValue) {
+		return false;
 	}
-	else
-	{
-		cumulativeFaceCountPerCell = new ULONG64[getCellCount()];
-		getCumulativeFaceCountPerCell(cumulativeFaceCountPerCell);
-		faceIndicesOfCells = new ULONG64[cumulativeFaceCountPerCell[getCellCount() - 1]];
+
+	_resqml2__UnstructuredGridRepresentation* grid = getSpecializedGsoapProxy();
+	return getJaggedArrayElementCount(hdfProxy, grid->Geometry->NodesPerFace) <= maxValue &&
+		getJaggedArrayElementCount(hdfProxy, grid->Geometry->FacesPerCell) <= maxValue;
+}
+
+UnstructuredGridRepresentation::GeometryInformation* UnstructuredGridRepresentation::readGeometryInformation(const bool & in32Bits) const
+{
+	GeometryInformation* result = new GeometryInformation();
+	try {
+		result->indicesIn32Bits = in32Bits;
+		result->faceCount = getFaceCount();
+		result->cellCount = getCellCount();
+
+		if (isNodeCountOfFacesConstant() == true)
+		{
+			result->constantNodeCountPerFace = getConstantNodeCountOfFaces();
+			result->nodeIndexCount = result->constantNodeCountPerFace * result->faceCount;
+		}
+		else
+		{
+			result->cumulativeNodeCountPerFace.allocate(result->faceCount, in32Bits);
+			if (in32Bits) getCumulativeNodeCountPerFace(result->cumulativeNodeCountPerFace.values32);
+			else getCumulativeNodeCountPerFace(result->cumulativeNodeCountPerFace.values64);
+			result->nodeIndexCount = result->cumulativeNodeCountPerFace[result->faceCount - 1];
+		}
+		result->nodeIndicesOfFaces.allocate(result->nodeIndexCount, in32Bits);
+
+		if (isFaceCountOfCellsConstant() == true)
+		{
+			result->constantFaceCountPerCell = getConstantFaceCountOfCells();
+			result->faceIndexCount = result->constantFaceCountPerCell * result->cellCount;
+		}
+		else
+		{
+			result->cumulativeFaceCountPerCell.allocate(result->cellCount, in32Bits);
+			if (in32Bits) getCumulativeFaceCountPerCell(result->cumulativeFaceCountPerCell.values32);
+			else getCumulativeFaceCountPerCell(result->cumulativeFaceCountPerCell.values64);
+			result->faceIndexCount = result->cumulativeFaceCountPerCell[result->cellCount - 1];
+		}
+		result->faceIndicesOfCells.allocate(result->faceIndexCount, in32Bits);
+
+		if (in32Bits) {
+			getNodeIndicesOfFaces(result->nodeIndicesOfFaces.values32);
+			getFaceIndicesOfCells(result->faceIndicesOfCells.values32);
+		}
+		else {
+			getNodeIndicesOfFaces(result->nodeIndicesOfFaces.values64);
+			getFaceIndicesOfCells(result->faceIndicesOfCells.values64);
+		}
+	}
+	catch (...) {
+		delete result;
+		throw;
 	}
 
-	getNodeIndicesOfFaces(nodeIndicesOfFaces);
+	return result;
+}
 
-	getFaceIndicesOfCells(faceIndicesOfCells);
+void UnstructuredGridRepresentation::loadGeometry(const bool & allow32BitIndices)
+{
+	if (getEpcDocument() == nullptr)
+		throw invalid_argument("The unstructured grid must belong to an EPC document to load its geometry.");
+
+	const bool in32Bits = allow32BitIndices && canIndexGeometryIn32Bits();
+	GeometryInformation* geometry = readGeometryInformation(in32Bits);
+	COMMON_NS::GeometryCache* cache = getEpcDocument()->getGeometryCache();
+	cachedGeometryInformation = std::static_pointer_cast<GeometryInformation>(cache->put(this, COMMON_NS::GeometryCache::UNSTRUCTURED_GEOMETRY, geometry));
+	// The connectivity of a previously loaded geometry is obsolete
+	cache->release(this, COMMON_NS::GeometryCache::UNSTRUCTURED_CONNECTIVITY);
+	cachedConnectivityInformation.reset();
+	unpinGeometry();
+	geometryIndexedIn32Bits = in32Bits;
+	geometryLoaded = true;
 }
 
 void UnstructuredGridRepresentation::unloadGeometry()
 {
-	constantNodeCountPerFace = 0;
-	constantFaceCountPerCell = 0;
+	geometryLoaded = false;
+	geometryIndexedIn32Bits = false;
+	unpinGeometry();
+	cachedGeometryInformation.reset();
+	cachedConnectivityInformation.reset();
+	if (getEpcDocument() != nullptr) {
+		getEpcDocument()->getGeometryCache()->release(this, COMMON_NS::GeometryCache::UNSTRUCTURED_GEOMETRY);
+		getEpcDocument()->getGeometryCache()->release(this, COMMON_NS::GeometryCache::UNSTRUCTURED_CONNECTIVITY);
+	}
+}
+
+std::shared_ptr<const UnstructuredGridRepresentation::GeometryInformation> UnstructuredGridRepresentation::getGeometryInformation() const
+{
+	if (!geometryLoaded) {
+		return std::shared_ptr<const GeometryInformation>();
+	}
+
+	std::shared_ptr<GeometryInformation> geometry = cachedGeometryInformation.lock();
+	if (!geometry) {
+		// It has been evicted from the cache
+		COMMON_NS::GeometryCache* cache = getEpcDocument()->getGeometryCache();
+		geometry = std::static_pointer_cast<GeometryInformation>(cache->put(this, COMMON_NS::GeometryCache::UNSTRUCTURED_GEOMETRY, readGeometryInformation(geometryIndexedIn32Bits)));
+		cachedGeometryInformation = geometry;
+	}
+
+	return geometry;
+}
+
+void UnstructuredGridRepresentation::unpinGeometry()
+{
+	pinnedGeometryInformation.reset();
+	pinnedConnectivityInformation.reset();
+}
+
+const UnstructuredGridRepresentation::GeometryInformation* UnstructuredGridRepresentation::getPinnedGeometryInformation() const
+{
+	if (!pinnedGeometryInformation) {
+		pinnedGeometryInformation = getGeometryInformation();
+		if (!pinnedGeometryInformation)
+			throw invalid_argument("The geometry must have been loaded first.");
+	}
 
-  delete[] cumulativeNodeCountPerFace;
-  cumulativeNodeCountPerFace = nullptr;
-  delete[] cumulativeFaceCountPerCell;
-  cumulativeFaceCountPerCell = nullptr;
-  delete[] nodeIndicesOfFaces;
-  nodeIndicesOfFaces = nullptr;
-  delete[] faceIndicesOfCells;
-  faceIndicesOfCells = nullptr;
+	return pinnedGeometryInformation.get();
 }
 
 unsigned int UnstructuredGridRepresentation::getFaceCountOfCell(const ULONG64 & cellIndex) const
@@ -743,71 +1170,358 @@ unsigned int UnstructuredGridRepresentation::getFaceCountOfCell(const ULONG64 &
 	if (cellIndex >= getCellCount())
 		throw range_error("The cell index is out of range.");
 
-	if (constantFaceCountPerCell != 0)
-		return constantFaceCountPerCell;
-
-	if (faceIndicesOfCells == nullptr)
-		throw invalid_argument("The geometry must have been loaded first.");
+	const GeometryInformation* geometry = getPinnedGeometryInformation();
 
-	if (cellIndex == 0)
-		return cumulativeFaceCountPerCell[0];
-	
-	return cumulativeFaceCountPerCell[cellIndex] -  cumulativeFaceCountPerCell[cellIndex-1];
+	return geometry->getFaceCountOfCell(cellIndex);
 }
 
 unsigned int UnstructuredGridRepresentation::getNodeCountOfFaceOfCell(const ULONG64 & cellIndex, const unsigned int & localFaceIndex) const
 {
 	if (cellIndex >= getCellCount())
 		throw range_error("The cell index is out of range.");
-	if (localFaceIndex >= getFaceCountOfCell(cellIndex))
+
+	const GeometryInformation* geometry = getPinnedGeometryInformation();
+	if (localFaceIndex >= geometry->getFaceCountOfCell(cellIndex))
 		throw range_error("The face index is out of range.");
-	
-	if (constantNodeCountPerFace != 0)
-		return constantNodeCountPerFace;
 
-	if (faceIndicesOfCells == nullptr)
-		throw invalid_argument("The geometry must have been loaded first.");
+	if (geometry->constantNodeCountPerFace != 0)
+		return geometry->constantNodeCountPerFace;
 
 	// Global face index
-	ULONG64 globalFaceIndex = 0;
-	if (cellIndex == 0)
-		globalFaceIndex = faceIndicesOfCells[cumulativeFaceCountPerCell[0] + localFaceIndex];
-	else
-		globalFaceIndex = faceIndicesOfCells[cumulativeFaceCountPerCell[cellIndex-1] + localFaceIndex];
+	const ULONG64 globalFaceIndex = geometry->getGlobalFaceIndex(cellIndex, localFaceIndex);
 	
 	if (globalFaceIndex == 0)
-		return cumulativeNodeCountPerFace[0];
+		return geometry->cumulativeNodeCountPerFace[0];
 
-	return cumulativeNodeCountPerFace[globalFaceIndex] -  cumulativeNodeCountPerFace[globalFaceIndex-1];
+	return geometry->cumulativeNodeCountPerFace[globalFaceIndex] - geometry->cumulativeNodeCountPerFace[globalFaceIndex-1];
 }
 
 ULONG64 * UnstructuredGridRepresentation::getNodeIndicesOfFaceOfCell(const ULONG64 & cellIndex, const unsigned int & localFaceIndex) const
 {
-	if (faceIndicesOfCells == nullptr)
-		throw invalid_argument("The geometry must have been loaded first.");
 	if (cellIndex >= getCellCount())
 		throw range_error("The cell index is out of range.");
-	if (localFaceIndex >= getFaceCountOfCell(cellIndex))
+
+	const GeometryInformation* geometry = getPinnedGeometryInformation();
+	if (localFaceIndex >= geometry->getFaceCountOfCell(cellIndex))
 		throw range_error("The face index is out of range.");
 
-	// Global face index
-	ULONG64 globalFaceIndex = 0;
-	if (cellIndex == 0)
-		globalFaceIndex = faceIndicesOfCells[localFaceIndex];
-	else
-	{
-		if (constantFaceCountPerCell != 0)
-			globalFaceIndex = faceIndicesOfCells[constantFaceCountPerCell * cellIndex + localFaceIndex];
-		else
-			globalFaceIndex = faceIndicesOfCells[cumulativeFaceCountPerCell[cellIndex-1] + localFaceIndex];
+	if (geometry->indicesIn32Bits)
+		throw logic_error("The geometry has been loaded with 32 bits indices. Please use getUIntNodeIndicesOfFaceOfCell.");
+
+	return geometry->nodeIndicesOfFaces.values64 + geometry->getFirstNodeIndexPosition(geometry->getGlobalFaceIndex(cellIndex, localFaceIndex));
+}
+
+const unsigned int * UnstructuredGridRepresentation::getUIntNodeIndicesOfFaceOfCell(const ULONG64 & cellIndex, const unsigned int & localFaceIndex) const
+{
+	if (cellIndex >= getCellCount())
+		throw range_error("The cell index is out of range.");
+
+	const GeometryInformation* geometry = getPinnedGeometryInformation();
+	if (localFaceIndex >= geometry->getFaceCountOfCell(cellIndex))
+		throw range_error("The face index is out of range.");
+	if (!geometry->indicesIn32Bits)
+		throw logic_error("The geometry has not been loaded with 32 bits indices. Please use getNodeIndicesOfFaceOfCell.");
+
+	return geometry->nodeIndicesOfFaces.values32 + geometry->getFirstNodeIndexPosition(geometry->getGlobalFaceIndex(cellIndex, localFaceIndex));
+}
+
+
+unsigned long long UnstructuredGridRepresentation::ConnectivityInformation::getByteSize() const
+{
+	return sizeof(ConnectivityInformation) + (faceCount + 1 + cellOffsetsOfFaces[faceCount] + cellCount + 1 + 2 * neighborOffsetsOfCells[cellCount]) * sizeof(ULONG64);
+}
+
+UnstructuredGridRepresentation::ConnectivityInformation* UnstructuredGridRepresentation::buildConnectivityInformation(const GeometryInformation* geometry) const
+{
+	ConnectivityInformation* result = new ConnectivityInformation();
+	try {
+		const ULONG64 faceCount = geometry->faceCount;
+		const ULONG64 cellCount = geometry->cellCount;
+		result->faceCount = faceCount;
+		result->cellCount = cellCount;
+
+		// Face to cells : each thread counts the cells of each face in its own histogram over a contiguous range of cells.
+		// A prefix sum over the faces and then over the threads gives where each thread scatters its cells in the face buckets.
+		// Ranges of cells are scattered in increasing order which keeps each bucket sorted.
+		const unsigned int chunkCount = parallel::getChunkCount(cellCount, 65536);
+		std::vector< std::vector<unsigned int> > cellCountOfFacePerChunk(chunkCount, std::vector<unsigned int>(faceCount, 0));
+		parallel::forEachChunk(cellCount, chunkCount, [&](const unsigned int & chunkIndex, const uint64_t & firstCell, const uint64_t & endCell) {
+			std::vector<unsigned int> & cellCountOfFace = cellCountOfFacePerChunk[chunkIndex];
+			for (ULONG64 cell = firstCell; cell < endCell; ++cell) {
+				const ULONG64 firstFaceIndex = geometry->getFirstFaceIndexPosition(cell);
+				const ULONG64 end = geometry->getFirstFaceIndexPosition(cell + 1);
+				for (ULONG64 faceIndexOfCell = firstFaceIndex; faceIndexOfCell < end; ++faceIndexOfCell) {
+					const ULONG64 face = geometry->faceIndicesOfCells[faceIndexOfCell];
+					if (face >= faceCount) {
+						throw range_error("A face index of a cell is out of range.");
+					}
+					if (geometry->isFirstOccurrenceOfFaceInCell(faceIndexOfCell, firstFaceIndex)) {
+						++cellCountOfFace[face];
+					}
+				}
+			}
+		});
+
+		// Each histogram becomes the offset of its thread inside each face bucket
+		result->cellOffsetsOfFaces = new ULONG64[faceCount + 1];
+		result->cellOffsetsOfFaces[0] = 0;
+		parallel::forEachRange(faceCount, 65536, [&](const unsigned int &, const uint64_t & firstFace, const uint64_t & endFace) {
+			for (ULONG64 face = firstFace; face < endFace; ++face) {
+				unsigned int cellCountOfFace = 0;
+				for (unsigned int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex) {
+					const unsigned int chunkCellCount = cellCountOfFacePerChunk[chunkIndex][face];
+					cellCountOfFacePerChunk[chunkIndex][face] = cellCountOfFace;
+					cellCountOfFace += chunkCellCount;
+				}
+				result->cellOffsetsOfFaces[face + 1] = cellCountOfFace;
+			}
+		});
+		for (ULONG64 face = 0; face < faceCount; ++face) {
+			result->cellOffsetsOfFaces[face + 1] += result->cellOffsetsOfFaces[face];
+		}
+
+		result->cellIndicesOfFaces = new ULONG64[result->cellOffsetsOfFaces[faceCount]];
+		parallel::forEachChunk(cellCount, chunkCount, [&](const unsigned int & chunkIndex, const uint64_t & firstCell, const uint64_t & endCell) {
+			std::vector<unsigned int> & next = cellCountOfFacePerChunk[chunkIndex];
+			for (ULONG64 cell = firstCell; cell < endCell; ++cell) {
+				const ULONG64 firstFaceIndex = geometry->getFirstFaceIndexPosition(cell);
+				const ULONG64 end = geometry->getFirstFaceIndexPosition(cell + 1);
+				for (ULONG64 faceIndexOfCell = firstFaceIndex; faceIndexOfCell < end; ++faceIndexOfCell) {
+					if (geometry->isFirstOccurrenceOfFaceInCell(faceIndexOfCell, firstFaceIndex)) {
+						const ULONG64 face = geometry->faceIndicesOfCells[faceIndexOfCell];
+						result->cellIndicesOfFaces[result->cellOffsetsOfFaces[face] + next[face]++] = cell;
+					}
+				}
+			}
+		});
+		cellCountOfFacePerChunk.clear();
+
+		// Cell to neighbors : each distinct face of a cell gives the other cells of this face.
+		// Each cell counts and then fills in its own neighbors : the cells are shared between threads.
+		result->neighborOffsetsOfCells = new ULONG64[cellCount + 1];
+		result->neighborOffsetsOfCells[0] = 0;
+		parallel::forEachChunk(cellCount, chunkCount, [&](const unsigned int &, const uint64_t & firstCell, const uint64_t & endCell) {
+			for (ULONG64 cell = firstCell; cell < endCell; ++cell) {
+				const ULONG64 firstFaceIndex = geometry->getFirstFaceIndexPosition(cell);
+				const ULONG64 end = geometry->getFirstFaceIndexPosition(cell + 1);
+				ULONG64 neighborCount = 0;
+				for (ULONG64 faceIndexOfCell = firstFaceIndex; faceIndexOfCell < end; ++faceIndexOfCell) {
+					if (geometry->isFirstOccurrenceOfFaceInCell(faceIndexOfCell, firstFaceIndex)) {
+						const ULONG64 face = geometry->faceIndicesOfCells[faceIndexOfCell];
+						neighborCount += result->cellOffsetsOfFaces[face + 1] - result->cellOffsetsOfFaces[face] - 1;
+					}
+				}
+				result->neighborOffsetsOfCells[cell + 1] = neighborCount;
+			}
+		});
+		for (ULONG64 cell = 0; cell < cellCount; ++cell) {
+			result->neighborOffsetsOfCells[cell + 1] += result->neighborOffsetsOfCells[cell];
+		}
+
+		const ULONG64 adjacencyCount = result->neighborOffsetsOfCells[cellCount];
+		result->neighborCellIndices = new ULONG64[adjacencyCount];
+		result->neighborFaceIndices = new ULONG64[adjacencyCount];
+		parallel::forEachChunk(cellCount, chunkCount, [&](const unsigned int &, const uint64_t & firstCell, const uint64_t & endCell) {
+			for (ULONG64 cell = firstCell; cell < endCell; ++cell) {
+				ULONG64 neighborIndex = result->neighborOffsetsOfCells[cell];
+				const ULONG64 firstFaceIndex = geometry->getFirstFaceIndexPosition(cell);
+				const ULONG64 end = geometry->getFirstFaceIndexPosition(cell + 1);
+				for (ULONG64 faceIndexOfCell = firstFaceIndex; faceIndexOfCell < end; ++faceIndexOfCell) {
+					if (!geometry->isFirstOccurrenceOfFaceInCell(faceIndexOfCell, firstFaceIndex)) {
+						continue;
+					}
+					const ULONG64 face = geometry->faceIndicesOfCells[faceIndexOfCell];
+					for (ULONG64 i = result->cellOffsetsOfFaces[face]; i < result->cellOffsetsOfFaces[face + 1]; ++i) {
+						if (result->cellIndicesOfFaces[i] != cell) {
+							result->neighborCellIndices[neighborIndex] = result->cellIndicesOfFaces[i];
+							result->neighborFaceIndices[neighborIndex] = face;
+							++neighborIndex;
+						}
+					}
+				}
+			}
+		});
+	}
+	catch (...) {
+		delete result;
+		throw;
 	}
 
-	if (globalFaceIndex == 0)
-		return nodeIndicesOfFaces;
+	return result;
+}
 
-	if (constantNodeCountPerFace != 0)
-		return &(nodeIndicesOfFaces[constantNodeCountPerFace * globalFaceIndex]);
-	else
-		return &(nodeIndicesOfFaces[cumulativeNodeCountPerFace[globalFaceIndex-1]]);
+std::shared_ptr<const UnstructuredGridRepresentation::ConnectivityInformation> UnstructuredGridRepresentation::getConnectivityInformation() const
+{
+	if (!geometryLoaded) {
+		return std::shared_ptr<const ConnectivityInformation>();
+	}
+
+	std::shared_ptr<ConnectivityInformation> connectivity = cachedConnectivityInformation.lock();
+	if (!connectivity) {
+		const std::shared_ptr<const GeometryInformation> geometry = getGeometryInformation();
+		COMMON_NS::GeometryCache* cache = getEpcDocument()->getGeometryCache();
+		connectivity = std::static_pointer_cast<ConnectivityInformation>(cache->put(this, COMMON_NS::GeometryCache::UNSTRUCTURED_CONNECTIVITY, buildConnectivityInformation(geometry.get())));
+		cachedConnectivityInformation = connectivity;
+	}
+
+	return connectivity;
+}
+
+const UnstructuredGridRepresentation::ConnectivityInformation* UnstructuredGridRepresentation::getPinnedConnectivityInformation() const
+{
+	if (!pinnedConnectivityInformation) {
+		pinnedConnectivityInformation = getConnectivityInformation();
+		if (!pinnedConnectivityInformation)
+			throw invalid_argument("The geometry must have been loaded first.");
+	}
+
+	return pinnedConnectivityInformation.get();
+}
+
+unsigned int UnstructuredGridRepresentation::getCellCountOfFace(const ULONG64 & faceIndex) const
+{
+	const ConnectivityInformation* connectivity = getPinnedConnectivityInformation();
+	if (faceIndex >= connectivity->faceCount)
+		throw range_error("The face index is out of range.");
+
+	return static_cast<unsigned int>(connectivity->cellOffsetsOfFaces[faceIndex + 1] - connectivity->cellOffsetsOfFaces[faceIndex]);
+}
+
+const ULONG64 * UnstructuredGridRepresentation::getCellIndicesOfFace(const ULONG64 & faceIndex) const
+{
+	const ConnectivityInformation* connectivity = getPinnedConnectivityInformation();
+	if (faceIndex >= connectivity->faceCount)
+		throw range_error("The face index is out of range.");
+
+	return connectivity->cellIndicesOfFaces + connectivity->cellOffsetsOfFaces[faceIndex];
+}
+
+void UnstructuredGridRepresentation::getCellIndicesOfFaces(ULONG64 * cumulativeCellCountPerFace, ULONG64 * cellIndicesOfFaces) const
+{
+	const std::shared_ptr<const ConnectivityInformation> connectivity = getConnectivityInformation();
+	if (!connectivity)
+		throw invalid_argument("The geometry must have been loaded first.");
+
+	std::copy(connectivity->cellOffsetsOfFaces + 1, connectivity->cellOffsetsOfFaces + connectivity->faceCount + 1, cumulativeCellCountPerFace);
+	std::copy(connectivity->cellIndicesOfFaces, connectivity->cellIndicesOfFaces + connectivity->cellOffsetsOfFaces[connectivity->faceCount], cellIndicesOfFaces);
+}
+
+unsigned int UnstructuredGridRepresentation::getNeighborCountOfCell(const ULONG64 & cellIndex) const
+{
+	const ConnectivityInformation* connectivity = getPinnedConnectivityInformation();
+	if (cellIndex >= connectivity->cellCount)
+		throw range_error("The cell index is out of range.");
+
+	return static_cast<unsigned int>(connectivity->neighborOffsetsOfCells[cellIndex + 1] - connectivity->neighborOffsetsOfCells[cellIndex]);
+}
+
+const ULONG64 * UnstructuredGridRepresentation::getNeighborCellIndicesOfCell(const ULONG64 & cellIndex) const
+{
+	const ConnectivityInformation* connectivity = getPinnedConnectivityInformation();
+	if (cellIndex >= connectivity->cellCount)
+		throw range_error("The cell index is out of range.");
+
+	return connectivity->neighborCellIndices + connectivity->neighborOffsetsOfCells[cellIndex];
+}
+
+const ULONG64 * UnstructuredGridRepresentation::getNeighborFaceIndicesOfCell(const ULONG64 & cellIndex) const
+{
+	const ConnectivityInformation* connectivity = getPinnedConnectivityInformation();
+	if (cellIndex >= connectivity->cellCount)
+		throw range_error("The cell index is out of range.");
+
+	return connectivity->neighborFaceIndices + connectivity->neighborOffsetsOfCells[cellIndex];
+}
+
+ULONG64 UnstructuredGridRepresentation::getCellAdjacencyCount() const
+{
+	const std::shared_ptr<const ConnectivityInformation> connectivity = getConnectivityInformation();
+	if (!connectivity)
+		throw invalid_argument("The geometry must have been loaded first.");
+
+	return connectivity->neighborOffsetsOfCells[connectivity->cellCount];
 }
 
+void UnstructuredGridRepresentation::getCellAdjacency(ULONG64 * cumulativeNeighborCountPerCell, ULONG64 * neighborCellIndices, ULONG64 * neighborFaceIndices) const
+{
+	const std::shared_ptr<const ConnectivityInformation> connectivity = getConnectivityInformation();
+	if (!connectivity)
+		throw invalid_argument("The geometry must have been loaded first.");
+
+	const ULONG64 adjacencyCount = connectivity->neighborOffsetsOfCells[connectivity->cellCount];
+	std::copy(connectivity->neighborOffsetsOfCells + 1, connectivity->neighborOffsetsOfCells + connectivity->cellCount + 1, cumulativeNeighborCountPerCell);
+	std::copy(connectivity->neighborCellIndices, connectivity->neighborCellIndices + adjacencyCount, neighborCellIndices);
+	if (neighborFaceIndices != nullptr) {
+		std::copy(connectivity->neighborFaceIndices, connectivity->neighborFaceIndices + adjacencyCount, neighborFaceIndices);
+	}
+}
+
+void UnstructuredGridRepresentation::computeFaceGeometry(double * faceAreas, double * faceNormals, double * faceCentroids) const
+{
+	const std::shared_ptr<const GeometryInformation> geometry = getGeometryInformation();
+	if (!geometry)
+		throw invalid_argument("The geometry must have been loaded first.");
+
+	std::vector<double> xyz(getXyzPointCountOfPatch(0) * 3);
+	getXyzPointsOfPatch(0, &xyz[0]);
+
+	std::vector<double> areaVectors;
+	if (faceAreas != nullptr || faceNormals != nullptr) {
+		areaVectors.resize(geometry->faceCount * 3);
+	}
+	double* areaVectorBuffer = areaVectors.empty() ? nullptr : &areaVectors[0];
+	if (geometry->indicesIn32Bits) {
+		computeFaceGeometryOfTopology(geometry->nodeIndicesOfFaces.values32, geometry->cumulativeNodeCountPerFace.values32, geometry->constantNodeCountPerFace,
+			geometry->faceCount, &xyz[0], nullptr, areaVectorBuffer, faceCentroids);
+	}
+	else {
+		computeFaceGeometryOfTopology(geometry->nodeIndicesOfFaces.values64, geometry->cumulativeNodeCountPerFace.values64, geometry->constantNodeCountPerFace,
+			geometry->faceCount, &xyz[0], nullptr, areaVectorBuffer, faceCentroids);
+	}
+
+	if (areaVectorBuffer == nullptr) {
+		return;
+	}
+	parallel::forEachRange(geometry->faceCount, 65536, [&](const unsigned int &, const uint64_t & firstFace, const uint64_t & endFace) {
+		for (ULONG64 face = firstFace; face < endFace; ++face) {
+			const double* areaVector = areaVectorBuffer + 3 * face;
+			const double area = sqrt(areaVector[0] * areaVector[0] + areaVector[1] * areaVector[1] + areaVector[2] * areaVector[2]);
+			if (faceAreas != nullptr) {
+				faceAreas[face] = area;
+			}
+			if (faceNormals != nullptr) {
+				for (unsigned int dim = 0; dim < 3; ++dim) {
+					faceNormals[3 * face + dim] = area > 0 ? areaVector[dim] / area : 0;
+				}
+			}
+		}
+	});
+}
+
+void UnstructuredGridRepresentation::computeCellGeometry(double * cellVolumes, double * cellCentroids) const
+{
+	const std::shared_ptr<const GeometryInformation> geometry = getGeometryInformation();
+	if (!geometry)
+		throw invalid_argument("The geometry must have been loaded first.");
+
+	std::vector<double> xyz(getXyzPointCountOfPatch(0) * 3);
+	getXyzPointsOfPatch(0, &xyz[0]);
+	std::vector<unsigned char> cellFaceIsRightHanded(geometry->faceIndexCount);
+	getCellFaceIsRightHanded(&cellFaceIsRightHanded[0]);
+
+	std::vector<double> faceCenters(geometry->faceCount * 3);
+	if (geometry->indicesIn32Bits) {
+		computeFaceGeometryOfTopology(geometry->nodeIndicesOfFaces.values32, geometry->cumulativeNodeCountPerFace.values32, geometry->constantNodeCountPerFace,
+			geometry->faceCount, &xyz[0], &faceCenters[0], nullptr, nullptr);
+		computeCellGeometryOfTopology(geometry->nodeIndicesOfFaces.values32, geometry->cumulativeNodeCountPerFace.values32, geometry->constantNodeCountPerFace,
+			geometry->faceIndicesOfCells.values32, geometry->cumulativeFaceCountPerCell.values32, geometry->constantFaceCountPerCell,
+			geometry->cellCount, &xyz[0], &faceCenters[0], &cellFaceIsRightHanded[0], cellVolumes, cellCentroids);
+	}
+	else {
+		computeFaceGeometryOfTopology(geometry->nodeIndicesOfFaces.values64, geometry->cumulativeNodeCountPerFace.values64, geometry->constantNodeCountPerFace,
+			geometry->faceCount, &xyz[0], &faceCenters[0], nullptr, nullptr);
+		computeCellGeometryOfTopology(geometry->nodeIndicesOfFaces.values64, geometry->cumulativeNodeCountPerFace.values64, geometry->constantNodeCountPerFace,
+			geometry->faceIndicesOfCells.values64, geometry->cumulativeFaceCountPerCell.values64, geometry->constantFaceCountPerCell,
+			geometry->cellCount, &xyz[0], &faceCenters[0], &cellFaceIsRightHanded[0], cellVolumes, cellCentroids);
+	}
+}
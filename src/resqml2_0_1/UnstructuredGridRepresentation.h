@@ -21,6 +21,8 @@ under the License.
 
 #include "resqml2/AbstractGridRepresentation.h"
 
+#include "common/GeometryCache.h"
+
 namespace RESQML2_0_1_NS
 {
 	class DLL_IMPORT_OR_EXPORT UnstructuredGridRepresentation : public RESQML2_NS::AbstractGridRepresentation
@@ -72,12 +74,192 @@ namespace RESQML2_0_1_NS
 			ULONG64 * faceIndicesPerCell, ULONG64 faceCountPerCell,
 			ULONG64 * nodeIndicesPerFace, ULONG64 nodeCountPerFace);
 
-		unsigned int constantNodeCountPerFace;
-		unsigned int constantFaceCountPerCell;
-		ULONG64 * cumulativeNodeCountPerFace;
-		ULONG64 * cumulativeFaceCountPerCell;
-		ULONG64 * nodeIndicesOfFaces;
-		ULONG64 * faceIndicesOfCells;
+		/**
+		* An index (or cumulative count) array of the loaded topology which is stored either with 32 bits or with 64 bits unsigned integers.
+		* Only one of the two buffers is allocated.
+		*/
+		class IndexArray
+		{
+		public:
+			ULONG64 * values64;
+			unsigned int * values32;
+
+			IndexArray() : values64(nullptr), values32(nullptr) {}
+			~IndexArray() {
+				delete[] values64;
+				delete[] values32;
+			}
+
+			void allocate(const ULONG64 & count, const bool & in32Bits) {
+				if (in32Bits) values32 = new unsigned int[count];
+				else values64 = new ULONG64[count];
+			}
+
+			bool isAllocated() const { return values64 != nullptr || values32 != nullptr; }
+
+			ULONG64 operator[](const ULONG64 & index) const { return values32 != nullptr ? values32[index] : values64[index]; }
+
+		private:
+			IndexArray(const IndexArray &);
+			IndexArray& operator=(const IndexArray &);
+		};
+
+		/**
+		* The loaded topology of the grid, owned by the geometry cache of the EPC document.
+		*/
+		class GeometryInformation : public COMMON_NS::GeometryCache::Entry
+		{
+		public:
+			unsigned int constantNodeCountPerFace;
+			unsigned int constantFaceCountPerCell;
+			bool indicesIn32Bits;
+			IndexArray cumulativeNodeCountPerFace;
+			IndexArray cumulativeFaceCountPerCell;
+			IndexArray nodeIndicesOfFaces;
+			IndexArray faceIndicesOfCells;
+			ULONG64 nodeIndexCount;
+			ULONG64 faceIndexCount;
+			ULONG64 faceCount;
+			ULONG64 cellCount;
+
+			GeometryInformation() : constantNodeCountPerFace(0), constantFaceCountPerCell(0), indicesIn32Bits(false),
+				nodeIndexCount(0), faceIndexCount(0), faceCount(0), cellCount(0) {}
+
+			unsigned long long getByteSize() const;
+
+			/**
+			* Get the count of faces of a cell.
+			*/
+			unsigned int getFaceCountOfCell(const ULONG64 & cellIndex) const;
+
+			/**
+			* Get the global index of a face of a cell.
+			*/
+			ULONG64 getGlobalFaceIndex(const ULONG64 & cellIndex, const unsigned int & localFaceIndex) const;
+
+			/**
+			* Get the position of the first node index of a face in nodeIndicesOfFaces.
+			*/
+			ULONG64 getFirstNodeIndexPosition(const ULONG64 & globalFaceIndex) const;
+
+			/**
+			* Get the position of the first face index of a cell in faceIndicesOfCells. The position of the first face index of the cell following the last one is the count of face indices.
+			*/
+			ULONG64 getFirstFaceIndexPosition(const ULONG64 & cellIndex) const;
+
+			/**
+			* Check if a face index of a cell is the first occurrence of this face in the face list of the cell, knowing that a cell may list the same face several times.
+			* @param faceIndexPosition				The position of the face index in faceIndicesOfCells.
+			* @param firstFaceIndexPositionOfCell	The position of the first face index of the cell in faceIndicesOfCells.
+			*/
+			bool isFirstOccurrenceOfFaceInCell(const ULONG64 & faceIndexPosition, const ULONG64 & firstFaceIndexPositionOfCell) const;
+		};
+
+		/**
+		* Check if all the topology arrays of the grid (indices and cumulative counts) can be stored with 32 bits unsigned integers.
+		*/
+		bool canIndexGeometryIn32Bits() const;
+
+		/**
+		* Read the topology of the grid from the HDF5 datasets.
+		* @param in32Bits	Indicates if the indices and cumulative counts must be stored with 32 bits unsigned integers. They are directly read with this width from the HDF5 datasets whatever their stored width.
+		*/
+		GeometryInformation* readGeometryInformation(const bool & in32Bits) const;
+
+		/**
+		* Get the loaded topology of the grid from the geometry cache of the EPC document.
+		* It is transparently reloaded if it has been evicted from the cache since it has been loaded.
+		* The cache is only looked up when the topology has been evicted : a weak pointer to it is kept meanwhile.
+		* The returned pointer pins the topology : keep it while using its content.
+		* @return An empty pointer if the geometry has not been loaded.
+		*/
+		std::shared_ptr<const GeometryInformation> getGeometryInformation() const;
+
+		/**
+		* The topology of the geometry cache, which expires when it is evicted from the cache.
+		*/
+		mutable std::weak_ptr<GeometryInformation> cachedGeometryInformation;
+
+		/**
+		* Get the loaded topology of the grid and pin it until unpinGeometry or unloadGeometry is called.
+		* Once pinned, the topology is accessed without any cache lookup nor shared pointer copy.
+		* It throws an invalid_argument if the geometry has not been loaded.
+		*/
+		const GeometryInformation* getPinnedGeometryInformation() const;
+
+		/**
+		* The topology which is pinned by the accessors returning pointers into it. It stays alive even if the cache evicts it.
+		*/
+		mutable std::shared_ptr<const GeometryInformation> pinnedGeometryInformation;
+
+		/**
+		* The face to cell inverse map and the cell adjacency graph of the grid, owned by the geometry cache of the EPC document.
+		* Both are stored as compressed sparse rows : the items of row r are in [offsets[r], offsets[r+1]).
+		*/
+		class ConnectivityInformation : public COMMON_NS::GeometryCache::Entry
+		{
+		public:
+			ULONG64 * cellOffsetsOfFaces;		// faceCount + 1 values
+			ULONG64 * cellIndicesOfFaces;		// ordered by increasing cell index inside each face
+			ULONG64 * neighborOffsetsOfCells;	// cellCount + 1 values
+			ULONG64 * neighborCellIndices;
+			ULONG64 * neighborFaceIndices;		// the face shared with each neighbor cell
+			ULONG64 faceCount;
+			ULONG64 cellCount;
+
+			ConnectivityInformation() : cellOffsetsOfFaces(nullptr), cellIndicesOfFaces(nullptr),
+				neighborOffsetsOfCells(nullptr), neighborCellIndices(nullptr), neighborFaceIndices(nullptr),
+				faceCount(0), cellCount(0) {}
+
+			~ConnectivityInformation() {
+				delete[] cellOffsetsOfFaces;
+				delete[] cellIndicesOfFaces;
+				delete[] neighborOffsetsOfCells;
+				delete[] neighborCellIndices;
+				delete[] neighborFaceIndices;
+			}
+
+			unsigned long long getByteSize() const;
+		};
+
+		/**
+		* Build the face to cell inverse map and the cell adjacency graph from the loaded topology of the grid.
+		* Both are built by bucketing (counting sort) in linear time. The cells are shared between threads which count them in their own histogram of the faces.
+		*/
+		ConnectivityInformation* buildConnectivityInformation(const GeometryInformation* geometry) const;
+
+		/**
+		* Get the face to cell inverse map and the cell adjacency graph from the geometry cache of the EPC document.
+		* They are transparently built if they are not in the cache yet.
+		* The returned pointer pins them : keep it while using its content.
+		* @return An empty pointer if the geometry has not been loaded.
+		*/
+		std::shared_ptr<const ConnectivityInformation> getConnectivityInformation() const;
+
+		/**
+		* The face to cell inverse map and the cell adjacency graph of the geometry cache, which expire when they are evicted from the cache.
+		*/
+		mutable std::weak_ptr<ConnectivityInformation> cachedConnectivityInformation;
+
+		/**
+		* Same as getPinnedGeometryInformation for the face to cell inverse map and the cell adjacency graph.
+		*/
+		const ConnectivityInformation* getPinnedConnectivityInformation() const;
+
+		/**
+		* The connectivity which is pinned by the accessors returning pointers into it.
+		*/
+		mutable std::shared_ptr<const ConnectivityInformation> pinnedConnectivityInformation;
+
+		/**
+		* Indicates if the geometry has been loaded (and not unloaded) by the user.
+		*/
+		bool geometryLoaded;
+
+		/**
+		* Indicates if the geometry has been loaded with 32 bits indices.
+		*/
+		bool geometryIndexedIn32Bits;
 
 	public:
 
@@ -85,9 +267,7 @@ namespace RESQML2_0_1_NS
 		* Only to be used in partial transfer context
 		*/
 		UnstructuredGridRepresentation(gsoap_resqml2_0_1::eml20__DataObjectReference* partialObject):
-			RESQML2_NS::AbstractGridRepresentation(partialObject, false), constantNodeCountPerFace(0), constantFaceCountPerCell(0),
-			cumulativeNodeCountPerFace(nullptr), cumulativeFaceCountPerCell(nullptr),
-			nodeIndicesOfFaces(nullptr), faceIndicesOfCells(nullptr)
+			RESQML2_NS::AbstractGridRepresentation(partialObject, false), geometryLoaded(false), geometryIndexedIn32Bits(false)
 		{
 		}
 
@@ -106,14 +286,16 @@ namespace RESQML2_0_1_NS
 		* Creates an instance of this class by wrapping a gsoap instance.
 		*/
 		UnstructuredGridRepresentation(gsoap_resqml2_0_1::_resqml2__UnstructuredGridRepresentation* fromGsoap):
-			RESQML2_NS::AbstractGridRepresentation(fromGsoap, false), constantNodeCountPerFace(0), constantFaceCountPerCell(0),
-			cumulativeNodeCountPerFace(nullptr), cumulativeFaceCountPerCell(nullptr),
-			nodeIndicesOfFaces(nullptr), faceIndicesOfCells(nullptr) {}
+			RESQML2_NS::AbstractGridRepresentation(fromGsoap, false), geometryLoaded(false), geometryIndexedIn32Bits(false) {}
 
 		/**
-		* Destructor does nothing since the memory is managed by the gsoap context.
+		* Destructor only releases the cached geometry since the memory is managed by the gsoap context.
 		*/
-		virtual ~UnstructuredGridRepresentation() {}
+		virtual ~UnstructuredGridRepresentation()
+		{
+			if (getEpcDocument() != nullptr)
+				getEpcDocument()->getGeometryCache()->releaseAll(this);
+		}
 
 		/**
 		* Indicates wether the grid has a geometry or not.
@@ -140,6 +322,12 @@ namespace RESQML2_0_1_NS
 		 */
 		void getFaceIndicesOfCells(ULONG64 * faceIndices) const;
 
+		/**
+		* Same as getFaceIndicesOfCells but with 32 bits indices which are directly read with this width from the HDF5 dataset.
+		* It throws a range_error if the face count of the grid does not fit in 32 bits.
+		*/
+		void getFaceIndicesOfCells(unsigned int * faceIndices) const;
+
 		/**
 		* Get the cumulative face count per cell. First value is the count of faces in the first cell.
 		* Second value is the count of faces in the first and in the second cell. Third value is the count of faces in the first and in the second and in the third cell. Etc...
@@ -149,6 +337,12 @@ namespace RESQML2_0_1_NS
 		*/
 		void getCumulativeFaceCountPerCell(ULONG64 * cumulativeFaceCountPerCell) const;
 
+		/**
+		* Same as getCumulativeFaceCountPerCell but with 32 bits counts which are directly read with this width from the HDF5 dataset.
+		* It throws a range_error if the count of face indices of the cells does not fit in 32 bits.
+		*/
+		void getCumulativeFaceCountPerCell(unsigned int * cumulativeFaceCountPerCell) const;
+
 		/**
 		* Less efficient than getCumulativeFaceCountOfCells.
 		* Get the face count per cell. First value is the count of faces in the first cell.
@@ -173,6 +367,12 @@ namespace RESQML2_0_1_NS
 		 */
 		void getNodeIndicesOfFaces(ULONG64 * nodeIndices) const;
 
+		/**
+		* Same as getNodeIndicesOfFaces but with 32 bits indices which are directly read with this width from the HDF5 dataset.
+		* It throws a range_error if the node count of the grid does not fit in 32 bits.
+		*/
+		void getNodeIndicesOfFaces(unsigned int * nodeIndices) const;
+
 		/**
 		* Get the cumulative node count per face. First value is the count of nodes in the first face.
 		* Second value is the count of nodes in the first and in the second face. Third value is the count of nodes in the first and in the second and in the third face. Etc...
@@ -182,6 +382,12 @@ namespace RESQML2_0_1_NS
 		*/
 		void getCumulativeNodeCountPerFace(ULONG64 * nodeCountPerFace) const;
 
+		/**
+		* Same as getCumulativeNodeCountPerFace but with 32 bits counts which are directly read with this width from the HDF5 dataset.
+		* It throws a range_error if the count of node indices of the faces does not fit in 32 bits.
+		*/
+		void getCumulativeNodeCountPerFace(unsigned int * nodeCountPerFace) const;
+
 		/**
 		* Less efficient than getCumulativeNodeCountPerFace.
 		* Get the node count per face. First value is the count of nodes in the first face.
@@ -202,15 +408,32 @@ namespace RESQML2_0_1_NS
 
 		/**
 		* Load the geoemtry into memory in order to ease access.
-		* Be aware that you must unload by yourself this memory.
+		* This memory is owned by the geometry cache of the EPC document : it is transparently reloaded if the cache evicts it because of its memory budget.
+		* Be aware that you must unload it by yourself when you no longer need it.
+		* @param allow32BitIndices	If true, the node indices of the faces, the face indices of the cells and their cumulative counts are stored with 32 bits unsigned integers
+		*							as soon as all the counts of the grid allow it. It halves the memory and the bandwidth of the topology.
+		*							In such a case, the node indices of a face must be accessed by means of getUIntNodeIndicesOfFaceOfCell.
 		*/
-		void loadGeometry();
+		void loadGeometry(const bool & allow32BitIndices = false);
 
 		/**
-		* Unload the split information from memory.
+		* Indicates if the geometry has been loaded with 32 bits indices (see loadGeometry).
+		*/
+		bool isGeometryIndexedIn32Bits() const { return geometryLoaded && geometryIndexedIn32Bits; }
+
+		/**
+		* Unload the geometry from memory.
 		*/
 		void unloadGeometry();
 
+		/**
+		* The per cell and per face accessors pin the loaded topology (and the face to cell and cell adjacency maps) : they stay in memory even if the geometry cache evicts them,
+		* which keeps valid the pointers returned by these accessors.
+		* Unpin them in order to let the geometry cache free them. The pointers previously returned by these accessors must no more be used then.
+		* They are transparently reloaded and pinned again by the next access.
+		*/
+		void unpinGeometry();
+
 		/**
 		* This method requires your have already loaded the geometry.
 		* @return The count of faces in a particular cell.
@@ -226,9 +449,96 @@ namespace RESQML2_0_1_NS
 		/**
 		* This method requires your have already loaded the geometry.
 		* It gets all the node indices of a particular face of a particular cell
+		* The returned pointer remains valid until unpinGeometry or unloadGeometry is called.
+		* It throws a logic_error if the geometry has been loaded with 32 bits indices.
 		*/
 		ULONG64 * getNodeIndicesOfFaceOfCell(const ULONG64 & cellIndex, const unsigned int & localFaceIndex) const;
 
+		/**
+		* This method requires your have already loaded the geometry with 32 bits indices (see isGeometryIndexedIn32Bits).
+		* It gets all the node indices of a particular face of a particular cell
+		* The returned pointer remains valid until unpinGeometry or unloadGeometry is called.
+		*/
+		const unsigned int * getUIntNodeIndicesOfFaceOfCell(const ULONG64 & cellIndex, const unsigned int & localFaceIndex) const;
+
+		/**
+		* This method requires your have already loaded the geometry.
+		* @return The count of cells sharing a particular face : 1 for a boundary face, 2 for an inner face.
+		*/
+		unsigned int getCellCountOfFace(const ULONG64 & faceIndex) const;
+
+		/**
+		* This method requires your have already loaded the geometry.
+		* It gets the indices of the cells sharing a particular face, ordered by increasing cell index.
+		* The returned pointer remains valid until unpinGeometry or unloadGeometry is called.
+		*/
+		const ULONG64 * getCellIndicesOfFace(const ULONG64 & faceIndex) const;
+
+		/**
+		* This method requires your have already loaded the geometry.
+		* Get the face to cell inverse map of the whole grid.
+		* @param cumulativeCellCountPerFace	It must be pre allocated with getFaceCount(). First value is the count of cells of the first face, second value is the count of cells of the first and the second face, etc...
+		* @param cellIndicesOfFaces			It must be pre allocated with the last value of cumulativeCellCountPerFace which is the count of distinct faces per cell of the grid.
+		*/
+		void getCellIndicesOfFaces(ULONG64 * cumulativeCellCountPerFace, ULONG64 * cellIndicesOfFaces) const;
+
+		/**
+		* This method requires your have already loaded the geometry.
+		* @return The count of neighbors of a particular cell. A neighbor which shares several faces with the cell is counted once per shared face. A face listed several times by a cell is only counted once.
+		*/
+		unsigned int getNeighborCountOfCell(const ULONG64 & cellIndex) const;
+
+		/**
+		* This method requires your have already loaded the geometry.
+		* It gets the indices of the neighbor cells of a particular cell. There is one neighbor per shared face, following the face order of the cell.
+		* The returned pointer remains valid until unpinGeometry or unloadGeometry is called.
+		*/
+		const ULONG64 * getNeighborCellIndicesOfCell(const ULONG64 & cellIndex) const;
+
+		/**
+		* This method requires your have already loaded the geometry.
+		* It gets the indices of the faces which are shared with each neighbor cell given by getNeighborCellIndicesOfCell.
+		* The returned pointer remains valid until unpinGeometry or unloadGeometry is called.
+		*/
+		const ULONG64 * getNeighborFaceIndicesOfCell(const ULONG64 & cellIndex) const;
+
+		/**
+		* This method requires your have already loaded the geometry.
+		* @return The count of neighbor entries of the cell adjacency graph i.e. twice the count of shared faces.
+		*/
+		ULONG64 getCellAdjacencyCount() const;
+
+		/**
+		* This method requires your have already loaded the geometry.
+		* Get the cell adjacency graph of the whole grid in compressed sparse row format.
+		* @param cumulativeNeighborCountPerCell	It must be pre allocated with getCellCount(). First value is the count of neighbors of the first cell, second value is the count of neighbors of the first and the second cell, etc...
+		* @param neighborCellIndices			It must be pre allocated with getCellAdjacencyCount().
+		* @param neighborFaceIndices			If not null, it must be pre allocated with getCellAdjacencyCount(). It is filled in with the face shared with each neighbor.
+		*/
+		void getCellAdjacency(ULONG64 * cumulativeNeighborCountPerCell, ULONG64 * neighborCellIndices, ULONG64 * neighborFaceIndices = nullptr) const;
+
+		/**
+		* This method requires your have already loaded the geometry.
+		* Compute the area, the unit normal and the centroid of all the faces of the grid in the local CRS of the grid.
+		* A non triangular face is split into a fan of triangles around the average of its nodes which allows non planar faces.
+		* The normal of a face follows the right hand rule on the order of its nodes, whatever the cells sharing this face.
+		* @param faceAreas		If not null, it must be pre allocated with getFaceCount().
+		* @param faceNormals	If not null, it must be pre allocated with 3 * getFaceCount().
+		* @param faceCentroids	If not null, it must be pre allocated with 3 * getFaceCount().
+		*/
+		void computeFaceGeometry(double * faceAreas, double * faceNormals = nullptr, double * faceCentroids = nullptr) const;
+
+		/**
+		* This method requires your have already loaded the geometry.
+		* Compute the volume and the centroid of all the cells of the grid in the local CRS of the grid.
+		* Each cell is split into tetrahedra joining the average of its face centers to the (fan) triangles of its faces.
+		* The faces are oriented outward by means of getCellFaceIsRightHanded : a negative volume reveals an inconsistent face handedness.
+		* The cells are shared between threads and tetrahedral or hexahedral grids are processed without going through the cumulative counts.
+		* @param cellVolumes	If not null, it must be pre allocated with getCellCount().
+		* @param cellCentroids	If not null, it must be pre allocated with 3 * getCellCount().
+		*/
+		void computeCellGeometry(double * cellVolumes, double * cellCentroids = nullptr) const;
+
 		/**
 		 * Get the cell count
 		 */
@@ -0,0 +1,351 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace indexing
+{
+	/**
+	* Count the set bits of a 64 bits word.
+	*/
+	inline unsigned int popcount64(uint64_t word)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<unsigned int>(__builtin_popcountll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+		return static_cast<unsigned int>(__popcnt64(word));
+#else
+		word = word - ((word >> 1) & 0x5555555555555555ULL);
+		word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+		word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return static_cast<unsigned int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+	}
+
+	/**
+	* Get the position (from the least significant bit) of the rank-th set bit of a 64 bits word.
+	* The word must contain at least rank + 1 set bits.
+	*/
+	inline unsigned int selectInWord64(uint64_t word, unsigned int rank)
+	{
+		for (unsigned int i = 0; i < rank; ++i) {
+			word &= word - 1; // clear the lowest set bit
+		}
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<unsigned int>(__builtin_ctzll(word));
+#else
+		unsigned int result = 0;
+		while ((word & 1) == 0) {
+			word >>= 1;
+			++result;
+		}
+		return result;
+#endif
+	}
+
+	/**
+	* A bit packed set of flags (one bit per item instead of one byte for a bool array) with rank/select support.
+	* It is typically used to store enabled (i.e. active) cells of a grid where it allows to go from a global cell index to an active cell index and conversely.
+	* The rank/select directory is built on demand (after any modification). Rank is then answered in constant time and select
+	* in a time logarithmic in the count of superblocks between two consecutive select samples, whatever the density of the bitset.
+	*/
+	class BitSet
+	{
+	public:
+
+		/**
+		* Create a bitset of bitCount bits, all set to value.
+		*/
+		BitSet(uint64_t bitCount = 0, bool value = false) : bitCount(0), isDirectoryUpToDate(false) { resize(bitCount, value); }
+		~BitSet() {}
+
+		/**
+		* Resize the bitset. All bits (including existing ones) are set to value.
+		*/
+		void resize(uint64_t newBitCount, bool value = false)
+		{
+			bitCount = newBitCount;
+			words.assign((bitCount + 63) / 64, value ? ~static_cast<uint64_t>(0) : 0);
+			clearTrailingBits();
+			isDirectoryUpToDate = false;
+		}
+
+		/**
+		* Get the count of bits in this bitset.
+		*/
+		uint64_t size() const { return bitCount; }
+
+		/**
+		* Get the count of 64 bits words which are used to store the bits.
+		*/
+		uint64_t getWordCount() const { return words.size(); }
+
+		/**
+		* Get a read only access to the underlying words. Bit i is stored in word i/64 at position i%64.
+		*/
+		const uint64_t* getWords() const { return words.empty() ? nullptr : &words[0]; }
+
+		bool test(uint64_t index) const
+		{
+			return ((words[index >> 6] >> (index & 63)) & 1) != 0;
+		}
+
+		void set(uint64_t index, bool value = true)
+		{
+			if (value) {
+				words[index >> 6] |= static_cast<uint64_t>(1) << (index & 63);
+			}
+			else {
+				words[index >> 6] &= ~(static_cast<uint64_t>(1) << (index & 63));
+			}
+			isDirectoryUpToDate = false;
+		}
+
+		/**
+		* Set the bits from an array of values. A zero value unsets the bit, any other value sets it.
+		* @param values	Must be of count size().
+		*/
+		template <class T> void setFromArray(const T* values)
+		{
+			for (uint64_t w = 0; w < words.size(); ++w) {
+				const uint64_t start = w << 6;
+				const unsigned int end = bitCount - start < 64 ? static_cast<unsigned int>(bitCount - start) : 64;
+				uint64_t word = 0;
+				for (unsigned int b = 0; b < end; ++b) {
+					word |= static_cast<uint64_t>(values[start + b] != 0) << b;
+				}
+				words[w] = word;
+			}
+			isDirectoryUpToDate = false;
+		}
+
+		/**
+		* Expand the bits into an array of values (1 for a set bit, 0 for an unset bit).
+		* @param values	Must be preallocated with a count of size().
+		*/
+		template <class T> void getAsArray(T* values) const
+		{
+			for (uint64_t w = 0; w < words.size(); ++w) {
+				const uint64_t start = w << 6;
+				const unsigned int end = bitCount - start < 64 ? static_cast<unsigned int>(bitCount - start) : 64;
+				const uint64_t word = words[w];
+				for (unsigned int b = 0; b < end; ++b) {
+					values[start + b] = static_cast<T>((word >> b) & 1);
+				}
+			}
+		}
+
+		/**
+		* Count the set bits.
+		*/
+		uint64_t count() const
+		{
+			if (isDirectoryUpToDate) {
+				return setBitCount;
+			}
+			uint64_t result = 0;
+			for (size_t w = 0; w < words.size(); ++w) {
+				result += popcount64(words[w]);
+			}
+			return result;
+		}
+
+		/**
+		* Build the rank/select directory. It is automatically called by rank and select if needed.
+		* Call it explicitly before sharing a const bitset between several threads.
+		*/
+		void buildDirectory() const
+		{
+			const size_t superBlockCount = (words.size() + WORDS_PER_SUPERBLOCK - 1) / WORDS_PER_SUPERBLOCK;
+			superBlockRanks.resize(superBlockCount + 1);
+			wordRanks.resize(words.size());
+			selectSamples.clear();
+
+			uint64_t rank = 0;
+			for (size_t sb = 0; sb < superBlockCount; ++sb) {
+				superBlockRanks[sb] = rank;
+				const size_t wordEnd = (sb + 1) * WORDS_PER_SUPERBLOCK < words.size() ? (sb + 1) * WORDS_PER_SUPERBLOCK : words.size();
+				for (size_t w = sb * WORDS_PER_SUPERBLOCK; w < wordEnd; ++w) {
+					wordRanks[w] = static_cast<unsigned short>(rank - superBlockRanks[sb]);
+					const unsigned int pop = popcount64(words[w]);
+					// Sample the superblock of each SELECT_SAMPLE_RATE-th set bit
+					while (selectSamples.size() * SELECT_SAMPLE_RATE < rank + pop) {
+						selectSamples.push_back(static_cast<uint64_t>(sb));
+					}
+					rank += pop;
+				}
+			}
+			superBlockRanks[superBlockCount] = rank;
+			setBitCount = rank;
+			isDirectoryUpToDate = true;
+		}
+
+		/**
+		* Count the set bits which are strictly before index.
+		* When the bitset represents enabled cells, it is the active index of the global cell index if this cell is enabled.
+		*/
+		uint64_t rank(uint64_t index) const
+		{
+			if (index > bitCount) {
+				throw std::out_of_range("The index is out of the bitset range.");
+			}
+			if (!isDirectoryUpToDate) {
+				buildDirectory();
+			}
+			if (index == bitCount) {
+				return setBitCount;
+			}
+
+			const uint64_t wordIndex = index >> 6;
+			const unsigned int bitInWord = index & 63;
+			const uint64_t mask = bitInWord == 0 ? 0 : (~static_cast<uint64_t>(0) >> (64 - bitInWord));
+			return superBlockRanks[wordIndex / WORDS_PER_SUPERBLOCK] + wordRanks[wordIndex] + popcount64(words[wordIndex] & mask);
+		}
+
+		/**
+		* Get the index of the (rank+1)-th set bit (rank is zero based).
+		* When the bitset represents enabled cells, it is the global cell index of an active cell index.
+		*/
+		uint64_t select(uint64_t rank) const
+		{
+			if (!isDirectoryUpToDate) {
+				buildDirectory();
+			}
+			if (rank >= setBitCount) {
+				throw std::out_of_range("The rank is greater or equal to the count of set bits.");
+			}
+
+			// The superblock of the set bit lies between the superblocks of the surrounding samples.
+			// Binary search it since, on a sparse bitset, two consecutive samples may be far apart.
+			const uint64_t sample = rank / SELECT_SAMPLE_RATE;
+			const uint64_t sbStart = selectSamples[sample];
+			const uint64_t sbEnd = sample + 1 < selectSamples.size() ? selectSamples[sample + 1] : superBlockRanks.size() - 2;
+			const uint64_t sb = static_cast<uint64_t>(std::upper_bound(superBlockRanks.begin() + sbStart + 1, superBlockRanks.begin() + sbEnd + 1, rank) - superBlockRanks.begin()) - 1;
+			uint64_t remaining = rank - superBlockRanks[sb];
+			uint64_t w = sb * WORDS_PER_SUPERBLOCK;
+			unsigned int pop = popcount64(words[w]);
+			while (pop <= remaining) {
+				remaining -= pop;
+				pop = popcount64(words[++w]);
+			}
+			return (w << 6) + selectInWord64(words[w], static_cast<unsigned int>(remaining));
+		}
+
+		/**
+		* Get the active index of a global index.
+		* @return The active index or std::numeric_limits<uint64_t>::max() if the bit at globalIndex is unset.
+		*/
+		uint64_t globalToActive(uint64_t globalIndex) const
+		{
+			return test(globalIndex) ? rank(globalIndex) : (std::numeric_limits<uint64_t>::max)();
+		}
+
+		/**
+		* Get the global index of an active index.
+		*/
+		uint64_t activeToGlobal(uint64_t activeIndex) const { return select(activeIndex); }
+
+		/**
+		* Copy the values corresponding to a set bit into a compacted array.
+		* @param input	An array of size() values
+		* @param output	Must be preallocated with count() values.
+		* @return		The count of written values.
+		*/
+		template <class T> uint64_t compact(const T* input, T* output) const
+		{
+			uint64_t outIndex = 0;
+			for (uint64_t w = 0; w < words.size(); ++w) {
+				uint64_t word = words[w];
+				const uint64_t start = w << 6;
+				if (word == ~static_cast<uint64_t>(0)) {
+					// Dense word : straight copy which can be vectorized
+					for (unsigned int b = 0; b < 64; ++b) {
+						output[outIndex + b] = input[start + b];
+					}
+					outIndex += 64;
+				}
+				else {
+					while (word != 0) {
+#if defined(__GNUC__) || defined(__clang__)
+						const unsigned int b = static_cast<unsigned int>(__builtin_ctzll(word));
+#else
+						const unsigned int b = selectInWord64(word, 0);
+#endif
+						output[outIndex++] = input[start + b];
+						word &= word - 1;
+					}
+				}
+			}
+			return outIndex;
+		}
+
+		/**
+		* Scatter compacted values back into a full array. Values corresponding to an unset bit are set to fillValue.
+		* @param input	An array of count() values
+		* @param output	Must be preallocated with size() values.
+		*/
+		template <class T> void expand(const T* input, T* output, const T & fillValue) const
+		{
+			uint64_t inIndex = 0;
+			for (uint64_t w = 0; w < words.size(); ++w) {
+				const uint64_t word = words[w];
+				const uint64_t start = w << 6;
+				const unsigned int end = bitCount - start < 64 ? static_cast<unsigned int>(bitCount - start) : 64;
+				for (unsigned int b = 0; b < end; ++b) {
+					if ((word >> b) & 1) {
+						output[start + b] = input[inIndex++];
+					}
+					else {
+						output[start + b] = fillValue;
+					}
+				}
+			}
+		}
+
+	private:
+
+		enum { WORDS_PER_SUPERBLOCK = 8, SELECT_SAMPLE_RATE = 4096 };
+
+		void clearTrailingBits()
+		{
+			if ((bitCount & 63) != 0 && !words.empty()) {
+				words.back() &= ~static_cast<uint64_t>(0) >> (64 - (bitCount & 63));
+			}
+		}
+
+		uint64_t bitCount;
+		std::vector<uint64_t> words;
+
+		// Rank/select directory
+		mutable bool isDirectoryUpToDate;
+		mutable uint64_t setBitCount;
+		mutable std::vector<uint64_t> superBlockRanks;	// set bit count before each superblock (one more entry for the total)
+		mutable std::vector<unsigned short> wordRanks;	// set bit count before each word relative to its superblock
+		mutable std::vector<uint64_t> selectSamples;	// superblock containing each SELECT_SAMPLE_RATE-th set bit
+	};
+}
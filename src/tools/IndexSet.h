@@ -0,0 +1,721 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdint.h>
+
+#include "tools/BitSet.h"
+
+namespace indexing
+{
+	/**
+	* A compressed set of 64 bits indices which is typically used to store the selected elements of a subrepresentation without expanding them.
+	* The index space is cut into chunks of 65536 indices. Only non empty chunks are stored and each of them uses the most compact of three containers :
+	* a sorted array of the 16 low bits of the indices (sparse chunks), a bitmap of 65536 bits (dense chunks) or a sorted list of index runs (ranges and lattices).
+	* Membership, union, intersection and iteration work on the compressed containers. The indices are only materialized on request (see getIndices).
+	*/
+	class IndexSet
+	{
+	private:
+
+		/**
+		* The indices of a chunk of 65536 indices.
+		*/
+		struct Container
+		{
+			enum { ARRAY_KIND = 0, BITMAP_KIND = 1, RUN_KIND = 2 };
+			enum { MAX_ARRAY_SIZE = 4096, MAX_RUN_COUNT = 2048, BITMAP_WORD_COUNT = 1024 };
+
+			uint64_t key;		// the high 48 bits of the indices of this chunk
+			unsigned char kind;
+			uint32_t cardinality;
+			std::vector<uint16_t> values;	// sorted low bits for an array, flattened (first, last) pairs for runs
+			std::vector<uint64_t> words;	// bits for a bitmap
+
+			Container(const uint64_t & key) : key(key), kind(ARRAY_KIND), cardinality(0) {}
+
+			bool contains(const uint16_t & low) const;
+			void add(const uint16_t & low);
+			void addRange(const uint16_t & first, const uint16_t & last);
+			void addRun(const uint16_t & first, const uint16_t & last);
+			void toBitmap();
+			void optimize();
+			void intersectWith(const Container & other);
+			void uniteWith(const Container & other);
+			void appendRanges(std::vector< std::pair<uint64_t, uint64_t> > & ranges) const;
+			uint64_t getByteSize() const;
+		};
+
+		std::vector<Container> containers; // sorted by key
+
+		/**
+		* Get the container of a key, creating it if it does not exist yet.
+		*/
+		Container & getOrCreateContainer(const uint64_t & key);
+
+	public:
+
+		/**
+		* Forward iterator over the indices of a set in increasing order.
+		*/
+		class const_iterator
+		{
+		public:
+			const_iterator() : set(nullptr), containerIndex(0), cursor(0), low(0) {}
+
+			uint64_t operator*() const { return (set->containers[containerIndex].key << 16) | low; }
+			const_iterator & operator++();
+			bool operator==(const const_iterator & other) const { return set == other.set && containerIndex == other.containerIndex && low == other.low; }
+			bool operator!=(const const_iterator & other) const { return !(*this == other); }
+
+		private:
+			friend class IndexSet;
+
+			/**
+			* Move to the first index of the current container (or of the next non empty one).
+			*/
+			void seekFirst();
+
+			const IndexSet* set;
+			size_t containerIndex;
+			uint32_t cursor;	// position in the array or in the runs of the current container
+			uint32_t low;		// low bits of the current index
+		};
+
+		IndexSet() {}
+		~IndexSet() {}
+
+		/**
+		* Add a single index.
+		*/
+		void add(const uint64_t & index);
+
+		/**
+		* Add all the indices of the range [start, end).
+		*/
+		void addRange(const uint64_t & start, const uint64_t & end);
+
+		/**
+		* Add some indices. Consecutive indices are added as ranges which makes this method fast for sorted indices.
+		*/
+		void add(const uint64_t * indices, const uint64_t & count);
+
+		/**
+		* Remove all indices.
+		*/
+		void clear() { containers.clear(); }
+
+		bool contains(const uint64_t & index) const;
+
+		/**
+		* Get the count of indices in this set.
+		*/
+		uint64_t count() const;
+
+		bool empty() const { return containers.empty(); }
+
+		/**
+		* Convert each container to its most compact representation.
+		* It is automatically called after a set operation but not after an addition.
+		*/
+		void optimize();
+
+		/**
+		* Get the count of bytes used by the containers of this set.
+		*/
+		uint64_t getByteSize() const;
+
+		/**
+		* Keep only the indices which are also in another set.
+		*/
+		IndexSet & operator&=(const IndexSet & other);
+
+		/**
+		* Add all the indices of another set.
+		*/
+		IndexSet & operator|=(const IndexSet & other);
+
+		/**
+		* Materialize the indices in increasing order.
+		* @param indices	It must be preallocated with count() values.
+		*/
+		void getIndices(uint64_t * indices) const;
+
+		/**
+		* Get the maximal ranges [start, end) of consecutive indices in increasing order.
+		*/
+		void getRanges(std::vector< std::pair<uint64_t, uint64_t> > & ranges) const;
+
+		const_iterator begin() const;
+		const_iterator end() const;
+	};
+
+	inline bool IndexSet::Container::contains(const uint16_t & low) const
+	{
+		if (kind == ARRAY_KIND) {
+			return std::binary_search(values.begin(), values.end(), low);
+		}
+		if (kind == BITMAP_KIND) {
+			return ((words[low >> 6] >> (low & 63)) & 1) != 0;
+		}
+		// Find the last run starting before or at low
+		size_t begin = 0;
+		size_t end = values.size() / 2;
+		while (begin < end) {
+			const size_t middle = (begin + end) / 2;
+			if (values[middle * 2] <= low) {
+				begin = middle + 1;
+			}
+			else {
+				end = middle;
+			}
+		}
+		return begin > 0 && values[begin * 2 - 1] >= low;
+	}
+
+	inline void IndexSet::Container::add(const uint16_t & low)
+	{
+		if (kind == RUN_KIND) {
+			addRun(low, low);
+			return;
+		}
+		if (kind == ARRAY_KIND) {
+			std::vector<uint16_t>::iterator it = std::lower_bound(values.begin(), values.end(), low);
+			if (it == values.end() || *it != low) {
+				values.insert(it, low);
+				++cardinality;
+				if (cardinality > MAX_ARRAY_SIZE) {
+					toBitmap();
+				}
+			}
+			return;
+		}
+		const uint64_t mask = static_cast<uint64_t>(1) << (low & 63);
+		if ((words[low >> 6] & mask) == 0) {
+			words[low >> 6] |= mask;
+			++cardinality;
+		}
+	}
+
+	inline void IndexSet::Container::addRange(const uint16_t & first, const uint16_t & last)
+	{
+		if (cardinality == 0) {
+			kind = RUN_KIND;
+			values.resize(2);
+			values[0] = first;
+			values[1] = last;
+			cardinality = static_cast<uint32_t>(last) - first + 1;
+			return;
+		}
+		if (kind == RUN_KIND) {
+			addRun(first, last);
+			return;
+		}
+		toBitmap();
+		const unsigned int firstWord = first >> 6;
+		const unsigned int lastWord = last >> 6;
+		for (unsigned int w = firstWord; w <= lastWord; ++w) {
+			uint64_t mask = ~static_cast<uint64_t>(0);
+			if (w == firstWord) {
+				mask &= ~static_cast<uint64_t>(0) << (first & 63);
+			}
+			if (w == lastWord) {
+				mask &= ~static_cast<uint64_t>(0) >> (63 - (last & 63));
+			}
+			cardinality += popcount64(mask & ~words[w]);
+			words[w] |= mask;
+		}
+	}
+
+	inline void IndexSet::Container::addRun(const uint16_t & first, const uint16_t & last)
+	{
+		// Find the first run which overlaps or touches the new one i.e. the first run which ends at or after first - 1.
+		const size_t runCount = values.size() / 2;
+		size_t begin = 0;
+		size_t end = runCount;
+		while (begin < end) {
+			const size_t middle = (begin + end) / 2;
+			if (static_cast<uint32_t>(values[middle * 2 + 1]) + 1 < first) {
+				begin = middle + 1;
+			}
+			else {
+				end = middle;
+			}
+		}
+
+		// Merge all the runs which overlap or touch the new one.
+		uint32_t mergedFirst = first;
+		uint32_t mergedLast = last;
+		size_t mergeEnd = begin;
+		while (mergeEnd < runCount && values[mergeEnd * 2] <= static_cast<uint32_t>(last) + 1) {
+			if (values[mergeEnd * 2] < mergedFirst) {
+				mergedFirst = values[mergeEnd * 2];
+			}
+			if (values[mergeEnd * 2 + 1] > mergedLast) {
+				mergedLast = values[mergeEnd * 2 + 1];
+			}
+			cardinality -= static_cast<uint32_t>(values[mergeEnd * 2 + 1]) - values[mergeEnd * 2] + 1;
+			++mergeEnd;
+		}
+		cardinality += mergedLast - mergedFirst + 1;
+
+		if (mergeEnd == begin) {
+			const uint16_t run[2] = { static_cast<uint16_t>(mergedFirst), static_cast<uint16_t>(mergedLast) };
+			values.insert(values.begin() + begin * 2, run, run + 2);
+		}
+		else {
+			values[begin * 2] = static_cast<uint16_t>(mergedFirst);
+			values[begin * 2 + 1] = static_cast<uint16_t>(mergedLast);
+			values.erase(values.begin() + begin * 2 + 2, values.begin() + mergeEnd * 2);
+		}
+
+		// Too many runs take more memory than a bitmap
+		if (values.size() / 2 > MAX_RUN_COUNT) {
+			toBitmap();
+		}
+	}
+
+	inline void IndexSet::Container::toBitmap()
+	{
+		if (kind == BITMAP_KIND) {
+			return;
+		}
+		words.assign(BITMAP_WORD_COUNT, 0);
+		if (kind == ARRAY_KIND) {
+			for (size_t i = 0; i < values.size(); ++i) {
+				words[values[i] >> 6] |= static_cast<uint64_t>(1) << (values[i] & 63);
+			}
+		}
+		else {
+			for (size_t run = 0; run < values.size(); run += 2) {
+				for (uint32_t low = values[run]; low <= values[run + 1]; ++low) {
+					words[low >> 6] |= static_cast<uint64_t>(1) << (low & 63);
+				}
+			}
+		}
+		std::vector<uint16_t>().swap(values);
+		kind = BITMAP_KIND;
+	}
+
+	inline void IndexSet::Container::optimize()
+	{
+		toBitmap();
+
+		// Count the runs i.e. the bits which are set while their previous bit is not.
+		uint64_t runCount = 0;
+		uint64_t previousBit = 0;
+		for (unsigned int w = 0; w < BITMAP_WORD_COUNT; ++w) {
+			const uint64_t word = words[w];
+			runCount += popcount64(word & ~((word << 1) | previousBit));
+			previousBit = word >> 63;
+		}
+
+		const uint64_t arrayByteSize = static_cast<uint64_t>(cardinality) * sizeof(uint16_t);
+		const uint64_t runByteSize = runCount * 2 * sizeof(uint16_t);
+		const uint64_t bitmapByteSize = BITMAP_WORD_COUNT * sizeof(uint64_t);
+		if (runByteSize < arrayByteSize && runByteSize < bitmapByteSize) {
+			std::vector< std::pair<uint64_t, uint64_t> > ranges;
+			appendRanges(ranges);
+			values.resize(ranges.size() * 2);
+			for (size_t run = 0; run < ranges.size(); ++run) {
+				values[run * 2] = static_cast<uint16_t>(ranges[run].first);
+				values[run * 2 + 1] = static_cast<uint16_t>(ranges[run].second - 1);
+			}
+			kind = RUN_KIND;
+			std::vector<uint64_t>().swap(words);
+		}
+		else if (arrayByteSize < bitmapByteSize) {
+			values.reserve(cardinality);
+			for (unsigned int w = 0; w < BITMAP_WORD_COUNT; ++w) {
+				uint64_t word = words[w];
+				while (word != 0) {
+					values.push_back(static_cast<uint16_t>((w << 6) + selectInWord64(word, 0)));
+					word &= word - 1;
+				}
+			}
+			kind = ARRAY_KIND;
+			std::vector<uint64_t>().swap(words);
+		}
+	}
+
+	inline void IndexSet::Container::intersectWith(const Container & other)
+	{
+		if (kind == ARRAY_KIND) {
+			size_t kept = 0;
+			for (size_t i = 0; i < values.size(); ++i) {
+				if (other.contains(values[i])) {
+					values[kept++] = values[i];
+				}
+			}
+			values.resize(kept);
+			cardinality = static_cast<uint32_t>(kept);
+			return;
+		}
+		if (other.kind == ARRAY_KIND) {
+			Container result(other);
+			result.intersectWith(*this);
+			*this = result;
+			return;
+		}
+
+		toBitmap();
+		Container otherBitmap(other);
+		otherBitmap.toBitmap();
+		cardinality = 0;
+		for (unsigned int w = 0; w < BITMAP_WORD_COUNT; ++w) {
+			words[w] &= otherBitmap.words[w];
+			cardinality += popcount64(words[w]);
+		}
+	}
+
+	inline void IndexSet::Container::uniteWith(const Container & other)
+	{
+		if (kind == RUN_KIND && other.kind == RUN_KIND) {
+			for (size_t run = 0; run < other.values.size() && kind == RUN_KIND; run += 2) {
+				addRun(other.values[run], other.values[run + 1]);
+			}
+			if (kind == RUN_KIND) {
+				return;
+			}
+		}
+		toBitmap();
+		Container otherBitmap(other);
+		otherBitmap.toBitmap();
+		cardinality = 0;
+		for (unsigned int w = 0; w < BITMAP_WORD_COUNT; ++w) {
+			words[w] |= otherBitmap.words[w];
+			cardinality += popcount64(words[w]);
+		}
+	}
+
+	inline void IndexSet::Container::appendRanges(std::vector< std::pair<uint64_t, uint64_t> > & ranges) const
+	{
+		const uint64_t base = key << 16;
+		if (kind == RUN_KIND) {
+			for (size_t run = 0; run < values.size(); run += 2) {
+				const uint64_t start = base + values[run];
+				const uint64_t end = base + values[run + 1] + 1;
+				if (!ranges.empty() && ranges.back().second == start) {
+					ranges.back().second = end;
+				}
+				else {
+					ranges.push_back(std::make_pair(start, end));
+				}
+			}
+		}
+		else if (kind == ARRAY_KIND) {
+			for (size_t i = 0; i < values.size(); ++i) {
+				const uint64_t index = base + values[i];
+				if (!ranges.empty() && ranges.back().second == index) {
+					++ranges.back().second;
+				}
+				else {
+					ranges.push_back(std::make_pair(index, index + 1));
+				}
+			}
+		}
+		else {
+			for (unsigned int w = 0; w < BITMAP_WORD_COUNT; ++w) {
+				const uint64_t word = words[w];
+				if (word == 0) {
+					continue;
+				}
+				for (unsigned int b = 0; b < 64; ++b) {
+					if ((word >> b) & 1) {
+						const uint64_t index = base + (w << 6) + b;
+						if (!ranges.empty() && ranges.back().second == index) {
+							++ranges.back().second;
+						}
+						else {
+							ranges.push_back(std::make_pair(index, index + 1));
+						}
+					}
+				}
+			}
+		}
+	}
+
+	inline uint64_t IndexSet::Container::getByteSize() const
+	{
+		return values.capacity() * sizeof(uint16_t) + words.capacity() * sizeof(uint64_t);
+	}
+
+	inline IndexSet::Container & IndexSet::getOrCreateContainer(const uint64_t & key)
+	{
+		// Additions are mostly made in increasing order
+		if (!containers.empty() && containers.back().key == key) {
+			return containers.back();
+		}
+		size_t begin = 0;
+		size_t end = containers.size();
+		while (begin < end) {
+			const size_t middle = (begin + end) / 2;
+			if (containers[middle].key < key) {
+				begin = middle + 1;
+			}
+			else {
+				end = middle;
+			}
+		}
+		if (begin == containers.size() || containers[begin].key != key) {
+			containers.insert(containers.begin() + begin, Container(key));
+		}
+		return containers[begin];
+	}
+
+	inline void IndexSet::add(const uint64_t & index)
+	{
+		getOrCreateContainer(index >> 16).add(static_cast<uint16_t>(index & 0xFFFF));
+	}
+
+	inline void IndexSet::addRange(const uint64_t & start, const uint64_t & end)
+	{
+		uint64_t first = start;
+		while (first < end) {
+			const uint64_t key = first >> 16;
+			const uint64_t last = (key << 16) + 0xFFFF < end - 1 ? (key << 16) + 0xFFFF : end - 1;
+			getOrCreateContainer(key).addRange(static_cast<uint16_t>(first & 0xFFFF), static_cast<uint16_t>(last & 0xFFFF));
+			first = last + 1;
+		}
+	}
+
+	inline void IndexSet::add(const uint64_t * indices, const uint64_t & count)
+	{
+		uint64_t i = 0;
+		while (i < count) {
+			uint64_t j = i + 1;
+			while (j < count && indices[j] == indices[j - 1] + 1) {
+				++j;
+			}
+			if (j - i == 1) {
+				add(indices[i]);
+			}
+			else {
+				addRange(indices[i], indices[j - 1] + 1);
+			}
+			i = j;
+		}
+	}
+
+	inline bool IndexSet::contains(const uint64_t & index) const
+	{
+		const uint64_t key = index >> 16;
+		size_t begin = 0;
+		size_t end = containers.size();
+		while (begin < end) {
+			const size_t middle = (begin + end) / 2;
+			if (containers[middle].key < key) {
+				begin = middle + 1;
+			}
+			else {
+				end = middle;
+			}
+		}
+		return begin < containers.size() && containers[begin].key == key && containers[begin].contains(static_cast<uint16_t>(index & 0xFFFF));
+	}
+
+	inline uint64_t IndexSet::count() const
+	{
+		uint64_t result = 0;
+		for (size_t c = 0; c < containers.size(); ++c) {
+			result += containers[c].cardinality;
+		}
+		return result;
+	}
+
+	inline void IndexSet::optimize()
+	{
+		for (size_t c = 0; c < containers.size(); ++c) {
+			containers[c].optimize();
+		}
+	}
+
+	inline uint64_t IndexSet::getByteSize() const
+	{
+		uint64_t result = containers.capacity() * sizeof(Container);
+		for (size_t c = 0; c < containers.size(); ++c) {
+			result += containers[c].getByteSize();
+		}
+		return result;
+	}
+
+	inline IndexSet & IndexSet::operator&=(const IndexSet & other)
+	{
+		size_t kept = 0;
+		size_t otherIndex = 0;
+		for (size_t c = 0; c < containers.size(); ++c) {
+			while (otherIndex < other.containers.size() && other.containers[otherIndex].key < containers[c].key) {
+				++otherIndex;
+			}
+			if (otherIndex == other.containers.size() || other.containers[otherIndex].key != containers[c].key) {
+				continue;
+			}
+			containers[c].intersectWith(other.containers[otherIndex]);
+			if (containers[c].cardinality > 0) {
+				containers[c].optimize();
+				if (kept != c) {
+					containers[kept] = containers[c];
+				}
+				++kept;
+			}
+		}
+		containers.erase(containers.begin() + kept, containers.end());
+		return *this;
+	}
+
+	inline IndexSet & IndexSet::operator|=(const IndexSet & other)
+	{
+		std::vector<Container> result;
+		result.reserve(containers.size() + other.containers.size());
+		size_t c = 0;
+		size_t otherIndex = 0;
+		while (c < containers.size() || otherIndex < other.containers.size()) {
+			if (otherIndex == other.containers.size() || (c < containers.size() && containers[c].key < other.containers[otherIndex].key)) {
+				result.push_back(containers[c++]);
+			}
+			else if (c == containers.size() || other.containers[otherIndex].key < containers[c].key) {
+				result.push_back(other.containers[otherIndex++]);
+			}
+			else {
+				result.push_back(containers[c++]);
+				result.back().uniteWith(other.containers[otherIndex++]);
+				result.back().optimize();
+			}
+		}
+		containers.swap(result);
+		return *this;
+	}
+
+	inline void IndexSet::getIndices(uint64_t * indices) const
+	{
+		uint64_t i = 0;
+		for (size_t c = 0; c < containers.size(); ++c) {
+			const Container & container = containers[c];
+			const uint64_t base = container.key << 16;
+			if (container.kind == Container::ARRAY_KIND) {
+				for (size_t v = 0; v < container.values.size(); ++v) {
+					indices[i++] = base + container.values[v];
+				}
+			}
+			else if (container.kind == Container::RUN_KIND) {
+				for (size_t run = 0; run < container.values.size(); run += 2) {
+					for (uint64_t low = container.values[run]; low <= container.values[run + 1]; ++low) {
+						indices[i++] = base + low;
+					}
+				}
+			}
+			else {
+				for (unsigned int w = 0; w < Container::BITMAP_WORD_COUNT; ++w) {
+					uint64_t word = container.words[w];
+					while (word != 0) {
+						indices[i++] = base + (w << 6) + selectInWord64(word, 0);
+						word &= word - 1;
+					}
+				}
+			}
+		}
+	}
+
+	inline void IndexSet::getRanges(std::vector< std::pair<uint64_t, uint64_t> > & ranges) const
+	{
+		ranges.clear();
+		for (size_t c = 0; c < containers.size(); ++c) {
+			containers[c].appendRanges(ranges);
+		}
+	}
+
+	inline IndexSet::const_iterator IndexSet::begin() const
+	{
+		const_iterator result;
+		result.set = this;
+		result.seekFirst();
+		return result;
+	}
+
+	inline IndexSet::const_iterator IndexSet::end() const
+	{
+		const_iterator result;
+		result.set = this;
+		result.containerIndex = containers.size();
+		return result;
+	}
+
+	inline void IndexSet::const_iterator::seekFirst()
+	{
+		cursor = 0;
+		low = 0;
+		while (containerIndex < set->containers.size() && set->containers[containerIndex].cardinality == 0) {
+			++containerIndex;
+		}
+		if (containerIndex == set->containers.size()) {
+			return;
+		}
+		const Container & container = set->containers[containerIndex];
+		if (container.kind == Container::BITMAP_KIND) {
+			unsigned int w = 0;
+			while (container.words[w] == 0) {
+				++w;
+			}
+			low = (w << 6) + selectInWord64(container.words[w], 0);
+		}
+		else {
+			low = container.values[0];
+		}
+	}
+
+	inline IndexSet::const_iterator & IndexSet::const_iterator::operator++()
+	{
+		const Container & container = set->containers[containerIndex];
+		if (container.kind == Container::ARRAY_KIND) {
+			if (++cursor < container.values.size()) {
+				low = container.values[cursor];
+				return *this;
+			}
+		}
+		else if (container.kind == Container::RUN_KIND) {
+			if (low < container.values[cursor * 2 + 1]) {
+				++low;
+				return *this;
+			}
+			if (++cursor < container.values.size() / 2) {
+				low = container.values[cursor * 2];
+				return *this;
+			}
+		}
+		else if (low < 0xFFFF) {
+			const uint32_t next = low + 1;
+			unsigned int w = next >> 6;
+			uint64_t word = container.words[w] & (~static_cast<uint64_t>(0) << (next & 63));
+			while (word == 0 && ++w < Container::BITMAP_WORD_COUNT) {
+				word = container.words[w];
+			}
+			if (word != 0) {
+				low = (w << 6) + selectInWord64(word, 0);
+				return *this;
+			}
+		}
+
+		++containerIndex;
+		seekFirst();
+		return *this;
+	}
+}
@@ -0,0 +1,147 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#pragma once
+
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+namespace parallel
+{
+	namespace detail
+	{
+		inline unsigned int & maxThreadCount() { static unsigned int value = 0; return value; }
+		inline uint64_t & minItemCountPerThread() { static uint64_t value = 0; return value; }
+	}
+
+	/**
+	* Set the maximum count of threads which can share a computation.
+	* @param threadCount	Zero (the default) means the count of hardware threads. One disables multithreading.
+	*/
+	inline void setMaxThreadCount(const unsigned int & threadCount) { detail::maxThreadCount() = threadCount; }
+
+	/**
+	* Get the maximum count of threads which can share a computation. It is at least one.
+	*/
+	inline unsigned int getMaxThreadCount()
+	{
+		if (detail::maxThreadCount() != 0) {
+			return detail::maxThreadCount();
+		}
+		const unsigned int hardwareThreadCount = std::thread::hardware_concurrency();
+		return hardwareThreadCount == 0 ? 1 : hardwareThreadCount;
+	}
+
+	/**
+	* Override the minimum count of items a thread must process, which is otherwise given by each computation.
+	* It is mainly useful to force multithreading on small data sets, for example in tests.
+	* @param itemCount	Zero (the default) means no override.
+	*/
+	inline void setMinItemCountPerThread(const uint64_t & itemCount) { detail::minItemCountPerThread() = itemCount; }
+
+	/**
+	* Get the count of chunks (i.e. of threads) to split a computation into.
+	* @param itemCount				The count of independent items of the computation.
+	* @param minItemCountPerChunk	The minimum count of items a thread must process in order to be worth its creation.
+	*/
+	inline unsigned int getChunkCount(const uint64_t & itemCount, const uint64_t & minItemCountPerChunk)
+	{
+		const uint64_t grain = detail::minItemCountPerThread() != 0 ? detail::minItemCountPerThread() : (minItemCountPerChunk == 0 ? 1 : minItemCountPerChunk);
+		const uint64_t chunkCount = itemCount / grain;
+		const unsigned int maxThreadCount = getMaxThreadCount();
+		return chunkCount == 0 ? 1 : (chunkCount < maxThreadCount ? static_cast<unsigned int>(chunkCount) : maxThreadCount);
+	}
+
+	/**
+	* Get the index of the first item of a chunk. Chunk c processes the items in [getChunkBegin(c), getChunkBegin(c + 1)).
+	*/
+	inline uint64_t getChunkBegin(const uint64_t & itemCount, const unsigned int & chunkCount, const unsigned int & chunkIndex)
+	{
+		return itemCount / chunkCount * chunkIndex + itemCount % chunkCount * chunkIndex / chunkCount;
+	}
+
+	/**
+	* Split the items [0, itemCount) into chunkCount contiguous chunks and call function(chunkIndex, begin, end) on each chunk in its own thread.
+	* The first chunk is processed by the calling thread. The function must only write to outputs which are distinct from one chunk to another
+	* and must not call the HDF5 library, which is not thread safe.
+	* The first exception thrown by a chunk is rethrown once all chunks are done.
+	*/
+	template <class Function>
+	void forEachChunk(const uint64_t & itemCount, const unsigned int & chunkCount, const Function & function)
+	{
+		if (chunkCount <= 1) {
+			function(0u, static_cast<uint64_t>(0), itemCount);
+			return;
+		}
+
+		std::vector<std::exception_ptr> exceptions(chunkCount);
+		std::vector<std::thread> threads;
+		threads.reserve(chunkCount - 1);
+		for (unsigned int chunkIndex = 1; chunkIndex < chunkCount; ++chunkIndex) {
+			const uint64_t begin = getChunkBegin(itemCount, chunkCount, chunkIndex);
+			const uint64_t end = getChunkBegin(itemCount, chunkCount, chunkIndex + 1);
+			std::exception_ptr & exception = exceptions[chunkIndex];
+			try {
+				threads.push_back(std::thread([&function, &exception, chunkIndex, begin, end]() {
+					try {
+						function(chunkIndex, begin, end);
+					}
+					catch (...) {
+						exception = std::current_exception();
+					}
+				}));
+			}
+			catch (const std::system_error &) {
+				// No more thread available : process the chunk in the calling thread.
+				try {
+					function(chunkIndex, begin, end);
+				}
+				catch (...) {
+					exception = std::current_exception();
+				}
+			}
+		}
+		try {
+			function(0u, static_cast<uint64_t>(0), getChunkBegin(itemCount, chunkCount, 1));
+		}
+		catch (...) {
+			exceptions[0] = std::current_exception();
+		}
+		for (size_t i = 0; i < threads.size(); ++i) {
+			threads[i].join();
+		}
+
+		for (unsigned int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex) {
+			if (exceptions[chunkIndex]) {
+				std::rethrow_exception(exceptions[chunkIndex]);
+			}
+		}
+	}
+
+	/**
+	* Same as forEachChunk with a chunk count given by getChunkCount.
+	*/
+	template <class Function>
+	void forEachRange(const uint64_t & itemCount, const uint64_t & minItemCountPerChunk, const Function & function)
+	{
+		forEachChunk(itemCount, getChunkCount(itemCount, minItemCountPerChunk), function);
+	}
+}
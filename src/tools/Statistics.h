@@ -21,10 +21,189 @@ under the License.
 #include <cstddef>
 #include <utility>
 #include <stdexcept>
+#include <limits>
+#include <vector>
+#include <cmath>
+#include <stdint.h>
 
 namespace statistics
 {
+	/**
+	* Computes in a single pass the count of valid values, the minimum, the maximum, the sum, the sum of squares and optionally an histogram of an array.
+	* A value is valid if it is not NaN and if it is not equal to the null value.
+	* Several accumulators (for example one per slab of a dataset) can be merged.
+	*/
+	template <class T>
+	class Accumulator
+	{
+	public:
+
+		/**
+		* @param nullValue	The values equal to this one are ignored. Use NaN (the default for floating point types) to only ignore NaN values.
+		*/
+		Accumulator(const T & nullValue = getDefaultNullValue()) :
+			nullValue(nullValue), validCount(0), minimum(getInitialMinimum()), maximum(getInitialMaximum()), sum(0), sumOfSquares(0),
+			histogramMinimum(0), histogramMaximum(0), histogramBinWidth(0) {}
+
+		/**
+		* Enable the computation of an histogram of regular bins. It must be called before any value is added.
+		* Valid values out of [histogramMin, histogramMax] are counted in the first or in the last bin.
+		*/
+		void setHistogram(const double & histogramMin, const double & histogramMax, const unsigned int & binCount)
+		{
+			if (binCount == 0 || !(histogramMax > histogramMin)) {
+				throw std::invalid_argument("An histogram needs at least one bin and a maximum strictly greater than its minimum.");
+			}
+			if (validCount != 0) {
+				throw std::logic_error("The histogram must be set before adding any value.");
+			}
+			histogramMinimum = histogramMin;
+			histogramMaximum = histogramMax;
+			histogramBinWidth = (histogramMax - histogramMin) / binCount;
+			histogram.assign(binCount, 0);
+		}
+
+		/**
+		* Accumulate some values.
+		* @param values		The array of values.
+		* @param valueCount	The count of values in the array (including the skipped ones when stride is greater than one).
+		* @param stride		Only one value every stride values is accumulated. It is typically the count of components of a vectorial property.
+		*/
+		void add(const T* values, const size_t & valueCount, const size_t & stride = 1)
+		{
+			if (stride == 0) {
+				throw std::invalid_argument("The stride cannot be zero.");
+			}
+
+			// Work on local variables with branch free updates in order to help the compiler keeping them in registers.
+			T localMin = minimum;
+			T localMax = maximum;
+			uint64_t localCount = 0;
+			double localSum = 0;
+			double localSumOfSquares = 0;
+			if (histogram.empty()) {
+				for (size_t i = 0; i < valueCount; i += stride) {
+					const T value = values[i];
+					const bool isValid = value == value && value != nullValue;
+					localMin = isValid && value < localMin ? value : localMin;
+					localMax = isValid && value > localMax ? value : localMax;
+					localCount += isValid ? 1 : 0;
+					const double doubleValue = isValid ? static_cast<double>(value) : 0.0;
+					localSum += doubleValue;
+					localSumOfSquares += doubleValue * doubleValue;
+				}
+			}
+			else {
+				const size_t lastBin = histogram.size() - 1;
+				for (size_t i = 0; i < valueCount; i += stride) {
+					const T value = values[i];
+					if (value == value && value != nullValue) {
+						localMin = value < localMin ? value : localMin;
+						localMax = value > localMax ? value : localMax;
+						++localCount;
+						const double doubleValue = static_cast<double>(value);
+						localSum += doubleValue;
+						localSumOfSquares += doubleValue * doubleValue;
+						const double bin = (doubleValue - histogramMinimum) / histogramBinWidth;
+						++histogram[bin <= 0 ? 0 : (bin >= lastBin ? lastBin : static_cast<size_t>(bin))];
+					}
+				}
+			}
+
+			minimum = localMin;
+			maximum = localMax;
+			validCount += localCount;
+			sum += localSum;
+			sumOfSquares += localSumOfSquares;
+		}
+
+		/**
+		* Merge the statistics of another accumulator into this one.
+		* Both accumulators must have the same null value and the same histogram definition.
+		*/
+		void merge(const Accumulator<T> & other)
+		{
+			if (other.histogram.size() != histogram.size() || other.histogramMinimum != histogramMinimum || other.histogramMaximum != histogramMaximum) {
+				throw std::invalid_argument("Cannot merge two accumulators having different histograms.");
+			}
+			if (other.minimum < minimum) {
+				minimum = other.minimum;
+			}
+			if (other.maximum > maximum) {
+				maximum = other.maximum;
+			}
+			validCount += other.validCount;
+			sum += other.sum;
+			sumOfSquares += other.sumOfSquares;
+			for (size_t bin = 0; bin < histogram.size(); ++bin) {
+				histogram[bin] += other.histogram[bin];
+			}
+		}
+
+		/**
+		* Get the count of accumulated values which are neither NaN nor equal to the null value.
+		*/
+		uint64_t getValidCount() const { return validCount; }
+
+		/**
+		* Get the minimum valid value. It is the null value if there is no valid value.
+		*/
+		T getMinimum() const { return validCount == 0 ? nullValue : minimum; }
+
+		/**
+		* Get the maximum valid value. It is the null value if there is no valid value.
+		*/
+		T getMaximum() const { return validCount == 0 ? nullValue : maximum; }
+
+		double getSum() const { return sum; }
+		double getSumOfSquares() const { return sumOfSquares; }
+
+		/**
+		* Get the mean of the valid values. It is NaN if there is no valid value.
+		*/
+		double getMean() const { return validCount == 0 ? std::numeric_limits<double>::quiet_NaN() : sum / validCount; }
+
+		/**
+		* Get the population variance of the valid values. It is NaN if there is no valid value.
+		*/
+		double getVariance() const
+		{
+			if (validCount == 0) {
+				return std::numeric_limits<double>::quiet_NaN();
+			}
+			const double mean = sum / validCount;
+			const double variance = sumOfSquares / validCount - mean * mean;
+			return variance > 0 ? variance : 0; // rounding errors could give a slightly negative variance
+		}
+
+		/**
+		* Get the count of valid values in each bin of the histogram. It is empty if no histogram has been set.
+		*/
+		const std::vector<uint64_t> & getHistogram() const { return histogram; }
 
+	private:
+
+		static T getDefaultNullValue() { return std::numeric_limits<T>::has_quiet_NaN ? std::numeric_limits<T>::quiet_NaN() : (std::numeric_limits<T>::max)(); }
+		static T getInitialMinimum() { return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : (std::numeric_limits<T>::max)(); }
+		static T getInitialMaximum() { return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : (std::numeric_limits<T>::min)(); }
+
+		T nullValue;
+		uint64_t validCount;
+		T minimum;
+		T maximum;
+		double sum;
+		double sumOfSquares;
+
+		double histogramMinimum;
+		double histogramMaximum;
+		double histogramBinWidth;
+		std::vector<uint64_t> histogram;
+	};
+
+	/**
+	* Get the minimum and the maximum values of an array, ignoring NaN values and values equal to noValue.
+	* @return The min and the max or a pair of noValue if there is no valid value.
+	*/
 	template <class T>
 	std::pair<T, T> getMinMax(
 		const T* values,
@@ -35,27 +214,9 @@ namespace statistics
 			throw std::invalid_argument("You cannot compute min max on an empty array.");
 		}
 
-		std::pair<T, T> minMax(noValue, noValue);
-		size_t i = 0;
-		while (i < valueCount && (values[i] != values[i] || values[i] == noValue)) ++i;
-		if (i < valueCount)
-		{
-			minMax.first = values[i];
-			minMax.second = values[i];
-		}
-		for (; i < valueCount; ++i)
-		{
-			if (values[i] == values[i] && values[i] != noValue)
-			{
-				if (values[i] > minMax.second)
-					minMax.second = values[i];
-				else if (values[i] < minMax.first)
-					minMax.first = values[i];
-			}
-		}
-
-		return minMax;
+		Accumulator<T> accumulator(noValue);
+		accumulator.add(values, valueCount);
+		return std::pair<T, T>(accumulator.getMinimum(), accumulator.getMaximum());
 	}
 	
 }
-
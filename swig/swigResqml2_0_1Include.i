@@ -2935,6 +2935,7 @@ namespace RESQML2_0_1_NS
 		unsigned int getNodeCountOfFaceOfCell(const ULONG64 & cellIndex, const unsigned int & localFaceIndex) const;
 		ULONG64 * getNodeIndicesOfFaceOfCell(const ULONG64 & cellIndex, const unsigned int & localFaceIndex) const;
 		void unloadGeometry();
+		void unpinGeometry();
 		
 		void setGeometry(unsigned char * cellFaceIsRightHanded, double * points, ULONG64 pointCount, class COMMON_NS::AbstractHdfProxy * proxy,
 			ULONG64 * faceIndicesPerCell, ULONG64 * faceIndicesCumulativeCountPerCell,
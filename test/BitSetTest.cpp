@@ -0,0 +1,79 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "catch.hpp"
+
+#include "tools/BitSet.h"
+
+using namespace indexing;
+
+TEST_CASE("Rank and select a dense bitset", "[tools]")
+{
+	BitSet bitSet(10000, true);
+	bitSet.set(0, false);
+	bitSet.set(5000, false);
+	REQUIRE(bitSet.count() == 9998);
+	REQUIRE(bitSet.rank(5001) == 4999);
+	REQUIRE(bitSet.select(0) == 1);
+	REQUIRE(bitSet.select(4999) == 5001);
+	REQUIRE(bitSet.select(9997) == 9999);
+	for (uint64_t rank = 0; rank < bitSet.count(); rank += 97) {
+		REQUIRE(bitSet.rank(bitSet.select(rank)) == rank);
+	}
+	REQUIRE_THROWS_AS(bitSet.select(9998), std::out_of_range);
+}
+
+TEST_CASE("Rank and select a sparse bitset", "[tools]")
+{
+	// A set bit every 1000 bits : 4096 set bits (i.e. one select sample) span more than 7000 superblocks.
+	const uint64_t bitCount = 10000000;
+	BitSet bitSet(bitCount);
+	for (uint64_t index = 999; index < bitCount; index += 1000) {
+		bitSet.set(index);
+	}
+	REQUIRE(bitSet.count() == 10000);
+	for (uint64_t rank = 0; rank < 10000; ++rank) {
+		REQUIRE(bitSet.select(rank) == rank * 1000 + 999);
+	}
+	REQUIRE(bitSet.rank(bitCount) == 10000);
+	REQUIRE(bitSet.globalToActive(4999) == 4);
+	REQUIRE(bitSet.globalToActive(5000) == (std::numeric_limits<uint64_t>::max)());
+	REQUIRE(bitSet.activeToGlobal(9999) == bitCount - 1);
+}
+
+TEST_CASE("Compact and expand values through a bitset", "[tools]")
+{
+	BitSet bitSet(130);
+	unsigned char mask[130];
+	int values[130];
+	for (unsigned int i = 0; i < 130; ++i) {
+		mask[i] = i < 64 || i % 3 == 0 ? 1 : 0;
+		values[i] = static_cast<int>(i);
+	}
+	bitSet.setFromArray(mask);
+	int compacted[130];
+	const uint64_t compactedCount = bitSet.compact(values, compacted);
+	REQUIRE(compactedCount == bitSet.count());
+	REQUIRE(compacted[63] == 63);
+	REQUIRE(compacted[64] == 66);
+	int expanded[130];
+	bitSet.expand(compacted, expanded, -1);
+	for (unsigned int i = 0; i < 130; ++i) {
+		REQUIRE(expanded[i] == (mask[i] != 0 ? values[i] : -1));
+	}
+}
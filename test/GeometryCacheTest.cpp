@@ -0,0 +1,95 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "catch.hpp"
+
+#include "common/GeometryCache.h"
+
+using namespace COMMON_NS;
+
+namespace {
+	class TestEntry : public GeometryCache::Entry
+	{
+	public:
+		bool* deleted;
+		unsigned long long byteSize;
+
+		TestEntry(bool* deleted, const unsigned long long & byteSize) : deleted(deleted), byteSize(byteSize) { *deleted = false; }
+		~TestEntry() { *deleted = true; }
+
+		unsigned long long getByteSize() const { return byteSize; }
+	};
+}
+
+TEST_CASE("Evict the least recently used geometry", "[cache]")
+{
+	// The cache never dereferences the owners
+	const AbstractObject* firstOwner = reinterpret_cast<const AbstractObject*>(0x10);
+	const AbstractObject* secondOwner = reinterpret_cast<const AbstractObject*>(0x20);
+
+	GeometryCache cache(250);
+	bool firstDeleted, secondDeleted, thirdDeleted;
+	cache.put(firstOwner, GeometryCache::SPLIT_INFORMATION, new TestEntry(&firstDeleted, 100));
+	cache.put(secondOwner, GeometryCache::SPLIT_INFORMATION, new TestEntry(&secondDeleted, 100));
+	REQUIRE(cache.getByteSize() == 200);
+
+	// the first entry becomes the most recently used one
+	REQUIRE(cache.get(firstOwner, GeometryCache::SPLIT_INFORMATION));
+	cache.put(secondOwner, GeometryCache::PILLAR_INFORMATION, new TestEntry(&thirdDeleted, 100));
+	REQUIRE(cache.getEntryCount() == 2);
+	REQUIRE(cache.getByteSize() == 200);
+	REQUIRE_FALSE(firstDeleted);
+	REQUIRE(secondDeleted);
+	REQUIRE_FALSE(cache.get(secondOwner, GeometryCache::SPLIT_INFORMATION));
+
+	// releasing an owner removes all its entries
+	cache.releaseAll(secondOwner);
+	REQUIRE(thirdDeleted);
+	REQUIRE(cache.getEntryCount() == 1);
+
+	REQUIRE_THROWS_AS(cache.put(firstOwner, GeometryCache::PILLAR_INFORMATION, nullptr), std::invalid_argument);
+}
+
+TEST_CASE("Pin an evicted geometry", "[cache]")
+{
+	const AbstractObject* owner = reinterpret_cast<const AbstractObject*>(0x10);
+
+	GeometryCache cache;
+	bool deleted, otherDeleted;
+	std::weak_ptr<GeometryCache::Entry> weakEntry = cache.put(owner, GeometryCache::UNSTRUCTURED_GEOMETRY, new TestEntry(&deleted, 100));
+	{
+		std::shared_ptr<GeometryCache::Entry> pinnedEntry = cache.get(owner, GeometryCache::UNSTRUCTURED_GEOMETRY);
+		cache.setByteBudget(50);
+		REQUIRE(cache.getEntryCount() == 0);
+		REQUIRE(cache.getByteSize() == 0);
+
+		// The evicted entry remains alive while it is pinned
+		REQUIRE_FALSE(deleted);
+		REQUIRE_FALSE(weakEntry.expired());
+		cache.put(owner, GeometryCache::UNSTRUCTURED_GEOMETRY, new TestEntry(&otherDeleted, 10));
+		REQUIRE(cache.getByteSize() == 10);
+		REQUIRE(static_cast<TestEntry*>(pinnedEntry.get())->byteSize == 100);
+		REQUIRE(static_cast<TestEntry*>(cache.get(owner, GeometryCache::UNSTRUCTURED_GEOMETRY).get())->byteSize == 10);
+	}
+	REQUIRE(deleted);
+	REQUIRE(weakEntry.expired());
+
+	cache.clear();
+	REQUIRE(otherDeleted);
+	REQUIRE(cache.getByteSize() == 0);
+}
@@ -0,0 +1,187 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "catch.hpp"
+
+#include "tools/IndexSet.h"
+
+using namespace indexing;
+
+namespace {
+	std::vector<uint64_t> getIndices(const IndexSet & indexSet)
+	{
+		std::vector<uint64_t> result(indexSet.count());
+		if (!result.empty()) {
+			indexSet.getIndices(&result[0]);
+		}
+		return result;
+	}
+}
+
+TEST_CASE("Merge the runs of an index set", "[tools]")
+{
+	IndexSet indexSet;
+	indexSet.addRange(10, 21);
+	indexSet.addRange(30, 41);
+	indexSet.addRange(21, 30);
+	indexSet.addRange(15, 36);
+	indexSet.add(41);
+	indexSet.add(25);
+	REQUIRE(indexSet.count() == 32);
+
+	// Still a single run and not a bitmap of 8KB
+	REQUIRE(indexSet.getByteSize() < 1024);
+	std::vector< std::pair<uint64_t, uint64_t> > ranges;
+	indexSet.getRanges(ranges);
+	REQUIRE(ranges.size() == 1);
+	REQUIRE(ranges[0].first == 10);
+	REQUIRE(ranges[0].second == 42);
+
+	indexSet.addRange(100, 110);
+	indexSet.add(50);
+	REQUIRE(indexSet.count() == 43);
+	REQUIRE(!indexSet.contains(9));
+	REQUIRE(indexSet.contains(10));
+	REQUIRE(indexSet.contains(41));
+	REQUIRE(!indexSet.contains(42));
+	REQUIRE(indexSet.contains(50));
+	REQUIRE(indexSet.contains(109));
+	REQUIRE(!indexSet.contains(110));
+	indexSet.getRanges(ranges);
+	REQUIRE(ranges.size() == 3);
+	REQUIRE(ranges[1].first == 50);
+	REQUIRE(ranges[1].second == 51);
+	REQUIRE(ranges[2].first == 100);
+}
+
+TEST_CASE("Fill and optimize bitmap containers of an index set", "[tools]")
+{
+	// Every third index : more than 4096 values in a chunk make a bitmap
+	IndexSet indexSet;
+	for (uint64_t index = 0; index < 15000; index += 3) {
+		indexSet.add(index);
+	}
+	REQUIRE(indexSet.count() == 5000);
+	REQUIRE(indexSet.getByteSize() >= 8192);
+	REQUIRE(indexSet.contains(14997));
+	REQUIRE(!indexSet.contains(14998));
+
+	// Neither an array nor runs are smaller
+	indexSet.optimize();
+	REQUIRE(indexSet.count() == 5000);
+	REQUIRE(indexSet.getByteSize() >= 8192);
+	std::vector<uint64_t> indices = getIndices(indexSet);
+	for (size_t i = 0; i < indices.size(); ++i) {
+		REQUIRE(indices[i] == i * 3);
+	}
+
+	// Consecutive additions end in a bitmap which is optimized as a single run
+	IndexSet denseSet;
+	for (uint64_t index = 0; index < 5000; ++index) {
+		denseSet.add(index);
+	}
+	REQUIRE(denseSet.getByteSize() >= 8192);
+	denseSet.optimize();
+	REQUIRE(denseSet.count() == 5000);
+	REQUIRE(denseSet.getByteSize() < 1024);
+	std::vector< std::pair<uint64_t, uint64_t> > ranges;
+	denseSet.getRanges(ranges);
+	REQUIRE(ranges.size() == 1);
+	REQUIRE(ranges[0].first == 0);
+	REQUIRE(ranges[0].second == 5000);
+
+	// An intersection optimizes a small bitmap as an array
+	IndexSet range;
+	range.addRange(0, 100);
+	indexSet &= range;
+	REQUIRE(indexSet.count() == 34);
+	REQUIRE(indexSet.getByteSize() < 1024);
+	REQUIRE(indexSet.contains(99));
+	REQUIRE(!indexSet.contains(100));
+}
+
+TEST_CASE("Unite index sets", "[tools]")
+{
+	IndexSet indexSet;
+	indexSet.addRange(0, 10);
+	IndexSet other;
+	other.addRange(5, 20);
+	other.add(70000);
+	indexSet |= other;
+	REQUIRE(indexSet.count() == 21);
+	std::vector< std::pair<uint64_t, uint64_t> > ranges;
+	indexSet.getRanges(ranges);
+	REQUIRE(ranges.size() == 2);
+	REQUIRE(ranges[0].first == 0);
+	REQUIRE(ranges[0].second == 20);
+	REQUIRE(ranges[1].first == 70000);
+	REQUIRE(ranges[1].second == 70001);
+
+	// Array with bitmap
+	IndexSet bitmapSet;
+	for (uint64_t index = 1; index < 10000; index += 2) {
+		bitmapSet.add(index);
+	}
+	indexSet |= bitmapSet;
+	REQUIRE(indexSet.count() == 5000 + 10 + 1);
+	REQUIRE(indexSet.contains(0));
+	REQUIRE(indexSet.contains(2));
+	REQUIRE(!indexSet.contains(20));
+	REQUIRE(indexSet.contains(21));
+	REQUIRE(indexSet.contains(70000));
+
+	// Uniting with an empty set changes nothing
+	indexSet |= IndexSet();
+	REQUIRE(indexSet.count() == 5011);
+}
+
+TEST_CASE("Iterate over the containers of an index set", "[tools]")
+{
+	// An array turned into a bitmap by a range which ends on the last bit of its chunk, a run container and an array container
+	IndexSet indexSet;
+	indexSet.add(1);
+	indexSet.add(3);
+	indexSet.addRange(65534, 65538);
+	indexSet.add(5 * 65536 + 7);
+	const uint64_t expected[7] = { 1, 3, 65534, 65535, 65536, 65537, 5 * 65536 + 7 };
+	REQUIRE(indexSet.count() == 7);
+
+	size_t i = 0;
+	for (IndexSet::const_iterator it = indexSet.begin(); it != indexSet.end(); ++it) {
+		REQUIRE(i < 7);
+		REQUIRE(*it == expected[i]);
+		++i;
+	}
+	REQUIRE(i == 7);
+
+	std::vector<uint64_t> indices = getIndices(indexSet);
+	for (i = 0; i < 7; ++i) {
+		REQUIRE(indices[i] == expected[i]);
+	}
+
+	// The range across both chunks is reported once
+	std::vector< std::pair<uint64_t, uint64_t> > ranges;
+	indexSet.getRanges(ranges);
+	REQUIRE(ranges.size() == 4);
+	REQUIRE(ranges[2].first == 65534);
+	REQUIRE(ranges[2].second == 65538);
+	REQUIRE(ranges[3].first == 5 * 65536 + 7);
+
+	const IndexSet emptySet;
+	REQUIRE(emptySet.begin() == emptySet.end());
+}
@@ -0,0 +1,68 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "catch.hpp"
+
+#include <stdexcept>
+
+#include "tools/Parallel.h"
+
+using namespace parallel;
+
+TEST_CASE("Split items into chunks", "[tools]")
+{
+	setMaxThreadCount(4);
+	REQUIRE(getMaxThreadCount() == 4);
+	REQUIRE(getChunkCount(0, 10) == 1);
+	REQUIRE(getChunkCount(25, 10) == 2);
+	REQUIRE(getChunkCount(1000, 10) == 4);
+	setMinItemCountPerThread(1);
+	REQUIRE(getChunkCount(3, 10) == 3);
+	setMinItemCountPerThread(0);
+	setMaxThreadCount(0);
+	REQUIRE(getMaxThreadCount() >= 1);
+
+	// The chunks are contiguous, balanced and cover all the items.
+	REQUIRE(getChunkBegin(10, 3, 0) == 0);
+	REQUIRE(getChunkBegin(10, 3, 1) == 3);
+	REQUIRE(getChunkBegin(10, 3, 2) == 6);
+	REQUIRE(getChunkBegin(10, 3, 3) == 10);
+}
+
+TEST_CASE("Process chunks in several threads", "[tools]")
+{
+	std::vector<uint64_t> values(1001, 0);
+	std::vector<uint64_t> chunkSums(4, 0);
+	forEachChunk(values.size(), 4, [&](const unsigned int & chunkIndex, const uint64_t & begin, const uint64_t & end) {
+		for (uint64_t i = begin; i < end; ++i) {
+			values[i] = i;
+			chunkSums[chunkIndex] += i;
+		}
+	});
+	for (uint64_t i = 0; i < values.size(); ++i) {
+		REQUIRE(values[i] == i);
+	}
+	REQUIRE(chunkSums[0] + chunkSums[1] + chunkSums[2] + chunkSums[3] == 1000 * 1001 / 2);
+
+	// An exception thrown in a thread is rethrown in the calling thread once all chunks are done.
+	REQUIRE_THROWS_AS(forEachChunk(100, 4, [](const unsigned int & chunkIndex, const uint64_t &, const uint64_t &) {
+		if (chunkIndex == 2) {
+			throw std::range_error("Chunk failure");
+		}
+	}), std::range_error);
+}
@@ -0,0 +1,141 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "catch.hpp"
+
+#include "tools/Statistics.h"
+
+using namespace statistics;
+
+TEST_CASE("Accumulate double values with an histogram", "[tools]")
+{
+	const double values[8] = { -5, 0, 1, 2.5, std::numeric_limits<double>::quiet_NaN(), 9.99, 10, 42 };
+	Accumulator<double> accumulator;
+	accumulator.setHistogram(0, 10, 4);
+	accumulator.add(values, 8);
+	REQUIRE(accumulator.getValidCount() == 7);
+	REQUIRE(accumulator.getMinimum() == -5);
+	REQUIRE(accumulator.getMaximum() == 42);
+
+	// The values out of [0, 10] are clamped into the first or the last bin. A value on a bin boundary is in the upper bin.
+	const std::vector<uint64_t> & histogram = accumulator.getHistogram();
+	REQUIRE(histogram.size() == 4);
+	REQUIRE(histogram[0] == 3);
+	REQUIRE(histogram[1] == 1);
+	REQUIRE(histogram[2] == 0);
+	REQUIRE(histogram[3] == 3);
+
+	REQUIRE_THROWS_AS(accumulator.setHistogram(0, 10, 4), std::logic_error);
+	Accumulator<double> invalidAccumulator;
+	REQUIRE_THROWS_AS(invalidAccumulator.setHistogram(0, 10, 0), std::invalid_argument);
+	REQUIRE_THROWS_AS(invalidAccumulator.setHistogram(10, 10, 4), std::invalid_argument);
+}
+
+TEST_CASE("Merge accumulators", "[tools]")
+{
+	const double values[6] = { 1, 2, 3, 4, 5, 6 };
+	Accumulator<double> first(-1);
+	first.setHistogram(0, 6, 3);
+	first.add(values, 3);
+	Accumulator<double> second(-1);
+	second.setHistogram(0, 6, 3);
+	second.add(values + 3, 3);
+	Accumulator<double> empty(-1);
+	empty.setHistogram(0, 6, 3);
+	REQUIRE(empty.getMinimum() == -1);
+	REQUIRE(empty.getMean() != empty.getMean());
+	REQUIRE(empty.getVariance() != empty.getVariance());
+
+	first.merge(second);
+	first.merge(empty);
+	REQUIRE(first.getValidCount() == 6);
+	REQUIRE(first.getMinimum() == 1);
+	REQUIRE(first.getMaximum() == 6);
+	REQUIRE(first.getSum() == 21);
+	REQUIRE(first.getSumOfSquares() == 91);
+	REQUIRE(first.getMean() == Approx(3.5));
+	REQUIRE(first.getVariance() == Approx(35.0 / 12.0));
+	REQUIRE(first.getHistogram()[0] == 1);
+	REQUIRE(first.getHistogram()[1] == 2);
+	REQUIRE(first.getHistogram()[2] == 3);
+
+	// A constant array has no variance, whatever the rounding errors are.
+	const double constantValues[3] = { 0.1, 0.1, 0.1 };
+	Accumulator<double> constant;
+	constant.add(constantValues, 3);
+	REQUIRE(constant.getVariance() >= 0);
+	REQUIRE(constant.getVariance() == Approx(0).margin(1e-15));
+
+	Accumulator<double> withoutHistogram(-1);
+	REQUIRE_THROWS_AS(first.merge(withoutHistogram), std::invalid_argument);
+}
+
+TEST_CASE("Accumulate a component of vectorial values", "[tools]")
+{
+	// Three components per element : only the first one is accumulated
+	const float values[9] = { 1, 100, 1000, 2, 200, 2000, std::numeric_limits<float>::quiet_NaN(), 300, 3000 };
+	Accumulator<float> accumulator;
+	accumulator.add(values, 9, 3);
+	REQUIRE(accumulator.getValidCount() == 2);
+	REQUIRE(accumulator.getMinimum() == 1);
+	REQUIRE(accumulator.getMaximum() == 2);
+	REQUIRE(accumulator.getSum() == 3);
+
+	// The second component, with an histogram
+	Accumulator<float> secondComponent;
+	secondComponent.setHistogram(0, 400, 2);
+	secondComponent.add(values + 1, 8, 3);
+	REQUIRE(secondComponent.getValidCount() == 3);
+	REQUIRE(secondComponent.getMaximum() == 300);
+	REQUIRE(secondComponent.getHistogram()[0] == 1);
+	REQUIRE(secondComponent.getHistogram()[1] == 2);
+
+	REQUIRE_THROWS_AS(accumulator.add(values, 9, 0), std::invalid_argument);
+}
+
+TEST_CASE("Accumulate integer values with the default null value", "[tools]")
+{
+	const long maxValue = (std::numeric_limits<long>::max)();
+	const long values[5] = { maxValue, -3, 7, maxValue, 0 };
+	Accumulator<long> accumulator;
+	accumulator.add(values, 5);
+	REQUIRE(accumulator.getValidCount() == 3);
+	REQUIRE(accumulator.getMinimum() == -3);
+	REQUIRE(accumulator.getMaximum() == 7);
+	REQUIRE(accumulator.getSum() == 4);
+
+	// Without any valid value, the minimum and the maximum are the null value.
+	Accumulator<long> nullAccumulator;
+	nullAccumulator.add(values, 1);
+	REQUIRE(nullAccumulator.getValidCount() == 0);
+	REQUIRE(nullAccumulator.getMinimum() == maxValue);
+	REQUIRE(nullAccumulator.getMaximum() == maxValue);
+
+	// An explicit null value makes the maximum of the type a valid value.
+	Accumulator<unsigned char> ucharAccumulator(0);
+	const unsigned char ucharValues[4] = { 0, 255, 3, 0 };
+	ucharAccumulator.add(ucharValues, 4);
+	REQUIRE(ucharAccumulator.getValidCount() == 2);
+	REQUIRE(ucharAccumulator.getMinimum() == 3);
+	REQUIRE(ucharAccumulator.getMaximum() == 255);
+
+	const std::pair<long, long> minMax = getMinMax(values, maxValue, 5);
+	REQUIRE(minMax.first == -3);
+	REQUIRE(minMax.second == 7);
+	REQUIRE_THROWS_AS(getMinMax(values, maxValue, 0), std::invalid_argument);
+}
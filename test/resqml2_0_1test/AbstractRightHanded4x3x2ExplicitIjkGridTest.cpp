@@ -0,0 +1,53 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/AbstractRightHanded4x3x2ExplicitIjkGridTest.h"
+
+#include "catch.hpp"
+#include "resqml2_0_1test/RightHanded4x3x2ExplicitIjkGrid.h"
+
+#include "common/EpcDocument.h"
+#include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+
+using namespace std;
+using namespace COMMON_NS;
+using namespace resqml2_0_1test;
+
+AbstractRightHanded4x3x2ExplicitIjkGridTest::AbstractRightHanded4x3x2ExplicitIjkGridTest(const string & epcDocPath, const string & uuid, const string & title)
+	: AbstractResqmlDataObjectTest(epcDocPath, uuid, title) {
+}
+
+void AbstractRightHanded4x3x2ExplicitIjkGridTest::initEpcDocHandler() {
+	// creation of the grid
+	RightHanded4x3x2ExplicitIjkGrid* gridTest = new RightHanded4x3x2ExplicitIjkGrid(this->epcDoc, true);
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridExplicitRepresentation>(RightHanded4x3x2ExplicitIjkGrid::defaultUuid);
+	REQUIRE(ijkGrid != nullptr);
+
+	initFeature(ijkGrid, this->epcDoc->getHdfProxySet()[0]);
+
+	// cleaning
+	delete gridTest;
+}
+
+void AbstractRightHanded4x3x2ExplicitIjkGridTest::readEpcDocHandler() {
+	// the grid itself is checked by its own test
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridExplicitRepresentation>(RightHanded4x3x2ExplicitIjkGrid::defaultUuid);
+	REQUIRE(ijkGrid != nullptr);
+
+	readFeature(ijkGrid);
+}
@@ -0,0 +1,60 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#pragma once
+
+#include "AbstractResqmlDataObjectTest.h"
+
+namespace COMMON_NS {
+	class AbstractHdfProxy;
+}
+
+namespace RESQML2_0_1_NS {
+	class IjkGridExplicitRepresentation;
+}
+
+namespace resqml2_0_1test {
+	/**
+	 * Base abstract class for testing a feature on the 4*3*2 explicit right handed ijk grid (see RightHanded4x3x2ExplicitIjkGrid).
+	 * The grid, its grid connection set and its properties are built by this class : child classes only create and check the objects of their feature.
+	 */
+	class AbstractRightHanded4x3x2ExplicitIjkGridTest : public AbstractResqmlDataObjectTest {
+	public:
+		/**
+		 * Creation of a testing object from an EPC document path. At serialize() call,
+		 * exising .epc file will be erased.
+		 * @param epcDocPath the path of the .epc file (including .epc extension)
+		 * @param uuid the uuid of the Resqml top level object to test
+		 * @param title the title of the Resqml top level object to test
+		 */
+		AbstractRightHanded4x3x2ExplicitIjkGridTest(const std::string & epcDocPath, const std::string & uuid, const std::string & title);
+	protected:
+		void initEpcDocHandler();
+		void readEpcDocHandler();
+
+		/**
+		 * Create the objects of the tested feature once the grid is built.
+		 */
+		virtual void initFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid, COMMON_NS::AbstractHdfProxy* hdfProxy) = 0;
+
+		/**
+		 * Check the objects of the tested feature once they are read back.
+		 */
+		virtual void readFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid) = 0;
+	};
+}
@@ -18,6 +18,8 @@ under the License.
 -----------------------------------------------------------------------*/
 #include "resqml2_0_1test/BigIjkGridExplicitRepresentationTest.h"
 
+#include <limits>
+
 #include "catch.hpp"
 #include "resqml2_0_1test/LocalDepth3dCrsTest.h"
 
@@ -26,17 +28,86 @@ under the License.
 #include "resqml2_0_1/DiscreteProperty.h"
 #include "resqml2_0_1/ContinuousProperty.h"
 
+#include "tools/Parallel.h"
+
 using namespace std;
 using namespace COMMON_NS;
 using namespace resqml2_0_1test;
 using namespace RESQML2_NS;
 
+namespace {
+	// Gives the points of the test grid one K interface after the other.
+	class LayerCopyGenerator : public RESQML2_0_1_NS::IjkGridExplicitRepresentation::PointLayerGenerator
+	{
+	public:
+		LayerCopyGenerator(const double * allPoints, const ULONG64 & layerPointCount) : allPoints(allPoints), layerPointCount(layerPointCount) {}
+
+		void generateLayer(const unsigned int & kInterfaceIndex, double * points) {
+			const double * layerStart = allPoints + kInterfaceIndex * layerPointCount * 3;
+			for (ULONG64 i = 0; i < layerPointCount * 3; ++i) {
+				points[i] = layerStart[i];
+			}
+		}
+
+	private:
+		const double * allPoints;
+		ULONG64 layerPointCount;
+	};
+
+	// Gives the points of the test grid one row of pillars (and of their split coordinate lines) after the other.
+	class ISlabCopyGenerator : public RESQML2_0_1_NS::IjkGridExplicitRepresentation::PointISlabGenerator
+	{
+	public:
+		ISlabCopyGenerator(const double * allPoints, const unsigned int & iPillarCount, const unsigned int & jPillarCount, const unsigned int & kInterfaceCount,
+			const unsigned int & splitCoordinateLineCount, const unsigned int * pillarOfCoordinateLine) :
+			allPoints(allPoints), iPillarCount(iPillarCount), kInterfaceCount(kInterfaceCount),
+			layerPointCount(iPillarCount * jPillarCount + splitCoordinateLineCount), pillarCount(iPillarCount * jPillarCount),
+			splitCoordinateLineCount(splitCoordinateLineCount), pillarOfCoordinateLine(pillarOfCoordinateLine) {}
+
+		void generateISlab(const unsigned int & jPillarIndex, double * pillarPoints, double * splitCoordinateLinePoints) {
+			std::vector<unsigned int> splitCoordinateLinesOfSlab;
+			for (unsigned int splitIndex = 0; splitIndex < splitCoordinateLineCount; ++splitIndex) {
+				if (pillarOfCoordinateLine[splitIndex] / iPillarCount == jPillarIndex) {
+					splitCoordinateLinesOfSlab.push_back(splitIndex);
+				}
+			}
+			for (unsigned int k = 0; k < kInterfaceCount; ++k) {
+				for (unsigned int i = 0; i < iPillarCount; ++i) {
+					copyPoint(k * layerPointCount + jPillarIndex * iPillarCount + i, pillarPoints + (k * iPillarCount + i) * 3);
+				}
+				for (size_t slabSplitIndex = 0; slabSplitIndex < splitCoordinateLinesOfSlab.size(); ++slabSplitIndex) {
+					copyPoint(k * layerPointCount + pillarCount + splitCoordinateLinesOfSlab[slabSplitIndex], splitCoordinateLinePoints + (k * splitCoordinateLinesOfSlab.size() + slabSplitIndex) * 3);
+				}
+			}
+		}
+
+	private:
+		void copyPoint(const ULONG64 & pointIndex, double * point) const {
+			point[0] = allPoints[pointIndex * 3];
+			point[1] = allPoints[pointIndex * 3 + 1];
+			point[2] = allPoints[pointIndex * 3 + 2];
+		}
+
+		const double * allPoints;
+		unsigned int iPillarCount;
+		unsigned int kInterfaceCount;
+		ULONG64 layerPointCount;
+		ULONG64 pillarCount;
+		unsigned int splitCoordinateLineCount;
+		const unsigned int * pillarOfCoordinateLine;
+	};
+}
+
 const char* BigIjkGridExplicitRepresentationTest::defaultUuid = "f889e5d2-249e-4827-8532-ce60a1d05b99";
 const char* BigIjkGridExplicitRepresentationTest::defaultTitle = "Ijk Grid Explicit Representation";
 const char* BigIjkGridExplicitRepresentationTest::discretePropertyUuid = "265343eb-6d1b-4015-b08b-8b4abbe7f84b";
 const char* BigIjkGridExplicitRepresentationTest::discretePropertyTitle = "Explicit IJK Grid K Index";
 const char* BigIjkGridExplicitRepresentationTest::continuousPropertyUuid = "a4e8e307-0844-47e9-b9fd-6ad0a1f99b88";
 const char* BigIjkGridExplicitRepresentationTest::continuousPropertyTitle = "Explicit IJK Grid Continuous Property";
+const char* BigIjkGridExplicitRepresentationTest::summarizedPropertyUuid = "b5d2c9e4-6a1f-4c8e-8e37-0f4a9d21c6b3";
+const char* BigIjkGridExplicitRepresentationTest::summarizedPropertyTitle = "Explicit IJK Grid Summarized Continuous Property";
+const char* BigIjkGridExplicitRepresentationTest::iSlabGridUuid = "3c0b7a0e-5d4f-4f3c-9a51-7e2d8c6b1f40";
+const char* BigIjkGridExplicitRepresentationTest::iSlabGridTitle = "Ijk Grid Explicit Representation By I Slab";
 
 BigIjkGridExplicitRepresentationTest::BigIjkGridExplicitRepresentationTest(
 	const string & epcDocPath,
@@ -70,9 +141,21 @@ void BigIjkGridExplicitRepresentationTest::initEpcDocHandler() {
 	unsigned int * splitCoordinateLineColumnCumulativeCount = new unsigned int[faultCount * (jCount + 1)];
 	unsigned int * splitCoordinateLineColumns = new unsigned int[(faultCount * (jCount + 1)) + (faultCount * (jCount - 1))];
 	initSplitCoordinateLine(pillarOfCoordinateLine, splitCoordinateLineColumnCumulativeCount, splitCoordinateLineColumns);
-	ijkGrid->setGeometryAsCoordinateLineNodes(gsoap_resqml2_0_1::resqml2__PillarShape__vertical, gsoap_resqml2_0_1::resqml2__KDirection__down, false, this->xyzPointsOfAllPatchesInGlobalCrs, hdfProxy,
+	// the K interfaces are generated by several threads
+	parallel::setMaxThreadCount(4);
+	parallel::setMinItemCountPerThread(1);
+	LayerCopyGenerator generator(this->xyzPointsOfAllPatchesInGlobalCrs, (iCount + 1) * (jCount + 1) + faultCount * (jCount + 1));
+	ijkGrid->setGeometryAsCoordinateLineNodesByLayer(gsoap_resqml2_0_1::resqml2__PillarShape__vertical, gsoap_resqml2_0_1::resqml2__KDirection__down, false, &generator, hdfProxy,
 		faultCount * (jCount + 1), pillarOfCoordinateLine, splitCoordinateLineColumnCumulativeCount, splitCoordinateLineColumns);
 
+	// the same grid generated by I slab
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* iSlabIjkGrid = this->epcDoc->createIjkGridExplicitRepresentation(crs, iSlabGridUuid, iSlabGridTitle, iCount, jCount, kCount);
+	ISlabCopyGenerator iSlabGenerator(this->xyzPointsOfAllPatchesInGlobalCrs, iCount + 1, jCount + 1, kCount + 1, faultCount * (jCount + 1), pillarOfCoordinateLine);
+	iSlabIjkGrid->setGeometryAsCoordinateLineNodesByISlab(gsoap_resqml2_0_1::resqml2__PillarShape__vertical, gsoap_resqml2_0_1::resqml2__KDirection__down, false, &iSlabGenerator, hdfProxy,
+		faultCount * (jCount + 1), pillarOfCoordinateLine, splitCoordinateLineColumnCumulativeCount, splitCoordinateLineColumns);
+	parallel::setMaxThreadCount(0);
+	parallel::setMinItemCountPerThread(0);
+
 	// adding a discrete property
 	RESQML2_0_1_NS::DiscreteProperty* discreteProperty = this->epcDoc->createDiscreteProperty(
 		ijkGrid, discretePropertyUuid, discretePropertyTitle,
@@ -81,6 +164,7 @@ void BigIjkGridExplicitRepresentationTest::initEpcDocHandler() {
 		gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__index);
 	unsigned short * discretePropertyValues = new unsigned short[iCount * jCount * kCount];
 	initDiscreteProperty(discretePropertyValues);
+	discreteProperty->enableChunkSummaries();
 	discreteProperty->pushBackUShortHdf5Array3dOfValues(discretePropertyValues, iCount, jCount, kCount, hdfProxy, -1);
 
 	// adding a continuous property
@@ -94,6 +178,23 @@ void BigIjkGridExplicitRepresentationTest::initEpcDocHandler() {
 	initContinuousProperty(continuousPropertyValues);
 	continuousProperty->pushBackDoubleHdf5Array1dOfValues(continuousPropertyValues, iCount * jCount * kCount, hdfProxy);
 
+	// adding a continuous property with chunk summaries whose statistics are computed by several threads
+	RESQML2_0_1_NS::ContinuousProperty* summarizedProperty = this->epcDoc->createContinuousProperty(
+		ijkGrid, summarizedPropertyUuid, summarizedPropertyTitle,
+		1,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__cells,
+		gsoap_resqml2_0_1::resqml2__ResqmlUom__m,
+		gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__length);
+	for (unsigned int cell = 0; cell < iCount * jCount; ++cell) {
+		continuousPropertyValues[cell] = std::numeric_limits<double>::quiet_NaN();
+	}
+	summarizedProperty->enableChunkSummaries();
+	parallel::setMaxThreadCount(4);
+	parallel::setMinItemCountPerThread(1);
+	summarizedProperty->pushBackDoubleHdf5Array3dOfValues(continuousPropertyValues, iCount, jCount, kCount, hdfProxy);
+	parallel::setMaxThreadCount(0);
+	parallel::setMinItemCountPerThread(0);
+
 	// cleaning
 	delete crsTest;
 	delete[] pillarOfCoordinateLine;
@@ -104,5 +205,132 @@ void BigIjkGridExplicitRepresentationTest::initEpcDocHandler() {
 }
 
 void BigIjkGridExplicitRepresentationTest::readEpcDocHandler() {
+	// the grids generated by K interface and by I slab have the same points
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* layerIjkGrid = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridExplicitRepresentation>(uuid);
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* iSlabIjkGrid = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridExplicitRepresentation>(iSlabGridUuid);
+	REQUIRE(iSlabIjkGrid != nullptr);
+	REQUIRE(iSlabIjkGrid->getXyzPointCountOfPatch(0) == layerIjkGrid->getXyzPointCountOfPatch(0));
+	std::vector<double> layerPoints(layerIjkGrid->getXyzPointCountOfPatch(0) * 3);
+	layerIjkGrid->getXyzPointsOfPatch(0, &layerPoints[0]);
+	std::vector<double> iSlabPoints(iSlabIjkGrid->getXyzPointCountOfPatch(0) * 3);
+	iSlabIjkGrid->getXyzPointsOfPatch(0, &iSlabPoints[0]);
+	for (size_t index = 0; index < layerPoints.size(); ++index) {
+		REQUIRE(iSlabPoints[index] == layerPoints[index]);
+	}
+
+	RESQML2_0_1_NS::DiscreteProperty* discreteProperty = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::DiscreteProperty>(discretePropertyUuid);
+	REQUIRE(discreteProperty != nullptr);
+
+	// chunk summaries : one per K layer
+	REQUIRE(discreteProperty->hasChunkSummaryOfPatch(0));
+	std::vector<double> minimums;
+	std::vector<double> maximums;
+	std::vector<ULONG64> validCounts;
+	REQUIRE(discreteProperty->getChunkSummaryOfPatch(0, minimums, maximums, validCounts) == iCount * jCount);
+	REQUIRE(validCounts.size() == kCount);
+	REQUIRE(minimums[1] == 1);
+	REQUIRE(maximums[1] == 1);
+	REQUIRE(validCounts[1] == iCount * jCount);
+
+	// range query
+	indexing::IndexSet selectedCells;
+	discreteProperty->selectElementIndicesOfPatch(0, 1.5, 3, selectedCells);
+	REQUIRE(selectedCells.count() == 2 * iCount * jCount);
+	REQUIRE(selectedCells.contains(2 * iCount * jCount));
+	REQUIRE_FALSE(selectedCells.contains(2 * iCount * jCount - 1));
+	REQUIRE_FALSE(selectedCells.contains(4 * iCount * jCount));
+
+	// the continuous property has no chunk summary
+	RESQML2_0_1_NS::ContinuousProperty* continuousProperty = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(continuousPropertyUuid);
+	REQUIRE_FALSE(continuousProperty->hasChunkSummaryOfPatch(0));
+
+	// the summarized property has NaN values on the first K layer only
+	RESQML2_0_1_NS::ContinuousProperty* summarizedProperty = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(summarizedPropertyUuid);
+	REQUIRE(summarizedProperty->getMinimumValue() == 0);
+	REQUIRE(summarizedProperty->getMaximumValue() == 1);
+	REQUIRE(summarizedProperty->getChunkSummaryOfPatch(0, minimums, maximums, validCounts) == iCount * jCount);
+	REQUIRE(validCounts.size() == kCount);
+	REQUIRE(validCounts[0] == 0);
+	for (unsigned int k = 1; k < kCount; ++k) {
+		REQUIRE(minimums[k] == 0);
+		REQUIRE(maximums[k] == 1);
+		REQUIRE(validCounts[k] == iCount * jCount);
+	}
+
+	// multi property query : K index in [1, 3] and continuous value (I gradient from 0 to 1) in [0, 0.5]
+	std::vector<const AbstractValuesProperty*> properties;
+	properties.push_back(discreteProperty);
+	properties.push_back(continuousProperty);
+	std::vector<double> minimumValues;
+	minimumValues.push_back(1);
+	minimumValues.push_back(0);
+	std::vector<double> maximumValues;
+	maximumValues.push_back(3);
+	maximumValues.push_back(0.5);
+	selectedCells.clear();
+	AbstractValuesProperty::selectElementIndicesOfPatch(properties, minimumValues, maximumValues, 0, selectedCells);
+	REQUIRE(selectedCells.count() == 3 * jCount * 5);
+	REQUIRE(selectedCells.contains(iCount * jCount + 4));
+	REQUIRE_FALSE(selectedCells.contains(iCount * jCount + 5));
+
+	// same query where the chunks are evaluated by several threads
+	parallel::setMaxThreadCount(4);
+	parallel::setMinItemCountPerThread(1);
+	indexing::IndexSet threadedSelectedCells;
+	AbstractValuesProperty::selectElementIndicesOfPatch(properties, minimumValues, maximumValues, 0, threadedSelectedCells);
+	parallel::setMaxThreadCount(0);
+	parallel::setMinItemCountPerThread(0);
+	std::vector< std::pair<uint64_t, uint64_t> > ranges;
+	selectedCells.getRanges(ranges);
+	std::vector< std::pair<uint64_t, uint64_t> > threadedRanges;
+	threadedSelectedCells.getRanges(threadedRanges);
+	REQUIRE(threadedRanges == ranges);
+
+	// block cell geometry : the specialized kernels must give the same points as the generic per corner path
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridExplicitRepresentation>(uuid);
+	REQUIRE(ijkGrid->hasArithmeticNodeIndexing() == (faultCount == 0));
+	if (faultCount > 0) {
+		ijkGrid->loadSplitInformation();
+	}
+	ijkGrid->loadBlockInformation(0, iCount, 0, jCount, 0, kCount);
+	const ULONG64 cellCount = ijkGrid->getCellCountOfBlock();
+	REQUIRE(cellCount == iCount * jCount * kCount);
+	std::vector<double> xyzPoints(ijkGrid->getXyzPointCountOfBlock() * 3);
+	ijkGrid->getXyzPointsOfBlockOfPatch(0, &xyzPoints[0]);
+	std::vector<ULONG64> cornerPointIndices(cellCount * 8);
+	ijkGrid->getXyzPointIndicesOfBlockCellCorners(&cornerPointIndices[0]);
+	std::vector<double> cellCenters(cellCount * 3);
+	ijkGrid->getCellCentersOfBlock(&xyzPoints[0], &cellCenters[0]);
+
+	// the generic path always walks through the split information
+	if (faultCount == 0) {
+		ijkGrid->loadSplitInformation();
+	}
+	ULONG64 cellIndex = 0;
+	for (unsigned int k = 0; k < kCount; ++k) {
+		for (unsigned int j = 0; j < jCount; ++j) {
+			for (unsigned int i = 0; i < iCount; ++i) {
+				double center[3] = { .0, .0, .0 };
+				for (unsigned int corner = 0; corner < 8; ++corner) {
+					double x, y, z;
+					ijkGrid->getXyzPointOfBlockFromCellCorner(i, j, k, corner, &xyzPoints[0], x, y, z);
+					const ULONG64 pointIndex = cornerPointIndices[cellIndex * 8 + corner];
+					REQUIRE(pointIndex == ijkGrid->getXyzPointIndexFromCellCorner(i, j, k, corner));
+					REQUIRE(x == xyzPoints[3 * pointIndex]);
+					REQUIRE(y == xyzPoints[3 * pointIndex + 1]);
+					REQUIRE(z == xyzPoints[3 * pointIndex + 2]);
+					REQUIRE(z == nodesIjkGridRepresentation[3 * pointIndex + 2]);
+					center[0] += x;
+					center[1] += y;
+					center[2] += z;
+				}
+				REQUIRE(cellCenters[cellIndex * 3] == Approx(center[0] / 8));
+				REQUIRE(cellCenters[cellIndex * 3 + 1] == Approx(center[1] / 8));
+				REQUIRE(cellCenters[cellIndex * 3 + 2] == Approx(center[2] / 8));
+				++cellIndex;
+			}
+		}
+	}
+	ijkGrid->unloadSplitInformation();
 }
 
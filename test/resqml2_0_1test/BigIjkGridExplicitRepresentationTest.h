@@ -34,6 +34,10 @@ namespace resqml2_0_1test {
 		static const char* discretePropertyTitle;
 		static const char* continuousPropertyUuid;
 		static const char* continuousPropertyTitle;
+		static const char* summarizedPropertyUuid;
+		static const char* summarizedPropertyTitle;
+		static const char* iSlabGridUuid;
+		static const char* iSlabGridTitle;
 	
 		/**
 		* Creation of an explicit IJK grid representation from an EPC document path. Resulting grid is 
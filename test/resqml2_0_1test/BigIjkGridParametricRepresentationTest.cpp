@@ -26,11 +26,33 @@ under the License.
 #include "resqml2_0_1/DiscreteProperty.h"
 #include "resqml2_0_1/ContinuousProperty.h"
 
+#include "tools/Parallel.h"
+
 using namespace std;
 using namespace COMMON_NS;
 using namespace resqml2_0_1test;
 using namespace RESQML2_NS;
 
+namespace {
+	// Gives the parameters of the test grid one K interface after the other.
+	class ParameterLayerCopyGenerator : public RESQML2_0_1_NS::IjkGridParametricRepresentation::ParameterLayerGenerator
+	{
+	public:
+		ParameterLayerCopyGenerator(const double * allParameters, const ULONG64 & layerNodeCount) : allParameters(allParameters), layerNodeCount(layerNodeCount) {}
+
+		void generateLayer(const unsigned int & kInterfaceIndex, double * parameters) {
+			const double * layerStart = allParameters + kInterfaceIndex * layerNodeCount;
+			for (ULONG64 i = 0; i < layerNodeCount; ++i) {
+				parameters[i] = layerStart[i];
+			}
+		}
+
+	private:
+		const double * allParameters;
+		ULONG64 layerNodeCount;
+	};
+}
+
 const char* BigIjkGridParametricRepresentationTest::defaultUuid = "d94033f1-188b-465b-9594-c88403f7767e";
 const char* BigIjkGridParametricRepresentationTest::defaultTitle = "Ijk Grid Param Representation";
 const char* BigIjkGridParametricRepresentationTest::discretePropertyUuid = "e3a36173-1d46-4db3-87d0-84e51efce7ed";
@@ -89,8 +111,14 @@ void BigIjkGridParametricRepresentationTest::initEpcDocHandler() {
 	initParametersAndControlPoints(parameters, controlPoints);
 	initSplitCoordinateLine(pillarOfCoordinateLine, splitCoordinateLineColumnCumulativeCount, splitCoordinateLineColumns);
 
-	ijkGrid->setGeometryAsParametricSplittedPillarNodes(gsoap_resqml2_0_1::resqml2__KDirection__down, false, parameters, controlPoints, NULL, 1, 0, hdfProxy,
+	// the parameters are generated by several threads one K interface after the other
+	parallel::setMaxThreadCount(4);
+	parallel::setMinItemCountPerThread(1);
+	ParameterLayerCopyGenerator generator(parameters, (iCount + 1) * (jCount + 1) + faultCount * (jCount + 1));
+	ijkGrid->setGeometryAsParametricSplittedPillarNodesByLayer(false, &generator, controlPoints, NULL, 1, 0, hdfProxy,
 		faultCount * (jCount + 1), pillarOfCoordinateLine, splitCoordinateLineColumnCumulativeCount, splitCoordinateLineColumns);
+	parallel::setMaxThreadCount(0);
+	parallel::setMinItemCountPerThread(0);
 
 	// adding a discrete property
 	RESQML2_0_1_NS::DiscreteProperty* discreteProperty = this->epcDoc->createDiscreteProperty(
@@ -125,5 +153,47 @@ void BigIjkGridParametricRepresentationTest::initEpcDocHandler() {
 }
 
 void BigIjkGridParametricRepresentationTest::readEpcDocHandler() {
+	RESQML2_0_1_NS::IjkGridParametricRepresentation* ijkGrid = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridParametricRepresentation>(uuid);
+	REQUIRE(ijkGrid != nullptr);
+
+	// K interface sequence : pillars are vertical and parameters are the Z values
+	const ULONG64 kInterfacePointCount = ijkGrid->getXyzPointCountOfKInterfaceOfPatch(0);
+	std::vector<double> xyzPoints(ijkGrid->getXyzPointCountOfPatch(0) * 3);
+	ijkGrid->getXyzPointsOfKInterfaceSequenceOfPatch(0, kCount, 0, &xyzPoints[0]);
+	for (ULONG64 index = 0; index < xyzPoints.size(); ++index) {
+		REQUIRE(xyzPoints[index] == Approx(nodesIjkGridRepresentation[index]));
+	}
+	std::vector<double> kInterfacePoints(kInterfacePointCount * 2 * 3);
+	ijkGrid->getXyzPointsOfKInterfaceSequenceOfPatch(1, 2, 0, &kInterfacePoints[0]);
+	for (ULONG64 index = 0; index < kInterfacePoints.size(); ++index) {
+		REQUIRE(kInterfacePoints[index] == xyzPoints[kInterfacePointCount * 3 + index]);
+	}
+
+	// block : only the window of the pillars is read and mapped to XYZ
+	ijkGrid->loadSplitInformation();
+	const unsigned int iStart = iCount / 4;
+	const unsigned int iEnd = iCount - iCount / 4;
+	const unsigned int jStart = 1;
+	const unsigned int jEnd = jCount - 1;
+	const unsigned int kStart = 1;
+	const unsigned int kEnd = kCount - 1;
+	ijkGrid->loadBlockInformation(iStart, iEnd, jStart, jEnd, kStart, kEnd);
+	std::vector<double> blockXyzPoints(ijkGrid->getXyzPointCountOfBlock() * 3);
+	ijkGrid->getXyzPointsOfBlockOfPatch(0, &blockXyzPoints[0]);
+	for (unsigned int k = kStart; k < kEnd; ++k) {
+		for (unsigned int j = jStart; j < jEnd; ++j) {
+			for (unsigned int i = iStart; i < iEnd; ++i) {
+				for (unsigned int corner = 0; corner < 8; ++corner) {
+					double x, y, z;
+					ijkGrid->getXyzPointOfBlockFromCellCorner(i, j, k, corner, &blockXyzPoints[0], x, y, z);
+					const ULONG64 pointIndex = ijkGrid->getXyzPointIndexFromCellCorner(i, j, k, corner);
+					REQUIRE(x == xyzPoints[3 * pointIndex]);
+					REQUIRE(y == xyzPoints[3 * pointIndex + 1]);
+					REQUIRE(z == xyzPoints[3 * pointIndex + 2]);
+				}
+			}
+		}
+	}
+	ijkGrid->unloadSplitInformation();
 }
 
@@ -0,0 +1,111 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/BulkLoadOnRightHanded4x3x2ExplicitIjkGrid.h"
+
+#include <map>
+#include <stdexcept>
+
+#include "catch.hpp"
+
+#include "common/EpcDocument.h"
+#include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+#include "resqml2_0_1/ContinuousProperty.h"
+#include "tools/Parallel.h"
+
+using namespace std;
+using namespace COMMON_NS;
+using namespace RESQML2_NS;
+using namespace resqml2_0_1test;
+
+const char* BulkLoadOnRightHanded4x3x2ExplicitIjkGrid::defaultUuid = "f2e7a9d3-71ed-4d34-a383-007af84ab092";
+const char* BulkLoadOnRightHanded4x3x2ExplicitIjkGrid::defaultTitle = "Cell index and its opposite";
+
+namespace {
+	const char* amplitudeUuid = "de5a71cc-879d-4cda-8fb3-146c70539cf9";
+	const char* cellIndexUuid = "0a8fb2aa-d1e1-4914-931c-e9e6bf2aabe5";
+}
+
+void BulkLoadOnRightHanded4x3x2ExplicitIjkGrid::initFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid, AbstractHdfProxy* hdfProxy) {
+	// vectorial property : two values per cell
+	RESQML2_0_1_NS::ContinuousProperty* vectorialProp = this->epcDoc->createContinuousProperty(ijkGrid, uuid, title, 2,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__cells, gsoap_resqml2_0_1::resqml2__ResqmlUom__Euc, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__index);
+	double vectorialValues[48];
+	for (unsigned int cell = 0; cell < 24; ++cell) {
+		vectorialValues[cell * 2] = cell;
+		vectorialValues[cell * 2 + 1] = -static_cast<double>(cell);
+	}
+	unsigned long long vectorialDims[4] = { 2, 3, 4, 2 };
+	vectorialProp->pushBackDoubleHdf5ArrayOfValues(vectorialValues, vectorialDims, 4, hdfProxy);
+}
+
+void BulkLoadOnRightHanded4x3x2ExplicitIjkGrid::readFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid) {
+	// all the cells
+	std::map<std::string, std::vector<double> > doubleColumns;
+	std::map<std::string, std::vector<long> > longColumns;
+	std::map<std::string, long> longNullValues;
+	ijkGrid->loadValuesPropertySetOfPatch(0, doubleColumns, longColumns, longNullValues);
+	REQUIRE(doubleColumns[amplitudeUuid].size() == 24);
+	REQUIRE(doubleColumns[amplitudeUuid][12] == 1.0);
+	REQUIRE(doubleColumns[uuid].size() == 48);
+	REQUIRE(doubleColumns[uuid][47] == -23);
+	REQUIRE(longColumns[cellIndexUuid].size() == 24);
+	REQUIRE(longColumns[cellIndexUuid][23] == 23);
+	REQUIRE(longNullValues.size() == 1);
+	REQUIRE(longNullValues[cellIndexUuid] == -1);
+
+	// the enabled cells only
+	indexing::BitSet enabledCells;
+	ijkGrid->getEnabledCells(enabledCells);
+	doubleColumns.clear();
+	longColumns.clear();
+	ijkGrid->loadValuesPropertySetOfPatch(0, doubleColumns, longColumns, longNullValues, &enabledCells);
+	REQUIRE(doubleColumns[amplitudeUuid].size() == 22);
+	REQUIRE(doubleColumns[amplitudeUuid][11] == 1.0);
+	REQUIRE(doubleColumns[uuid].size() == 44);
+	REQUIRE(doubleColumns[uuid][22] == 12);
+	REQUIRE(doubleColumns[uuid][23] == -12);
+	REQUIRE(doubleColumns[uuid][43] == -22);
+	REQUIRE(longColumns[cellIndexUuid].size() == 22);
+	REQUIRE(longColumns[cellIndexUuid][21] == 22);
+
+	// same enabled cells when the compaction is shared between threads
+	std::map<std::string, std::vector<double> > threadedDoubleColumns;
+	std::map<std::string, std::vector<long> > threadedLongColumns;
+	parallel::setMaxThreadCount(4);
+	parallel::setMinItemCountPerThread(1);
+	ijkGrid->loadValuesPropertySetOfPatch(0, threadedDoubleColumns, threadedLongColumns, longNullValues, &enabledCells);
+	parallel::setMaxThreadCount(0);
+	parallel::setMinItemCountPerThread(0);
+	REQUIRE(threadedDoubleColumns == doubleColumns);
+	REQUIRE(threadedLongColumns == longColumns);
+
+	// some properties only
+	std::vector<AbstractValuesProperty*> properties;
+	properties.push_back(this->epcDoc->getResqmlAbstractObjectByUuid<AbstractValuesProperty>(uuid));
+	doubleColumns.clear();
+	longColumns.clear();
+	AbstractValuesProperty::loadValuesOfPatch(properties, 0, doubleColumns, longColumns, longNullValues, &enabledCells);
+	REQUIRE(doubleColumns.size() == 1);
+	REQUIRE(longColumns.empty());
+
+	// wrong active elements and patch
+	indexing::BitSet tooFewCells(10, true);
+	REQUIRE_THROWS_AS(AbstractValuesProperty::loadValuesOfPatch(properties, 0, doubleColumns, longColumns, longNullValues, &tooFewCells), invalid_argument);
+	REQUIRE_THROWS_AS(AbstractValuesProperty::loadValuesOfPatch(properties, 1, doubleColumns, longColumns, longNullValues), range_error);
+}
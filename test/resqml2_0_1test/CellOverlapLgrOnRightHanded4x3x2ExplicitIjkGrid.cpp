@@ -0,0 +1,152 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/CellOverlapLgrOnRightHanded4x3x2ExplicitIjkGrid.h"
+
+#include <limits>
+#include <stdexcept>
+
+#include "resqml2_0_1test/AbstractIjkGridRepresentationTest.h"
+#include "resqml2_0_1test/RightHanded4x3x2ExplicitIjkGrid.h"
+#include "resqml2_0_1test/LocalDepth3dCrsTest.h"
+
+#include "catch.hpp"
+#include "common/EpcDocument.h"
+#include "resqml2_0_1/LocalDepth3dCrs.h"
+#include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+#include "resqml2/LocalGridRefinementMapping.h"
+
+using namespace std;
+using namespace resqml2_0_1test;
+using namespace COMMON_NS;
+using namespace RESQML2_NS;
+
+const char* CellOverlapLgrOnRightHanded4x3x2ExplicitIjkGrid::defaultUuid = "ef2e5aea-1f7c-4a22-adf8-96abbd269131";
+const char* CellOverlapLgrOnRightHanded4x3x2ExplicitIjkGrid::defaultTitle = "Cell overlap LGR";
+const ULONG64 CellOverlapLgrOnRightHanded4x3x2ExplicitIjkGrid::nodesCountIjkGridRepresentation = 12;
+double CellOverlapLgrOnRightHanded4x3x2ExplicitIjkGrid::nodesIjkGridRepresentation[] = {
+	0, 50, 300, 50, 50, 300, 100, 50, 300, //IJ0K0
+	0, 0, 300, 50, 0, 300, 100, 0, 300, //IJ1K0
+	0, 50, 350, 50, 50, 350, 100, 50, 350, //IJ0K1
+	0, 0, 350, 50, 0, 350, 100, 0, 350 //IJ1K1
+};
+
+CellOverlapLgrOnRightHanded4x3x2ExplicitIjkGrid::CellOverlapLgrOnRightHanded4x3x2ExplicitIjkGrid(const string & epcDocPath)
+	: AbstractIjkGridRepresentationTest(epcDocPath, defaultUuid, defaultTitle, nodesCountIjkGridRepresentation, nodesIjkGridRepresentation) {
+}
+
+CellOverlapLgrOnRightHanded4x3x2ExplicitIjkGrid::CellOverlapLgrOnRightHanded4x3x2ExplicitIjkGrid(EpcDocument* epcDoc, bool init)
+	: AbstractIjkGridRepresentationTest(epcDoc, defaultUuid, defaultTitle, nodesCountIjkGridRepresentation, nodesIjkGridRepresentation) {
+	if (init) {
+		this->initEpcDoc();
+	}
+	else {
+		this->readEpcDoc();
+	}
+}
+
+void CellOverlapLgrOnRightHanded4x3x2ExplicitIjkGrid::initEpcDocHandler() {
+	// getting the parent grid
+	RightHanded4x3x2ExplicitIjkGrid* parentGridTest = new RightHanded4x3x2ExplicitIjkGrid(this->epcDoc, true);
+
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* parentGrid = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridExplicitRepresentation>(RightHanded4x3x2ExplicitIjkGrid::defaultUuid);
+	RESQML2_0_1_NS::LocalDepth3dCrs* crs = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::LocalDepth3dCrs>(LocalDepth3dCrsTest::defaultUuid);
+
+	// cleaning
+	delete parentGridTest;
+
+	// getting the hdf proxy
+	AbstractHdfProxy* hdfProxy = this->epcDoc->getHdfProxySet()[0];
+
+	// creating the child ijk grid : the explicit cell overlap takes precedence over the regrid of the parent window
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* childGrid = epcDoc->createIjkGridExplicitRepresentation(crs, uuid, title, 2, 1, 1);
+	childGrid->setGeometryAsCoordinateLineNodes(gsoap_resqml2_0_1::resqml2__PillarShape__vertical, gsoap_resqml2_0_1::resqml2__KDirection__down, false, xyzPointsOfAllPatchesInGlobalCrs, hdfProxy);
+	childGrid->setParentWindow(
+		1, 2, 2,
+		1, 1, 1,
+		0, 1, 1,
+		parentGrid);
+	ULONG64 parentChildCellPairs[6] = { 5, 0, 6, 0, 6, 1 };
+	double overlapVolumes[3] = { 100, 50, 150 };
+	childGrid->setCellOverlap(3, parentChildCellPairs, gsoap_resqml2_0_1::eml20__VolumeUom__m3, overlapVolumes);
+}
+
+void CellOverlapLgrOnRightHanded4x3x2ExplicitIjkGrid::readEpcDocHandler() {
+	RightHanded4x3x2ExplicitIjkGrid* parentGridTest = new RightHanded4x3x2ExplicitIjkGrid(this->epcDoc, false);
+
+	// getting the childGrid
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* childGrid = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridExplicitRepresentation>(uuid);
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* parentGrid = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridExplicitRepresentation>(RightHanded4x3x2ExplicitIjkGrid::defaultUuid);
+
+	REQUIRE(childGrid->getCellCount() == 2);
+	REQUIRE(childGrid->getParentGrid() == parentGrid);
+	REQUIRE(childGrid->hasCellOverlap());
+	REQUIRE(childGrid->getCellOverlapCount() == 3);
+	REQUIRE(childGrid->hasCellOverlapVolume());
+
+	// Mapping : the fractions come from the overlap volumes
+	LocalGridRefinementMapping mapping(childGrid);
+	REQUIRE(mapping.getChildCellCount() == 2);
+	REQUIRE(mapping.getParentCellCount() == 24);
+	REQUIRE(mapping.getOverlapCount() == 3);
+	REQUIRE(mapping.isParentCellRefined(5));
+	REQUIRE(mapping.isParentCellRefined(6));
+	REQUIRE(!mapping.isParentCellRefined(4));
+
+	REQUIRE(mapping.getParentCellCountOfChildCell(0) == 2);
+	ULONG64 parentCellIndicesOfChild[2];
+	double childFractions[2];
+	mapping.getParentCellsOfChildCell(0, parentCellIndicesOfChild, childFractions);
+	REQUIRE(parentCellIndicesOfChild[0] == 5);
+	REQUIRE(parentCellIndicesOfChild[1] == 6);
+	REQUIRE(childFractions[0] == Approx(2.0 / 3.0));
+	REQUIRE(childFractions[1] == Approx(1.0 / 3.0));
+
+	REQUIRE(mapping.getChildCellCountOfParentCell(6) == 2);
+	ULONG64 childCellIndicesOfParent[2];
+	double parentFractions[2];
+	mapping.getChildCellsOfParentCell(6, childCellIndicesOfParent, parentFractions);
+	REQUIRE(childCellIndicesOfParent[0] == 0);
+	REQUIRE(childCellIndicesOfParent[1] == 1);
+	REQUIRE(parentFractions[0] == Approx(0.25));
+	REQUIRE(parentFractions[1] == Approx(0.75));
+
+	ULONG64 childCellIndices[2] = { 0, 1 };
+	ULONG64 parentCellIndices[2];
+	mapping.getParentCellIndices(childCellIndices, 2, parentCellIndices);
+	REQUIRE(parentCellIndices[0] == 5);
+	REQUIRE(parentCellIndices[1] == 6);
+
+	double childValues[2] = { 2, 6 };
+	double parentValues[24];
+	for (unsigned int i = 0; i < 24; ++i) {
+		parentValues[i] = -1;
+	}
+	mapping.upscale(childValues, parentValues);
+	REQUIRE(parentValues[5] == Approx(2));
+	REQUIRE(parentValues[6] == Approx(5));
+	REQUIRE(parentValues[4] == -1);
+
+	parentValues[5] = 100;
+	parentValues[6] = 200;
+	mapping.downscale(parentValues, childValues, LocalGridRefinementMapping::EXTENSIVE);
+	REQUIRE(childValues[0] == Approx(150));
+	REQUIRE(childValues[1] == Approx(150));
+
+	delete parentGridTest;
+}
@@ -0,0 +1,154 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/ColumnLayerLgrOnRightHanded4x3x2ExplicitIjkGrid.h"
+
+#include <limits>
+#include <stdexcept>
+
+#include "resqml2_0_1test/AbstractIjkGridRepresentationTest.h"
+#include "resqml2_0_1test/RightHanded4x3x2ExplicitIjkGrid.h"
+#include "resqml2_0_1test/LocalDepth3dCrsTest.h"
+
+#include "catch.hpp"
+#include "common/EpcDocument.h"
+#include "resqml2_0_1/LocalDepth3dCrs.h"
+#include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+#include "resqml2/LocalGridRefinementMapping.h"
+
+using namespace std;
+using namespace resqml2_0_1test;
+using namespace COMMON_NS;
+using namespace RESQML2_NS;
+
+const char* ColumnLayerLgrOnRightHanded4x3x2ExplicitIjkGrid::defaultUuid = "14c68a2f-159c-419f-a9da-023f088565e5";
+const char* ColumnLayerLgrOnRightHanded4x3x2ExplicitIjkGrid::defaultTitle = "Column layer LGR";
+const ULONG64 ColumnLayerLgrOnRightHanded4x3x2ExplicitIjkGrid::nodesCountIjkGridRepresentation = 30;
+double ColumnLayerLgrOnRightHanded4x3x2ExplicitIjkGrid::nodesIjkGridRepresentation[] = {
+	0, 50, 300, 50, 50, 300, 100, 50, 300, //IJ0K0
+	0, 0, 300, 50, 0, 300, 100, 0, 300, //IJ1K0
+	0, 50, 325, 50, 50, 325, 100, 50, 325, //IJ0K1
+	0, 0, 325, 50, 0, 325, 100, 0, 325, //IJ1K1
+	0, 50, 350, 50, 50, 350, 100, 50, 350, //IJ0K2
+	0, 0, 350, 50, 0, 350, 100, 0, 350, //IJ1K2
+	0, 50, 375, 50, 50, 375, 100, 50, 375, //IJ0K3
+	0, 0, 375, 50, 0, 375, 100, 0, 375, //IJ1K3
+	0, 50, 400, 50, 50, 400, 100, 50, 400, //IJ0K4
+	0, 0, 400, 50, 0, 400, 100, 0, 400 //IJ1K4
+};
+
+ColumnLayerLgrOnRightHanded4x3x2ExplicitIjkGrid::ColumnLayerLgrOnRightHanded4x3x2ExplicitIjkGrid(const string & epcDocPath)
+	: AbstractIjkGridRepresentationTest(epcDocPath, defaultUuid, defaultTitle, nodesCountIjkGridRepresentation, nodesIjkGridRepresentation) {
+}
+
+ColumnLayerLgrOnRightHanded4x3x2ExplicitIjkGrid::ColumnLayerLgrOnRightHanded4x3x2ExplicitIjkGrid(EpcDocument* epcDoc, bool init)
+	: AbstractIjkGridRepresentationTest(epcDoc, defaultUuid, defaultTitle, nodesCountIjkGridRepresentation, nodesIjkGridRepresentation) {
+	if (init) {
+		this->initEpcDoc();
+	}
+	else {
+		this->readEpcDoc();
+	}
+}
+
+void ColumnLayerLgrOnRightHanded4x3x2ExplicitIjkGrid::initEpcDocHandler() {
+	// getting the parent grid
+	RightHanded4x3x2ExplicitIjkGrid* parentGridTest = new RightHanded4x3x2ExplicitIjkGrid(this->epcDoc, true);
+
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* parentGrid = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridExplicitRepresentation>(RightHanded4x3x2ExplicitIjkGrid::defaultUuid);
+	RESQML2_0_1_NS::LocalDepth3dCrs* crs = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::LocalDepth3dCrs>(LocalDepth3dCrsTest::defaultUuid);
+
+	// cleaning
+	delete parentGridTest;
+
+	// getting the hdf proxy
+	AbstractHdfProxy* hdfProxy = this->epcDoc->getHdfProxySet()[0];
+
+	// creating the child ijk grid : two parent columns whose first two layers are regridded into four child layers
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* childGrid = epcDoc->createIjkGridExplicitRepresentation(crs, uuid, title, 2, 1, 4);
+	childGrid->setGeometryAsCoordinateLineNodes(gsoap_resqml2_0_1::resqml2__PillarShape__vertical, gsoap_resqml2_0_1::resqml2__KDirection__down, false, xyzPointsOfAllPatchesInGlobalCrs, hdfProxy);
+	unsigned int columnIndices[2] = { 0, 5 };
+	unsigned int childCellCountPerInterval = 4;
+	unsigned int parentCellCountPerInterval = 2;
+	double childCellWeights[4] = { 1, 1, 2, 4 };
+	childGrid->setParentWindow(columnIndices, 2, 0, &childCellCountPerInterval, &parentCellCountPerInterval, 1, parentGrid, childCellWeights);
+	ULONG64 forcedNonRegridedParentCell = 17;
+	childGrid->setForcedNonRegridedParentCell(&forcedNonRegridedParentCell, 1);
+}
+
+void ColumnLayerLgrOnRightHanded4x3x2ExplicitIjkGrid::readEpcDocHandler() {
+	RightHanded4x3x2ExplicitIjkGrid* parentGridTest = new RightHanded4x3x2ExplicitIjkGrid(this->epcDoc, false);
+
+	// getting the childGrid
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* childGrid = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridExplicitRepresentation>(uuid);
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* parentGrid = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridExplicitRepresentation>(RightHanded4x3x2ExplicitIjkGrid::defaultUuid);
+
+	REQUIRE(childGrid->getCellCount() == 8);
+	REQUIRE(childGrid->getParentGrid() == parentGrid);
+	REQUIRE(childGrid->getParentColumnIndexCount() == 2);
+	REQUIRE(childGrid->getForcedNonRegridedParentCellCount() == 1);
+
+	// Mapping : child cell (k, column) overlaps parent cell column + k * 12
+	LocalGridRefinementMapping mapping(childGrid);
+	REQUIRE(mapping.getChildCellCount() == 8);
+	REQUIRE(mapping.getParentCellCount() == 24);
+	REQUIRE(mapping.getOverlapCount() == 7);
+	REQUIRE(mapping.isParentCellRefined(0));
+	REQUIRE(mapping.isParentCellRefined(5));
+	REQUIRE(mapping.isParentCellRefined(12));
+	REQUIRE(!mapping.isParentCellRefined(17));
+	REQUIRE(!mapping.isParentCellRefined(1));
+
+	REQUIRE(mapping.getChildCellCountOfParentCell(0) == 3);
+	ULONG64 childCellIndices[3];
+	double parentFractions[3];
+	mapping.getChildCellsOfParentCell(0, childCellIndices, parentFractions);
+	REQUIRE(childCellIndices[0] == 0);
+	REQUIRE(childCellIndices[1] == 2);
+	REQUIRE(childCellIndices[2] == 4);
+	REQUIRE(parentFractions[0] == Approx(0.25));
+	REQUIRE(parentFractions[1] == Approx(0.25));
+	REQUIRE(parentFractions[2] == Approx(0.5));
+	REQUIRE(mapping.getParentCellCountOfChildCell(6) == 1);
+	REQUIRE(mapping.getParentCellCountOfChildCell(7) == 0);
+
+	ULONG64 mappedChildCellIndices[2] = { 6, 7 };
+	ULONG64 parentCellIndices[2];
+	mapping.getParentCellIndices(mappedChildCellIndices, 2, parentCellIndices);
+	REQUIRE(parentCellIndices[0] == 12);
+	REQUIRE(parentCellIndices[1] == (numeric_limits<ULONG64>::max)());
+
+	double childValues[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	double parentValues[24];
+	for (unsigned int i = 0; i < 24; ++i) {
+		parentValues[i] = -1;
+	}
+	mapping.upscale(childValues, parentValues);
+	REQUIRE(parentValues[0] == Approx(3.5));
+	REQUIRE(parentValues[5] == Approx(4.5));
+	REQUIRE(parentValues[12] == 7);
+	REQUIRE(parentValues[17] == -1);
+
+	parentValues[0] = 8;
+	mapping.downscale(parentValues, childValues, LocalGridRefinementMapping::EXTENSIVE);
+	REQUIRE(childValues[0] == Approx(2));
+	REQUIRE(childValues[4] == Approx(4));
+	REQUIRE(childValues[7] == 8);
+
+	delete parentGridTest;
+}
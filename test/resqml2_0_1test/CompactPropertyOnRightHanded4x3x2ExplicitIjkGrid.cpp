@@ -0,0 +1,129 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/CompactPropertyOnRightHanded4x3x2ExplicitIjkGrid.h"
+
+#include <limits>
+
+#include "catch.hpp"
+
+#include "common/EpcDocument.h"
+#include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+#include "resqml2_0_1/DiscreteProperty.h"
+#include "resqml2_0_1/CategoricalProperty.h"
+#include "resqml2_0_1/StringTableLookup.h"
+
+using namespace std;
+using namespace COMMON_NS;
+using namespace RESQML2_NS;
+using namespace resqml2_0_1test;
+
+const char* CompactPropertyOnRightHanded4x3x2ExplicitIjkGrid::defaultUuid = "5c2c3e0a-4b9e-4f0f-8d76-6f1b9a4c2d31";
+const char* CompactPropertyOnRightHanded4x3x2ExplicitIjkGrid::defaultTitle = "Compact cell index";
+
+namespace {
+	const char* faciesUuid = "161f4f2e-d228-4cf1-b3e7-88f329a80b16";
+	const char* faciesLookupUuid = "c0033afa-b62e-4966-9d9f-2151097444e6";
+
+	/**
+	* The cell index except in cell 11 whose value does not fit in a signed char.
+	*/
+	long getCompactCellIndex(const ULONG64 & cellIndex)
+	{
+		return cellIndex == 11 ? 200 : static_cast<long>(cellIndex);
+	}
+
+	/**
+	* Four facies which repeat along I. The disabled cells have no facies.
+	*/
+	long getFacies(const ULONG64 & cellIndex)
+	{
+		return cellIndex == 11 || cellIndex == 23 ? (numeric_limits<long>::max)() : static_cast<long>(cellIndex % 4);
+	}
+}
+
+void CompactPropertyOnRightHanded4x3x2ExplicitIjkGrid::initFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid, AbstractHdfProxy* hdfProxy) {
+	unsigned long long cellDims[3] = { 2, 3, 4 };
+
+	// discrete property : the null value -1 does not fit in unsigned chars
+	RESQML2_0_1_NS::DiscreteProperty* compactDiscreteProp = this->epcDoc->createDiscreteProperty(ijkGrid, uuid, title, 1,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__cells, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__index);
+	long cellIndices[24];
+	for (ULONG64 cell = 0; cell < 24; ++cell) {
+		cellIndices[cell] = getCompactCellIndex(cell);
+	}
+	REQUIRE(compactDiscreteProp->pushBackCompactLongHdf5ArrayOfValues(cellIndices, cellDims, 3, hdfProxy, -1) == AbstractValuesProperty::UCHAR);
+
+	// categorical property : the default null value does not fit in signed chars
+	RESQML2_0_1_NS::StringTableLookup* faciesLookup = this->epcDoc->createStringTableLookup(faciesLookupUuid, "Facies");
+	faciesLookup->addValue("Sand", 0);
+	faciesLookup->addValue("Shaly sand", 1);
+	faciesLookup->addValue("Shale", 2);
+	faciesLookup->addValue("Carbonate", 3);
+	RESQML2_0_1_NS::CategoricalProperty* facies = this->epcDoc->createCategoricalProperty(ijkGrid, faciesUuid, "Facies", 1,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__cells, faciesLookup, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__categorical);
+	long faciesValues[24];
+	for (ULONG64 cell = 0; cell < 24; ++cell) {
+		faciesValues[cell] = getFacies(cell);
+	}
+	REQUIRE(facies->pushBackCompactLongHdf5ArrayOfValues(faciesValues, cellDims, 3, hdfProxy, (numeric_limits<long>::max)()) == AbstractValuesProperty::CHAR);
+}
+
+void CompactPropertyOnRightHanded4x3x2ExplicitIjkGrid::readFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid) {
+	// discrete property : the null value has been changed to the maximum unsigned char
+	RESQML2_0_1_NS::DiscreteProperty* compactDiscreteProp = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::DiscreteProperty>(uuid);
+	REQUIRE(compactDiscreteProp->getRepresentation() == ijkGrid);
+	REQUIRE(compactDiscreteProp->getValuesHdfDatatype() == AbstractValuesProperty::UCHAR);
+	REQUIRE(compactDiscreteProp->getNullValueOfPatch(0) == 255);
+	long widenedValues[24];
+	compactDiscreteProp->getLongValuesOfPatch(0, widenedValues);
+	int intValues[24];
+	compactDiscreteProp->getIntValuesOfPatch(0, intValues);
+	for (ULONG64 cell = 0; cell < 24; ++cell) {
+		REQUIRE(widenedValues[cell] == getCompactCellIndex(cell));
+		REQUIRE(intValues[cell] == getCompactCellIndex(cell));
+	}
+
+	// strided read of the narrowed values
+	unsigned char stridedValues[4];
+	unsigned long long stridedCounts[3] = { 1, 2, 2 };
+	unsigned long long stridedOffsets[3] = { 0, 0, 1 };
+	unsigned long long strides[3] = { 1, 2, 2 };
+	compactDiscreteProp->getUCharValuesOfHyperslabOfPatch(0, stridedValues, stridedCounts, stridedOffsets, strides, 3);
+	REQUIRE(stridedValues[0] == 1);
+	REQUIRE(stridedValues[1] == 3);
+	REQUIRE(stridedValues[2] == 9);
+	REQUIRE(stridedValues[3] == 200);
+
+	// categorical property : the null value has been changed to the maximum signed char
+	RESQML2_0_1_NS::CategoricalProperty* facies = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::CategoricalProperty>(faciesUuid);
+	REQUIRE(facies->getStringLookupUuid() == faciesLookupUuid);
+	REQUIRE(facies->getValuesHdfDatatype() == AbstractValuesProperty::CHAR);
+	REQUIRE(facies->getNullValueOfPatch(0) == 127);
+	long faciesValues[24];
+	facies->getLongValuesOfPatch(0, faciesValues);
+	for (ULONG64 cell = 0; cell < 24; ++cell) {
+		if (cell == 11 || cell == 23) {
+			REQUIRE(faciesValues[cell] == 127);
+		}
+		else {
+			REQUIRE(faciesValues[cell] == getFacies(cell));
+		}
+	}
+	REQUIRE(facies->getStringLookup()->getStringValue(faciesValues[6]) == "Shale");
+}
@@ -101,6 +101,19 @@ void ContinuousPropertyOnWellFrameTest::readEpcDocHandler() {
 	REQUIRE(values[2] == 2.3);
 	REQUIRE(values[3] == 3.4);
 	REQUIRE(values[4] == 4.5);
+
+	// unit of measure conversion
+	continuousProperty->getDoubleValuesOfPatch(0, values, gsoap_resqml2_0_1::resqml2__ResqmlUom__ft);
+	REQUIRE(values[0] == Approx(0.1 / 0.3048));
+	REQUIRE(values[4] == Approx(4.5 / 0.3048));
+	REQUIRE_THROWS(continuousProperty->getDoubleValuesOfPatch(0, values, gsoap_resqml2_0_1::resqml2__ResqmlUom__psi));
+	REQUIRE_THROWS_AS(continuousProperty->getDoubleValuesOfPatch(0, values, gsoap_resqml2_0_1::resqml2__ResqmlUom__mCi), invalid_argument);
+	double scale, offset;
+	REQUIRE(RESQML2_0_1_NS::ContinuousProperty::getUomConversion(gsoap_resqml2_0_1::resqml2__ResqmlUom__degC, gsoap_resqml2_0_1::resqml2__ResqmlUom__degF, scale, offset));
+	REQUIRE(100 * scale + offset == Approx(212));
+	REQUIRE(RESQML2_0_1_NS::ContinuousProperty::getUomConversion(gsoap_resqml2_0_1::resqml2__ResqmlUom__us_x002fft, gsoap_resqml2_0_1::resqml2__ResqmlUom__ms_x002fm, scale, offset));
+	REQUIRE(scale == Approx(1e-3 / 0.3048));
+	REQUIRE_FALSE(RESQML2_0_1_NS::ContinuousProperty::getUomConversion(gsoap_resqml2_0_1::resqml2__ResqmlUom__m, gsoap_resqml2_0_1::resqml2__ResqmlUom__mCi, scale, offset));
 	delete[] values;
 
 	// cleaning
@@ -70,6 +70,18 @@ void ContinuousPropertySeriesTest::initEpcDocHandler() {
 	double valuesTime[6] = {0,1,2,3,3,4};
 	continuousPropertySeries->pushBackDoubleHdf5Array1dOfValues(valuesTime, 6, hdfProxy);
 
+	// history of the second cell read by time index
+	REQUIRE(continuousPropertySeries->getSeriesTimeIndexCount() == 3);
+	REQUIRE_FALSE(continuousPropertySeries->hasHistoryOfPatch(0));
+	indexing::IndexSet secondCell;
+	secondCell.add(1);
+	double history[3];
+	continuousPropertySeries->getDoubleValuesOfElementHistory(0, secondCell, history);
+	REQUIRE(history[0] == 1);
+	REQUIRE(history[1] == 3);
+	REQUIRE(history[2] == 4);
+	continuousPropertySeries->writeHistoryOfPatch(0);
+
 	// cleaning
 	delete timeSeriesTest;
 	delete ijkGridTest;
@@ -115,6 +127,28 @@ void ContinuousPropertySeriesTest::readEpcDocHandler() {
 	REQUIRE( values[5] == 4 );
 	delete [] values;
 
+	// series access
+	REQUIRE(continuousPropertySeries->getSeriesElementCountOfPatch(0) == 2);
+	double timeSlice[2];
+	continuousPropertySeries->getDoubleValuesOfTimeIndex(0, 1, timeSlice);
+	REQUIRE(timeSlice[0] == 2);
+	REQUIRE(timeSlice[1] == 3);
+	double timeWindow[2];
+	continuousPropertySeries->getDoubleValuesOfTimeWindow(0, 1, 2, 1, 1, timeWindow);
+	REQUIRE(timeWindow[0] == 3);
+	REQUIRE(timeWindow[1] == 4);
+	REQUIRE(continuousPropertySeries->hasHistoryOfPatch(0));
+	indexing::IndexSet allCells;
+	allCells.addRange(0, 2);
+	double histories[6];
+	continuousPropertySeries->getDoubleValuesOfElementHistory(0, allCells, histories);
+	REQUIRE(histories[0] == 0);
+	REQUIRE(histories[1] == 2);
+	REQUIRE(histories[2] == 3);
+	REQUIRE(histories[3] == 1);
+	REQUIRE(histories[4] == 3);
+	REQUIRE(histories[5] == 4);
+
 	// cleaning
 	delete ijkGridTest;
 	delete timeSeriesTest;
@@ -0,0 +1,149 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/DerivedPropertyOnRightHanded4x3x2ExplicitIjkGrid.h"
+
+#include <limits>
+#include <stdexcept>
+
+#include "catch.hpp"
+
+#include "common/EpcDocument.h"
+#include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+#include "resqml2_0_1/ContinuousProperty.h"
+#include "tools/Parallel.h"
+
+using namespace std;
+using namespace COMMON_NS;
+using namespace RESQML2_NS;
+using namespace resqml2_0_1test;
+
+const char* DerivedPropertyOnRightHanded4x3x2ExplicitIjkGrid::defaultUuid = "9e8a4c7d-3b2f-4e61-a5d0-7c1f2b3e4d5a";
+const char* DerivedPropertyOnRightHanded4x3x2ExplicitIjkGrid::defaultTitle = "Squared amplitude";
+
+namespace {
+	const char* amplitudeUuid = "de5a71cc-879d-4cda-8fb3-146c70539cf9";
+	const char* vectorialInputUuid = "952adb90-c0e3-4315-af57-88c70e09cf37";
+	const char* vectorialFactorUuid = "04f8eac6-f8fe-4255-81f8-89b2e015d635";
+	const char* vectorialDerivedUuid = "8dcea257-2e8e-440f-bd53-5897386a6ea9";
+
+	/**
+	* The second component of the vectorial input is undefined in one cell of each K layer.
+	*/
+	bool isUndefined(const ULONG64 & cellIndex)
+	{
+		return cellIndex == 5 || cellIndex == 23;
+	}
+}
+
+void DerivedPropertyOnRightHanded4x3x2ExplicitIjkGrid::initFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid, AbstractHdfProxy* hdfProxy) {
+	// the amplitude property of the grid
+	RESQML2_0_1_NS::ContinuousProperty* amplitude = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(amplitudeUuid);
+
+	// scalar derived property streamed one K layer at a time
+	RESQML2_0_1_NS::ContinuousProperty* derivedProp = this->epcDoc->createContinuousProperty(ijkGrid, uuid, title, 1,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__cells, gsoap_resqml2_0_1::resqml2__ResqmlUom__Euc, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__amplitude);
+	std::vector<RESQML2_NS::AbstractValuesProperty*> derivationInputs(2, amplitude);
+	RESQML2_0_1_NS::ContinuousProperty::ProductKernel productKernel;
+	derivedProp->pushBackDerivedDoubleHdf5ArrayOfValues(derivationInputs, 0, productKernel, hdfProxy, 12);
+	REQUIRE(derivedProp->getMinimumValue() == 0.0);
+	REQUIRE(derivedProp->getMaximumValue() == Approx(2.25));
+
+	// vectorial inputs : the first component is the cell index, the second one is one except in the undefined cells
+	unsigned long long vectorialDims[4] = { 2, 3, 4, 2 };
+	double vectorialValues[48];
+	double vectorialFactors[48];
+	for (ULONG64 cell = 0; cell < 24; ++cell) {
+		vectorialValues[2 * cell] = static_cast<double>(cell);
+		vectorialValues[2 * cell + 1] = isUndefined(cell) ? numeric_limits<double>::quiet_NaN() : 1.0;
+		vectorialFactors[2 * cell] = 2.0;
+		vectorialFactors[2 * cell + 1] = static_cast<double>(cell);
+	}
+	RESQML2_0_1_NS::ContinuousProperty* vectorialInput = this->epcDoc->createContinuousProperty(ijkGrid, vectorialInputUuid, "Vectorial input", 2,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__cells, gsoap_resqml2_0_1::resqml2__ResqmlUom__Euc, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__amplitude);
+	vectorialInput->pushBackDoubleHdf5ArrayOfValues(vectorialValues, vectorialDims, 4, hdfProxy);
+	RESQML2_0_1_NS::ContinuousProperty* vectorialFactor = this->epcDoc->createContinuousProperty(ijkGrid, vectorialFactorUuid, "Vectorial factor", 2,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__cells, gsoap_resqml2_0_1::resqml2__ResqmlUom__Euc, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__amplitude);
+	vectorialFactor->pushBackDoubleHdf5ArrayOfValues(vectorialFactors, vectorialDims, 4, hdfProxy);
+
+	// the inputs must have the same dimensions
+	RESQML2_0_1_NS::ContinuousProperty* vectorialDerived = this->epcDoc->createContinuousProperty(ijkGrid, vectorialDerivedUuid, "Vectorial product", 2,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__cells, gsoap_resqml2_0_1::resqml2__ResqmlUom__Euc, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__amplitude);
+	derivationInputs[0] = vectorialInput;
+	REQUIRE_THROWS_AS(vectorialDerived->pushBackDerivedDoubleHdf5ArrayOfValues(derivationInputs, 0, productKernel, hdfProxy, 12), invalid_argument);
+
+	// vectorial derived property streamed in two chunks : a K layer holds 24 values which are derived by several threads
+	derivationInputs[1] = vectorialFactor;
+	vectorialDerived->enableChunkSummaries();
+	parallel::setMaxThreadCount(4);
+	parallel::setMinItemCountPerThread(1);
+	vectorialDerived->pushBackDerivedDoubleHdf5ArrayOfValues(derivationInputs, 0, productKernel, hdfProxy, 12);
+	parallel::setMaxThreadCount(0);
+	parallel::setMinItemCountPerThread(0);
+	REQUIRE(vectorialDerived->getPatchCount() == 1);
+}
+
+void DerivedPropertyOnRightHanded4x3x2ExplicitIjkGrid::readFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid) {
+	// scalar derived property
+	RESQML2_0_1_NS::ContinuousProperty* amplitude = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(amplitudeUuid);
+	double amplitudeValues[24];
+	amplitude->getDoubleValuesOfPatch(0, amplitudeValues);
+	RESQML2_0_1_NS::ContinuousProperty* derivedProp = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(uuid);
+	REQUIRE(derivedProp->getRepresentation() == ijkGrid);
+	REQUIRE(derivedProp->getMinimumValue() == 0.0);
+	REQUIRE(derivedProp->getMaximumValue() == Approx(2.25));
+	double derivedValues[24];
+	derivedProp->getDoubleValuesOfPatch(0, derivedValues);
+	for (ULONG64 cell = 0; cell < 24; ++cell) {
+		REQUIRE(derivedValues[cell] == Approx(amplitudeValues[cell] * amplitudeValues[cell]));
+	}
+
+	// vectorial derived property : NaN propagates to the derived values but not to the minimum and maximum of each component
+	RESQML2_0_1_NS::ContinuousProperty* vectorialDerived = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(vectorialDerivedUuid);
+	REQUIRE(vectorialDerived->getValuesCountOfPatch(0) == 48);
+	double vectorialValues[48];
+	vectorialDerived->getDoubleValuesOfPatch(0, vectorialValues);
+	for (ULONG64 cell = 0; cell < 24; ++cell) {
+		REQUIRE(vectorialValues[2 * cell] == 2.0 * cell);
+		if (isUndefined(cell)) {
+			REQUIRE(vectorialValues[2 * cell + 1] != vectorialValues[2 * cell + 1]);
+		}
+		else {
+			REQUIRE(vectorialValues[2 * cell + 1] == static_cast<double>(cell));
+		}
+	}
+	gsoap_resqml2_0_1::_resqml2__ContinuousProperty* vectorialDerivedProxy = static_cast<gsoap_resqml2_0_1::_resqml2__ContinuousProperty*>(vectorialDerived->getGsoapProxy());
+	REQUIRE(vectorialDerivedProxy->MinimumValue.size() == 2);
+	REQUIRE(vectorialDerivedProxy->MinimumValue[0] == 0.0);
+	REQUIRE(vectorialDerivedProxy->MaximumValue[0] == 46.0);
+	REQUIRE(vectorialDerivedProxy->MinimumValue[1] == 0.0);
+	REQUIRE(vectorialDerivedProxy->MaximumValue[1] == 22.0);
+
+	// the chunk summary of each K layer is computed while streaming
+	std::vector<double> minimums;
+	std::vector<double> maximums;
+	std::vector<ULONG64> validCounts;
+	REQUIRE(vectorialDerived->getChunkSummaryOfPatch(0, minimums, maximums, validCounts) == 24);
+	REQUIRE(minimums.size() == 2);
+	REQUIRE(minimums[0] == 0.0);
+	REQUIRE(maximums[0] == 22.0);
+	REQUIRE(validCounts[0] == 23);
+	REQUIRE(minimums[1] == 12.0);
+	REQUIRE(maximums[1] == 46.0);
+	REQUIRE(validCounts[1] == 23);
+}
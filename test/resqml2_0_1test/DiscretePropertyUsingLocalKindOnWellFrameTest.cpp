@@ -98,6 +98,10 @@ void DiscretePropertyUsingLocalKindOnWellFrameTest::readEpcDocHandler() {
 	// getValuesCountOfPatch
 	REQUIRE(discreteProperty->getValuesCountOfPatch(0) == 4);
 
+	// min max computed at writing time
+	REQUIRE(discreteProperty->getMinimumValue() == 0);
+	REQUIRE(discreteProperty->getMaximumValue() == 3);
+
 	int* values = new int[4];
 	discreteProperty->getIntValuesOfPatch(0, values);
 	REQUIRE(values[0] == 0);
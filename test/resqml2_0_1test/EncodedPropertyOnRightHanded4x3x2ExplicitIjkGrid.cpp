@@ -0,0 +1,245 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/EncodedPropertyOnRightHanded4x3x2ExplicitIjkGrid.h"
+
+#include <limits>
+
+#include "catch.hpp"
+#include "resqml2_0_1test/TimeSeriesTest.h"
+
+#include "common/EpcDocument.h"
+#include "resqml2/TimeSeries.h"
+#include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+#include "resqml2_0_1/ContinuousPropertySeries.h"
+
+using namespace std;
+using namespace COMMON_NS;
+using namespace RESQML2_NS;
+using namespace resqml2_0_1test;
+
+const char* EncodedPropertyOnRightHanded4x3x2ExplicitIjkGrid::defaultUuid = "0ac3f86d-6b60-43f6-b5e6-3f58f515f824";
+const char* EncodedPropertyOnRightHanded4x3x2ExplicitIjkGrid::defaultTitle = "Encoded amplitude series";
+
+namespace {
+	const char* encodedAmplitudeUuid = "0ab2bd6e-7f4f-4c3e-9a1d-2f52b8c6a9e1";
+	const char* halfFloatAmplitudeUuid = "2bad64e1-ea34-43fc-9864-841a81985a8a";
+
+	const double amplitudes[24] = {
+		0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.5, 0.4, 0.3, 0.2, 0.1, 0.0,
+		1.0, 1.1, 1.2, 1.3, 1.4, 1.5, 1.5, 1.4, 1.3, 1.2, 1.1, 1.0
+	};
+
+	/**
+	* The amplitude of the cell increased by the time index. The amplitude of the cell 7 is unknown at time index 1.
+	*/
+	double getSeriesValue(const unsigned int & timeIndex, const ULONG64 & cellIndex)
+	{
+		return timeIndex == 1 && cellIndex == 7 ? numeric_limits<double>::quiet_NaN() : amplitudes[cellIndex] + timeIndex;
+	}
+
+	// The series is encoded with a maximal error of 0.01 and the amplitude with a maximal error of 0.005.
+	const double seriesMargin = 0.0101;
+	const double amplitudeMargin = 0.0051;
+
+	/**
+	* Float values which exercise the rounding, the subnormal values and the overflow of the conversion to half floats.
+	* The last twelve cells have regular amplitudes.
+	*/
+	void getHalfFloatInputs(double * values)
+	{
+		const double specialValues[12] = { 0.1, 1e-6, 1e5, -2.5, 2049, 2051, 65504, 65520, 6.1e-5, 1.5, 3e-8, numeric_limits<double>::quiet_NaN() };
+		for (unsigned int cell = 0; cell < 12; ++cell) {
+			values[cell] = specialValues[cell];
+			values[cell + 12] = amplitudes[cell + 12];
+		}
+	}
+}
+
+void EncodedPropertyOnRightHanded4x3x2ExplicitIjkGrid::initFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid, AbstractHdfProxy* hdfProxy) {
+	// creation of the time series
+	TimeSeriesTest* timeSeriesTest = new TimeSeriesTest(this->epcDoc, true);
+	TimeSeries* timeSeries = this->epcDoc->getResqmlAbstractObjectByUuid<TimeSeries>(TimeSeriesTest::defaultUuid);
+
+	// amplitude stored as scaled unsigned char codes
+	RESQML2_0_1_NS::ContinuousProperty* encodedAmplitude = this->epcDoc->createContinuousProperty(ijkGrid, encodedAmplitudeUuid, "Encoded amplitude", 1,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__cells, gsoap_resqml2_0_1::resqml2__ResqmlUom__Euc, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__amplitude);
+	unsigned long long cellDims[3] = { 2, 3, 4 };
+	REQUIRE(encodedAmplitude->pushBackEncodedDoubleHdf5ArrayOfValues(amplitudes, cellDims, 3, hdfProxy, 0.005) == RESQML2_0_1_NS::ContinuousProperty::SCALED_UCHAR);
+
+	// amplitude stored as half floats
+	RESQML2_0_1_NS::ContinuousProperty* halfFloatAmplitude = this->epcDoc->createContinuousProperty(ijkGrid, halfFloatAmplitudeUuid, "Half float amplitude", 1,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__cells, gsoap_resqml2_0_1::resqml2__ResqmlUom__Euc, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__amplitude);
+	double halfFloatInputs[24];
+	getHalfFloatInputs(halfFloatInputs);
+	halfFloatAmplitude->pushBackEncodedDoubleHdf5ArrayOfValues(halfFloatInputs, cellDims, 3, hdfProxy, RESQML2_0_1_NS::ContinuousProperty::HALF_FLOAT);
+
+	// amplitude series stored as scaled unsigned char codes
+	RESQML2_0_1_NS::ContinuousPropertySeries* encodedSeries = this->epcDoc->createContinuousPropertySeries(ijkGrid, uuid, title, 1,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__cells, gsoap_resqml2_0_1::resqml2__ResqmlUom__Euc, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__amplitude, timeSeries);
+	double seriesValues[72];
+	for (unsigned int t = 0; t < 3; ++t) {
+		for (ULONG64 cell = 0; cell < 24; ++cell) {
+			seriesValues[t * 24 + cell] = getSeriesValue(t, cell);
+		}
+	}
+	unsigned long long seriesDims[4] = { 3, 2, 3, 4 };
+	REQUIRE(encodedSeries->pushBackEncodedDoubleHdf5ArrayOfValues(seriesValues, seriesDims, 4, hdfProxy, 0.01) == RESQML2_0_1_NS::ContinuousProperty::SCALED_UCHAR);
+
+	// history read from the codes, before any history dataset exists
+	REQUIRE_FALSE(encodedSeries->hasHistoryOfPatch(0));
+	indexing::IndexSet cells;
+	cells.add(7);
+	cells.add(20);
+	double histories[6];
+	encodedSeries->getDoubleValuesOfElementHistory(0, cells, histories);
+	REQUIRE(histories[0] == Approx(amplitudes[7]).margin(seriesMargin));
+	REQUIRE(histories[1] != histories[1]);
+	REQUIRE(histories[2] == Approx(amplitudes[7] + 2).margin(seriesMargin));
+	REQUIRE(histories[5] == Approx(amplitudes[20] + 2).margin(seriesMargin));
+
+	// summary and history computed from the decoded values
+	encodedSeries->writeChunkSummaryOfPatch(0);
+	encodedSeries->writeHistoryOfPatch(0);
+
+	// double values cannot be scattered to codes
+	REQUIRE_THROWS_AS(encodedSeries->scatterDoubleValuesOfPatch(0, cells, histories), logic_error);
+
+	// cleaning
+	delete timeSeriesTest;
+}
+
+void EncodedPropertyOnRightHanded4x3x2ExplicitIjkGrid::readFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid) {
+	// reading the time series
+	TimeSeriesTest* timeSeriesTest = new TimeSeriesTest(this->epcDoc, false);
+
+	// scaled codes
+	RESQML2_0_1_NS::ContinuousProperty* encodedAmplitude = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(encodedAmplitudeUuid);
+	REQUIRE(encodedAmplitude->getRepresentation() == ijkGrid);
+	REQUIRE(encodedAmplitude->getEncodingOfPatch(0) == RESQML2_0_1_NS::ContinuousProperty::SCALED_UCHAR);
+	REQUIRE(encodedAmplitude->getValuesHdfDatatype() == AbstractValuesProperty::UCHAR);
+	double decodedValues[24];
+	encodedAmplitude->getDoubleValuesOfPatch(0, decodedValues);
+	for (ULONG64 cell = 0; cell < 24; ++cell) {
+		REQUIRE(decodedValues[cell] == Approx(amplitudes[cell]).margin(amplitudeMargin));
+	}
+	double boxValues[4];
+	encodedAmplitude->getDoubleValuesOf3dBoxOfPatch(0, boxValues, 2, 2, 1, 1, 1, 1);
+	REQUIRE(boxValues[0] == Approx(amplitudes[17]).margin(amplitudeMargin));
+	REQUIRE(boxValues[3] == Approx(amplitudes[22]).margin(amplitudeMargin));
+
+	// half floats : rounding to the nearest even value, subnormal values, overflow and NaN
+	RESQML2_0_1_NS::ContinuousProperty* halfFloatAmplitude = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(halfFloatAmplitudeUuid);
+	REQUIRE(halfFloatAmplitude->getEncodingOfPatch(0) == RESQML2_0_1_NS::ContinuousProperty::HALF_FLOAT);
+	double halfFloatValues[24];
+	halfFloatAmplitude->getDoubleValuesOfPatch(0, halfFloatValues);
+	REQUIRE(halfFloatValues[0] == 0.0999755859375);
+	REQUIRE(halfFloatValues[1] == 1.0132789611816406e-06);
+	REQUIRE(halfFloatValues[2] == numeric_limits<double>::infinity());
+	REQUIRE(halfFloatValues[3] == -2.5);
+	REQUIRE(halfFloatValues[4] == 2048);
+	REQUIRE(halfFloatValues[5] == 2052);
+	REQUIRE(halfFloatValues[6] == 65504);
+	REQUIRE(halfFloatValues[7] == numeric_limits<double>::infinity());
+	REQUIRE(halfFloatValues[8] == 6.097555160522461e-05);
+	REQUIRE(halfFloatValues[9] == 1.5);
+	REQUIRE(halfFloatValues[10] == 5.960464477539063e-08);
+	REQUIRE(halfFloatValues[11] != halfFloatValues[11]);
+	REQUIRE(halfFloatValues[12] == 1.0);
+	REQUIRE(halfFloatValues[23] == 1.0);
+	float halfFloatFloatValues[24];
+	halfFloatAmplitude->getFloatValuesOfPatch(0, halfFloatFloatValues);
+	REQUIRE(halfFloatFloatValues[3] == -2.5f);
+
+	// history over one property per time step, through the gather path
+	std::vector<const AbstractValuesProperty*> timeSteps;
+	timeSteps.push_back(encodedAmplitude);
+	timeSteps.push_back(halfFloatAmplitude);
+	indexing::IndexSet stepCells;
+	stepCells.add(1);
+	stepCells.add(9);
+	double stepHistories[4];
+	AbstractValuesProperty::getDoubleValuesOfElementHistory(timeSteps, 0, stepCells, stepHistories);
+	REQUIRE(stepHistories[0] == Approx(amplitudes[1]).margin(amplitudeMargin));
+	REQUIRE(stepHistories[1] == 1.0132789611816406e-06);
+	REQUIRE(stepHistories[2] == Approx(amplitudes[9]).margin(amplitudeMargin));
+	REQUIRE(stepHistories[3] == 1.5);
+
+	// scaled series
+	RESQML2_0_1_NS::ContinuousPropertySeries* encodedSeries = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousPropertySeries>(uuid);
+	REQUIRE(encodedSeries->getEncodingOfPatch(0) == RESQML2_0_1_NS::ContinuousProperty::SCALED_UCHAR);
+	REQUIRE(encodedSeries->getSeriesElementCountOfPatch(0) == 24);
+	double timeSlice[24];
+	encodedSeries->getDoubleValuesOfTimeIndex(0, 2, timeSlice);
+	for (ULONG64 cell = 0; cell < 24; ++cell) {
+		REQUIRE(timeSlice[cell] == Approx(getSeriesValue(2, cell)).margin(seriesMargin));
+	}
+	double timeWindow[6];
+	encodedSeries->getDoubleValuesOfTimeWindow(0, 1, 2, 6, 3, timeWindow);
+	REQUIRE(timeWindow[0] == Approx(getSeriesValue(1, 6)).margin(seriesMargin));
+	REQUIRE(timeWindow[1] != timeWindow[1]);
+	REQUIRE(timeWindow[5] == Approx(getSeriesValue(2, 8)).margin(seriesMargin));
+
+	// gather through the linearized (time index, cell) indices
+	indexing::IndexSet elementIndices;
+	elementIndices.addRange(3, 6);
+	elementIndices.add(31);
+	elementIndices.add(50);
+	double gatheredValues[5];
+	encodedSeries->gatherDoubleValuesOfPatch(0, elementIndices, gatheredValues);
+	REQUIRE(gatheredValues[0] == Approx(getSeriesValue(0, 3)).margin(seriesMargin));
+	REQUIRE(gatheredValues[2] == Approx(getSeriesValue(0, 5)).margin(seriesMargin));
+	REQUIRE(gatheredValues[3] != gatheredValues[3]);
+	REQUIRE(gatheredValues[4] == Approx(getSeriesValue(2, 2)).margin(seriesMargin));
+
+	// the chunk summary and the selection compare decoded values, not codes
+	std::vector<double> minimums;
+	std::vector<double> maximums;
+	std::vector<ULONG64> validCounts;
+	REQUIRE(encodedSeries->getChunkSummaryOfPatch(0, minimums, maximums, validCounts) == 24);
+	REQUIRE(validCounts.size() == 3);
+	REQUIRE(validCounts[1] == 23);
+	REQUIRE(minimums[0] == Approx(0).margin(seriesMargin));
+	REQUIRE(maximums[1] == Approx(2.5).margin(seriesMargin));
+	REQUIRE(maximums[2] == Approx(3.5).margin(seriesMargin));
+	indexing::IndexSet selectedIndices;
+	encodedSeries->selectElementIndicesOfPatch(0, 2.95, 3.6, selectedIndices);
+	REQUIRE(selectedIndices.count() == 12);
+	std::vector< std::pair<uint64_t, uint64_t> > selectedRanges;
+	selectedIndices.getRanges(selectedRanges);
+	REQUIRE(selectedRanges.size() == 1);
+	REQUIRE(selectedRanges[0].first == 60);
+	REQUIRE(selectedRanges[0].second == 72);
+
+	// history dataset
+	REQUIRE(encodedSeries->hasHistoryOfPatch(0));
+	indexing::IndexSet cells;
+	cells.add(7);
+	cells.add(20);
+	double histories[6];
+	encodedSeries->getDoubleValuesOfElementHistory(0, cells, histories);
+	REQUIRE(histories[0] == Approx(amplitudes[7]).margin(seriesMargin));
+	REQUIRE(histories[1] != histories[1]);
+	REQUIRE(histories[2] == Approx(amplitudes[7] + 2).margin(seriesMargin));
+	REQUIRE(histories[3] == Approx(amplitudes[20]).margin(seriesMargin));
+	REQUIRE(histories[4] == Approx(amplitudes[20] + 1).margin(seriesMargin));
+	REQUIRE(histories[5] == Approx(amplitudes[20] + 2).margin(seriesMargin));
+
+	// cleaning
+	delete timeSeriesTest;
+}
@@ -0,0 +1,118 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/FaultGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid.h"
+
+#include "catch.hpp"
+#include "resqml2_0_1test/RightHanded4x3x2ExplicitIjkGrid.h"
+
+#include "common/EpcDocument.h"
+#include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+#include "resqml2/GridConnectionSetRepresentation.h"
+
+using namespace std;
+using namespace COMMON_NS;
+using namespace resqml2_0_1test;
+using namespace RESQML2_NS;
+
+const char* FaultGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid::defaultUuid = "ceba2384-457d-4534-b955-2b413ffc0db8";
+const char* FaultGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid::defaultTitle = "Fault grid connection set";
+
+FaultGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid::FaultGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid(const string & epcDocPath)
+	: AbstractResqmlDataObjectTest(epcDocPath, defaultUuid, defaultTitle) {
+}
+
+FaultGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid::FaultGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid(EpcDocument * epcDoc, bool init)
+	: AbstractResqmlDataObjectTest(epcDoc, defaultUuid, defaultTitle) {
+	if (init)
+		this->initEpcDoc();
+	else
+		this->readEpcDoc();
+}
+
+void FaultGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid::initEpcDocHandler() {
+	// creation of the faulted grid
+	RightHanded4x3x2ExplicitIjkGrid* gridTest = new RightHanded4x3x2ExplicitIjkGrid(this->epcDoc, true);
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridExplicitRepresentation>(RightHanded4x3x2ExplicitIjkGrid::defaultUuid);
+
+	// cleaning
+	delete gridTest;
+
+	// getting the hdf proxy
+	AbstractHdfProxy* hdfProxy = this->epcDoc->getHdfProxySet()[0];
+
+	// generating the grid connection set of the fault
+	ijkGrid->loadSplitInformation();
+	REQUIRE(ijkGrid->createFaultGridConnectionSet(uuid, title, hdfProxy) != nullptr);
+	ijkGrid->unloadSplitInformation();
+}
+
+void FaultGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid::readEpcDocHandler() {
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridExplicitRepresentation>(RightHanded4x3x2ExplicitIjkGrid::defaultUuid);
+	RESQML2_NS::GridConnectionSetRepresentation* gcs = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_NS::GridConnectionSetRepresentation>(uuid);
+	REQUIRE(ijkGrid->getGridConnectionSetRepresentationCount() == 2);
+	REQUIRE(!gcs->isBasedOnMultiGrids());
+	REQUIRE(gcs->getSupportingGridRepresentationCount() == 1);
+	REQUIRE(gcs->getSupportingGridRepresentation(0) == ijkGrid);
+	REQUIRE(gcs->hasLocalFacePerCell());
+
+	// The connections are swept column by column and along the pillars for each column edge : a face may be connected to two faces of the other column.
+	REQUIRE(gcs->getCellIndexPairCount() == 9);
+	ULONG64 cellIndexPairs[18];
+	gcs->getCellIndexPairs(cellIndexPairs);
+	int localFacePerCellIndexPairs[18];
+	gcs->getLocalFacePerCellIndexPairs(localFacePerCellIndexPairs);
+	const ULONG64 expectedCellIndexPairs[18] = {
+		1, 2, 13, 2, 13, 14,
+		5, 6, 17, 6, 17, 18,
+		9, 10, 21, 10, 21, 22
+	};
+	for (unsigned int i = 0; i < 18; ++i) {
+		REQUIRE(cellIndexPairs[i] == expectedCellIndexPairs[i]);
+		REQUIRE(localFacePerCellIndexPairs[i] == (i % 2 == 0 ? 3 : 5));
+	}
+
+	// They are the fault connections of the hand made grid connection set
+	RESQML2_NS::GridConnectionSetRepresentation* handMadeGcs = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_NS::GridConnectionSetRepresentation>("a3d1462a-04e3-4374-921b-a4a1e9ba3ea3");
+	ULONG64 handMadeCellIndexPairs[30];
+	handMadeGcs->getCellIndexPairs(handMadeCellIndexPairs);
+	for (unsigned int connection = 0; connection < 9; ++connection) {
+		bool isFound = false;
+		for (unsigned int handMadeConnection = 3; handMadeConnection < 12 && !isFound; ++handMadeConnection) {
+			isFound = handMadeCellIndexPairs[handMadeConnection * 2] == cellIndexPairs[connection * 2] &&
+				handMadeCellIndexPairs[handMadeConnection * 2 + 1] == cellIndexPairs[connection * 2 + 1];
+		}
+		REQUIRE(isFound);
+	}
+
+	// The direct computation gives the same connections and keeps the current block
+	ijkGrid->loadSplitInformation();
+	ijkGrid->loadBlockInformation(0, 1, 0, 1, 0, 1);
+	const ULONG64 blockPointCount = ijkGrid->getXyzPointCountOfBlock();
+	std::vector<ULONG64> faultCellIndexPairs;
+	std::vector<int> faultLocalFacePerCellIndexPairs;
+	ijkGrid->getFaultConnections(faultCellIndexPairs, faultLocalFacePerCellIndexPairs);
+	REQUIRE(ijkGrid->getXyzPointCountOfBlock() == blockPointCount);
+	ijkGrid->unloadSplitInformation();
+	REQUIRE(faultCellIndexPairs.size() == 18);
+	REQUIRE(faultLocalFacePerCellIndexPairs.size() == 18);
+	for (unsigned int i = 0; i < 18; ++i) {
+		REQUIRE(faultCellIndexPairs[i] == cellIndexPairs[i]);
+		REQUIRE(faultLocalFacePerCellIndexPairs[i] == localFacePerCellIndexPairs[i]);
+	}
+}
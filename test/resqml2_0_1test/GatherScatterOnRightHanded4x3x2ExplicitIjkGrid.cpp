@@ -0,0 +1,133 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/GatherScatterOnRightHanded4x3x2ExplicitIjkGrid.h"
+
+#include "catch.hpp"
+
+#include "common/EpcDocument.h"
+#include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+#include "resqml2_0_1/DiscreteProperty.h"
+#include "resqml2_0_1/ContinuousProperty.h"
+
+using namespace std;
+using namespace COMMON_NS;
+using namespace RESQML2_NS;
+using namespace resqml2_0_1test;
+
+const char* GatherScatterOnRightHanded4x3x2ExplicitIjkGrid::defaultUuid = "72bbdcce-1b91-4d9d-88bf-6f2b8bdc00a8";
+const char* GatherScatterOnRightHanded4x3x2ExplicitIjkGrid::defaultTitle = "Scattered cell index";
+
+namespace {
+	const char* continuousPropUuid = "de5a71cc-879d-4cda-8fb3-146c70539cf9";
+
+	/**
+	* Runs of cells which are separated by small gaps.
+	*/
+	void getCoalescedElementIndices(indexing::IndexSet & elementIndices)
+	{
+		elementIndices.addRange(3, 6);
+		elementIndices.add(9);
+		elementIndices.addRange(13, 18);
+	}
+
+	/**
+	* The cells 3 to 5, 9 and 13 to 17 are scattered with 100 + cell index as a single window.
+	* The cells 20 and 22 are scattered with 200 + cell index as separated runs.
+	* The other cells keep their cell index.
+	*/
+	long getScatteredValue(const ULONG64 & cellIndex)
+	{
+		if ((cellIndex >= 3 && cellIndex < 6) || cellIndex == 9 || (cellIndex >= 13 && cellIndex < 18)) {
+			return 100 + cellIndex;
+		}
+		if (cellIndex == 20 || cellIndex == 22) {
+			return 200 + cellIndex;
+		}
+		return cellIndex;
+	}
+}
+
+void GatherScatterOnRightHanded4x3x2ExplicitIjkGrid::initFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid, AbstractHdfProxy* hdfProxy) {
+	// the property which is scattered to
+	RESQML2_0_1_NS::DiscreteProperty* discreteProp = this->epcDoc->createDiscreteProperty(ijkGrid, uuid, title, 1,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__cells, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__index);
+	long cellIndices[24];
+	for (ULONG64 cell = 0; cell < 24; ++cell) {
+		cellIndices[cell] = cell;
+	}
+	discreteProp->pushBackLongHdf5Array3dOfValues(cellIndices, 4, 3, 2, hdfProxy, -1);
+
+	// runs which are close enough are written as a single window
+	indexing::IndexSet coalescedIndices;
+	getCoalescedElementIndices(coalescedIndices);
+	long coalescedValues[9];
+	ULONG64 valueIndex = 0;
+	for (indexing::IndexSet::const_iterator it = coalescedIndices.begin(); it != coalescedIndices.end(); ++it) {
+		coalescedValues[valueIndex++] = getScatteredValue(*it);
+	}
+	discreteProp->scatterLongValuesOfPatch(0, coalescedIndices, coalescedValues);
+
+	// runs are written one by one when no gap can be coalesced
+	indexing::IndexSet separatedIndices;
+	separatedIndices.add(20);
+	separatedIndices.add(22);
+	const long separatedValues[2] = { getScatteredValue(20), getScatteredValue(22) };
+	discreteProp->scatterLongValuesOfPatch(0, separatedIndices, separatedValues, 0);
+
+	// out of range element indices
+	indexing::IndexSet outOfRangeIndices;
+	outOfRangeIndices.add(24);
+	REQUIRE_THROWS_AS(discreteProp->scatterLongValuesOfPatch(0, outOfRangeIndices, separatedValues), out_of_range);
+}
+
+void GatherScatterOnRightHanded4x3x2ExplicitIjkGrid::readFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid) {
+	// the unselected cells of a scattered window keep their values
+	RESQML2_0_1_NS::DiscreteProperty* discreteProp = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::DiscreteProperty>(uuid);
+	REQUIRE(discreteProp->getRepresentation() == ijkGrid);
+	long values[24];
+	discreteProp->getLongValuesOfPatch(0, values);
+	for (ULONG64 cell = 0; cell < 24; ++cell) {
+		REQUIRE(values[cell] == getScatteredValue(cell));
+	}
+
+	// gather of long values
+	indexing::IndexSet elementIndices;
+	getCoalescedElementIndices(elementIndices);
+	long gatheredLongValues[9];
+	REQUIRE(discreteProp->gatherLongValuesOfPatch(0, elementIndices, gatheredLongValues) == -1);
+	ULONG64 valueIndex = 0;
+	for (indexing::IndexSet::const_iterator it = elementIndices.begin(); it != elementIndices.end(); ++it) {
+		REQUIRE(gatheredLongValues[valueIndex++] == getScatteredValue(*it));
+	}
+
+	// gather of double values, with and without coalescing the runs
+	RESQML2_0_1_NS::ContinuousProperty* continuousProp = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(continuousPropUuid);
+	double continuousValues[24];
+	continuousProp->getDoubleValuesOfPatch(0, continuousValues);
+	double gatheredDoubleValues[9];
+	continuousProp->gatherDoubleValuesOfPatch(0, elementIndices, gatheredDoubleValues);
+	double separatedDoubleValues[9];
+	continuousProp->gatherDoubleValuesOfPatch(0, elementIndices, separatedDoubleValues, 0);
+	valueIndex = 0;
+	for (indexing::IndexSet::const_iterator it = elementIndices.begin(); it != elementIndices.end(); ++it) {
+		REQUIRE(gatheredDoubleValues[valueIndex] == continuousValues[*it]);
+		REQUIRE(separatedDoubleValues[valueIndex] == continuousValues[*it]);
+		++valueIndex;
+	}
+}
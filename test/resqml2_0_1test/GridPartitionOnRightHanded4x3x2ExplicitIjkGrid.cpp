@@ -0,0 +1,127 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/GridPartitionOnRightHanded4x3x2ExplicitIjkGrid.h"
+
+#include "catch.hpp"
+
+#include "common/EpcDocument.h"
+#include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+#include "resqml2_0_1/DiscreteProperty.h"
+#include "resqml2/GridPartition.h"
+
+using namespace std;
+using namespace COMMON_NS;
+using namespace RESQML2_NS;
+using namespace resqml2_0_1test;
+
+const char* GridPartitionOnRightHanded4x3x2ExplicitIjkGrid::defaultUuid = "c45a6c12-e811-4a06-a187-41869a43a497";
+const char* GridPartitionOnRightHanded4x3x2ExplicitIjkGrid::defaultTitle = "Partition";
+
+void GridPartitionOnRightHanded4x3x2ExplicitIjkGrid::initFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid, AbstractHdfProxy* hdfProxy) {
+	// partition property
+	GridPartition partition(ijkGrid, 2);
+	RESQML2_0_1_NS::DiscreteProperty* partitionProperty = partition.createPartitionProperty(this->uuid, this->title, hdfProxy);
+	REQUIRE(partitionProperty != nullptr);
+}
+
+void GridPartitionOnRightHanded4x3x2ExplicitIjkGrid::readFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid) {
+	// The disabled cells 11 and 23 weight nothing and the fault connections are part of the cell graph
+	const unsigned int partOfCells[24] = {
+		1, 1, 1, 0, 1, 1, 1, 0, 0, 0, 0, 0,
+		1, 1, 1, 0, 1, 1, 1, 0, 0, 0, 0, 0
+	};
+
+	// partition property
+	RESQML2_0_1_NS::DiscreteProperty* partitionProperty = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::DiscreteProperty>(uuid);
+	REQUIRE(partitionProperty->getValuesCountOfPatch(0) == 24);
+	REQUIRE(partitionProperty->getMinimumValue() == 0);
+	REQUIRE(partitionProperty->getMaximumValue() == 1);
+	int values[24];
+	partitionProperty->getIntValuesOfPatch(0, values);
+	for (unsigned int cell = 0; cell < 24; ++cell) {
+		REQUIRE(values[cell] == static_cast<int>(partOfCells[cell]));
+	}
+
+	// partition
+	GridPartition partition(ijkGrid, 2);
+	REQUIRE(partition.getCellCount() == 24);
+	for (unsigned int cell = 0; cell < 24; ++cell) {
+		REQUIRE(partition.getPartOfCell(cell) == partOfCells[cell]);
+	}
+	REQUIRE(partition.getEdgeCut() == 10);
+	REQUIRE(partition.getWeightOfPart(0) == 10);
+	REQUIRE(partition.getWeightOfPart(1) == 12);
+	REQUIRE(partition.getCellCountOfPart(0) == 12);
+	REQUIRE(partition.getCellCountOfPart(1) == 12);
+	ULONG64 cellIndices[12];
+	partition.getCellIndicesOfPart(1, cellIndices);
+	REQUIRE(cellIndices[0] == 0);
+	REQUIRE(cellIndices[3] == 4);
+	REQUIRE(cellIndices[6] == 12);
+	REQUIRE(cellIndices[11] == 18);
+	REQUIRE_THROWS_AS(partition.getCellCountOfPart(2), out_of_range);
+
+	// halo : the enabled cells of the other part which are directly connected to the part
+	const ULONG64 haloOfPart0[8] = { 2, 4, 5, 6, 14, 16, 17, 18 };
+	REQUIRE(partition.getHaloCellCountOfPart(0) == 8);
+	ULONG64 haloCellIndices[12];
+	partition.getHaloCellIndicesOfPart(0, haloCellIndices);
+	for (unsigned int i = 0; i < 8; ++i) {
+		REQUIRE(haloCellIndices[i] == haloOfPart0[i]);
+	}
+	const ULONG64 haloOfPart1[10] = { 3, 7, 8, 9, 10, 15, 19, 20, 21, 22 };
+	REQUIRE(partition.getHaloCellCountOfPart(1) == 10);
+	partition.getHaloCellIndicesOfPart(1, haloCellIndices);
+	for (unsigned int i = 0; i < 10; ++i) {
+		REQUIRE(haloCellIndices[i] == haloOfPart1[i]);
+	}
+
+	// ijk boxes : the halo of each part spreads over the whole grid
+	unsigned int iStart, iEnd, jStart, jEnd, kStart, kEnd;
+	partition.getIjkBoxOfPart(1, iStart, iEnd, jStart, jEnd, kStart, kEnd);
+	REQUIRE(iStart == 0);
+	REQUIRE(iEnd == 4);
+	REQUIRE(jStart == 0);
+	REQUIRE(jEnd == 3);
+	REQUIRE(kStart == 0);
+	REQUIRE(kEnd == 2);
+
+	// without halo, the box only contains the part
+	GridPartition partitionWithoutHalo(ijkGrid, 2, true, 0);
+	REQUIRE(partitionWithoutHalo.getEdgeCut() == 10);
+	REQUIRE(partitionWithoutHalo.getHaloCellCountOfPart(0) == 0);
+	REQUIRE(partitionWithoutHalo.getHaloCellCountOfPart(1) == 0);
+	partitionWithoutHalo.getIjkBoxOfPart(1, iStart, iEnd, jStart, jEnd, kStart, kEnd);
+	REQUIRE(iStart == 0);
+	REQUIRE(iEnd == 3);
+	REQUIRE(jStart == 0);
+	REQUIRE(jEnd == 2);
+	REQUIRE(kStart == 0);
+	REQUIRE(kEnd == 2);
+
+	// a two layer halo reaches all the cells of the other part
+	GridPartition partitionWithDeepHalo(ijkGrid, 2, true, 2);
+	REQUIRE(partitionWithDeepHalo.getHaloCellCountOfPart(0) == 12);
+	partitionWithDeepHalo.getHaloCellIndicesOfPart(0, haloCellIndices);
+	partition.getCellIndicesOfPart(1, cellIndices);
+	for (unsigned int i = 0; i < 12; ++i) {
+		REQUIRE(haloCellIndices[i] == cellIndices[i]);
+	}
+	REQUIRE(partitionWithDeepHalo.getHaloCellCountOfPart(1) == 10);
+}
@@ -0,0 +1,136 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/HorizontalPillarFaultedIjkGrid.h"
+
+#include "resqml2_0_1test/LocalDepth3dCrsTest.h"
+
+#include "catch.hpp"
+#include "common/EpcDocument.h"
+#include "resqml2_0_1/LocalDepth3dCrs.h"
+#include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+#include "resqml2/GridConnectionSetRepresentation.h"
+
+using namespace std;
+using namespace resqml2_0_1test;
+using namespace COMMON_NS;
+using namespace RESQML2_NS;
+
+const char* HorizontalPillarFaultedIjkGrid::defaultUuid = "6ba9bbba-f8eb-4bb2-b762-b9e6ef915ebf";
+const char* HorizontalPillarFaultedIjkGrid::defaultTitle = "Horizontal pillar faulted ijk grid";
+const ULONG64 HorizontalPillarFaultedIjkGrid::nodesCountIjkGridRepresentation = 32;
+// The pillars go along Y and the nodes of the split coordinate lines of the middle pillars are thrown by 5 along the pillars.
+double HorizontalPillarFaultedIjkGrid::nodesIjkGridRepresentation[] = {
+	0, 0, 1000, 100, 0, 1000, 200, 0, 1000, 0, 0, 1050, 100, 0, 1050, 200, 0, 1050, //IJK0
+	100, 5, 1000, 100, 5, 1050, // SPLIT K0
+	0, 10, 1000, 100, 10, 1000, 200, 10, 1000, 0, 10, 1050, 100, 10, 1050, 200, 10, 1050, //IJK1
+	100, 15, 1000, 100, 15, 1050, // SPLIT K1
+	0, 20, 1000, 100, 20, 1000, 200, 20, 1000, 0, 20, 1050, 100, 20, 1050, 200, 20, 1050, //IJK2
+	100, 25, 1000, 100, 25, 1050, // SPLIT K2
+	0, 30, 1000, 100, 30, 1000, 200, 30, 1000, 0, 30, 1050, 100, 30, 1050, 200, 30, 1050, //IJK3
+	100, 35, 1000, 100, 35, 1050 // SPLIT K3
+};
+
+namespace {
+	const char* faultGridConnectionSetUuid = "2c284cfc-e601-423b-aad1-cb871bc482bb";
+}
+
+HorizontalPillarFaultedIjkGrid::HorizontalPillarFaultedIjkGrid(const string & epcDocPath)
+	: AbstractIjkGridRepresentationTest(epcDocPath, defaultUuid, defaultTitle, nodesCountIjkGridRepresentation, nodesIjkGridRepresentation) {
+}
+
+HorizontalPillarFaultedIjkGrid::HorizontalPillarFaultedIjkGrid(EpcDocument* epcDoc, bool init)
+	: AbstractIjkGridRepresentationTest(epcDoc, defaultUuid, defaultTitle, nodesCountIjkGridRepresentation, nodesIjkGridRepresentation) {
+	if (init) {
+		this->initEpcDoc();
+	}
+	else {
+		this->readEpcDoc();
+	}
+}
+
+void HorizontalPillarFaultedIjkGrid::initEpcDocHandler() {
+	// getting the local depth 3d crs
+	LocalDepth3dCrsTest* crsTest = new LocalDepth3dCrsTest(this->epcDoc, true);
+	RESQML2_0_1_NS::LocalDepth3dCrs* crs = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::LocalDepth3dCrs>(LocalDepth3dCrsTest::defaultUuid);
+
+	// cleaning
+	delete crsTest;
+
+	// getting the hdf proxy
+	AbstractHdfProxy* hdfProxy = this->epcDoc->getHdfProxySet()[0];
+
+	// creating the ijk grid : the fault is between the two columns
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid = this->epcDoc->createIjkGridExplicitRepresentation(crs, uuid, title, 2, 1, 3);
+	REQUIRE(ijkGrid != nullptr);
+	unsigned int pillarOfCoordinateLine[2] = { 1, 4 };
+	unsigned int splitCoordinateLineColumnCumulativeCount[2] = { 1, 2 };
+	unsigned int splitCoordinateLineColumns[2] = { 1, 1 };
+	ijkGrid->setGeometryAsCoordinateLineNodes(gsoap_resqml2_0_1::resqml2__PillarShape__straight, gsoap_resqml2_0_1::resqml2__KDirection__not_x0020monotonic, false, this->xyzPointsOfAllPatchesInGlobalCrs, hdfProxy,
+		2, pillarOfCoordinateLine, splitCoordinateLineColumnCumulativeCount, splitCoordinateLineColumns);
+
+	// The middle cell of the second column is disabled
+	unsigned char enabledCells[6] = {
+		1, 1,
+		1, 0,
+		1, 1
+	};
+	ijkGrid->setEnabledCells(enabledCells);
+
+	// generating the grid connection set of the fault
+	ijkGrid->loadSplitInformation();
+	REQUIRE(ijkGrid->createFaultGridConnectionSet(faultGridConnectionSetUuid, "Fault grid connection set", hdfProxy) != nullptr);
+	ijkGrid->unloadSplitInformation();
+}
+
+void HorizontalPillarFaultedIjkGrid::readEpcDocHandler() {
+	RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridExplicitRepresentation>(uuid);
+	REQUIRE(ijkGrid->getCellCount() == 6);
+	REQUIRE(ijkGrid->getEnabledCellCount() == 5);
+
+	// The faces of both columns only differ along the pillars where Z is constant : they are ordered along the pillar axes.
+	// Without the disabled cell 3, cell 2 would also be connected to cell 3 and cell 4 to cell 3.
+	REQUIRE(ijkGrid->getGridConnectionSetRepresentationCount() == 1);
+	RESQML2_NS::GridConnectionSetRepresentation* gcs = ijkGrid->getGridConnectionSetRepresentation(0);
+	REQUIRE(gcs->getUuid() == faultGridConnectionSetUuid);
+	REQUIRE(gcs->getCellIndexPairCount() == 3);
+	ULONG64 cellIndexPairs[6];
+	gcs->getCellIndexPairs(cellIndexPairs);
+	int localFacePerCellIndexPairs[6];
+	gcs->getLocalFacePerCellIndexPairs(localFacePerCellIndexPairs);
+	const ULONG64 expectedCellIndexPairs[6] = {
+		0, 1,
+		2, 1,
+		4, 5
+	};
+	for (unsigned int i = 0; i < 6; ++i) {
+		REQUIRE(cellIndexPairs[i] == expectedCellIndexPairs[i]);
+		REQUIRE(localFacePerCellIndexPairs[i] == (i % 2 == 0 ? 3 : 5));
+	}
+
+	ijkGrid->loadSplitInformation();
+	REQUIRE(ijkGrid->isColumnEdgeSplitted(0, 0, 1));
+	std::vector<ULONG64> faultCellIndexPairs;
+	std::vector<int> faultLocalFacePerCellIndexPairs;
+	ijkGrid->getFaultConnections(faultCellIndexPairs, faultLocalFacePerCellIndexPairs);
+	ijkGrid->unloadSplitInformation();
+	REQUIRE(faultCellIndexPairs.size() == 6);
+	for (unsigned int i = 0; i < 6; ++i) {
+		REQUIRE(faultCellIndexPairs[i] == expectedCellIndexPairs[i]);
+	}
+}
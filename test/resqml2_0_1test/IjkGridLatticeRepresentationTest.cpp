@@ -0,0 +1,133 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/IjkGridLatticeRepresentationTest.h"
+
+#include "catch.hpp"
+#include "resqml2_0_1test/LocalDepth3dCrsTest.h"
+
+#include "resqml2_0_1/LocalDepth3dCrs.h"
+#include "resqml2_0_1/IjkGridLatticeRepresentation.h"
+
+using namespace std;
+using namespace COMMON_NS;
+using namespace resqml2_0_1test;
+using namespace RESQML2_NS;
+
+const char* IjkGridLatticeRepresentationTest::defaultUuid = "b0a5ad5b-3f47-4a07-9c4e-6e2d1f0c8a47";
+const char* IjkGridLatticeRepresentationTest::defaultTitle = "3x2x2 Lattice Ijk Grid";
+const ULONG64 IjkGridLatticeRepresentationTest::nodesCountIjkGridRepresentation = 36;
+double IjkGridLatticeRepresentationTest::nodesIjkGridRepresentation[] = {
+	0, 0, 300, 100, 0, 300, 200, 0, 300, 300, 0, 300, //IJ0K0
+	0, 50, 300, 100, 50, 300, 200, 50, 300, 300, 50, 300, //IJ1K0
+	0, 100, 300, 100, 100, 300, 200, 100, 300, 300, 100, 300, //IJ2K0
+	0, 0, 325, 100, 0, 325, 200, 0, 325, 300, 0, 325, //IJ0K1
+	0, 50, 325, 100, 50, 325, 200, 50, 325, 300, 50, 325, //IJ1K1
+	0, 100, 325, 100, 100, 325, 200, 100, 325, 300, 100, 325, //IJ2K1
+	0, 0, 350, 100, 0, 350, 200, 0, 350, 300, 0, 350, //IJ0K2
+	0, 50, 350, 100, 50, 350, 200, 50, 350, 300, 50, 350, //IJ1K2
+	0, 100, 350, 100, 100, 350, 200, 100, 350, 300, 100, 350 //IJ2K2
+};
+
+IjkGridLatticeRepresentationTest::IjkGridLatticeRepresentationTest(const string & epcDocPath)
+	: AbstractIjkGridRepresentationTest(epcDocPath, defaultUuid, defaultTitle, nodesCountIjkGridRepresentation, nodesIjkGridRepresentation) {
+}
+
+IjkGridLatticeRepresentationTest::IjkGridLatticeRepresentationTest(EpcDocument * epcDoc, bool init)
+	: AbstractIjkGridRepresentationTest(epcDoc, defaultUuid, defaultTitle, nodesCountIjkGridRepresentation, nodesIjkGridRepresentation) {
+	if (init)
+		this->initEpcDoc();
+	else
+		this->readEpcDoc();
+}
+
+void IjkGridLatticeRepresentationTest::initEpcDocHandler() {
+	// getting the local depth 3d crs
+	LocalDepth3dCrsTest* crsTest = new LocalDepth3dCrsTest(this->epcDoc, true);
+	RESQML2_0_1_NS::LocalDepth3dCrs* crs = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::LocalDepth3dCrs>(LocalDepth3dCrsTest::defaultUuid);
+
+	// creating the ijk grid
+	RESQML2_0_1_NS::IjkGridLatticeRepresentation* ijkGrid = this->epcDoc->createIjkGridLatticeRepresentation(crs, uuid, title, 3, 2, 2);
+	REQUIRE(ijkGrid != nullptr);
+	ijkGrid->setGeometryAsCoordinateLineNodes(gsoap_resqml2_0_1::resqml2__PillarShape__vertical, gsoap_resqml2_0_1::resqml2__KDirection__down, true,
+		0, 0, 300,
+		1, 0, 0, 100,
+		0, 1, 0, 50,
+		0, 0, 1, 25);
+
+	// cleaning
+	delete crsTest;
+}
+
+void IjkGridLatticeRepresentationTest::readEpcDocHandler() {
+	RESQML2_0_1_NS::IjkGridLatticeRepresentation* ijkGrid = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::IjkGridLatticeRepresentation>(this->uuid);
+	REQUIRE(ijkGrid->getCellCount() == 12);
+	REQUIRE(ijkGrid->hasArithmeticNodeIndexing());
+
+	// node indexing does not need the split information
+	REQUIRE(ijkGrid->getXyzPointIndexFromCellCorner(0, 0, 0, 0) == 0);
+	REQUIRE(ijkGrid->getXyzPointIndexFromCellCorner(2, 1, 1, 6) == 35);
+	REQUIRE(ijkGrid->getXyzPointIndexFromCellCorner(1, 1, 0, 4) == 17);
+	REQUIRE(!ijkGrid->isColumnEdgeSplitted(1, 1, 1));
+
+	// K interface sequence
+	double kInterfacePoints[24 * 3];
+	ijkGrid->getXyzPointsOfKInterfaceSequenceOfPatch(1, 2, 0, kInterfacePoints);
+	for (unsigned int index = 0; index < 24 * 3; ++index) {
+		REQUIRE(kInterfacePoints[index] == nodesIjkGridRepresentation[12 * 3 + index]);
+	}
+
+	// block : I interfaces 1 to 3, J interfaces 0 to 2, K interfaces 1 to 2
+	ijkGrid->loadBlockInformation(1, 3, 0, 2, 1, 2);
+	REQUIRE(ijkGrid->getXyzPointCountOfBlock() == 18);
+	REQUIRE(ijkGrid->getCellCountOfBlock() == 4);
+	double xyzPoints[18 * 3];
+	ijkGrid->getXyzPointsOfBlockOfPatch(0, xyzPoints);
+	ULONG64 cornerPointIndices[4 * 8];
+	ijkGrid->getXyzPointIndicesOfBlockCellCorners(cornerPointIndices);
+	double cellCenters[4 * 3];
+	ijkGrid->getCellCentersOfBlock(xyzPoints, cellCenters);
+	unsigned int cellIndex = 0;
+	for (unsigned int j = 0; j < 2; ++j) {
+		for (unsigned int i = 1; i < 3; ++i) {
+			double center[3] = { .0, .0, .0 };
+			for (unsigned int corner = 0; corner < 8; ++corner) {
+				// the block must give the same points as the whole grid
+				const ULONG64 globalPointIndex = ijkGrid->getXyzPointIndexFromCellCorner(i, j, 1, corner);
+				double x, y, z;
+				ijkGrid->getXyzPointOfBlockFromCellCorner(i, j, 1, corner, xyzPoints, x, y, z);
+				REQUIRE(x == nodesIjkGridRepresentation[3 * globalPointIndex]);
+				REQUIRE(y == nodesIjkGridRepresentation[3 * globalPointIndex + 1]);
+				REQUIRE(z == nodesIjkGridRepresentation[3 * globalPointIndex + 2]);
+				REQUIRE(x == xyzPoints[3 * cornerPointIndices[cellIndex * 8 + corner]]);
+				REQUIRE(y == xyzPoints[3 * cornerPointIndices[cellIndex * 8 + corner] + 1]);
+				REQUIRE(z == xyzPoints[3 * cornerPointIndices[cellIndex * 8 + corner] + 2]);
+				center[0] += x;
+				center[1] += y;
+				center[2] += z;
+			}
+			REQUIRE(cellCenters[cellIndex * 3] == Approx(center[0] / 8));
+			REQUIRE(cellCenters[cellIndex * 3 + 1] == Approx(center[1] / 8));
+			REQUIRE(cellCenters[cellIndex * 3 + 2] == Approx(center[2] / 8));
+			++cellIndex;
+		}
+	}
+	REQUIRE(cellCenters[0] == Approx(150));
+	REQUIRE(cellCenters[1] == Approx(25));
+	REQUIRE(cellCenters[2] == Approx(337.5));
+}
@@ -0,0 +1,128 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/InterpretedGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid.h"
+
+#include <limits>
+#include <stdexcept>
+
+#include "../config.h"
+#include "catch.hpp"
+#include "resqml2_0_1test/FaultInterpretationTest.h"
+
+#include "common/EpcDocument.h"
+#include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+#include "resqml2_0_1/FaultInterpretation.h"
+#include "resqml2/AbstractFeatureInterpretation.h"
+#include "resqml2/GridConnectionSetRepresentation.h"
+
+using namespace std;
+using namespace COMMON_NS;
+using namespace resqml2_0_1test;
+using namespace RESQML2_NS;
+
+const char* InterpretedGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid::defaultUuid = "91d72e73-70c9-4400-ba2a-754c3596d441";
+const char* InterpretedGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid::defaultTitle = "Interpreted grid connection set";
+
+void InterpretedGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid::initFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid, AbstractHdfProxy* hdfProxy) {
+	// getting the fault interpretation
+	FaultInterpretationTest* faultInterpTest = new FaultInterpretationTest(this->epcDoc, true);
+	RESQML2_0_1_NS::FaultInterpretation* faultInterp = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::FaultInterpretation>(uuidFaultInterpretation);
+	delete faultInterpTest;
+
+	// the fault only crosses the three middle rows of connections but connections 4 and 9, the first and last rows are boundary ones
+	RESQML2_NS::GridConnectionSetRepresentation* gcs = epcDoc->createGridConnectionSetRepresentation(uuid, title);
+	gcs->pushBackSupportingGridRepresentation(ijkGrid);
+	ULONG64 cellConn[30] = {
+		1, 9999, 5, 9999, 9, 9999,
+		1, 2, 5, 6, 9, 10,
+		13, 2, 17, 6, 21, 10,
+		13, 14, 17, 18, 21, 22,
+		9999, 14, 9999, 18, 9999, 22
+	};
+	gcs->setCellIndexPairs(15, cellConn, 9999, hdfProxy);
+	int localFacePerCellIndexPairs[30] = {
+		3, 9999, 3, 9999, 3, 9999,
+		3, 5, 3, 5, 3, 5,
+		3, 5, 3, 5, 3, 5,
+		3, 5, 3, 5, 3, 5,
+		9999, 5, 9999, 5, 9999, 5
+	};
+	gcs->setLocalFacePerCellIndexPairs(15, localFacePerCellIndexPairs, 9999, hdfProxy);
+	gcs->pushBackInterpretation(faultInterp);
+	unsigned int interpretationIndices[15] = {
+		9999, 9999, 9999,
+		0, 9999, 0,
+		0, 0, 0,
+		9999, 0, 0,
+		9999, 9999, 9999
+	};
+	gcs->setConnectionInterpretationIndices(interpretationIndices, 15, 9999, hdfProxy);
+}
+
+void InterpretedGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid::readFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid) {
+	RESQML2_NS::GridConnectionSetRepresentation* gcs = epcDoc->getResqmlAbstractObjectByUuid<RESQML2_NS::GridConnectionSetRepresentation>(uuid);
+	REQUIRE(gcs->getSupportingGridRepresentation(0) == ijkGrid);
+
+	REQUIRE(gcs->getCellIndexPairCount() == 15);
+	REQUIRE(gcs->getInterpretationCount() == 1);
+	REQUIRE(gcs->getInterpretationFromIndex(0)->getUuid() == uuidFaultInterpretation);
+	REQUIRE(gcs->getCellIndexPairCountFromInterpretationIndex(0) == 7);
+
+	ULONG64 connectionIndices[7];
+	gcs->getConnectionIndicesFromInterpretationIndex(connectionIndices, 0);
+	const ULONG64 expectedConnectionIndices[7] = { 3, 5, 6, 7, 8, 10, 11 };
+	for (ULONG64 i = 0; i < 7; ++i) {
+		REQUIRE(connectionIndices[i] == expectedConnectionIndices[i]);
+	}
+
+	// the pairs are gathered from the three runs of connections of the fault
+	ULONG64 faultCellIndexPairs[14];
+	int faultLocalFacePerCellIndexPairs[14];
+	gcs->getGridConnectionSetInformationFromInterpretationIndex(faultCellIndexPairs, nullptr, faultLocalFacePerCellIndexPairs, 0);
+	REQUIRE(faultCellIndexPairs[0] == 1);
+	REQUIRE(faultCellIndexPairs[1] == 2);
+	REQUIRE(faultCellIndexPairs[2] == 9);
+	REQUIRE(faultCellIndexPairs[3] == 10);
+	REQUIRE(faultCellIndexPairs[4] == 13);
+	REQUIRE(faultCellIndexPairs[5] == 2);
+	REQUIRE(faultCellIndexPairs[8] == 21);
+	REQUIRE(faultCellIndexPairs[9] == 10);
+	REQUIRE(faultCellIndexPairs[10] == 17);
+	REQUIRE(faultCellIndexPairs[11] == 18);
+	REQUIRE(faultCellIndexPairs[12] == 21);
+	REQUIRE(faultCellIndexPairs[13] == 22);
+	REQUIRE(faultLocalFacePerCellIndexPairs[0] == 3);
+	REQUIRE(faultLocalFacePerCellIndexPairs[13] == 5);
+
+	// a second read is served by the cached connection indices
+	ULONG64 faultCellIndexPairsAgain[14];
+	gcs->getGridConnectionSetInformationFromInterpretationIndex(faultCellIndexPairsAgain, nullptr, nullptr, 0);
+	for (unsigned int i = 0; i < 14; ++i) {
+		REQUIRE(faultCellIndexPairsAgain[i] == faultCellIndexPairs[i]);
+	}
+
+	// out of range interpretation indices
+	REQUIRE_THROWS_AS(gcs->getCellIndexPairCountFromInterpretationIndex(1), range_error);
+	REQUIRE_THROWS_AS(gcs->getConnectionIndicesFromInterpretationIndex(connectionIndices, (numeric_limits<unsigned int>::max)()), range_error);
+	REQUIRE_THROWS_AS(gcs->getGridConnectionSetInformationFromInterpretationIndex(faultCellIndexPairs, nullptr, nullptr, 1), range_error);
+
+	// as getGridIndexPairs, grid index pairs cannot be asked to a single grid connection set
+	unsigned short faultGridIndexPairs[14];
+	REQUIRE_THROWS_AS(gcs->getGridConnectionSetInformationFromInterpretationIndex(faultCellIndexPairs, faultGridIndexPairs, nullptr, 0), invalid_argument);
+}
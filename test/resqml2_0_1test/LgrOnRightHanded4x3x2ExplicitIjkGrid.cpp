@@ -28,8 +28,10 @@ under the License.
 #include "common/EpcDocument.h"
 #include "resqml2_0_1/LocalDepth3dCrs.h"
 #include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+#include "tools/Parallel.h"
 #include "resqml2_0_1/DiscreteProperty.h"
 #include "resqml2_0_1/ContinuousProperty.h"
+#include "resqml2/LocalGridRefinementMapping.h"
 
 using namespace std;
 using namespace resqml2_0_1test;
@@ -133,6 +135,52 @@ void LgrOnRightHanded4x3x2ExplicitIjkGrid::readEpcDocHandler() {
 	REQUIRE(childGrid->getRegridConstantCellCountPerInterval('j', false) == 1);
 	REQUIRE(childGrid->getRegridConstantCellCountPerInterval('k', false) == 1);
 
+	// Mapping
+	LocalGridRefinementMapping mapping(childGrid);
+	REQUIRE(mapping.getChildCellCount() == 12);
+	REQUIRE(mapping.getParentCellCount() == 24);
+	REQUIRE(mapping.getOverlapCount() == 12);
+	REQUIRE(mapping.isParentCellRefined(0));
+	REQUIRE(!mapping.isParentCellRefined(1));
+	REQUIRE(mapping.isParentCellRefined(12));
+	REQUIRE(mapping.getChildCellCountOfParentCell(12) == 6);
+	ULONG64 childCellIndices[4] = { 0, 5, 6, 11 };
+	ULONG64 parentCellIndices[4];
+	mapping.getParentCellIndices(childCellIndices, 4, parentCellIndices);
+	REQUIRE(parentCellIndices[0] == 0);
+	REQUIRE(parentCellIndices[1] == 0);
+	REQUIRE(parentCellIndices[2] == 12);
+	REQUIRE(parentCellIndices[3] == 12);
+
+	double childValues[12] = { 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.5, 0.4, 0.3, 0.2, 0.1, 0.0 };
+	double parentValues[24];
+	for (unsigned int i = 0; i < 24; ++i) {
+		parentValues[i] = i;
+	}
+	mapping.downscale(parentValues, childValues);
+	REQUIRE(childValues[5] == 0);
+	REQUIRE(childValues[6] == 12);
+	mapping.upscale(childValues, parentValues, LocalGridRefinementMapping::EXTENSIVE);
+	REQUIRE(parentValues[0] == 0);
+	REQUIRE(parentValues[1] == 1);
+	REQUIRE(parentValues[12] == Approx(72));
+
+	// The same transfers shared between several threads
+	parallel::setMaxThreadCount(4);
+	parallel::setMinItemCountPerThread(1);
+	for (unsigned int i = 0; i < 24; ++i) {
+		parentValues[i] = i;
+	}
+	mapping.downscale(parentValues, childValues);
+	REQUIRE(childValues[5] == 0);
+	REQUIRE(childValues[6] == 12);
+	mapping.upscale(childValues, parentValues, LocalGridRefinementMapping::EXTENSIVE);
+	REQUIRE(parentValues[0] == 0);
+	REQUIRE(parentValues[1] == 1);
+	REQUIRE(parentValues[12] == Approx(72));
+	parallel::setMaxThreadCount(0);
+	parallel::setMinItemCountPerThread(0);
+
 	delete parentGridTest;
 }
 
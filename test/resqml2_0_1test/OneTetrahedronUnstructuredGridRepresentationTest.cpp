@@ -22,8 +22,10 @@ under the License.
 #include "LocalDepth3dCrsTest.h"
 #include "resqml2_0_1/LocalDepth3dCrs.h"
 #include "common/EpcDocument.h"
+#include "common/GeometryCache.h"
 #include "common/AbstractHdfProxy.h"
 #include "resqml2_0_1/UnstructuredGridRepresentation.h"
+#include "tools/Parallel.h"
 
 using namespace std;
 using namespace COMMON_NS;
@@ -53,7 +55,8 @@ void OneTetrahedronUnstructuredGridRepresentationTest::initEpcDocHandler() {
 	// creating the unstructured grid
 	RESQML2_0_1_NS::UnstructuredGridRepresentation* tetraGrid = this->epcDoc->createUnstructuredGridRepresentation(crs, this->uuid, this->title, 1);
 	REQUIRE(tetraGrid != nullptr);
-	unsigned char faceRightHandness[4] = { 0, 0, 1, 1 };
+	// the normals of the faces 1 and 2 follow the right hand rule outward the cell
+	unsigned char faceRightHandness[4] = { 0, 1, 1, 0 };
 	ULONG64 faceIndicesPerCell[4] = { 0, 1, 2, 3 };
 	ULONG64 nodeIndicesPerCell[12] = { 0, 1, 2, 1, 2, 3, 0, 1, 3, 0, 2, 3 };
 	tetraGrid->setTetrahedraOnlyGeometry(faceRightHandness, this->xyzPointsOfAllPatchesInGlobalCrs, 4, 4, hdfProxy, faceIndicesPerCell, nodeIndicesPerCell);
@@ -181,11 +184,89 @@ void OneTetrahedronUnstructuredGridRepresentationTest::readEpcDocHandler() {
 	// getNodeCount
 	REQUIRE( unstructuredGrid->getNodeCount() == 4);
 
-	// TODO: not able to test since method is not yet implemented
-	//unstructuredGrid->getCellFaceIsRightHanded(cellFaceIsRightHanded);
+	// getCellFaceIsRightHanded
+	unsigned char cellFaceIsRightHanded[4];
+	unstructuredGrid->getCellFaceIsRightHanded(cellFaceIsRightHanded);
+	REQUIRE( cellFaceIsRightHanded[0] == 0 );
+	REQUIRE( cellFaceIsRightHanded[1] == 1 );
+	REQUIRE( cellFaceIsRightHanded[2] == 1 );
+	REQUIRE( cellFaceIsRightHanded[3] == 0 );
+
+	// the geometry is owned by the geometry cache : the returned pointers pin it until it is unpinned, then it is transparently reloaded once evicted
+	COMMON_NS::GeometryCache* geometryCache = this->epcDoc->getGeometryCache();
+	REQUIRE( geometryCache->getEntryCount() == 1 );
+	REQUIRE( geometryCache->getByteSize() > 0 );
+	geometryCache->setByteBudget(1);
+	REQUIRE( geometryCache->getEntryCount() == 0 );
+	REQUIRE( nodeIndicesOfFourthFace[2] == 3 );
+	REQUIRE( unstructuredGrid->getNodeIndicesOfFaceOfCell(0, 3) == nodeIndicesOfFourthFace );
+	REQUIRE( geometryCache->getEntryCount() == 0 );
+	unstructuredGrid->unpinGeometry();
+	REQUIRE( unstructuredGrid->getNodeIndicesOfFaceOfCell(0, 3)[2] == 3 );
+	REQUIRE( geometryCache->getEntryCount() == 1 );
+	geometryCache->setByteBudget(0);
+
+	// face to cell and cell adjacency
+	REQUIRE_THROWS_AS( unstructuredGrid->getCellCountOfFace(4), range_error );
+	REQUIRE( unstructuredGrid->getCellCountOfFace(3) == 1 );
+	REQUIRE( unstructuredGrid->getCellIndicesOfFace(3)[0] == 0 );
+	REQUIRE( unstructuredGrid->getNeighborCountOfCell(0) == 0 );
+	REQUIRE( unstructuredGrid->getCellAdjacencyCount() == 0 );
+	REQUIRE( geometryCache->getEntryCount() == 2 );
+
+	// face geometry
+	double faceAreas[4];
+	double faceNormals[12];
+	double faceCentroids[12];
+	unstructuredGrid->computeFaceGeometry(faceAreas, faceNormals, faceCentroids);
+	REQUIRE( faceAreas[0] == Approx(52633.758) );
+	REQUIRE( faceNormals[0] == Approx(-0.0712470) );
+	REQUIRE( faceNormals[1] == Approx(0) );
+	REQUIRE( faceNormals[2] == Approx(0.9974587) );
+	REQUIRE( faceCentroids[0] == Approx(700.0 / 3) );
+	REQUIRE( faceCentroids[1] == Approx(50) );
+	REQUIRE( faceCentroids[2] == Approx(950.0 / 3) );
+	REQUIRE( faceAreas[2] == Approx(70000) );
+	REQUIRE( faceNormals[7] == Approx(-1) );
+
+	// cell geometry : a tetrahedron is 1/6 of the parallelepiped built on its edges and its centroid is the average of its nodes
+	double cellVolume;
+	double cellCentroid[3];
+	unstructuredGrid->computeCellGeometry(&cellVolume, cellCentroid);
+	REQUIRE( cellVolume == Approx(700.0 * 150 * 200 / 6) );
+	REQUIRE( cellCentroid[0] == Approx(175) );
+	REQUIRE( cellCentroid[1] == Approx(37.5) );
+	REQUIRE( cellCentroid[2] == Approx(362.5) );
+
+	// same face geometry when the faces are shared between threads
+	double threadedFaceAreas[4];
+	double threadedFaceCentroids[12];
+	parallel::setMaxThreadCount(4);
+	parallel::setMinItemCountPerThread(1);
+	unstructuredGrid->computeFaceGeometry(threadedFaceAreas, nullptr, threadedFaceCentroids);
+	parallel::setMaxThreadCount(0);
+	parallel::setMinItemCountPerThread(0);
+	for (unsigned int face = 0; face < 4; ++face) {
+		REQUIRE( threadedFaceAreas[face] == faceAreas[face] );
+		REQUIRE( threadedFaceCentroids[3 * face + 2] == faceCentroids[3 * face + 2] );
+	}
 
 	// unloading geometry
 	unstructuredGrid->unloadGeometry();
+	REQUIRE( geometryCache->getEntryCount() == 0 );
+
+	// 32 bits indices
+	unstructuredGrid->loadGeometry(true);
+	REQUIRE( unstructuredGrid->isGeometryIndexedIn32Bits() );
+	REQUIRE_THROWS_AS( unstructuredGrid->getNodeIndicesOfFaceOfCell(0, 0), logic_error );
+	const unsigned int* uintNodeIndicesOfFourthFace = unstructuredGrid->getUIntNodeIndicesOfFaceOfCell(0, 3);
+	REQUIRE( uintNodeIndicesOfFourthFace[0] == 0 );
+	REQUIRE( uintNodeIndicesOfFourthFace[1] == 2 );
+	REQUIRE( uintNodeIndicesOfFourthFace[2] == 3 );
+	REQUIRE( unstructuredGrid->getNodeCountOfFaceOfCell(0, 3) == 3 );
+	REQUIRE( unstructuredGrid->getCellIndicesOfFace(2)[0] == 0 );
+	unstructuredGrid->unloadGeometry();
+	REQUIRE( !unstructuredGrid->isGeometryIndexedIn32Bits() );
 
 	// getPatchCount
 	REQUIRE( unstructuredGrid->getPatchCount() == 1);
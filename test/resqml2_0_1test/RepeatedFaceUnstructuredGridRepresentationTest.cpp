@@ -0,0 +1,123 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "RepeatedFaceUnstructuredGridRepresentationTest.h"
+
+#include "../catch.hpp"
+#include "LocalDepth3dCrsTest.h"
+#include "resqml2_0_1/LocalDepth3dCrs.h"
+#include "common/EpcDocument.h"
+#include "common/AbstractHdfProxy.h"
+#include "resqml2_0_1/UnstructuredGridRepresentation.h"
+#include "tools/Parallel.h"
+
+using namespace std;
+using namespace COMMON_NS;
+using namespace resqml2_0_1test;
+
+const char* RepeatedFaceUnstructuredGridRepresentationTest::defaultUuid = "3c1ea85b-c6b6-4000-bacf-590f0e9fb1d5";
+const char* RepeatedFaceUnstructuredGridRepresentationTest::defaultTitle = "Repeated Face Unstructured Grid Representation Test";
+const ULONG64 RepeatedFaceUnstructuredGridRepresentationTest::nodesCount = 5;
+double RepeatedFaceUnstructuredGridRepresentationTest::nodes[] = { 0, 0, 300, 100, 0, 300, 0, 100, 300, 0, 0, 400, 0, 0, 200 };
+
+RepeatedFaceUnstructuredGridRepresentationTest::RepeatedFaceUnstructuredGridRepresentationTest(const string & epcDocPath)
+	: UnstructuredGridRepresentationTest(epcDocPath, defaultUuid, defaultTitle, nodesCount, nodes) {
+}
+
+RepeatedFaceUnstructuredGridRepresentationTest::RepeatedFaceUnstructuredGridRepresentationTest(EpcDocument * epcDoc, bool init)
+	: UnstructuredGridRepresentationTest(epcDoc, defaultUuid, defaultTitle, nodesCount, nodes) {
+	if (init)
+		this->initEpcDoc();
+	else
+		this->readEpcDoc();
+}
+
+void RepeatedFaceUnstructuredGridRepresentationTest::initEpcDocHandler() {
+	// getting the local depth 3d crs
+	LocalDepth3dCrsTest* crsTest = new LocalDepth3dCrsTest(this->epcDoc, true);
+	RESQML2_0_1_NS::LocalDepth3dCrs* crs = static_cast<RESQML2_0_1_NS::LocalDepth3dCrs*>(this->epcDoc->getResqmlAbstractObjectByUuid(LocalDepth3dCrsTest::defaultUuid));
+
+	// getting the hdf proxy
+	AbstractHdfProxy* hdfProxy = this->epcDoc->getHdfProxySet()[0];
+
+	// creating the unstructured grid : the second cell lists the shared face 0 twice instead of its own bottom face
+	RESQML2_0_1_NS::UnstructuredGridRepresentation* tetraGrid = this->epcDoc->createUnstructuredGridRepresentation(crs, this->uuid, this->title, 2);
+	REQUIRE(tetraGrid != nullptr);
+	unsigned char faceRightHandness[8] = { 0, 0, 1, 1, 1, 0, 0, 1 };
+	ULONG64 faceIndicesPerCell[8] = { 0, 1, 2, 3, 0, 4, 5, 0 };
+	ULONG64 nodeIndicesPerFace[18] = { 0, 1, 2, 0, 1, 3, 0, 2, 3, 1, 2, 3, 0, 1, 4, 0, 2, 4 };
+	tetraGrid->setTetrahedraOnlyGeometry(faceRightHandness, this->xyzPointsOfAllPatchesInGlobalCrs, 5, 6, hdfProxy, faceIndicesPerCell, nodeIndicesPerFace);
+
+	// cleaning
+	delete crsTest;
+}
+
+void RepeatedFaceUnstructuredGridRepresentationTest::readEpcDocHandler() {
+	// reading the local depth 3d crs
+	LocalDepth3dCrsTest* crsTest = new LocalDepth3dCrsTest(this->epcDoc, false);
+
+	// getting the unstructured grid
+	RESQML2_0_1_NS::UnstructuredGridRepresentation * unstructuredGrid = static_cast<RESQML2_0_1_NS::UnstructuredGridRepresentation*>(this->epcDoc->getResqmlAbstractObjectByUuid(defaultUuid));
+	REQUIRE( unstructuredGrid->getCellCount() == 2 );
+	REQUIRE( unstructuredGrid->getFaceCount() == 6 );
+
+	unstructuredGrid->loadGeometry();
+
+	// the repeated face is only bucketed once for the second cell
+	REQUIRE( unstructuredGrid->getCellCountOfFace(0) == 2 );
+	REQUIRE( unstructuredGrid->getCellIndicesOfFace(0)[0] == 0 );
+	REQUIRE( unstructuredGrid->getCellIndicesOfFace(0)[1] == 1 );
+	ULONG64 cumulativeCellCountPerFace[6];
+	ULONG64 cellIndicesOfFaces[7];
+	unstructuredGrid->getCellIndicesOfFaces(cumulativeCellCountPerFace, cellIndicesOfFaces);
+	REQUIRE( cumulativeCellCountPerFace[0] == 2 );
+	REQUIRE( cumulativeCellCountPerFace[3] == 5 );
+	REQUIRE( cumulativeCellCountPerFace[5] == 7 );
+	REQUIRE( cellIndicesOfFaces[5] == 1 );
+	REQUIRE( cellIndicesOfFaces[6] == 1 );
+
+	// and gives a single neighbor
+	REQUIRE( unstructuredGrid->getCellAdjacencyCount() == 2 );
+	REQUIRE( unstructuredGrid->getNeighborCountOfCell(0) == 1 );
+	REQUIRE( unstructuredGrid->getNeighborCountOfCell(1) == 1 );
+	REQUIRE( unstructuredGrid->getNeighborCellIndicesOfCell(0)[0] == 1 );
+	REQUIRE( unstructuredGrid->getNeighborCellIndicesOfCell(1)[0] == 0 );
+	REQUIRE( unstructuredGrid->getNeighborFaceIndicesOfCell(1)[0] == 0 );
+
+	unstructuredGrid->unloadGeometry();
+
+	// the same maps built by one thread per cell : the face buckets remain ordered by increasing cell index
+	parallel::setMaxThreadCount(2);
+	parallel::setMinItemCountPerThread(1);
+	unstructuredGrid->loadGeometry();
+	unstructuredGrid->getCellIndicesOfFaces(cumulativeCellCountPerFace, cellIndicesOfFaces);
+	parallel::setMaxThreadCount(0);
+	parallel::setMinItemCountPerThread(0);
+	REQUIRE( cumulativeCellCountPerFace[0] == 2 );
+	REQUIRE( cumulativeCellCountPerFace[3] == 5 );
+	REQUIRE( cumulativeCellCountPerFace[5] == 7 );
+	REQUIRE( cellIndicesOfFaces[0] == 0 );
+	REQUIRE( cellIndicesOfFaces[1] == 1 );
+	REQUIRE( unstructuredGrid->getNeighborCellIndicesOfCell(0)[0] == 1 );
+	REQUIRE( unstructuredGrid->getNeighborCellIndicesOfCell(1)[0] == 0 );
+
+	unstructuredGrid->unloadGeometry();
+
+	// cleaning
+	delete crsTest;
+}
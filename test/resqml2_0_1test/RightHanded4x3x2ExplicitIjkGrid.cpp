@@ -141,5 +141,69 @@ void RightHanded4x3x2ExplicitIjkGrid::readEpcDocHandler() {
 	REQUIRE(ijkGrid->getGridConnectionSetRepresentation(0)->getUuid() == "a3d1462a-04e3-4374-921b-a4a1e9ba3ea3");
 	REQUIRE(ijkGrid->getGridConnectionSetRepresentation(0)->getCellIndexPairCount() == 15);
 	REQUIRE(ijkGrid->getGridConnectionSetRepresentation(0)->getSupportingGridRepresentation(0) == ijkGrid);
+
+	// enabled cells
+	indexing::BitSet enabledCells;
+	ijkGrid->getEnabledCells(enabledCells);
+	REQUIRE(enabledCells.size() == 24);
+	REQUIRE(enabledCells.count() == 22);
+	REQUIRE(ijkGrid->getEnabledCellCount() == 22);
+	REQUIRE(!enabledCells.test(11));
+	REQUIRE(enabledCells.globalToActive(12) == 11);
+	REQUIRE(enabledCells.activeToGlobal(21) == 22);
+
+	// block cell geometry
+	REQUIRE(!ijkGrid->hasArithmeticNodeIndexing());
+	ijkGrid->loadSplitInformation();
+	ijkGrid->loadBlockInformation(0, 4, 0, 3, 0, 2);
+	REQUIRE(ijkGrid->getCellCountOfBlock() == 24);
+	double* xyzPoints = new double[ijkGrid->getXyzPointCountOfBlock() * 3];
+	ijkGrid->getXyzPointsOfBlockOfPatch(0, xyzPoints);
+	ULONG64 cornerPointIndices[24 * 8];
+	ijkGrid->getXyzPointIndicesOfBlockCellCorners(cornerPointIndices);
+	double cellCenters[24 * 3];
+	ijkGrid->getCellCentersOfBlock(xyzPoints, cellCenters);
+	double cornerXyzPoints[24 * 8 * 3];
+	unsigned int cellIndex = 0;
+	for (unsigned int k = 0; k < 2; ++k) {
+		for (unsigned int j = 0; j < 3; ++j) {
+			for (unsigned int i = 0; i < 4; ++i) {
+				double zSum = .0;
+				for (unsigned int corner = 0; corner < 8; ++corner) {
+					double x, y, z;
+					ijkGrid->getXyzPointOfBlockFromCellCorner(i, j, k, corner, xyzPoints, x, y, z);
+					REQUIRE(x == xyzPoints[3 * cornerPointIndices[cellIndex * 8 + corner]]);
+					REQUIRE(z == xyzPoints[3 * cornerPointIndices[cellIndex * 8 + corner] + 2]);
+					cornerXyzPoints[(cellIndex * 8 + corner) * 3] = x;
+					cornerXyzPoints[(cellIndex * 8 + corner) * 3 + 1] = y;
+					cornerXyzPoints[(cellIndex * 8 + corner) * 3 + 2] = z;
+					zSum += z;
+				}
+				REQUIRE(cellCenters[cellIndex * 3 + 2] == Approx(zSum / 8));
+				++cellIndex;
+			}
+		}
+	}
+	delete[] xyzPoints;
+
+	// sub block geometry must be the same as the whole grid one
+	ijkGrid->loadBlockInformation(1, 3, 1, 3, 1, 2);
+	xyzPoints = new double[ijkGrid->getXyzPointCountOfBlock() * 3];
+	ijkGrid->getXyzPointsOfBlockOfPatch(0, xyzPoints);
+	for (unsigned int j = 1; j < 3; ++j) {
+		for (unsigned int i = 1; i < 3; ++i) {
+			cellIndex = i + j * 4 + 12;
+			for (unsigned int corner = 0; corner < 8; ++corner) {
+				double x, y, z;
+				ijkGrid->getXyzPointOfBlockFromCellCorner(i, j, 1, corner, xyzPoints, x, y, z);
+				REQUIRE(x == cornerXyzPoints[(cellIndex * 8 + corner) * 3]);
+				REQUIRE(y == cornerXyzPoints[(cellIndex * 8 + corner) * 3 + 1]);
+				REQUIRE(z == cornerXyzPoints[(cellIndex * 8 + corner) * 3 + 2]);
+			}
+		}
+	}
+	delete[] xyzPoints;
+
+	ijkGrid->unloadSplitInformation();
 }
 
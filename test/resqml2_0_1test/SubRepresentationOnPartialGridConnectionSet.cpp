@@ -55,6 +55,9 @@ void SubRepresentationOnPartialGridConnectionSet::initEpcDocHandler()
 
 	ULONG64 elements[2] = { 1, 2 };
 	subRep->pushBackSubRepresentationPatch(gsoap_resqml2_0_1::resqml2__IndexableElements__cells, 2, elements, hdfProxy);
+
+	// lattice patch whose unit offsets overlap each other
+	subRep->pushBackSubRepresentationPatch(gsoap_resqml2_0_1::resqml2__IndexableElements__cells, 60000, 2, 3, 40000);
 }
 
 void SubRepresentationOnPartialGridConnectionSet::readEpcDocHandler()
@@ -66,5 +69,35 @@ void SubRepresentationOnPartialGridConnectionSet::readEpcDocHandler()
 	REQUIRE(subRep->getSupportingRepresentation(0)->getXmlTag().compare("GridConnectionSetRepresentation") == 0);
 	REQUIRE(subRep->getSupportingRepresentation(0)->getUuid().compare("00a7d22f-4746-409b-87dc-5bdb83660d27") == 0);
 	REQUIRE(subRep->getSupportingRepresentation(0)->getTitle().compare("GCSR") == 0);
+
+	// compressed element indices
+	indexing::IndexSet elementIndices;
+	subRep->getElementIndicesOfPatch(0, 0, elementIndices);
+	REQUIRE(elementIndices.count() == 2);
+	REQUIRE(!elementIndices.contains(0));
+	REQUIRE(elementIndices.contains(1));
+	REQUIRE(elementIndices.contains(2));
+	REQUIRE(*elementIndices.begin() == 1);
+	indexing::IndexSet range;
+	range.addRange(2, 100000);
+	range &= elementIndices;
+	REQUIRE(range.count() == 1);
+	REQUIRE(range.contains(2));
+
+	// compressed lattice element indices : the runs of the odometer are merged across two chunks
+	REQUIRE(subRep->areElementIndicesBasedOnLattice(1));
+	indexing::IndexSet latticeIndices;
+	subRep->getElementIndicesOfPatch(1, 0, latticeIndices);
+	REQUIRE(latticeIndices.count() == 40003);
+	REQUIRE(!latticeIndices.contains(59999));
+	REQUIRE(latticeIndices.contains(65535));
+	REQUIRE(latticeIndices.contains(100002));
+	REQUIRE(!latticeIndices.contains(100003));
+	REQUIRE(latticeIndices.getByteSize() < 1024);
+	std::vector< std::pair<uint64_t, uint64_t> > ranges;
+	latticeIndices.getRanges(ranges);
+	REQUIRE(ranges.size() == 1);
+	REQUIRE(ranges[0].first == 60000);
+	REQUIRE(ranges[0].second == 100003);
 }
 
@@ -0,0 +1,235 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/TransmissibilityOnRightHanded4x3x2ExplicitIjkGrid.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "catch.hpp"
+
+#include "common/EpcDocument.h"
+#include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+#include "resqml2_0_1/ContinuousProperty.h"
+#include "resqml2/GridConnectionSetRepresentation.h"
+#include "resqml2/GridConnectionGeometry.h"
+#include "tools/Parallel.h"
+
+using namespace std;
+using namespace COMMON_NS;
+using namespace RESQML2_NS;
+using namespace resqml2_0_1test;
+
+const char* TransmissibilityOnRightHanded4x3x2ExplicitIjkGrid::defaultUuid = "1271f17c-06e1-4f74-91a9-630889947ddd";
+const char* TransmissibilityOnRightHanded4x3x2ExplicitIjkGrid::defaultTitle = "Transmissibility";
+
+namespace {
+	const char* gridConnectionSetUuid = "a3d1462a-04e3-4374-921b-a4a1e9ba3ea3";
+	const char* overlapAreaUuid = "22ae7bc7-72db-40ef-ab48-a81b00727060";
+	const char* permeabilityIUuid = "5bc226ae-d92e-4eb9-bd1f-ea2812731523";
+	const char* permeabilityJUuid = "8b9f4c3a-4c6b-4163-86e2-9a4d034e6759";
+	const char* permeabilityKUuid = "153a0184-f55c-4a1d-9e3a-0aa4f01526c7";
+	const char* netToGrossUuid = "0145b3ea-c805-439e-92d3-92ffb7ef8050";
+	const double darcyConstant = 0.5;
+
+	RESQML2_0_1_NS::ContinuousProperty* createCellProperty(EpcDocument* epcDoc, RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid, const string & guid, const string & title,
+		const gsoap_resqml2_0_1::resqml2__ResqmlUom & uom, const gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind & kind, double * values, AbstractHdfProxy* hdfProxy)
+	{
+		RESQML2_0_1_NS::ContinuousProperty* result = epcDoc->createContinuousProperty(ijkGrid, guid, title, 1,
+			gsoap_resqml2_0_1::resqml2__IndexableElements__cells, uom, kind);
+		result->pushBackDoubleHdf5Array3dOfValues(values, 4, 3, 2, hdfProxy);
+		return result;
+	}
+
+	/**
+	* The I permeability is 100 times the I index plus one, the net to gross ratio is 0.5 in cell 1 and the I permeability of cell 5 is NaN.
+	*/
+	double getPermeabilityI(const ULONG64 & cellIndex)
+	{
+		return cellIndex == 5 ? numeric_limits<double>::quiet_NaN() : 100.0 * (cellIndex % 4 + 1);
+	}
+
+	double getNetToGross(const ULONG64 & cellIndex)
+	{
+		return cellIndex == 1 ? 0.5 : 1.0;
+	}
+}
+
+void TransmissibilityOnRightHanded4x3x2ExplicitIjkGrid::initFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid, AbstractHdfProxy* hdfProxy) {
+	// the grid connection set of the faulted grid
+	GridConnectionSetRepresentation* gcs = this->epcDoc->getResqmlAbstractObjectByUuid<GridConnectionSetRepresentation>(gridConnectionSetUuid);
+
+	// cell properties
+	double permeabilityIValues[24];
+	double permeabilityJValues[24];
+	double permeabilityKValues[24];
+	double netToGrossValues[24];
+	for (ULONG64 cell = 0; cell < 24; ++cell) {
+		permeabilityIValues[cell] = getPermeabilityI(cell);
+		permeabilityJValues[cell] = 50;
+		permeabilityKValues[cell] = 10;
+		netToGrossValues[cell] = getNetToGross(cell);
+	}
+	RESQML2_0_1_NS::ContinuousProperty* permeabilityI = createCellProperty(this->epcDoc, ijkGrid, permeabilityIUuid, "Permeability I",
+		gsoap_resqml2_0_1::resqml2__ResqmlUom__mD, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__permeability_x0020rock, permeabilityIValues, hdfProxy);
+	RESQML2_0_1_NS::ContinuousProperty* permeabilityJ = createCellProperty(this->epcDoc, ijkGrid, permeabilityJUuid, "Permeability J",
+		gsoap_resqml2_0_1::resqml2__ResqmlUom__mD, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__permeability_x0020rock, permeabilityJValues, hdfProxy);
+	RESQML2_0_1_NS::ContinuousProperty* permeabilityK = createCellProperty(this->epcDoc, ijkGrid, permeabilityKUuid, "Permeability K",
+		gsoap_resqml2_0_1::resqml2__ResqmlUom__mD, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__permeability_x0020rock, permeabilityKValues, hdfProxy);
+	RESQML2_0_1_NS::ContinuousProperty* netToGross = createCellProperty(this->epcDoc, ijkGrid, netToGrossUuid, "Net to gross",
+		gsoap_resqml2_0_1::resqml2__ResqmlUom__Euc, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__net_x0020to_x0020gross_x0020ratio, netToGrossValues, hdfProxy);
+
+	// connection properties
+	ijkGrid->loadSplitInformation();
+	GridConnectionGeometry connectionGeometry(gcs);
+	ijkGrid->unloadSplitInformation();
+	REQUIRE(connectionGeometry.createOverlapAreaProperty(overlapAreaUuid, "Overlap area", gsoap_resqml2_0_1::resqml2__ResqmlUom__m2, hdfProxy) != nullptr);
+	double transmissibilities[15];
+	connectionGeometry.computeTransmissibilities(transmissibilities, permeabilityI, permeabilityJ, permeabilityK, netToGross, darcyConstant);
+	REQUIRE(connectionGeometry.createTransmissibilityProperty(uuid, title, transmissibilities, gsoap_resqml2_0_1::resqml2__ResqmlUom__Euc, hdfProxy) != nullptr);
+}
+
+void TransmissibilityOnRightHanded4x3x2ExplicitIjkGrid::readFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid) {
+	GridConnectionSetRepresentation* gcs = this->epcDoc->getResqmlAbstractObjectByUuid<GridConnectionSetRepresentation>(gridConnectionSetUuid);
+	ULONG64 cellIndexPairs[30];
+	gcs->getCellIndexPairs(cellIndexPairs);
+
+	// connection geometry : the fault faces of both sides are shifted by half a cell thickness
+	ijkGrid->loadSplitInformation();
+	GridConnectionGeometry connectionGeometry(gcs);
+	ijkGrid->unloadSplitInformation();
+	REQUIRE(connectionGeometry.getConnectionCount() == 15);
+	double overlapAreas[15];
+	connectionGeometry.getOverlapAreas(overlapAreas);
+	double overlapCentroids[45];
+	connectionGeometry.getOverlapCentroids(overlapCentroids);
+	double overlapNormals[45];
+	connectionGeometry.getOverlapNormals(overlapNormals);
+	for (unsigned int connection = 0; connection < 15; ++connection) {
+		if (connection < 3 || connection >= 12) {
+			// boundary connections
+			REQUIRE(overlapAreas[connection] == 0);
+			REQUIRE(connectionGeometry.getOverlapPolygonVertexCount(connection) == 0);
+		}
+		else {
+			REQUIRE(overlapAreas[connection] == Approx(2500));
+			REQUIRE(overlapCentroids[connection * 3] == Approx(375));
+			REQUIRE(overlapNormals[connection * 3] == Approx(1));
+			REQUIRE(overlapNormals[connection * 3 + 1] == Approx(0).margin(1e-12));
+			REQUIRE(overlapNormals[connection * 3 + 2] == Approx(0).margin(1e-12));
+			REQUIRE(connectionGeometry.getOverlapPolygonVertexCount(connection) == 4);
+		}
+	}
+	REQUIRE(overlapCentroids[10] == Approx(125));
+	REQUIRE(overlapCentroids[11] == Approx(375));
+	double polygon[12];
+	connectionGeometry.getOverlapPolygon(3, polygon);
+	for (unsigned int vertex = 0; vertex < 4; ++vertex) {
+		REQUIRE(polygon[vertex * 3] == Approx(375));
+		REQUIRE(polygon[vertex * 3 + 2] >= 350 - 1e-9);
+		REQUIRE(polygon[vertex * 3 + 2] <= 400 + 1e-9);
+	}
+	REQUIRE_THROWS_AS(connectionGeometry.getOverlapPolygonVertexCount(15), out_of_range);
+
+	// same connection geometry when the connections are shared between threads
+	ijkGrid->loadSplitInformation();
+	parallel::setMaxThreadCount(4);
+	parallel::setMinItemCountPerThread(1);
+	GridConnectionGeometry threadedConnectionGeometry(gcs);
+	parallel::setMaxThreadCount(0);
+	parallel::setMinItemCountPerThread(0);
+	ijkGrid->unloadSplitInformation();
+	double threadedOverlapAreas[15];
+	threadedConnectionGeometry.getOverlapAreas(threadedOverlapAreas);
+	for (unsigned int connection = 0; connection < 15; ++connection) {
+		REQUIRE(threadedOverlapAreas[connection] == overlapAreas[connection]);
+		REQUIRE(threadedConnectionGeometry.getOverlapPolygonVertexCount(connection) == connectionGeometry.getOverlapPolygonVertexCount(connection));
+	}
+	double threadedPolygon[12];
+	threadedConnectionGeometry.getOverlapPolygon(11, threadedPolygon);
+	connectionGeometry.getOverlapPolygon(11, polygon);
+	for (unsigned int i = 0; i < 12; ++i) {
+		REQUIRE(threadedPolygon[i] == polygon[i]);
+	}
+
+	// overlap area property
+	RESQML2_0_1_NS::ContinuousProperty* overlapAreaProperty = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(overlapAreaUuid);
+	REQUIRE(overlapAreaProperty->getRepresentation() == gcs);
+	REQUIRE(overlapAreaProperty->getAttachmentKind() == gsoap_resqml2_0_1::resqml2__IndexableElements__faces);
+	REQUIRE(overlapAreaProperty->getValuesCountOfPatch(0) == 15);
+	double storedAreas[15];
+	overlapAreaProperty->getDoubleValuesOfPatch(0, storedAreas);
+	for (unsigned int connection = 0; connection < 15; ++connection) {
+		REQUIRE(storedAreas[connection] == overlapAreas[connection]);
+	}
+
+	// transmissibility property : harmonic mean of the half transmissibilities k.A.|n.d|/(d.d)
+	// The cell centers are 112.5 and 87.5 away from the fault in I and 25 away from the overlap centroid in K.
+	const double leftGeometricFactor = 2500 * 112.5 / (112.5 * 112.5 + 25 * 25);
+	const double rightGeometricFactor = 2500 * 87.5 / (87.5 * 87.5 + 25 * 25);
+	RESQML2_0_1_NS::ContinuousProperty* transmissibilityProperty = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(uuid);
+	REQUIRE(transmissibilityProperty->getRepresentation() == gcs);
+	REQUIRE(transmissibilityProperty->getAttachmentKind() == gsoap_resqml2_0_1::resqml2__IndexableElements__faces);
+	REQUIRE(transmissibilityProperty->getValuesCountOfPatch(0) == 15);
+	double storedTransmissibilities[15];
+	transmissibilityProperty->getDoubleValuesOfPatch(0, storedTransmissibilities);
+	for (unsigned int connection = 0; connection < 15; ++connection) {
+		if (connection < 3 || connection >= 12) {
+			REQUIRE(storedTransmissibilities[connection] == 0);
+			continue;
+		}
+		const ULONG64 leftCell = cellIndexPairs[connection * 2];
+		const ULONG64 rightCell = cellIndexPairs[connection * 2 + 1];
+		const double leftHalf = getPermeabilityI(leftCell) * getNetToGross(leftCell) * leftGeometricFactor;
+		const double rightHalf = getPermeabilityI(rightCell) * getNetToGross(rightCell) * rightGeometricFactor;
+		if (leftCell == 5) {
+			REQUIRE(std::isnan(storedTransmissibilities[connection]));
+		}
+		else {
+			REQUIRE(storedTransmissibilities[connection] == Approx(darcyConstant * leftHalf * rightHalf / (leftHalf + rightHalf)));
+		}
+	}
+	REQUIRE(storedTransmissibilities[3] == Approx(darcyConstant * 100 * leftGeometricFactor * 300 * rightGeometricFactor / (100 * leftGeometricFactor + 300 * rightGeometricFactor)));
+
+	// the computation from the stored cell properties gives the stored transmissibilities
+	RESQML2_0_1_NS::ContinuousProperty* permeabilityI = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(permeabilityIUuid);
+	RESQML2_0_1_NS::ContinuousProperty* permeabilityJ = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(permeabilityJUuid);
+	RESQML2_0_1_NS::ContinuousProperty* permeabilityK = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(permeabilityKUuid);
+	RESQML2_0_1_NS::ContinuousProperty* netToGross = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(netToGrossUuid);
+	double transmissibilities[15];
+	connectionGeometry.computeTransmissibilities(transmissibilities, permeabilityI, permeabilityJ, permeabilityK, netToGross, darcyConstant);
+	for (unsigned int connection = 0; connection < 15; ++connection) {
+		if (connection == 4) {
+			REQUIRE(std::isnan(transmissibilities[connection]));
+		}
+		else {
+			REQUIRE(transmissibilities[connection] == Approx(storedTransmissibilities[connection]));
+		}
+	}
+
+	// without net to gross ratio, cell 1 has its whole I permeability
+	connectionGeometry.computeTransmissibilities(transmissibilities, permeabilityI, permeabilityJ, permeabilityK, nullptr, darcyConstant);
+	REQUIRE(transmissibilities[3] == Approx(darcyConstant * 200 * leftGeometricFactor * 300 * rightGeometricFactor / (200 * leftGeometricFactor + 300 * rightGeometricFactor)));
+
+	// the properties must be given for each supporting grid
+	REQUIRE_THROWS_AS(connectionGeometry.computeTransmissibilities(transmissibilities,
+		std::vector<RESQML2_0_1_NS::ContinuousProperty*>(), std::vector<RESQML2_0_1_NS::ContinuousProperty*>(), std::vector<RESQML2_0_1_NS::ContinuousProperty*>(),
+		std::vector<RESQML2_0_1_NS::ContinuousProperty*>()), invalid_argument);
+	REQUIRE_THROWS_AS(connectionGeometry.computeTransmissibilities(transmissibilities, overlapAreaProperty, permeabilityJ, permeabilityK), invalid_argument);
+}
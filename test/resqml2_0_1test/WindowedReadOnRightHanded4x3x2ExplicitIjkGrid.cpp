@@ -0,0 +1,90 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "resqml2_0_1test/WindowedReadOnRightHanded4x3x2ExplicitIjkGrid.h"
+
+#include "catch.hpp"
+
+#include "common/EpcDocument.h"
+#include "resqml2_0_1/IjkGridExplicitRepresentation.h"
+#include "resqml2_0_1/DiscreteProperty.h"
+#include "resqml2_0_1/ContinuousProperty.h"
+
+using namespace std;
+using namespace COMMON_NS;
+using namespace RESQML2_NS;
+using namespace resqml2_0_1test;
+
+const char* WindowedReadOnRightHanded4x3x2ExplicitIjkGrid::defaultUuid = "cf7f66fd-9367-4557-b039-1c6dac762b66";
+const char* WindowedReadOnRightHanded4x3x2ExplicitIjkGrid::defaultTitle = "Windowed cell index";
+
+namespace {
+	const char* amplitudeUuid = "de5a71cc-879d-4cda-8fb3-146c70539cf9";
+}
+
+void WindowedReadOnRightHanded4x3x2ExplicitIjkGrid::initFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid, AbstractHdfProxy* hdfProxy) {
+	// discrete property whose values are the cell indices
+	RESQML2_0_1_NS::DiscreteProperty* discreteProp = this->epcDoc->createDiscreteProperty(ijkGrid, uuid, title, 1,
+		gsoap_resqml2_0_1::resqml2__IndexableElements__cells, gsoap_resqml2_0_1::resqml2__ResqmlPropertyKind__index);
+	long cellIndices[24];
+	for (long cell = 0; cell < 24; ++cell) {
+		cellIndices[cell] = cell;
+	}
+	discreteProp->pushBackLongHdf5Array3dOfValues(cellIndices, 4, 3, 2, hdfProxy, -1);
+}
+
+void WindowedReadOnRightHanded4x3x2ExplicitIjkGrid::readFeature(RESQML2_0_1_NS::IjkGridExplicitRepresentation* ijkGrid) {
+	RESQML2_0_1_NS::DiscreteProperty* discreteProp = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::DiscreteProperty>(uuid);
+	REQUIRE(discreteProp->getRepresentation() == ijkGrid);
+
+	// contiguous box of 2*2*1 cells starting at cell (1,1,1)
+	double boxValues[4];
+	discreteProp->getDoubleValuesOf3dBoxOfPatch(0, boxValues, 2, 2, 1, 1, 1, 1);
+	REQUIRE(boxValues[0] == 17);
+	REQUIRE(boxValues[1] == 18);
+	REQUIRE(boxValues[2] == 21);
+	REQUIRE(boxValues[3] == 22);
+
+	// strided box : every other cell along I and J in both K layers
+	long stridedValues[8];
+	discreteProp->getLongValuesOf3dBoxOfPatch(0, stridedValues, 2, 2, 2, 0, 0, 0, 2, 2, 1);
+	const long expectedStridedValues[8] = { 0, 2, 8, 10, 12, 14, 20, 22 };
+	for (unsigned int i = 0; i < 8; ++i) {
+		REQUIRE(stridedValues[i] == expectedStridedValues[i]);
+	}
+
+	// hyperslab whose dimensions are ordered from the slowest to the fastest one : the last row of the first K layer
+	unsigned char rowValues[4];
+	unsigned long long rowCounts[3] = { 1, 1, 4 };
+	unsigned long long rowOffsets[3] = { 0, 2, 0 };
+	discreteProp->getUCharValuesOfHyperslabOfPatch(0, rowValues, rowCounts, rowOffsets, nullptr, 3);
+	for (unsigned int i = 0; i < 4; ++i) {
+		REQUIRE(rowValues[i] == 8 + i);
+	}
+
+	// floating point box of the amplitude of the grid
+	RESQML2_0_1_NS::ContinuousProperty* amplitude = this->epcDoc->getResqmlAbstractObjectByUuid<RESQML2_0_1_NS::ContinuousProperty>(amplitudeUuid);
+	double amplitudeValues[24];
+	amplitude->getDoubleValuesOfPatch(0, amplitudeValues);
+	float amplitudeBoxValues[4];
+	amplitude->getFloatValuesOf3dBoxOfPatch(0, amplitudeBoxValues, 2, 2, 1, 1, 1, 1);
+	REQUIRE(amplitudeBoxValues[0] == static_cast<float>(amplitudeValues[17]));
+	REQUIRE(amplitudeBoxValues[1] == static_cast<float>(amplitudeValues[18]));
+	REQUIRE(amplitudeBoxValues[2] == static_cast<float>(amplitudeValues[21]));
+	REQUIRE(amplitudeBoxValues[3] == static_cast<float>(amplitudeValues[22]));
+}
@@ -37,6 +37,7 @@ under the License.
 #include "resqml2_0_1test/ActivityTemplateGenericCreationTest.h"
 #include "resqml2_0_1test/ActivityCreationTest.h"
 #include "resqml2_0_1test/OneTetrahedronUnstructuredGridRepresentationTest.h"
+#include "resqml2_0_1test/RepeatedFaceUnstructuredGridRepresentationTest.h"
 #include "resqml2_0_1test/UnstructuredFromIjkGridRepresentationTest.h"
 #include "resqml2_0_1test/TimeSeriesTest.h"
 #include "resqml2_0_1test/CommentProperty.h"
@@ -50,9 +51,23 @@ under the License.
 #include "resqml2_0_1test/HorizonOnSeismicLine.h"
 #include "resqml2_0_1test/RightHanded4x3x2ExplicitIjkGrid.h"
 #include "resqml2_0_1test/BigIjkGridExplicitRepresentationTest.h"
+#include "resqml2_0_1test/IjkGridLatticeRepresentationTest.h"
 #include "resqml2_0_1test/BigIjkGridParametricRepresentationTest.h"
 #include "resqml2_0_1test/SubRepresentationOnPartialGridConnectionSet.h"
 #include "resqml2_0_1test/LgrOnRightHanded4x3x2ExplicitIjkGrid.h"
+#include "resqml2_0_1test/GridPartitionOnRightHanded4x3x2ExplicitIjkGrid.h"
+#include "resqml2_0_1test/InterpretedGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid.h"
+#include "resqml2_0_1test/TransmissibilityOnRightHanded4x3x2ExplicitIjkGrid.h"
+#include "resqml2_0_1test/FaultGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid.h"
+#include "resqml2_0_1test/GatherScatterOnRightHanded4x3x2ExplicitIjkGrid.h"
+#include "resqml2_0_1test/BulkLoadOnRightHanded4x3x2ExplicitIjkGrid.h"
+#include "resqml2_0_1test/EncodedPropertyOnRightHanded4x3x2ExplicitIjkGrid.h"
+#include "resqml2_0_1test/CompactPropertyOnRightHanded4x3x2ExplicitIjkGrid.h"
+#include "resqml2_0_1test/DerivedPropertyOnRightHanded4x3x2ExplicitIjkGrid.h"
+#include "resqml2_0_1test/WindowedReadOnRightHanded4x3x2ExplicitIjkGrid.h"
+#include "resqml2_0_1test/HorizontalPillarFaultedIjkGrid.h"
+#include "resqml2_0_1test/ColumnLayerLgrOnRightHanded4x3x2ExplicitIjkGrid.h"
+#include "resqml2_0_1test/CellOverlapLgrOnRightHanded4x3x2ExplicitIjkGrid.h"
 #include "resqml2_0_1test/InterpretationDomain.h"
 
 using namespace commontest;
@@ -101,6 +116,14 @@ TEST_CASE("Export and import a big explicit ijk grid", "[grid][property]")
 	delete test;
 }
 
+TEST_CASE("Export and import a big unfaulted explicit ijk grid", "[grid][property]")
+{
+	BigIjkGridExplicitRepresentationTest* test = new BigIjkGridExplicitRepresentationTest("../../UnfaultedBigIjkGridExplicitRepresentationTest.epc", 10, 10, 5, 0, 0., 100., 0., 100., 0., 50., 10);
+	test->serialize();
+	test->deserialize();
+	delete test;
+}
+
 TEST_CASE("Export and import a big parametric ijk grid", "[grid][property]")
 {
 	BigIjkGridParametricRepresentationTest* test = new BigIjkGridParametricRepresentationTest("../../BigIjkGridParametricRepresentationTest.epc", 20, 20, 10, 10, 0., 100., 0., 100., 0., 50., 10);
@@ -111,8 +134,36 @@ TEST_CASE("Export and import a big parametric ijk grid", "[grid][property]")
 
 FESAPI_TEST("Export and import a LGR on a 4*3*2 explicit right handed ijk grid", "[grid]", LgrOnRightHanded4x3x2ExplicitIjkGrid)
 
+FESAPI_TEST("Export and import a column layer LGR on a 4*3*2 explicit right handed ijk grid", "[grid]", ColumnLayerLgrOnRightHanded4x3x2ExplicitIjkGrid)
+
+FESAPI_TEST("Export and import a cell overlap LGR on a 4*3*2 explicit right handed ijk grid", "[grid]", CellOverlapLgrOnRightHanded4x3x2ExplicitIjkGrid)
+
+FESAPI_TEST("Export and import the partition of a 4*3*2 explicit right handed ijk grid", "[grid][property]", GridPartitionOnRightHanded4x3x2ExplicitIjkGrid)
+
+FESAPI_TEST("Export and import a fault interpreted grid connection set on a 4*3*2 explicit right handed ijk grid", "[grid]", InterpretedGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid)
+
+FESAPI_TEST("Export and import the transmissibilities of the fault connections of a 4*3*2 explicit right handed ijk grid", "[grid][property]", TransmissibilityOnRightHanded4x3x2ExplicitIjkGrid)
+
+FESAPI_TEST("Export and import the generated fault grid connection set of a 4*3*2 explicit right handed ijk grid", "[grid]", FaultGridConnectionSetOnRightHanded4x3x2ExplicitIjkGrid)
+
+FESAPI_TEST("Export and import values scattered through an index set to a property of a 4*3*2 explicit right handed ijk grid", "[grid][property]", GatherScatterOnRightHanded4x3x2ExplicitIjkGrid)
+
+FESAPI_TEST("Export and import the bulk load of the properties of a 4*3*2 explicit right handed ijk grid", "[grid][property]", BulkLoadOnRightHanded4x3x2ExplicitIjkGrid)
+
+FESAPI_TEST("Export and import encoded properties and property series of a 4*3*2 explicit right handed ijk grid", "[grid][property]", EncodedPropertyOnRightHanded4x3x2ExplicitIjkGrid)
+
+FESAPI_TEST("Export and import properties stored in the narrowest integer datatype on a 4*3*2 explicit right handed ijk grid", "[grid][property]", CompactPropertyOnRightHanded4x3x2ExplicitIjkGrid)
+FESAPI_TEST("Export and import properties derived by streaming from other properties on a 4*3*2 explicit right handed ijk grid", "[grid][property]", DerivedPropertyOnRightHanded4x3x2ExplicitIjkGrid)
+FESAPI_TEST("Export and import windows of property values on a 4*3*2 explicit right handed ijk grid", "[grid][property]", WindowedReadOnRightHanded4x3x2ExplicitIjkGrid)
+
+FESAPI_TEST("Export and import a faulted ijk grid with horizontal pillars and a disabled cell", "[grid]", HorizontalPillarFaultedIjkGrid)
+
+FESAPI_TEST("Export and import a 3*2*2 lattice ijk grid", "[grid]", IjkGridLatticeRepresentationTest)
+
 FESAPI_TEST("Export and import an unstructured grid", "[grid]", OneTetrahedronUnstructuredGridRepresentationTest)
 
+FESAPI_TEST("Export and import an unstructured grid whose cell repeats a face", "[grid]", RepeatedFaceUnstructuredGridRepresentationTest)
+
 FESAPI_TEST("Export and import a subrepresenation on a partial grid connection set", "[grid]", SubRepresentationOnPartialGridConnectionSet)
 
 // fail